@@ -77,8 +77,10 @@ enum PH_EATTRIBUTE
 
 // HACK
 #define PH_NUM_RENDER_LAYERS         4
-#define PH_NUM_RENDER_STATE_INTEGERS 4
-#define PH_NUM_RENDER_STATE_REALS    4
+#define PH_NUM_RENDER_STATE_INTEGERS 8
+#define PH_NUM_RENDER_STATE_REALS    8
+#define PH_NUM_RENDER_HISTOGRAMS     4
+#define PH_NUM_RENDER_HISTOGRAM_BINS 16
 #define PH_MAX_NAME_LENGTH           128
 
 // HACK
@@ -86,6 +88,7 @@ struct PHRenderState
 {
 	PHint64   integers[PH_NUM_RENDER_STATE_INTEGERS];
 	PHfloat32 reals[PH_NUM_RENDER_STATE_REALS];
+	PHint64   histograms[PH_NUM_RENDER_HISTOGRAMS][PH_NUM_RENDER_HISTOGRAM_BINS];
 };
 
 // HACK
@@ -94,13 +97,15 @@ struct PHObservableRenderData
 	PHchar layers[PH_NUM_RENDER_LAYERS][PH_MAX_NAME_LENGTH + 1];
 	PHchar integers[PH_NUM_RENDER_STATE_INTEGERS][PH_MAX_NAME_LENGTH + 1];
 	PHchar reals[PH_NUM_RENDER_STATE_REALS][PH_MAX_NAME_LENGTH + 1];
+	PHchar histograms[PH_NUM_RENDER_HISTOGRAMS][PH_MAX_NAME_LENGTH + 1];
 };
 
 // HACK
 enum PH_ERenderStateType
 {
 	INTEGER,
-	REAL
+	REAL,
+	HISTOGRAM
 };
 
 #define PH_FILM_REGION_STATUS_INVALID  -1
@@ -150,6 +155,13 @@ extern PH_API void phSetWorkingDirectory(PHuint64 engineId, const PHchar* workin
 extern PH_API void phAquireFrame(PHuint64 engineId, PHuint64 channelIndex, PHuint64 frameId);
 extern PH_API void phAquireFrameRaw(PHuint64 engineId, PHuint64 channelIndex, PHuint64 frameId);
 
+/*! @brief Saves all render layers to an OpenEXR file, without post-processing.
+
+Each layer is retrieved into a frame of the full film size before writing,
+so this takes memory for as many frames as there are layers.
+ */
+extern PH_API void phSaveRenderLayers(PHuint64 engineId, const PHchar* filePath);
+
 ///////////////////////////////////////////////////////////////////////////////
 // frame operations
 //
@@ -4,7 +4,8 @@
 #include "Actor/AModel.h"
 #include "Actor/Geometry/PrimitiveBuildingMaterial.h"
 #include "FileIO/SDL/InputPacket.h"
-#include "Actor/Geometry/GeometrySoup.h"
+#include "Core/Intersectable/PTriangleMesh.h"
+#include "Core/Intersectable/IndexedTriangleBuffer.h"
 
 #include <iostream>
 
@@ -13,7 +14,9 @@ namespace ph
 
 GTriangleMesh::GTriangleMesh() : 
 	Geometry(), 
-	m_gTriangles()
+	m_gTriangles(),
+	m_isQuantized(false),
+	m_bvhWidth(4)
 {}
 
 GTriangleMesh::GTriangleMesh(const std::vector<Vector3R>& positions,
@@ -52,10 +55,43 @@ void GTriangleMesh::genPrimitive(
 	const PrimitiveBuildingMaterial& data,
 	std::vector<std::unique_ptr<Primitive>>& out_primitives) const
 {
+	if(!data.metadata)
+	{
+		std::cerr << "warning: at GTriangleMesh::genPrimitive(), " 
+		          << "no PrimitiveMetadata" << std::endl;
+		return;
+	}
+
+	if(m_gTriangles.empty())
+	{
+		return;
+	}
+
+	std::vector<Vector3R> positions;
+	std::vector<Vector3R> normals;
+	std::vector<Vector3R> uvws;
+	positions.reserve(m_gTriangles.size() * 3);
+	normals.reserve(m_gTriangles.size() * 3);
+	uvws.reserve(m_gTriangles.size() * 3);
 	for(const auto& gTriangle : m_gTriangles)
 	{
-		gTriangle.genPrimitive(data, out_primitives);
+		positions.push_back(gTriangle.getVa());
+		positions.push_back(gTriangle.getVb());
+		positions.push_back(gTriangle.getVc());
+		normals.push_back(gTriangle.getNa());
+		normals.push_back(gTriangle.getNb());
+		normals.push_back(gTriangle.getNc());
+		uvws.push_back(gTriangle.getUVWa());
+		uvws.push_back(gTriangle.getUVWb());
+		uvws.push_back(gTriangle.getUVWc());
 	}
+
+	// all triangles go into a single primitive sharing one vertex buffer
+	out_primitives.push_back(std::make_unique<PTriangleMesh>(
+		data.metadata, 
+		IndexedTriangleBuffer(positions, normals, uvws, m_isQuantized),
+		m_bvhWidth,
+		EBvhType::SAH_BUCKET));
 }
 
 void GTriangleMesh::addTriangle(const GTriangle& gTriangle)
@@ -63,16 +99,33 @@ void GTriangleMesh::addTriangle(const GTriangle& gTriangle)
 	m_gTriangles.push_back(gTriangle);
 }
 
+void GTriangleMesh::setQuantizedAttributes(const bool isQuantized)
+{
+	m_isQuantized = isQuantized;
+}
+
+void GTriangleMesh::setBvhWidth(const std::size_t bvhWidth)
+{
+	PH_ASSERT(bvhWidth == 4 || bvhWidth == 8);
+
+	m_bvhWidth = bvhWidth;
+}
+
 std::shared_ptr<Geometry> GTriangleMesh::genTransformed(
 	const StaticAffineTransform& transform) const
 {
-	auto geometrySoup = std::make_shared<GeometrySoup>();
+	auto tTriangleMesh = std::make_shared<GTriangleMesh>();
+	tTriangleMesh->setQuantizedAttributes(m_isQuantized);
+	tTriangleMesh->setBvhWidth(m_bvhWidth);
 	for(const auto& gTriangle : m_gTriangles)
 	{
-		geometrySoup->add(std::make_shared<GTriangle>(gTriangle));
+		const auto& tTriangle = std::dynamic_pointer_cast<GTriangle>(gTriangle.genTransformed(transform));
+		PH_ASSERT(tTriangle);
+
+		tTriangleMesh->addTriangle(*tTriangle);
 	}
 
-	return geometrySoup->genTransformed(transform);
+	return tTriangleMesh;
 }
 
 // command interface
@@ -91,11 +144,33 @@ void GTriangleMesh::ciRegister(CommandRegister& cmdRegister)
 
 std::unique_ptr<GTriangleMesh> GTriangleMesh::ciLoad(const InputPacket& packet)
 {
-	const std::vector<Vector3R> positions = packet.getVector3Array("positions");
-	const std::vector<Vector3R> texCoords = packet.getVector3Array("texture-coordinates");
-	const std::vector<Vector3R> normals   = packet.getVector3Array("normals");
+	const std::vector<Vector3R> positions   = packet.getVector3Array("positions");
+	const std::vector<Vector3R> texCoords   = packet.getVector3Array("texture-coordinates");
+	const std::vector<Vector3R> normals     = packet.getVector3Array("normals");
+	const std::string           precision   = packet.getString("attribute-precision", "full");
+	const std::string           accelerator = packet.getString("accelerator", "bvh4");
+
+	auto triangleMesh = std::make_unique<GTriangleMesh>(positions, texCoords, normals);
+	if(precision == "16-bit")
+	{
+		triangleMesh->setQuantizedAttributes(true);
+	}
+	else if(precision != "full")
+	{
+		std::cerr << "warning: at GTriangleMesh::ciLoad(), "
+		          << "unknown attribute precision <" << precision << ">, using full precision" << std::endl;
+	}
 
-	return std::make_unique<GTriangleMesh>(positions, texCoords, normals);
+	if(accelerator == "bvh8")
+	{
+		triangleMesh->setBvhWidth(8);
+	}
+	else if(accelerator != "bvh4")
+	{
+		std::cerr << "warning: at GTriangleMesh::ciLoad(), "
+		          << "unknown accelerator <" << accelerator << ">, using bvh4" << std::endl;
+	}
+	return triangleMesh;
 }
 
 }// end namespace ph
\ No newline at end of file
@@ -27,8 +27,18 @@ public:
 
 	void addTriangle(const GTriangle& gTriangle);
 
+	// Whether normals and texture coordinates of the generated primitive are
+	// stored as 16-bit integers.
+	void setQuantizedAttributes(bool isQuantized);
+
+	// Number of children per node of the BVH over triangles of the generated
+	// primitive, either 4 or 8.
+	void setBvhWidth(std::size_t bvhWidth);
+
 private:
 	std::vector<GTriangle> m_gTriangles;
+	bool                   m_isQuantized;
+	std::size_t            m_bvhWidth;
 
 // command interface
 public:
@@ -70,6 +80,18 @@ public:
 				each triangle.
 			</description>
 		</input>
+		<input name="attribute-precision" type="string">
+			<description>
+				Storage precision of normals and texture coordinates, can be "full"
+				(32-bit floats, the default) or "16-bit" (quantized, uses less memory).
+			</description>
+		</input>
+		<input name="accelerator" type="string">
+			<description>
+				Acceleration structure over triangles of the mesh, can be "bvh4" (the
+				default) or "bvh8".
+			</description>
+		</input>
 	</command>
 
 	</SDL_interface>
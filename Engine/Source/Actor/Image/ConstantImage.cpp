@@ -1,5 +1,7 @@
 #include "Actor/Image/ConstantImage.h"
 #include "Core/Texture/TConstantTexture.h"
+#include "Core/Texture/ConstantSpectralTexture.h"
+#include "Core/Quantity/ConstantSpectralStrength.h"
 #include "Math/TVector3.h"
 #include "FileIO/SDL/InputPacket.h"
 #include "FileIO/SDL/InputPrototype.h"
@@ -91,27 +93,27 @@ std::shared_ptr<TTexture<Vector3R>> ConstantImage::genTextureVector3R(
 std::shared_ptr<TTexture<SpectralStrength>> ConstantImage::genTextureSpectral(
 	CookingContext& context) const
 {
-	SpectralStrength values;
+	ConstantSpectralStrength values;
 	if(m_values.size() == 1)
 	{
 		switch(m_type)
 		{
 		case EType::RAW:
-			values.setValues(m_values[0]);
+			values = ConstantSpectralStrength(m_values[0]);
 			break;
 			
 		case EType::EMR_LINEAR_SRGB:
-			values.setLinearSrgb(Vector3R(m_values[0]), EQuantity::EMR);
+			values = ConstantSpectralStrength(Vector3R(m_values[0]), EQuantity::EMR);
 			break;
 
 		case EType::ECF_LINEAR_SRGB:
-			values.setLinearSrgb(Vector3R(m_values[0]), EQuantity::ECF);
+			values = ConstantSpectralStrength(Vector3R(m_values[0]), EQuantity::ECF);
 			break;
 
 		default:
 			std::cerr << "warning: at ConstantImage::genTextureSpectral(), "
 			          << "unsupported value type, using raw" << std::endl;
-			values.setValues(m_values[0]);
+			values = ConstantSpectralStrength(m_values[0]);
 			break;
 		}
 	}
@@ -120,21 +122,21 @@ std::shared_ptr<TTexture<SpectralStrength>> ConstantImage::genTextureSpectral(
 		switch(m_type)
 		{
 		case EType::EMR_LINEAR_SRGB:
-			values.setLinearSrgb(Vector3R(m_values[0], m_values[1], m_values[2]), EQuantity::EMR);
+			values = ConstantSpectralStrength(Vector3R(m_values[0], m_values[1], m_values[2]), EQuantity::EMR);
 			break;
 
 		case EType::ECF_LINEAR_SRGB:
-			values.setLinearSrgb(Vector3R(m_values[0], m_values[1], m_values[2]), EQuantity::ECF);
+			values = ConstantSpectralStrength(Vector3R(m_values[0], m_values[1], m_values[2]), EQuantity::ECF);
 			break;
 
 		case EType::RAW_LINEAR_SRGB:
-			values.setLinearSrgb(Vector3R(m_values[0], m_values[1], m_values[2]), EQuantity::RAW);
+			values = ConstantSpectralStrength(Vector3R(m_values[0], m_values[1], m_values[2]), EQuantity::RAW);
 			break;
 
 		default:
 			std::cerr << "warning: at ConstantImage::genTextureSpectral(), "
 			          << "unsupported value type, assuming ECF linear sRGB" << std::endl;
-			values.setLinearSrgb(Vector3R(m_values[0], m_values[1], m_values[2]), EQuantity::ECF);
+			values = ConstantSpectralStrength(Vector3R(m_values[0], m_values[1], m_values[2]), EQuantity::ECF);
 			break;
 		}
 	}
@@ -153,13 +155,15 @@ std::shared_ptr<TTexture<SpectralStrength>> ConstantImage::genTextureSpectral(
 			          << "only raw type is supported." << std::endl;
 		}
 
+		SpectralStrength rawValues;
 		for(std::size_t i = 0; i < SpectralStrength::NUM_VALUES; i++)
 		{
-			values[i] = i < m_values.size() ? m_values[i] : 1;
+			rawValues[i] = i < m_values.size() ? m_values[i] : 1;
 		}
+		values = ConstantSpectralStrength(rawValues);
 	}
 
-	return std::make_shared<TConstantTexture<SpectralStrength>>(values);
+	return std::make_shared<ConstantSpectralTexture>(values);
 }
 
 // command interface
@@ -5,6 +5,10 @@
 #include "Core/Texture/HdrRgbTexture2D.h"
 #include "Core/Texture/TNearestPixelTex2D.h"
 #include "Core/Texture/TBilinearPixelTex2D.h"
+#include "Core/Texture/TTrilinearPixelTex2D.h"
+#include "Core/Texture/TEwaPixelTex2D.h"
+#include "Core/Texture/TTiledImage.h"
+#include "Common/Logger.h"
 
 #include <memory>
 #include <utility>
@@ -12,32 +16,66 @@
 namespace ph
 {
 
+namespace
+{
+	const Logger logger(LogSender("HDR Picture Image"));
+}
+
 HdrPictureImage::HdrPictureImage() :
 	HdrPictureImage(HdrRgbFrame())
 {}
 
 HdrPictureImage::HdrPictureImage(const HdrRgbFrame& picture) :
 	PictureImage(),
-	m_picture(picture)
+	m_picture(picture),
+	m_picturePath()
 {}
 
 std::shared_ptr<TTexture<SpectralStrength>> HdrPictureImage::genTextureSpectral(
 	CookingContext& context) const
 {
 	std::unique_ptr<TAbstractPixelTex2D<HdrComponent, 3>> texture;
-	switch(getSampleMode())
+
+	const HdrRgbFrame* picture = &m_picture;
+	HdrRgbFrame        loadedPicture;
+	if(isTiled())
 	{
-	case EImgSampleMode::NEAREST:
-		texture = std::make_unique<TNearestPixelTex2D<HdrComponent, 3>>(m_picture);
-		break;
+		texture = genTiledTexture();
+		if(!texture)
+		{
+			logger.log(ELogLevel::WARNING_MED, 
+				"cannot use tiled picture for <" + m_picturePath.toString() + ">, "
+				"loading the picture into memory");
 
-	case EImgSampleMode::BILINEAR:
-		texture = std::make_unique<TBilinearPixelTex2D<HdrComponent, 3>>(m_picture);
-		break;
+			loadedPicture = PictureLoader::loadHdr(m_picturePath);
+			picture       = &loadedPicture;
+		}
+	}
 
-	default:
-		texture = std::make_unique<TNearestPixelTex2D<HdrComponent, 3>>(m_picture);
-		break;
+	if(!texture)
+	{
+		switch(getSampleMode())
+		{
+		case EImgSampleMode::NEAREST:
+			texture = std::make_unique<TNearestPixelTex2D<HdrComponent, 3>>(*picture);
+			break;
+
+		case EImgSampleMode::BILINEAR:
+			texture = std::make_unique<TBilinearPixelTex2D<HdrComponent, 3>>(*picture);
+			break;
+
+		case EImgSampleMode::MIPMAP_TRILINEAR:
+			texture = std::make_unique<TTrilinearPixelTex2D<HdrComponent, 3>>(*picture);
+			break;
+
+		case EImgSampleMode::MIPMAP_EWA:
+			texture = std::make_unique<TEwaPixelTex2D<HdrComponent, 3>>(*picture);
+			break;
+
+		default:
+			texture = std::make_unique<TNearestPixelTex2D<HdrComponent, 3>>(*picture);
+			break;
+		}
 	}
 
 	switch(getWrapMode())
@@ -54,6 +92,38 @@ std::shared_ptr<TTexture<SpectralStrength>> HdrPictureImage::genTextureSpectral(
 	return std::make_shared<HdrRgbTexture2D>(std::move(texture));
 }
 
+std::unique_ptr<TAbstractPixelTex2D<HdrComponent, 3>> HdrPictureImage::genTiledTexture() const
+{
+	const Path tiledPicturePath(m_picturePath.toAbsoluteString() + ".phtile");
+
+	auto tiledImage = std::make_shared<TTiledImage<HdrComponent, 3>>();
+	if(!tiledImage->openOrCreate(tiledPicturePath, calcPictureFileKey(m_picturePath), 
+		[this]()
+		{
+			logger.log("converting <" + m_picturePath.toString() + "> to a tiled picture...");
+
+			return PictureLoader::loadHdr(m_picturePath);
+		}))
+	{
+		return nullptr;
+	}
+
+	switch(getSampleMode())
+	{
+	case EImgSampleMode::BILINEAR:
+		return std::make_unique<TBilinearPixelTex2D<HdrComponent, 3>>(tiledImage, 0);
+
+	case EImgSampleMode::MIPMAP_TRILINEAR:
+		return std::make_unique<TTrilinearPixelTex2D<HdrComponent, 3>>(tiledImage);
+
+	case EImgSampleMode::MIPMAP_EWA:
+		return std::make_unique<TEwaPixelTex2D<HdrComponent, 3>>(tiledImage);
+
+	default:
+		return std::make_unique<TNearestPixelTex2D<HdrComponent, 3>>(tiledImage, 0);
+	}
+}
+
 void HdrPictureImage::setPicture(const HdrRgbFrame& picture)
 {
 	m_picture = picture;
@@ -72,7 +142,15 @@ HdrPictureImage::HdrPictureImage(const InputPacket& packet) :
 	const Path& picturePath = packet.getStringAsPath(
 		"image", Path(), DataTreatment::REQUIRED());
 
-	m_picture = PictureLoader::loadHdr(picturePath);
+	// tiled pictures are loaded on demand
+	if(isTiled())
+	{
+		m_picturePath = picturePath;
+	}
+	else
+	{
+		m_picture = PictureLoader::loadHdr(picturePath);
+	}
 }
 
 SdlTypeInfo HdrPictureImage::ciTypeInfo()
@@ -4,6 +4,10 @@
 #include "Actor/Image/PictureImage.h"
 #include "FileIO/SDL/TCommandInterface.h"
 #include "Frame/TFrame.h"
+#include "Core/Texture/TAbstractPixelTex2D.h"
+#include "FileIO/FileSystem/Path.h"
+
+#include <memory>
 
 namespace ph
 {
@@ -25,6 +29,13 @@ public:
 private:
 	HdrRgbFrame m_picture;
 
+	// the picture file, only kept for tiled images
+	Path m_picturePath;
+
+	// Creates a texture from the tiled version of the picture file, or 
+	// returns nullptr if it cannot be created.
+	std::unique_ptr<TAbstractPixelTex2D<HdrComponent, 3>> genTiledTexture() const;
+
 // command interface
 public:
 	explicit HdrPictureImage(const InputPacket& packet);
@@ -1,5 +1,16 @@
 #include "Actor/Image/PictureImage.h"
 #include "FileIO/SDL/InputPacket.h"
+#include "Math/hash.h"
+#include "Common/os.h"
+
+#include <string>
+
+#if defined(PH_OPERATING_SYSTEM_IS_WINDOWS)
+	#include <sys/types.h>
+	#include <sys/stat.h>
+#else
+	#include <sys/stat.h>
+#endif
 
 namespace ph
 {
@@ -7,7 +18,8 @@ namespace ph
 PictureImage::PictureImage() :
 	Image(),
 	m_sampleMode(EImgSampleMode::NEAREST),
-	m_wrapMode(EImgWrapMode::REPEAT)
+	m_wrapMode(EImgWrapMode::REPEAT),
+	m_isTiled(false)
 {}
 
 PictureImage& PictureImage::setSampleMode(EImgSampleMode mode)
@@ -24,6 +36,13 @@ PictureImage& PictureImage::setWrapMode(EImgWrapMode mode)
 	return *this;
 }
 
+PictureImage& PictureImage::setTiled(const bool isTiled)
+{
+	m_isTiled = isTiled;
+
+	return *this;
+}
+
 EImgSampleMode PictureImage::getSampleMode() const
 {
 	return m_sampleMode;
@@ -34,6 +53,31 @@ EImgWrapMode PictureImage::getWrapMode() const
 	return m_wrapMode;
 }
 
+bool PictureImage::isTiled() const
+{
+	return m_isTiled;
+}
+
+uint64 PictureImage::calcPictureFileKey(const Path& picturePath)
+{
+	const std::string& filePath = picturePath.toAbsoluteString();
+
+#if defined(PH_OPERATING_SYSTEM_IS_WINDOWS)
+	struct _stat64 fileStatus;
+	if(_stat64(filePath.c_str(), &fileStatus) != 0)
+#else
+	struct stat fileStatus;
+	if(stat(filePath.c_str(), &fileStatus) != 0)
+#endif
+	{
+		return 0;
+	}
+
+	return hash::combine_64(
+		static_cast<uint64>(fileStatus.st_size), 
+		static_cast<uint64>(fileStatus.st_mtime));
+}
+
 // command interface
 
 PictureImage::PictureImage(const InputPacket& packet) : 
@@ -52,6 +96,10 @@ PictureImage::PictureImage(const InputPacket& packet) :
 	{
 		m_sampleMode = EImgSampleMode::MIPMAP_TRILINEAR;
 	}
+	else if(sampleMode == "mipmap-ewa")
+	{
+		m_sampleMode = EImgSampleMode::MIPMAP_EWA;
+	}
 
 	const std::string& wrapMode = packet.getString("wrap-mode", "repeat");
 	if(wrapMode == "repeat")
@@ -62,6 +110,8 @@ PictureImage::PictureImage(const InputPacket& packet) :
 	{
 		m_wrapMode = EImgWrapMode::CLAMP_TO_EDGE;
 	}
+
+	m_isTiled = packet.getString("tiled", "false") == "true";
 }
 
 SdlTypeInfo PictureImage::ciTypeInfo()
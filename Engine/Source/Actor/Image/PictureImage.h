@@ -2,6 +2,8 @@
 
 #include "Actor/Image/Image.h"
 #include "FileIO/SDL/TCommandInterface.h"
+#include "FileIO/FileSystem/Path.h"
+#include "Common/primitive_type.h"
 
 namespace ph
 {
@@ -10,7 +12,8 @@ enum class EImgSampleMode
 {
 	NEAREST,
 	BILINEAR,
-	MIPMAP_TRILINEAR
+	MIPMAP_TRILINEAR,
+	MIPMAP_EWA
 };
 
 enum class EImgWrapMode
@@ -31,13 +34,21 @@ public:
 
 	EImgSampleMode getSampleMode() const;
 	EImgWrapMode   getWrapMode() const;
+	bool           isTiled() const;
 
 	PictureImage& setSampleMode(EImgSampleMode mode);
 	PictureImage& setWrapMode(EImgWrapMode mode);
+	PictureImage& setTiled(bool isTiled);
+
+protected:
+	// Identifies the current contents of a picture file by its size and
+	// modification time, for telling stale tile files apart.
+	static uint64 calcPictureFileKey(const Path& picturePath);
 
 private:
 	EImgSampleMode m_sampleMode;
 	EImgWrapMode   m_wrapMode;
+	bool           m_isTiled;
 
 // command interface
 public:
@@ -65,7 +76,10 @@ public:
 			<description>
 				Controls how the image will be sampled. "nearest": nearest sampling, fast but 
 				blocky at close distances; "bilinear": bilinearly interpolated sampling, a good
-				trade-off between speed and quality.
+				trade-off between speed and quality; "mipmap-trilinear": interpolates between 
+				the two mipmap levels closest to the pixel footprint, which removes aliasing of
+				distant textures; "mipmap-ewa": anisotropic filtering by elliptically weighted 
+				average, sharper than "mipmap-trilinear" for textures seen at grazing angles.
 			</description>
 		</input>
 		<input name="wrap-mode" type="string">
@@ -76,6 +90,16 @@ public:
 				out-of-range coordinates.
 			</description>
 		</input>
+		<input name="tiled" type="string">
+			<description>
+				"true" or "false". Whether to keep the image out of memory. The image is converted
+				once into a file of tiles with mipmaps next to it (with ".phtile" appended to its 
+				name) and tiles are loaded on demand into a texture cache shared by all images, 
+				whose size is set by "texture-cache-mb" of cook settings. The image is resized to
+				power-of-2 dimensions. The tile file is regenerated whenever the size or modification
+				time of the image file changes.
+			</description>
+		</input>
 	</command>
 
 	</SDL_interface>
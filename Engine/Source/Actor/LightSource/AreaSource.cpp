@@ -16,7 +16,7 @@
 #include "Actor/Image/LdrPictureImage.h"
 #include "FileIO/PictureLoader.h"
 #include "Math/constant.h"
-#include "Core/Texture/TConstantTexture.h"
+#include "Core/Texture/ConstantSpectralTexture.h"
 #include "Actor/Geometry/PrimitiveBuildingMaterial.h"
 #include "Actor/AModel.h"
 
@@ -69,9 +69,8 @@ std::unique_ptr<Emitter> AreaSource::genEmitter(
 	const auto totalWattColor = unitWattColor.mul(m_numWatts);
 	const auto lightRadiance  = totalWattColor.div(lightArea * constant::pi<real>);
 
-	SpectralStrength radiance;
-	radiance.setSampled(lightRadiance, EQuantity::EMR);
-	const auto& emittedRadiance = std::make_shared<TConstantTexture<SpectralStrength>>(radiance);
+	const auto& emittedRadiance = std::make_shared<ConstantSpectralTexture>(
+		ConstantSpectralStrength(lightRadiance, EQuantity::EMR));
 
 	std::unique_ptr<Emitter> emitter;
 	{
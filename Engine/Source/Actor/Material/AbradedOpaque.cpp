@@ -145,8 +145,7 @@ std::unique_ptr<FresnelEffect> AbradedOpaque::loadFresnelEffect(const InputPacke
 	{
 		const auto& f0 = packet.getVector3("f0");
 
-		SpectralStrength spectralF0;
-		spectralF0.setLinearSrgb(f0);// FIXME: check color space
+		const ConstantSpectralStrength spectralF0(f0, EQuantity::RAW);// FIXME: check color space
 		fresnelEffect = std::make_unique<SchlickApproxConductorDielectricFresnel>(spectralF0);
 	}
 	else
@@ -156,8 +155,7 @@ std::unique_ptr<FresnelEffect> AbradedOpaque::loadFresnelEffect(const InputPacke
 
 		const Vector3R defaultF0(0.04_r, 0.04_r, 0.04_r);
 
-		SpectralStrength spectralF0;// FIXME: check color space
-		spectralF0.setLinearSrgb(defaultF0);
+		const ConstantSpectralStrength spectralF0(defaultF0, EQuantity::RAW);// FIXME: check color space
 		fresnelEffect = std::make_unique<SchlickApproxConductorDielectricFresnel>(spectralF0);
 	}
 	
@@ -44,8 +44,7 @@ void IdealSubstance::asDielectricReflector(const real iorInner, const real iorOu
 
 void IdealSubstance::asMetallicReflector(const Vector3R& linearSrgbF0, const real iorOuter)
 {
-	SpectralStrength f0Spectral;
-	f0Spectral.setLinearSrgb(linearSrgbF0);// FIXME: check color space
+	const ConstantSpectralStrength f0Spectral(linearSrgbF0, EQuantity::RAW);// FIXME: check color space
 
 	m_opticsGenerator = [=](CookingContext& context)
 	{
@@ -66,6 +66,9 @@
 #include "Core/SampleGenerator/SampleGenerator.h"
 #include "Core/SampleGenerator/SGUniformRandom.h"
 #include "Core/SampleGenerator/SGStratified.h"
+#include "Core/SampleGenerator/SGSobol.h"
+#include "Core/SampleGenerator/SGHalton.h"
+#include "Core/SampleGenerator/SGPmj02.h"
 
 // renderers
 #include "Core/Renderer/Renderer.h"
@@ -165,6 +168,9 @@ bool init_command_parser()
 	register_command_interface<SampleGenerator>();
 	register_command_interface<SGUniformRandom>();
 	register_command_interface<SGStratified>();
+	register_command_interface<SGSobol>();
+	register_command_interface<SGHalton>();
+	register_command_interface<SGPmj02>();
 
 	// renderers
 	register_command_interface<Renderer>();
@@ -10,6 +10,7 @@
 #include "FileIO/FileSystem/Path.h"
 #include "Common/assertion.h"
 #include "FileIO/PictureSaver.h"
+#include "FileIO/ExrFileWriter.h"
 #include "Api/ApiHelper.h"
 #include "Core/Renderer/Region/Region.h"
 #include "Common/config.h"
@@ -18,6 +19,9 @@
 #include <memory>
 #include <iostream>
 #include <cstring>
+#include <algorithm>
+#include <vector>
+#include <string>
 
 namespace
 {
@@ -164,6 +168,54 @@ void phAquireFrameRaw(
 	}
 }
 
+void phSaveRenderLayers(const PHuint64 engineId, const PHchar* const filePath)
+{
+	PH_ASSERT(filePath != nullptr);
+
+	using namespace ph;
+
+	Engine* engine = ApiDatabase::getEngine(engineId);
+	if(engine)
+	{
+		const auto data = engine->getRenderer()->getObservableData();
+		const auto dim  = engine->getFilmDimensionPx();
+
+		// layer 0 is the default layer of the file; renderers that name no
+		// layer still have it
+		const std::size_t numLayers = std::max(data.numLayers(), std::size_t(1));
+
+		// Renderers only give whole frames, and scanlines of all layers are
+		// interleaved in the file, so every layer is copied into a frame
+		// before writing.
+
+		std::vector<HdrRgbFrame> frames;
+		frames.reserve(numLayers);
+
+		ExrFileWriter writer;
+		for(std::size_t i = 0; i < numLayers; ++i)
+		{
+			frames.push_back(HdrRgbFrame(static_cast<uint32>(dim.x), static_cast<uint32>(dim.y)));
+			engine->retrieveFrame(i, frames.back(), false);
+
+			std::string layerName;
+			if(i > 0)
+			{
+				layerName = data.getLayerName(i);
+				if(layerName.empty())
+				{
+					layerName = "layer" + std::to_string(i);
+				}
+			}
+			writer.addLayer(layerName, &(frames.back()));
+		}
+
+		if(!writer.write(Path(filePath)))
+		{
+			logger.log("render layers of engine<" + std::to_string(engineId) + "> saving failed");
+		}
+	}
+}
+
 void phGetRenderDimension(const PHuint64 engineId, PHuint32* const out_widthPx, PHuint32* const out_heightPx)
 {
 	using namespace ph;
@@ -228,6 +280,19 @@ void phGetObservableRenderData(
 				out_data->reals[i][PH_MAX_NAME_LENGTH] = '\0';
 			}
 		}
+
+		for(std::size_t i = 0; i < PH_NUM_RENDER_HISTOGRAMS; ++i)
+		{
+			out_data->histograms[i][0] = '\0';
+			if(i < data.numHistograms())
+			{
+				std::strncpy(
+					out_data->histograms[i],
+					data.getHistogramName(i).c_str(),
+					PH_MAX_NAME_LENGTH);
+				out_data->histograms[i][PH_MAX_NAME_LENGTH] = '\0';
+			}
+		}
 	}
 }
 
@@ -332,6 +397,16 @@ void phAsyncGetRendererState(
 		{
 			out_state->reals[i] = static_cast<PHfloat32>(state.getRealState(i));
 		}
+
+		static_assert(PH_NUM_RENDER_HISTOGRAMS     == RenderState::NUM_HISTOGRAMS);
+		static_assert(PH_NUM_RENDER_HISTOGRAM_BINS == RenderState::NUM_HISTOGRAM_BINS);
+		for(std::size_t i = 0; i < PH_NUM_RENDER_HISTOGRAMS; ++i)
+		{
+			for(std::size_t j = 0; j < PH_NUM_RENDER_HISTOGRAM_BINS; ++j)
+			{
+				out_state->histograms[i][j] = static_cast<PHint64>(state.getHistogramBin(i, j));
+			}
+		}
 	}
 }
 
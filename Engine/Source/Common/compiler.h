@@ -8,4 +8,17 @@
 	#define PH_COMPILER_IS_GCC
 #elif defined(_MSC_VER)
 	#define PH_COMPILER_IS_MSVC
-#endif
\ No newline at end of file
+#endif
+
+// Instruction sets that are enabled for the current compilation. Note that
+// these only reflect the compiler flags being used, not the capabilities of
+// the machine running the program. AVX is enabled by the ENABLE_AVX build 
+// option.
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define PH_ISA_HAS_SSE2
+#endif
+
+#if defined(__AVX__)
+	#define PH_ISA_HAS_AVX
+#endif
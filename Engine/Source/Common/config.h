@@ -16,11 +16,19 @@
 // Log as soon as possible (primarily for debugging).
 //#define PH_UNBUFFERED_LOG
 
+// Use SIMD instructions in performance critical code paths. Instruction sets
+// are detected at compile time (see "Common/compiler.h"); a scalar fallback is
+// used if none is available.
+#define PH_USE_SIMD
+
 ///////////////////////////////////////////////////////////////////////////////
 // Render Mode Selections:
 //
 #define PH_RENDER_MODE_RGB
 //#define PH_RENDER_MODE_SPECTRAL
+
+// Hero wavelength spectral rendering: each camera path carries 
+// PH_SPECTRUM_HERO_NUM_WAVELENGTHS randomly chosen wavelengths.
 //#define PH_RENDER_MODE_FULL_SPECTRAL
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -34,6 +42,7 @@
 #define PH_SPECTRUM_SAMPLED_MIN_WAVELENGTH_NM 350
 #define PH_SPECTRUM_SAMPLED_MAX_WAVELENGTH_NM 850
 #define PH_SPECTRUM_SAMPLED_NUM_SAMPLES       100
+#define PH_SPECTRUM_HERO_NUM_WAVELENGTHS      4
 #define PH_HIT_PROBE_DEPTH                    8
 
 // Number of available bytes for a probe's cache. Note that a byte is not 
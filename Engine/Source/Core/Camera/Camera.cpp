@@ -4,6 +4,7 @@
 #include "Core/Ray.h"
 #include "Common/Logger.h"
 #include "Math/math.h"
+#include "Common/assertion.h"
 
 #include <iostream>
 
@@ -26,24 +27,28 @@ Camera::Camera(const Vector3R& position, const QuaternionR& rotation) :
 }
 
 void Camera::calcSensedRayDifferentials(
-	const Vector2R& rasterPosPx, const Ray& sensedRay,
+	const Vector2R& filmNdcPos, const Ray& sensedRay,
 	RayDifferential* const out_result) const
 {
-	// 2nd-order accurate with respect to the size of <deltaPx>
-	const real deltaPx        = 1.0_r / 32.0_r;
-	const real reciIntervalPx = 1.0_r / deltaPx;
+	PH_ASSERT(out_result);
+
+	// 2nd-order accurate with respect to the size of <deltaNdc>
+	const real deltaNdc        = 1.0_r / 1024.0_r;
+	const real reciIntervalNdc = 1.0_r / (2.0_r * deltaNdc);
 
 	Ray dnxRay, dpxRay, dnyRay, dpyRay;
-	genSensedRay(Vector2R(rasterPosPx.x - deltaPx, rasterPosPx.y), &dnxRay);
-	genSensedRay(Vector2R(rasterPosPx.x + deltaPx, rasterPosPx.y), &dpxRay);
-	genSensedRay(Vector2R(rasterPosPx.x, rasterPosPx.y - deltaPx), &dnyRay);
-	genSensedRay(Vector2R(rasterPosPx.x, rasterPosPx.y + deltaPx), &dpyRay);
+	genSensedRay(Vector2R(filmNdcPos.x - deltaNdc, filmNdcPos.y), &dnxRay);
+	genSensedRay(Vector2R(filmNdcPos.x + deltaNdc, filmNdcPos.y), &dpxRay);
+	genSensedRay(Vector2R(filmNdcPos.x, filmNdcPos.y - deltaNdc), &dnyRay);
+	genSensedRay(Vector2R(filmNdcPos.x, filmNdcPos.y + deltaNdc), &dpyRay);
+
+	out_result->setRay(sensedRay.getOrigin(), sensedRay.getDirection());
 
-	out_result->setPartialPs((dpxRay.getOrigin() - dnxRay.getOrigin()).divLocal(reciIntervalPx),
-	                         (dpyRay.getOrigin() - dnyRay.getOrigin()).divLocal(reciIntervalPx));
+	out_result->setPartialPs((dpxRay.getOrigin() - dnxRay.getOrigin()).mulLocal(reciIntervalNdc),
+	                         (dpyRay.getOrigin() - dnyRay.getOrigin()).mulLocal(reciIntervalNdc));
 
-	out_result->setPartialDs((dpxRay.getDirection() - dnxRay.getDirection()).divLocal(reciIntervalPx),
-	                         (dpyRay.getDirection() - dnyRay.getDirection()).divLocal(reciIntervalPx));
+	out_result->setPartialDs((dpxRay.getDirection() - dnxRay.getDirection()).mulLocal(reciIntervalNdc),
+	                         (dpyRay.getDirection() - dnyRay.getDirection()).mulLocal(reciIntervalNdc));
 }
 
 void Camera::updateCameraPose(const TVector3<hiReal>& position, const TQuaternion<hiReal>& rotation)
@@ -35,9 +35,11 @@ public:
 	virtual void genSensedRay(const Vector2R& filmNdcPos, Ray* out_ray) const = 0;
 
 	// Given a ray generated by genSensedRay() along with the parameters for it, 
-	// calculates differential information on the origin of the ray.
+	// calculates differential information on the origin of the ray. The 
+	// differentials are with respect to NDC positions on the film.
 	// The default implementation uses numerical differentiation for 
-	// the differentials.
+	// the differentials, which is only valid for cameras that generate
+	// rays deterministically.
 	virtual void calcSensedRayDifferentials(const Vector2R& filmNdcPos, const Ray& sensedRay,
 	                                        RayDifferential* out_result) const;
 
@@ -1,5 +1,6 @@
 #include "Core/Camera/PerspectiveCamera.h"
 #include "Core/Ray.h"
+#include "Core/RayDifferential.h"
 #include "Core/Sample.h"
 #include "Core/Filmic/TSamplingFilm.h"
 #include "FileIO/SDL/InputPacket.h"
@@ -28,6 +29,39 @@ void PerspectiveCamera::updateTransforms()
 	m_cameraToWorld = std::make_shared<StaticAffineTransform>(StaticAffineTransform::makeForward(m_cameraToWorldTransform));
 }
 
+void PerspectiveCamera::calcSensedRayDifferentials(
+	const Vector2R&        filmNdcPos,
+	const Ray&             sensedRay,
+	RayDifferential* const out_result) const
+{
+	PH_ASSERT(out_result);
+
+	// Similar to ray generation, calculations are done in camera space then 
+	// transformed to world space for better numerical precision.
+
+	Vector3R filmPosMM, dFilmPosMMdX, dFilmPosMMdY;
+	m_filmToCamera->transformP(Vector3R(filmNdcPos.x, filmNdcPos.y, 0), &filmPosMM);
+	m_filmToCamera->transformV(Vector3R(1, 0, 0), &dFilmPosMMdX);
+	m_filmToCamera->transformV(Vector3R(0, 1, 0), &dFilmPosMMdY);
+
+	Vector3R unnormalizedDir, dUnnormalizedDirdX, dUnnormalizedDirdY;
+	m_cameraToWorld->transformV(filmPosMM,    &unnormalizedDir);
+	m_cameraToWorld->transformV(dFilmPosMMdX, &dUnnormalizedDirdX);
+	m_cameraToWorld->transformV(dFilmPosMMdY, &dUnnormalizedDirdY);
+
+	// derivative of normalize(v) is (dv - D * dot(D, dv)) / length(v)
+	const real     reciLength = 1.0_r / unnormalizedDir.length();
+	const Vector3R D          = unnormalizedDir.mul(reciLength);
+	const auto calcDirPartial = [&D, reciLength](const Vector3R& dUnnormalizedDir)
+	{
+		return dUnnormalizedDir.sub(D.mul(D.dot(dUnnormalizedDir))).mulLocal(reciLength);
+	};
+
+	out_result->setRay(sensedRay.getOrigin(), sensedRay.getDirection());
+	out_result->setPartialPs(Vector3R(0), Vector3R(0));
+	out_result->setPartialDs(calcDirPartial(dUnnormalizedDirdX), calcDirPartial(dUnnormalizedDirdY));
+}
+
 // command interface
 
 PerspectiveCamera::PerspectiveCamera(const InputPacket& packet) :
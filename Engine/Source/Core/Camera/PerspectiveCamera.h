@@ -28,6 +28,13 @@ public:
 		real* out_filmArea, 
 		real* const out_pdfW) const override = 0;
 
+	// Differentials are calculated for the ray passing through the center 
+	// of the lens; defocus is not considered.
+	void calcSensedRayDifferentials(
+		const Vector2R&  filmNdcPos, 
+		const Ray&       sensedRay,
+		RayDifferential* out_result) const override;
+
 	void setAspectRatio(real ratio) override;
 
 protected:
@@ -1,7 +1,7 @@
 #include "Core/Emitter/DiffuseSurfaceEmitter.h"
 #include "Math/TVector3.h"
 #include "Actor/Geometry/Geometry.h"
-#include "Core/Texture/TConstantTexture.h"
+#include "Core/Texture/ConstantSpectralTexture.h"
 #include "Core/Intersectable/Primitive.h"
 #include "Math/Random.h"
 #include "Core/Sample/PositionSample.h"
@@ -32,9 +32,8 @@ DiffuseSurfaceEmitter::DiffuseSurfaceEmitter(const Primitive* const surface) :
 	const real extendedArea = surface->calcExtendedArea();
 	m_reciExtendedArea = extendedArea > 0.0_r ? 1.0_r / extendedArea : 0.0_r;
 
-	SpectralStrength defaultRadiance;
-	defaultRadiance.setSampled(ColorSpace::get_D65_SPD());
-	setEmittedRadiance(std::make_shared<TConstantTexture<SpectralStrength>>(defaultRadiance));
+	setEmittedRadiance(std::make_shared<ConstantSpectralTexture>(
+		ConstantSpectralStrength(ColorSpace::get_D65_SPD(), EQuantity::RAW)));
 }
 
 void DiffuseSurfaceEmitter::evalEmittedRadiance(const SurfaceHit& X, SpectralStrength* const out_radiance) const
@@ -4,6 +4,9 @@
 #include "Frame/Operator/JRToneMapping.h"
 #include "Core/Filmic/TSamplingFilm.h"
 #include "Common/Logger.h"
+#include "Utility/WorkStealingScheduler.h"
+
+#include <algorithm>
 
 namespace ph
 {
@@ -14,7 +17,8 @@ namespace
 }
 
 Engine::Engine() : 
-	m_renderer(nullptr)
+	m_renderer(nullptr),
+	m_numRenderThreads(0)
 {
 	setNumRenderThreads(1);
 }
@@ -26,6 +30,10 @@ void Engine::enterCommand(const std::string& commandFragment)
 
 void Engine::update()
 {
+	// Threads waiting on tasks run them too, so one less worker is needed.
+	// Cooking and rendering both use the shared scheduler.
+	WorkStealingScheduler::setSharedNumWorkers(std::max(m_numRenderThreads, 1u) - 1);
+
 	// HACK
 	m_data.update(0.0_r);
 
@@ -1,6 +1,7 @@
 #include "Core/Estimator/BNEEPTEstimator.h"
 #include "Common/primitive_type.h"
 #include "Core/Ray.h"
+#include "Core/RayDifferential.h"
 #include "World/Scene.h"
 #include "Math/TVector3.h"
 #include "Core/HitDetail.h"
@@ -32,9 +33,10 @@ namespace ph
 {
 
 void BNEEPTEstimator::estimate(
-	const Ray&        ray,
-	const Integrand&  integrand,
-	EnergyEstimation& out_estimation) const
+	const Ray&             ray,
+	const RayDifferential& rayDifferential,
+	const Integrand&       integrand,
+	EnergyEstimation&      out_estimation) const
 {
 	const Scene&  scene  = integrand.getScene();
 	const Camera& camera = integrand.getCamera();
@@ -65,6 +67,10 @@ void BNEEPTEstimator::estimate(
 	{
 		surfaceHit = SurfaceHit(tracingRay, hitProbe);
 
+		RayDifferential tracingRayDifferential(rayDifferential);
+		tracingRayDifferential.reverse();
+		surfaceHit.setIncidentRayDifferential(tracingRayDifferential);
+
 		// sidedness agreement between real geometry and shading normal
 		//
 		V = tracingRay.getDirection().mul(-1.0_r);
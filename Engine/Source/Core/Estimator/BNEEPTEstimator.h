@@ -28,9 +28,10 @@ public:
 	void update(const Integrand& integrand) override;
 
 	void estimate(
-		const Ray&        ray,
-		const Integrand&  integrand,
-		EnergyEstimation& out_estimation) const override;
+		const Ray&             ray,
+		const RayDifferential& rayDifferential,
+		const Integrand&       integrand,
+		EnergyEstimation&      out_estimation) const override;
 
 private:
 	static void rationalClamp(SpectralStrength& value);
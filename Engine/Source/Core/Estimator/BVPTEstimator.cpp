@@ -1,5 +1,6 @@
 #include "Core/Estimator/BVPTEstimator.h"
 #include "Core/Ray.h"
+#include "Core/RayDifferential.h"
 #include "Core/HitDetail.h"
 #include "Core/SurfaceHit.h"
 #include "Core/Intersectable/PrimitiveMetadata.h"
@@ -26,9 +27,10 @@ namespace ph
 {
 
 void BVPTEstimator::estimate(
-	const Ray&        ray,
-	const Integrand&  integrand,
-	EnergyEstimation& out_estimation) const
+	const Ray&             ray,
+	const RayDifferential& rayDifferential,
+	const Integrand&       integrand,
+	EnergyEstimation&      out_estimation) const
 {
 	const auto& surfaceEventDispatcher = TSurfaceEventDispatcher<ESaPolicy::DO_NOT_CARE>(&(integrand.getScene()));
 
@@ -41,10 +43,19 @@ void BVPTEstimator::estimate(
 	tracingRay.setMinT(0.0001_r);// HACK: hard-coded number
 	tracingRay.setMaxT(std::numeric_limits<real>::max());
 
+	RayDifferential tracingRayDifferential(rayDifferential);
+	tracingRayDifferential.reverse();
+
 	SurfaceHit surfaceHit;
 	while(numBounces <= MAX_RAY_BOUNCES && 
 	      surfaceEventDispatcher.traceNextSurface(tracingRay, &surfaceHit))
 	{
+		// only the first hit is seen through a pixel
+		if(numBounces == 0)
+		{
+			surfaceHit.setIncidentRayDifferential(tracingRayDifferential);
+		}
+
 		const auto* const     metadata            = surfaceHit.getDetail().getPrimitive()->getMetadata();
 		const SurfaceBehavior& hitSurfaceBehavior = metadata->getSurface();
 
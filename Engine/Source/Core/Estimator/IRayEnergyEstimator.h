@@ -14,9 +14,10 @@ public:
 	void update(const Integrand& integrand) override = 0;
 
 	void estimate(
-		const Ray&        ray, 
-		const Integrand&  integrand, 
-		EnergyEstimation& out_estimation) const override = 0;
+		const Ray&             ray, 
+		const RayDifferential& rayDifferential,
+		const Integrand&       integrand, 
+		EnergyEstimation&      out_estimation) const override = 0;
 };
 
 }// end namespace ph
\ No newline at end of file
@@ -6,6 +6,7 @@ namespace ph
 {
 
 class Ray;
+class RayDifferential;
 class Integrand;
 
 template<typename EstimationType>
@@ -16,8 +17,11 @@ public:
 
 	virtual void update(const Integrand& integrand) = 0;
 
+	// Estimates along <ray>; <rayDifferential> is for the ray and can be 
+	// zero if unknown.
 	virtual void estimate(
 		const Ray&                        ray, 
+		const RayDifferential&            rayDifferential,
 		const Integrand&                  integrand, 
 		TEstimationArray<EstimationType>& out_estimation) const = 0;
 };
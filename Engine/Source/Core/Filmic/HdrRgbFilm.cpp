@@ -88,20 +88,64 @@ void HdrRgbFilm::addSample(
 	TVector2<int64> x1y1(filterMax.sub(0.5).floor());
 	x1y1.x += 1;
 	x1y1.y += 1;
+	if(x0y0.x >= x1y1.x || x0y0.y >= x1y1.y)
+	{
+		return;
+	}
+
+	const SampleFilter& filter      = getFilter();
+	const int64         footprintW  = x1y1.x - x0y0.x;
+	const std::size_t   effectiveW  = static_cast<std::size_t>(getEffectiveResPx().x);
+	const float64       filterBaseX = xPx - 0.5;
+	const float64       filterBaseY = yPx - 0.5;
+
+	if(filter.isSeparable() && footprintW <= MAX_SEPARABLE_FOOTPRINT_PX)
+	{
+		// Column weights are shared by all rows of the footprint, only the
+		// per-row factor differs.
+		float64 xWeights[MAX_SEPARABLE_FOOTPRINT_PX];
+		for(int64 i = 0; i < footprintW; ++i)
+		{
+			xWeights[i] = filter.evaluateX(static_cast<float64>(x0y0.x + i) - filterBaseX);
+		}
+
+		const float64 submergeAmount = filter.getSubmergeAmount();
+		const float64 minWeight      = filter.getMinWeight();
+		for(int64 y = x0y0.y; y < x1y1.y; y++)
+		{
+			const float64 yWeight = filter.evaluateY(static_cast<float64>(y) - filterBaseY);
+
+			const std::size_t fy = y - getEffectiveWindowPx().minVertex.y;
+			const std::size_t fx = x0y0.x - getEffectiveWindowPx().minVertex.x;
+			RadianceSensor* const sensors = &(m_pixelRadianceSensors[fy * effectiveW + fx]);
+
+			// a straight multiply-add over contiguous sensors, which compilers 
+			// can vectorize
+			for(int64 i = 0; i < footprintW; ++i)
+			{
+				const float64 weight = std::max(xWeights[i] * yWeight - submergeAmount, minWeight);
+
+				sensors[i].accuR      += rgb.x * weight;
+				sensors[i].accuG      += rgb.y * weight;
+				sensors[i].accuB      += rgb.z * weight;
+				sensors[i].accuWeight += weight;
+			}
+		}
+		return;
+	}
 
 	for(int64 y = x0y0.y; y < x1y1.y; y++)
 	{
 		for(int64 x = x0y0.x; x < x1y1.x; x++)
 		{
-			// TODO: factor out the -0.5 part
-			const float64 filterX = x - (xPx - 0.5);
-			const float64 filterY = y - (yPx - 0.5);
+			const float64 filterX = x - filterBaseX;
+			const float64 filterY = y - filterBaseY;
 
 			const std::size_t fx = x - getEffectiveWindowPx().minVertex.x;
 			const std::size_t fy = y - getEffectiveWindowPx().minVertex.y;
-			const std::size_t index = fy * static_cast<std::size_t>(getEffectiveResPx().x) + fx;
+			const std::size_t index = fy * effectiveW + fx;
 			
-			const float64 weight = getFilter().evaluate(filterX, filterY);
+			const float64 weight = filter.evaluate(filterX, filterY);
 
 			m_pixelRadianceSensors[index].accuR      += rgb.x * weight;
 			m_pixelRadianceSensors[index].accuG      += rgb.y * weight;
@@ -147,21 +191,19 @@ void HdrRgbFilm::developRegion(HdrRgbFrame& out_frame, const TAABB2D<int64>& reg
 
 	TAABB2D<int64> frameIndexBound(getEffectiveWindowPx());
 	frameIndexBound.intersectWith(regionPx);
-	frameIndexBound.maxVertex.subLocal(1);
+	if(!frameIndexBound.isArea())
+	{
+		return;
+	}
 
 	float64     sensorR, sensorG, sensorB;
 	float64     reciWeight;
 	std::size_t fx, fy, filmIndex;
 
-	for(int64 y = 0; y < getActualResPx().y; y++)
+	for(int64 y = frameIndexBound.minVertex.y; y < frameIndexBound.maxVertex.y; y++)
 	{
-		for(int64 x = 0; x < getActualResPx().x; x++)
+		for(int64 x = frameIndexBound.minVertex.x; x < frameIndexBound.maxVertex.x; x++)
 		{
-			if(!frameIndexBound.isIntersectingArea({x, y}))
-			{
-				continue;
-			}
-
 			fx = x - getEffectiveWindowPx().minVertex.x;
 			fy = y - getEffectiveWindowPx().minVertex.y;
 			filmIndex = fy * static_cast<std::size_t>(getEffectiveResPx().x) + fx;
@@ -190,10 +232,43 @@ void HdrRgbFilm::clear()
 	std::fill(m_pixelRadianceSensors.begin(), m_pixelRadianceSensors.end(), RadianceSensor());
 }
 
+void HdrRgbFilm::clear(const TAABB2D<int64>& regionPx)
+{
+	TAABB2D<int64> validRegion(getEffectiveWindowPx());
+	validRegion.intersectWith(regionPx);
+	if(!validRegion.isArea())
+	{
+		return;
+	}
+
+	const std::size_t effectiveW = static_cast<std::size_t>(getEffectiveResPx().x);
+	for(int64 y = validRegion.minVertex.y; y < validRegion.maxVertex.y; ++y)
+	{
+		const std::size_t baseIndex = 
+			static_cast<std::size_t>(y - getEffectiveWindowPx().minVertex.y) * effectiveW + 
+			static_cast<std::size_t>(validRegion.minVertex.x - getEffectiveWindowPx().minVertex.x);
+
+		std::fill(
+			m_pixelRadianceSensors.begin() + baseIndex,
+			m_pixelRadianceSensors.begin() + baseIndex + static_cast<std::size_t>(validRegion.getWidth()),
+			RadianceSensor());
+	}
+}
+
 void HdrRgbFilm::mergeWith(const HdrRgbFilm& other)
+{
+	mergeWith(other, other.getEffectiveWindowPx());
+}
+
+void HdrRgbFilm::mergeWith(const HdrRgbFilm& other, const TAABB2D<int64>& regionPx)
 {
 	TAABB2D<int64> validRegion(this->getEffectiveWindowPx());
 	validRegion.intersectWith(other.getEffectiveWindowPx());
+	validRegion.intersectWith(regionPx);
+	if(!validRegion.isArea())
+	{
+		return;
+	}
 
 	for(int64 y = validRegion.minVertex.y; y < validRegion.maxVertex.y; ++y)
 	{
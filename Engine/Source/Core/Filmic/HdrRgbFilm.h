@@ -44,6 +44,12 @@ public:
 	void addSample(float64 xPx, float64 yPx, const Vector3R& rgb);
 	void mergeWith(const HdrRgbFilm& other);
 
+	// Clears only the part of the film that lies within <regionPx>.
+	void clear(const TAABB2D<int64>& regionPx);
+
+	// Merges only the part of <other> that lies within <regionPx>.
+	void mergeWith(const HdrRgbFilm& other, const TAABB2D<int64>& regionPx);
+
 	HdrRgbFilm& operator = (HdrRgbFilm&& other);
 
 	// HACK
@@ -55,6 +61,10 @@ private:
 	std::vector<RadianceSensor> m_pixelRadianceSensors;
 
 	void resizeRadianceSensorBuffer();
+
+	// Separable filters with footprints up to this width are splatted with 
+	// precomputed per-column weights.
+	static constexpr int64 MAX_SEPARABLE_FOOTPRINT_PX = 32;
 };
 
 }// end namespace ph
\ No newline at end of file
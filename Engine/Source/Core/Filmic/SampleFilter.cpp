@@ -1,42 +1,108 @@
 #include "Core/Filmic/SampleFilter.h"
 #include "Common/assertion.h"
 
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <utility>
+
 namespace ph
 {
 
+SampleFilter SampleFilter::makeSeparable(
+	const std::shared_ptr<TMathFunction2D<float64>>& filter,
+	const float64 widthPx, const float64 heightPx,
+	const float64 submergeAmount)
+{
+	PH_ASSERT(filter);
+
+	SampleFilter separableFilter(filter, widthPx, heightPx);
+
+	// For f(x, y) = g(x) * h(y), we have f(x, 0) * f(0, y) / f(0, 0) = f(x, y),
+	// so each factor can be tabulated as a slice through the origin scaled 
+	// by 1 / sqrt(f(0, 0)).
+	const float64 originValue = filter->evaluate(0, 0);
+	if(!(originValue > 0))
+	{
+		std::cerr << "warning: at SampleFilter::makeSeparable(), "
+		          << "filter is not positive at origin, cannot be tabulated" << std::endl;
+		return separableFilter;
+	}
+	const float64 reciSqrtOriginValue = 1.0 / std::sqrt(originValue);
+
+	const auto tabulate = [&filter, reciSqrtOriginValue](const float64 halfSizePx, const bool isXAxis)
+	{
+		const std::size_t numEntries = static_cast<std::size_t>(std::ceil(halfSizePx * TABLE_ENTRIES_PER_PX)) + 1;
+		const float64     stepPx     = halfSizePx / static_cast<float64>(numEntries - 1);
+
+		auto table = std::make_shared<WeightTable>(numEntries);
+		for(std::size_t i = 0; i < numEntries; ++i)
+		{
+			const float64 px = static_cast<float64>(i) * stepPx;
+			(*table)[i] = (isXAxis ? filter->evaluate(px, 0) : filter->evaluate(0, px)) * reciSqrtOriginValue;
+		}
+		return std::make_pair(std::shared_ptr<const WeightTable>(std::move(table)), 1.0 / stepPx);
+	};
+
+	const auto xTable = tabulate(separableFilter.m_halfSizePx.x, true);
+	const auto yTable = tabulate(separableFilter.m_halfSizePx.y, false);
+	separableFilter.m_xWeights        = xTable.first;
+	separableFilter.m_yWeights        = yTable.first;
+	separableFilter.m_reciTableStepPx = TVector2<float64>(xTable.second, yTable.second);
+	separableFilter.m_submergeAmount  = submergeAmount;
+	separableFilter.m_minWeight       = submergeAmount > 0 ? 0.0 : -std::numeric_limits<float64>::infinity();
+
+	return separableFilter;
+}
+
 SampleFilter::SampleFilter(const std::shared_ptr<TMathFunction2D<float64>>& filter,
                            const float64 widthPx, const float64 heightPx) :
-	m_filter    (filter),
-	m_sizePx    (widthPx, heightPx),
-	m_halfSizePx(widthPx * 0.5, heightPx * 0.5)
+	m_filter         (filter),
+	m_sizePx         (widthPx, heightPx),
+	m_halfSizePx     (widthPx * 0.5, heightPx * 0.5),
+	m_xWeights       (nullptr),
+	m_yWeights       (nullptr),
+	m_reciTableStepPx(0),
+	m_submergeAmount (0),
+	m_minWeight      (0)
 {
 	PH_ASSERT(filter);
 }
 
 SampleFilter::SampleFilter(const SampleFilter& other) :
-	m_filter    (other.m_filter),
-	m_sizePx    (other.m_sizePx),
-	m_halfSizePx(other.m_halfSizePx)
+	m_filter         (other.m_filter),
+	m_sizePx         (other.m_sizePx),
+	m_halfSizePx     (other.m_halfSizePx),
+	m_xWeights       (other.m_xWeights),
+	m_yWeights       (other.m_yWeights),
+	m_reciTableStepPx(other.m_reciTableStepPx),
+	m_submergeAmount (other.m_submergeAmount),
+	m_minWeight      (other.m_minWeight)
 {}
 
 SampleFilter::SampleFilter(SampleFilter&& other) : 
-	m_filter    (std::move(other.m_filter)),
-	m_sizePx    (other.m_sizePx), 
-	m_halfSizePx(other.m_halfSizePx)
+	m_filter         (std::move(other.m_filter)),
+	m_sizePx         (other.m_sizePx), 
+	m_halfSizePx     (other.m_halfSizePx),
+	m_xWeights       (std::move(other.m_xWeights)),
+	m_yWeights       (std::move(other.m_yWeights)),
+	m_reciTableStepPx(other.m_reciTableStepPx),
+	m_submergeAmount (other.m_submergeAmount),
+	m_minWeight      (other.m_minWeight)
 {}
 
-float64 SampleFilter::evaluate(const float64 xPx, const float64 yPx) const
-{
-	return m_filter->evaluate(xPx, yPx);
-}
-
 SampleFilter& SampleFilter::operator = (const SampleFilter& rhs)
 {
-	m_filter     = rhs.m_filter;
-	m_sizePx     = rhs.m_sizePx;
-	m_halfSizePx = rhs.m_halfSizePx;
+	m_filter          = rhs.m_filter;
+	m_sizePx          = rhs.m_sizePx;
+	m_halfSizePx      = rhs.m_halfSizePx;
+	m_xWeights        = rhs.m_xWeights;
+	m_yWeights        = rhs.m_yWeights;
+	m_reciTableStepPx = rhs.m_reciTableStepPx;
+	m_submergeAmount  = rhs.m_submergeAmount;
+	m_minWeight       = rhs.m_minWeight;
 
 	return *this;
 }
 
-}// end namespace ph
\ No newline at end of file
+}// end namespace ph
@@ -1,16 +1,34 @@
 #pragma once
 
 #include "Common/primitive_type.h"
+#include "Common/assertion.h"
 #include "Math/Function/TMathFunction2D.h"
 #include "Math/TVector2.h"
 
 #include <memory>
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace ph
 {
 
 class SampleFilter final
 {
+public:
+	// Creates a filter from a function that can be written as g(x) * h(y) 
+	// (both g and h being even functions). The filter evaluates to 
+	// max(<filter>(x, y) - <submergeAmount>, 0) if <submergeAmount> is 
+	// positive, and to <filter>(x, y) otherwise. The 1-D factors g and h are 
+	// tabulated once here, so evaluating the filter requires no call to 
+	// <filter> afterwards.
+	static SampleFilter makeSeparable(
+		const std::shared_ptr<TMathFunction2D<float64>>& filter,
+		float64 widthPx, float64 heightPx,
+		float64 submergeAmount = 0.0);
+
 public:
 	SampleFilter() = default;
 	SampleFilter(const std::shared_ptr<TMathFunction2D<float64>>& filter,
@@ -20,6 +38,16 @@ public:
 
 	float64 evaluate(float64 xPx, float64 yPx) const;
 
+	// Separable filters evaluate to max(evaluateX(x) * evaluateY(y) - 
+	// getSubmergeAmount(), getMinWeight()), where the minimum weight is 0 for 
+	// submerged filters and -infinity otherwise (so negative lobes are kept).
+	// Methods for the 1-D factors are only valid for separable filters.
+	bool isSeparable() const;
+	float64 evaluateX(float64 xPx) const;
+	float64 evaluateY(float64 yPx) const;
+	float64 getSubmergeAmount() const;
+	float64 getMinWeight() const;
+
 	inline const TVector2<float64>& getSizePx() const
 	{
 		return m_sizePx;
@@ -33,9 +61,82 @@ public:
 	SampleFilter& operator = (const SampleFilter& rhs);
 
 private:
+	// Samples of a 1-D filter factor over [0, half filter size], evenly spaced.
+	using WeightTable = std::vector<float64>;
+
 	std::shared_ptr<TMathFunction2D<float64>> m_filter;
 	TVector2<float64>                         m_sizePx;
 	TVector2<float64>                         m_halfSizePx;
+	std::shared_ptr<const WeightTable>        m_xWeights;
+	std::shared_ptr<const WeightTable>        m_yWeights;
+	TVector2<float64>                         m_reciTableStepPx;
+	float64                                   m_submergeAmount;
+	float64                                   m_minWeight;
+
+	static float64 lookupWeight(const WeightTable& table, float64 reciStepPx, float64 absPx);
+
+	static constexpr std::size_t TABLE_ENTRIES_PER_PX = 256;
 };
 
-}// end namespace ph
\ No newline at end of file
+// In-header Implementations:
+
+inline float64 SampleFilter::evaluate(const float64 xPx, const float64 yPx) const
+{
+	if(isSeparable())
+	{
+		return std::max(evaluateX(xPx) * evaluateY(yPx) - m_submergeAmount, m_minWeight);
+	}
+	else
+	{
+		return m_filter->evaluate(xPx, yPx);
+	}
+}
+
+inline bool SampleFilter::isSeparable() const
+{
+	return m_xWeights != nullptr;
+}
+
+inline float64 SampleFilter::evaluateX(const float64 xPx) const
+{
+	PH_ASSERT(isSeparable());
+
+	return lookupWeight(*m_xWeights, m_reciTableStepPx.x, std::abs(xPx));
+}
+
+inline float64 SampleFilter::evaluateY(const float64 yPx) const
+{
+	PH_ASSERT(isSeparable());
+
+	return lookupWeight(*m_yWeights, m_reciTableStepPx.y, std::abs(yPx));
+}
+
+inline float64 SampleFilter::getSubmergeAmount() const
+{
+	return m_submergeAmount;
+}
+
+inline float64 SampleFilter::getMinWeight() const
+{
+	return m_minWeight;
+}
+
+inline float64 SampleFilter::lookupWeight(const WeightTable& table, const float64 reciStepPx, const float64 absPx)
+{
+	PH_ASSERT_GE(table.size(), 2);
+
+	// linearly interpolate nearby entries; beyond the table the last entry 
+	// is used
+
+	const float64     fIndex = absPx * reciStepPx;
+	const std::size_t index  = static_cast<std::size_t>(fIndex);
+	if(index >= table.size() - 1)
+	{
+		return table.back();
+	}
+
+	const float64 t = fIndex - static_cast<float64>(index);
+	return table[index] + t * (table[index + 1] - table[index]);
+}
+
+}// end namespace ph
@@ -41,7 +41,7 @@ SampleFilter SampleFilters::createBoxFilter()
 	const float64 constantValue = 1.0;
 	auto constantFunc = std::make_unique<TConstant2D<float64>>(constantValue);
 
-	return SampleFilter(std::move(constantFunc), 1.0, 1.0);
+	return SampleFilter::makeSeparable(std::move(constantFunc), 1.0, 1.0);
 }
 
 SampleFilter SampleFilters::createGaussianFilter()
@@ -59,9 +59,9 @@ SampleFilter SampleFilters::createGaussianFilter()
 	// NOTE: is submerging gaussian filter really make sense?
 	// see this thread for more discussion:
 	// https://developer.blender.org/D1453
-	gaussianFunc->setSubmergeAmount(edgeValue);
-
-	return SampleFilter(std::move(gaussianFunc), filterSize, filterSize);
+	// (submerging is done by the sample filter, as a submerged Gaussian is 
+	// not separable anymore)
+	return SampleFilter::makeSeparable(std::move(gaussianFunc), filterSize, filterSize, edgeValue);
 }
 
 SampleFilter SampleFilters::createMitchellNetravaliFilter()
@@ -76,7 +76,7 @@ SampleFilter SampleFilters::createMitchellNetravaliFilter()
 
 	auto mnCubicFunc = std::make_unique<TMNCubic2D<float64>>(b, c);
 
-	return SampleFilter(std::move(mnCubicFunc), 4.0, 4.0);
+	return SampleFilter::makeSeparable(std::move(mnCubicFunc), 4.0, 4.0);
 }
 
 SampleFilter SampleFilters::createBlackmanHarrisFilter()
@@ -85,7 +85,7 @@ SampleFilter SampleFilters::createBlackmanHarrisFilter()
 
 	auto bhFunc = std::make_unique<TBlackmanHarris2D<float64>>(radius);
 
-	return SampleFilter(std::move(bhFunc), radius * 2.0, radius * 2.0);
+	return SampleFilter::makeSeparable(std::move(bhFunc), radius * 2.0, radius * 2.0);
 }
 
 }// end namespace ph
\ No newline at end of file
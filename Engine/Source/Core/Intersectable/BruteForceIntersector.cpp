@@ -61,11 +61,11 @@ bool BruteForceIntersector::isIntersecting(const Ray& ray, HitProbe& probe) cons
 	}
 }
 
-bool BruteForceIntersector::isIntersecting(const Ray& ray) const
+bool BruteForceIntersector::isOccluded(const Ray& ray) const
 {
 	for(const Intersectable* intersectable : m_intersectables)
 	{
-		if(intersectable->isIntersecting(ray))
+		if(intersectable->isOccluded(ray))
 		{
 			return true;
 		}
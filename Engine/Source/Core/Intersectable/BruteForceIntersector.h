@@ -17,7 +17,7 @@ public:
 
 	virtual void update(const CookedDataStorage& cookedActors) override;
 	virtual bool isIntersecting(const Ray& ray, HitProbe& probe) const override;
-	virtual bool isIntersecting(const Ray& ray) const override;
+	virtual bool isOccluded(const Ray& ray) const override;
 	virtual void calcAABB(AABB3D* out_aabb) const override;
 
 private:
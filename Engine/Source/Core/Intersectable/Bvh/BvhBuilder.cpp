@@ -1,400 +1,718 @@
 #include "Core/Intersectable/Bvh/BvhBuilder.h"
-#include "Core/Intersectable/Bvh/BvhInfoNode.h"
 #include "Core/Intersectable/Intersectable.h"
+#include "Utility/TaskGroup.h"
+#include "Utility/WorkStealingScheduler.h"
+#include "Utility/concurrent.h"
 #include "Math/TVector3.h"
+#include "Math/math.h"
 #include "Common/assertion.h"
 
 #include <iostream>
 #include <algorithm>
+#include <numeric>
+#include <limits>
 
 namespace ph
 {
 
+namespace
+{
+
+constexpr real SAH_TRAVERSAL_COST = 1.0_r / 8.0_r;
+constexpr real SAH_INTERSECT_COST = 1.0_r;
+
+// Nodes with more intersectables than this are always split, even if the
+// split is considered worse than making a leaf.
+constexpr std::size_t MAX_LEAF_INTERSECTABLES = 256;
+
+// Intersectables sharing the same Morton code are kept in a leaf up to this
+// amount.
+constexpr std::size_t MAX_LBVH_LEAF_INTERSECTABLES = 4;
+
+constexpr std::size_t NUM_SAH_BUCKETS = 32;
+
+/*
+	Bounds are stored as plain 4-element arrays (the last element is unused)
+	so merging buckets compiles to packed min/max instructions.
+*/
 class BvhSahBucket final
 {
 public:
-	AABB3D      aabb;
+	alignas(4 * sizeof(real)) real minVertex[4];
+	alignas(4 * sizeof(real)) real maxVertex[4];
 	std::size_t numIntersectables;
 
-	BvhSahBucket() : aabb(), numIntersectables(0) {}
-	bool isEmpty() { return numIntersectables == 0; }
-};
-
-BvhBuilder::BvhBuilder(const EBvhType type) : 
-	m_type(type)
-{}
+	BvhSahBucket() :
+		minVertex{ std::numeric_limits<real>::max(),  std::numeric_limits<real>::max(),  std::numeric_limits<real>::max(), 0},
+		maxVertex{-std::numeric_limits<real>::max(), -std::numeric_limits<real>::max(), -std::numeric_limits<real>::max(), 0},
+		numIntersectables(0)
+	{}
 
-const BvhInfoNode* BvhBuilder::buildInformativeBinaryBvh(const std::vector<const Intersectable*>& intersectables)
-{
-	m_infoNodes.clear();
-	m_infoNodes.shrink_to_fit();
+	bool isEmpty() const { return numIntersectables == 0; }
 
-	std::vector<BvhIntersectableInfo> intersectableInfos(intersectables.size());
-	for(std::size_t i = 0; i < intersectables.size(); i++)
+	void add(const AABB3D& aabb)
 	{
-		intersectableInfos[i] = BvhIntersectableInfo(intersectables[i], i);
+		for(int i = 0; i < 3; ++i)
+		{
+			minVertex[i] = std::min(minVertex[i], aabb.getMinVertex()[i]);
+			maxVertex[i] = std::max(maxVertex[i], aabb.getMaxVertex()[i]);
+		}
+		++numIntersectables;
 	}
 
-	const BvhInfoNode* rootNode = nullptr;
-
-	if(m_type == EBvhType::HALF)
+	void merge(const BvhSahBucket& other)
 	{
-		rootNode = buildBinaryBvhInfoNodeRecursive(intersectableInfos, 
-		                                           ENodeSplitMethod::EQUAL_INTERSECTABLES);
+		for(int i = 0; i < 4; ++i)
+		{
+			minVertex[i] = std::min(minVertex[i], other.minVertex[i]);
+			maxVertex[i] = std::max(maxVertex[i], other.maxVertex[i]);
+		}
+		numIntersectables += other.numIntersectables;
 	}
-	else if(m_type == EBvhType::SAH_BUCKET)
+
+	real getSurfaceArea() const
 	{
-		rootNode = buildBinaryBvhInfoNodeRecursive(intersectableInfos, 
-		                                           ENodeSplitMethod::SAH_BUCKETS);
+		if(isEmpty())
+		{
+			return 0.0_r;
+		}
+
+		const real dx = maxVertex[0] - minVertex[0];
+		const real dy = maxVertex[1] - minVertex[1];
+		const real dz = maxVertex[2] - minVertex[2];
+		return 2.0_r * (dx * dy + dy * dz + dz * dx);
 	}
-	else
+};
+
+// Spreads the lower 10 bits of <value> such that there are two zero bits
+// between each of them.
+inline uint32 spread_bits_by_2(uint32 value)
+{
+	value = (value | (value << 16)) & 0x030000FF;
+	value = (value | (value <<  8)) & 0x0300F00F;
+	value = (value | (value <<  4)) & 0x030C30C3;
+	value = (value | (value <<  2)) & 0x09249249;
+	return value;
+}
+
+std::size_t calc_max_depth_recursive(const std::vector<BvhLinearNode>& linearNodes, const std::size_t nodeIndex)
+{
+	const BvhLinearNode& node = linearNodes[nodeIndex];
+	if(node.isLeaf())
 	{
-		std::cerr << "warning: at BvhBuilder::buildInformativeBinaryBvh(), " 
-		          << "unsupported BVH type specified" << std::endl;
+		return 0;
 	}
 
-	return rootNode;
+	const std::size_t depthA = calc_max_depth_recursive(linearNodes, nodeIndex + 1);
+	const std::size_t depthB = calc_max_depth_recursive(linearNodes, node.secondChildOffset);
+	return 1 + std::max(depthA, depthB);
 }
 
-void BvhBuilder::buildLinearDepthFirstBinaryBvh(const BvhInfoNode* const rootNode,
-                                                std::vector<BvhLinearNode>* const out_linearNodes,
-                                                std::vector<const Intersectable*>* const out_intersectables)
+// Depth of the most balanced binary tree with <numLeaves> leaves.
+std::size_t calc_min_depth(const std::size_t numLeaves)
 {
-	PH_ASSERT_MSG(rootNode != nullptr, "input node cannot be nullptr");
+	return numLeaves > 1 ? math::log2_floor(numLeaves - 1) + 1 : 0;
+}
 
-	m_linearNodes.clear();
-	m_linearNodes.shrink_to_fit();
-	m_linearNodes.reserve(calcTotalNodes(rootNode));
-	m_intersectables.clear();
-	m_intersectables.shrink_to_fit();
-	m_intersectables.reserve(calcTotalIntersectables(rootNode));
+}// end anonymous namespace
 
-	buildBinaryBvhLinearDepthFirstNodeRecursive(rootNode, nullptr);
+BvhBuilder::BvhBuilder(const EBvhType type) :
+	BvhBuilder(type, WorkStealingScheduler::getShared().numWorkers() + 1)
+{}
+
+BvhBuilder::BvhBuilder(const EBvhType type, const std::size_t numThreads) :
+	m_type(type),
+	m_numThreads(std::max(numThreads, std::size_t(1))),
+	m_infos(),
+	m_infoIndices(),
+	m_mortonCodes(),
+	m_nodeSlots(),
+	m_isSlotUsed(),
+	m_subtreeTasks(nullptr)
+{}
+
+void BvhBuilder::buildLinearDepthFirstBinaryBvh(
+	const std::vector<const Intersectable*>& intersectables,
+	std::vector<BvhLinearNode>* const        out_linearNodes,
+	std::vector<const Intersectable*>* const out_intersectables)
+{
+	PH_ASSERT(out_linearNodes && out_intersectables);
 
-	out_linearNodes->clear();
-	out_linearNodes->shrink_to_fit();
 	out_intersectables->clear();
 	out_intersectables->shrink_to_fit();
 
-	m_linearNodes.swap(*out_linearNodes);
-	m_intersectables.swap(*out_intersectables);
+	const std::size_t numIntersectables = intersectables.size();
+
+	std::vector<AABB3D> aabbs(numIntersectables);
+	const auto calcAABBs = [&intersectables, &aabbs](const std::size_t begin, const std::size_t end)
+	{
+		for(std::size_t i = begin; i < end; ++i)
+		{
+			intersectables[i]->calcAABB(&aabbs[i]);
+		}
+	};
+
+	if(m_numThreads > 1 && numIntersectables >= PARALLEL_BUILD_THRESHOLD)
+	{
+		parallel_for(0, numIntersectables, PARALLEL_BUILD_THRESHOLD, calcAABBs);
+	}
+	else
+	{
+		calcAABBs(0, numIntersectables);
+	}
+
+	std::vector<std::size_t> intersectableIndices;
+	buildLinearDepthFirstBinaryBvh(aabbs, out_linearNodes, &intersectableIndices);
+
+	out_intersectables->reserve(intersectableIndices.size());
+	for(const std::size_t intersectableIndex : intersectableIndices)
+	{
+		out_intersectables->push_back(intersectables[intersectableIndex]);
+	}
 }
 
-const BvhInfoNode* BvhBuilder::buildBinaryBvhInfoNodeRecursive(const std::vector<BvhIntersectableInfo>& intersectables, 
-                                                               const ENodeSplitMethod splitMethod)
+void BvhBuilder::buildLinearDepthFirstBinaryBvh(
+	const std::vector<AABB3D>&        itemAABBs,
+	std::vector<BvhLinearNode>* const out_linearNodes,
+	std::vector<std::size_t>* const   out_itemIndices)
 {
-	m_infoNodes.push_back(std::make_unique<BvhInfoNode>());
-	BvhInfoNode* node = m_infoNodes.back().get();
+	PH_ASSERT(out_linearNodes && out_itemIndices);
 
-	AABB3D nodeAABB(intersectables.empty() ? AABB3D() : intersectables.front().aabb);
-	for(const auto& intersectable : intersectables)
+	out_linearNodes->clear();
+	out_linearNodes->shrink_to_fit();
+	out_itemIndices->clear();
+	out_itemIndices->shrink_to_fit();
+
+	if(itemAABBs.empty())
 	{
-		nodeAABB = AABB3D::makeUnioned(nodeAABB, intersectable.aabb);
+		std::cerr << "warning: at BvhBuilder::buildLinearDepthFirstBinaryBvh(), "
+		          << "no intersectable to build" << std::endl;
+		return;
 	}
 
-	if(intersectables.size() <= 1)
-	{
-		*node = BvhInfoNode::makeBinaryLeaf(intersectables, nodeAABB);
+	const std::size_t numIntersectables = itemAABBs.size();
 
-		if(intersectables.empty())
-		{
-			std::cerr << "warning: at BvhBuilder::buildBinaryBvhNodeRecursive(), " 
-			          << "leaf node without primitive detected" << std::endl;
-		}
+	const bool isParallel = m_numThreads > 1 && numIntersectables >= PARALLEL_BUILD_THRESHOLD;
+
+	TaskGroup subtreeTasks;
+	m_subtreeTasks = isParallel ? &subtreeTasks : nullptr;
+
+	m_infos.resize(numIntersectables);
+	for(std::size_t i = 0; i < numIntersectables; ++i)
+	{
+		m_infos[i] = BvhIntersectableInfo(itemAABBs[i], i);
 	}
-	else
+
+	m_infoIndices.resize(numIntersectables);
+	std::iota(m_infoIndices.begin(), m_infoIndices.end(), 0);
+
+	if(m_type == EBvhType::LBVH)
 	{
-		AABB3D centroidsAABB(intersectables.front().aabbCentroid);
-		for(const auto& intersectable : intersectables)
+		AABB3D centroidsAABB(m_infos.front().aabbCentroid);
+		for(const auto& info : m_infos)
 		{
-			centroidsAABB = AABB3D::makeUnioned(centroidsAABB, intersectable.aabbCentroid);
+			centroidsAABB.unionWith(info.aabbCentroid);
 		}
 
-		Vector3R extents = centroidsAABB.getExtents();
-		if(extents.hasNegativeComponent())
-		{
-			std::cerr << "warning: at BvhBuilder::buildBinaryBvhNodeRecursive(), " 
-			          << "negative AABB extent detected" << std::endl;
-			extents.absLocal();
-		}
+		computeMortonCodes(centroidsAABB);
+	}
 
-		const int32 maxDimension = extents.maxDimension();
+	// A binary tree with n leaves has 2n - 1 nodes. Every subtree is given
+	// enough slots for the case where each leaf has only one intersectable,
+	// so node positions can be determined without synchronization; unused
+	// slots are removed afterwards.
+	m_nodeSlots.assign(2 * numIntersectables - 1, BvhLinearNode());
+	m_isSlotUsed.assign(2 * numIntersectables - 1, 0);
 
-		if(centroidsAABB.getMinVertex()[maxDimension] == centroidsAABB.getMaxVertex()[maxDimension])
-		{
-			*node = BvhInfoNode::makeBinaryLeaf(intersectables, nodeAABB);
-		}
-		else
-		{
-			bool isSplitSuccess = false;
-			std::vector<BvhIntersectableInfo> intersectablesA;
-			std::vector<BvhIntersectableInfo> intersectablesB;
+	buildNodeRecursive(0, 0, numIntersectables, 0);
+	subtreeTasks.wait();
 
-			switch(splitMethod)
-			{
+	compactNodeSlots(out_linearNodes);
 
-			case ENodeSplitMethod::EQUAL_INTERSECTABLES:
-				isSplitSuccess = splitWithEqualIntersectables(intersectables, maxDimension, 
-				                                              &intersectablesA, &intersectablesB);
-				break;
+	out_itemIndices->reserve(numIntersectables);
+	for(const std::size_t infoIndex : m_infoIndices)
+	{
+		out_itemIndices->push_back(m_infos[infoIndex].index);
+	}
 
-			case ENodeSplitMethod::SAH_BUCKETS:
-				isSplitSuccess = splitWithSahBuckets(intersectables, maxDimension, 
-				                                     nodeAABB, centroidsAABB, 
-				                                     &intersectablesA, &intersectablesB);
-				break;
+	m_subtreeTasks = nullptr;
+	m_infos.clear();
+	m_infos.shrink_to_fit();
+	m_infoIndices.clear();
+	m_infoIndices.shrink_to_fit();
+	m_mortonCodes.clear();
+	m_mortonCodes.shrink_to_fit();
+	m_nodeSlots.clear();
+	m_nodeSlots.shrink_to_fit();
+	m_isSlotUsed.clear();
+	m_isSlotUsed.shrink_to_fit();
+}
 
-			default:
-				std::cerr << "warning: at BvhBuilder::buildBinaryBvhNodeRecursive(), " 
-				          << "unknown split method detected" << std::endl;
-				isSplitSuccess = false;
-				break;
+void BvhBuilder::buildNodeRecursive(
+	const std::size_t nodeSlot,
+	const std::size_t infoBegin,
+	const std::size_t infoEnd,
+	const std::size_t depth)
+{
+	PH_ASSERT_LT(infoBegin, infoEnd);
+	PH_ASSERT_LT(nodeSlot, m_nodeSlots.size());
+	PH_ASSERT_LE(depth, MAX_DEPTH);
 
-			}// end switch split method
+	AABB3D nodeAABB(m_infos[m_infoIndices[infoBegin]].aabb);
+	AABB3D centroidsAABB(m_infos[m_infoIndices[infoBegin]].aabbCentroid);
+	for(std::size_t i = infoBegin + 1; i < infoEnd; ++i)
+	{
+		const BvhIntersectableInfo& info = m_infos[m_infoIndices[i]];
+		nodeAABB.unionWith(info.aabb);
+		centroidsAABB.unionWith(info.aabbCentroid);
+	}
 
-			if(isSplitSuccess && (intersectablesA.empty() || intersectablesB.empty()))
-			{
-				std::cerr << "warning: at BvhBuilder::buildBinaryBvhNodeRecursive(), " 
-				          << "bad split detected" << std::endl;
-				isSplitSuccess = false;
-			}
+	const std::size_t numIntersectables = infoEnd - infoBegin;
+	const int32       maxDimension      = centroidsAABB.getExtents().maxDimension();
 
-			if(isSplitSuccess)
-			{
-				//std::cout << "#A: " << primitivesA.size() << "| #B: " << primitivesB.size() << std::endl;
+	// Once the remaining depth only allows a balanced subtree, intersectables
+	// are split in halves regardless of the split method; nodes at MAX_DEPTH
+	// are always leaves.
+	const bool isDepthLimited = depth + calc_min_depth(numIntersectables) >= MAX_DEPTH;
+	const bool isAtMaxDepth   = depth == MAX_DEPTH;
 
-				*node = BvhInfoNode::makeBinaryInternal(buildBinaryBvhInfoNodeRecursive(intersectablesA, splitMethod),
-				                                        buildBinaryBvhInfoNodeRecursive(intersectablesB, splitMethod),
-				                                        maxDimension);
-			}
-			else
+	bool        isSplitSuccess = false;
+	std::size_t infoMiddle     = infoBegin;
+	int32       splitAxis      = maxDimension;
+	if(numIntersectables > 1 && !centroidsAABB.isPoint() && !isDepthLimited)
+	{
+		switch(m_type)
+		{
+		case EBvhType::LBVH:
+			isSplitSuccess = splitWithMortonCodes(infoBegin, infoEnd, &infoMiddle, &splitAxis);
+			if(!isSplitSuccess && numIntersectables > MAX_LBVH_LEAF_INTERSECTABLES)
 			{
-				*node = BvhInfoNode::makeBinaryLeaf(intersectables, nodeAABB);
+				splitWithEqualIntersectables(infoBegin, infoEnd, maxDimension, &infoMiddle);
+				splitAxis      = maxDimension;
+				isSplitSuccess = true;
 			}
+			break;
+
+		case EBvhType::SAH_BUCKET:
+			isSplitSuccess = splitWithSahBuckets(infoBegin, infoEnd, nodeAABB, centroidsAABB,
+			                                     &infoMiddle, &splitAxis);
+			break;
+
+		case EBvhType::SAH_SWEEP:
+			isSplitSuccess = splitWithSahSweep(infoBegin, infoEnd, nodeAABB, centroidsAABB,
+			                                   &infoMiddle, &splitAxis);
+			break;
+
+		default:
+			std::cerr << "warning: at BvhBuilder::buildNodeRecursive(), "
+			          << "unsupported BVH type specified" << std::endl;
+			break;
 		}
 	}
 
-	return node;
-}
+	// intersectables cannot be told apart, but too many of them in a leaf is
+	// still not acceptable
+	if(!isSplitSuccess && !isAtMaxDepth &&
+	   (numIntersectables > MAX_LEAF_INTERSECTABLES || (isDepthLimited && numIntersectables > 1)))
+	{
+		splitWithEqualIntersectables(infoBegin, infoEnd, maxDimension, &infoMiddle);
+		splitAxis      = maxDimension;
+		isSplitSuccess = true;
+	}
+
+	m_isSlotUsed[nodeSlot] = 1;
+	if(!isSplitSuccess)
+	{
+		m_nodeSlots[nodeSlot] = BvhLinearNode::makeLeaf(nodeAABB, infoBegin, static_cast<int32>(numIntersectables));
+		return;
+	}
 
+	PH_ASSERT(infoBegin < infoMiddle && infoMiddle < infoEnd);
 
-void BvhBuilder::buildBinaryBvhLinearDepthFirstNodeRecursive(
-	const BvhInfoNode* const rootNode,
-	std::size_t* const out_nodeIndex)
-{
-	std::size_t nodeIndex = m_linearNodes.size();
+	const std::size_t firstChildSlot  = nodeSlot + 1;
+	const std::size_t secondChildSlot = firstChildSlot + 2 * (infoMiddle - infoBegin) - 1;
+	m_nodeSlots[nodeSlot] = BvhLinearNode::makeInternal(nodeAABB, secondChildSlot, splitAxis);
 
-	if(rootNode->isBinaryLeaf())
+	if(m_subtreeTasks && infoEnd - infoMiddle >= PARALLEL_BUILD_THRESHOLD)
 	{
-		m_linearNodes.push_back(BvhLinearNode::makeLeaf(rootNode->aabb, 
-		                                                m_intersectables.size(), 
-		                                                static_cast<int32>(rootNode->intersectables.size())));
-
-		for(const auto& intersectableInfo : rootNode->intersectables)
+		m_subtreeTasks->run([this, secondChildSlot, infoMiddle, infoEnd, depth]()
 		{
-			m_intersectables.push_back(intersectableInfo.intersectable);
-		}
-	}
-	else if(rootNode->isBinaryInternal())
-	{
-		m_linearNodes.push_back(BvhLinearNode());
-
-		std::size_t secondChildOffset = static_cast<std::size_t>(-1);
-		buildBinaryBvhLinearDepthFirstNodeRecursive(rootNode->children[0], nullptr);
-		buildBinaryBvhLinearDepthFirstNodeRecursive(rootNode->children[1], &secondChildOffset);
-		m_linearNodes[nodeIndex] = BvhLinearNode::makeInternal(rootNode->aabb, 
-		                                                       secondChildOffset, 
-		                                                       rootNode->splitAxis);
+			buildNodeRecursive(secondChildSlot, infoMiddle, infoEnd, depth + 1);
+		});
 	}
 	else
 	{
-		std::cerr << "warning: at BvhBuilder::buildBinaryBvhLinearDepthFirstNodeRecursive(), " 
-		          << "only binary node is acceptable" << std::endl;
-		nodeIndex = static_cast<std::size_t>(-1);
+		buildNodeRecursive(secondChildSlot, infoMiddle, infoEnd, depth + 1);
 	}
 
-	if(out_nodeIndex)
-	{
-		*out_nodeIndex = nodeIndex;
-	}
+	buildNodeRecursive(firstChildSlot, infoBegin, infoMiddle, depth + 1);
 }
 
-std::size_t BvhBuilder::calcTotalNodes(const BvhInfoNode* const rootNode)
+bool BvhBuilder::splitWithMortonCodes(
+	const std::size_t  infoBegin,
+	const std::size_t  infoEnd,
+	std::size_t* const out_infoMiddle,
+	int32* const       out_splitAxis)
 {
-	std::size_t result = 1;
-	result += rootNode->children[0] ? calcTotalNodes(rootNode->children[0]) : 0;
-	result += rootNode->children[1] ? calcTotalNodes(rootNode->children[1]) : 0;
-	return result;
-}
+	PH_ASSERT(out_infoMiddle && out_splitAxis);
+	PH_ASSERT_EQ(m_mortonCodes.size(), m_infos.size());
 
-std::size_t BvhBuilder::calcTotalIntersectables(const BvhInfoNode* const rootNode)
-{
-	std::size_t result = rootNode->intersectables.size();
-	result += rootNode->children[0] ? calcTotalIntersectables(rootNode->children[0]) : 0;
-	result += rootNode->children[1] ? calcTotalIntersectables(rootNode->children[1]) : 0;
-	return result;
-}
+	// infos are sorted by their Morton codes already, split at the highest bit
+	// that differs
 
-std::size_t BvhBuilder::calcMaxDepth(const BvhInfoNode* const rootNode)
-{
-	std::size_t depth = rootNode->children[0] || rootNode->children[1] ? 1 : 0;
-	std::size_t depthA = rootNode->children[0] ? calcMaxDepth(rootNode->children[0]) : 0;
-	std::size_t depthB = rootNode->children[1] ? calcMaxDepth(rootNode->children[1]) : 0;
-	depth += std::max(depthA, depthB);
-	return depth;
-}
-
-bool BvhBuilder::splitWithEqualIntersectables(const std::vector<BvhIntersectableInfo>& intersectables, 
-                                              const int32 splitDimension, 
-                                              std::vector<BvhIntersectableInfo>* const out_partA,
-                                              std::vector<BvhIntersectableInfo>* const out_partB)
-{
-	if(intersectables.size() < 2)
+	const uint32 firstCode = m_mortonCodes[m_infoIndices[infoBegin]];
+	const uint32 lastCode  = m_mortonCodes[m_infoIndices[infoEnd - 1]];
+	if(firstCode == lastCode)
 	{
-		std::cerr << "warning: at BvhBuilder::splitWithEqualPrimitives(), " 
-		          << "number of primitives < 2, cannot split" << std::endl;
 		return false;
 	}
 
-	const std::size_t midIndex = intersectables.size() / 2 - 1;
-	std::vector<BvhIntersectableInfo> sortedIntersectables(intersectables);
-
-	std::nth_element(sortedIntersectables.begin(), 
-	                 sortedIntersectables.begin() + midIndex, 
-	                 sortedIntersectables.end(),
-	[splitDimension](const BvhIntersectableInfo& a, const BvhIntersectableInfo& b)
-	{
-		return a.aabbCentroid[splitDimension] < b.aabbCentroid[splitDimension];
-	});
+	const uint32 splitBit  = math::log2_floor(firstCode ^ lastCode);
+	const uint32 splitMask = uint32(1) << splitBit;
 
-	out_partA->clear();
-	out_partB->clear();
-	out_partA->shrink_to_fit();
-	out_partB->shrink_to_fit();
+	const auto& middle = std::partition_point(
+		m_infoIndices.begin() + infoBegin,
+		m_infoIndices.begin() + infoEnd,
+		[this, splitMask](const std::size_t infoIndex)
+		{
+			return (m_mortonCodes[infoIndex] & splitMask) == 0;
+		});
 
-	out_partA->insert(out_partA->end(), 
-	                  sortedIntersectables.begin(), sortedIntersectables.begin() + midIndex + 1);
-	out_partB->insert(out_partB->end(), 
-	                  sortedIntersectables.begin() + midIndex + 1, sortedIntersectables.end());
+	// bits are interleaved as zyxzyx...zyx from low to high
+	*out_infoMiddle = static_cast<std::size_t>(middle - m_infoIndices.begin());
+	*out_splitAxis  = 2 - static_cast<int32>(splitBit % 3);
 
 	return true;
 }
 
-bool BvhBuilder::splitWithSahBuckets(const std::vector<BvhIntersectableInfo>& intersectables, 
-                                     const int32 splitDimension,
-                                     const AABB3D& primitivesAABB, const AABB3D& centroidsAABB,
-                                     std::vector<BvhIntersectableInfo>* const out_partA,
-                                     std::vector<BvhIntersectableInfo>* const out_partB)
+bool BvhBuilder::splitWithSahBuckets(
+	const std::size_t  infoBegin,
+	const std::size_t  infoEnd,
+	const AABB3D&      nodeAABB,
+	const AABB3D&      centroidsAABB,
+	std::size_t* const out_infoMiddle,
+	int32* const       out_splitAxis)
 {
-	if(intersectables.size() < 2)
+	PH_ASSERT(out_infoMiddle && out_splitAxis);
+
+	const Vector3R extents   = centroidsAABB.getExtents();
+	const Vector3R minVertex = centroidsAABB.getMinVertex();
+
+	// slightly less than the number of buckets so the max centroid does not
+	// fall outside
+	Vector3R bucketScales;
+	for(int32 axis = 0; axis < 3; ++axis)
 	{
-		std::cerr << "warning: at BvhBuilder::splitWithSahBuckets(), " 
-		          << "number of intersectables < 2, cannot split" << std::endl;
-		return false;
+		bucketScales[axis] = extents[axis] > 0.0_r ?
+			static_cast<real>(NUM_SAH_BUCKETS) * (1.0_r - 1e-6_r) / extents[axis] : 0.0_r;
 	}
 
-	const int32 numBuckets = 64;
+	const auto calcBucketIndex = [&](const Vector3R& centroid, const int32 axis) -> std::size_t
+	{
+		const real scaled = (centroid[axis] - minVertex[axis]) * bucketScales[axis];
+		return std::min(static_cast<std::size_t>(std::max(scaled, 0.0_r)), NUM_SAH_BUCKETS - 1);
+	};
+
+	// bin intersectables for all axes in one pass
+	BvhSahBucket buckets[3][NUM_SAH_BUCKETS];
+	for(std::size_t i = infoBegin; i < infoEnd; ++i)
+	{
+		const BvhIntersectableInfo& info = m_infos[m_infoIndices[i]];
+		for(int32 axis = 0; axis < 3; ++axis)
+		{
+			buckets[axis][calcBucketIndex(info.aabbCentroid, axis)].add(info.aabb);
+		}
+	}
 
-	const int32    dim         = splitDimension;
-	const Vector3R extents     = centroidsAABB.getExtents();
-	const real     splitExtent = extents[dim];
+	const real reciNodeArea = 1.0_r / nodeAABB.getSurfaceArea();
 
-	BvhSahBucket buckets[numBuckets];
-	for(const auto& intersectable : intersectables)
+	real        minCost   = std::numeric_limits<real>::max();
+	int32       bestAxis  = -1;
+	std::size_t bestSplit = 0;
+	for(int32 axis = 0; axis < 3; ++axis)
 	{
-		if(splitExtent < 0.0_r)
+		if(extents[axis] <= 0.0_r)
+		{
+			continue;
+		}
+
+		// Splitting at s puts buckets [0, s) to the negative side. Costs of
+		// the positive side are accumulated from the back first.
+
+		real        positiveAreas[NUM_SAH_BUCKETS];
+		std::size_t positiveCounts[NUM_SAH_BUCKETS];
+		BvhSahBucket positiveSide;
+		for(std::size_t s = NUM_SAH_BUCKETS - 1; s > 0; --s)
 		{
-			std::cerr << "warning: at BvhBuilder::splitWithSahBuckets(), " 
-			          << "intersectable AABB split extent < 0, cannot split" << std::endl;
-			return false;
+			positiveSide.merge(buckets[axis][s]);
+			positiveAreas[s]  = positiveSide.getSurfaceArea();
+			positiveCounts[s] = positiveSide.numIntersectables;
 		}
 
-		const real factor = (intersectable.aabbCentroid[dim] - centroidsAABB.getMinVertex()[dim]) / splitExtent;
-		int32 bucketIndex = static_cast<int32>(factor * numBuckets);
-		bucketIndex = (bucketIndex == numBuckets) ? bucketIndex - 1 : bucketIndex;
+		BvhSahBucket negativeSide;
+		for(std::size_t s = 1; s < NUM_SAH_BUCKETS; ++s)
+		{
+			negativeSide.merge(buckets[axis][s - 1]);
+			if(negativeSide.isEmpty() || positiveCounts[s] == 0)
+			{
+				continue;
+			}
+
+			const real cost = SAH_TRAVERSAL_COST + SAH_INTERSECT_COST * reciNodeArea * (
+				static_cast<real>(negativeSide.numIntersectables) * negativeSide.getSurfaceArea() +
+				static_cast<real>(positiveCounts[s]) * positiveAreas[s]);
+			if(cost < minCost)
+			{
+				minCost   = cost;
+				bestAxis  = axis;
+				bestSplit = s;
+			}
+		}
+	}
 
-		buckets[bucketIndex].aabb = (buckets[bucketIndex].isEmpty()) ?
-		                            intersectable.aabb : buckets[bucketIndex].aabb.unionWith(intersectable.aabb);
-		buckets[bucketIndex].numIntersectables++;
+	const std::size_t numIntersectables = infoEnd - infoBegin;
+	const real        noSplitCost       = SAH_INTERSECT_COST * static_cast<real>(numIntersectables);
+	if(bestAxis == -1 || (minCost >= noSplitCost && numIntersectables <= MAX_LEAF_INTERSECTABLES))
+	{
+		return false;
 	}
 
-	const real traversalCost = 1.0_r / 8.0_r;
-	const real intersectCost = 1.0_r;
+	const auto& middle = std::partition(
+		m_infoIndices.begin() + infoBegin,
+		m_infoIndices.begin() + infoEnd,
+		[&](const std::size_t infoIndex)
+		{
+			return calcBucketIndex(m_infos[infoIndex].aabbCentroid, bestAxis) < bestSplit;
+		});
+
+	*out_infoMiddle = static_cast<std::size_t>(middle - m_infoIndices.begin());
+	*out_splitAxis  = bestAxis;
+
+	return true;
+}
+
+bool BvhBuilder::splitWithSahSweep(
+	const std::size_t  infoBegin,
+	const std::size_t  infoEnd,
+	const AABB3D&      nodeAABB,
+	const AABB3D&      centroidsAABB,
+	std::size_t* const out_infoMiddle,
+	int32* const       out_splitAxis)
+{
+	PH_ASSERT(out_infoMiddle && out_splitAxis);
+
+	const std::size_t numIntersectables = infoEnd - infoBegin;
+	const Vector3R    extents           = centroidsAABB.getExtents();
+	const real        reciNodeArea      = 1.0_r / nodeAABB.getSurfaceArea();
+
+	std::vector<std::size_t> sortedIndices(numIntersectables);
+	std::vector<std::size_t> bestSortedIndices;
+	std::vector<real>        positiveAreas(numIntersectables);
 
-	real costs[numBuckets - 1] = {0.0_r};
-	for(int32 i = 0; i < numBuckets - 1; i++)
+	real        minCost   = std::numeric_limits<real>::max();
+	int32       bestAxis  = -1;
+	std::size_t bestSplit = 0;
+	for(int32 axis = 0; axis < 3; ++axis)
 	{
-		std::size_t numIntersectablesA = 0;
-		AABB3D aabbA;
-		for(int32 j = 0; j <= i; j++)
+		if(extents[axis] <= 0.0_r)
 		{
-			if(!buckets[j].isEmpty())
+			continue;
+		}
+
+		std::copy(
+			m_infoIndices.begin() + infoBegin,
+			m_infoIndices.begin() + infoEnd,
+			sortedIndices.begin());
+		std::sort(sortedIndices.begin(), sortedIndices.end(),
+			[this, axis](const std::size_t a, const std::size_t b)
 			{
-				aabbA = aabbA.isPoint() ? buckets[j].aabb : AABB3D::makeUnioned(aabbA, buckets[j].aabb);
-			}
-			
-			numIntersectablesA += buckets[j].numIntersectables;
+				return m_infos[a].aabbCentroid[axis] < m_infos[b].aabbCentroid[axis];
+			});
+
+		// Splitting at s puts the first s intersectables to the negative side.
+
+		BvhSahBucket positiveSide;
+		for(std::size_t s = numIntersectables - 1; s > 0; --s)
+		{
+			positiveSide.add(m_infos[sortedIndices[s]].aabb);
+			positiveAreas[s] = positiveSide.getSurfaceArea();
 		}
 
-		std::size_t numIntersectablesB = 0;
-		AABB3D aabbB;
-		for(int32 j = i + 1; j < numBuckets; j++)
+		bool isBetterAxis = false;
+		BvhSahBucket negativeSide;
+		for(std::size_t s = 1; s < numIntersectables; ++s)
 		{
-			if(!buckets[j].isEmpty())
+			negativeSide.add(m_infos[sortedIndices[s - 1]].aabb);
+
+			const real cost = SAH_TRAVERSAL_COST + SAH_INTERSECT_COST * reciNodeArea * (
+				static_cast<real>(s) * negativeSide.getSurfaceArea() +
+				static_cast<real>(numIntersectables - s) * positiveAreas[s]);
+			if(cost < minCost)
 			{
-				aabbB = aabbB.isPoint() ? buckets[j].aabb : AABB3D::makeUnioned(aabbB, buckets[j].aabb);
+				minCost      = cost;
+				bestAxis     = axis;
+				bestSplit    = s;
+				isBetterAxis = true;
 			}
-
-			numIntersectablesB += buckets[j].numIntersectables;
 		}
 
-		const real probTestingA = aabbA.getSurfaceArea() / primitivesAABB.getSurfaceArea();
-		const real probTestingB = aabbB.getSurfaceArea() / primitivesAABB.getSurfaceArea();
+		if(isBetterAxis)
+		{
+			bestSortedIndices.swap(sortedIndices);
+			sortedIndices.resize(numIntersectables);
+		}
+	}
 
-		costs[i] = traversalCost + 
-		           static_cast<real>(numIntersectablesA) * intersectCost * probTestingA +
-		           static_cast<real>(numIntersectablesB) * intersectCost * probTestingB;
+	const real noSplitCost = SAH_INTERSECT_COST * static_cast<real>(numIntersectables);
+	if(bestAxis == -1 || (minCost >= noSplitCost && numIntersectables <= MAX_LEAF_INTERSECTABLES))
+	{
+		return false;
 	}
 
-	int32 minCostIndex = 0;
-	for(int32 i = 1; i < numBuckets - 1; i++)
+	std::copy(bestSortedIndices.begin(), bestSortedIndices.end(), m_infoIndices.begin() + infoBegin);
+
+	*out_infoMiddle = infoBegin + bestSplit;
+	*out_splitAxis  = bestAxis;
+
+	return true;
+}
+
+void BvhBuilder::splitWithEqualIntersectables(
+	const std::size_t  infoBegin,
+	const std::size_t  infoEnd,
+	const int32        splitAxis,
+	std::size_t* const out_infoMiddle)
+{
+	PH_ASSERT(out_infoMiddle);
+	PH_ASSERT_GE(infoEnd - infoBegin, 2);
+
+	const std::size_t infoMiddle = infoBegin + (infoEnd - infoBegin) / 2;
+	std::nth_element(
+		m_infoIndices.begin() + infoBegin,
+		m_infoIndices.begin() + infoMiddle,
+		m_infoIndices.begin() + infoEnd,
+		[this, splitAxis](const std::size_t a, const std::size_t b)
+		{
+			return m_infos[a].aabbCentroid[splitAxis] < m_infos[b].aabbCentroid[splitAxis];
+		});
+
+	*out_infoMiddle = infoMiddle;
+}
+
+void BvhBuilder::computeMortonCodes(const AABB3D& centroidsAABB)
+{
+	const Vector3R extents   = centroidsAABB.getExtents();
+	const Vector3R minVertex = centroidsAABB.getMinVertex();
+
+	// 10 bits for each axis
+	constexpr real GRID_SIZE = 1024.0_r;
+
+	m_mortonCodes.resize(m_infos.size());
+	for(std::size_t i = 0; i < m_infos.size(); ++i)
 	{
-		if(costs[i] < costs[minCostIndex])
+		uint32 gridCoords[3];
+		for(int32 axis = 0; axis < 3; ++axis)
 		{
-			minCostIndex = i;
+			const real normalized = extents[axis] > 0.0_r ?
+				(m_infos[i].aabbCentroid[axis] - minVertex[axis]) / extents[axis] : 0.0_r;
+			gridCoords[axis] = static_cast<uint32>(math::clamp(normalized * GRID_SIZE, 0.0_r, GRID_SIZE - 1.0_r));
 		}
+
+		m_mortonCodes[i] =
+			(spread_bits_by_2(gridCoords[0]) << 2) |
+			(spread_bits_by_2(gridCoords[1]) << 1) |
+			(spread_bits_by_2(gridCoords[2]));
 	}
 
-	const real minSplitCost = costs[minCostIndex];
-	const real noSplitCost  = intersectCost * static_cast<real>(intersectables.size());
+	const auto byMortonCode = [this](const std::size_t a, const std::size_t b)
+	{
+		return m_mortonCodes[a] < m_mortonCodes[b];
+	};
 
-	const std::size_t maxIntersectables = 256;
+	// sort chunks in parallel, then merge them pairwise
 
-	if(minSplitCost < noSplitCost || intersectables.size() > maxIntersectables)
+	const std::size_t numChunks = m_subtreeTasks ? m_numThreads : 1;
+	std::vector<std::size_t> chunkBounds;
+	for(std::size_t i = 0; i < numChunks; ++i)
 	{
-		out_partA->clear();
-		out_partB->clear();
-		out_partA->shrink_to_fit();
-		out_partB->shrink_to_fit();
+		const auto chunkRange = math::ith_evenly_divided_range(i, m_infoIndices.size(), numChunks);
+		chunkBounds.push_back(chunkRange.first);
+	}
+	chunkBounds.push_back(m_infoIndices.size());
 
-		for(const auto& intersectable : intersectables)
+	parallel_work(numChunks, numChunks,
+		[this, &chunkBounds, &byMortonCode](const std::size_t workerIdx, const std::size_t workBegin, const std::size_t workEnd)
 		{
-			const real factor = (intersectable.aabbCentroid[dim] - centroidsAABB.getMinVertex()[dim]) / splitExtent;
-			int32 bucketIndex = static_cast<int32>(factor * numBuckets);
-			bucketIndex = (bucketIndex == numBuckets) ? bucketIndex - 1 : bucketIndex;
-
-			if(bucketIndex <= minCostIndex)
-				out_partA->push_back(intersectable);
-			else
-				out_partB->push_back(intersectable);
+			for(std::size_t i = workBegin; i < workEnd; ++i)
+			{
+				std::sort(
+					m_infoIndices.begin() + chunkBounds[i],
+					m_infoIndices.begin() + chunkBounds[i + 1],
+					byMortonCode);
+			}
+		});
+
+	while(chunkBounds.size() > 2)
+	{
+		std::vector<std::size_t> mergedBounds;
+		for(std::size_t i = 0; i + 2 < chunkBounds.size(); i += 2)
+		{
+			std::inplace_merge(
+				m_infoIndices.begin() + chunkBounds[i],
+				m_infoIndices.begin() + chunkBounds[i + 1],
+				m_infoIndices.begin() + chunkBounds[i + 2],
+				byMortonCode);
+			mergedBounds.push_back(chunkBounds[i]);
+		}
+
+		// an odd chunk is left as-is
+		if(chunkBounds.size() % 2 == 0)
+		{
+			mergedBounds.push_back(chunkBounds[chunkBounds.size() - 2]);
 		}
+		mergedBounds.push_back(chunkBounds.back());
 
-		return true;
+		chunkBounds.swap(mergedBounds);
 	}
-	else
+}
+
+void BvhBuilder::compactNodeSlots(std::vector<BvhLinearNode>* const out_linearNodes)
+{
+	PH_ASSERT(out_linearNodes);
+
+	// Slots are already in depth-first order, only the unused ones need to be
+	// removed.
+
+	std::vector<std::size_t> compactIndices(m_nodeSlots.size());
+	std::size_t numNodes = 0;
+	for(std::size_t slot = 0; slot < m_nodeSlots.size(); ++slot)
 	{
-		return false;
+		compactIndices[slot] = numNodes;
+		numNodes += m_isSlotUsed[slot] ? 1 : 0;
 	}
+
+	out_linearNodes->resize(numNodes);
+	for(std::size_t slot = 0; slot < m_nodeSlots.size(); ++slot)
+	{
+		if(!m_isSlotUsed[slot])
+		{
+			continue;
+		}
+
+		BvhLinearNode node = m_nodeSlots[slot];
+		if(node.isInternal())
+		{
+			PH_ASSERT(m_isSlotUsed[node.secondChildOffset]);
+
+			node.secondChildOffset = compactIndices[node.secondChildOffset];
+		}
+		(*out_linearNodes)[compactIndices[slot]] = node;
+	}
+}
+
+std::size_t BvhBuilder::calcMaxDepth(const std::vector<BvhLinearNode>& linearNodes)
+{
+	return linearNodes.empty() ? 0 : calc_max_depth_recursive(linearNodes, 0);
 }
 
-}// end namespace ph
\ No newline at end of file
+}// end namespace ph
@@ -3,59 +3,220 @@
 #include "Core/Intersectable/Bvh/EBvhType.h"
 #include "Core/Intersectable/Bvh/BvhIntersectableInfo.h"
 #include "Core/Intersectable/Bvh/BvhLinearNode.h"
+#include "Core/Intersectable/Bvh/TWideBvhNode.h"
+#include "Common/primitive_type.h"
+#include "Common/assertion.h"
 
-#include <memory>
 #include <vector>
+#include <array>
+#include <cstddef>
+#include <iostream>
 
 namespace ph
 {
 
-class Intersectables;
-class BvhInfoNode;
+class Intersectable;
+class TaskGroup;
 
+/*
+	Builds binary BVHs top-down. All intersectables are referenced by a single
+	index array which is partitioned in place; large subtrees are built as
+	separate tasks on the shared scheduler. Nodes are written to their final linear
+	(depth-first) positions directly.
+*/
 class BvhBuilder final
 {
 public:
-	static std::size_t calcTotalNodes(const BvhInfoNode* rootNode);
-	static std::size_t calcTotalIntersectables(const BvhInfoNode* rootNode);
-	static std::size_t calcMaxDepth(const BvhInfoNode* rootNode);
+	// Maximum number of internal nodes on any path from the root to a leaf.
+	// Built trees never exceed it, so traversal stacks can be of fixed size.
+	static constexpr std::size_t MAX_DEPTH = 64;
 
 public:
-	BvhBuilder(EBvhType type);
+	static std::size_t calcMaxDepth(const std::vector<BvhLinearNode>& linearNodes);
 
-	const BvhInfoNode* buildInformativeBinaryBvh(const std::vector<const Intersectable*>& intersectables);
-	void buildLinearDepthFirstBinaryBvh(const BvhInfoNode* rootNode, 
-	                                    std::vector<BvhLinearNode>* out_linearNodes, 
-	                                    std::vector<const Intersectable*>* out_intersectables);
+public:
+	explicit BvhBuilder(EBvhType type);
+
+	// <numThreads> is the maximum number of threads used for building.
+	BvhBuilder(EBvhType type, std::size_t numThreads);
+
+	// Builds a binary BVH where the first child of an internal node is stored
+	// right after it. Intersectables are reordered such that every leaf
+	// references a contiguous range of them.
+	void buildLinearDepthFirstBinaryBvh(
+		const std::vector<const Intersectable*>& intersectables,
+		std::vector<BvhLinearNode>*              out_linearNodes,
+		std::vector<const Intersectable*>*       out_intersectables);
+
+	// Similar to the above, except that items are given by their bounds only.
+	// Indices of the items are stored in <out_itemIndices> in leaf order, so
+	// callers can keep items in whatever form they like.
+	void buildLinearDepthFirstBinaryBvh(
+		const std::vector<AABB3D>&  itemAABBs,
+		std::vector<BvhLinearNode>* out_linearNodes,
+		std::vector<std::size_t>*   out_itemIndices);
+
+	// Collapses a binary BVH built by buildLinearDepthFirstBinaryBvh() into a
+	// N-wide one. Nodes are stored in depth-first order with the root at
+	// index 0; the order of intersectables is unchanged.
+	template<std::size_t N>
+	static void buildLinearDepthFirstWideBvh(
+		const std::vector<BvhLinearNode>& binaryNodes,
+		std::vector<TWideBvhNode<N>>*     out_nodes);
 
 private:
-	EBvhType m_type;
-	std::vector<std::unique_ptr<BvhInfoNode>> m_infoNodes;
-	std::vector<BvhLinearNode> m_linearNodes;
-	std::vector<const Intersectable*> m_intersectables;
+	EBvhType    m_type;
+	std::size_t m_numThreads;
 
-	enum class ENodeSplitMethod
-	{
-		EQUAL_INTERSECTABLES, 
-		SAH_BUCKETS, 
-		SAH_EDGE_SORT
-	};
-
-	const BvhInfoNode* buildBinaryBvhInfoNodeRecursive(const std::vector<BvhIntersectableInfo>& intersectables, 
-	                                                   ENodeSplitMethod splitMethod);
-	void buildBinaryBvhLinearDepthFirstNodeRecursive(const BvhInfoNode* rootNode, 
-	                                                 std::size_t* out_nodeIndex);
-
-	bool splitWithEqualIntersectables(const std::vector<BvhIntersectableInfo>& intersectables, 
-	                                  int32 splitDimension,
-	                                  std::vector<BvhIntersectableInfo>* out_partA,
-	                                  std::vector<BvhIntersectableInfo>* out_partB);
-
-	bool splitWithSahBuckets(const std::vector<BvhIntersectableInfo>& intersectables, 
-	                         int32 splitDimension,
-	                         const AABB3D& primitivesAABB, const AABB3D& centroidsAABB,
-	                         std::vector<BvhIntersectableInfo>* out_partA,
-	                         std::vector<BvhIntersectableInfo>* out_partB);
+	// Build states, only valid during a build.
+	std::vector<BvhIntersectableInfo> m_infos;
+	std::vector<std::size_t>          m_infoIndices;
+	std::vector<uint32>               m_mortonCodes;
+	std::vector<BvhLinearNode>        m_nodeSlots;
+	std::vector<uint8>                m_isSlotUsed;
+	TaskGroup*                        m_subtreeTasks;
+
+	void buildNodeRecursive(
+		std::size_t nodeSlot,
+		std::size_t infoBegin,
+		std::size_t infoEnd,
+		std::size_t depth);
+
+	// Methods for splitting intersectables in [infoBegin, infoEnd) in place.
+	// On success, intersectables in [infoBegin, out_infoMiddle) are on the
+	// negative side of <out_splitAxis>.
+	bool splitWithMortonCodes(
+		std::size_t  infoBegin,
+		std::size_t  infoEnd,
+		std::size_t* out_infoMiddle,
+		int32*       out_splitAxis);
+
+	bool splitWithSahBuckets(
+		std::size_t   infoBegin,
+		std::size_t   infoEnd,
+		const AABB3D& nodeAABB,
+		const AABB3D& centroidsAABB,
+		std::size_t*  out_infoMiddle,
+		int32*        out_splitAxis);
+
+	bool splitWithSahSweep(
+		std::size_t   infoBegin,
+		std::size_t   infoEnd,
+		const AABB3D& nodeAABB,
+		const AABB3D& centroidsAABB,
+		std::size_t*  out_infoMiddle,
+		int32*        out_splitAxis);
+
+	void splitWithEqualIntersectables(
+		std::size_t   infoBegin,
+		std::size_t   infoEnd,
+		int32         splitAxis,
+		std::size_t*  out_infoMiddle);
+
+	void computeMortonCodes(const AABB3D& centroidsAABB);
+	void compactNodeSlots(std::vector<BvhLinearNode>* out_linearNodes);
+
+	// Subtrees with at least this many intersectables are built in parallel.
+	static constexpr std::size_t PARALLEL_BUILD_THRESHOLD = 1024;
+
+	template<std::size_t N>
+	static std::size_t buildWideBvhLinearDepthFirstNodeRecursive(
+		const std::vector<BvhLinearNode>& binaryNodes,
+		std::size_t                       binaryNodeIndex,
+		std::vector<TWideBvhNode<N>>&     nodes);
 };
 
-}// end namespace ph
\ No newline at end of file
+// In-header Implementations:
+
+template<std::size_t N>
+inline void BvhBuilder::buildLinearDepthFirstWideBvh(
+	const std::vector<BvhLinearNode>&   binaryNodes,
+	std::vector<TWideBvhNode<N>>* const out_nodes)
+{
+	PH_ASSERT(out_nodes);
+
+	out_nodes->clear();
+	out_nodes->shrink_to_fit();
+
+	if(binaryNodes.empty())
+	{
+		std::cerr << "warning: at BvhBuilder::buildLinearDepthFirstWideBvh(), "
+		          << "no node to collapse" << std::endl;
+		return;
+	}
+
+	const BvhLinearNode& rootNode = binaryNodes.front();
+	if(rootNode.isLeaf())
+	{
+		// the root itself is the only child of the wide root node
+		TWideBvhNode<N> node;
+		node.setLeafChild(0, rootNode.aabb, rootNode.primitivesOffset, rootNode.numPrimitives);
+		out_nodes->push_back(node);
+	}
+	else
+	{
+		buildWideBvhLinearDepthFirstNodeRecursive<N>(binaryNodes, 0, *out_nodes);
+	}
+}
+
+template<std::size_t N>
+inline std::size_t BvhBuilder::buildWideBvhLinearDepthFirstNodeRecursive(
+	const std::vector<BvhLinearNode>& binaryNodes,
+	const std::size_t                 binaryNodeIndex,
+	std::vector<TWideBvhNode<N>>&     nodes)
+{
+	PH_ASSERT_LT(binaryNodeIndex, binaryNodes.size());
+	PH_ASSERT(binaryNodes[binaryNodeIndex].isInternal());
+
+	// Pull grandchildren up by repeatedly opening the internal child with the
+	// largest surface area, until there are N children or only leaves left.
+
+	std::array<std::size_t, N> children{};
+	std::size_t numChildren = 2;
+	children[0] = binaryNodeIndex + 1;
+	children[1] = binaryNodes[binaryNodeIndex].secondChildOffset;
+	while(numChildren < N)
+	{
+		std::size_t openedChild = N;
+		real        maxArea     = -1.0_r;
+		for(std::size_t i = 0; i < numChildren; ++i)
+		{
+			const BvhLinearNode& child = binaryNodes[children[i]];
+			if(child.isInternal() && child.aabb.getSurfaceArea() > maxArea)
+			{
+				openedChild = i;
+				maxArea     = child.aabb.getSurfaceArea();
+			}
+		}
+
+		if(openedChild == N)
+		{
+			break;
+		}
+
+		const std::size_t openedNodeIndex = children[openedChild];
+		children[openedChild]   = openedNodeIndex + 1;
+		children[numChildren++] = binaryNodes[openedNodeIndex].secondChildOffset;
+	}
+
+	const std::size_t nodeIndex = nodes.size();
+	nodes.push_back(TWideBvhNode<N>());
+
+	for(std::size_t i = 0; i < numChildren; ++i)
+	{
+		const BvhLinearNode& child = binaryNodes[children[i]];
+		if(child.isLeaf())
+		{
+			nodes[nodeIndex].setLeafChild(i, child.aabb, child.primitivesOffset, child.numPrimitives);
+		}
+		else
+		{
+			const std::size_t childNodeIndex = buildWideBvhLinearDepthFirstNodeRecursive<N>(binaryNodes, children[i], nodes);
+			nodes[nodeIndex].setInternalChild(i, child.aabb, childNodeIndex);
+		}
+	}
+
+	return nodeIndex;
+}
+
+}// end namespace ph
@@ -1,18 +1,12 @@
 #include "Core/Intersectable/Bvh/BvhIntersectableInfo.h"
-#include "Core/Intersectable/Intersectable.h"
-
-#include <iostream>
 
 namespace ph
 {
 
 BvhIntersectableInfo::BvhIntersectableInfo(
-	const Intersectable* const intersectable, 
-	const std::size_t          index) :
-	index(index), aabb(), aabbCentroid(), intersectable(intersectable)
-{
-	intersectable->calcAABB(&aabb);
-	aabbCentroid = aabb.getCentroid();
-}
+	const AABB3D&     aabb, 
+	const std::size_t index) :
+	index(index), aabb(aabb), aabbCentroid(aabb.getCentroid())
+{}
 
 }// end namespace ph
\ No newline at end of file
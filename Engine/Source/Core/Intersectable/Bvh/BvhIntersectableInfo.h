@@ -8,18 +8,15 @@
 namespace ph
 {
 
-class Intersectable;
-
 class BvhIntersectableInfo final
 {
 public:
-	std::size_t          index;
-	AABB3D               aabb;
-	Vector3R             aabbCentroid;
-	const Intersectable* intersectable;
+	std::size_t index;
+	AABB3D      aabb;
+	Vector3R    aabbCentroid;
 
 	BvhIntersectableInfo() = default;
-	BvhIntersectableInfo(const Intersectable* intersectable, std::size_t index);
+	BvhIntersectableInfo(const AABB3D& aabb, std::size_t index);
 };
 
 }// end namespace ph
\ No newline at end of file
@@ -2,9 +2,9 @@
 #include "Core/HitProbe.h"
 #include "Core/Ray.h"
 #include "Actor/CookedDataStorage.h"
-#include "Core/Intersectable/Bvh/BvhInfoNode.h"
 #include "Core/Intersectable/Bvh/BvhBuilder.h"
 #include "Core/Bound/TAABB3D.h"
+#include "Common/assertion.h"
 
 #include <iostream>
 #include <limits>
@@ -12,7 +12,16 @@
 namespace ph
 {
 
-const int32 ClassicBvhIntersector::NODE_STACK_SIZE;
+ClassicBvhIntersector::ClassicBvhIntersector() :
+	ClassicBvhIntersector(EBvhType::SAH_BUCKET)
+{}
+
+ClassicBvhIntersector::ClassicBvhIntersector(const EBvhType bvhType) :
+	Intersector(),
+	m_intersectables(),
+	m_nodes(),
+	m_bvhType(bvhType)
+{}
 
 ClassicBvhIntersector::~ClassicBvhIntersector() = default;
 
@@ -21,7 +30,7 @@ void ClassicBvhIntersector::update(const CookedDataStorage& cookedActors)
 	std::vector<const Intersectable*> intersectables;
 	for(const auto& intersectable : cookedActors.intersectables())
 	{
-		// HACK
+		// intersectables without finite bounds cannot be partitioned spatially
 		AABB3D aabb;
 		intersectable->calcAABB(&aabb);
 		if(!aabb.isFiniteVolume())
@@ -37,10 +46,8 @@ void ClassicBvhIntersector::update(const CookedDataStorage& cookedActors)
 	// printing information about the constructed BVH
 
 	/*std::cout << "intersector:             classic BVH" << std::endl;
-	std::cout << "total primitives inside: " << BvhBuilder::calcTotalIntersectables(root) << " (info), " << 
-	             m_intersectables.size() << " (linear)" << std::endl;
-	std::cout << "total nodes:             " << BvhBuilder::calcTotalNodes(root) << " (info), " <<
-	             m_nodes.size() << " (linear)" << std::endl;
+	std::cout << "total primitives inside: " << m_intersectables.size() << std::endl;
+	std::cout << "total nodes:             " << m_nodes.size() << std::endl;
 	std::cout << "max tree depth:          " << treeDepth << std::endl;*/
 }
 
@@ -124,6 +131,62 @@ bool ClassicBvhIntersector::isIntersecting(const Ray& ray, HitProbe& probe) cons
 	}
 }
 
+bool ClassicBvhIntersector::isOccluded(const Ray& ray) const
+{
+	const int32 isDirNeg[3] = {ray.getDirection().x < 0, ray.getDirection().y < 0, ray.getDirection().z < 0};
+
+	std::size_t todoNodes[NODE_STACK_SIZE];
+	int32       numTodoNodes     = 0;
+	std::size_t currentNodeIndex = 0;
+
+	while(!m_nodes.empty())
+	{
+		const BvhLinearNode& node = m_nodes[currentNodeIndex];
+
+		if(node.aabb.isIntersectingVolume(ray))
+		{
+			if(node.isLeaf())
+			{
+				// any hit is enough, no need to search for the closest one
+				for(int32 i = 0; i < node.numPrimitives; i++)
+				{
+					if(m_intersectables[node.primitivesOffset + i]->isOccluded(ray))
+					{
+						return true;
+					}
+				}
+
+				if(numTodoNodes == 0)
+					break;
+				else
+					currentNodeIndex = todoNodes[--numTodoNodes];
+			}
+			else
+			{
+				if(isDirNeg[node.splittedAxis])
+				{
+					todoNodes[numTodoNodes++] = currentNodeIndex + 1;
+					currentNodeIndex = node.secondChildOffset;
+				}
+				else
+				{
+					todoNodes[numTodoNodes++] = node.secondChildOffset;
+					currentNodeIndex = currentNodeIndex + 1;
+				}
+			}
+		}
+		else
+		{
+			if(numTodoNodes == 0)
+				break;
+			else
+				currentNodeIndex = todoNodes[--numTodoNodes];
+		}
+	}
+
+	return false;
+}
+
 void ClassicBvhIntersector::calcAABB(AABB3D* const out_aabb) const
 {
 	if(m_intersectables.empty())
@@ -143,18 +206,12 @@ void ClassicBvhIntersector::calcAABB(AABB3D* const out_aabb) const
 
 void ClassicBvhIntersector::rebuildWithIntersectables(std::vector<const Intersectable*> intersectables)
 {
-	BvhBuilder bvhBuilder(EBvhType::SAH_BUCKET);
-	const BvhInfoNode* root = bvhBuilder.buildInformativeBinaryBvh(intersectables);
-	bvhBuilder.buildLinearDepthFirstBinaryBvh(root, &m_nodes, &m_intersectables);
+	BvhBuilder bvhBuilder(m_bvhType);
+	bvhBuilder.buildLinearDepthFirstBinaryBvh(intersectables, &m_nodes, &m_intersectables);
 
 	// TODO: try to turn some checking into assertions
 
-	const std::size_t treeDepth = BvhBuilder::calcMaxDepth(root);
-	if(treeDepth > NODE_STACK_SIZE)
-	{
-		std::cerr << "warning: at ClassicBvhIntersector::update(), " 
-		          << "BVH depth exceeds stack size (" << NODE_STACK_SIZE << ")" << std::endl;
-	}
+	PH_ASSERT_LE(BvhBuilder::calcMaxDepth(m_nodes), NODE_STACK_SIZE);
 
 	if(m_intersectables.empty() || m_nodes.empty())
 	{
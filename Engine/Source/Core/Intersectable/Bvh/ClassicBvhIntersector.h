@@ -3,6 +3,8 @@
 #include "Core/Intersectable/Intersector.h"
 #include "Common/primitive_type.h"
 #include "Core/Intersectable/Bvh/BvhLinearNode.h"
+#include "Core/Intersectable/Bvh/EBvhType.h"
+#include "Core/Intersectable/Bvh/BvhBuilder.h"
 
 #include <vector>
 #include <memory>
@@ -15,10 +17,13 @@ class Intersectable;
 class ClassicBvhIntersector : public Intersector
 {
 public:
+	ClassicBvhIntersector();
+	explicit ClassicBvhIntersector(EBvhType bvhType);
 	virtual ~ClassicBvhIntersector() override;
 
 	virtual void update(const CookedDataStorage& cookedActors) override;
 	virtual bool isIntersecting(const Ray& ray, HitProbe& probe) const override;
+	virtual bool isOccluded(const Ray& ray) const override;
 	virtual void calcAABB(AABB3D* out_aabb) const override;
 
 	void rebuildWithIntersectables(std::vector<const Intersectable*> intersectables);
@@ -26,8 +31,9 @@ public:
 private:
 	std::vector<const Intersectable*> m_intersectables;
 	std::vector<BvhLinearNode>        m_nodes;
+	EBvhType                          m_bvhType;
 
-	static const int32 NODE_STACK_SIZE = 64;
+	static constexpr std::size_t NODE_STACK_SIZE = BvhBuilder::MAX_DEPTH;
 };
 
 }// end namespace ph
\ No newline at end of file
@@ -3,12 +3,20 @@
 namespace ph
 {
 
+/*
+	Methods for building a BVH, from the fastest to build to the one giving
+	the best tree quality.
+*/
 enum class EBvhType
 {
-	HALF, 
-	MIDPOINT, 
+	// splits by Morton codes of primitive centroids (linear BVH)
+	LBVH, 
+
+	// surface area heuristic evaluated on a fixed number of bins
 	SAH_BUCKET, 
-	SAH_EDGE
+
+	// surface area heuristic evaluated on every primitive centroid
+	SAH_SWEEP
 };
 
-}// end namespace ph
\ No newline at end of file
+}// end namespace ph
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Core/Intersectable/Bvh/TWideBvhNode.h"
+#include "Core/Intersectable/Bvh/BvhBuilder.h"
+#include "Core/Intersectable/Bvh/EBvhType.h"
+#include "Core/Bound/TAABB3D.h"
+
+#include <vector>
+#include <cstddef>
+
+namespace ph
+{
+
+class Ray;
+class HitProbe;
+
+/*
+	Nodes of a BVH with N children per node, without the items they bound.
+	Leaves reference ranges of item indices; items are stored by the user in
+	the order given by build(), so they can be anything from intersectables to
+	triangles of a mesh referenced by index.
+
+	Items are tested by the callables passed to traversal methods:
+
+	bool isIntersectingItem(std::size_t itemIndex, const Ray& ray, HitProbe& probe);
+	bool isOccludedByItem(std::size_t itemIndex, const Ray& ray);
+*/
+template<std::size_t N>
+class TWideBvh final
+{
+public:
+	TWideBvh();
+
+	// Builds the tree over items with bounds <itemAABBs>. The item at index i
+	// of the reordered items must be the one at <out_itemOrder>[i] in
+	// <itemAABBs>.
+	void build(
+		const std::vector<AABB3D>& itemAABBs,
+		EBvhType                   bvhType,
+		std::vector<std::size_t>*  out_itemOrder);
+
+	template<typename ItemIntersector>
+	bool isIntersecting(const Ray& ray, HitProbe& probe, const ItemIntersector& isIntersectingItem) const;
+
+	template<typename ItemOccluder>
+	bool isOccluded(const Ray& ray, const ItemOccluder& isOccludedByItem) const;
+
+	void clear();
+	bool isEmpty() const;
+	std::size_t numNodes() const;
+
+private:
+	std::vector<TWideBvhNode<N>> m_nodes;
+
+	// Every wide node consumes at least one level of the binary BVH, and a
+	// visited node replaces itself with at most N children on the stack.
+	static constexpr std::size_t NODE_STACK_SIZE = BvhBuilder::MAX_DEPTH * (N - 1) + 1;
+};
+
+}// end namespace ph
+
+#include "Core/Intersectable/Bvh/TWideBvh.ipp"
@@ -0,0 +1,233 @@
+#pragma once
+
+#include "Core/Intersectable/Bvh/TWideBvh.h"
+#include "Core/Intersectable/Bvh/BvhLinearNode.h"
+#include "Core/HitProbe.h"
+#include "Core/Ray.h"
+#include "Common/assertion.h"
+
+#include <limits>
+
+namespace ph
+{
+
+template<std::size_t N>
+inline TWideBvh<N>::TWideBvh() :
+	m_nodes()
+{}
+
+template<std::size_t N>
+inline void TWideBvh<N>::build(
+	const std::vector<AABB3D>&      itemAABBs,
+	const EBvhType                  bvhType,
+	std::vector<std::size_t>* const out_itemOrder)
+{
+	PH_ASSERT(out_itemOrder);
+
+	std::vector<BvhLinearNode> binaryNodes;
+	BvhBuilder bvhBuilder(bvhType);
+	bvhBuilder.buildLinearDepthFirstBinaryBvh(itemAABBs, &binaryNodes, out_itemOrder);
+	BvhBuilder::buildLinearDepthFirstWideBvh<N>(binaryNodes, &m_nodes);
+
+	PH_ASSERT_LE(BvhBuilder::calcMaxDepth(binaryNodes), BvhBuilder::MAX_DEPTH);
+}
+
+template<std::size_t N>
+template<typename ItemIntersector>
+inline bool TWideBvh<N>::isIntersecting(
+	const Ray&             ray,
+	HitProbe&              probe,
+	const ItemIntersector& isIntersectingItem) const
+{
+	struct TodoNode
+	{
+		std::size_t nodeIndex;
+		float32     nearHitT;
+	};
+
+	if(m_nodes.empty())
+	{
+		return false;
+	}
+
+	const typename TWideBvhNode<N>::RaySegment segment(ray);
+
+	TodoNode    todoNodes[NODE_STACK_SIZE];
+	std::size_t numTodoNodes = 0;
+	todoNodes[numTodoNodes++] = {0, static_cast<float32>(ray.getMinT())};
+
+	Ray      bvhRay(ray);
+	HitProbe closestProbe;
+	real     minHitT = std::numeric_limits<real>::max();
+
+	while(numTodoNodes > 0)
+	{
+		const TodoNode todoNode = todoNodes[--numTodoNodes];
+
+		// a closer hit was found after this node has been pushed
+		if(todoNode.nearHitT > static_cast<float32>(bvhRay.getMaxT()))
+		{
+			continue;
+		}
+
+		const TWideBvhNode<N>& node = m_nodes[todoNode.nodeIndex];
+
+		float32 nearHitTs[N];
+		uint32 hitMask = node.isIntersectingChildVolumes(
+			segment,
+			static_cast<float32>(bvhRay.getMinT()),
+			static_cast<float32>(bvhRay.getMaxT()),
+			nearHitTs);
+
+		// sort hit children by their near hit distances (insertion sort, as
+		// there are at most N of them)
+		std::size_t sortedChildren[N];
+		std::size_t numHitChildren = 0;
+		for(std::size_t i = 0; hitMask != 0; ++i, hitMask >>= 1)
+		{
+			if(!(hitMask & 1))
+			{
+				continue;
+			}
+
+			std::size_t j = numHitChildren++;
+			while(j > 0 && nearHitTs[sortedChildren[j - 1]] > nearHitTs[i])
+			{
+				sortedChildren[j] = sortedChildren[j - 1];
+				--j;
+			}
+			sortedChildren[j] = i;
+		}
+
+		// Leaves are tested right away, from near to far, so closer hits can
+		// cull the remaining children as early as possible.
+		for(std::size_t k = 0; k < numHitChildren; ++k)
+		{
+			const std::size_t childIndex = sortedChildren[k];
+			if(!node.isLeafChild(childIndex) || 
+			   nearHitTs[childIndex] > static_cast<float32>(bvhRay.getMaxT()))
+			{
+				continue;
+			}
+
+			const std::size_t primitivesOffset = node.primitivesOffset(childIndex);
+			const std::size_t numPrimitives    = node.numPrimitives(childIndex);
+			for(std::size_t p = 0; p < numPrimitives; ++p)
+			{
+				HitProbe currentProbe(probe);
+				if(isIntersectingItem(primitivesOffset + p, bvhRay, currentProbe))
+				{
+					const real hitT = currentProbe.getHitRayT();
+					if(hitT < minHitT)
+					{
+						minHitT = hitT;
+						bvhRay.setMaxT(hitT);
+						closestProbe = currentProbe;
+					}
+				}
+			}
+		}
+
+		// internal children are pushed from far to near so the nearest one
+		// is visited first
+		for(std::size_t k = numHitChildren; k > 0; --k)
+		{
+			const std::size_t childIndex = sortedChildren[k - 1];
+			if(node.isLeafChild(childIndex))
+			{
+				continue;
+			}
+
+			PH_ASSERT_LT(numTodoNodes, NODE_STACK_SIZE);
+			todoNodes[numTodoNodes++] = {node.childNodeIndex(childIndex), nearHitTs[childIndex]};
+		}
+	}
+
+	if(minHitT < std::numeric_limits<real>::max())
+	{
+		probe = closestProbe;
+		return true;
+	}
+	else
+	{
+		return false;
+	}
+}
+
+template<std::size_t N>
+template<typename ItemOccluder>
+inline bool TWideBvh<N>::isOccluded(
+	const Ray&          ray,
+	const ItemOccluder& isOccludedByItem) const
+{
+	if(m_nodes.empty())
+	{
+		return false;
+	}
+
+	const typename TWideBvhNode<N>::RaySegment segment(ray);
+	const float32 minT = static_cast<float32>(ray.getMinT());
+	const float32 maxT = static_cast<float32>(ray.getMaxT());
+
+	std::size_t todoNodes[NODE_STACK_SIZE];
+	std::size_t numTodoNodes = 0;
+	todoNodes[numTodoNodes++] = 0;
+
+	// Children are not sorted here: any hit terminates the traversal, and the
+	// ray segment never shrinks.
+	while(numTodoNodes > 0)
+	{
+		const TWideBvhNode<N>& node = m_nodes[todoNodes[--numTodoNodes]];
+
+		float32 nearHitTs[N];
+		uint32 hitMask = node.isIntersectingChildVolumes(segment, minT, maxT, nearHitTs);
+		for(std::size_t i = 0; hitMask != 0; ++i, hitMask >>= 1)
+		{
+			if(!(hitMask & 1))
+			{
+				continue;
+			}
+
+			if(node.isLeafChild(i))
+			{
+				const std::size_t primitivesOffset = node.primitivesOffset(i);
+				const std::size_t numPrimitives    = node.numPrimitives(i);
+				for(std::size_t p = 0; p < numPrimitives; ++p)
+				{
+					if(isOccludedByItem(primitivesOffset + p, ray))
+					{
+						return true;
+					}
+				}
+			}
+			else
+			{
+				PH_ASSERT_LT(numTodoNodes, NODE_STACK_SIZE);
+				todoNodes[numTodoNodes++] = node.childNodeIndex(i);
+			}
+		}
+	}
+
+	return false;
+}
+
+template<std::size_t N>
+inline void TWideBvh<N>::clear()
+{
+	m_nodes.clear();
+	m_nodes.shrink_to_fit();
+}
+
+template<std::size_t N>
+inline bool TWideBvh<N>::isEmpty() const
+{
+	return m_nodes.empty();
+}
+
+template<std::size_t N>
+inline std::size_t TWideBvh<N>::numNodes() const
+{
+	return m_nodes.size();
+}
+
+}// end namespace ph
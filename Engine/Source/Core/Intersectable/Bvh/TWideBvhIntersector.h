@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Core/Intersectable/Intersector.h"
+#include "Common/primitive_type.h"
+#include "Core/Intersectable/Bvh/TWideBvh.h"
+#include "Core/Intersectable/Bvh/EBvhType.h"
+
+#include <vector>
+#include <cstddef>
+
+namespace ph
+{
+
+class Intersectable;
+
+/*
+	A BVH with N children per node. The tree is built as a binary BVH first
+	then collapsed; all children of a node are tested against the ray at once
+	and visited in front-to-back order.
+*/
+template<std::size_t N>
+class TWideBvhIntersector : public Intersector
+{
+public:
+	TWideBvhIntersector();
+	explicit TWideBvhIntersector(EBvhType bvhType);
+
+	void update(const CookedDataStorage& cookedActors) override;
+	bool isIntersecting(const Ray& ray, HitProbe& probe) const override;
+	bool isOccluded(const Ray& ray) const override;
+	void calcAABB(AABB3D* out_aabb) const override;
+
+	void rebuildWithIntersectables(std::vector<const Intersectable*> intersectables);
+
+private:
+	std::vector<const Intersectable*> m_intersectables;
+	TWideBvh<N>                       m_bvh;
+	EBvhType                          m_bvhType;
+};
+
+}// end namespace ph
+
+#include "Core/Intersectable/Bvh/TWideBvhIntersector.ipp"
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "Core/Intersectable/Bvh/TWideBvhIntersector.h"
+#include "Actor/CookedDataStorage.h"
+#include "Core/HitProbe.h"
+#include "Core/Ray.h"
+#include "Core/Bound/TAABB3D.h"
+#include "Common/assertion.h"
+
+#include <iostream>
+#include <limits>
+#include <utility>
+
+namespace ph
+{
+
+template<std::size_t N>
+inline TWideBvhIntersector<N>::TWideBvhIntersector() :
+	TWideBvhIntersector(EBvhType::SAH_BUCKET)
+{}
+
+template<std::size_t N>
+inline TWideBvhIntersector<N>::TWideBvhIntersector(const EBvhType bvhType) :
+	Intersector(),
+	m_intersectables(),
+	m_bvh(),
+	m_bvhType(bvhType)
+{}
+
+template<std::size_t N>
+inline void TWideBvhIntersector<N>::update(const CookedDataStorage& cookedActors)
+{
+	std::vector<const Intersectable*> intersectables;
+	for(const auto& intersectable : cookedActors.intersectables())
+	{
+		// intersectables without finite bounds cannot be partitioned spatially
+		AABB3D aabb;
+		intersectable->calcAABB(&aabb);
+		if(!aabb.isFiniteVolume())
+		{
+			continue;
+		}
+
+		intersectables.push_back(intersectable.get());
+	}
+
+	rebuildWithIntersectables(std::move(intersectables));
+}
+
+template<std::size_t N>
+inline bool TWideBvhIntersector<N>::isIntersecting(const Ray& ray, HitProbe& probe) const
+{
+	return m_bvh.isIntersecting(ray, probe, 
+		[this](const std::size_t itemIndex, const Ray& bvhRay, HitProbe& itemProbe)
+		{
+			return m_intersectables[itemIndex]->isIntersecting(bvhRay, itemProbe);
+		});
+}
+
+template<std::size_t N>
+inline bool TWideBvhIntersector<N>::isOccluded(const Ray& ray) const
+{
+	return m_bvh.isOccluded(ray, 
+		[this](const std::size_t itemIndex, const Ray& bvhRay)
+		{
+			return m_intersectables[itemIndex]->isOccluded(bvhRay);
+		});
+}
+
+template<std::size_t N>
+inline void TWideBvhIntersector<N>::calcAABB(AABB3D* const out_aabb) const
+{
+	if(m_intersectables.empty())
+	{
+		*out_aabb = AABB3D();
+		return;
+	}
+
+	m_intersectables.front()->calcAABB(out_aabb);
+	for(auto intersectable : m_intersectables)
+	{
+		AABB3D aabb;
+		intersectable->calcAABB(&aabb);
+		out_aabb->unionWith(aabb);
+	}
+}
+
+template<std::size_t N>
+inline void TWideBvhIntersector<N>::rebuildWithIntersectables(std::vector<const Intersectable*> intersectables)
+{
+	if(intersectables.empty())
+	{
+		m_bvh.clear();
+		m_intersectables.clear();
+
+		std::cerr << "warning: at TWideBvhIntersector::rebuildWithIntersectables(), " 
+		          << "no intersectable is present" << std::endl;
+		return;
+	}
+
+	std::vector<AABB3D> aabbs(intersectables.size());
+	for(std::size_t i = 0; i < intersectables.size(); ++i)
+	{
+		intersectables[i]->calcAABB(&aabbs[i]);
+	}
+
+	std::vector<std::size_t> itemOrder;
+	m_bvh.build(aabbs, m_bvhType, &itemOrder);
+
+	m_intersectables.clear();
+	m_intersectables.reserve(itemOrder.size());
+	for(const std::size_t intersectableIndex : itemOrder)
+	{
+		m_intersectables.push_back(intersectables[intersectableIndex]);
+	}
+}
+
+}// end namespace ph
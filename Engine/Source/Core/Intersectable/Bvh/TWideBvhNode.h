@@ -0,0 +1,300 @@
+#pragma once
+
+#include "Common/primitive_type.h"
+#include "Common/compiler.h"
+#include "Common/assertion.h"
+#include "Core/Bound/TAABB3D.h"
+#include "Core/Ray.h"
+
+#include <cstddef>
+#include <array>
+#include <limits>
+#include <cmath>
+
+#if defined(PH_USE_SIMD) && defined(PH_ISA_HAS_SSE2)
+	#include <emmintrin.h>
+#endif
+
+#if defined(PH_USE_SIMD) && defined(PH_ISA_HAS_AVX)
+	#include <immintrin.h>
+#endif
+
+namespace ph
+{
+
+/*
+	A BVH node with N children. Bounds of the children are stored in SoA
+	layout (single precision, rounded conservatively) so that all of them can
+	be tested against a ray at once. Each child can be an internal node, a leaf
+	(a range of primitives) or empty.
+*/
+template<std::size_t N>
+class alignas(sizeof(float32) * N) TWideBvhNode final
+{
+	static_assert(N >= 2 && N <= 32 && (N & (N - 1)) == 0,
+		"number of children must be a power of 2 in [2, 32]");
+
+public:
+	/*
+		Ray data that is shared across node tests during a traversal.
+	*/
+	class RaySegment final
+	{
+	public:
+		explicit RaySegment(const Ray& ray);
+
+		std::array<float32, 3> origin;
+		std::array<float32, 3> reciDir;
+		std::array<bool, 3>    isDirNeg;
+	};
+
+public:
+	TWideBvhNode();
+
+	void setInternalChild(std::size_t childIndex, const AABB3D& childAABB, std::size_t childNodeIndex);
+	void setLeafChild(std::size_t childIndex, const AABB3D& childAABB, std::size_t primitivesOffset, std::size_t numPrimitives);
+
+	bool isEmptyChild(std::size_t childIndex) const;
+	bool isLeafChild(std::size_t childIndex) const;
+	std::size_t childNodeIndex(std::size_t childIndex) const;
+	std::size_t primitivesOffset(std::size_t childIndex) const;
+	std::size_t numPrimitives(std::size_t childIndex) const;
+
+	/*
+		Tests the ray segment [minT, maxT] against all child AABBs. Returns a
+		bit mask where the i-th bit is set if the i-th child is hit; parametric
+		distances where the ray enters each hit child are stored in
+		<out_nearHitTs>.
+	*/
+	uint32 isIntersectingChildVolumes(
+		const RaySegment& segment,
+		float32           minT,
+		float32           maxT,
+		float32*          out_nearHitTs) const;
+
+private:
+	constexpr static uint32 EMPTY_CHILD = std::numeric_limits<uint32>::max();
+
+	// indexed by [min/max vertex][axis][child]
+	float32 m_bounds[2][3][N];
+
+	// For internal children this is the index of the child node; for leaf
+	// children this is the offset to the primitive buffer.
+	uint32 m_childData[N];
+
+	// 0 for internal children, EMPTY_CHILD for empty ones and number of
+	// primitives for leaf children.
+	uint32 m_numPrimitives[N];
+
+	void setChildAABB(std::size_t childIndex, const AABB3D& childAABB);
+};
+
+// In-header Implementations:
+
+template<std::size_t N>
+inline TWideBvhNode<N>::RaySegment::RaySegment(const Ray& ray)
+{
+	for(std::size_t axis = 0; axis < 3; ++axis)
+	{
+		origin[axis]  = static_cast<float32>(ray.getOrigin()[axis]);
+		reciDir[axis] = 1.0f / static_cast<float32>(ray.getDirection()[axis]);
+
+		// Sign of the reciprocal is used since it correctly handles -0
+		isDirNeg[axis] = reciDir[axis] < 0.0f;
+	}
+}
+
+template<std::size_t N>
+inline TWideBvhNode<N>::TWideBvhNode()
+{
+	for(std::size_t i = 0; i < N; ++i)
+	{
+		for(std::size_t axis = 0; axis < 3; ++axis)
+		{
+			// an inverted bound that no ray can hit
+			m_bounds[0][axis][i] =  std::numeric_limits<float32>::infinity();
+			m_bounds[1][axis][i] = -std::numeric_limits<float32>::infinity();
+		}
+
+		m_childData[i]     = 0;
+		m_numPrimitives[i] = EMPTY_CHILD;
+	}
+}
+
+template<std::size_t N>
+inline void TWideBvhNode<N>::setInternalChild(
+	const std::size_t childIndex,
+	const AABB3D&     childAABB,
+	const std::size_t childNodeIndex)
+{
+	PH_ASSERT_LT(childIndex, N);
+	PH_ASSERT_LT(childNodeIndex, EMPTY_CHILD);
+
+	setChildAABB(childIndex, childAABB);
+	m_childData[childIndex]     = static_cast<uint32>(childNodeIndex);
+	m_numPrimitives[childIndex] = 0;
+}
+
+template<std::size_t N>
+inline void TWideBvhNode<N>::setLeafChild(
+	const std::size_t childIndex,
+	const AABB3D&     childAABB,
+	const std::size_t primitivesOffset,
+	const std::size_t numPrimitives)
+{
+	PH_ASSERT_LT(childIndex, N);
+	PH_ASSERT_LT(primitivesOffset, EMPTY_CHILD);
+	PH_ASSERT_MSG(0 < numPrimitives && numPrimitives < EMPTY_CHILD, std::to_string(numPrimitives));
+
+	setChildAABB(childIndex, childAABB);
+	m_childData[childIndex]     = static_cast<uint32>(primitivesOffset);
+	m_numPrimitives[childIndex] = static_cast<uint32>(numPrimitives);
+}
+
+template<std::size_t N>
+inline void TWideBvhNode<N>::setChildAABB(const std::size_t childIndex, const AABB3D& childAABB)
+{
+	for(std::size_t axis = 0; axis < 3; ++axis)
+	{
+		// round outwards so the single precision bound still encloses the
+		// original one
+		const float32 minValue = static_cast<float32>(childAABB.getMinVertex()[axis]);
+		const float32 maxValue = static_cast<float32>(childAABB.getMaxVertex()[axis]);
+		m_bounds[0][axis][childIndex] = std::nextafter(minValue, -std::numeric_limits<float32>::infinity());
+		m_bounds[1][axis][childIndex] = std::nextafter(maxValue,  std::numeric_limits<float32>::infinity());
+	}
+}
+
+template<std::size_t N>
+inline bool TWideBvhNode<N>::isEmptyChild(const std::size_t childIndex) const
+{
+	PH_ASSERT_LT(childIndex, N);
+
+	return m_numPrimitives[childIndex] == EMPTY_CHILD;
+}
+
+template<std::size_t N>
+inline bool TWideBvhNode<N>::isLeafChild(const std::size_t childIndex) const
+{
+	PH_ASSERT_LT(childIndex, N);
+
+	return m_numPrimitives[childIndex] != 0 && m_numPrimitives[childIndex] != EMPTY_CHILD;
+}
+
+template<std::size_t N>
+inline std::size_t TWideBvhNode<N>::childNodeIndex(const std::size_t childIndex) const
+{
+	PH_ASSERT(!isEmptyChild(childIndex) && !isLeafChild(childIndex));
+
+	return m_childData[childIndex];
+}
+
+template<std::size_t N>
+inline std::size_t TWideBvhNode<N>::primitivesOffset(const std::size_t childIndex) const
+{
+	PH_ASSERT(isLeafChild(childIndex));
+
+	return m_childData[childIndex];
+}
+
+template<std::size_t N>
+inline std::size_t TWideBvhNode<N>::numPrimitives(const std::size_t childIndex) const
+{
+	PH_ASSERT(isLeafChild(childIndex));
+
+	return m_numPrimitives[childIndex];
+}
+
+/*
+	Slab test against all children. Near and far planes are selected by the
+	sign of ray direction, and the comparisons are ordered such that NaNs
+	(from 0 * inf) never replace the current ray interval.
+*/
+template<std::size_t N>
+inline uint32 TWideBvhNode<N>::isIntersectingChildVolumes(
+	const RaySegment& segment,
+	const float32     minT,
+	const float32     maxT,
+	float32* const    out_nearHitTs) const
+{
+	PH_ASSERT(out_nearHitTs);
+
+	uint32 hitMask = 0;
+	std::size_t i  = 0;
+
+#if defined(PH_USE_SIMD) && defined(PH_ISA_HAS_AVX)
+	for(; i + 8 <= N; i += 8)
+	{
+		__m256 nearT = _mm256_set1_ps(minT);
+		__m256 farT  = _mm256_set1_ps(maxT);
+		for(std::size_t axis = 0; axis < 3; ++axis)
+		{
+			const float32* const nearPlanes = m_bounds[segment.isDirNeg[axis] ? 1 : 0][axis];
+			const float32* const farPlanes  = m_bounds[segment.isDirNeg[axis] ? 0 : 1][axis];
+
+			const __m256 origin  = _mm256_set1_ps(segment.origin[axis]);
+			const __m256 reciDir = _mm256_set1_ps(segment.reciDir[axis]);
+			const __m256 t0 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(nearPlanes + i), origin), reciDir);
+			const __m256 t1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(farPlanes + i), origin), reciDir);
+
+			// max/min return the second operand if either one is NaN
+			nearT = _mm256_max_ps(t0, nearT);
+			farT  = _mm256_min_ps(t1, farT);
+		}
+
+		_mm256_storeu_ps(out_nearHitTs + i, nearT);
+		const int mask = _mm256_movemask_ps(_mm256_cmp_ps(nearT, farT, _CMP_LE_OQ));
+		hitMask |= static_cast<uint32>(mask) << i;
+	}
+#endif
+
+#if defined(PH_USE_SIMD) && defined(PH_ISA_HAS_SSE2)
+	for(; i + 4 <= N; i += 4)
+	{
+		__m128 nearT = _mm_set1_ps(minT);
+		__m128 farT  = _mm_set1_ps(maxT);
+		for(std::size_t axis = 0; axis < 3; ++axis)
+		{
+			const float32* const nearPlanes = m_bounds[segment.isDirNeg[axis] ? 1 : 0][axis];
+			const float32* const farPlanes  = m_bounds[segment.isDirNeg[axis] ? 0 : 1][axis];
+
+			const __m128 origin  = _mm_set1_ps(segment.origin[axis]);
+			const __m128 reciDir = _mm_set1_ps(segment.reciDir[axis]);
+			const __m128 t0 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(nearPlanes + i), origin), reciDir);
+			const __m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(farPlanes + i), origin), reciDir);
+
+			// max/min return the second operand if either one is NaN
+			nearT = _mm_max_ps(t0, nearT);
+			farT  = _mm_min_ps(t1, farT);
+		}
+
+		_mm_storeu_ps(out_nearHitTs + i, nearT);
+		const int mask = _mm_movemask_ps(_mm_cmple_ps(nearT, farT));
+		hitMask |= static_cast<uint32>(mask) << i;
+	}
+#endif
+
+	for(; i < N; ++i)
+	{
+		float32 nearT = minT;
+		float32 farT  = maxT;
+		for(std::size_t axis = 0; axis < 3; ++axis)
+		{
+			const float32 nearPlane = m_bounds[segment.isDirNeg[axis] ? 1 : 0][axis][i];
+			const float32 farPlane  = m_bounds[segment.isDirNeg[axis] ? 0 : 1][axis][i];
+
+			const float32 t0 = (nearPlane - segment.origin[axis]) * segment.reciDir[axis];
+			const float32 t1 = (farPlane  - segment.origin[axis]) * segment.reciDir[axis];
+
+			nearT = t0 > nearT ? t0 : nearT;
+			farT  = t1 < farT  ? t1 : farT;
+		}
+
+		out_nearHitTs[i] = nearT;
+		hitMask |= static_cast<uint32>(nearT <= farT) << i;
+	}
+
+	return hitMask;
+}
+
+}// end namespace ph
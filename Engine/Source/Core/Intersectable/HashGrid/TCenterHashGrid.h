@@ -0,0 +1,340 @@
+#pragma once
+
+#include "Common/primitive_type.h"
+#include "Common/assertion.h"
+#include "Math/TVector3.h"
+#include "Math/hash.h"
+#include "Math/math.h"
+#include "Utility/utility.h"
+#include "Utility/concurrent.h"
+
+#include <vector>
+#include <utility>
+#include <cstddef>
+#include <cmath>
+#include <limits>
+
+namespace ph
+{
+
+/*
+	A spatial hash grid over item centers, suitable for range searches of a
+	radius that is known before building (e.g., photon gathering with a fixed
+	kernel radius). Items are stored sorted by hash bucket; a search visits
+	every cell overlapping the search sphere and scans the bucket of each.
+	Searches are most efficient when the cell size is close to the search
+	radius. As in TCenterKdtree, item centers are kept in a separate array,
+	and a built grid can be saved and used in place (see Storage).
+*/
+template<typename Item, typename CenterCalculator>
+class TCenterHashGrid
+{
+public:
+	// Arrays of a built grid; items of bucket i are in 
+	// [bucketBegins[i], bucketBegins[i + 1]).
+	struct Storage
+	{
+		const Item*        items;
+		const Vector3R*    itemCenters;
+		const std::size_t* bucketBegins;
+		std::size_t        numItems;
+		std::size_t        numBuckets;
+		real               reciCellSize;
+	};
+
+	explicit TCenterHashGrid(const CenterCalculator& centerCalculator);
+
+	void build(std::vector<Item>&& items, real cellSize);
+
+	void findWithinRange(
+		const Vector3R&    location,
+		real               searchRadius,
+		std::vector<Item>& results) const;
+
+	// Calls <itemHandler> with each item (as const Item&) within range, 
+	// without copying them.
+	template<typename ItemHandler>
+	void forEachWithinRange(
+		const Vector3R& location,
+		real            searchRadius,
+		ItemHandler     itemHandler) const;
+
+	std::size_t numItems() const;
+
+	// Calls <bucketHandler> with the number of items of each bucket.
+	template<typename BucketHandler>
+	void forEachBucket(BucketHandler bucketHandler) const;
+
+	// Number of bytes used by items, item centers and buckets.
+	std::size_t memoryUsage() const;
+
+	Storage getStorage() const;
+
+	// Makes the grid use the arrays of <storage> instead of building; see
+	// TCenterKdtree::useStorage().
+	void useStorage(const Storage& storage);
+
+	// Whether the arrays of <storage> form a grid that can be searched 
+	// without reading out of bounds, e.g., after loading them from a file.
+	static bool isStorageValid(const Storage& storage);
+
+private:
+	using Cell = TVector3<int64>;
+
+	std::vector<Item>        m_items;
+	std::vector<Vector3R>    m_itemCenters;
+	std::vector<std::size_t> m_bucketBegins;
+	real                     m_reciCellSize;
+	CenterCalculator         m_centerCalculator;
+	Storage                  m_externalStorage;
+	bool                     m_isStorageExternal;
+
+	Cell toCell(const Vector3R& position) const;
+};
+
+// In-header Implementations:
+
+template<typename Item, typename CenterCalculator>
+inline TCenterHashGrid<Item, CenterCalculator>::
+TCenterHashGrid(const CenterCalculator& centerCalculator) :
+
+	m_items(),
+	m_itemCenters(),
+	m_bucketBegins(),
+	m_reciCellSize(1.0_r),
+	m_centerCalculator(centerCalculator),
+	m_externalStorage(),
+	m_isStorageExternal(false)
+{}
+
+template<typename Item, typename CenterCalculator>
+inline void TCenterHashGrid<Item, CenterCalculator>::
+	build(std::vector<Item>&& items, const real cellSize)
+{
+	PH_ASSERT_GT(cellSize, 0.0_r);
+
+	m_reciCellSize = 1.0_r / cellSize;
+	m_bucketBegins.clear();
+	m_items.clear();
+	m_itemCenters.clear();
+	m_isStorageExternal = false;
+	if(items.empty())
+	{
+		return;
+	}
+
+	// about one item per bucket
+	PH_ASSERT(items.size() <= (std::size_t(1) << 31));
+	const std::size_t numBuckets = math::next_power_of_2(static_cast<uint32>(items.size()));
+
+	std::vector<Vector3R>    itemCenters(items.size());
+	std::vector<std::size_t> itemBucketIndices(items.size());
+	parallel_for(0, items.size(), 4096,
+		[this, &items, &itemCenters, &itemBucketIndices, numBuckets](const std::size_t workBegin, const std::size_t workEnd)
+		{
+			for(std::size_t i = workBegin; i < workEnd; ++i)
+			{
+				itemCenters[i]       = m_centerCalculator(regular_access(items[i]));
+				itemBucketIndices[i] = hash::discrete_spatial_hash(toCell(itemCenters[i]), numBuckets);
+			}
+		});
+
+	// Counting sort items by bucket index. Items of the same bucket keep
+	// their input order, so the result does not depend on thread count.
+
+	m_bucketBegins.resize(numBuckets + 1, 0);
+	for(const std::size_t bucketIndex : itemBucketIndices)
+	{
+		++m_bucketBegins[bucketIndex + 1];
+	}
+	for(std::size_t i = 1; i < m_bucketBegins.size(); ++i)
+	{
+		m_bucketBegins[i] += m_bucketBegins[i - 1];
+	}
+
+	std::vector<std::size_t> bucketEnds(m_bucketBegins.begin(), m_bucketBegins.end() - 1);
+	std::vector<std::size_t> sortedIndices(items.size());
+	for(std::size_t i = 0; i < items.size(); ++i)
+	{
+		sortedIndices[bucketEnds[itemBucketIndices[i]]++] = i;
+	}
+
+	m_items.reserve(items.size());
+	m_itemCenters.reserve(items.size());
+	for(const std::size_t itemIndex : sortedIndices)
+	{
+		m_items.push_back(std::move(items[itemIndex]));
+		m_itemCenters.push_back(itemCenters[itemIndex]);
+	}
+	items.clear();
+}
+
+template<typename Item, typename CenterCalculator>
+inline void TCenterHashGrid<Item, CenterCalculator>::
+	findWithinRange(
+		const Vector3R&    location,
+		const real         searchRadius,
+		std::vector<Item>& results) const
+{
+	forEachWithinRange(location, searchRadius,
+		[&results](const Item& item)
+		{
+			results.push_back(item);
+		});
+}
+
+template<typename Item, typename CenterCalculator>
+template<typename ItemHandler>
+inline void TCenterHashGrid<Item, CenterCalculator>::
+	forEachWithinRange(
+		const Vector3R& location,
+		const real      searchRadius,
+		ItemHandler     itemHandler) const
+{
+	const Storage storage = getStorage();
+	if(storage.numItems == 0)
+	{
+		return;
+	}
+
+	const real searchRadius2 = searchRadius * searchRadius;
+	const Cell minCell       = toCell(location.sub(searchRadius));
+	const Cell maxCell       = toCell(location.add(searchRadius));
+
+	for(int64 z = minCell.z; z <= maxCell.z; ++z)
+	{
+		for(int64 y = minCell.y; y <= maxCell.y; ++y)
+		{
+			for(int64 x = minCell.x; x <= maxCell.x; ++x)
+			{
+				const Cell        cell        = Cell(x, y, z);
+				const std::size_t bucketIndex = hash::discrete_spatial_hash(cell, storage.numBuckets);
+				for(std::size_t i = storage.bucketBegins[bucketIndex]; i < storage.bucketBegins[bucketIndex + 1]; ++i)
+				{
+					const Vector3R& itemCenter = storage.itemCenters[i];
+					if((itemCenter - location).lengthSquared() > searchRadius2)
+					{
+						continue;
+					}
+
+					// A bucket may hold items of other cells (hash collisions); only 
+					// accept items of the current cell so none is reported twice.
+					if(toCell(itemCenter) == cell)
+					{
+						itemHandler(storage.items[i]);
+					}
+				}
+			}
+		}
+	}
+}
+
+template<typename Item, typename CenterCalculator>
+inline std::size_t TCenterHashGrid<Item, CenterCalculator>::
+	numItems() const
+{
+	return getStorage().numItems;
+}
+
+template<typename Item, typename CenterCalculator>
+template<typename BucketHandler>
+inline void TCenterHashGrid<Item, CenterCalculator>::
+	forEachBucket(BucketHandler bucketHandler) const
+{
+	const Storage storage = getStorage();
+	for(std::size_t i = 0; i < storage.numBuckets; ++i)
+	{
+		bucketHandler(storage.bucketBegins[i + 1] - storage.bucketBegins[i]);
+	}
+}
+
+template<typename Item, typename CenterCalculator>
+inline std::size_t TCenterHashGrid<Item, CenterCalculator>::
+	memoryUsage() const
+{
+	const Storage storage = getStorage();
+	return 
+		sizeof(Item)        * storage.numItems + 
+		sizeof(Vector3R)    * storage.numItems + 
+		sizeof(std::size_t) * (storage.numBuckets > 0 ? storage.numBuckets + 1 : 0);
+}
+
+template<typename Item, typename CenterCalculator>
+inline auto TCenterHashGrid<Item, CenterCalculator>::
+	getStorage() const
+	-> Storage
+{
+	if(m_isStorageExternal)
+	{
+		return m_externalStorage;
+	}
+
+	Storage storage;
+	storage.items        = m_items.data();
+	storage.itemCenters  = m_itemCenters.data();
+	storage.bucketBegins = m_bucketBegins.data();
+	storage.numItems     = m_items.size();
+	storage.numBuckets   = m_bucketBegins.empty() ? 0 : m_bucketBegins.size() - 1;
+	storage.reciCellSize = m_reciCellSize;
+	return storage;
+}
+
+template<typename Item, typename CenterCalculator>
+inline void TCenterHashGrid<Item, CenterCalculator>::
+	useStorage(const Storage& storage)
+{
+	PH_ASSERT(storage.numItems == 0 || (storage.items && storage.itemCenters && storage.bucketBegins));
+	PH_ASSERT(storage.numItems == 0 || storage.numBuckets > 0);
+	PH_ASSERT_GT(storage.reciCellSize, 0.0_r);
+
+	m_items.clear();
+	m_itemCenters.clear();
+	m_bucketBegins.clear();
+	m_reciCellSize = storage.reciCellSize;
+
+	m_externalStorage   = storage;
+	m_isStorageExternal = true;
+}
+
+template<typename Item, typename CenterCalculator>
+inline bool TCenterHashGrid<Item, CenterCalculator>::
+	isStorageValid(const Storage& storage)
+{
+	if(!(storage.reciCellSize > 0.0_r && std::isfinite(storage.reciCellSize)))
+	{
+		return false;
+	}
+
+	if(storage.numItems == 0)
+	{
+		return true;
+	}
+
+	if(!(storage.items && storage.itemCenters && storage.bucketBegins) || storage.numBuckets == 0)
+	{
+		return false;
+	}
+
+	// bucket ranges must not overlap or reach past the last item
+	for(std::size_t i = 0; i < storage.numBuckets; ++i)
+	{
+		if(storage.bucketBegins[i] > storage.bucketBegins[i + 1])
+		{
+			return false;
+		}
+	}
+	return storage.bucketBegins[storage.numBuckets] <= storage.numItems;
+}
+
+template<typename Item, typename CenterCalculator>
+inline auto TCenterHashGrid<Item, CenterCalculator>::
+	toCell(const Vector3R& position) const
+	-> Cell
+{
+	return Cell(
+		static_cast<int64>(std::floor(position.x * m_reciCellSize)),
+		static_cast<int64>(std::floor(position.y * m_reciCellSize)),
+		static_cast<int64>(std::floor(position.z * m_reciCellSize)));
+}
+
+}// end namespace ph
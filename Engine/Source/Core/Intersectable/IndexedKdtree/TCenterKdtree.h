@@ -1,10 +1,13 @@
 #pragma once
 
+#include "Common/primitive_type.h"
 #include "Common/assertion.h"
 #include "Math/TVector3.h"
 #include "Core/Intersectable/IndexedKdtree/TIndexedKdtreeNode.h"
 #include "Core/Bound/TAABB3D.h"
 #include "Utility/utility.h"
+#include "Utility/concurrent.h"
+#include "Utility/TaskGroup.h"
 
 #include <vector>
 #include <utility>
@@ -12,18 +15,44 @@
 #include <algorithm>
 #include <array>
 #include <memory>
+#include <numeric>
+#include <limits>
 
 namespace ph
 {
 
+/*
+	A kd-tree over item centers, split at the median along the longest axis.
+	Since the split only depends on the number of items, the size of each
+	subtree is known in advance and subtrees are built in parallel.
+
+	Items are stored in leaf order, and their centers are kept in a separate
+	array; range searches only read centers, and items are touched only if
+	they are within range.
+
+	A built tree consists of three flat arrays without pointers, which can be
+	saved and later used in place, without building (see Storage).
+*/
 template<typename Item, typename Index, typename CenterCalculator>
 class TCenterKdtree
 {
 public:
 	using Node = TIndexedKdtreeNode<Index, false>;
 
+	// Arrays of a built tree; leaves refer to items by their offsets.
+	struct Storage
+	{
+		const Node*     nodes;
+		const Item*     items;
+		const Vector3R* itemCenters;
+		std::size_t     numNodes;
+		std::size_t     numItems;
+	};
+
 	TCenterKdtree(std::size_t maxNodeItems, const CenterCalculator& centerCalculator);
 
+	// Builds the tree with all available threads. The result is identical
+	// to a serial build.
 	void build(std::vector<Item>&& items);
 
 	void findWithinRange(
@@ -31,6 +60,14 @@ public:
 		real               searchRadius,
 		std::vector<Item>& results) const;
 
+	// Calls <itemHandler> with each item (as const Item&) within range, 
+	// without copying them.
+	template<typename ItemHandler>
+	void forEachWithinRange(
+		const Vector3R& location,
+		real            searchRadius,
+		ItemHandler     itemHandler) const;
+
 	template<typename NNResult>
 	void findNearestNeighbors(
 		const Vector3R&    location, 
@@ -39,23 +76,56 @@ public:
 
 	std::size_t numItems() const;
 
+	// Calls <leafHandler> with the depth (0 for the root) and the number of 
+	// items of each leaf.
+	template<typename LeafHandler>
+	void forEachLeaf(LeafHandler leafHandler) const;
+
+	// Number of bytes used by nodes, items and item centers.
+	std::size_t memoryUsage() const;
+
+	Storage getStorage() const;
+
+	// Makes the tree use the arrays of <storage>, e.g., ones obtained from 
+	// getStorage() and saved to a memory-mapped file, instead of building. 
+	// The arrays are not copied; they must outlive the tree, or be in use 
+	// until the next build().
+	void useStorage(const Storage& storage);
+
+	// Whether the arrays of <storage> form a tree that can be searched 
+	// without reading out of bounds, e.g., after loading them from a file.
+	static bool isStorageValid(const Storage& storage);
+
 private:
-	std::vector<Node>  m_nodeBuffer;
-	std::vector<Item>  m_items;
-	AABB3D             m_rootAABB;
-	std::size_t        m_numNodes;
-	std::size_t        m_maxNodeItems;
-	std::vector<Index> m_indexBuffer;
-	CenterCalculator   m_centerCalculator;
+	std::vector<Node>     m_nodeBuffer;
+	std::vector<Item>     m_items;
+	std::vector<Vector3R> m_itemCenters;
+	AABB3D                m_rootAABB;
+	std::size_t           m_numNodes;
+	std::size_t           m_maxNodeItems;
+	CenterCalculator      m_centerCalculator;
+	Storage               m_externalStorage;
+	bool                  m_isStorageExternal;
+
+	// subtrees with fewer items are built by a single thread
+	constexpr static std::size_t MIN_PARALLEL_BUILD_ITEMS = 32768;
+
+	// searches keep far nodes of at most this many ancestors
+	constexpr static std::size_t MAX_STACK_HEIGHT = 64;
 
 	void buildNodeRecursive(
 		std::size_t                  nodeIndex,
 		const AABB3D&                nodeAABB,
-		Index*                       nodeItemIndices,
+		Index*                       itemIndices,
+		std::size_t                  nodeItemsOffset,
 		std::size_t                  numNodeItems,
 		const std::vector<Vector3R>& itemCenters,
 		std::size_t                  currentNodeDepth);
 
+	// Returns the number of nodes in subtrees of <numItems> and 
+	// <numItems> + 1 items.
+	std::pair<std::size_t, std::size_t> calcNumSubtreeNodes(std::size_t numItems) const;
+
 	AABB3D calcCentersAABB(
 		const Index*                 itemIndices, 
 		std::size_t                  numItems, 
@@ -70,11 +140,13 @@ TCenterKdtree(const std::size_t maxNodeItems, const CenterCalculator& centerCalc
 
 	m_nodeBuffer(),
 	m_items(),
+	m_itemCenters(),
 	m_rootAABB(),
 	m_numNodes(0),
 	m_maxNodeItems(maxNodeItems),
-	m_indexBuffer(),
-	m_centerCalculator(centerCalculator)
+	m_centerCalculator(centerCalculator),
+	m_externalStorage(),
+	m_isStorageExternal(false)
 {
 	PH_ASSERT(maxNodeItems > 0);
 }
@@ -87,36 +159,54 @@ inline void TCenterKdtree<Item, Index, CenterCalculator>::
 	m_items    = std::move(items);
 	m_rootAABB = AABB3D();
 	m_numNodes = 0;
-	m_indexBuffer.clear();
+	m_itemCenters.clear();
+	m_isStorageExternal = false;
 	if(m_items.empty())
 	{
 		return;
 	}
 
-	std::vector<Vector3R> itemCenters;
-	for(const auto& item : m_items)
-	{
-		const Vector3R& center = m_centerCalculator(regular_access(item));
-		itemCenters.push_back(center);
-	}
+	std::vector<Vector3R> itemCenters(m_items.size());
+	parallel_for(0, m_items.size(), 4096,
+		[this, &itemCenters](const std::size_t workBegin, const std::size_t workEnd)
+		{
+			for(std::size_t i = workBegin; i < workEnd; ++i)
+			{
+				itemCenters[i] = m_centerCalculator(regular_access(m_items[i]));
+			}
+		});
 
-	std::unique_ptr<Index[]> itemIndices(new Index[m_items.size()]);
+	PH_ASSERT(m_items.size() - 1 <= static_cast<std::size_t>(std::numeric_limits<Index>::max()));
+	std::vector<Index> itemIndices(m_items.size());
+	std::iota(itemIndices.begin(), itemIndices.end(), Index(0));
 
-	PH_ASSERT(m_items.size() - 1 <= std::numeric_limits<Index>::max());
-	for(std::size_t i = 0; i < m_items.size(); ++i)
-	{
-		itemIndices[i] = static_cast<Index>(i);
-	}
+	m_rootAABB = calcCentersAABB(itemIndices.data(), m_items.size(), itemCenters);
 
-	m_rootAABB = calcCentersAABB(itemIndices.get(), m_items.size(), itemCenters);
+	m_numNodes = calcNumSubtreeNodes(m_items.size()).first;
+	m_nodeBuffer.resize(m_numNodes);
 
 	buildNodeRecursive(
 		0,
 		m_rootAABB,
-		itemIndices.get(),
+		itemIndices.data(),
+		0,
 		m_items.size(),
 		itemCenters,
 		0);
+
+	// Each leaf refers to a contiguous range of the partitioned indices, in 
+	// the same order as leaves appear in the node buffer. Items and centers
+	// are reordered accordingly so leaves can refer to them directly.
+
+	std::vector<Item> sortedItems;
+	sortedItems.reserve(m_items.size());
+	m_itemCenters.resize(m_items.size());
+	for(std::size_t i = 0; i < itemIndices.size(); ++i)
+	{
+		sortedItems.push_back(std::move(m_items[itemIndices[i]]));
+		m_itemCenters[i] = itemCenters[itemIndices[i]];
+	}
+	m_items = std::move(sortedItems);
 }
 
 template<typename Item, typename Index, typename CenterCalculator>
@@ -126,14 +216,32 @@ inline void TCenterKdtree<Item, Index, CenterCalculator>::
 		const real         searchRadius,
 		std::vector<Item>& results) const
 {
-	PH_ASSERT(m_numNodes > 0);
+	forEachWithinRange(location, searchRadius, 
+		[&results](const Item& item)
+		{
+			results.push_back(item);
+		});
+}
+
+template<typename Item, typename Index, typename CenterCalculator>
+template<typename ItemHandler>
+inline void TCenterKdtree<Item, Index, CenterCalculator>::
+	forEachWithinRange(
+		const Vector3R& location,
+		const real      searchRadius,
+		ItemHandler     itemHandler) const
+{
+	const Storage storage = getStorage();
+	if(storage.numNodes == 0)
+	{
+		return;
+	}
 
 	const real searchRadius2 = searchRadius * searchRadius;
 
-	constexpr std::size_t MAX_STACK_HEIGHT = 64;
 	std::array<const Node*, MAX_STACK_HEIGHT> nodeStack;
 
-	const Node* currentNode = &(m_nodeBuffer[0]);
+	const Node* currentNode = &(storage.nodes[0]);
 	std::size_t stackHeight = 0;
 	while(true)
 	{
@@ -149,11 +257,11 @@ inline void TCenterKdtree<Item, Index, CenterCalculator>::
 			if(splitPlaneDiff < 0)
 			{
 				nearNode = currentNode + 1;
-				farNode  = &(m_nodeBuffer[currentNode->positiveChildIndex()]);
+				farNode  = &(storage.nodes[currentNode->positiveChildIndex()]);
 			}
 			else
 			{
-				nearNode = &(m_nodeBuffer[currentNode->positiveChildIndex()]);
+				nearNode = &(storage.nodes[currentNode->positiveChildIndex()]);
 				farNode  = currentNode + 1;
 			}
 
@@ -167,17 +275,14 @@ inline void TCenterKdtree<Item, Index, CenterCalculator>::
 		// current node is leaf
 		else
 		{
-			const std::size_t numItems          = currentNode->numItems();
-			const std::size_t indexBufferOffset = currentNode->indexBufferOffset();
-			for(std::size_t i = 0; i < numItems; ++i)
+			const std::size_t itemsBegin = currentNode->indexBufferOffset();
+			const std::size_t itemsEnd   = itemsBegin + currentNode->numItems();
+			for(std::size_t i = itemsBegin; i < itemsEnd; ++i)
 			{
-				const Index     itemIndex  = m_indexBuffer[indexBufferOffset + i];
-				const Item&     item       = m_items[itemIndex];
-				const Vector3R& itemCenter = m_centerCalculator(item);
-				const real      dist2      = (itemCenter - location).lengthSquared();
+				const real dist2 = (storage.itemCenters[i] - location).lengthSquared();
 				if(dist2 <= searchRadius2)
 				{
-					results.push_back(item);
+					itemHandler(storage.items[i]);
 				}
 			}
 
@@ -193,6 +298,126 @@ inline void TCenterKdtree<Item, Index, CenterCalculator>::
 	}// end while stackHeight > 0
 }
 
+template<typename Item, typename Index, typename CenterCalculator>
+template<typename LeafHandler>
+inline void TCenterKdtree<Item, Index, CenterCalculator>::
+	forEachLeaf(LeafHandler leafHandler) const
+{
+	const Storage storage = getStorage();
+	if(storage.numNodes == 0)
+	{
+		return;
+	}
+
+	// pairs of node index and depth
+	std::vector<std::pair<std::size_t, std::size_t>> nodeStack;
+	nodeStack.push_back({0, 0});
+	while(!nodeStack.empty())
+	{
+		const auto [nodeIndex, depth] = nodeStack.back();
+		nodeStack.pop_back();
+
+		const Node& node = storage.nodes[nodeIndex];
+		if(node.isLeaf())
+		{
+			leafHandler(depth, node.numItems());
+		}
+		else
+		{
+			nodeStack.push_back({node.positiveChildIndex(), depth + 1});
+			nodeStack.push_back({nodeIndex + 1, depth + 1});
+		}
+	}
+}
+
+template<typename Item, typename Index, typename CenterCalculator>
+inline std::size_t TCenterKdtree<Item, Index, CenterCalculator>::
+	memoryUsage() const
+{
+	const Storage storage = getStorage();
+	return 
+		sizeof(Node)     * storage.numNodes + 
+		sizeof(Item)     * storage.numItems + 
+		sizeof(Vector3R) * storage.numItems;
+}
+
+template<typename Item, typename Index, typename CenterCalculator>
+inline auto TCenterKdtree<Item, Index, CenterCalculator>::
+	getStorage() const
+	-> Storage
+{
+	if(m_isStorageExternal)
+	{
+		return m_externalStorage;
+	}
+
+	Storage storage;
+	storage.nodes       = m_nodeBuffer.data();
+	storage.items       = m_items.data();
+	storage.itemCenters = m_itemCenters.data();
+	storage.numNodes    = m_numNodes;
+	storage.numItems    = m_items.size();
+	return storage;
+}
+
+template<typename Item, typename Index, typename CenterCalculator>
+inline void TCenterKdtree<Item, Index, CenterCalculator>::
+	useStorage(const Storage& storage)
+{
+	PH_ASSERT(storage.numNodes == 0 || (storage.nodes && storage.items && storage.itemCenters));
+
+	m_nodeBuffer.clear();
+	m_items.clear();
+	m_itemCenters.clear();
+	m_rootAABB = AABB3D();
+	m_numNodes = 0;
+
+	m_externalStorage   = storage;
+	m_isStorageExternal = true;
+}
+
+template<typename Item, typename Index, typename CenterCalculator>
+inline bool TCenterKdtree<Item, Index, CenterCalculator>::
+	isStorageValid(const Storage& storage)
+{
+	if(storage.numNodes > 0 && !(storage.nodes && storage.items && storage.itemCenters))
+	{
+		return false;
+	}
+
+	// The negative child follows its parent and the positive child comes 
+	// after the negative subtree, so children always have larger indices 
+	// and depths are known before nodes are visited.
+	std::vector<uint8> nodeDepths(storage.numNodes, 0);
+	for(std::size_t i = 0; i < storage.numNodes; ++i)
+	{
+		const Node& node = storage.nodes[i];
+		if(node.isLeaf())
+		{
+			const std::size_t numNodeItems = node.numItems();
+			if(numNodeItems > storage.numItems || 
+			   node.indexBufferOffset() > storage.numItems - numNodeItems)
+			{
+				return false;
+			}
+		}
+		else
+		{
+			const std::size_t positiveChildIndex = node.positiveChildIndex();
+			if(positiveChildIndex <= i + 1 || positiveChildIndex >= storage.numNodes ||
+			   nodeDepths[i] + 1 >= MAX_STACK_HEIGHT)
+			{
+				return false;
+			}
+
+			const uint8 childDepth = static_cast<uint8>(nodeDepths[i] + 1);
+			nodeDepths[i + 1]              = std::max(nodeDepths[i + 1], childDepth);
+			nodeDepths[positiveChildIndex] = std::max(nodeDepths[positiveChildIndex], childDepth);
+		}
+	}
+	return true;
+}
+
 template<typename Item, typename Index, typename CenterCalculator>
 template<typename NNResult>
 inline void TCenterKdtree<Item, Index, CenterCalculator>::
@@ -212,27 +437,25 @@ inline void TCenterKdtree<Item, Index, CenterCalculator>::
 	buildNodeRecursive(
 		const std::size_t            nodeIndex,
 		const AABB3D&                nodeAABB,
-		Index* const                 nodeItemIndices,
+		Index* const                 itemIndices,
+		const std::size_t            nodeItemsOffset,
 		const std::size_t            numNodeItems,
 		const std::vector<Vector3R>& itemCenters,
 		const std::size_t            currentNodeDepth)
 {
-	++m_numNodes;
-	if(m_numNodes > m_nodeBuffer.size())
-	{
-		m_nodeBuffer.resize(m_numNodes * 2);
-	}
 	PH_ASSERT(nodeIndex < m_nodeBuffer.size());
 
 	if(numNodeItems <= m_maxNodeItems)
 	{
-		m_nodeBuffer[nodeIndex] = Node::makeLeaf(nodeItemIndices, numNodeItems, m_indexBuffer);
+		m_nodeBuffer[nodeIndex] = Node::makeLeaf(static_cast<Index>(nodeItemsOffset), numNodeItems);
 		return;
 	}
 
 	const Vector3R& nodeExtents = nodeAABB.getExtents();
 	const int       splitAxis   = nodeExtents.maxDimension();
 
+	Index* const nodeItemIndices = itemIndices + nodeItemsOffset;
+
 	const std::size_t midIndicesIndex = numNodeItems / 2;
 	std::nth_element(
 		nodeItemIndices, 
@@ -255,25 +478,76 @@ inline void TCenterKdtree<Item, Index, CenterCalculator>::
 	splitPosMaxVertex[splitAxis] = splitPos;
 	const AABB3D negativeNodeAABB(nodeAABB.getMinVertex(), splitPosMaxVertex);
 	const AABB3D positiveNodeAABB(splitPosMinVertex, nodeAABB.getMaxVertex());
-	
-	buildNodeRecursive(
-		nodeIndex + 1, 
-		negativeNodeAABB, 
-		nodeItemIndices,
-		numNegativeItems,
-		itemCenters,
-		currentNodeDepth + 1);
 
-	const std::size_t positiveChildIndex = m_numNodes;
+	// the negative subtree immediately follows the current node
+	const std::size_t positiveChildIndex = nodeIndex + 1 + calcNumSubtreeNodes(numNegativeItems).first;
 	m_nodeBuffer[nodeIndex] = Node::makeInner(splitPos, splitAxis, positiveChildIndex);
 
-	buildNodeRecursive(
-		positiveChildIndex,
-		positiveNodeAABB,
-		nodeItemIndices + midIndicesIndex,
-		numPositiveItems,
-		itemCenters,
-		currentNodeDepth + 1);
+	const auto buildNegativeChild = [=, &itemCenters]()
+	{
+		buildNodeRecursive(
+			nodeIndex + 1, 
+			negativeNodeAABB, 
+			itemIndices,
+			nodeItemsOffset,
+			numNegativeItems,
+			itemCenters,
+			currentNodeDepth + 1);
+	};
+
+	const auto buildPositiveChild = [=, &itemCenters]()
+	{
+		buildNodeRecursive(
+			positiveChildIndex,
+			positiveNodeAABB,
+			itemIndices,
+			nodeItemsOffset + midIndicesIndex,
+			numPositiveItems,
+			itemCenters,
+			currentNodeDepth + 1);
+	};
+
+	if(numNodeItems >= MIN_PARALLEL_BUILD_ITEMS)
+	{
+		TaskGroup negativeChildBuild;
+		negativeChildBuild.run(buildNegativeChild);
+		buildPositiveChild();
+		negativeChildBuild.wait();
+	}
+	else
+	{
+		buildNegativeChild();
+		buildPositiveChild();
+	}
+}
+
+template<typename Item, typename Index, typename CenterCalculator>
+inline auto TCenterKdtree<Item, Index, CenterCalculator>::
+	calcNumSubtreeNodes(const std::size_t numItems) const
+	-> std::pair<std::size_t, std::size_t>
+{
+	// A node of N items has children of floor(N/2) and ceil(N/2) items, so
+	// sizes of N and N + 1 items can be derived from sizes of N/2 and 
+	// N/2 + 1 items, taking O(log(N)) time.
+
+	if(numItems + 1 <= m_maxNodeItems)
+	{
+		return {1, 1};
+	}
+
+	const auto [numHalfNodes, numHalfPlusOneNodes] = calcNumSubtreeNodes(numItems / 2);
+	if(numItems % 2 == 0)
+	{
+		return {
+			numItems <= m_maxNodeItems ? 1 : 1 + 2 * numHalfNodes,
+			1 + numHalfNodes + numHalfPlusOneNodes};
+	}
+	else
+	{
+		return {
+			numItems <= m_maxNodeItems ? 1 : 1 + numHalfNodes + numHalfPlusOneNodes,
+			1 + 2 * numHalfPlusOneNodes};
+	}
 }
 
 template<typename Item, typename Index, typename CenterCalculator>
@@ -297,7 +571,7 @@ template<typename Item, typename Index, typename CenterCalculator>
 inline std::size_t TCenterKdtree<Item, Index, CenterCalculator>::
 	numItems() const
 {
-	return m_items.size();
+	return getStorage().numItems;
 }
 
 }// end namespace ph
\ No newline at end of file
@@ -33,6 +33,7 @@ public:
 
 	void build(std::vector<Item>&& items);
 	bool isIntersecting(const Ray& ray, HitProbe& probe) const;
+	bool isOccluded(const Ray& ray) const;
 	void getAABB(AABB3D* out_aabb) const;
 
 private:
@@ -265,6 +266,119 @@ inline bool TIndexedKdtree<Item, Index>::isIntersecting(const Ray& ray, HitProbe
 	return false;
 }
 
+template<typename Item, typename Index>
+inline bool TIndexedKdtree<Item, Index>::isOccluded(const Ray& ray) const
+{
+	PH_ASSERT(m_numNodes > 0);
+
+	struct NodeState
+	{
+		const Node* node;
+		real minT;
+		real maxT;
+	};
+
+	constexpr int MAX_STACK_HEIGHT = 64;
+
+	real minT, maxT;
+	if(!m_rootAABB.isIntersectingVolume(ray, &minT, &maxT))
+	{
+		return false;
+	}
+
+	const Vector3R reciRayDir(ray.getDirection().reciprocal());
+
+	std::array<NodeState, MAX_STACK_HEIGHT> nodeStack;
+	int stackHeight = 0;
+	const Node* currentNode = &(m_nodeBuffer[0]);
+	while(true)
+	{
+		if(!currentNode->isLeaf())
+		{
+			const int  splitAxis   = currentNode->splitAxisIndex();
+			const real splitPlaneT = (currentNode->splitPos() - ray.getOrigin()[splitAxis]) * reciRayDir[splitAxis];
+
+			const Node* nearHitNode;
+			const Node* farHitNode;
+			if((ray.getOrigin()[splitAxis] < currentNode->splitPos()) ||
+			   (ray.getOrigin()[splitAxis] == currentNode->splitPos() && ray.getDirection()[splitAxis] <= 0))
+			{
+				nearHitNode = currentNode + 1;
+				farHitNode  = &(m_nodeBuffer[currentNode->positiveChildIndex()]);
+			}
+			else
+			{
+				nearHitNode = &(m_nodeBuffer[currentNode->positiveChildIndex()]);
+				farHitNode  = currentNode + 1;
+			}
+
+			// see isIntersecting() for the cases
+			if(splitPlaneT > maxT || splitPlaneT < 0)
+			{
+				currentNode = nearHitNode;
+			}
+			else if(splitPlaneT < minT)
+			{
+				currentNode = farHitNode;
+			}
+			else
+			{
+				PH_ASSERT(stackHeight < MAX_STACK_HEIGHT);
+
+				nodeStack[stackHeight].node = farHitNode;
+				nodeStack[stackHeight].minT = splitPlaneT;
+				nodeStack[stackHeight].maxT = maxT;
+				++stackHeight;
+
+				currentNode = nearHitNode;
+				maxT        = splitPlaneT;
+			}
+		}
+		// current node is leaf
+		else
+		{
+			// Items can span multiple nodes; testing them against the original
+			// ray is fine as any hit within it blocks the ray.
+
+			const std::size_t numItems = currentNode->numItems();
+			if(numItems == 1)
+			{
+				const Item& item = m_items[currentNode->singleItemDirectIndex()];
+				if(regular_access(item).isOccluded(ray))
+				{
+					return true;
+				}
+			}
+			else
+			{
+				for(std::size_t i = 0; i < numItems; ++i)
+				{
+					const Index itemIndex = m_itemIndices[currentNode->indexBufferOffset() + i];
+					const Item& item      = m_items[itemIndex];
+					if(regular_access(item).isOccluded(ray))
+					{
+						return true;
+					}
+				}
+			}
+
+			if(stackHeight > 0)
+			{
+				--stackHeight;
+				currentNode = nodeStack[stackHeight].node;
+				minT        = nodeStack[stackHeight].minT;
+				maxT        = nodeStack[stackHeight].maxT;
+			}
+			else
+			{
+				break;
+			}
+		}// end is leaf node
+	}// end infinite loop
+
+	return false;
+}
+
 template<typename Item, typename Index>
 inline void TIndexedKdtree<Item, Index>::buildNodeRecursive(
 	const std::size_t nodeIndex,
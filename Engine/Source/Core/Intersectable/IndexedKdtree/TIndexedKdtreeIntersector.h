@@ -14,6 +14,7 @@ public:
 
 	void update(const CookedDataStorage& cookedActors) override;
 	bool isIntersecting(const Ray& ray, HitProbe& probe) const override;
+	bool isOccluded(const Ray& ray) const override;
 	void calcAABB(AABB3D* out_aabb) const override;
 
 private:
@@ -35,4 +35,10 @@ bool TIndexedKdtreeIntersector<IndexedKdtree>::isIntersecting(const Ray& ray, Hi
 	return m_tree.isIntersecting(ray, probe);
 }
 
+template<typename IndexedKdtree>
+bool TIndexedKdtreeIntersector<IndexedKdtree>::isOccluded(const Ray& ray) const
+{
+	return m_tree.isOccluded(ray);
+}
+
 }// end namespace ph
\ No newline at end of file
@@ -0,0 +1,287 @@
+#include "Core/Intersectable/IndexedTriangleBuffer.h"
+#include "Math/TVector2.h"
+#include "Math/math.h"
+
+#include <iostream>
+#include <algorithm>
+#include <numeric>
+#include <array>
+#include <limits>
+#include <cmath>
+#include <utility>
+
+namespace ph
+{
+
+namespace
+{
+
+constexpr float32 MAX_UINT16_VALUE = static_cast<float32>(std::numeric_limits<uint16>::max());
+
+// Maps a value in [0, 1] to the full range of uint16.
+inline uint16 quantize_unorm16(const real value)
+{
+	const real clampedValue = math::clamp(value, 0.0_r, 1.0_r);
+	return static_cast<uint16>(std::round(clampedValue * MAX_UINT16_VALUE));
+}
+
+inline real dequantize_unorm16(const uint16 value)
+{
+	return static_cast<real>(value) / MAX_UINT16_VALUE;
+}
+
+inline real sign_not_zero(const real value)
+{
+	return value >= 0.0_r ? 1.0_r : -1.0_r;
+}
+
+// Projects the unit vector onto an octahedron, then unfolds the octahedron
+// to a square in [-1, 1]^2.
+inline Vector2R octahedron_encode(const Vector3R& unitVector)
+{
+	const real l1Norm = std::abs(unitVector.x) + std::abs(unitVector.y) + std::abs(unitVector.z);
+	Vector2R encoded(unitVector.x / l1Norm, unitVector.y / l1Norm);
+	if(unitVector.z < 0.0_r)
+	{
+		encoded = Vector2R(
+			(1.0_r - std::abs(encoded.y)) * sign_not_zero(encoded.x),
+			(1.0_r - std::abs(encoded.x)) * sign_not_zero(encoded.y));
+	}
+	return encoded;
+}
+
+inline Vector3R octahedron_decode(const Vector2R& encoded)
+{
+	Vector3R unitVector(encoded.x, encoded.y, 1.0_r - std::abs(encoded.x) - std::abs(encoded.y));
+	if(unitVector.z < 0.0_r)
+	{
+		unitVector.x = (1.0_r - std::abs(encoded.y)) * sign_not_zero(encoded.x);
+		unitVector.y = (1.0_r - std::abs(encoded.x)) * sign_not_zero(encoded.y);
+	}
+	return unitVector.normalize();
+}
+
+}// end anonymous namespace
+
+IndexedTriangleBuffer::IndexedTriangleBuffer() :
+	m_positions(),
+	m_normals(),
+	m_uvws(),
+	m_quantizedNormals(),
+	m_quantizedUvws(),
+	m_indices(),
+	m_uvwMin(0),
+	m_uvwExtents(0),
+	m_isQuantized(false)
+{}
+
+IndexedTriangleBuffer::IndexedTriangleBuffer(
+	const std::vector<Vector3R>& positions,
+	const std::vector<Vector3R>& normals,
+	const std::vector<Vector3R>& uvws,
+	const bool                   isQuantized) :
+
+	IndexedTriangleBuffer()
+{
+	if(positions.size() != normals.size() || positions.size() != uvws.size() ||
+	   positions.size() % 3 != 0)
+	{
+		std::cerr << "warning: at IndexedTriangleBuffer::IndexedTriangleBuffer(), "
+		          << "bad input detected, buffer is left empty" << std::endl;
+		return;
+	}
+
+	if(positions.size() > std::numeric_limits<uint32>::max())
+	{
+		std::cerr << "warning: at IndexedTriangleBuffer::IndexedTriangleBuffer(), "
+		          << "too many vertices (" << positions.size() << "), buffer is left empty" << std::endl;
+		return;
+	}
+
+	m_isQuantized = isQuantized;
+
+	using Vertex = std::array<float32, 9>;
+	const auto makeVertex = [&](const std::size_t i) -> Vertex
+	{
+		return {
+			static_cast<float32>(positions[i].x), static_cast<float32>(positions[i].y), static_cast<float32>(positions[i].z),
+			static_cast<float32>(normals[i].x),   static_cast<float32>(normals[i].y),   static_cast<float32>(normals[i].z),
+			static_cast<float32>(uvws[i].x),      static_cast<float32>(uvws[i].y),      static_cast<float32>(uvws[i].z)};
+	};
+
+	// Identical vertices are found by sorting, so they end up being adjacent
+	// to each other.
+	std::vector<uint32> sortedInputIndices(positions.size());
+	std::iota(sortedInputIndices.begin(), sortedInputIndices.end(), 0);
+	std::sort(sortedInputIndices.begin(), sortedInputIndices.end(),
+		[&](const uint32 a, const uint32 b)
+		{
+			return makeVertex(a) < makeVertex(b);
+		});
+
+	std::vector<uint32> uniqueInputIndices;
+	m_indices.resize(positions.size());
+	for(std::size_t i = 0; i < sortedInputIndices.size(); ++i)
+	{
+		const uint32 inputIndex = sortedInputIndices[i];
+		if(i == 0 || makeVertex(sortedInputIndices[i - 1]) != makeVertex(inputIndex))
+		{
+			uniqueInputIndices.push_back(inputIndex);
+		}
+		m_indices[inputIndex] = static_cast<uint32>(uniqueInputIndices.size() - 1);
+	}
+
+	const std::size_t numUniqueVertices = uniqueInputIndices.size();
+
+	m_positions.reserve(numUniqueVertices * 3);
+	for(const uint32 inputIndex : uniqueInputIndices)
+	{
+		m_positions.push_back(static_cast<float32>(positions[inputIndex].x));
+		m_positions.push_back(static_cast<float32>(positions[inputIndex].y));
+		m_positions.push_back(static_cast<float32>(positions[inputIndex].z));
+	}
+
+	if(!m_isQuantized)
+	{
+		m_normals.reserve(numUniqueVertices * 3);
+		m_uvws.reserve(numUniqueVertices * 3);
+		for(const uint32 inputIndex : uniqueInputIndices)
+		{
+			for(int i = 0; i < 3; ++i)
+			{
+				m_normals.push_back(static_cast<float32>(normals[inputIndex][i]));
+				m_uvws.push_back(static_cast<float32>(uvws[inputIndex][i]));
+			}
+		}
+	}
+	else
+	{
+		Vector3R uvwMax(std::numeric_limits<real>::lowest());
+		m_uvwMin = Vector3R(std::numeric_limits<real>::max());
+		for(const uint32 inputIndex : uniqueInputIndices)
+		{
+			m_uvwMin = m_uvwMin.min(uvws[inputIndex]);
+			uvwMax   = uvwMax.max(uvws[inputIndex]);
+		}
+		m_uvwExtents = uvwMax.sub(m_uvwMin);
+
+		m_quantizedNormals.reserve(numUniqueVertices * 2);
+		m_quantizedUvws.reserve(numUniqueVertices * 3);
+		for(const uint32 inputIndex : uniqueInputIndices)
+		{
+			const Vector2R encodedNormal = octahedron_encode(normals[inputIndex]);
+			m_quantizedNormals.push_back(quantize_unorm16(encodedNormal.x * 0.5_r + 0.5_r));
+			m_quantizedNormals.push_back(quantize_unorm16(encodedNormal.y * 0.5_r + 0.5_r));
+
+			for(int i = 0; i < 3; ++i)
+			{
+				const real normalizedUvw = m_uvwExtents[i] > 0.0_r ?
+					(uvws[inputIndex][i] - m_uvwMin[i]) / m_uvwExtents[i] : 0.0_r;
+				m_quantizedUvws.push_back(quantize_unorm16(normalizedUvw));
+			}
+		}
+	}
+}
+
+void IndexedTriangleBuffer::getNormals(
+	const std::size_t triangleIndex,
+	Vector3R* const   out_nA,
+	Vector3R* const   out_nB,
+	Vector3R* const   out_nC) const
+{
+	PH_ASSERT_LT(triangleIndex, numTriangles());
+	PH_ASSERT(out_nA && out_nB && out_nC);
+
+	*out_nA = getNormal(m_indices[triangleIndex * 3 + 0]);
+	*out_nB = getNormal(m_indices[triangleIndex * 3 + 1]);
+	*out_nC = getNormal(m_indices[triangleIndex * 3 + 2]);
+}
+
+void IndexedTriangleBuffer::getUVWs(
+	const std::size_t triangleIndex,
+	Vector3R* const   out_uvwA,
+	Vector3R* const   out_uvwB,
+	Vector3R* const   out_uvwC) const
+{
+	PH_ASSERT_LT(triangleIndex, numTriangles());
+	PH_ASSERT(out_uvwA && out_uvwB && out_uvwC);
+
+	*out_uvwA = getUVW(m_indices[triangleIndex * 3 + 0]);
+	*out_uvwB = getUVW(m_indices[triangleIndex * 3 + 1]);
+	*out_uvwC = getUVW(m_indices[triangleIndex * 3 + 2]);
+}
+
+void IndexedTriangleBuffer::reorderTriangles(const std::vector<std::size_t>& triangleOrder)
+{
+	PH_ASSERT_EQ(triangleOrder.size(), numTriangles());
+
+	std::vector<uint32> reorderedIndices(m_indices.size());
+	for(std::size_t i = 0; i < triangleOrder.size(); ++i)
+	{
+		PH_ASSERT_LT(triangleOrder[i], numTriangles());
+
+		reorderedIndices[i * 3 + 0] = m_indices[triangleOrder[i] * 3 + 0];
+		reorderedIndices[i * 3 + 1] = m_indices[triangleOrder[i] * 3 + 1];
+		reorderedIndices[i * 3 + 2] = m_indices[triangleOrder[i] * 3 + 2];
+	}
+	m_indices = std::move(reorderedIndices);
+}
+
+std::size_t IndexedTriangleBuffer::memoryUsage() const
+{
+	return
+		m_positions.size()        * sizeof(float32) +
+		m_normals.size()          * sizeof(float32) +
+		m_uvws.size()             * sizeof(float32) +
+		m_quantizedNormals.size() * sizeof(uint16) +
+		m_quantizedUvws.size()    * sizeof(uint16) +
+		m_indices.size()          * sizeof(uint32);
+}
+
+Vector3R IndexedTriangleBuffer::getNormal(const uint32 vertexIndex) const
+{
+	if(!m_isQuantized)
+	{
+		const std::size_t offset = static_cast<std::size_t>(vertexIndex) * 3;
+		PH_ASSERT_LT(offset + 2, m_normals.size());
+
+		return Vector3R(
+			static_cast<real>(m_normals[offset + 0]),
+			static_cast<real>(m_normals[offset + 1]),
+			static_cast<real>(m_normals[offset + 2]));
+	}
+	else
+	{
+		const std::size_t offset = static_cast<std::size_t>(vertexIndex) * 2;
+		PH_ASSERT_LT(offset + 1, m_quantizedNormals.size());
+
+		return octahedron_decode(Vector2R(
+			dequantize_unorm16(m_quantizedNormals[offset + 0]) * 2.0_r - 1.0_r,
+			dequantize_unorm16(m_quantizedNormals[offset + 1]) * 2.0_r - 1.0_r));
+	}
+}
+
+Vector3R IndexedTriangleBuffer::getUVW(const uint32 vertexIndex) const
+{
+	const std::size_t offset = static_cast<std::size_t>(vertexIndex) * 3;
+	if(!m_isQuantized)
+	{
+		PH_ASSERT_LT(offset + 2, m_uvws.size());
+
+		return Vector3R(
+			static_cast<real>(m_uvws[offset + 0]),
+			static_cast<real>(m_uvws[offset + 1]),
+			static_cast<real>(m_uvws[offset + 2]));
+	}
+	else
+	{
+		PH_ASSERT_LT(offset + 2, m_quantizedUvws.size());
+
+		return Vector3R(
+			dequantize_unorm16(m_quantizedUvws[offset + 0]),
+			dequantize_unorm16(m_quantizedUvws[offset + 1]),
+			dequantize_unorm16(m_quantizedUvws[offset + 2])).mul(m_uvwExtents).add(m_uvwMin);
+	}
+}
+
+}// end namespace ph
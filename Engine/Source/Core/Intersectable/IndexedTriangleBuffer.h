@@ -0,0 +1,106 @@
+#pragma once
+
+#include "Common/primitive_type.h"
+#include "Common/assertion.h"
+#include "Math/TVector3.h"
+
+#include <vector>
+#include <cstddef>
+
+namespace ph
+{
+
+/*
+	Vertex and index storage of a triangle mesh. Vertices shared by multiple
+	triangles are stored only once. Normals and texture coordinates can
+	optionally be quantized to 16-bit integers: normals are octahedral encoded,
+	and texture coordinates are stored relative to the bounds of all texture
+	coordinates in the mesh.
+*/
+class IndexedTriangleBuffer final
+{
+public:
+	IndexedTriangleBuffer();
+
+	// Every three consecutive elements in the input arrays form a triangle.
+	// Normals are expected to be normalized.
+	IndexedTriangleBuffer(
+		const std::vector<Vector3R>& positions,
+		const std::vector<Vector3R>& normals,
+		const std::vector<Vector3R>& uvws,
+		bool                         isQuantized);
+
+	void getPositions(std::size_t triangleIndex, Vector3R* out_vA, Vector3R* out_vB, Vector3R* out_vC) const;
+	void getNormals(std::size_t triangleIndex, Vector3R* out_nA, Vector3R* out_nB, Vector3R* out_nC) const;
+	void getUVWs(std::size_t triangleIndex, Vector3R* out_uvwA, Vector3R* out_uvwB, Vector3R* out_uvwC) const;
+
+	// Reorders triangles such that the i-th triangle becomes the one
+	// previously at <triangleOrder>[i]. Vertices are unaffected.
+	void reorderTriangles(const std::vector<std::size_t>& triangleOrder);
+
+	std::size_t numTriangles() const;
+	std::size_t numVertices() const;
+	bool isQuantized() const;
+
+	// Number of bytes used by the vertex and index buffers.
+	std::size_t memoryUsage() const;
+
+private:
+	std::vector<float32> m_positions;
+	std::vector<float32> m_normals;
+	std::vector<float32> m_uvws;
+	std::vector<uint16>  m_quantizedNormals;
+	std::vector<uint16>  m_quantizedUvws;
+	std::vector<uint32>  m_indices;
+	Vector3R             m_uvwMin;
+	Vector3R             m_uvwExtents;
+	bool                 m_isQuantized;
+
+	Vector3R getPosition(uint32 vertexIndex) const;
+	Vector3R getNormal(uint32 vertexIndex) const;
+	Vector3R getUVW(uint32 vertexIndex) const;
+};
+
+// In-header Implementations:
+
+inline void IndexedTriangleBuffer::getPositions(
+	const std::size_t triangleIndex,
+	Vector3R* const   out_vA,
+	Vector3R* const   out_vB,
+	Vector3R* const   out_vC) const
+{
+	PH_ASSERT_LT(triangleIndex, numTriangles());
+	PH_ASSERT(out_vA && out_vB && out_vC);
+
+	*out_vA = getPosition(m_indices[triangleIndex * 3 + 0]);
+	*out_vB = getPosition(m_indices[triangleIndex * 3 + 1]);
+	*out_vC = getPosition(m_indices[triangleIndex * 3 + 2]);
+}
+
+inline std::size_t IndexedTriangleBuffer::numTriangles() const
+{
+	return m_indices.size() / 3;
+}
+
+inline std::size_t IndexedTriangleBuffer::numVertices() const
+{
+	return m_positions.size() / 3;
+}
+
+inline bool IndexedTriangleBuffer::isQuantized() const
+{
+	return m_isQuantized;
+}
+
+inline Vector3R IndexedTriangleBuffer::getPosition(const uint32 vertexIndex) const
+{
+	const std::size_t offset = static_cast<std::size_t>(vertexIndex) * 3;
+	PH_ASSERT_LT(offset + 2, m_positions.size());
+
+	return Vector3R(
+		static_cast<real>(m_positions[offset + 0]),
+		static_cast<real>(m_positions[offset + 1]),
+		static_cast<real>(m_positions[offset + 2]));
+}
+
+}// end namespace ph
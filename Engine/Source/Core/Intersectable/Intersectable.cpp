@@ -7,7 +7,7 @@ namespace ph
 
 Intersectable::~Intersectable() = default;
 
-bool Intersectable::isIntersecting(const Ray& ray) const
+bool Intersectable::isOccluded(const Ray& ray) const
 {
 	HitProbe dummyProbe;
 	return isIntersecting(ray, dummyProbe);
@@ -56,11 +56,14 @@ public:
 
 	/*! @brief Determines whether this object blocks the ray.
 
-	If greater performance is desired, you can override the default
+	Unlike isIntersecting(const Ray&, HitProbe&) const, any hit within the ray
+	segment suffices and no hit information is recorded, so implementations
+	are free to stop at the first hit they find (this is what shadow rays
+	need). If greater performance is desired, you can override the default
 	implementation which simply calls isIntersecting(const Ray&, HitProbe&)
 	const to do the job.
 	*/
-	virtual bool isIntersecting(const Ray& ray) const;
+	virtual bool isOccluded(const Ray& ray) const;
 
 	/*! @brief Conservatively checks whether this object overlaps a volume.
 
@@ -21,10 +21,10 @@ public:
 	virtual void update(const CookedDataStorage& cookedActors) = 0;
 	
 	bool isIntersecting(const Ray& ray, HitProbe& probe) const override = 0;
+	bool isOccluded(const Ray& ray) const override = 0;
 
 	void calcAABB(AABB3D* out_aabb) const override = 0;
 	
-	using Intersectable::isIntersecting;
 	void calcIntersectionDetail(const Ray& ray, HitProbe& probe,
 	                            HitDetail* out_detail) const override;
 };
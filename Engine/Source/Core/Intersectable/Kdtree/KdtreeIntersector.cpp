@@ -42,6 +42,11 @@ bool KdtreeIntersector::isIntersecting(const Ray& ray, HitProbe& probe) const
 	return m_rootKdtreeNode.findClosestIntersection(ray, probe);
 }
 
+bool KdtreeIntersector::isOccluded(const Ray& ray) const
+{
+	return m_rootKdtreeNode.isOccluded(ray);
+}
+
 void KdtreeIntersector::calcAABB(AABB3D* const out_aabb) const
 {
 	PH_ASSERT(out_aabb);
@@ -94,6 +94,20 @@ bool KdtreeNode::findClosestIntersection(const Ray& ray, HitProbe& probe) const
 	return traverseAndFindClosestIntersection(ray, probe, rayNearHitDist, rayFarHitDist);
 }
 
+bool KdtreeNode::isOccluded(const Ray& ray) const
+{
+	real rayNearHitDist;
+	real rayFarHitDist;
+
+	if(!m_aabb.isIntersectingVolume(ray, &rayNearHitDist, &rayFarHitDist))
+	{
+		// ray missed root node's aabb
+		return false;
+	}
+
+	return traverseAndFindAnyIntersection(ray, rayNearHitDist, rayFarHitDist);
+}
+
 void KdtreeNode::analyzeSplitCostSAH(const std::vector<const Intersectable*>& intersectables,
                                      const int32 axis, 
                                      float64* const out_minCost, 
@@ -382,6 +396,67 @@ bool KdtreeNode::traverseAndFindClosestIntersection(const Ray& ray,
 	return false;
 }
 
+bool KdtreeNode::traverseAndFindAnyIntersection(const Ray& ray, 
+                                                const real rayDistMin, 
+                                                const real rayDistMax) const
+{
+	if(!isLeaf())
+	{
+		const real splitAxisRayOrigin = ray.getOrigin()[m_splitAxis];
+		const real splitAxisRayDir    = ray.getDirection()[m_splitAxis];
+
+		KdtreeNode* nearHitNode;
+		KdtreeNode* farHitNode;
+
+		if(m_splitPos > splitAxisRayOrigin)
+		{
+			nearHitNode = m_negativeChild.get();
+			farHitNode = m_positiveChild.get();
+		}
+		else
+		{
+			nearHitNode = m_positiveChild.get();
+			farHitNode = m_negativeChild.get();
+		}
+
+		// NaN is handled by Case III, see traverseAndFindClosestIntersection()
+		real raySplitPlaneDist = (m_splitPos - splitAxisRayOrigin) / splitAxisRayDir;
+
+		// Case I: Split plane is beyond ray's range or behind ray origin, only near node is hit.
+		if(raySplitPlaneDist >= rayDistMax || raySplitPlaneDist < 0.0_r)
+		{
+			return nearHitNode != nullptr && 
+			       nearHitNode->traverseAndFindAnyIntersection(ray, rayDistMin, rayDistMax);
+		}
+		// Case II: Split plane is between ray origin and near intersection point, only far node is hit.
+		else if(raySplitPlaneDist <= rayDistMin && raySplitPlaneDist > 0.0_r)
+		{
+			return farHitNode != nullptr && 
+			       farHitNode->traverseAndFindAnyIntersection(ray, rayDistMin, rayDistMax);
+		}
+		// Case III: Split plane is within ray's range, and both near and far node are hit.
+		else
+		{
+			return (nearHitNode != nullptr && nearHitNode->traverseAndFindAnyIntersection(ray, rayDistMin, raySplitPlaneDist)) ||
+			       (farHitNode  != nullptr && farHitNode->traverseAndFindAnyIntersection(ray, raySplitPlaneDist, rayDistMax));
+		}
+	}
+	else
+	{
+		// Intersectables can span multiple nodes; testing them against the 
+		// original ray is fine as any hit within it blocks the ray.
+		for(std::size_t isableIndex = m_nodeBufferStartIndex; isableIndex < m_nodeBufferEndIndex; isableIndex++)
+		{
+			if((*m_intersectableBuffer)[isableIndex]->isOccluded(ray))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+}
+
 bool KdtreeNode::isLeaf() const
 {
 	return m_nodeBufferStartIndex != m_nodeBufferEndIndex;
@@ -19,6 +19,7 @@ public:
 
 	void buildTree(const std::vector<const Intersectable*>& intersectables);
 	bool findClosestIntersection(const Ray& ray, HitProbe& probe) const;
+	bool isOccluded(const Ray& ray) const;
 	KdtreeAABB getAABB() const;
 
 private:
@@ -38,6 +39,8 @@ private:
 	                                           const std::vector<const Intersectable*>& parentIntersectables);
 	bool traverseAndFindClosestIntersection(const Ray& ray, HitProbe& probe,
 	                                        real rayDistMin, real rayDistMax) const;
+	bool traverseAndFindAnyIntersection(const Ray& ray, 
+	                                    real rayDistMin, real rayDistMax) const;
 	void analyzeSplitCostSAH(const std::vector<const Intersectable*>& intersectables, int32 axis,
 	                         float64* out_minCost, real* out_splitPoint) const;
 	bool isLeaf() const;
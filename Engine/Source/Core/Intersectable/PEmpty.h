@@ -13,7 +13,7 @@ public:
 	explicit PEmpty(const PrimitiveMetadata* metadata);
 
 	bool isIntersecting(const Ray& ray, HitProbe& probe) const override;
-	bool isIntersecting(const Ray& ray) const override;
+	bool isOccluded(const Ray& ray) const override;
 
 	void calcIntersectionDetail(
 		const Ray& ray, 
@@ -35,7 +35,7 @@ inline bool PEmpty::isIntersecting(const Ray& ray, HitProbe& probe) const
 	return false;
 }
 
-inline bool PEmpty::isIntersecting(const Ray& ray) const
+inline bool PEmpty::isOccluded(const Ray& ray) const
 {
 	return false;
 }
@@ -36,7 +36,7 @@ bool PInfiniteSphere::isIntersecting(const Ray& ray, HitProbe& probe) const
 	return false;
 }
 
-bool PInfiniteSphere::isIntersecting(const Ray& ray) const
+bool PInfiniteSphere::isOccluded(const Ray& ray) const
 {
 	return ray.getMaxT() >= std::numeric_limits<real>::max();
 }
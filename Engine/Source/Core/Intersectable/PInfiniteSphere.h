@@ -17,7 +17,7 @@ public:
 		const PrimitiveMetadata* metadata);
 
 	bool isIntersecting(const Ray& ray, HitProbe& probe) const override;
-	bool isIntersecting(const Ray& ray) const override;
+	bool isOccluded(const Ray& ray) const override;
 
 	void calcIntersectionDetail(
 		const Ray& ray, 
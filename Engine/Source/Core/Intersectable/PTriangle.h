@@ -15,6 +15,7 @@ public:
 	PTriangle(const PrimitiveMetadata* metadata, const Vector3R& vA, const Vector3R& vB, const Vector3R& vC);
 
 	bool isIntersecting(const Ray& ray, HitProbe& probe) const override;
+	bool isOccluded(const Ray& ray) const override;
 	void calcIntersectionDetail(const Ray& ray, HitProbe& probe,
 	                            HitDetail* out_detail) const override;
 	bool isIntersectingVolumeConservative(const AABB3D& volume) const override;
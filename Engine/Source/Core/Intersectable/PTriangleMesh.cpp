@@ -0,0 +1,288 @@
+#include "Core/Intersectable/PTriangleMesh.h"
+#include "Core/Intersectable/triangle_intersection.h"
+#include "Core/Ray.h"
+#include "Core/HitProbe.h"
+#include "Core/HitDetail.h"
+#include "Core/Sample/PositionSample.h"
+#include "Math/Random.h"
+#include "Math/TVector2.h"
+#include "Common/assertion.h"
+
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#define TRIANGLE_EPSILON 0.0001f
+
+namespace ph
+{
+
+namespace
+{
+
+inline Vector3R calc_face_normal(const Vector3R& eAB, const Vector3R& eAC)
+{
+	// Vertices may form a degenerate triangle, in such case an arbitrary
+	// vector is chosen (same as PTriangle).
+	const Vector3R crossed = eAB.cross(eAC);
+	return crossed.lengthSquared() > 0.0_r ? crossed.normalize() : Vector3R(0, 1, 0);
+}
+
+}// end anonymous namespace
+
+PTriangleMesh::PTriangleMesh(const PrimitiveMetadata* const metadata, IndexedTriangleBuffer triangles) :
+	PTriangleMesh(metadata, std::move(triangles), 4, EBvhType::SAH_BUCKET)
+{}
+
+PTriangleMesh::PTriangleMesh(
+	const PrimitiveMetadata* const metadata,
+	IndexedTriangleBuffer          triangles,
+	const std::size_t              bvhWidth,
+	const EBvhType                 bvhType) :
+
+	Primitive(metadata),
+
+	m_triangles(std::move(triangles)),
+	m_bvh4(),
+	m_bvh8(),
+	m_aabb(),
+	m_areaDistribution(),
+	m_area(0.0_r)
+{
+	PH_ASSERT_GT(m_triangles.numTriangles(), 0);
+	PH_ASSERT_LE(m_triangles.numTriangles() - 1, std::numeric_limits<uint32>::max());
+
+	std::vector<AABB3D> triangleAABBs(m_triangles.numTriangles());
+	for(std::size_t i = 0; i < m_triangles.numTriangles(); ++i)
+	{
+		calcTriangleAABB(i, &triangleAABBs[i]);
+		if(i == 0)
+		{
+			m_aabb = triangleAABBs[i];
+		}
+		else
+		{
+			m_aabb.unionWith(triangleAABBs[i]);
+		}
+	}
+
+	// triangles are rearranged into leaf order, so BVH leaves index them
+	// directly
+	std::vector<std::size_t> triangleOrder;
+	if(bvhWidth == 8)
+	{
+		m_bvh8.build(triangleAABBs, bvhType, &triangleOrder);
+	}
+	else
+	{
+		PH_ASSERT_EQ(bvhWidth, 4);
+
+		m_bvh4.build(triangleAABBs, bvhType, &triangleOrder);
+	}
+	m_triangles.reorderTriangles(triangleOrder);
+
+	std::vector<real> triangleAreas(m_triangles.numTriangles());
+	for(std::size_t i = 0; i < m_triangles.numTriangles(); ++i)
+	{
+		Vector3R vA, vB, vC;
+		m_triangles.getPositions(i, &vA, &vB, &vC);
+		triangleAreas[i] = vB.sub(vA).cross(vC.sub(vA)).length() * 0.5_r;
+		m_area += triangleAreas[i];
+	}
+	m_areaDistribution = TPwcDistribution1D<real>(triangleAreas);
+}
+
+bool PTriangleMesh::isIntersecting(const Ray& ray, HitProbe& probe) const
+{
+	const auto isIntersectingItem = [this](const std::size_t triangleIndex, const Ray& bvhRay, HitProbe& triangleProbe)
+	{
+		return isIntersectingTriangle(triangleIndex, bvhRay, triangleProbe);
+	};
+
+	return !m_bvh8.isEmpty() ? 
+		m_bvh8.isIntersecting(ray, probe, isIntersectingItem) : 
+		m_bvh4.isIntersecting(ray, probe, isIntersectingItem);
+}
+
+bool PTriangleMesh::isOccluded(const Ray& ray) const
+{
+	const auto isOccludedByItem = [this](const std::size_t triangleIndex, const Ray& bvhRay)
+	{
+		return isOccludedByTriangle(triangleIndex, bvhRay);
+	};
+
+	return !m_bvh8.isEmpty() ? 
+		m_bvh8.isOccluded(ray, isOccludedByItem) : 
+		m_bvh4.isOccluded(ray, isOccludedByItem);
+}
+
+inline bool PTriangleMesh::isIntersectingTriangle(
+	const std::size_t triangleIndex,
+	const Ray&        ray,
+	HitProbe&         probe) const
+{
+	Vector3R vA, vB, vC;
+	m_triangles.getPositions(triangleIndex, &vA, &vB, &vC);
+
+	real     hitTscaled;
+	Vector3R funcEabc;
+	real     determinant;
+	if(!triangle::find_watertight_hit(ray, vA, vB, vC, &hitTscaled, &funcEabc, &determinant))
+	{
+		return false;
+	}
+
+	PH_ASSERT_MSG(determinant != 0 && std::isfinite(determinant), std::to_string(determinant));
+
+	const real reciDeterminant = 1.0_r / determinant;
+
+	TriangleHit hit;
+	hit.triangleIndex = static_cast<uint32>(triangleIndex);
+	hit.baryB         = static_cast<float32>(funcEabc.y * reciDeterminant);
+	hit.baryC         = static_cast<float32>(funcEabc.z * reciDeterminant);
+
+	probe.pushBaseHit(this, hitTscaled * reciDeterminant);
+	probe.cache(hit);
+
+	return true;
+}
+
+inline bool PTriangleMesh::isOccludedByTriangle(const std::size_t triangleIndex, const Ray& ray) const
+{
+	Vector3R vA, vB, vC;
+	m_triangles.getPositions(triangleIndex, &vA, &vB, &vC);
+
+	real     hitTscaled;
+	Vector3R funcEabc;
+	real     determinant;
+	return triangle::find_watertight_hit(ray, vA, vB, vC, &hitTscaled, &funcEabc, &determinant);
+}
+
+inline void PTriangleMesh::calcTriangleAABB(const std::size_t triangleIndex, AABB3D* const out_aabb) const
+{
+	PH_ASSERT(out_aabb);
+
+	Vector3R vA, vB, vC;
+	m_triangles.getPositions(triangleIndex, &vA, &vB, &vC);
+
+	*out_aabb = AABB3D(vA.min(vB).min(vC), vA.max(vB).max(vC));
+	out_aabb->expand(Vector3R(TRIANGLE_EPSILON));
+}
+
+void PTriangleMesh::calcIntersectionDetail(const Ray& ray, HitProbe& probe,
+                                           HitDetail* const out_detail) const
+{
+	TriangleHit hit;
+	probe.getCached(&hit);
+
+	const Vector3R hitBaryABC(
+		1.0_r - static_cast<real>(hit.baryB) - static_cast<real>(hit.baryC),
+		static_cast<real>(hit.baryB),
+		static_cast<real>(hit.baryC));
+
+	Vector3R vA, vB, vC;
+	Vector3R nA, nB, nC;
+	Vector3R uvwA, uvwB, uvwC;
+	m_triangles.getPositions(hit.triangleIndex, &vA, &vB, &vC);
+	m_triangles.getNormals(hit.triangleIndex, &nA, &nB, &nC);
+	m_triangles.getUVWs(hit.triangleIndex, &uvwA, &uvwB, &uvwC);
+
+	const Vector3R eAB = vB.sub(vA);
+	const Vector3R eAC = vC.sub(vA);
+
+	const Vector3R& hitPosition = ray.getOrigin().add(ray.getDirection().mul(probe.getHitRayT()));
+	const Vector3R hitShadingNormal = Vector3R::weightedSum(
+		nA, hitBaryABC.x,
+		nB, hitBaryABC.y,
+		nC, hitBaryABC.z).normalizeLocal();
+
+	PH_ASSERT_MSG(hitPosition.isFinite() && hitShadingNormal.isFinite(), "\n"
+		"hit-position       = " + hitPosition.toString() + "\n"
+		"hit-shading-normal = " + hitShadingNormal.toString() + "\n");
+
+	const Vector3R& hitUVW = Vector3R::weightedSum(
+		uvwA, hitBaryABC.x,
+		uvwB, hitBaryABC.y,
+		uvwC, hitBaryABC.z);
+
+	out_detail->getHitInfo(ECoordSys::LOCAL).setAttributes(
+		hitPosition,
+		calc_face_normal(eAB, eAC),
+		hitShadingNormal);
+
+	Vector3R dPdU(0.0_r), dPdV(0.0_r);
+	Vector3R dNdU(0.0_r), dNdV(0.0_r);
+	const Vector2R dUVab(uvwB.x - uvwA.x, uvwB.y - uvwA.y);
+	const Vector2R dUVac(uvwC.x - uvwA.x, uvwC.y - uvwA.y);
+	const real uvDet = dUVab.x * dUVac.y - dUVab.y * dUVac.x;
+	if(uvDet != 0.0_r)
+	{
+		const real reciUvDet = 1.0_r / uvDet;
+
+		dPdU = eAB.mul(dUVac.y).add(eAC.mul(-dUVab.y)).mulLocal(reciUvDet);
+		dPdV = eAB.mul(-dUVac.x).add(eAC.mul(dUVab.x)).mulLocal(reciUvDet);
+
+		const Vector3R& dNab = nB.sub(nA);
+		const Vector3R& dNac = nC.sub(nA);
+		dNdU = dNab.mul(dUVac.y).add(dNac.mul(-dUVab.y)).mulLocal(reciUvDet);
+		dNdV = dNab.mul(-dUVac.x).add(dNac.mul(dUVab.x)).mulLocal(reciUvDet);
+	}
+
+	out_detail->getHitInfo(ECoordSys::LOCAL).setDerivatives(
+		dPdU, dPdV, dNdU, dNdV);
+
+	out_detail->getHitInfo(ECoordSys::WORLD) = out_detail->getHitInfo(ECoordSys::LOCAL);
+	out_detail->setMisc(this, hitUVW, probe.getHitRayT());
+}
+
+bool PTriangleMesh::isIntersectingVolumeConservative(const AABB3D& volume) const
+{
+	return m_aabb.isIntersectingVolume(volume);
+}
+
+void PTriangleMesh::calcAABB(AABB3D* const out_aabb) const
+{
+	PH_ASSERT(out_aabb);
+
+	*out_aabb = m_aabb;
+}
+
+real PTriangleMesh::calcPositionSamplePdfA(const Vector3R& /* position */) const
+{
+	// triangles are picked according to their areas, so the PDF is uniform
+	// over the whole mesh
+	return 1.0_r / m_area;
+}
+
+void PTriangleMesh::genPositionSample(PositionSample* const out_sample) const
+{
+	PH_ASSERT(out_sample);
+
+	const std::size_t triangleIndex = m_areaDistribution.sampleDiscrete(Random::genUniformReal_i0_e1());
+
+	const real A = std::sqrt(Random::genUniformReal_i0_e1());
+	const real B = Random::genUniformReal_i0_e1();
+	const Vector3R abc(1.0_r - A, A * (1.0_r - B), B * A);
+
+	Vector3R vA, vB, vC;
+	Vector3R nA, nB, nC;
+	Vector3R uvwA, uvwB, uvwC;
+	m_triangles.getPositions(triangleIndex, &vA, &vB, &vC);
+	m_triangles.getNormals(triangleIndex, &nA, &nB, &nC);
+	m_triangles.getUVWs(triangleIndex, &uvwA, &uvwB, &uvwC);
+
+	out_sample->position = Vector3R::weightedSum(vA, abc.x, vB, abc.y, vC, abc.z);
+	out_sample->uvw      = Vector3R::weightedSum(uvwA, abc.x, uvwB, abc.y, uvwC, abc.z);
+	out_sample->normal   = Vector3R::weightedSum(nA, abc.x, nB, abc.y, nC, abc.z).normalizeLocal();
+	out_sample->pdf      = this->PTriangleMesh::calcPositionSamplePdfA(out_sample->position);
+
+	PH_ASSERT(out_sample->normal.isFinite() && out_sample->normal.length() > 0.9_r);
+}
+
+real PTriangleMesh::calcExtendedArea() const
+{
+	return m_area;
+}
+
+}// end namespace ph
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "Core/Intersectable/Primitive.h"
+#include "Core/Intersectable/IndexedTriangleBuffer.h"
+#include "Core/Intersectable/Bvh/TWideBvh.h"
+#include "Core/Intersectable/Bvh/EBvhType.h"
+#include "Math/Random/TPwcDistribution1D.h"
+#include "Common/primitive_type.h"
+
+#include <cstddef>
+
+namespace ph
+{
+
+/*
+	A triangle mesh stored as a single primitive. Triangles share one vertex
+	and index buffer and are indexed by a mesh-level wide BVH, so testing
+	them against rays involves no virtual calls. Triangles are stored in the
+	order of BVH leaves, which makes the index buffer the only per-triangle
+	storage besides BVH nodes.
+*/
+class PTriangleMesh final : public Primitive
+{
+public:
+	PTriangleMesh(const PrimitiveMetadata* metadata, IndexedTriangleBuffer triangles);
+
+	// <bvhWidth> is the number of children per BVH node, either 4 or 8.
+	PTriangleMesh(
+		const PrimitiveMetadata* metadata, 
+		IndexedTriangleBuffer    triangles, 
+		std::size_t              bvhWidth, 
+		EBvhType                 bvhType);
+
+	PTriangleMesh(const PTriangleMesh& other) = delete;
+
+	bool isIntersecting(const Ray& ray, HitProbe& probe) const override;
+	bool isOccluded(const Ray& ray) const override;
+	void calcIntersectionDetail(const Ray& ray, HitProbe& probe,
+	                            HitDetail* out_detail) const override;
+	bool isIntersectingVolumeConservative(const AABB3D& volume) const override;
+	void calcAABB(AABB3D* out_aabb) const override;
+	real calcPositionSamplePdfA(const Vector3R& position) const override;
+	void genPositionSample(PositionSample* out_sample) const override;
+
+	real calcExtendedArea() const override;
+
+	std::size_t numTriangles() const;
+	const IndexedTriangleBuffer& getTriangles() const;
+
+	PTriangleMesh& operator = (const PTriangleMesh& rhs) = delete;
+
+private:
+	/*
+		Data cached in hit probe after a triangle is hit. Barycentric
+		coordinate of vertex A is implied by the other two.
+	*/
+	struct TriangleHit
+	{
+		uint32  triangleIndex;
+		float32 baryB;
+		float32 baryC;
+	};
+
+	// only one of the BVHs is built, depending on the width requested
+	IndexedTriangleBuffer    m_triangles;
+	TWideBvh<4>              m_bvh4;
+	TWideBvh<8>              m_bvh8;
+	AABB3D                   m_aabb;
+	TPwcDistribution1D<real> m_areaDistribution;
+	real                     m_area;
+
+	bool isIntersectingTriangle(std::size_t triangleIndex, const Ray& ray, HitProbe& probe) const;
+	bool isOccludedByTriangle(std::size_t triangleIndex, const Ray& ray) const;
+	void calcTriangleAABB(std::size_t triangleIndex, AABB3D* out_aabb) const;
+};
+
+// In-header Implementations:
+
+inline std::size_t PTriangleMesh::numTriangles() const
+{
+	return m_triangles.numTriangles();
+}
+
+inline const IndexedTriangleBuffer& PTriangleMesh::getTriangles() const
+{
+	return m_triangles;
+}
+
+}// end namespace ph
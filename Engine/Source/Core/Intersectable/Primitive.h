@@ -19,7 +19,6 @@ class Primitive : public Intersectable
 public:
 	explicit Primitive(const PrimitiveMetadata* metadata);
 
-	using Intersectable::isIntersecting;
 	bool isIntersecting(const Ray& ray, HitProbe& probe) const override = 0;
 	void calcIntersectionDetail(const Ray& ray, HitProbe& probe,
 	                            HitDetail* out_detail) const override = 0;
@@ -28,11 +28,11 @@ SuperpositionedPrimitive::SuperpositionedPrimitive(
 	m_mainPrimitive = primitives[mainPrimitiveIndex];
 }
 
-bool SuperpositionedPrimitive::isIntersecting(const Ray& ray) const
+bool SuperpositionedPrimitive::isOccluded(const Ray& ray) const
 {
 	PH_ASSERT(m_mainPrimitive != nullptr);
 
-	return m_mainPrimitive->isIntersecting(ray);
+	return m_mainPrimitive->isOccluded(ray);
 }
 
 bool SuperpositionedPrimitive::isIntersecting(const Ray& ray, HitProbe& probe) const
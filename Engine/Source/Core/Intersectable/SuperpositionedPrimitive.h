@@ -31,7 +31,7 @@ public:
 	                         const std::vector<const Primitive*>& primitives, 
 	                         std::size_t                          mainPrimitiveIndex);
 
-	bool isIntersecting(const Ray& ray) const override;
+	bool isOccluded(const Ray& ray) const override;
 	bool isIntersecting(const Ray& ray, HitProbe& probe) const override;
 	bool isIntersectingVolumeConservative(const AABB3D& aabb) const override;
 
@@ -28,11 +28,11 @@ TransformedIntersectable::TransformedIntersectable(const TransformedIntersectabl
 
 // FIXME: intersecting routines' time correctness
 
-bool TransformedIntersectable::isIntersecting(const Ray& ray) const
+bool TransformedIntersectable::isOccluded(const Ray& ray) const
 {
 	Ray localRay;
 	m_worldToLocal->transform(ray, &localRay);
-	return m_intersectable->isIntersecting(localRay);
+	return m_intersectable->isOccluded(localRay);
 }
 
 bool TransformedIntersectable::isIntersecting(const Ray& ray, HitProbe& probe) const
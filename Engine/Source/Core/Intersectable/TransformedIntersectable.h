@@ -16,7 +16,7 @@ public:
 	                         const Transform*     worldToLocal);
 	TransformedIntersectable(const TransformedIntersectable& other);
 
-	bool isIntersecting(const Ray& ray) const override;
+	bool isOccluded(const Ray& ray) const override;
 	bool isIntersecting(const Ray& ray, HitProbe& probe) const override;
 	void calcIntersectionDetail(const Ray& ray, HitProbe& probe,
 	                                    HitDetail* out_detail) const override;
@@ -25,9 +25,9 @@ public:
 		const RigidTransform* localToWorld,
 		const RigidTransform* worldToLocal);
 
-	inline bool isIntersecting(const Ray& ray) const override
+	inline bool isOccluded(const Ray& ray) const override
 	{
-		return m_intersectable.isIntersecting(ray);
+		return m_intersectable.isOccluded(ray);
 	}
 
 	inline bool isIntersecting(const Ray& ray, HitProbe& probe) const override
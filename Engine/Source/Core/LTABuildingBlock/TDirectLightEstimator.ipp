@@ -10,17 +10,12 @@
 #include "Core/SurfaceBehavior/BsdfEvaluation.h"
 #include "Core/SurfaceBehavior/BsdfPdfQuery.h"
 #include "Core/SurfaceBehavior/BsdfSample.h"
+#include "Core/LTABuildingBlock/lta.h"
 #include "Common/assertion.h"
 
 namespace ph
 {
 
-namespace
-{
-	// FIXME: hardcoded number
-	constexpr real DL_RAY_DELTA_DIST = 0.0001_r;
-}
-
 template<ESaPolicy POLICY>
 inline TDirectLightEstimator<POLICY>::TDirectLightEstimator(const Scene* const scene) : 
 	m_scene(scene)
@@ -52,11 +47,11 @@ inline bool TDirectLightEstimator<POLICY>::sample(
 
 		// sidedness agreement between real geometry and shading normal
 		//
-		if(toLightVec.lengthSquared() > DL_RAY_DELTA_DIST * DL_RAY_DELTA_DIST * 3 &&
+		if(toLightVec.lengthSquared() > lta::RAY_DELTA_DIST * lta::RAY_DELTA_DIST * 3 &&
 		   SidednessAgreement(POLICY).isSidednessAgreed(targetPos, toLightVec))
 		{
-			const Ray visRay(targetPos.getPosition(), toLightVec.normalize(), DL_RAY_DELTA_DIST, toLightVec.length() - DL_RAY_DELTA_DIST * 2, time);
-			if(!m_scene->isIntersecting(visRay))
+			const Ray visRay(targetPos.getPosition(), toLightVec.normalize(), lta::RAY_DELTA_DIST, toLightVec.length() - lta::RAY_DELTA_DIST * 2, time);
+			if(!m_scene->isOccluded(visRay))
 			{
 				PH_ASSERT(out_L && out_pdfW && out_emittedRadiance);
 
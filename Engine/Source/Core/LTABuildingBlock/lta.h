@@ -12,6 +12,13 @@ namespace ph
 namespace lta
 {
 
+/*
+	Distance to offset rays leaving a surface by, so they do not hit the 
+	surface they started from. Visibility rays also stop this short of their
+	target.
+*/
+constexpr real RAY_DELTA_DIST = 0.0001_r;
+
 /*
 	Using shading normal for light transport algorithms is equivalent to using
 	asymmetric BSDFs. This can lead to inconsistent results between regular 
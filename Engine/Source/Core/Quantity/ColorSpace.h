@@ -7,6 +7,7 @@
 
 #include <cmath>
 #include <cstddef>
+#include <array>
 #include <type_traits>
 
 namespace ph
@@ -138,6 +139,25 @@ public:
 	template<ESourceHint HINT = ESourceHint::RAW_DATA>
 	static inline void sRGB_to_SPD(const Vector3R& color, SampledSpectralStrength* out_spd);
 
+	// Counterparts of SPD_to_linear_sRGB() and linear_sRGB_to_SPD() for SPDs
+	// that are only known at some samples of SampledSpectralStrength, as
+	// specified by <sampleIndices>. Tristimulus values are Monte Carlo 
+	// estimates, which are unbiased if each index is uniformly distributed.
+	// Estimates of reflectances are not clamped to [0, 1] as a single 
+	// estimate may exceed it even for a valid reflectance; clamp them after
+	// accumulation instead.
+	//
+	template<ESourceHint HINT = ESourceHint::RAW_DATA, std::size_t N>
+	static inline Vector3R SPD_samples_to_linear_sRGB(
+		const std::array<std::size_t, N>& sampleIndices, 
+		const TArithmeticArray<real, N>&  values);
+
+	template<ESourceHint HINT = ESourceHint::RAW_DATA, std::size_t N>
+	static inline void linear_sRGB_to_SPD_samples(
+		const Vector3R&                   color, 
+		const std::array<std::size_t, N>& sampleIndices, 
+		TArithmeticArray<real, N>*        out_values);
+
 	static inline const SampledSpectralStrength& get_D65_SPD()
 	{
 		PH_ASSERT(isInitialized());
@@ -153,6 +173,14 @@ public:
 	}
 
 private:
+	// Decomposes a linear sRGB color into a weighted sum of Smits' white 
+	// SPD and two other basis SPDs.
+	//
+	static inline void decompose_linear_sRGB_Smits(
+		const Vector3R&                                 color, 
+		std::array<const SampledSpectralStrength*, 3>* out_bases, 
+		Vector3R*                                       out_weights);
+
 #ifdef PH_DEBUG
 	static inline bool isInitialized(const bool toggle = false)
 	{
@@ -135,12 +135,112 @@ inline void ColorSpace::linear_sRGB_to_SPD(
 	PH_ASSERT(isInitialized());
 	PH_ASSERT(out_spd != nullptr);
 
+	std::array<const SampledSpectralStrength*, 3> bases;
+	Vector3R                                      weights;
+	decompose_linear_sRGB_Smits(color, &bases, &weights);
+
+	out_spd->setValues(0);
+	out_spd->addLocal(*bases[0] * weights.x);
+	out_spd->addLocal(*bases[1] * weights.y);
+	out_spd->addLocal(*bases[2] * weights.z);
+
+	// For illuminants, scale its SPD so that constant SPDs matches D65.
+	//
+	if constexpr(HINT == ESourceHint::ILLUMINANT)
+	{
+		out_spd->mulLocal(SPD_D65);
+	}
+
+	// For reflectances, make sure energy conservation requirements are met.
+	//
+	if constexpr(HINT == ESourceHint::REFLECTANCE)
+	{
+		out_spd->clampLocal(0.0_r, 1.0_r);
+	}
+}
+
+template<ESourceHint HINT, std::size_t N>
+inline Vector3R ColorSpace::SPD_samples_to_linear_sRGB(
+	const std::array<std::size_t, N>& sampleIndices,
+	const TArithmeticArray<real, N>&  values)
+{
+	PH_ASSERT(isInitialized());
+
+	// each sample stands for 1/N of all intervals
+	const real sampleWeight = static_cast<real>(SampledSpectralStrength::NUM_VALUES) / static_cast<real>(N);
+
+	Vector3R xyz(0);
+	for(std::size_t i = 0; i < N; ++i)
+	{
+		const std::size_t sampleIndex = sampleIndices[i];
+		PH_ASSERT_LT(sampleIndex, SampledSpectralStrength::NUM_VALUES);
+
+		xyz.x += kernel_X[sampleIndex] * values[i];
+		xyz.y += kernel_Y[sampleIndex] * values[i];
+		xyz.z += kernel_Z[sampleIndex] * values[i];
+	}
+	xyz.mulLocal(sampleWeight);
+
+	// unlike SPD_to_CIE_XYZ_E(), reflectances are not clamped here, which 
+	// would bias the estimate
+	if constexpr(HINT == ESourceHint::ILLUMINANT)
+	{
+		return CIE_XYZ_D65_to_linear_sRGB(xyz.mulLocal(kernel_XYZ_D65_norm));
+	}
+	else
+	{
+		return CIE_XYZ_E_to_linear_sRGB(xyz);
+	}
+}
+
+template<ESourceHint HINT, std::size_t N>
+inline void ColorSpace::linear_sRGB_to_SPD_samples(
+	const Vector3R&                   color,
+	const std::array<std::size_t, N>& sampleIndices,
+	TArithmeticArray<real, N>* const  out_values)
+{
+	PH_ASSERT(isInitialized());
+	PH_ASSERT(out_values);
+
+	std::array<const SampledSpectralStrength*, 3> bases;
+	Vector3R                                      weights;
+	decompose_linear_sRGB_Smits(color, &bases, &weights);
+
+	for(std::size_t i = 0; i < N; ++i)
+	{
+		const std::size_t sampleIndex = sampleIndices[i];
+		PH_ASSERT_LT(sampleIndex, SampledSpectralStrength::NUM_VALUES);
+
+		real value = (*bases[0])[sampleIndex] * weights.x;
+		value += (*bases[1])[sampleIndex] * weights.y;
+		value += (*bases[2])[sampleIndex] * weights.z;
+
+		// same as the ILLUMINANT and REFLECTANCE cases of linear_sRGB_to_SPD()
+		if constexpr(HINT == ESourceHint::ILLUMINANT)
+		{
+			value *= SPD_D65[sampleIndex];
+		}
+		if constexpr(HINT == ESourceHint::REFLECTANCE)
+		{
+			value = std::fmin(1.0_r, std::fmax(value, 0.0_r));
+		}
+
+		(*out_values)[i] = value;
+	}
+}
+
+inline void ColorSpace::decompose_linear_sRGB_Smits(
+	const Vector3R&                                      color,
+	std::array<const SampledSpectralStrength*, 3>* const out_bases,
+	Vector3R* const                                      out_weights)
+{
+	PH_ASSERT(out_bases);
+	PH_ASSERT(out_weights);
+
 	const real r = color.x;
 	const real g = color.y;
 	const real b = color.z;
 
-	out_spd->setValues(0);
-
 	// The following steps mix in primary colors only as needed. Also, 
 	// (r, g, b) = (1, 1, 1) will be mapped to a constant SPD with 
 	// magnitudes = 1.
@@ -148,62 +248,63 @@ inline void ColorSpace::linear_sRGB_to_SPD(
 	// when R is minimum
 	if(r <= g && r <= b)
 	{
-		out_spd->addLocal(SPD_Smits_E_white * r);
+		(*out_bases)[0] = &SPD_Smits_E_white;
+		out_weights->x  = r;
 		if(g <= b)
 		{
-			out_spd->addLocal(SPD_Smits_E_cyan * (g - r));
-			out_spd->addLocal(SPD_Smits_E_blue * (b - g));
+			(*out_bases)[1] = &SPD_Smits_E_cyan;
+			out_weights->y  = g - r;
+			(*out_bases)[2] = &SPD_Smits_E_blue;
+			out_weights->z  = b - g;
 		}
 		else
 		{
-			out_spd->addLocal(SPD_Smits_E_cyan * (b - r));
-			out_spd->addLocal(SPD_Smits_E_green * (g - b));
+			(*out_bases)[1] = &SPD_Smits_E_cyan;
+			out_weights->y  = b - r;
+			(*out_bases)[2] = &SPD_Smits_E_green;
+			out_weights->z  = g - b;
 		}
 	}
 	// when G is minimum
 	else if(g <= r && g <= b)
 	{
-		out_spd->addLocal(SPD_Smits_E_white * g);
+		(*out_bases)[0] = &SPD_Smits_E_white;
+		out_weights->x  = g;
 		if(r <= b)
 		{
-			out_spd->addLocal(SPD_Smits_E_magenta * (r - g));
-			out_spd->addLocal(SPD_Smits_E_blue * (b - r));
+			(*out_bases)[1] = &SPD_Smits_E_magenta;
+			out_weights->y  = r - g;
+			(*out_bases)[2] = &SPD_Smits_E_blue;
+			out_weights->z  = b - r;
 		}
 		else
 		{
-			out_spd->addLocal(SPD_Smits_E_magenta * (b - g));
-			out_spd->addLocal(SPD_Smits_E_red * (r - b));
+			(*out_bases)[1] = &SPD_Smits_E_magenta;
+			out_weights->y  = b - g;
+			(*out_bases)[2] = &SPD_Smits_E_red;
+			out_weights->z  = r - b;
 		}
 	}
 	// when B is minimum
 	else
 	{
-		out_spd->addLocal(SPD_Smits_E_white * b);
+		(*out_bases)[0] = &SPD_Smits_E_white;
+		out_weights->x  = b;
 		if(r <= g)
 		{
-			out_spd->addLocal(SPD_Smits_E_yellow * (r - b));
-			out_spd->addLocal(SPD_Smits_E_green * (g - r));
+			(*out_bases)[1] = &SPD_Smits_E_yellow;
+			out_weights->y  = r - b;
+			(*out_bases)[2] = &SPD_Smits_E_green;
+			out_weights->z  = g - r;
 		}
 		else
 		{
-			out_spd->addLocal(SPD_Smits_E_yellow * (g - b));
-			out_spd->addLocal(SPD_Smits_E_red * (r - g));
+			(*out_bases)[1] = &SPD_Smits_E_yellow;
+			out_weights->y  = g - b;
+			(*out_bases)[2] = &SPD_Smits_E_red;
+			out_weights->z  = r - g;
 		}
 	}
-	
-	// For illuminants, scale its SPD so that constant SPDs matches D65.
-	//
-	if constexpr(HINT == ESourceHint::ILLUMINANT)
-	{
-		out_spd->mulLocal(SPD_D65);
-	}
-
-	// For reflectances, make sure energy conservation requirements are met.
-	//
-	if constexpr(HINT == ESourceHint::REFLECTANCE)
-	{
-		out_spd->clampLocal(0.0_r, 1.0_r);
-	}
 }
 
 template<ESourceHint HINT>
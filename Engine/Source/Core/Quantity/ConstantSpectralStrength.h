@@ -0,0 +1,104 @@
+#pragma once
+
+#include "Common/config.h"
+#include "Common/primitive_type.h"
+#include "Common/assertion.h"
+#include "Core/Quantity/SpectralStrength.h"
+#include "Core/Quantity/EQuantity.h"
+#include "Math/TVector3.h"
+
+namespace ph
+{
+
+/*
+	A spectral value that does not change during rendering, such as the color
+	of a light source. In hero wavelength mode (PH_RENDER_MODE_FULL_SPECTRAL),
+	the wavelengths of SpectralStrength are only known while tracing a path, 
+	so the whole spectrum is kept and get() converts it to the wavelengths
+	of the calling thread. In other modes, the value is converted once.
+*/
+class ConstantSpectralStrength final
+{
+public:
+	inline ConstantSpectralStrength();
+	explicit inline ConstantSpectralStrength(real value);
+	inline ConstantSpectralStrength(const Vector3R& linearSrgb, EQuantity valueType);
+	inline ConstantSpectralStrength(const SampledSpectralStrength& sampled, EQuantity valueType);
+
+	// In hero wavelength mode, <value> must be created without wavelengths
+	// (a constant spectrum, see THeroSpectralStrength).
+	explicit inline ConstantSpectralStrength(const SpectralStrength& value);
+
+	inline SpectralStrength get() const;
+
+private:
+#if defined(PH_RENDER_MODE_FULL_SPECTRAL)
+	SampledSpectralStrength m_sampled;
+#else
+	SpectralStrength        m_value;
+#endif
+};
+
+// In-header Implementations:
+
+inline ConstantSpectralStrength::ConstantSpectralStrength() :
+	ConstantSpectralStrength(0.0_r)
+{}
+
+#if defined(PH_RENDER_MODE_FULL_SPECTRAL)
+
+inline ConstantSpectralStrength::ConstantSpectralStrength(const real value) :
+	m_sampled(value)
+{}
+
+inline ConstantSpectralStrength::ConstantSpectralStrength(const Vector3R& linearSrgb, const EQuantity valueType) :
+	m_sampled()
+{
+	m_sampled.setLinearSrgb(linearSrgb, valueType);
+}
+
+inline ConstantSpectralStrength::ConstantSpectralStrength(const SampledSpectralStrength& sampled, const EQuantity valueType) :
+	m_sampled(sampled)
+{}
+
+inline ConstantSpectralStrength::ConstantSpectralStrength(const SpectralStrength& value) :
+	m_sampled(value.avg())
+{
+	PH_ASSERT(!SpectralStrength::hasWavelengths());
+}
+
+inline SpectralStrength ConstantSpectralStrength::get() const
+{
+	return SpectralStrength().setSampled(m_sampled);
+}
+
+#else
+
+inline ConstantSpectralStrength::ConstantSpectralStrength(const real value) :
+	m_value(value)
+{}
+
+inline ConstantSpectralStrength::ConstantSpectralStrength(const Vector3R& linearSrgb, const EQuantity valueType) :
+	m_value()
+{
+	m_value.setLinearSrgb(linearSrgb, valueType);
+}
+
+inline ConstantSpectralStrength::ConstantSpectralStrength(const SampledSpectralStrength& sampled, const EQuantity valueType) :
+	m_value()
+{
+	m_value.setSampled(sampled, valueType);
+}
+
+inline ConstantSpectralStrength::ConstantSpectralStrength(const SpectralStrength& value) :
+	m_value(value)
+{}
+
+inline SpectralStrength ConstantSpectralStrength::get() const
+{
+	return m_value;
+}
+
+#endif
+
+}// end namespace ph
@@ -4,6 +4,7 @@
 #include "Core/Quantity/spectral_strength_fwd.h"
 #include "Core/Quantity/private_SpectralStrength/LinearSrgbSpectralStrength.h"
 #include "Core/Quantity/private_SpectralStrength/TSampledSpectralStrength.h"
+#include "Core/Quantity/private_SpectralStrength/THeroSpectralStrength.h"
 
 namespace ph
 {
@@ -15,7 +16,7 @@ namespace ph
 	using SpectralStrength = SampledSpectralStrength;
 
 #elif defined(PH_RENDER_MODE_FULL_SPECTRAL)
-	// TODO
+	using SpectralStrength = HeroSpectralStrength;
 
 #else
 	using SpectralStrength = LinearSrgbSpectralStrength;
@@ -26,3 +27,4 @@ namespace ph
 
 #include "Core/Quantity/private_SpectralStrength/TAbstractSpectralStrength.tpp"
 #include "Core/Quantity/private_SpectralStrength/TSampledSpectralStrength.tpp"
+#include "Core/Quantity/private_SpectralStrength/THeroSpectralStrength.tpp"
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Core/Quantity/private_SpectralStrength/TAbstractSpectralStrength.h"
+#include "Core/Quantity/spectral_strength_fwd.h"
+#include "Math/TVector3.h"
+
+#include <cstddef>
+#include <array>
+
+namespace ph
+{
+
+/*
+	Spectral values at N wavelengths that are chosen per light path, i.e.,
+	hero wavelength spectral sampling (Wilkie et al., 2014). A hero 
+	wavelength is sampled uniformly and the others are evenly spaced after it
+	(wrapping around), so each of them is uniformly distributed as well.
+	Wavelengths are snapped to the intervals of SampledSpectralStrength to 
+	reuse its data for conversions.
+
+	The wavelengths are a per-thread state: they are selected by
+	sampleWavelengths() before tracing a path and apply to all values created
+	by that thread until the next selection. Without any selection, values
+	represent constant spectra (e.g., values converted while loading a 
+	scene); conversions then use the average over all wavelengths.
+*/
+template<std::size_t N>
+class THeroSpectralStrength final :
+	public TAbstractSpectralStrength<THeroSpectralStrength<N>, N>
+{
+public:
+	// Selects wavelengths by a uniform random sample in [0, 1).
+	static inline void sampleWavelengths(real sample);
+
+	static inline void clearWavelengths();
+	static inline bool hasWavelengths();
+
+	// Wavelength of the value at <index>, within the interval of its sample.
+	static inline real wavelengthNmOf(std::size_t index);
+
+	// Indices of SampledSpectralStrength's intervals the values are in.
+	static inline const std::array<std::size_t, N>& sampleIndices();
+
+public:
+	using Parent = TAbstractSpectralStrength<THeroSpectralStrength, N>;
+
+	inline THeroSpectralStrength() = default;
+	inline THeroSpectralStrength(const THeroSpectralStrength& other) = default;
+	using Parent::Parent;
+
+	inline Vector3R impl_genLinearSrgb(EQuantity valueType) const;
+	inline void impl_setLinearSrgb(const Vector3R& rgb, EQuantity valueType);
+	inline void impl_setSampled(const SampledSpectralStrength& sampled, EQuantity valueType);
+
+private:
+	struct Wavelengths
+	{
+		bool                       isSampled = false;
+		std::array<real, N>        nm;
+		std::array<std::size_t, N> sampleIndices;
+	};
+
+	static inline Wavelengths& threadWavelengths();
+};
+
+}// end namespace ph
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "Core/Quantity/private_SpectralStrength/THeroSpectralStrength.h"
+#include "Core/Quantity/ColorSpace.h"
+#include "Common/assertion.h"
+
+#include <cmath>
+#include <algorithm>
+
+namespace ph
+{
+
+template<std::size_t N>
+inline void THeroSpectralStrength<N>::sampleWavelengths(const real sample)
+{
+	PH_ASSERT_GE(sample, 0.0_r);
+	PH_ASSERT_LE(sample, 1.0_r);
+
+	constexpr std::size_t NUM_SAMPLES = SampledSpectralStrength::NUM_VALUES;
+
+	Wavelengths& wavelengths = threadWavelengths();
+	for(std::size_t i = 0; i < N; ++i)
+	{
+		real fraction = sample + static_cast<real>(i) / static_cast<real>(N);
+		fraction = fraction < 1.0_r ? fraction : fraction - 1.0_r;
+
+		wavelengths.nm[i] = 
+			static_cast<real>(PH_SPECTRUM_SAMPLED_MIN_WAVELENGTH_NM) + 
+			fraction * SampledSpectralStrength::LAMBDA_RANGE_NM;
+		wavelengths.sampleIndices[i] = std::min(
+			static_cast<std::size_t>(fraction * static_cast<real>(NUM_SAMPLES)), 
+			NUM_SAMPLES - 1);
+	}
+	wavelengths.isSampled = true;
+}
+
+template<std::size_t N>
+inline void THeroSpectralStrength<N>::clearWavelengths()
+{
+	threadWavelengths().isSampled = false;
+}
+
+template<std::size_t N>
+inline bool THeroSpectralStrength<N>::hasWavelengths()
+{
+	return threadWavelengths().isSampled;
+}
+
+template<std::size_t N>
+inline real THeroSpectralStrength<N>::wavelengthNmOf(const std::size_t index)
+{
+	PH_ASSERT(hasWavelengths());
+	PH_ASSERT_LT(index, N);
+
+	return threadWavelengths().nm[index];
+}
+
+template<std::size_t N>
+inline auto THeroSpectralStrength<N>::sampleIndices()
+	-> const std::array<std::size_t, N>&
+{
+	PH_ASSERT(hasWavelengths());
+
+	return threadWavelengths().sampleIndices;
+}
+
+template<std::size_t N>
+inline auto THeroSpectralStrength<N>::impl_genLinearSrgb(const EQuantity valueType) const
+	-> Vector3R
+{
+	if(!hasWavelengths())
+	{
+		return SampledSpectralStrength(this->m_values.avg()).genLinearSrgb(valueType);
+	}
+
+	switch(valueType)
+	{
+	case EQuantity::EMR:
+		return ColorSpace::SPD_samples_to_linear_sRGB<ESourceHint::ILLUMINANT>(
+			sampleIndices(), this->m_values);
+
+	case EQuantity::ECF:
+		return ColorSpace::SPD_samples_to_linear_sRGB<ESourceHint::REFLECTANCE>(
+			sampleIndices(), this->m_values);
+
+	default:
+		return ColorSpace::SPD_samples_to_linear_sRGB<ESourceHint::RAW_DATA>(
+			sampleIndices(), this->m_values);
+	}
+}
+
+template<std::size_t N>
+inline auto THeroSpectralStrength<N>::impl_setLinearSrgb(const Vector3R& linearSrgb, const EQuantity valueType)
+	-> void
+{
+	if(!hasWavelengths())
+	{
+		impl_setSampled(SampledSpectralStrength().setLinearSrgb(linearSrgb, valueType), valueType);
+		return;
+	}
+
+	switch(valueType)
+	{
+	case EQuantity::EMR:
+		ColorSpace::linear_sRGB_to_SPD_samples<ESourceHint::ILLUMINANT>(
+			linearSrgb, sampleIndices(), &(this->m_values));
+		break;
+
+	case EQuantity::ECF:
+		ColorSpace::linear_sRGB_to_SPD_samples<ESourceHint::REFLECTANCE>(
+			linearSrgb, sampleIndices(), &(this->m_values));
+		break;
+
+	default:
+		ColorSpace::linear_sRGB_to_SPD_samples<ESourceHint::RAW_DATA>(
+			linearSrgb, sampleIndices(), &(this->m_values));
+		break;
+	}
+}
+
+template<std::size_t N>
+inline auto THeroSpectralStrength<N>::impl_setSampled(const SampledSpectralStrength& sampled, const EQuantity valueType)
+	-> void
+{
+	if(!hasWavelengths())
+	{
+		this->m_values.set(sampled.avg());
+		return;
+	}
+
+	const std::array<std::size_t, N>& indices = sampleIndices();
+	for(std::size_t i = 0; i < N; ++i)
+	{
+		this->m_values[i] = sampled[indices[i]];
+	}
+}
+
+template<std::size_t N>
+inline auto THeroSpectralStrength<N>::threadWavelengths()
+	-> Wavelengths&
+{
+	thread_local Wavelengths wavelengths;
+	return wavelengths;
+}
+
+}// end namespace ph
@@ -19,4 +19,9 @@ using SampledSpectralStrength = TSampledSpectralStrength<
 	PH_SPECTRUM_SAMPLED_MIN_WAVELENGTH_NM,
 	PH_SPECTRUM_SAMPLED_MAX_WAVELENGTH_NM>;
 
+template<std::size_t N>
+class THeroSpectralStrength;
+
+using HeroSpectralStrength = THeroSpectralStrength<PH_SPECTRUM_HERO_NUM_WAVELENGTHS>;
+
 }// end namespace ph
\ No newline at end of file
@@ -14,26 +14,79 @@ RayDifferential::RayDifferential() :
 
 RayDifferential::RayDifferential(const Vector3R& dPdX, const Vector3R& dPdY,
                                  const Vector3R& dDdX, const Vector3R& dDdY) : 
-	m_dPdX(dPdX), m_dPdY(dPdY),
-	m_dDdX(dDdX), m_dDdY(dDdY),
+	m_P(0), m_D(0),
+	m_dPdX(), m_dPdY(),
+	m_dDdX(), m_dDdY(),
 	m_isPartialPsNonZero(false), m_isPartialDsNonZero(false)
 {
-
+	setPartialPs(dPdX, dPdY);
+	setPartialDs(dDdX, dDdY);
 }
 
 void RayDifferential::transferToSurface(const Vector3R& surfaceP, const Vector3R& surfaceN)
 {
 	PH_ASSERT(std::abs(surfaceN.length() - 1.0_r) < 0.0001_r);
 
+	// Grazing rays have (nearly) unbounded footprints on the surface; 
+	// treat their differentials as unknown.
 	const real DoN = m_D.dot(surfaceN);
-	const real T   = (surfaceP - m_P).dot(surfaceN) / DoN;
+	if(std::abs(DoN) < 0.0001_r)
+	{
+		setPartialPs(Vector3R(0), Vector3R(0));
+		setPartialDs(Vector3R(0), Vector3R(0));
+		m_P = surfaceP;
+		return;
+	}
+
+	const real T = (surfaceP - m_P).dot(surfaceN) / DoN;
 	PH_ASSERT(T >= 0.0_r);
 
 	const real dTdX = -(m_dPdX + T * m_dDdX).dot(surfaceN) / DoN;
 	const real dTdY = -(m_dPdY + T * m_dDdY).dot(surfaceN) / DoN;
 
-	m_dPdX = (m_dPdX + T * m_dDdX) + dTdX * m_D;
-	m_dPdY = (m_dPdY + T * m_dDdY) + dTdY * m_D;
+	setPartialPs((m_dPdX + T * m_dDdX) + dTdX * m_D,
+	             (m_dPdY + T * m_dDdY) + dTdY * m_D);
+	m_P = surfaceP;
+}
+
+void RayDifferential::calcPartialUVs(
+	const Vector3R& dPdU, const Vector3R& dPdV,
+	Vector2R* const out_dUVdX,
+	Vector2R* const out_dUVdY) const
+{
+	PH_ASSERT(out_dUVdX && out_dUVdY);
+
+	*out_dUVdX = Vector2R(0);
+	*out_dUVdY = Vector2R(0);
+
+	// Solving dPdU * du + dPdV * dv = dPdX (and likewise for y) in the least
+	// squares sense, as the partials do not necessarily lie on the tangent
+	// plane spanned by dPdU & dPdV.
+
+	const real UoU = dPdU.dot(dPdU);
+	const real UoV = dPdU.dot(dPdV);
+	const real VoV = dPdV.dot(dPdV);
+	const real det = UoU * VoV - UoV * UoV;
+	if(!m_isPartialPsNonZero || !std::isnormal(det))
+	{
+		return;
+	}
+
+	const real reciDet = 1.0_r / det;
+	const auto solve = [&](const Vector3R& dPdXorY, Vector2R* const out_dUV)
+	{
+		const real UoP = dPdU.dot(dPdXorY);
+		const real VoP = dPdV.dot(dPdXorY);
+		const Vector2R dUV(
+			(VoV * UoP - UoV * VoP) * reciDet,
+			(UoU * VoP - UoV * UoP) * reciDet);
+		if(std::isfinite(dUV.x) && std::isfinite(dUV.y))
+		{
+			*out_dUV = dUV;
+		}
+	};
+	solve(m_dPdX, out_dUVdX);
+	solve(m_dPdY, out_dUVdY);
 }
 
-}// end namespace ph
\ No newline at end of file
+}// end namespace ph
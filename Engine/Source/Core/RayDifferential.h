@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Math/TVector3.h"
+#include "Math/TVector2.h"
 
 #include <limits>
 
@@ -19,14 +20,40 @@ public:
 	// <surfaceP> with surface normal <surfaceN>.
 	void transferToSurface(const Vector3R& surfaceP, const Vector3R& surfaceN);
 
+	// Given partial derivatives of surface position with respect to surface
+	// parameters u & v, calculates partial derivatives of u & v with respect 
+	// to raster coordinates x & y. The partials should have been transferred
+	// to the surface. Derivatives are zero if they cannot be determined.
+	void calcPartialUVs(
+		const Vector3R& dPdU, const Vector3R& dPdV,
+		Vector2R*       out_dUVdX, 
+		Vector2R*       out_dUVdY) const;
+
 	// Modify differential quantities as if the ray is reversed in
 	// direction.
 	inline void reverse()
 	{
+		m_D.mulLocal(-1);
 		m_dDdX.mulLocal(-1);
 		m_dDdY.mulLocal(-1);
 	}
 
+	// Scales partials with respect to x & y by <sx> & <sy>, respectively. 
+	// This is useful for changing the unit of raster coordinates.
+	inline void scalePartials(const real sx, const real sy)
+	{
+		setPartialPs(m_dPdX.mul(sx), m_dPdY.mul(sy));
+		setPartialDs(m_dDdX.mul(sx), m_dDdY.mul(sy));
+	}
+
+	// Sets the point P and direction D of the ray that the differentials 
+	// are for.
+	inline void setRay(const Vector3R& P, const Vector3R& D)
+	{
+		m_P = P;
+		m_D = D;
+	}
+
 	inline void setPartialPs(const Vector3R& dPdX, const Vector3R& dPdY)
 	{
 		m_dPdX = dPdX;
@@ -43,6 +70,8 @@ public:
 		m_isPartialDsNonZero = isVectorNonZero(dDdX) || isVectorNonZero(dDdY);
 	}
 
+	inline const Vector3R& getP() const    { return m_P;    }
+	inline const Vector3R& getD() const    { return m_D;    }
 	inline const Vector3R& getdPdX() const { return m_dPdX; }
 	inline const Vector3R& getdPdY() const { return m_dPdY; }
 	inline const Vector3R& getdDdX() const { return m_dDdX; }
@@ -70,4 +99,4 @@ private:
 	}
 };
 
-}// end namespace ph
\ No newline at end of file
+}// end namespace ph
@@ -15,18 +15,22 @@ public:
 	void setLayerName(std::size_t index, const std::string& name);
 	void setIntegerState(std::size_t index, const std::string& name);
 	void setRealState(std::size_t index, const std::string& name);
+	void setHistogram(std::size_t index, const std::string& name);
 
 	std::string getLayerName(std::size_t index) const;
 	std::string getIntegerStateName(std::size_t index) const;
 	std::string getRealStateName(std::size_t index) const;
+	std::string getHistogramName(std::size_t index) const;
 	std::size_t numLayers() const;
 	std::size_t numIntegerStates() const;
 	std::size_t numRealStates() const;
+	std::size_t numHistograms() const;
 
 private:
 	std::vector<std::string> m_layerNames;
 	std::vector<std::string> m_integerStateNames;
 	std::vector<std::string> m_realStateNames;
+	std::vector<std::string> m_histogramNames;
 };
 
 // In-header Implementations:
@@ -64,6 +68,17 @@ inline void ObservableRenderData::setRealState(const std::size_t index, const st
 	m_realStateNames[index] = name;
 }
 
+inline void ObservableRenderData::setHistogram(const std::size_t index, const std::string& name)
+{
+	if(index >= m_histogramNames.size())
+	{
+		m_histogramNames.resize(index + 1);
+	}
+
+	PH_ASSERT_LT(index, m_histogramNames.size());
+	m_histogramNames[index] = name;
+}
+
 inline std::string ObservableRenderData::getLayerName(const std::size_t index) const
 {
 	PH_ASSERT_LT(index, m_layerNames.size());
@@ -82,6 +97,12 @@ inline std::string ObservableRenderData::getRealStateName(const std::size_t inde
 	return m_realStateNames[index];
 }
 
+inline std::string ObservableRenderData::getHistogramName(const std::size_t index) const
+{
+	PH_ASSERT_LT(index, m_histogramNames.size());
+	return m_histogramNames[index];
+}
+
 inline std::size_t ObservableRenderData::numLayers() const
 {
 	return m_layerNames.size();
@@ -97,4 +118,9 @@ inline std::size_t ObservableRenderData::numRealStates() const
 	return m_realStateNames.size();
 }
 
+inline std::size_t ObservableRenderData::numHistograms() const
+{
+	return m_histogramNames.size();
+}
+
 }// end namespace ph
\ No newline at end of file
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "Core/Renderer/PM/TPhoton.h"
+#include "Core/Quantity/SpectralStrength.h"
+#include "Math/TVector3.h"
+#include "Math/encoding.h"
+#include "Common/primitive_type.h"
+#include "Common/assertion.h"
+
+#include <array>
+
+namespace ph
+{
+
+/*
+	A photon type for storing large amounts of photons. Position is stored 
+	in single precision, direction is quantized to 32 bits and throughput 
+	radiance is stored with a shared exponent; this takes 20 bytes in RGB 
+	mode, compared to 36 bytes of FullPhoton (with single precision reals).
+*/
+class CompactPhoton : public TPhoton<CompactPhoton>
+{
+public:
+	CompactPhoton() = default;
+
+	template<EPhotonData TYPE>
+	static constexpr bool impl_has();
+
+	template<EPhotonData TYPE>
+	decltype(auto) impl_get() const;
+
+	template<EPhotonData TYPE, typename T>
+	void impl_set(const T& value);
+
+private:
+	constexpr static std::size_t NUM_SPECTRAL_VALUES = SpectralStrength::NUM_VALUES;
+
+	TVector3<float32>                           m_position;
+	uint32                                      m_fromDir;
+	std::array<uint8, NUM_SPECTRAL_VALUES + 1> m_throughputRadiance;
+};
+
+// In-header Implementations:
+
+template<EPhotonData TYPE>
+inline constexpr bool CompactPhoton::impl_has()
+{
+	if constexpr(
+		TYPE == EPhotonData::THROUGHPUT_RADIANCE ||
+		TYPE == EPhotonData::POSITION            || 
+		TYPE == EPhotonData::FROM_DIR)
+	{
+		return true;
+	}
+	else
+	{
+		return false;
+	}
+}
+
+template<EPhotonData TYPE>
+inline decltype(auto) CompactPhoton::impl_get() const
+{
+	if constexpr(TYPE == EPhotonData::THROUGHPUT_RADIANCE)
+	{
+		real values[NUM_SPECTRAL_VALUES];
+		encoding::decode_shared_exponent<NUM_SPECTRAL_VALUES>(m_throughputRadiance.data(), values);
+
+		SpectralStrength throughputRadiance;
+		for(std::size_t i = 0; i < NUM_SPECTRAL_VALUES; ++i)
+		{
+			throughputRadiance[i] = values[i];
+		}
+		return throughputRadiance;
+	}
+	else if constexpr(TYPE == EPhotonData::POSITION)
+	{
+		return Vector3R(m_position);
+	}
+	else if constexpr(TYPE == EPhotonData::FROM_DIR)
+	{
+		return encoding::decode_unit_vector_octahedral(m_fromDir);
+	}
+	else
+	{
+		PH_ASSERT_UNREACHABLE_SECTION();
+		return false;
+	}
+}
+
+template<EPhotonData TYPE, typename T>
+inline void CompactPhoton::impl_set(const T& value)
+{
+	if constexpr(TYPE == EPhotonData::THROUGHPUT_RADIANCE)
+	{
+		real values[NUM_SPECTRAL_VALUES];
+		for(std::size_t i = 0; i < NUM_SPECTRAL_VALUES; ++i)
+		{
+			values[i] = value[i];
+		}
+		encoding::encode_shared_exponent<NUM_SPECTRAL_VALUES>(values, m_throughputRadiance.data());
+	}
+	else if constexpr(TYPE == EPhotonData::POSITION)
+	{
+		m_position = TVector3<float32>(value);
+	}
+	else if constexpr(TYPE == EPhotonData::FROM_DIR)
+	{
+		m_fromDir = encoding::encode_unit_vector_octahedral<uint32>(value);
+	}
+	else
+	{
+		PH_ASSERT_UNREACHABLE_SECTION();
+	}
+}
+
+}// end namespace ph
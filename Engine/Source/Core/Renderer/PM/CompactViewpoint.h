@@ -0,0 +1,150 @@
+#pragma once
+
+#include "Core/Renderer/PM/TViewpoint.h"
+#include "Common/primitive_type.h"
+#include "Core/SurfaceHit.h"
+#include "Math/TVector2.h"
+#include "Math/encoding.h"
+#include "Core/Quantity/SpectralStrength.h"
+#include "Common/assertion.h"
+
+#include <cstddef>
+#include <array>
+
+namespace ph
+{
+
+/*
+	A viewpoint type with smaller memory footprint than FullViewpoint. View
+	direction is not stored but derived from the incident ray of the surface
+	hit, and view throughput is stored with a shared exponent. Quantities 
+	accumulated over passes are kept in full precision.
+*/
+class CompactViewpoint : public TViewpoint<CompactViewpoint>
+{
+public:
+	CompactViewpoint() = default;
+
+	template<EViewpointData TYPE>
+	static constexpr bool impl_has();
+
+	template<EViewpointData TYPE>
+	decltype(auto) impl_get() const;
+
+	template<EViewpointData TYPE, typename T>
+	void impl_set(const T& value);
+
+private:
+	constexpr static std::size_t NUM_SPECTRAL_VALUES = SpectralStrength::NUM_VALUES;
+
+	SurfaceHit                                 m_surfaceHit;
+	Vector2R                                   m_filmNdc;
+	real                                       m_radius;
+	real                                       m_numPhotons;
+	SpectralStrength                           m_tau;
+	std::array<uint8, NUM_SPECTRAL_VALUES + 1> m_viewThroughput;
+	SpectralStrength                           m_viewRadiance;
+};
+
+// In-header Implementations:
+
+template<EViewpointData TYPE>
+inline constexpr bool CompactViewpoint::impl_has()
+{
+	if constexpr(
+		TYPE == EViewpointData::SURFACE_HIT       ||
+		TYPE == EViewpointData::FILM_NDC          ||
+		TYPE == EViewpointData::RADIUS            ||
+		TYPE == EViewpointData::NUM_PHOTONS       ||
+		TYPE == EViewpointData::TAU               ||
+		TYPE == EViewpointData::VIEW_THROUGHPUT   || 
+		TYPE == EViewpointData::VIEW_DIR          || 
+		TYPE == EViewpointData::VIEW_RADIANCE)
+	{
+		return true;
+	}
+	else
+	{
+		return false;
+	}
+}
+
+template<EViewpointData TYPE>
+inline decltype(auto) CompactViewpoint::impl_get() const
+{
+	if constexpr(TYPE == EViewpointData::SURFACE_HIT) {
+		return m_surfaceHit;
+	}
+	else if constexpr(TYPE == EViewpointData::FILM_NDC) {
+		return m_filmNdc;
+	}
+	else if constexpr(TYPE == EViewpointData::RADIUS) {
+		return m_radius;
+	}
+	else if constexpr(TYPE == EViewpointData::NUM_PHOTONS) {
+		return m_numPhotons;
+	}
+	else if constexpr(TYPE == EViewpointData::TAU) {
+		return m_tau;
+	}
+	else if constexpr(TYPE == EViewpointData::VIEW_THROUGHPUT) {
+		real values[NUM_SPECTRAL_VALUES];
+		encoding::decode_shared_exponent<NUM_SPECTRAL_VALUES>(m_viewThroughput.data(), values);
+
+		SpectralStrength viewThroughput;
+		for(std::size_t i = 0; i < NUM_SPECTRAL_VALUES; ++i)
+		{
+			viewThroughput[i] = values[i];
+		}
+		return viewThroughput;
+	}
+	else if constexpr(TYPE == EViewpointData::VIEW_DIR) {
+		return m_surfaceHit.getIncidentRay().getDirection().mul(-1);
+	}
+	else if constexpr(TYPE == EViewpointData::VIEW_RADIANCE) {
+		return m_viewRadiance;
+	}
+	else {
+		PH_ASSERT_UNREACHABLE_SECTION();
+		return false;
+	}
+}
+
+template<EViewpointData TYPE, typename T>
+inline void CompactViewpoint::impl_set(const T& value)
+{
+	if constexpr(TYPE == EViewpointData::SURFACE_HIT) {
+		m_surfaceHit = value;
+	}
+	else if constexpr(TYPE == EViewpointData::FILM_NDC) {
+		m_filmNdc = value;
+	}
+	else if constexpr(TYPE == EViewpointData::RADIUS) {
+		m_radius = value;
+	}
+	else if constexpr(TYPE == EViewpointData::NUM_PHOTONS) {
+		m_numPhotons = value;
+	}
+	else if constexpr(TYPE == EViewpointData::TAU) {
+		m_tau = value;
+	}
+	else if constexpr(TYPE == EViewpointData::VIEW_THROUGHPUT) {
+		real values[NUM_SPECTRAL_VALUES];
+		for(std::size_t i = 0; i < NUM_SPECTRAL_VALUES; ++i)
+		{
+			values[i] = value[i];
+		}
+		encoding::encode_shared_exponent<NUM_SPECTRAL_VALUES>(values, m_viewThroughput.data());
+	}
+	else if constexpr(TYPE == EViewpointData::VIEW_DIR) {
+		// derived from the surface hit
+	}
+	else if constexpr(TYPE == EViewpointData::VIEW_RADIANCE) {
+		m_viewRadiance = value;
+	}
+	else {
+		PH_ASSERT_UNREACHABLE_SECTION();
+	}
+}
+
+}// end namespace ph
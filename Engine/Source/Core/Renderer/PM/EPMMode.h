@@ -7,7 +7,9 @@ enum class EPMMode
 {
 	VANILLA,
 	PROGRESSIVE,
-	STOCHASTIC_PROGRESSIVE
+	ADAPTIVE_PROGRESSIVE,
+	STOCHASTIC_PROGRESSIVE,
+	VCM
 };
 
 }// end namespace ph
\ No newline at end of file
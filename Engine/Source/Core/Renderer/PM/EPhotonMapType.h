@@ -0,0 +1,12 @@
+#pragma once
+
+namespace ph
+{
+
+enum class EPhotonMapType
+{
+	KD_TREE,
+	HASH_GRID
+};
+
+}// end namespace ph
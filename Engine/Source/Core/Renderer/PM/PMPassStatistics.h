@@ -0,0 +1,120 @@
+#pragma once
+
+#include "Core/Renderer/PM/TPhotonMap.h"
+#include "Common/primitive_type.h"
+#include "Common/assertion.h"
+
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <algorithm>
+
+namespace ph
+{
+
+/*
+	Measurements of a single photon mapping pass, for tuning the kernel
+	radius and the number of photons of a scene. Leaves are those of a
+	kd-tree photon map, or buckets of a hash grid one. Radii are binned
+	evenly over [0, initial radius].
+*/
+class PMPassStatistics final
+{
+public:
+	static constexpr std::size_t NUM_HISTOGRAM_BINS = 16;
+
+	using Histogram = std::array<std::size_t, NUM_HISTOGRAM_BINS>;
+
+	float64     photonMapBuildMs;
+	float64     radianceEvaluationMs;
+	std::size_t numGatherQueries;
+	std::size_t numGatheredPhotons;
+	std::size_t photonMapBytes;
+	std::size_t viewpointBytes;
+
+	std::size_t numLeaves;
+	std::size_t maxLeafDepth;
+	Histogram   leafDepthHistogram;
+	Histogram   leafSizeHistogram;
+
+	std::size_t numRadii;
+	real        minRadius;
+	real        maxRadius;
+	float64     sumRadii;
+	Histogram   radiusHistogram;
+
+	PMPassStatistics();
+
+	template<typename Photon>
+	void addPhotonMap(const TPhotonMap<Photon>& photonMap);
+
+	void addRadius(real radius, real initialRadius);
+
+	real avgGatheredPhotons() const;
+	real avgRadius() const;
+};
+
+// In-header Implementations:
+
+inline PMPassStatistics::PMPassStatistics() :
+	photonMapBuildMs    (0),
+	radianceEvaluationMs(0),
+	numGatherQueries    (0),
+	numGatheredPhotons  (0),
+	photonMapBytes      (0),
+	viewpointBytes      (0),
+
+	numLeaves         (0),
+	maxLeafDepth      (0),
+	leafDepthHistogram(),
+	leafSizeHistogram (),
+
+	numRadii       (0),
+	minRadius      (std::numeric_limits<real>::max()),
+	maxRadius      (0),
+	sumRadii       (0),
+	radiusHistogram()
+{}
+
+template<typename Photon>
+inline void PMPassStatistics::addPhotonMap(const TPhotonMap<Photon>& photonMap)
+{
+	photonMapBytes += photonMap.memoryUsage();
+
+	photonMap.forEachLeaf(
+		[this](const std::size_t depth, const std::size_t numPhotons)
+		{
+			++numLeaves;
+			maxLeafDepth = std::max(depth, maxLeafDepth);
+
+			// the last bins also count all larger values
+			++leafDepthHistogram[std::min(depth, NUM_HISTOGRAM_BINS - 1)];
+			++leafSizeHistogram[std::min(numPhotons, NUM_HISTOGRAM_BINS - 1)];
+		});
+}
+
+inline void PMPassStatistics::addRadius(const real radius, const real initialRadius)
+{
+	PH_ASSERT_GT(initialRadius, 0.0_r);
+
+	++numRadii;
+	minRadius = std::min(radius, minRadius);
+	maxRadius = std::max(radius, maxRadius);
+	sumRadii += radius;
+
+	const auto bin = static_cast<std::size_t>(std::max(radius / initialRadius, 0.0_r) * NUM_HISTOGRAM_BINS);
+	++radiusHistogram[std::min(bin, NUM_HISTOGRAM_BINS - 1)];
+}
+
+inline real PMPassStatistics::avgGatheredPhotons() const
+{
+	return numGatherQueries > 0 ?
+		static_cast<real>(numGatheredPhotons) / static_cast<real>(numGatherQueries) : 0.0_r;
+}
+
+inline real PMPassStatistics::avgRadius() const
+{
+	return numRadii > 0 ? static_cast<real>(sumRadii / static_cast<float64>(numRadii)) : 0.0_r;
+}
+
+}// end namespace ph
@@ -3,21 +3,37 @@
 #include "FileIO/SDL/SdlResourcePack.h"
 #include "Core/Renderer/PM/TViewPathTracingWork.h"
 #include "Core/Renderer/PM/TPhotonMappingWork.h"
+#include "Core/Renderer/PM/TAdaptivePhotonMappingWork.h"
+#include "Core/Renderer/PM/PMVisibilityGrid.h"
 #include "Core/Renderer/PM/TPhotonMap.h"
-#include "Core/Renderer/PM/VPMRadianceEvaluator.h"
+#include "Core/Renderer/PM/TVPMRadianceEvaluator.h"
 #include "Core/Renderer/PM/FullPhoton.h"
 #include "FileIO/SDL/InputPacket.h"
-#include "Utility/FixedSizeThreadPool.h"
 #include "Utility/concurrent.h"
 #include "Common/Logger.h"
-#include "Core/Renderer/PM/PPMRadianceEvaluationWork.h"
-#include "Core/Renderer/PM/FullPhoton.h"
+#include "Core/Renderer/PM/TPPMRadianceEvaluationWork.h"
 #include "Core/Renderer/PM/FullViewpoint.h"
+#include "Core/Renderer/PM/CompactPhoton.h"
+#include "Core/Renderer/PM/CompactViewpoint.h"
 #include "Utility/Timer.h"
 #include "Core/Renderer/PM/TPPMViewpointCollector.h"
 #include "Core/Renderer/PM/TSPPMRadianceEvaluator.h"
+#include "Core/Renderer/Region/TileScheduler.h"
+#include "Math/Random.h"
+#include "Math/math.h"
+#include "Math/hash.h"
+#include "Utility/TaskGroup.h"
+#include "Core/Renderer/PM/VCMParameters.h"
+#include "Core/Renderer/PM/VCMLightPathWork.h"
+#include "Core/Renderer/PM/VCMCameraPathWork.h"
+#include "Common/assertion.h"
 
 #include <numeric>
+#include <algorithm>
+#include <utility>
+#include <cmath>
+#include <string>
+#include <cstring>
 
 namespace ph
 {
@@ -25,6 +41,37 @@ namespace ph
 namespace
 {
 	const Logger logger(LogSender("PM Renderer"));
+
+	// Negative values are rejected in favor of <defaultValue>, instead of
+	// becoming huge sizes.
+	std::size_t get_size_input(
+		const InputPacket& packet,
+		const std::string& name,
+		const integer      defaultValue)
+	{
+		PH_ASSERT_GE(defaultValue, 0);
+
+		const integer value = packet.getInteger(name, defaultValue);
+		if(value < 0)
+		{
+			logger.log(ELogLevel::WARNING_MED, 
+				name + " cannot be negative (" + std::to_string(value) + "), " + 
+				std::to_string(defaultValue) + " is used instead");
+
+			return static_cast<std::size_t>(defaultValue);
+		}
+
+		return static_cast<std::size_t>(value);
+	}
+
+	// In deterministic mode, randomness of each piece of work is keyed by 
+	// the stage it belongs to and the piece itself.
+	constexpr uint64 PHOTON_TRACING_KEY    = 0;
+	constexpr uint64 VIEWPOINT_TRACING_KEY = 1;
+
+	// VCM merge radius shrinks over passes in proportion to 
+	// (passIndex + 1)^(-(1 - alpha) / 2), as in progressive photon mapping.
+	constexpr real VCM_RADIUS_ALPHA = 0.75_r;
 }
 
 void PMRenderer::doUpdate(const SdlResourcePack& data)
@@ -32,33 +79,78 @@ void PMRenderer::doUpdate(const SdlResourcePack& data)
 	m_film = std::make_unique<HdrRgbFilm>(getRenderWidthPx(), getRenderHeightPx(), getRenderWindowPx(), m_filter);
 
 	m_scene = &(data.visualWorld.getScene());
+	m_sceneSignature = data.visualWorld.getSceneSignature();
 	m_camera = data.getCamera().get();
 	m_sg = data.getSampleGenerator().get();
 
 	m_statistics.zero();
 	m_photonsPerSecond = 0;
 	m_isFilmUpdated = false;
+	m_numPlannedIterations = m_mode != EPMMode::VANILLA ? m_numPasses : m_numSamplesPerPixel;
 }
 
 void PMRenderer::doRender()
 {
+	logger.log(std::string("photon map: ") + 
+		(m_photonMapType == EPhotonMapType::HASH_GRID ? "hash grid" : "kd-tree"));
+
 	if(m_mode == EPMMode::VANILLA)
 	{
 		logger.log("rendering mode: vanilla photon mapping");
 
-		renderWithVanillaPM();
+		if(m_useCompactStorage)
+		{
+			renderWithVanillaPM<CompactPhoton>();
+		}
+		else
+		{
+			renderWithVanillaPM<FullPhoton>();
+		}
 	}
 	else if(m_mode == EPMMode::PROGRESSIVE)
 	{
 		logger.log("rendering mode: progressive photon mapping");
 
-		renderWithProgressivePM();
+		if(m_useCompactStorage)
+		{
+			renderWithProgressivePM<CompactPhoton, CompactViewpoint>();
+		}
+		else
+		{
+			renderWithProgressivePM<FullPhoton, FullViewpoint>();
+		}
+	}
+	else if(m_mode == EPMMode::ADAPTIVE_PROGRESSIVE)
+	{
+		logger.log("rendering mode: adaptive progressive photon mapping");
+
+		if(m_useCompactStorage)
+		{
+			renderWithProgressivePM<CompactPhoton, CompactViewpoint>();
+		}
+		else
+		{
+			renderWithProgressivePM<FullPhoton, FullViewpoint>();
+		}
 	}
 	else if(m_mode == EPMMode::STOCHASTIC_PROGRESSIVE)
 	{
 		logger.log("rendering mode: stochastic progressive photon mapping");
 
-		renderWithStochasticProgressivePM();
+		if(m_useCompactStorage)
+		{
+			renderWithStochasticProgressivePM<CompactPhoton, CompactViewpoint>();
+		}
+		else
+		{
+			renderWithStochasticProgressivePM<FullPhoton, FullViewpoint>();
+		}
+	}
+	else if(m_mode == EPMMode::VCM)
+	{
+		logger.log("rendering mode: vertex connection and merging");
+
+		renderWithVCM();
 	}
 	else
 	{
@@ -66,200 +158,614 @@ void PMRenderer::doRender()
 	}
 }
 
-void PMRenderer::renderWithVanillaPM()
+template<typename Photon>
+std::size_t PMRenderer::tracePhotons(
+	std::vector<Photon>&          photonBuffer, 
+	const std::size_t             passIndex,
+	const PMVisibilityGrid* const visibilityGrid)
 {
-	using Photon = FullPhoton;
-
-	logger.log("photon size: " + std::to_string(sizeof(Photon)) + " bytes");
+	// Adaptive tracing may store fewer photons than a range has room for, and 
+	// its paths are counted by the chain, uniformly sampled and visible 
+	// uniformly sampled ones.
+	struct PhotonRange
+	{
+		std::size_t begin                  = 0;
+		std::size_t numStoredPhotons       = 0;
+		std::size_t numPhotonPaths         = 0;
+		std::size_t numUniformPaths        = 0;
+		std::size_t numVisibleUniformPaths = 0;
+	};
+
+	const auto tracePhotonRange = [this, &photonBuffer, visibilityGrid](
+		const std::size_t  workStart, 
+		const std::size_t  workEnd,
+		PhotonRange* const out_range)
+	{
+		out_range->begin = workStart;
 
-	logger.log("target number of photons: " + std::to_string(m_numPhotons));
-	logger.log("size of photon buffer: " + std::to_string(sizeof(Photon) * m_numPhotons / 1024 / 1024) + " MB");
-	logger.log("start shooting photons...");
-
-	std::vector<Photon>  photonBuffer(m_numPhotons);
-	std::vector<std::size_t> numPhotonPaths(numWorkers(), 0);
-	parallel_work(m_numPhotons, numWorkers(),
-		[this, &photonBuffer, &numPhotonPaths](
-			const std::size_t workerIdx, 
-			const std::size_t workStart, 
-			const std::size_t workEnd)
+		if(visibilityGrid)
 		{
-			auto sampleGenerator = m_sg->genCopied(1);
-
-			TPhotonMappingWork<Photon> photonMappingWork(
+			TAdaptivePhotonMappingWork<Photon> photonMappingWork(
 				m_scene,
-				m_camera,
-				sampleGenerator.get(),
+				visibilityGrid,
 				&(photonBuffer[workStart]),
-				workEnd - workStart,
-				&(numPhotonPaths[workerIdx]));
+				workEnd - workStart);
 			photonMappingWork.setPMStatistics(&m_statistics);
 
 			photonMappingWork.work();
-		});
-	const std::size_t totalPhotonPaths = std::accumulate(numPhotonPaths.begin(), numPhotonPaths.end(), std::size_t(0));
 
-	logger.log("building photon map...");
+			out_range->numStoredPhotons       = photonMappingWork.numStoredPhotons();
+			out_range->numPhotonPaths         = photonMappingWork.numChainPaths();
+			out_range->numUniformPaths        = photonMappingWork.numUniformPaths();
+			out_range->numVisibleUniformPaths = photonMappingWork.numVisibleUniformPaths();
+			return;
+		}
 
-	TPhotonMap<Photon> photonMap(2, TPhotonCenterCalculator<Photon>());
-	photonMap.build(std::move(photonBuffer));
+		auto sampleGenerator = m_sg->genCopied(1);
 
-	logger.log("estimating radiance...");
+		TPhotonMappingWork<Photon> photonMappingWork(
+			m_scene,
+			m_camera,
+			sampleGenerator.get(),
+			&(photonBuffer[workStart]),
+			workEnd - workStart,
+			&(out_range->numPhotonPaths));
+		photonMappingWork.setPMStatistics(&m_statistics);
 
-	parallel_work(m_numSamplesPerPixel, numWorkers(),
-		[this, &photonMap, totalPhotonPaths](
-			const std::size_t workerIdx, 
-			const std::size_t workStart, 
-			const std::size_t workEnd)
+		photonMappingWork.work();
+
+		out_range->numStoredPhotons = workEnd - workStart;
+	};
+
+	std::vector<PhotonRange> ranges;
+	if(!isDeterministic())
+	{
+		ranges.resize(numWorkers());
+		parallel_work(photonBuffer.size(), numWorkers(),
+			[&tracePhotonRange, &ranges](
+				const std::size_t workerIdx, 
+				const std::size_t workStart, 
+				const std::size_t workEnd)
+			{
+				tracePhotonRange(workStart, workEnd, &(ranges[workerIdx]));
+			});
+	}
+	else
+	{
+		// photons are traced in fixed chunks, each with its own keyed randomness
+		const std::size_t numChunks = math::ceil_div_positive(photonBuffer.size(), DETERMINISTIC_PHOTON_CHUNK_SIZE);
+
+		ranges.resize(numChunks);
+		parallel_for(0, numChunks,
+			[&photonBuffer, &tracePhotonRange, &ranges, passIndex](
+				const std::size_t chunkBegin, 
+				const std::size_t chunkEnd)
+			{
+				for(std::size_t chunkIndex = chunkBegin; chunkIndex < chunkEnd; ++chunkIndex)
+				{
+					Random::keyThisThread(PHOTON_TRACING_KEY, passIndex, chunkIndex);
+
+					const std::size_t workStart = chunkIndex * DETERMINISTIC_PHOTON_CHUNK_SIZE;
+					const std::size_t workEnd   = std::min(workStart + DETERMINISTIC_PHOTON_CHUNK_SIZE, photonBuffer.size());
+					tracePhotonRange(workStart, workEnd, &(ranges[chunkIndex]));
+				}
+			});
+	}
+
+	std::size_t numStoredPhotons       = 0;
+	std::size_t numPhotonPaths         = 0;
+	std::size_t numUniformPaths        = 0;
+	std::size_t numVisibleUniformPaths = 0;
+	for(const PhotonRange& range : ranges)
+	{
+		// ranges are in buffer order, so photons only move towards the front
+		if(range.begin != numStoredPhotons)
 		{
-			auto sampleGenerator = m_sg->genCopied(workEnd - workStart);
-			auto film            = std::make_unique<HdrRgbFilm>(
-				getRenderWidthPx(), getRenderHeightPx(), getRenderWindowPx(), m_filter);
-
-			VPMRadianceEvaluator evaluator(
-				&photonMap, 
-				totalPhotonPaths, 
-				film.get(), 
-				m_scene);
-			evaluator.setPMRenderer(this);
-			evaluator.setPMStatistics(&m_statistics);
-			evaluator.setKernelRadius(m_kernelRadius);
-
-			TViewPathTracingWork<VPMRadianceEvaluator> radianceEvaluator(
-				&evaluator,
-				m_scene,
-				m_camera,
-				sampleGenerator.get(),
-				getRenderWindowPx(),
-				{getRenderWidthPx(), getRenderHeightPx()});
+			std::move(
+				photonBuffer.begin() + range.begin, 
+				photonBuffer.begin() + range.begin + range.numStoredPhotons,
+				photonBuffer.begin() + numStoredPhotons);
+		}
 
-			radianceEvaluator.work();
-		});
+		numStoredPhotons       += range.numStoredPhotons;
+		numPhotonPaths         += range.numPhotonPaths;
+		numUniformPaths        += range.numUniformPaths;
+		numVisibleUniformPaths += range.numVisibleUniformPaths;
+	}
+	photonBuffer.resize(numStoredPhotons);
+
+	if(!visibilityGrid)
+	{
+		return numPhotonPaths;
+	}
+	else if(numVisibleUniformPaths == 0)
+	{
+		return numUniformPaths;
+	}
+
+	// Visible paths make up numVisibleUniformPaths / numUniformPaths of all 
+	// paths; chain paths only sample those.
+	const float64 numEquivalentPaths = 
+		static_cast<float64>(numPhotonPaths) * 
+		static_cast<float64>(numUniformPaths) / 
+		static_cast<float64>(numVisibleUniformPaths);
+	return static_cast<std::size_t>(numEquivalentPaths + 0.5);
 }
 
-void PMRenderer::renderWithProgressivePM()
+template<typename Photon>
+void PMRenderer::renderWithVanillaPM()
 {
-	using Photon    = FullPhoton;
-	using Viewpoint = FullViewpoint;
+	using RadianceEvaluator = TVPMRadianceEvaluator<Photon>;
 
 	logger.log("photon size: " + std::to_string(sizeof(Photon)) + " bytes");
-	logger.log("viewpoint size: " + std::to_string(sizeof(Viewpoint)) + " bytes");
 
-	logger.log("start gathering viewpoints...");
+	// all samples use the same photon map, so they are recorded as a single pass
+	PMPassStatistics passStatistics;
+	Timer            stageTimer;
 
-	std::vector<Viewpoint> viewpoints;
+	// photons saved for other geometry, lights or tracing settings are not loaded
+	uint64 kernelRadiusBits = 0;
+	std::memcpy(&kernelRadiusBits, &m_kernelRadius, sizeof(real));
+	const uint64 photonMapFileKey = hash::combine_64(
+		hash::combine_64(m_sceneSignature, m_numPhotons), kernelRadiusBits);
+
+	TPhotonMap<Photon> photonMap(m_photonMapType);
+	std::size_t        totalPhotonPaths = 0;
+	if(m_usePhotonMapFile && photonMap.load(m_photonMapFilePath, photonMapFileKey, &totalPhotonPaths))
 	{
-		using ViewpointCollector = TPPMViewpointCollector<Viewpoint>;
-		ViewpointCollector viewpointCollector(6, m_kernelRadius);
+		logger.log("photon map of " + std::to_string(photonMap.numItems()) + " photons loaded from <" + 
+			m_photonMapFilePath.toString() + ">, photon tracing skipped");
+	}
+	else
+	{
+		logger.log("target number of photons: " + std::to_string(m_numPhotons));
+		logger.log("size of photon buffer: " + std::to_string(sizeof(Photon) * m_numPhotons / 1024 / 1024) + " MB");
+		logger.log("start shooting photons...");
 
-		auto viewpointSampleGenerator = m_sg->genCopied(m_numSamplesPerPixel);
+		std::vector<Photon> photonBuffer(m_numPhotons);
+		totalPhotonPaths = tracePhotons(photonBuffer, 0);
 
-		TViewPathTracingWork<ViewpointCollector> viewpointWork(
-			&viewpointCollector,
-			m_scene, 
-			m_camera, 
-			viewpointSampleGenerator.get(),
-			getRenderWindowPx(),
-			{getRenderWidthPx(), getRenderHeightPx()});
+		logger.log("building photon map...");
 
-		viewpointWork.work();
+		stageTimer.start();
+		photonMap.build(std::move(photonBuffer), m_kernelRadius);
+		stageTimer.finish();
 
-		viewpoints = viewpointCollector.claimViewpoints();
-	}
-	
-	logger.log("size of viewpoint buffer: " + 
-		std::to_string(math::byte_to_MB<real>(sizeof(Viewpoint) * viewpoints.size())) + " MB");
+		passStatistics.photonMapBuildMs = static_cast<float64>(stageTimer.getDeltaUs()) / 1000.0;
 
-	const std::size_t numPhotonsPerPass = m_numPhotons;
+		if(m_usePhotonMapFile)
+		{
+			if(photonMap.save(m_photonMapFilePath, totalPhotonPaths, photonMapFileKey))
+			{
+				logger.log("photon map saved to <" + m_photonMapFilePath.toString() + ">");
+			}
+			else
+			{
+				logger.log(ELogLevel::WARNING_MED, 
+					"cannot save photon map to <" + m_photonMapFilePath.toString() + ">");
+			}
+		}
+	}
+	passStatistics.addPhotonMap(photonMap);
 
-	logger.log("number of photons per pass: " + std::to_string(numPhotonsPerPass));
-	logger.log("size of photon buffer: " 
-		+ std::to_string(math::byte_to_MB<real>(sizeof(Photon) * numPhotonsPerPass)) + " MB");
-	logger.log("start accumulating passes...");
+	logger.log("estimating radiance...");
 
-	std::mutex resultFilmMutex;
-	auto resultFilm = std::make_unique<HdrRgbFilm>(
-		getRenderWidthPx(), getRenderHeightPx(), getRenderWindowPx(), m_filter);
+	const std::size_t numGatherQueriesBefore   = m_statistics.asyncGetNumGatherQueries();
+	const std::size_t numGatheredPhotonsBefore = m_statistics.asyncGetNumGatheredPhotons();
+	stageTimer.start();
 
-	Timer passTimer;
-	std::size_t numFinishedPasses = 0;
-	std::size_t totalPhotonPaths  = 0;
-	while(numFinishedPasses < m_numPasses)
+	if(isDeterministic())
 	{
-		passTimer.start();
-		std::vector<Photon> photonBuffer(numPhotonsPerPass);
+		// Tiles do not depend on the number of workers and their film windows
+		// never overlap, so merging them in any order gives the same result.
+		std::vector<Region> tiles;
+		{
+			TileScheduler tileScheduler(
+				1, 
+				WorkUnit(getRenderWindowPx(), 1), 
+				Vector2S(DETERMINISTIC_TILE_SIZE_PX, DETERMINISTIC_TILE_SIZE_PX));
 
-		std::vector<std::size_t> numPhotonPaths(numWorkers(), 0);
-		parallel_work(numPhotonsPerPass, numWorkers(),
-			[this, &photonBuffer, &numPhotonPaths](
-				const std::size_t workerIdx, 
-				const std::size_t workStart, 
+			WorkUnit tile;
+			while(tileScheduler.schedule(&tile))
+			{
+				tiles.push_back(tile.getRegion());
+			}
+		}
+
+		for(std::size_t sampleIndex = 0; sampleIndex < m_numSamplesPerPixel; ++sampleIndex)
+		{
+			parallel_for(0, tiles.size(),
+				[this, &photonMap, &tiles, totalPhotonPaths, sampleIndex](
+					const std::size_t tileBegin,
+					const std::size_t tileEnd)
+				{
+					for(std::size_t tileIndex = tileBegin; tileIndex < tileEnd; ++tileIndex)
+					{
+						Random::keyThisThread(VIEWPOINT_TRACING_KEY, sampleIndex, tileIndex);
+
+						auto sampleGenerator = m_sg->genCopied(1);
+						auto film            = std::make_unique<HdrRgbFilm>(
+							getRenderWidthPx(), getRenderHeightPx(), tiles[tileIndex], m_filter);
+
+						// samples outside the tile also contribute to it
+						const TAABB2D<float64>& sampleWindowPx = film->getSampleWindowPx();
+						const Region sampleRegionPx(
+							TVector2<int64>(sampleWindowPx.minVertex.floor()),
+							TVector2<int64>(sampleWindowPx.maxVertex.ceil()));
+
+						RadianceEvaluator evaluator(
+							&photonMap, 
+							totalPhotonPaths, 
+							film.get(), 
+							m_scene);
+						evaluator.setPMRenderer(this);
+						evaluator.setKernelRadius(m_kernelRadius);
+
+						TViewPathTracingWork<RadianceEvaluator> radianceEvaluator(
+							&evaluator,
+							m_scene,
+							m_camera,
+							sampleGenerator.get(),
+							sampleRegionPx,
+							{getRenderWidthPx(), getRenderHeightPx()});
+
+						radianceEvaluator.work();
+
+						m_statistics.asyncAddGatherQueries(evaluator.numGatherQueries(), evaluator.numGatheredPhotons());
+					}
+				});
+
+			m_statistics.asyncIncrementNumIterations();
+		}
+	}
+	else
+	{
+		parallel_work(m_numSamplesPerPixel, numWorkers(),
+			[this, &photonMap, totalPhotonPaths](
+				const std::size_t workerIdx,
+				const std::size_t workStart,
 				const std::size_t workEnd)
 			{
-				auto sampleGenerator = m_sg->genCopied(1);
+				auto sampleGenerator = m_sg->genCopied(workEnd - workStart);
+				auto film            = std::make_unique<HdrRgbFilm>(
+					getRenderWidthPx(), getRenderHeightPx(), getRenderWindowPx(), m_filter);
+
+				RadianceEvaluator evaluator(
+					&photonMap,
+					totalPhotonPaths,
+					film.get(),
+					m_scene);
+				evaluator.setPMRenderer(this);
+				evaluator.setPMStatistics(&m_statistics);
+				evaluator.setKernelRadius(m_kernelRadius);
 
-				TPhotonMappingWork<Photon> photonMappingWork(
+				TViewPathTracingWork<RadianceEvaluator> radianceEvaluator(
+					&evaluator,
 					m_scene,
 					m_camera,
 					sampleGenerator.get(),
-					&(photonBuffer[workStart]),
-					workEnd - workStart,
-					&(numPhotonPaths[workerIdx]));
-				photonMappingWork.setPMStatistics(&m_statistics);
+					getRenderWindowPx(),
+					{getRenderWidthPx(), getRenderHeightPx()});
+
+				radianceEvaluator.work();
 
-				photonMappingWork.work();
+				m_statistics.asyncAddGatherQueries(evaluator.numGatherQueries(), evaluator.numGatheredPhotons());
 			});
-		totalPhotonPaths = std::accumulate(numPhotonPaths.begin(), numPhotonPaths.end(), totalPhotonPaths);
+	}
 
-		TPhotonMap<Photon> photonMap(2, TPhotonCenterCalculator<Photon>());
-		photonMap.build(std::move(photonBuffer));
+	stageTimer.finish();
 
-		parallel_work(viewpoints.size(), numWorkers(),
-			[this, &photonMap, &viewpoints, &resultFilm, &resultFilmMutex, totalPhotonPaths](
-				const std::size_t workerIdx, 
-				const std::size_t workStart, 
-				const std::size_t workEnd)
-			{
-				auto film = std::make_unique<HdrRgbFilm>(
-					getRenderWidthPx(), getRenderHeightPx(), getRenderWindowPx(), m_filter);
+	passStatistics.radianceEvaluationMs = static_cast<float64>(stageTimer.getDeltaUs()) / 1000.0;
+	passStatistics.numGatherQueries     = m_statistics.asyncGetNumGatherQueries() - numGatherQueriesBefore;
+	passStatistics.numGatheredPhotons   = m_statistics.asyncGetNumGatheredPhotons() - numGatheredPhotonsBefore;
+	recordPass(passStatistics);
+}
 
-				PPMRadianceEvaluationWork radianceEstimator(
-					&photonMap, 
-					totalPhotonPaths,
-					film.get(),
-					&(viewpoints[workStart]),
-					workEnd - workStart,
-					m_scene);
-				radianceEstimator.setPMStatistics(&m_statistics);
+template<typename Photon, typename Viewpoint>
+void PMRenderer::renderWithProgressivePM()
+{
+	using RadianceEvaluator = TPPMRadianceEvaluationWork<Photon, Viewpoint>;
+
+	logger.log("photon size: " + std::to_string(sizeof(Photon)) + " bytes");
+	logger.log("viewpoint size: " + std::to_string(sizeof(Viewpoint)) + " bytes");
+
+	const Region      renderWindowPx = getRenderWindowPx();
+	const std::size_t windowWidthPx  = static_cast<std::size_t>(renderWindowPx.getWidth());
+	const std::size_t windowHeightPx = static_cast<std::size_t>(renderWindowPx.getHeight());
+
+	// Films of a band also record contributions of its viewpoints to the
+	// neighboring rows the filter reaches.
+	const int64 filterExtentPx = static_cast<int64>(std::ceil(m_filter.getHalfSizePx().y));
+
+	// Without a memory budget, all viewpoints of the image are gathered at
+	// once and each pass traces all photons at once.
+	std::size_t numPhotonsPerPass = m_numPhotons;
+	std::size_t numPasses         = m_numPasses;
+	std::size_t bandHeightPx      = windowHeightPx;
+	if(m_memoryBudgetMB > 0)
+	{
+		const std::size_t budgetBytes    = m_memoryBudgetMB * 1024 * 1024;
+		const std::size_t bytesPerPhoton = sizeof(Photon) + sizeof(Vector3R);
+
+		// Photons take at most half of the budget. A pass with more photons is
+		// split into passes with fewer photons, which are equally valid 
+		// refinements of the viewpoints.
+		const std::size_t maxPhotonsPerPass = std::max(budgetBytes / 2 / bytesPerPhoton, std::size_t(1));
+		if(numPhotonsPerPass > maxPhotonsPerPass)
+		{
+			const std::size_t numSplits = math::ceil_div_positive(numPhotonsPerPass, maxPhotonsPerPass);
+			numPhotonsPerPass = math::ceil_div_positive(m_numPhotons, numSplits);
+			numPasses         = m_numPasses * numSplits;
+		}
+
+		// The rest is for viewpoints, estimated as one for each sample, and 
+		// films of the band: the band's result, what finished bands added to 
+		// it, and one for each worker unless rendering deterministically. The 
+		// image is processed in bands of rows, with viewpoints and films of a 
+		// single band resident at a time.
+		const std::size_t numBandFilms    = 2 + (isDeterministic() ? 0 : numWorkers());
+		const std::size_t filmBytesPerRow = numBandFilms * sizeof(RadianceSensor) * windowWidthPx;
+		const std::size_t bandBytesPerRow = std::max(
+			sizeof(Viewpoint) * m_numSamplesPerPixel * windowWidthPx + filmBytesPerRow, std::size_t(1));
+		const std::size_t fixedBytes      = 
+			numPhotonsPerPass * bytesPerPhoton + filmBytesPerRow * 2 * static_cast<std::size_t>(filterExtentPx);
+		const std::size_t bandBudgetBytes = budgetBytes - std::min(fixedBytes, budgetBytes);
+		bandHeightPx = math::clamp(bandBudgetBytes / bandBytesPerRow, std::size_t(1), windowHeightPx);
+	}
 
-				radianceEstimator.work();
+	const std::size_t numBands = math::ceil_div_positive(windowHeightPx, bandHeightPx);
+	m_numPlannedIterations.store(numBands * numPasses, std::memory_order_relaxed);
 
+	logger.log("number of photons per pass: " + std::to_string(numPhotonsPerPass));
+	logger.log("size of photon buffer: " 
+		+ std::to_string(math::byte_to_MB<real>(sizeof(Photon) * numPhotonsPerPass)) + " MB");
+	if(numBands > 1)
+	{
+		logger.log("rendering in " + std::to_string(numBands) + " bands of " + 
+			std::to_string(bandHeightPx) + " rows, " + std::to_string(numPasses) + " passes each");
+	}
+
+	for(std::size_t bandIndex = 0; bandIndex < numBands; ++bandIndex)
+	{
+		Region bandRegionPx = renderWindowPx;
+		bandRegionPx.minVertex.y = renderWindowPx.minVertex.y + static_cast<int64>(bandIndex * bandHeightPx);
+		bandRegionPx.maxVertex.y = std::min(
+			bandRegionPx.minVertex.y + static_cast<int64>(bandHeightPx), renderWindowPx.maxVertex.y);
+
+		Region bandFilmWindowPx = bandRegionPx;
+		bandFilmWindowPx.minVertex.y = std::max(bandRegionPx.minVertex.y - filterExtentPx, renderWindowPx.minVertex.y);
+		bandFilmWindowPx.maxVertex.y = std::min(bandRegionPx.maxVertex.y + filterExtentPx, renderWindowPx.maxVertex.y);
+
+		std::mutex resultFilmMutex;
+		auto resultFilm = std::make_unique<HdrRgbFilm>(
+			getRenderWidthPx(), getRenderHeightPx(), bandFilmWindowPx, m_filter);
+
+		// final radiance that finished bands added to pixels of this band's film
+		std::unique_ptr<HdrRgbFilm> finishedBandsFilm;
+		if(bandIndex > 0)
+		{
+			finishedBandsFilm = std::make_unique<HdrRgbFilm>(
+				getRenderWidthPx(), getRenderHeightPx(), bandFilmWindowPx, m_filter);
+
+			std::lock_guard<std::mutex> lock(m_filmMutex);
+
+			finishedBandsFilm->mergeWith(*m_film);
+		}
+
+		logger.log("start gathering viewpoints...");
+
+		// Viewpoints are gathered for fixed tiles of the band in parallel. 
+		// Each tile keeps its own viewpoints, which later stages work on 
+		// directly, so they are never merged into a single buffer.
+		std::vector<Region> tiles;
+		{
+			TileScheduler tileScheduler(
+				1, 
+				WorkUnit(bandRegionPx, 1), 
+				Vector2S(DETERMINISTIC_TILE_SIZE_PX, DETERMINISTIC_TILE_SIZE_PX));
+
+			WorkUnit tile;
+			while(tileScheduler.schedule(&tile))
+			{
+				tiles.push_back(tile.getRegion());
+			}
+		}
+
+		std::vector<std::vector<Viewpoint>> tileViewpoints(tiles.size());
+		parallel_for(0, tiles.size(),
+			[this, &tiles, &tileViewpoints, bandIndex](
+				const std::size_t tileBegin,
+				const std::size_t tileEnd)
+			{
+				for(std::size_t tileIndex = tileBegin; tileIndex < tileEnd; ++tileIndex)
 				{
-					std::lock_guard<std::mutex> lock(resultFilmMutex);
+					using ViewpointCollector = TPPMViewpointCollector<Viewpoint>;
+					ViewpointCollector viewpointCollector(6, m_kernelRadius);
 
-					resultFilm->mergeWith(*film);
+					if(isDeterministic())
+					{
+						Random::keyThisThread(VIEWPOINT_TRACING_KEY, bandIndex, tileIndex);
+					}
+
+					auto viewpointSampleGenerator = m_sg->genCopied(m_numSamplesPerPixel);
+
+					TViewPathTracingWork<ViewpointCollector> viewpointWork(
+						&viewpointCollector,
+						m_scene, 
+						m_camera, 
+						viewpointSampleGenerator.get(),
+						tiles[tileIndex],
+						{getRenderWidthPx(), getRenderHeightPx()});
+
+					viewpointWork.work();
+
+					tileViewpoints[tileIndex] = viewpointCollector.claimViewpoints();
 				}
 			});
 
-		asyncReplaceFilm(*resultFilm);
-		resultFilm->clear();
+		std::size_t numViewpoints = 0;
+		for(const auto& viewpoints : tileViewpoints)
+		{
+			numViewpoints += viewpoints.size();
+		}
+	
+		logger.log("size of viewpoint buffer: " + 
+			std::to_string(math::byte_to_MB<real>(sizeof(Viewpoint) * numViewpoints)) + " MB");
 
-		passTimer.finish();
+		// In adaptive mode, photons are traced towards viewpoints of the band.
+		PMVisibilityGrid visibilityGrid;
+		if(m_mode == EPMMode::ADAPTIVE_PROGRESSIVE)
+		{
+			std::vector<Vector3R> viewpointPositions;
+			viewpointPositions.reserve(numViewpoints);
+			for(const auto& viewpoints : tileViewpoints)
+			{
+				for(const Viewpoint& viewpoint : viewpoints)
+				{
+					viewpointPositions.push_back(viewpoint.template get<EViewpointData::SURFACE_HIT>().getPosition());
+				}
+			}
 
-		const real passTimeMs   = static_cast<real>(passTimer.getDeltaMs());
-		const real photonsPerMs = passTimeMs != 0 ? static_cast<real>(numPhotonsPerPass) / passTimeMs : 0;
-		m_photonsPerSecond.store(static_cast<std::uint32_t>(photonsPerMs * 1000 + 0.5_r), std::memory_order_relaxed);
+			visibilityGrid.build(std::move(viewpointPositions), m_kernelRadius);
+		}
 
-		m_statistics.asyncIncrementNumIterations();
-		++numFinishedPasses;
-	}// end while more pass needed
+		logger.log("start accumulating passes...");
+
+		// Every band uses photons of the same pass indices; in deterministic 
+		// and non-adaptive mode they are the same photons.
+		Timer passTimer;
+		std::size_t numFinishedPasses = 0;
+		std::size_t totalPhotonPaths  = 0;
+		while(numFinishedPasses < numPasses)
+		{
+			passTimer.start();
+			std::vector<Photon> photonBuffer(numPhotonsPerPass);
+			totalPhotonPaths += tracePhotons(
+				photonBuffer,
+				numFinishedPasses,
+				m_mode == EPMMode::ADAPTIVE_PROGRESSIVE ? &visibilityGrid : nullptr);
+
+			PMPassStatistics passStatistics;
+			Timer            stageTimer;
+
+			stageTimer.start();
+			TPhotonMap<Photon> photonMap(m_photonMapType);
+			photonMap.build(std::move(photonBuffer), m_kernelRadius);
+			stageTimer.finish();
+
+			passStatistics.photonMapBuildMs = static_cast<float64>(stageTimer.getDeltaUs()) / 1000.0;
+			passStatistics.addPhotonMap(photonMap);
+
+			const std::size_t numGatherQueriesBefore   = m_statistics.asyncGetNumGatherQueries();
+			const std::size_t numGatheredPhotonsBefore = m_statistics.asyncGetNumGatheredPhotons();
+			stageTimer.start();
+
+			if(isDeterministic())
+			{
+				// Viewpoints are independent of each other; only adding them to 
+				// the film needs a fixed order.
+				parallel_for(0, tileViewpoints.size(),
+					[this, &photonMap, &tileViewpoints, totalPhotonPaths](
+						const std::size_t tileBegin, 
+						const std::size_t tileEnd)
+					{
+						for(std::size_t tileIndex = tileBegin; tileIndex < tileEnd; ++tileIndex)
+						{
+							RadianceEvaluator radianceEstimator(
+								&photonMap, 
+								totalPhotonPaths,
+								nullptr,
+								tileViewpoints[tileIndex].data(),
+								tileViewpoints[tileIndex].size(),
+								m_scene);
+							radianceEstimator.setPMStatistics(&m_statistics);
+
+							radianceEstimator.work();
+						}
+					});
+
+				for(auto& viewpoints : tileViewpoints)
+				{
+					RadianceEvaluator(
+						&photonMap, 
+						totalPhotonPaths,
+						nullptr,
+						viewpoints.data(),
+						viewpoints.size(),
+						m_scene).splatRadiance(*resultFilm);
+				}
+			}
+			else
+			{
+				parallel_work(tileViewpoints.size(), numWorkers(),
+					[this, &photonMap, &tileViewpoints, &resultFilm, &resultFilmMutex, &bandFilmWindowPx, totalPhotonPaths](
+						const std::size_t workerIdx, 
+						const std::size_t workStart, 
+						const std::size_t workEnd)
+					{
+						auto film = std::make_unique<HdrRgbFilm>(
+							getRenderWidthPx(), getRenderHeightPx(), bandFilmWindowPx, m_filter);
+
+						for(std::size_t tileIndex = workStart; tileIndex < workEnd; ++tileIndex)
+						{
+							RadianceEvaluator radianceEstimator(
+								&photonMap, 
+								totalPhotonPaths,
+								film.get(),
+								tileViewpoints[tileIndex].data(),
+								tileViewpoints[tileIndex].size(),
+								m_scene);
+							radianceEstimator.setPMStatistics(&m_statistics);
+
+							radianceEstimator.work();
+						}
+
+						{
+							std::lock_guard<std::mutex> lock(resultFilmMutex);
+
+							resultFilm->mergeWith(*film);
+						}
+					});
+			}
+			stageTimer.finish();
+
+			passStatistics.radianceEvaluationMs = static_cast<float64>(stageTimer.getDeltaUs()) / 1000.0;
+			passStatistics.numGatherQueries     = m_statistics.asyncGetNumGatherQueries() - numGatherQueriesBefore;
+			passStatistics.numGatheredPhotons   = m_statistics.asyncGetNumGatheredPhotons() - numGatheredPhotonsBefore;
+			passStatistics.viewpointBytes       = sizeof(Viewpoint) * numViewpoints;
+			for(const auto& viewpoints : tileViewpoints)
+			{
+				for(const Viewpoint& viewpoint : viewpoints)
+				{
+					passStatistics.addRadius(viewpoint.template get<EViewpointData::RADIUS>(), m_kernelRadius);
+				}
+			}
+			recordPass(passStatistics);
+
+			// only the part of the film this band covers is replaced
+			if(finishedBandsFilm)
+			{
+				resultFilm->mergeWith(*finishedBandsFilm);
+			}
+			asyncReplaceFilm(*resultFilm);
+
+			passTimer.finish();
+
+			const real passTimeMs   = static_cast<real>(passTimer.getDeltaMs());
+			const real photonsPerMs = passTimeMs != 0 ? static_cast<real>(numPhotonsPerPass) / passTimeMs : 0;
+			m_photonsPerSecond.store(static_cast<std::uint32_t>(photonsPerMs * 1000 + 0.5_r), std::memory_order_relaxed);
+
+			m_statistics.asyncIncrementNumIterations();
+			++numFinishedPasses;
+
+			resultFilm->clear();
+		}// end while more pass needed
+	}// end for each band
 }
 
+template<typename Photon, typename Viewpoint>
 void PMRenderer::renderWithStochasticProgressivePM()
 {
-	using Photon    = FullPhoton;
-	using Viewpoint = FullViewpoint;
-
 	logger.log("photon size: " + std::to_string(sizeof(Photon)) + " bytes");
 	logger.log("viewpoint size: " + std::to_string(sizeof(Viewpoint)) + " bytes");
 
@@ -297,46 +803,79 @@ void PMRenderer::renderWithStochasticProgressivePM()
 		+ std::to_string(math::byte_to_MB<real>(sizeof(Photon) * numPhotonsPerPass)) + " MB");
 	logger.log("start accumulating passes...");
 
-	std::mutex resultFilmMutex;
 	auto resultFilm = std::make_unique<HdrRgbFilm>(
 		getRenderWidthPx(), getRenderHeightPx(), getRenderWindowPx(), m_filter);
 
+	// Photons of a pass only depend on the pass index. In pipelined mode, 
+	// photons of the next pass are traced (and their map built) while the 
+	// current pass is being evaluated, using two photon maps in turn.
+	const auto preparePhotonMap = [this, numPhotonsPerPass](
+		const std::size_t   passIndex, 
+		TPhotonMap<Photon>& out_photonMap,
+		float64* const      out_buildMs) -> std::size_t
+	{
+		std::vector<Photon> photonBuffer(numPhotonsPerPass);
+		const std::size_t numPhotonPaths = tracePhotons(photonBuffer, passIndex);
+
+		Timer buildTimer;
+		buildTimer.start();
+		out_photonMap.build(std::move(photonBuffer), m_kernelRadius);
+		buildTimer.finish();
+
+		*out_buildMs = static_cast<float64>(buildTimer.getDeltaUs()) / 1000.0;
+		return numPhotonPaths;
+	};
+
+	TPhotonMap<Photon> photonMap(m_photonMapType);
+	TPhotonMap<Photon> nextPhotonMap(m_photonMapType);
+	std::size_t        numNextPhotonPaths = 0;
+	float64            nextBuildMs        = 0;
+	TaskGroup          nextPassPreparation;
+	if(m_isPipelined && m_numPasses > 0)
+	{
+		logger.log("pipelining passes");
+
+		numNextPhotonPaths = preparePhotonMap(0, nextPhotonMap, &nextBuildMs);
+	}
+
 	Timer passTimer;
 	std::size_t numFinishedPasses = 0;
 	std::size_t totalPhotonPaths  = 0;
 	while(numFinishedPasses < m_numPasses)
 	{
 		passTimer.start();
-		std::vector<Photon> photonBuffer(numPhotonsPerPass);
 
-		std::vector<std::size_t> numPhotonPaths(numWorkers(), 0);
-		parallel_work(numPhotonsPerPass, numWorkers(),
-			[this, &photonBuffer, &numPhotonPaths](
-				const std::size_t workerIdx, 
-				const std::size_t workStart, 
-				const std::size_t workEnd)
-			{
-				auto sampleGenerator = m_sg->genCopied(1);
+		PMPassStatistics passStatistics;
+		if(m_isPipelined)
+		{
+			std::swap(photonMap, nextPhotonMap);
+			totalPhotonPaths += numNextPhotonPaths;
+			passStatistics.photonMapBuildMs = nextBuildMs;
 
-				TPhotonMappingWork<Photon> photonMappingWork(
-					m_scene,
-					m_camera,
-					sampleGenerator.get(),
-					&(photonBuffer[workStart]),
-					workEnd - workStart,
-					&(numPhotonPaths[workerIdx]));
-				photonMappingWork.setPMStatistics(&m_statistics);
+			if(numFinishedPasses + 1 < m_numPasses)
+			{
+				nextPassPreparation.run(
+					[&preparePhotonMap, &nextPhotonMap, &numNextPhotonPaths, &nextBuildMs, 
+					 nextPassIndex = numFinishedPasses + 1]()
+					{
+						numNextPhotonPaths = preparePhotonMap(nextPassIndex, nextPhotonMap, &nextBuildMs);
+					});
+			}
+		}
+		else
+		{
+			totalPhotonPaths += preparePhotonMap(numFinishedPasses, photonMap, &(passStatistics.photonMapBuildMs));
+		}
+		passStatistics.addPhotonMap(photonMap);
 
-				photonMappingWork.work();
-			});
-		totalPhotonPaths = std::accumulate(numPhotonPaths.begin(), numPhotonPaths.end(), totalPhotonPaths);
+		const std::size_t numGatherQueriesBefore   = m_statistics.asyncGetNumGatherQueries();
+		const std::size_t numGatheredPhotonsBefore = m_statistics.asyncGetNumGatheredPhotons();
 
-		TPhotonMap<Photon> photonMap(2, TPhotonCenterCalculator<Photon>());
-		photonMap.build(std::move(photonBuffer));
+		Timer evaluationTimer;
+		evaluationTimer.start();
 
-		parallel_work(getRenderWidthPx(), numWorkers(),
-			[this, &photonMap, &viewpoints, &resultFilm, &resultFilmMutex, totalPhotonPaths, numFinishedPasses](
-				const std::size_t workerIdx, 
+		const auto evaluateColumns = 
+			[this, &photonMap, &viewpoints, &resultFilm, totalPhotonPaths, numFinishedPasses](
 				const std::size_t workStart, 
 				const std::size_t workEnd)
 			{
@@ -358,6 +897,7 @@ void PMRenderer::renderWithStochasticProgressivePM()
 					region,
 					numFinishedPasses + 1,
 					6);
+				radianceEvaluator.setPMStatistics(&m_statistics);
 
 				TViewPathTracingWork<RadianceEvaluator> viewpointWork(
 					&radianceEvaluator,
@@ -368,11 +908,55 @@ void PMRenderer::renderWithStochasticProgressivePM()
 					{getRenderWidthPx(), getRenderHeightPx()});
 
 				viewpointWork.work();
-			});
+			};
+
+		if(isDeterministic())
+		{
+			// columns are split into fixed chunks, each with its own keyed randomness
+			const std::size_t numColumnChunks = math::ceil_div_positive<std::size_t>(
+				getRenderWidthPx(), SPPM_COLUMN_CHUNK_SIZE);
+
+			parallel_for(0, numColumnChunks,
+				[this, &evaluateColumns, numFinishedPasses](
+					const std::size_t chunkBegin, 
+					const std::size_t chunkEnd)
+				{
+					for(std::size_t chunkIndex = chunkBegin; chunkIndex < chunkEnd; ++chunkIndex)
+					{
+						Random::keyThisThread(VIEWPOINT_TRACING_KEY, numFinishedPasses, chunkIndex);
+
+						const std::size_t workStart = chunkIndex * SPPM_COLUMN_CHUNK_SIZE;
+						evaluateColumns(
+							workStart, 
+							std::min(workStart + SPPM_COLUMN_CHUNK_SIZE, static_cast<std::size_t>(getRenderWidthPx())));
+					}
+				});
+		}
+		else
+		{
+			// Cost of columns varies a lot with scene content, so they are handed 
+			// out dynamically rather than split evenly among workers.
+			parallel_for(0, getRenderWidthPx(), SPPM_COLUMN_CHUNK_SIZE, evaluateColumns);
+		}
+		evaluationTimer.finish();
+
+		passStatistics.radianceEvaluationMs = static_cast<float64>(evaluationTimer.getDeltaUs()) / 1000.0;
+		passStatistics.numGatherQueries     = m_statistics.asyncGetNumGatherQueries() - numGatherQueriesBefore;
+		passStatistics.numGatheredPhotons   = m_statistics.asyncGetNumGatheredPhotons() - numGatheredPhotonsBefore;
+		passStatistics.viewpointBytes       = sizeof(Viewpoint) * viewpoints.size();
+		for(const Viewpoint& viewpoint : viewpoints)
+		{
+			passStatistics.addRadius(viewpoint.template get<EViewpointData::RADIUS>(), m_kernelRadius);
+		}
+		recordPass(passStatistics);
 
 		asyncReplaceFilm(*resultFilm);
 		resultFilm->clear();
 
+		// photons of the next pass must be ready before it starts (the calling
+		// thread helps if they are not)
+		nextPassPreparation.wait();
+
 		passTimer.finish();
 
 		const real passTimeMs   = static_cast<real>(passTimer.getDeltaMs());
@@ -384,6 +968,215 @@ void PMRenderer::renderWithStochasticProgressivePM()
 	}// end while more pass needed
 }
 
+void PMRenderer::renderWithVCM()
+{
+	const Region      renderWindowPx = getRenderWindowPx();
+	const std::size_t windowWidthPx  = static_cast<std::size_t>(renderWindowPx.getWidth());
+	const std::size_t windowHeightPx = static_cast<std::size_t>(renderWindowPx.getHeight());
+
+	// one light sub-path for each camera sub-path
+	const std::size_t numLightPaths = windowWidthPx * windowHeightPx;
+	if(numLightPaths == 0)
+	{
+		return;
+	}
+
+	logger.log("number of light sub-paths per pass: " + std::to_string(numLightPaths));
+
+	auto resultFilm = std::make_unique<HdrRgbFilm>(
+		getRenderWidthPx(), getRenderHeightPx(), renderWindowPx, m_filter);
+
+	const std::size_t numLightPathChunks = math::ceil_div_positive(numLightPaths, VCM_LIGHT_PATH_CHUNK_SIZE);
+	const std::size_t numColumnChunks    = math::ceil_div_positive(windowWidthPx, VCM_COLUMN_CHUNK_SIZE);
+
+	// Column films also cover pixels the filter reaches from their columns, 
+	// so merging them does not leave seams.
+	const int64 filterExtentPx = static_cast<int64>(std::ceil(m_filter.getHalfSizePx().x));
+
+	Timer passTimer;
+	for(std::size_t passIndex = 0; passIndex < m_numPasses; ++passIndex)
+	{
+		passTimer.start();
+
+		const real mergeRadius = m_kernelRadius * 
+			std::pow(static_cast<real>(passIndex + 1), -0.5_r * (1.0_r - VCM_RADIUS_ALPHA));
+		const VCMParameters parameters(mergeRadius, numLightPaths);
+
+		// Light sub-paths are traced in fixed chunks; vertices of a chunk are 
+		// in path order, and so are the chunks.
+		std::vector<std::vector<VCMLightVertex>> chunkLightVertices(numLightPathChunks);
+		std::vector<std::vector<std::size_t>>    chunkPathVertexEnds(numLightPathChunks);
+		parallel_for(0, numLightPathChunks,
+			[this, &parameters, &chunkLightVertices, &chunkPathVertexEnds, numLightPaths, passIndex](
+				const std::size_t chunkBegin,
+				const std::size_t chunkEnd)
+			{
+				for(std::size_t chunkIndex = chunkBegin; chunkIndex < chunkEnd; ++chunkIndex)
+				{
+					if(isDeterministic())
+					{
+						Random::keyThisThread(PHOTON_TRACING_KEY, passIndex, chunkIndex);
+					}
+
+					const std::size_t pathBegin = chunkIndex * VCM_LIGHT_PATH_CHUNK_SIZE;
+					const std::size_t pathEnd   = std::min(pathBegin + VCM_LIGHT_PATH_CHUNK_SIZE, numLightPaths);
+
+					VCMLightPathWork lightPathWork(
+						m_scene,
+						parameters,
+						pathEnd - pathBegin,
+						&(chunkLightVertices[chunkIndex]),
+						&(chunkPathVertexEnds[chunkIndex]));
+					lightPathWork.setPMStatistics(&m_statistics);
+
+					lightPathWork.work();
+				}
+			});
+
+		std::vector<VCMLightVertex> lightVertices;
+		std::vector<std::size_t>    pathVertexEnds;
+		pathVertexEnds.reserve(numLightPaths);
+		for(std::size_t chunkIndex = 0; chunkIndex < numLightPathChunks; ++chunkIndex)
+		{
+			const std::size_t vertexOffset = lightVertices.size();
+			for(const std::size_t pathVertexEnd : chunkPathVertexEnds[chunkIndex])
+			{
+				pathVertexEnds.push_back(vertexOffset + pathVertexEnd);
+			}
+
+			lightVertices.insert(lightVertices.end(), 
+				chunkLightVertices[chunkIndex].begin(), chunkLightVertices[chunkIndex].end());
+			chunkLightVertices[chunkIndex] = std::vector<VCMLightVertex>();
+		}
+
+		std::vector<VCMPhoton> photonBuffer(lightVertices.size());
+		std::transform(lightVertices.begin(), lightVertices.end(), photonBuffer.begin(),
+			[](const VCMLightVertex& lightVertex)
+			{
+				return lightVertex.toPhoton();
+			});
+
+		const std::size_t numLightVertices = lightVertices.size();
+
+		PMPassStatistics passStatistics;
+		Timer            stageTimer;
+
+		stageTimer.start();
+		TPhotonMap<VCMPhoton> photonMap(m_photonMapType);
+		photonMap.build(std::move(photonBuffer), mergeRadius);
+		stageTimer.finish();
+
+		passStatistics.photonMapBuildMs = static_cast<float64>(stageTimer.getDeltaUs()) / 1000.0;
+		passStatistics.addPhotonMap(photonMap);
+		passStatistics.addRadius(mergeRadius, m_kernelRadius);
+
+		stageTimer.start();
+
+		// each column chunk has a film of its own, merged in a fixed order
+		std::vector<std::unique_ptr<HdrRgbFilm>> columnFilms(numColumnChunks);
+		parallel_for(0, numColumnChunks,
+			[this, &parameters, &photonMap, &lightVertices, &pathVertexEnds, &columnFilms, 
+			 &renderWindowPx, numLightPaths, windowHeightPx, filterExtentPx, passIndex](
+				const std::size_t chunkBegin,
+				const std::size_t chunkEnd)
+			{
+				for(std::size_t chunkIndex = chunkBegin; chunkIndex < chunkEnd; ++chunkIndex)
+				{
+					if(isDeterministic())
+					{
+						Random::keyThisThread(VIEWPOINT_TRACING_KEY, passIndex, chunkIndex);
+					}
+
+					Region region = renderWindowPx;
+					region.minVertex.x = renderWindowPx.minVertex.x + static_cast<int64>(chunkIndex * VCM_COLUMN_CHUNK_SIZE);
+					region.maxVertex.x = std::min(
+						region.minVertex.x + static_cast<int64>(VCM_COLUMN_CHUNK_SIZE), renderWindowPx.maxVertex.x);
+
+					Region filmWindowPx = region;
+					filmWindowPx.minVertex.x = std::max(region.minVertex.x - filterExtentPx, renderWindowPx.minVertex.x);
+					filmWindowPx.maxVertex.x = std::min(region.maxVertex.x + filterExtentPx, renderWindowPx.maxVertex.x);
+
+					auto sampleGenerator = m_sg->genCopied(1);
+					auto film            = std::make_unique<HdrRgbFilm>(
+						getRenderWidthPx(), getRenderHeightPx(), filmWindowPx, m_filter);
+
+					VCMCameraPathWork cameraPathWork(
+						m_scene,
+						m_camera,
+						sampleGenerator.get(),
+						parameters,
+						&photonMap,
+						lightVertices.data(),
+						pathVertexEnds.data(),
+						numLightPaths,
+						static_cast<std::size_t>(region.minVertex.x - renderWindowPx.minVertex.x) * windowHeightPx,
+						film.get(),
+						region,
+						{getRenderWidthPx(), getRenderHeightPx()});
+
+					cameraPathWork.work();
+
+					columnFilms[chunkIndex] = std::move(film);
+				}
+			});
+
+		for(const auto& columnFilm : columnFilms)
+		{
+			resultFilm->mergeWith(*columnFilm);
+		}
+		stageTimer.finish();
+
+		passStatistics.radianceEvaluationMs = static_cast<float64>(stageTimer.getDeltaUs()) / 1000.0;
+		recordPass(passStatistics);
+
+		asyncReplaceFilm(*resultFilm);
+
+		passTimer.finish();
+
+		const real passTimeMs   = static_cast<real>(passTimer.getDeltaMs());
+		const real photonsPerMs = passTimeMs != 0 ? static_cast<real>(numLightVertices) / passTimeMs : 0;
+		m_photonsPerSecond.store(static_cast<std::uint32_t>(photonsPerMs * 1000 + 0.5_r), std::memory_order_relaxed);
+
+		m_statistics.asyncIncrementNumIterations();
+	}// end for each pass
+}
+
+void PMRenderer::recordPass(const PMPassStatistics& passStatistics)
+{
+	m_statistics.asyncSetLastPass(passStatistics);
+
+	logger.log(
+		"pass: photon map built in " + std::to_string(passStatistics.photonMapBuildMs) + " ms (" + 
+		std::to_string(math::byte_to_MB<real>(passStatistics.photonMapBytes)) + " MB, " + 
+		std::to_string(passStatistics.numLeaves) + " leaves, max depth " + 
+		std::to_string(passStatistics.maxLeafDepth) + "); radiance evaluated in " + 
+		std::to_string(passStatistics.radianceEvaluationMs) + " ms (" + 
+		std::to_string(passStatistics.avgGatheredPhotons()) + " photons per query)");
+
+	if(passStatistics.numRadii > 0)
+	{
+		logger.log(
+			"pass: radius min/avg/max: " + 
+			std::to_string(passStatistics.minRadius) + "/" + 
+			std::to_string(passStatistics.avgRadius()) + "/" + 
+			std::to_string(passStatistics.maxRadius));
+	}
+
+	const auto toString = [](const PMPassStatistics::Histogram& histogram)
+	{
+		std::string result;
+		for(const std::size_t count : histogram)
+		{
+			result += " " + std::to_string(count);
+		}
+		return result;
+	};
+
+	logger.log(ELogLevel::DEBUG_MIN, "pass: leaf depth histogram:" + toString(passStatistics.leafDepthHistogram));
+	logger.log(ELogLevel::DEBUG_MIN, "pass: leaf size histogram:" + toString(passStatistics.leafSizeHistogram));
+	logger.log(ELogLevel::DEBUG_MIN, "pass: radius histogram:" + toString(passStatistics.radiusHistogram));
+}
+
 ERegionStatus PMRenderer::asyncPollUpdatedRegion(Region* const out_region)
 {
 	PH_ASSERT(out_region);
@@ -404,7 +1197,7 @@ ERegionStatus PMRenderer::asyncPollUpdatedRegion(Region* const out_region)
 RenderProgress PMRenderer::asyncQueryRenderProgress()
 {
 	return RenderProgress(
-		m_mode != EPMMode::VANILLA ? m_numPasses : m_numSamplesPerPixel, 
+		m_numPlannedIterations.load(std::memory_order_relaxed), 
 		m_statistics.asyncGetNumIterations(), 
 		0);
 }
@@ -438,6 +1231,23 @@ ObservableRenderData PMRenderer::getObservableData() const
 	data.setIntegerState(0, m_mode != EPMMode::VANILLA ? "finished passes" : "finished samples");
 	data.setIntegerState(1, "traced photons");
 	data.setIntegerState(2, "photons/second");
+	data.setIntegerState(3, "photon map (KB)");
+	data.setIntegerState(4, "viewpoints (KB)");
+	data.setIntegerState(5, "photon map leaves");
+	data.setIntegerState(6, "photon map depth (max.)");
+
+	// the following are of the latest pass
+	data.setRealState(0, "photon map build (ms)");
+	data.setRealState(1, "radiance evaluation (ms)");
+	data.setRealState(2, "photons/query (avg.)");
+	data.setRealState(3, "radius (min.)");
+	data.setRealState(4, "radius (avg.)");
+	data.setRealState(5, "radius (max.)");
+
+	// bins of the latest pass, the last bin also counts all larger values
+	data.setHistogram(0, "photon map leaf depth");
+	data.setHistogram(1, "photons per leaf");
+	data.setHistogram(2, "radius / initial radius");
 
 	return data;
 }
@@ -448,6 +1258,26 @@ RenderState PMRenderer::asyncQueryRenderState()
 	state.setIntegerState(0, m_statistics.asyncGetNumIterations());
 	state.setIntegerState(1, m_statistics.asyncGetNumTracedPhotons());
 	state.setIntegerState(2, static_cast<RenderState::IntegerState>(m_photonsPerSecond.load(std::memory_order_relaxed)));
+
+	const PMPassStatistics lastPass = m_statistics.asyncGetLastPass();
+	state.setIntegerState(3, static_cast<RenderState::IntegerState>(lastPass.photonMapBytes / 1024));
+	state.setIntegerState(4, static_cast<RenderState::IntegerState>(lastPass.viewpointBytes / 1024));
+	state.setIntegerState(5, static_cast<RenderState::IntegerState>(lastPass.numLeaves));
+	state.setIntegerState(6, static_cast<RenderState::IntegerState>(lastPass.maxLeafDepth));
+	state.setRealState(0, static_cast<RenderState::RealState>(lastPass.photonMapBuildMs));
+	state.setRealState(1, static_cast<RenderState::RealState>(lastPass.radianceEvaluationMs));
+	state.setRealState(2, static_cast<RenderState::RealState>(lastPass.avgGatheredPhotons()));
+	state.setRealState(3, static_cast<RenderState::RealState>(lastPass.numRadii > 0 ? lastPass.minRadius : 0.0_r));
+	state.setRealState(4, static_cast<RenderState::RealState>(lastPass.avgRadius()));
+	state.setRealState(5, static_cast<RenderState::RealState>(lastPass.maxRadius));
+
+	static_assert(PMPassStatistics::NUM_HISTOGRAM_BINS == RenderState::NUM_HISTOGRAM_BINS);
+	for(std::size_t i = 0; i < PMPassStatistics::NUM_HISTOGRAM_BINS; ++i)
+	{
+		state.setHistogramBin(0, i, static_cast<RenderState::HistogramBin>(lastPass.leafDepthHistogram[i]));
+		state.setHistogramBin(1, i, static_cast<RenderState::HistogramBin>(lastPass.leafSizeHistogram[i]));
+		state.setHistogramBin(2, i, static_cast<RenderState::HistogramBin>(lastPass.radiusHistogram[i]));
+	}
 	return state;
 }
 
@@ -467,7 +1297,7 @@ void PMRenderer::asyncReplaceFilm(const HdrRgbFilm& srcFilm)
 	{
 		std::lock_guard<std::mutex> lock(m_filmMutex);
 
-		m_film->clear();
+		m_film->clear(srcFilm.getEffectiveWindowPx());
 		m_film->mergeWith(srcFilm);
 	}
 
@@ -480,11 +1310,18 @@ PMRenderer::PMRenderer(const InputPacket& packet) :
 	Renderer(packet),
 	m_film(),
 	m_scene(nullptr),
+	m_sceneSignature(0),
 	m_camera(nullptr),
 	m_sg(nullptr),
 	m_filter(SampleFilters::createBlackmanHarrisFilter()),
 
 	m_mode(),
+	m_photonMapType(),
+	m_useCompactStorage(false),
+	m_isPipelined(false),
+	m_memoryBudgetMB(0),
+	m_usePhotonMapFile(false),
+	m_photonMapFilePath(),
 	m_numPhotons(),
 	m_kernelRadius(),
 	m_numPasses(),
@@ -502,15 +1339,49 @@ PMRenderer::PMRenderer(const InputPacket& packet) :
 	{
 		m_mode = EPMMode::PROGRESSIVE;
 	}
+	else if(mode == "adaptive-progressive")
+	{
+		m_mode = EPMMode::ADAPTIVE_PROGRESSIVE;
+	}
 	else if(mode == "stochastic-progressive")
 	{
 		m_mode = EPMMode::STOCHASTIC_PROGRESSIVE;
 	}
+	else if(mode == "vcm")
+	{
+		m_mode = EPMMode::VCM;
+	}
+
+	const std::string& photonMapType = packet.getString("photon-map", "kd-tree");
+	if(photonMapType == "kd-tree")
+	{
+		m_photonMapType = EPhotonMapType::KD_TREE;
+	}
+	else if(photonMapType == "hash-grid")
+	{
+		m_photonMapType = EPhotonMapType::HASH_GRID;
+	}
+
+	m_useCompactStorage = packet.getString("compact-storage", "false") == "true";
+	m_isPipelined       = packet.getString("pipelined", "false") == "true";
+	m_memoryBudgetMB    = get_size_input(packet, "memory-budget-mb", 0);
+
+	if(packet.hasString("photon-map-file"))
+	{
+		m_usePhotonMapFile  = true;
+		m_photonMapFilePath = packet.getStringAsPath("photon-map-file");
+
+		if(m_mode != EPMMode::VANILLA)
+		{
+			logger.log(ELogLevel::WARNING_MIN, 
+				"photon map file is only used in vanilla mode, ignored");
+		}
+	}
 
-	m_numPhotons = packet.getInteger("num-photons", 200000);
+	m_numPhotons = get_size_input(packet, "num-photons", 200000);
 	m_kernelRadius = packet.getReal("radius", 0.1_r);
-	m_numPasses = packet.getInteger("num-passes", 1);
-	m_numSamplesPerPixel = packet.getInteger("num-samples-per-pixel", 4);
+	m_numPasses = get_size_input(packet, "num-passes", 1);
+	m_numSamplesPerPixel = get_size_input(packet, "num-samples-per-pixel", 4);
 }
 
 SdlTypeInfo PMRenderer::ciTypeInfo()
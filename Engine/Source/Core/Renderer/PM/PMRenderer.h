@@ -4,7 +4,10 @@
 #include "Core/Filmic/HdrRgbFilm.h"
 #include "Core/Filmic/SampleFilter.h"
 #include "Core/Renderer/PM/EPMMode.h"
+#include "Core/Renderer/PM/EPhotonMapType.h"
 #include "Core/Renderer/PM/PMStatistics.h"
+#include "Core/Renderer/PM/PMPassStatistics.h"
+#include "FileIO/FileSystem/Path.h"
 
 #include <vector>
 #include <memory>
@@ -15,6 +18,8 @@
 namespace ph
 {
 
+class PMVisibilityGrid;
+
 class PMRenderer : public Renderer, public TCommandInterface<PMRenderer>
 {
 public:
@@ -33,17 +38,26 @@ public:
 	ObservableRenderData getObservableData() const override;
 
 	void asyncMergeFilm(const HdrRgbFilm& srcFilm);
+
+	// Replaces the part of the film covered by <srcFilm>.
 	void asyncReplaceFilm(const HdrRgbFilm& srcFilm);
 
 private:
 	std::unique_ptr<HdrRgbFilm> m_film;
 
 	const Scene*          m_scene;
+	uint64                m_sceneSignature;
 	const Camera*         m_camera;
 	SampleGenerator*      m_sg;
 	SampleFilter          m_filter;
 
 	EPMMode m_mode;
+	EPhotonMapType m_photonMapType;
+	bool m_useCompactStorage;
+	bool m_isPipelined;
+	std::size_t m_memoryBudgetMB;
+	bool m_usePhotonMapFile;
+	Path m_photonMapFilePath;
 	std::size_t m_numPhotons;
 	std::size_t m_numPasses;
 	std::size_t m_numSamplesPerPixel;
@@ -54,11 +68,42 @@ private:
 	PMStatistics m_statistics;
 	std::atomic_uint32_t m_photonsPerSecond;
 	std::atomic_bool     m_isFilmUpdated;
+	std::atomic_size_t   m_numPlannedIterations;
 
+	template<typename Photon>
 	void renderWithVanillaPM();
+
+	template<typename Photon, typename Viewpoint>
 	void renderWithProgressivePM();
+
+	template<typename Photon, typename Viewpoint>
 	void renderWithStochasticProgressivePM();
 
+	void renderWithVCM();
+
+	// Logs <passStatistics> and makes them the latest for render state queries.
+	void recordPass(const PMPassStatistics& passStatistics);
+
+	// Fills <photonBuffer> with photons and returns the number of photon
+	// paths traced. <passIndex> distinguishes passes in deterministic mode.
+	// With a <visibilityGrid>, photons are traced adaptively towards it and
+	// the returned count is the equivalent number of uniformly sampled paths;
+	// the buffer shrinks if not enough visible photons are found.
+	template<typename Photon>
+	std::size_t tracePhotons(
+		std::vector<Photon>&    photonBuffer, 
+		std::size_t             passIndex,
+		const PMVisibilityGrid* visibilityGrid = nullptr);
+
+	// Sizes of the fixed pieces work is split into in deterministic mode.
+	static constexpr std::size_t DETERMINISTIC_PHOTON_CHUNK_SIZE = 16384;
+	static constexpr std::size_t DETERMINISTIC_TILE_SIZE_PX      = 64;
+	static constexpr std::size_t SPPM_COLUMN_CHUNK_SIZE          = 8;
+
+	// Sizes of the pieces VCM passes are split into.
+	static constexpr std::size_t VCM_LIGHT_PATH_CHUNK_SIZE = 4096;
+	static constexpr std::size_t VCM_COLUMN_CHUNK_SIZE     = 16;
+
 // command interface
 public:
 	explicit PMRenderer(const InputPacket& packet);
@@ -87,8 +132,14 @@ public:
 			<description>
 				Photon mapping mode. "vanilla": directly compute energy values from photon map, no
 				fancy tricks applied; "progressive": progressively refine the rendered results;
+				"adaptive-progressive": progressive photon mapping with photons traced by a 
+				Markov chain that favors photon paths landing near viewpoints, which helps 
+				when most photons would land where the camera does not see; 
 				"stochastic-progressive": stochastic sampling technique is utilized for energy 
-				value computation.
+				value computation; "vcm": vertex connection and merging, which combines photon
+				mapping with bidirectional path tracing by multiple importance sampling. It is
+				progressive and traces one light sub-path and one camera sub-path per pixel in
+				each pass ("num-photons" and "num-samples-per-pixel" are not used).
 			</description>
 		</input>
 		<input name="num-photons" type="integer">
@@ -113,6 +164,45 @@ public:
 				consume large amounts of memory.
 			</description>
 		</input>
+		<input name="photon-map" type="string">
+			<description>
+				Spatial structure for finding photons. "kd-tree": a kd-tree, suitable for all
+				cases; "hash-grid": a hash grid with cells of the size of "radius", faster when
+				photons are gathered within a fixed radius (which is the case for all modes).
+			</description>
+		</input>
+		<input name="compact-storage" type="string">
+			<description>
+				"true" or "false". Whether to store photons and viewpoints with quantized
+				directions and colors, which takes much less memory at a slight loss of precision.
+			</description>
+		</input>
+		<input name="pipelined" type="string">
+			<description>
+				"true" or "false". For "stochastic-progressive" mode, whether photons of the next
+				pass are traced while the current pass is being evaluated. This keeps more cores 
+				busy, at the cost of holding photons of two passes in memory.
+			</description>
+		</input>
+		<input name="memory-budget-mb" type="integer">
+			<description>
+				For "progressive" and "adaptive-progressive" modes, the approximate amount of
+				memory in megabytes for photons, viewpoints and intermediate films; 0 (the 
+				default) means unlimited. Within the budget, the image is rendered in bands of 
+				rows, one at a time, and passes with too many photons are split into several 
+				smaller passes.
+			</description>
+		</input>
+		<input name="photon-map-file" type="string">
+			<description>
+				For "vanilla" mode, a file to keep the photon map in. If the file exists and 
+				was saved for the same geometry, lights and photon mapping settings, photon 
+				tracing and building are skipped and the photon map is mapped from the file 
+				into memory; otherwise, the built photon map is saved to it. This speeds up 
+				animations where only the camera moves. Changes of materials alone are not 
+				detected, and the file must be deleted after them.
+			</description>
+		</input>
 	</command>
 
 	</SDL_interface>
@@ -1,8 +1,11 @@
 #pragma once
 
+#include "Core/Renderer/PM/PMPassStatistics.h"
+
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <mutex>
 
 namespace ph
 {
@@ -16,13 +19,23 @@ public:
 
 	void asyncAddNumTracedPhotons(std::size_t num);
 	void asyncIncrementNumIterations();
+	void asyncAddGatherQueries(std::size_t numQueries, std::size_t numGatheredPhotons);
+	void asyncSetLastPass(const PMPassStatistics& pass);
 
 	std::size_t asyncGetNumTracedPhotons() const;
 	std::size_t asyncGetNumIterations() const;
+	std::size_t asyncGetNumGatherQueries() const;
+	std::size_t asyncGetNumGatheredPhotons() const;
+	PMPassStatistics asyncGetLastPass() const;
 
 private:
 	std::atomic_uint64_t m_numTracedPhotons;
 	std::atomic_uint32_t m_numIterations;
+	std::atomic_uint64_t m_numGatherQueries;
+	std::atomic_uint64_t m_numGatheredPhotons;
+
+	mutable std::mutex   m_lastPassMutex;
+	PMPassStatistics     m_lastPass;
 };
 
 // In-header Implementations:
@@ -34,8 +47,12 @@ inline PMStatistics::PMStatistics()
 
 inline void PMStatistics::zero()
 {
-	m_numTracedPhotons = 0;
-	m_numIterations    = 0;
+	m_numTracedPhotons   = 0;
+	m_numIterations      = 0;
+	m_numGatherQueries   = 0;
+	m_numGatheredPhotons = 0;
+
+	asyncSetLastPass(PMPassStatistics());
 }
 
 inline void PMStatistics::asyncAddNumTracedPhotons(const std::size_t num)
@@ -48,6 +65,19 @@ inline void PMStatistics::asyncIncrementNumIterations()
 	m_numIterations.fetch_add(1, std::memory_order_relaxed);
 }
 
+inline void PMStatistics::asyncAddGatherQueries(const std::size_t numQueries, const std::size_t numGatheredPhotons)
+{
+	m_numGatherQueries.fetch_add(static_cast<std::uint64_t>(numQueries), std::memory_order_relaxed);
+	m_numGatheredPhotons.fetch_add(static_cast<std::uint64_t>(numGatheredPhotons), std::memory_order_relaxed);
+}
+
+inline void PMStatistics::asyncSetLastPass(const PMPassStatistics& pass)
+{
+	std::lock_guard<std::mutex> lock(m_lastPassMutex);
+
+	m_lastPass = pass;
+}
+
 inline std::size_t PMStatistics::asyncGetNumTracedPhotons() const
 {
 	return static_cast<std::size_t>(m_numTracedPhotons.load(std::memory_order_relaxed));
@@ -58,4 +88,21 @@ inline std::size_t PMStatistics::asyncGetNumIterations() const
 	return static_cast<std::size_t>(m_numIterations.load(std::memory_order_relaxed));
 }
 
+inline std::size_t PMStatistics::asyncGetNumGatherQueries() const
+{
+	return static_cast<std::size_t>(m_numGatherQueries.load(std::memory_order_relaxed));
+}
+
+inline std::size_t PMStatistics::asyncGetNumGatheredPhotons() const
+{
+	return static_cast<std::size_t>(m_numGatheredPhotons.load(std::memory_order_relaxed));
+}
+
+inline PMPassStatistics PMStatistics::asyncGetLastPass() const
+{
+	std::lock_guard<std::mutex> lock(m_lastPassMutex);
+
+	return m_lastPass;
+}
+
 }// end namespace ph
\ No newline at end of file
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Core/Intersectable/HashGrid/TCenterHashGrid.h"
+#include "Math/TVector3.h"
+#include "Common/primitive_type.h"
+#include "Common/assertion.h"
+
+#include <vector>
+#include <utility>
+#include <cstddef>
+
+namespace ph
+{
+
+/*
+	Tells whether a position is within a fixed radius of any viewpoint, i.e.,
+	whether a photon there may contribute to the image. With the initial
+	kernel radius, this is conservative for all later passes, as viewpoint
+	radii only shrink.
+*/
+class PMVisibilityGrid final
+{
+public:
+	PMVisibilityGrid();
+
+	void build(std::vector<Vector3R>&& viewpointPositions, real radius);
+	bool isVisible(const Vector3R& position) const;
+	std::size_t numViewpoints() const;
+
+private:
+	struct PositionCalculator
+	{
+		Vector3R operator () (const Vector3R& position) const
+		{
+			return position;
+		}
+	};
+
+	TCenterHashGrid<Vector3R, PositionCalculator> m_grid;
+	real                                          m_radius;
+};
+
+// In-header Implementations:
+
+inline PMVisibilityGrid::PMVisibilityGrid() :
+	m_grid  (PositionCalculator()),
+	m_radius(0.0_r)
+{}
+
+inline void PMVisibilityGrid::build(std::vector<Vector3R>&& viewpointPositions, const real radius)
+{
+	PH_ASSERT_GT(radius, 0.0_r);
+
+	m_grid.build(std::move(viewpointPositions), radius);
+	m_radius = radius;
+}
+
+inline bool PMVisibilityGrid::isVisible(const Vector3R& position) const
+{
+	bool isVisible = false;
+	m_grid.forEachWithinRange(position, m_radius,
+		[&isVisible](const Vector3R& /* viewpointPosition */)
+		{
+			isVisible = true;
+		});
+
+	return isVisible;
+}
+
+inline std::size_t PMVisibilityGrid::numViewpoints() const
+{
+	return m_grid.numItems();
+}
+
+}// end namespace ph
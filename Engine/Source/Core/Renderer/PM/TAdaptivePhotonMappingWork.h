@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Core/Renderer/RenderWork.h"
+#include "Core/Renderer/PM/TPhoton.h"
+#include "Common/primitive_type.h"
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace ph
+{
+
+class Scene;
+class PMVisibilityGrid;
+class PMStatistics;
+
+/*
+	Traces photon paths with a Markov chain whose states are visible paths,
+	i.e., paths with a photon near some viewpoint, after Hachisuka and
+	Jensen's robust adaptive photon tracing. In each step, a path sampled
+	uniformly in primary sample space replaces the current state if it is
+	visible; otherwise a mutation of the current state is tried. Photons of
+	the current state are stored after each step. The mutation size adapts
+	towards an acceptance rate of 0.234.
+
+	Photons of a chain follow the uniform distribution restricted to visible
+	paths, so they represent numChainPaths() * numUniformPaths() /
+	numVisibleUniformPaths() photon paths of uniform sampling. Fewer photons
+	than requested are stored (none at all) if no visible path is found
+	after many uniformly sampled paths.
+*/
+template<typename Photon>
+class TAdaptivePhotonMappingWork : public RenderWork
+{
+	static_assert(std::is_base_of_v<TPhoton<Photon>, Photon>);
+
+public:
+	TAdaptivePhotonMappingWork(
+		const Scene*            scene,
+		const PMVisibilityGrid* visibilityGrid,
+		Photon*                 photonBuffer,
+		std::size_t             numPhotons);
+
+	void setPMStatistics(PMStatistics* statistics);
+
+	std::size_t numStoredPhotons() const;
+	std::size_t numChainPaths() const;
+	std::size_t numUniformPaths() const;
+	std::size_t numVisibleUniformPaths() const;
+
+private:
+	void doWork() override;
+
+	bool isVisible(const std::vector<Photon>& pathPhotons) const;
+
+	const Scene*            m_scene;
+	const PMVisibilityGrid* m_visibilityGrid;
+	Photon*                 m_photonBuffer;
+	std::size_t             m_numPhotons;
+	PMStatistics*           m_statistics;
+
+	std::size_t m_numStoredPhotons;
+	std::size_t m_numChainPaths;
+	std::size_t m_numUniformPaths;
+	std::size_t m_numVisibleUniformPaths;
+
+	static constexpr real        INITIAL_MUTATION_SIZE  = 0.1_r;
+	static constexpr real        MIN_MUTATION_SIZE      = 1e-4_r;
+	static constexpr real        TARGET_ACCEPTANCE_RATE = 0.234_r;
+
+	// a chain gives up if no visible path is found in this many tries
+	static constexpr std::size_t MAX_INVISIBLE_PATHS = std::size_t(1) << 20;
+};
+
+}// end namespace ph
+
+#include "Core/Renderer/PM/TAdaptivePhotonMappingWork.ipp"
@@ -0,0 +1,182 @@
+#pragma once
+
+#include "Core/Renderer/PM/TAdaptivePhotonMappingWork.h"
+#include "Core/Renderer/PM/TPhotonMappingWork.h"
+#include "Core/Renderer/PM/PMVisibilityGrid.h"
+#include "Core/Renderer/PM/PMStatistics.h"
+#include "Math/Random.h"
+#include "Math/Random/Pcg32.h"
+#include "Math/Random/PrimarySampleSequence.h"
+#include "Math/math.h"
+#include "Utility/Timer.h"
+#include "Common/assertion.h"
+
+#include <utility>
+
+namespace ph
+{
+
+template<typename Photon>
+inline TAdaptivePhotonMappingWork<Photon>::TAdaptivePhotonMappingWork(
+
+	const Scene* const            scene,
+	const PMVisibilityGrid* const visibilityGrid,
+	Photon* const                 photonBuffer,
+	const std::size_t             numPhotons) :
+
+	m_scene(scene),
+	m_visibilityGrid(visibilityGrid),
+	m_photonBuffer(photonBuffer),
+	m_numPhotons(numPhotons),
+	m_statistics(nullptr),
+
+	m_numStoredPhotons(0),
+	m_numChainPaths(0),
+	m_numUniformPaths(0),
+	m_numVisibleUniformPaths(0)
+{
+	PH_ASSERT(scene && visibilityGrid);
+}
+
+template<typename Photon>
+inline void TAdaptivePhotonMappingWork<Photon>::doWork()
+{
+	Timer timer;
+	timer.start();
+
+	m_numStoredPhotons       = 0;
+	m_numChainPaths          = 0;
+	m_numUniformPaths        = 0;
+	m_numVisibleUniformPaths = 0;
+
+	// the chain is seeded by the thread generator, so keying it beforehand 
+	// makes the chain deterministic
+	const uint64 chainSeed     = Random::genSeed();
+	const uint64 chainStreamId = Random::genSeed();
+	PrimarySampleSequence sequence(Pcg32(chainSeed, chainStreamId));
+
+	const auto tracePath = [this, &sequence](std::vector<Photon>& out_photons)
+	{
+		out_photons.clear();
+
+		Random::overrideThisThread(&sequence);
+		TPhotonMappingWork<Photon>::tracePhotonPath(m_scene, 
+			[&out_photons](const Photon& photon)
+			{
+				out_photons.push_back(photon);
+				return true;
+			});
+		Random::overrideThisThread(nullptr);
+	};
+
+	std::vector<Photon> currentPhotons;
+	std::vector<Photon> proposedPhotons;
+	bool                hasState     = false;
+	real                mutationSize = INITIAL_MUTATION_SIZE;
+	std::size_t         numMutations = 0;
+	while(m_numStoredPhotons < m_numPhotons)
+	{
+		if(!hasState && m_numUniformPaths >= MAX_INVISIBLE_PATHS)
+		{
+			break;
+		}
+
+		sequence.proposeLargeStep();
+		tracePath(proposedPhotons);
+		++m_numUniformPaths;
+
+		if(isVisible(proposedPhotons))
+		{
+			sequence.accept();
+			std::swap(currentPhotons, proposedPhotons);
+			hasState = true;
+
+			++m_numVisibleUniformPaths;
+		}
+		else if(hasState)
+		{
+			sequence.proposeSmallStep(mutationSize);
+			tracePath(proposedPhotons);
+			++numMutations;
+
+			const bool isAccepted = isVisible(proposedPhotons);
+			if(isAccepted)
+			{
+				sequence.accept();
+				std::swap(currentPhotons, proposedPhotons);
+			}
+
+			const real acceptance = isAccepted ? 1.0_r : 0.0_r;
+			mutationSize += (acceptance - TARGET_ACCEPTANCE_RATE) / static_cast<real>(numMutations);
+			mutationSize = math::clamp(mutationSize, MIN_MUTATION_SIZE, 1.0_r);
+		}
+		else
+		{
+			continue;
+		}
+
+		++m_numChainPaths;
+		for(const Photon& photon : currentPhotons)
+		{
+			if(m_numStoredPhotons == m_numPhotons)
+			{
+				break;
+			}
+
+			m_photonBuffer[m_numStoredPhotons++] = photon;
+		}
+	}// end while photon buffer is not full
+
+	timer.finish();
+	setElapsedMs(timer.getDeltaMs());
+
+	if(m_statistics)
+	{
+		m_statistics->asyncAddNumTracedPhotons(m_numStoredPhotons);
+	}
+}
+
+template<typename Photon>
+inline bool TAdaptivePhotonMappingWork<Photon>::isVisible(const std::vector<Photon>& pathPhotons) const
+{
+	for(const Photon& photon : pathPhotons)
+	{
+		if(m_visibilityGrid->isVisible(photon.template get<EPhotonData::POSITION>()))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+template<typename Photon>
+inline void TAdaptivePhotonMappingWork<Photon>::setPMStatistics(PMStatistics* const statistics)
+{
+	m_statistics = statistics;
+}
+
+template<typename Photon>
+inline std::size_t TAdaptivePhotonMappingWork<Photon>::numStoredPhotons() const
+{
+	return m_numStoredPhotons;
+}
+
+template<typename Photon>
+inline std::size_t TAdaptivePhotonMappingWork<Photon>::numChainPaths() const
+{
+	return m_numChainPaths;
+}
+
+template<typename Photon>
+inline std::size_t TAdaptivePhotonMappingWork<Photon>::numUniformPaths() const
+{
+	return m_numUniformPaths;
+}
+
+template<typename Photon>
+inline std::size_t TAdaptivePhotonMappingWork<Photon>::numVisibleUniformPaths() const
+{
+	return m_numVisibleUniformPaths;
+}
+
+}// end namespace ph
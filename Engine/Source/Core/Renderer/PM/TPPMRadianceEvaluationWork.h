@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Common/primitive_type.h"
+#include "Common/assertion.h"
+#include "Core/Renderer/PM/TRadianceEvaluationWork.h"
+#include "Core/Renderer/PM/TPhoton.h"
+#include "Core/Renderer/PM/TViewpoint.h"
+#include "Core/Filmic/HdrRgbFilm.h"
+
+#include <vector>
+#include <type_traits>
+
+namespace ph
+{
+
+class Scene;
+class PMStatistics;
+class PMRenderer;
+
+/*
+	Implements the progressive photon mapping technique developed by 
+	Hachisuka et al. The radiance evaluation process progressively shrinks 
+	the kernel radius and increases the number of photons, reaching a 
+	consistent result in the limit. 
+
+	References:
+
+	Hachisuka et al., "Progressive Photon Mapping", ACM SIGGRAPH Asia 2008.
+*/
+template<typename Photon, typename Viewpoint>
+class TPPMRadianceEvaluationWork : public TRadianceEvaluationWork<Photon>
+{
+	static_assert(std::is_base_of_v<TViewpoint<Viewpoint>, Viewpoint>);
+
+public:
+	// <film> can be null, in which case only the viewpoints are updated.
+	TPPMRadianceEvaluationWork(
+		const TPhotonMap<Photon>* photonMap,
+		std::size_t               numPhotonPaths,
+		HdrRgbFilm*               film,
+		Viewpoint*                viewpoints,
+		std::size_t               numViewpoints,
+		const Scene*              scene);
+
+	void setPMStatistics(PMStatistics* statistics);
+	void setAlpha(real alpha);
+
+	// Adds radiance of the viewpoints to <film>, in the order they are 
+	// given. This is for works without a film, which only update viewpoints.
+	void splatRadiance(HdrRgbFilm& film) const;
+
+private:
+	void doWork() override;
+
+	HdrRgbFilm*   m_film;
+	PMStatistics* m_statistics;
+	Viewpoint*    m_viewpoints;
+	std::size_t   m_numViewpoints;
+	const Scene*  m_scene;
+	real          m_alpha;
+
+	void sanitizeVariables();
+	void addRadianceSample(HdrRgbFilm& film, const Viewpoint& viewpoint) const;
+};
+
+}// end namespace ph
+
+#include "Core/Renderer/PM/TPPMRadianceEvaluationWork.ipp"
\ No newline at end of file
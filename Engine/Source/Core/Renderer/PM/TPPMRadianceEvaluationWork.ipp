@@ -0,0 +1,165 @@
+#pragma once
+
+#include "Core/Renderer/PM/TPPMRadianceEvaluationWork.h"
+#include "Common/assertion.h"
+#include "Core/Intersectable/Primitive.h"
+#include "Core/Intersectable/PrimitiveMetadata.h"
+#include "Core/SurfaceBehavior/SurfaceBehavior.h"
+#include "Core/SurfaceBehavior/SurfaceOptics.h"
+#include "Core/SurfaceHit.h"
+#include "Core/Renderer/PM/PMRenderer.h"
+#include "Core/Renderer/PM/PMStatistics.h"
+#include "Core/Emitter/Emitter.h"
+#include "Core/LTABuildingBlock/TSurfaceEventDispatcher.h"
+#include "Core/LTABuildingBlock/lta.h"
+#include "Common/Logger.h"
+
+namespace ph
+{
+
+template<typename Photon, typename Viewpoint>
+inline TPPMRadianceEvaluationWork<Photon, Viewpoint>::TPPMRadianceEvaluationWork(
+
+	const TPhotonMap<Photon>* const photonMap,
+	const std::size_t               numPhotonPaths,
+
+	HdrRgbFilm* const  film,
+	Viewpoint* const   viewpoints,
+	const std::size_t  numViewpoints,
+	const Scene* const scene) :
+
+	TRadianceEvaluationWork<Photon>(photonMap, numPhotonPaths),
+
+	m_film         (film),
+	m_viewpoints   (viewpoints),
+	m_numViewpoints(numViewpoints),
+	m_scene        (scene)
+{
+	setPMStatistics(nullptr);
+	setAlpha(2.0_r / 3.0_r);
+}
+
+template<typename Photon, typename Viewpoint>
+inline void TPPMRadianceEvaluationWork<Photon, Viewpoint>::setPMStatistics(PMStatistics* const statistics)
+{
+	m_statistics = statistics;
+}
+
+template<typename Photon, typename Viewpoint>
+inline void TPPMRadianceEvaluationWork<Photon, Viewpoint>::setAlpha(const real alpha)
+{
+	m_alpha = alpha;
+}
+
+template<typename Photon, typename Viewpoint>
+inline void TPPMRadianceEvaluationWork<Photon, Viewpoint>::doWork()
+{
+	sanitizeVariables();
+	TSurfaceEventDispatcher<ESaPolicy::STRICT> surfaceEvent(m_scene);
+
+	std::size_t numGatheredPhotons = 0;
+	for(std::size_t i = 0; i < m_numViewpoints; ++i)
+	{
+		Viewpoint& viewpoint = m_viewpoints[i];
+
+		const SurfaceHit& surfaceHit = viewpoint.template get<EViewpointData::SURFACE_HIT>();
+		const Vector3R    L          = viewpoint.template get<EViewpointData::VIEW_DIR>();
+		const Vector3R    Ng         = surfaceHit.getGeometryNormal();
+		const Vector3R    Ns         = surfaceHit.getShadingNormal();
+		const real        R          = viewpoint.template get<EViewpointData::RADIUS>();
+
+		std::size_t      numPhotons = 0;
+		SpectralStrength tauM(0);
+		BsdfEvaluation   bsdfEval;
+		this->getPhotonMap()->forEachWithinRange(surfaceHit.getPosition(), R, 
+			[&](const Photon& photon)
+			{
+				++numPhotons;
+
+				const Vector3R V = photon.template get<EPhotonData::FROM_DIR>();
+
+				bsdfEval.inputs.set(surfaceHit, L, V, ALL_ELEMENTALS, ETransport::IMPORTANCE);
+				if(!surfaceEvent.doBsdfEvaluation(surfaceHit, bsdfEval))
+				{
+					return;
+				}
+
+				SpectralStrength tau = photon.template get<EPhotonData::THROUGHPUT_RADIANCE>();
+				tau.mulLocal(bsdfEval.outputs.bsdf);
+				tau.mulLocal(lta::importance_BSDF_Ns_corrector(Ns, Ng, L, V));
+
+				tauM.addLocal(tau);
+			});
+
+		numGatheredPhotons += numPhotons;
+
+		const real N    = viewpoint.template get<EViewpointData::NUM_PHOTONS>();
+		const real M    = static_cast<real>(numPhotons);
+		const real newN = N + m_alpha * M;
+		const real newR = (N + M) != 0.0_r ? R * std::sqrt(newN / (N + M)) : R;
+
+		const SpectralStrength tauN   = viewpoint.template get<EViewpointData::TAU>();
+		const SpectralStrength newTau = (N + M) != 0.0_r ? (tauN + tauM) * (newN / (N + M)) : SpectralStrength(0);
+
+		viewpoint.template set<EViewpointData::RADIUS>(newR);
+		viewpoint.template set<EViewpointData::NUM_PHOTONS>(newN);
+		viewpoint.template set<EViewpointData::TAU>(newTau);
+		
+		if(m_film)
+		{
+			addRadianceSample(*m_film, viewpoint);
+		}
+	}
+
+	if(m_statistics)
+	{
+		m_statistics->asyncAddGatherQueries(m_numViewpoints, numGatheredPhotons);
+	}
+}
+
+template<typename Photon, typename Viewpoint>
+inline void TPPMRadianceEvaluationWork<Photon, Viewpoint>::splatRadiance(HdrRgbFilm& film) const
+{
+	for(std::size_t i = 0; i < m_numViewpoints; ++i)
+	{
+		addRadianceSample(film, m_viewpoints[i]);
+	}
+}
+
+template<typename Photon, typename Viewpoint>
+inline void TPPMRadianceEvaluationWork<Photon, Viewpoint>::addRadianceSample(HdrRgbFilm& film, const Viewpoint& viewpoint) const
+{
+	// evaluate radiance using current iteration's data
+
+	const real R                  = viewpoint.template get<EViewpointData::RADIUS>();
+	const real kernelArea         = R * R * constant::pi<real>;
+	const real radianceMultiplier = 1.0_r / (kernelArea * static_cast<real>(this->numPhotonPaths()));
+
+	SpectralStrength radiance(viewpoint.template get<EViewpointData::TAU>() * radianceMultiplier);
+	radiance.addLocal(viewpoint.template get<EViewpointData::VIEW_RADIANCE>());
+	radiance.mulLocal(viewpoint.template get<EViewpointData::VIEW_THROUGHPUT>());
+
+	const Vector2R filmNdc = viewpoint.template get<EViewpointData::FILM_NDC>();
+	const real filmXPx = filmNdc.x * static_cast<real>(film.getActualResPx().x);
+	const real filmYPx = filmNdc.y * static_cast<real>(film.getActualResPx().y);
+	film.addSample(filmXPx, filmYPx, radiance);
+}
+
+template<typename Photon, typename Viewpoint>
+inline void TPPMRadianceEvaluationWork<Photon, Viewpoint>::sanitizeVariables()
+{
+	static const Logger logger(LogSender("PPM Radiance Evaluator"));
+
+	real sanitizedAlpha = m_alpha;
+	if(m_alpha < 0.0_r || m_alpha > 1.0_r)
+	{
+		logger.log(ELogLevel::WARNING_MED, 
+			"alpha must be in [0, 1], " + std::to_string(m_alpha) + " provided, clamping");
+
+		sanitizedAlpha = math::clamp(m_alpha, 0.0_r, 1.0_r);
+	}
+
+	m_alpha = sanitizedAlpha;
+}
+
+}// end namespace ph
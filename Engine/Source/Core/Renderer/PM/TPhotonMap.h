@@ -1,10 +1,25 @@
 #pragma once
 
 #include "Core/Intersectable/IndexedKdtree/TCenterKdtree.h"
+#include "Core/Intersectable/HashGrid/TCenterHashGrid.h"
 #include "Core/Renderer/PM/TPhoton.h"
+#include "Core/Renderer/PM/EPhotonMapType.h"
 #include "Math/TVector3.h"
+#include "FileIO/FileSystem/Path.h"
+#include "FileIO/MemoryMappedFile.h"
+#include "FileIO/FileReplacement.h"
+#include "Common/primitive_type.h"
+#include "Common/assertion.h"
 
 #include <type_traits>
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include <memory>
+#include <fstream>
+#include <cstring>
+#include <string>
+#include <algorithm>
 
 namespace ph
 {
@@ -22,7 +37,406 @@ struct TPhotonCenterCalculator
 	}
 };
 
+/*
+	Photons stored in either a kd-tree or a hash grid. The hash grid is 
+	preferable when gather radii are known before building and do not exceed
+	the build-time gather radius by much, which is the case for all photon 
+	mapping renderers here (their radii only shrink over passes).
+
+	A built photon map can be saved to a file and loaded by mapping the file
+	into memory, which takes neither photon tracing nor building. The file
+	is only readable on platforms of the same type sizes and byte order.
+*/
+template<typename Photon>
+class TPhotonMap
+{
+public:
+	explicit TPhotonMap(EPhotonMapType type = EPhotonMapType::KD_TREE);
+
+	// <gatherRadius> is the expected search radius, which is a hint for 
+	// structures that depend on it (searches of any radius are supported).
+	void build(std::vector<Photon>&& photons, real gatherRadius);
+
+	void findWithinRange(
+		const Vector3R&      location,
+		real                 searchRadius,
+		std::vector<Photon>& results) const;
+
+	// Calls <photonHandler> with each photon (as const Photon&) within 
+	// range. Only photon positions are read for culling, and no photon is
+	// copied, which is preferable to findWithinRange() for gathering.
+	template<typename PhotonHandler>
+	void forEachWithinRange(
+		const Vector3R& location,
+		real            searchRadius,
+		PhotonHandler   photonHandler) const;
+
+	// Calls <leafHandler> with the depth and the number of photons of each 
+	// kd-tree leaf, or of each hash grid bucket (all at depth 0).
+	template<typename LeafHandler>
+	void forEachLeaf(LeafHandler leafHandler) const;
+
+	// Number of bytes used by the underlying structure, photons included.
+	std::size_t memoryUsage() const;
+
+	// Writes the built photon map to <filePath>, along with the number of
+	// photon paths it was traced from and <contentKey>, a user-defined value
+	// identifying what the photons were traced from (e.g., a hash of the 
+	// scene and tracing settings). The file is written under a temporary
+	// name first, so it is never seen partially written.
+	bool save(const Path& filePath, std::size_t numPhotonPaths, uint64 contentKey) const;
+
+	// Maps a file written by save() read-only and uses it in place of 
+	// building. Fails if the file was saved from another type of photon or
+	// photon map, or with a content key other than <contentKey>. A missing
+	// file fails quietly. The file stays mapped until the next build() or 
+	// load().
+	bool load(const Path& filePath, uint64 contentKey, std::size_t* out_numPhotonPaths);
+
+	std::size_t numItems() const;
+	EPhotonMapType getType() const;
+
+private:
+	using Kdtree   = TCenterKdtree<Photon, int, TPhotonCenterCalculator<Photon>>;
+	using HashGrid = TCenterHashGrid<Photon, TPhotonCenterCalculator<Photon>>;
+
+	// Leads a saved photon map, followed by aligned sections of photons, 
+	// photon positions and either kd-tree nodes or hash grid buckets.
+	struct FileHeader
+	{
+		char    magicNumber[8];
+		uint64  photonSignature;
+		uint64  platformSignature;
+		uint64  photonMapType;
+		uint64  contentKey;
+		uint64  numPhotonPaths;
+		uint64  numItems;
+		uint64  numNodesOrBuckets;
+		float64 reciCellSize;
+		uint64  sectionOffsets[3];
+	};
+
+	EPhotonMapType                    m_type;
+	Kdtree                            m_kdtree;
+	HashGrid                          m_hashGrid;
+	std::shared_ptr<MemoryMappedFile> m_mappedFile;
+
+	static constexpr char        FILE_MAGIC_NUMBER[8]  = {'P', 'H', 'P', 'M', 'A', 'P', '0', '2'};
+	static constexpr std::size_t FILE_SECTION_ALIGNMENT = 64;
+
+	FileHeader makeFileHeader() const;
+};
+
+// In-header Implementations:
+
+template<typename Photon>
+inline TPhotonMap<Photon>::TPhotonMap(const EPhotonMapType type) :
+	m_type      (type),
+	m_kdtree    (2, TPhotonCenterCalculator<Photon>()),
+	m_hashGrid  (TPhotonCenterCalculator<Photon>()),
+	m_mappedFile()
+{}
+
+template<typename Photon>
+inline void TPhotonMap<Photon>::build(std::vector<Photon>&& photons, const real gatherRadius)
+{
+	switch(m_type)
+	{
+	case EPhotonMapType::KD_TREE:
+		m_kdtree.build(std::move(photons));
+		break;
+
+	case EPhotonMapType::HASH_GRID:
+		m_hashGrid.build(std::move(photons), gatherRadius);
+		break;
+
+	default:
+		PH_ASSERT_UNREACHABLE_SECTION();
+		break;
+	}
+
+	// no longer in use by the structures
+	m_mappedFile = nullptr;
+}
+
+template<typename Photon>
+inline void TPhotonMap<Photon>::findWithinRange(
+	const Vector3R&      location,
+	const real           searchRadius,
+	std::vector<Photon>& results) const
+{
+	if(m_type == EPhotonMapType::HASH_GRID)
+	{
+		m_hashGrid.findWithinRange(location, searchRadius, results);
+	}
+	else
+	{
+		m_kdtree.findWithinRange(location, searchRadius, results);
+	}
+}
+
+template<typename Photon>
+template<typename PhotonHandler>
+inline void TPhotonMap<Photon>::forEachWithinRange(
+	const Vector3R& location,
+	const real      searchRadius,
+	PhotonHandler   photonHandler) const
+{
+	if(m_type == EPhotonMapType::HASH_GRID)
+	{
+		m_hashGrid.forEachWithinRange(location, searchRadius, std::move(photonHandler));
+	}
+	else
+	{
+		m_kdtree.forEachWithinRange(location, searchRadius, std::move(photonHandler));
+	}
+}
+
+template<typename Photon>
+template<typename LeafHandler>
+inline void TPhotonMap<Photon>::forEachLeaf(LeafHandler leafHandler) const
+{
+	if(m_type == EPhotonMapType::HASH_GRID)
+	{
+		m_hashGrid.forEachBucket(
+			[&leafHandler](const std::size_t numPhotons)
+			{
+				leafHandler(std::size_t(0), numPhotons);
+			});
+	}
+	else
+	{
+		m_kdtree.forEachLeaf(std::move(leafHandler));
+	}
+}
+
+template<typename Photon>
+inline std::size_t TPhotonMap<Photon>::memoryUsage() const
+{
+	return m_type == EPhotonMapType::HASH_GRID ? m_hashGrid.memoryUsage() : m_kdtree.memoryUsage();
+}
+
+template<typename Photon>
+inline bool TPhotonMap<Photon>::save(
+	const Path&       filePath,
+	const std::size_t numPhotonPaths,
+	const uint64      contentKey) const
+{
+	static_assert(std::is_trivially_copyable_v<Photon>);
+
+	FileHeader header = makeFileHeader();
+	header.contentKey     = contentKey;
+	header.numPhotonPaths = numPhotonPaths;
+
+	const void* sectionData[3];
+	std::size_t sectionBytes[3];
+	if(m_type == EPhotonMapType::HASH_GRID)
+	{
+		const typename HashGrid::Storage storage = m_hashGrid.getStorage();
+		const std::size_t numBucketBegins = storage.numBuckets > 0 ? storage.numBuckets + 1 : 0;
+
+		header.numItems          = storage.numItems;
+		header.numNodesOrBuckets = storage.numBuckets;
+		header.reciCellSize      = storage.reciCellSize;
+		sectionData[0]  = storage.items;
+		sectionData[1]  = storage.itemCenters;
+		sectionData[2]  = storage.bucketBegins;
+		sectionBytes[0] = sizeof(Photon) * storage.numItems;
+		sectionBytes[1] = sizeof(Vector3R) * storage.numItems;
+		sectionBytes[2] = sizeof(std::size_t) * numBucketBegins;
+	}
+	else
+	{
+		const typename Kdtree::Storage storage = m_kdtree.getStorage();
+
+		header.numItems          = storage.numItems;
+		header.numNodesOrBuckets = storage.numNodes;
+		sectionData[0]  = storage.items;
+		sectionData[1]  = storage.itemCenters;
+		sectionData[2]  = storage.nodes;
+		sectionBytes[0] = sizeof(Photon) * storage.numItems;
+		sectionBytes[1] = sizeof(Vector3R) * storage.numItems;
+		sectionBytes[2] = sizeof(typename Kdtree::Node) * storage.numNodes;
+	}
+
+	std::size_t fileBytes = sizeof(FileHeader);
+	for(std::size_t i = 0; i < 3; ++i)
+	{
+		fileBytes = (fileBytes + FILE_SECTION_ALIGNMENT - 1) / FILE_SECTION_ALIGNMENT * FILE_SECTION_ALIGNMENT;
+		header.sectionOffsets[i] = fileBytes;
+		fileBytes += sectionBytes[i];
+	}
+
+	FileReplacement replacement(filePath);
+	{
+		std::ofstream file(replacement.getTempFilePath(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+		file.write(reinterpret_cast<const char*>(&header), sizeof(FileHeader));
+
+		const char padding[FILE_SECTION_ALIGNMENT] = {};
+		std::size_t writtenBytes = sizeof(FileHeader);
+		for(std::size_t i = 0; i < 3; ++i)
+		{
+			file.write(padding, header.sectionOffsets[i] - writtenBytes);
+			if(sectionBytes[i] > 0)
+			{
+				file.write(static_cast<const char*>(sectionData[i]), sectionBytes[i]);
+			}
+			writtenBytes = header.sectionOffsets[i] + sectionBytes[i];
+		}
+
+		if(!file.good())
+		{
+			return false;
+		}
+	}
+
+	return replacement.commit();
+}
+
+template<typename Photon>
+inline bool TPhotonMap<Photon>::load(
+	const Path&        filePath,
+	const uint64       contentKey,
+	std::size_t* const out_numPhotonPaths)
+{
+	static_assert(std::is_trivially_copyable_v<Photon>);
+	PH_ASSERT(out_numPhotonPaths);
+
+	// a missing file is expected before the first save(), and is not worth
+	// the warnings of a failed mapping
+	if(!std::ifstream(filePath.toAbsoluteString(), std::ios_base::in | std::ios_base::binary).is_open())
+	{
+		return false;
+	}
+
+	auto mappedFile = std::make_shared<MemoryMappedFile>(filePath);
+	if(!mappedFile->open() || mappedFile->getSize() < sizeof(FileHeader))
+	{
+		return false;
+	}
+
+	FileHeader header;
+	std::memcpy(&header, mappedFile->getData(), sizeof(FileHeader));
+
+	const FileHeader expectedHeader = makeFileHeader();
+	if(std::memcmp(header.magicNumber, expectedHeader.magicNumber, sizeof(header.magicNumber)) != 0 ||
+	   header.photonSignature   != expectedHeader.photonSignature                                   ||
+	   header.platformSignature != expectedHeader.platformSignature                                 ||
+	   header.photonMapType     != expectedHeader.photonMapType                                     ||
+	   header.contentKey        != contentKey)
+	{
+		return false;
+	}
+
+	// Counts and offsets are untrusted; they are checked against the file 
+	// size without forming products or sums that may overflow.
+	const std::size_t fileBytes = mappedFile->getSize();
+	const std::size_t itemBytes = std::max(sizeof(Photon), sizeof(Vector3R));
+	const std::size_t nodeOrBucketBytes = m_type == EPhotonMapType::HASH_GRID ? 
+		sizeof(std::size_t) : sizeof(typename Kdtree::Node);
+	if(header.numItems > fileBytes / itemBytes || header.numNodesOrBuckets > fileBytes / nodeOrBucketBytes)
+	{
+		return false;
+	}
+
+	const std::size_t numItems = static_cast<std::size_t>(header.numItems);
+	const std::size_t numNodesOrBuckets = static_cast<std::size_t>(header.numNodesOrBuckets);
+	const std::size_t sectionBytes[3] = {
+		sizeof(Photon) * numItems,
+		sizeof(Vector3R) * numItems,
+		m_type == EPhotonMapType::HASH_GRID ?
+			sizeof(std::size_t) * (numNodesOrBuckets > 0 ? numNodesOrBuckets + 1 : 0) :
+			sizeof(typename Kdtree::Node) * numNodesOrBuckets};
+
+	const void* sectionData[3];
+	for(std::size_t i = 0; i < 3; ++i)
+	{
+		if(header.sectionOffsets[i] % FILE_SECTION_ALIGNMENT != 0 ||
+		   header.sectionOffsets[i] > fileBytes                  ||
+		   sectionBytes[i] > fileBytes - header.sectionOffsets[i])
+		{
+			return false;
+		}
+
+		sectionData[i] = mappedFile->getData() + header.sectionOffsets[i];
+	}
+
+	if(m_type == EPhotonMapType::HASH_GRID)
+	{
+		typename HashGrid::Storage storage;
+		storage.items        = static_cast<const Photon*>(sectionData[0]);
+		storage.itemCenters  = static_cast<const Vector3R*>(sectionData[1]);
+		storage.bucketBegins = static_cast<const std::size_t*>(sectionData[2]);
+		storage.numItems     = numItems;
+		storage.numBuckets   = numNodesOrBuckets;
+		storage.reciCellSize = static_cast<real>(header.reciCellSize);
+		if(!HashGrid::isStorageValid(storage))
+		{
+			return false;
+		}
+		m_hashGrid.useStorage(storage);
+	}
+	else
+	{
+		typename Kdtree::Storage storage;
+		storage.nodes       = static_cast<const typename Kdtree::Node*>(sectionData[2]);
+		storage.items       = static_cast<const Photon*>(sectionData[0]);
+		storage.itemCenters = static_cast<const Vector3R*>(sectionData[1]);
+		storage.numNodes    = numNodesOrBuckets;
+		storage.numItems    = numItems;
+		if(!Kdtree::isStorageValid(storage))
+		{
+			return false;
+		}
+		m_kdtree.useStorage(storage);
+	}
+
+	m_mappedFile = std::move(mappedFile);
+
+	*out_numPhotonPaths = static_cast<std::size_t>(header.numPhotonPaths);
+	return true;
+}
+
+template<typename Photon>
+inline auto TPhotonMap<Photon>::makeFileHeader() const
+	-> FileHeader
+{
+	FileHeader header = {};
+	std::memcpy(header.magicNumber, FILE_MAGIC_NUMBER, sizeof(header.magicNumber));
+
+	// Photon types are told apart by their size and stored data; type 
+	// sizes and byte order (detected from a 16-bit value) tell platforms 
+	// apart.
+	header.photonSignature = 
+		static_cast<uint64>(sizeof(Photon)) | 
+		static_cast<uint64>(Photon::template has<EPhotonData::THROUGHPUT_RADIANCE>()) << 32 | 
+		static_cast<uint64>(Photon::template has<EPhotonData::POSITION>()) << 33 | 
+		static_cast<uint64>(Photon::template has<EPhotonData::FROM_DIR>()) << 34;
+
+	const uint16 byteOrderProbe = 1;
+	uint8 firstByte;
+	std::memcpy(&firstByte, &byteOrderProbe, 1);
+	header.platformSignature = 
+		static_cast<uint64>(sizeof(real)) | 
+		static_cast<uint64>(sizeof(std::size_t)) << 8 | 
+		static_cast<uint64>(sizeof(Vector3R)) << 16 | 
+		static_cast<uint64>(sizeof(typename Kdtree::Node)) << 24 | 
+		static_cast<uint64>(firstByte) << 32;
+
+	header.photonMapType = static_cast<uint64>(m_type);
+	return header;
+}
+
 template<typename Photon>
-using TPhotonMap = TCenterKdtree<Photon, int, TPhotonCenterCalculator<Photon>>;
+inline std::size_t TPhotonMap<Photon>::numItems() const
+{
+	return m_type == EPhotonMapType::HASH_GRID ? m_hashGrid.numItems() : m_kdtree.numItems();
+}
+
+template<typename Photon>
+inline EPhotonMapType TPhotonMap<Photon>::getType() const
+{
+	return m_type;
+}
 
 }// end namespace ph
\ No newline at end of file
@@ -32,6 +32,12 @@ public:
 
 	void setPMStatistics(PMStatistics* statistics);
 
+	// Traces a single photon path, calling <photonHandler> with each photon 
+	// (as const Photon&) stored along it. Tracing stops once the handler 
+	// returns false. 0-bounce lighting is not accounted for.
+	template<typename PhotonHandler>
+	static void tracePhotonPath(const Scene* scene, PhotonHandler photonHandler);
+
 private:
 	void doWork() override;
 
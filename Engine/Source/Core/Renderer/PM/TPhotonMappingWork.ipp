@@ -58,86 +58,14 @@ inline void TPhotonMappingWork<Photon>::doWork()
 	{
 		++(*m_numPhotonPaths);
 
-		Ray tracingRay;
-		SpectralStrength emittedRadiance;
-		Vector3R emitN;
-		real pdfA;
-		real pdfW;
-		m_scene->genSensingRay(&tracingRay, &emittedRadiance, &emitN, &pdfA, &pdfW);
-		if(pdfA * pdfW == 0.0_r)
-		{
-			continue;
-		}
-
-		// here 0-bounce lighting is not accounted for
-
-		SpectralStrength throughputRadiance(emittedRadiance);
-		throughputRadiance.divLocal(pdfA);
-		throughputRadiance.divLocal(pdfW);
-		throughputRadiance.mulLocal(emitN.absDot(tracingRay.getDirection()));
-
-		TSurfaceEventDispatcher<ESaPolicy::STRICT> surfaceEvent(m_scene);
-
-		// start tracing single photon path
-		while(!throughputRadiance.isZero())
-		{
-			SurfaceHit surfaceHit;
-			if(!surfaceEvent.traceNextSurface(tracingRay, &surfaceHit))
+		tracePhotonPath(m_scene, 
+			[this, &numStoredPhotons, &photonCounter](const Photon& photon)
 			{
-				break;
-			}
-
-			const PrimitiveMetadata* metadata = surfaceHit.getDetail().getPrimitive()->getMetadata();
-			const SurfaceOptics* optics = metadata->getSurface().getOptics();
-
-			SpectralStrength weightedThroughputRadiance;
-			if(RussianRoulette::surviveOnLuminance(throughputRadiance, &weightedThroughputRadiance))
-			{
-				throughputRadiance = weightedThroughputRadiance;
-
-				Photon photon;
-
-				if constexpr(Photon::template has<EPhotonData::POSITION>()) {
-					photon.template set<EPhotonData::POSITION>(surfaceHit.getPosition());
-				}
-				if constexpr(Photon::template has<EPhotonData::THROUGHPUT_RADIANCE>()) {
-					photon.template set<EPhotonData::THROUGHPUT_RADIANCE>(throughputRadiance);
-				}
-				if constexpr(Photon::template has<EPhotonData::FROM_DIR>()) {
-					photon.template set<EPhotonData::FROM_DIR>(tracingRay.getDirection().mul(-1));
-				}
-
 				m_photonBuffer[numStoredPhotons++] = photon;
 				++photonCounter;
 
-				if(numStoredPhotons == m_numPhotons)
-				{
-					break;
-				}
-			}// end if photon survived
-			else
-			{
-				break;
-			}
-
-			BsdfSample bsdfSample;
-			Ray sampledRay;
-			bsdfSample.inputs.set(surfaceHit, tracingRay.getDirection().mul(-1), ALL_ELEMENTALS, ETransport::IMPORTANCE);
-			if(!surfaceEvent.doBsdfSample(surfaceHit, bsdfSample, &sampledRay))
-			{
-				break;
-			}
-
-			Vector3R V = tracingRay.getDirection().mulLocal(-1);
-			Vector3R L = bsdfSample.outputs.L;
-			Vector3R Ng = surfaceHit.getGeometryNormal();
-			Vector3R Ns = surfaceHit.getShadingNormal();
-			throughputRadiance.mulLocal(bsdfSample.outputs.pdfAppliedBsdf);
-			throughputRadiance.mulLocal(lta::importance_BSDF_Ns_corrector(Ns, Ng, L, V));
-			throughputRadiance.mulLocal(Ns.absDot(L));
-
-			tracingRay = sampledRay;
-		}// end single photon path
+				return numStoredPhotons < m_numPhotons;
+			});
 
 		if(photonCounter >= 16384)
 		{
@@ -162,6 +90,87 @@ inline void TPhotonMappingWork<Photon>::doWork()
 	}
 }
 
+template<typename Photon>
+template<typename PhotonHandler>
+inline void TPhotonMappingWork<Photon>::tracePhotonPath(const Scene* const scene, PhotonHandler photonHandler)
+{
+	Ray tracingRay;
+	SpectralStrength emittedRadiance;
+	Vector3R emitN;
+	real pdfA;
+	real pdfW;
+	scene->genSensingRay(&tracingRay, &emittedRadiance, &emitN, &pdfA, &pdfW);
+	if(pdfA * pdfW == 0.0_r)
+	{
+		return;
+	}
+
+	SpectralStrength throughputRadiance(emittedRadiance);
+	throughputRadiance.divLocal(pdfA);
+	throughputRadiance.divLocal(pdfW);
+	throughputRadiance.mulLocal(emitN.absDot(tracingRay.getDirection()));
+
+	TSurfaceEventDispatcher<ESaPolicy::STRICT> surfaceEvent(scene);
+
+	// start tracing single photon path
+	while(!throughputRadiance.isZero())
+	{
+		SurfaceHit surfaceHit;
+		if(!surfaceEvent.traceNextSurface(tracingRay, &surfaceHit))
+		{
+			break;
+		}
+
+		const PrimitiveMetadata* metadata = surfaceHit.getDetail().getPrimitive()->getMetadata();
+		const SurfaceOptics* optics = metadata->getSurface().getOptics();
+
+		SpectralStrength weightedThroughputRadiance;
+		if(RussianRoulette::surviveOnLuminance(throughputRadiance, &weightedThroughputRadiance))
+		{
+			throughputRadiance = weightedThroughputRadiance;
+
+			Photon photon;
+
+			if constexpr(Photon::template has<EPhotonData::POSITION>()) {
+				photon.template set<EPhotonData::POSITION>(surfaceHit.getPosition());
+			}
+			if constexpr(Photon::template has<EPhotonData::THROUGHPUT_RADIANCE>()) {
+				photon.template set<EPhotonData::THROUGHPUT_RADIANCE>(throughputRadiance);
+			}
+			if constexpr(Photon::template has<EPhotonData::FROM_DIR>()) {
+				photon.template set<EPhotonData::FROM_DIR>(tracingRay.getDirection().mul(-1));
+			}
+
+			if(!photonHandler(photon))
+			{
+				break;
+			}
+		}// end if photon survived
+		else
+		{
+			break;
+		}
+
+		BsdfSample bsdfSample;
+		Ray sampledRay;
+		bsdfSample.inputs.set(surfaceHit, tracingRay.getDirection().mul(-1), ALL_ELEMENTALS, ETransport::IMPORTANCE);
+		if(!surfaceEvent.doBsdfSample(surfaceHit, bsdfSample, &sampledRay))
+		{
+			break;
+		}
+
+		Vector3R V = tracingRay.getDirection().mulLocal(-1);
+		Vector3R L = bsdfSample.outputs.L;
+		Vector3R Ng = surfaceHit.getGeometryNormal();
+		Vector3R Ns = surfaceHit.getShadingNormal();
+		throughputRadiance.mulLocal(bsdfSample.outputs.pdfAppliedBsdf);
+		throughputRadiance.mulLocal(lta::importance_BSDF_Ns_corrector(Ns, Ng, L, V));
+		throughputRadiance.mulLocal(Ns.absDot(L));
+
+		tracingRay = sampledRay;
+	}// end single photon path
+}
+
 template<typename Photon>
 inline void TPhotonMappingWork<Photon>::setPMStatistics(PMStatistics* const statistics)
 {
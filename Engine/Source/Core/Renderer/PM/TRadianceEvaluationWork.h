@@ -43,7 +43,6 @@ private:
 	std::size_t m_numViewpoints;
 	HdrRgbFilm* m_film;
 	std::size_t m_numPhotonPaths;
-	std::vector<Photon> m_photonCache;
 };
 
 }// end namespace ph
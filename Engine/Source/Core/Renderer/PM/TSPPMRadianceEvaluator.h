@@ -17,6 +17,7 @@
 #include "Core/Renderer/PM/TPhotonMap.h"
 #include "Math/math.h"
 #include "Core/Renderer/Region/Region.h"
+#include "Core/Renderer/PM/PMStatistics.h"
 
 #include <vector>
 #include <type_traits>
@@ -56,6 +57,8 @@ public:
 
 	void impl_onSampleBatchFinished();
 
+	void setPMStatistics(PMStatistics* statistics);
+
 private:
 	Viewpoint* m_viewpoints;
 	std::size_t m_numViewpoints;
@@ -66,9 +69,11 @@ private:
 	Region m_filmRegion;
 	std::size_t m_numSamplesPerPixel;
 	std::size_t m_maxViewpointDepth;
+	PMStatistics* m_statistics;
 
 	Viewpoint* m_viewpoint;
-	std::vector<Photon> m_photonCache;
+	std::size_t m_numGatherQueries;
+	std::size_t m_numGatheredPhotons;
 	Vector2S m_filmPosPx;
 	bool m_isViewpointFound;
 
@@ -97,7 +102,10 @@ inline TSPPMRadianceEvaluator<Viewpoint, Photon>::TSPPMRadianceEvaluator(
 	m_film(film),
 	m_filmRegion(filmRegion),
 	m_numSamplesPerPixel(numSamplesPerPixel),
-	m_maxViewpointDepth(maxViewpointDepth)
+	m_maxViewpointDepth(maxViewpointDepth),
+	m_statistics(nullptr),
+	m_numGatherQueries(0),
+	m_numGatheredPhotons(0)
 {
 	PH_ASSERT(m_viewpoints);
 	PH_ASSERT(photonMap);
@@ -195,37 +203,41 @@ inline void TSPPMRadianceEvaluator<Viewpoint, Photon>::impl_onCameraSampleEnd()
 	const Vector3R    Ns         = surfaceHit.getShadingNormal();
 	const real        R          = m_viewpoint->template get<EViewpointData::RADIUS>();
 
-	m_photonCache.clear();
-	m_photonMap->findWithinRange(surfaceHit.getPosition(), R, m_photonCache);
+	std::size_t      numPhotons = 0;
+	SpectralStrength tauM(0);
+	BsdfEvaluation   bsdfEval;
+	m_photonMap->forEachWithinRange(surfaceHit.getPosition(), R, 
+		[&](const Photon& photon)
+		{
+			++numPhotons;
+
+			const Vector3R V = photon.template get<EPhotonData::FROM_DIR>();
+
+			bsdfEval.inputs.set(surfaceHit, L, V, ALL_ELEMENTALS, ETransport::IMPORTANCE);
+			if(!surfaceEvent.doBsdfEvaluation(surfaceHit, bsdfEval))
+			{
+				return;
+			}
+
+			SpectralStrength tau = photon.template get<EPhotonData::THROUGHPUT_RADIANCE>();
+			tau.mulLocal(bsdfEval.outputs.bsdf);
+			tau.mulLocal(lta::importance_BSDF_Ns_corrector(Ns, Ng, L, V));
+
+			tauM.addLocal(tau);
+		});
+	tauM.mulLocal(m_viewpoint->template get<EViewpointData::VIEW_THROUGHPUT>());
+
+	++m_numGatherQueries;
+	m_numGatheredPhotons += numPhotons;
 
 	// FIXME: as a parameter
 	const real alpha = 2.0_r / 3.0_r;
 
 	const real N    = m_viewpoint->template get<EViewpointData::NUM_PHOTONS>();
-	const real M    = static_cast<real>(m_photonCache.size());
+	const real M    = static_cast<real>(numPhotons);
 	const real newN = N + alpha * M;
 	const real newR = (N + M) != 0.0_r ? R * std::sqrt(newN / (N + M)) : R;
 
-	SpectralStrength tauM(0);
-	BsdfEvaluation   bsdfEval;
-	for(const auto& photon : m_photonCache)
-	{
-		const Vector3R V = photon.template get<EPhotonData::FROM_DIR>();
-
-		bsdfEval.inputs.set(surfaceHit, L, V, ALL_ELEMENTALS, ETransport::IMPORTANCE);
-		if(!surfaceEvent.doBsdfEvaluation(surfaceHit, bsdfEval))
-		{
-			continue;
-		}
-
-		SpectralStrength tau = photon.template get<EPhotonData::THROUGHPUT_RADIANCE>();
-		tau.mulLocal(bsdfEval.outputs.bsdf);
-		tau.mulLocal(lta::importance_BSDF_Ns_corrector(Ns, Ng, L, V));
-
-		tauM.addLocal(tau);
-	}
-	tauM.mulLocal(m_viewpoint->template get<EViewpointData::VIEW_THROUGHPUT>());
-
 	const SpectralStrength tauN   = m_viewpoint->template get<EViewpointData::TAU>();
 	const SpectralStrength newTau = (N + M) != 0.0_r ? (tauN + tauM) * (newN / (N + M)) : SpectralStrength(0);
 
@@ -253,6 +265,19 @@ inline void TSPPMRadianceEvaluator<Viewpoint, Photon>::impl_onSampleBatchFinishe
 			m_film->setPixel(static_cast<float64>(x), static_cast<float64>(y), radiance);
 		}
 	}
+
+	if(m_statistics)
+	{
+		m_statistics->asyncAddGatherQueries(m_numGatherQueries, m_numGatheredPhotons);
+	}
+	m_numGatherQueries   = 0;
+	m_numGatheredPhotons = 0;
+}
+
+template<typename Viewpoint, typename Photon>
+inline void TSPPMRadianceEvaluator<Viewpoint, Photon>::setPMStatistics(PMStatistics* const statistics)
+{
+	m_statistics = statistics;
 }
 
 template<typename Viewpoint, typename Photon>
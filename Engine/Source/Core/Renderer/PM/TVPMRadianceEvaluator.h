@@ -4,7 +4,7 @@
 #include "Common/assertion.h"
 #include "Core/Renderer/PM/TViewPathHandler.h"
 #include "Core/Renderer/PM/TPhotonMap.h"
-#include "Core/Renderer/PM/FullPhoton.h"
+#include "Core/Renderer/PM/TPhoton.h"
 #include "Core/Filmic/HdrRgbFilm.h"
 #include "Core/Intersectable/Primitive.h"
 #include "Core/Intersectable/PrimitiveMetadata.h"
@@ -17,6 +17,7 @@
 #include "Core/LTABuildingBlock/lta.h"
 
 #include <vector>
+#include <type_traits>
 
 namespace ph
 {
@@ -27,11 +28,14 @@ class SampleGenerator;
 class PMStatistics;
 class PMRenderer;
 
-class VPMRadianceEvaluator : public TViewPathHandler<VPMRadianceEvaluator>
+template<typename Photon>
+class TVPMRadianceEvaluator : public TViewPathHandler<TVPMRadianceEvaluator<Photon>>
 {
+	static_assert(std::is_base_of_v<TPhoton<Photon>, Photon>);
+
 public:
-	VPMRadianceEvaluator(
-		const TPhotonMap<FullPhoton>* photonMap,
+	TVPMRadianceEvaluator(
+		const TPhotonMap<Photon>*     photonMap,
 		std::size_t                   numPhotonPaths,
 		HdrRgbFilm*                   film,
 		const Scene*                  scene);
@@ -53,8 +57,12 @@ public:
 	void setPMRenderer(PMRenderer* renderer);
 	void setKernelRadius(real radius);
 
+	// Number of photon map searches done so far and photons found by them.
+	std::size_t numGatherQueries() const;
+	std::size_t numGatheredPhotons() const;
+
 private:
-	const TPhotonMap<FullPhoton>* m_photonMap;
+	const TPhotonMap<Photon>*     m_photonMap;
 	std::size_t                   m_numPhotonPaths;
 	HdrRgbFilm*                   m_film;
 	const Scene*                  m_scene;
@@ -65,13 +73,15 @@ private:
 
 	Vector2R                      m_filmNdc;
 	SpectralStrength              m_sampledRadiance;
-	std::vector<FullPhoton>       m_photonCache;
+	std::size_t                   m_numGatherQueries;
+	std::size_t                   m_numGatheredPhotons;
 };
 
 // In-header Implementations:
 
-inline VPMRadianceEvaluator::VPMRadianceEvaluator(
-	const TPhotonMap<FullPhoton>* photonMap,
+template<typename Photon>
+inline TVPMRadianceEvaluator<Photon>::TVPMRadianceEvaluator(
+	const TPhotonMap<Photon>*     photonMap,
 	std::size_t                   numPhotonPaths,
 	HdrRgbFilm*                   film,
 	const Scene*                  scene) :
@@ -79,7 +89,9 @@ inline VPMRadianceEvaluator::VPMRadianceEvaluator(
 	m_photonMap(photonMap),
 	m_numPhotonPaths(numPhotonPaths),
 	m_film(film),
-	m_scene(scene)
+	m_scene(scene),
+	m_numGatherQueries(0),
+	m_numGatheredPhotons(0)
 {
 	PH_ASSERT(photonMap);
 	PH_ASSERT(film);
@@ -92,7 +104,8 @@ inline VPMRadianceEvaluator::VPMRadianceEvaluator(
 	m_film->clear();
 }
 
-inline bool VPMRadianceEvaluator::impl_onCameraSampleStart(
+template<typename Photon>
+inline bool TVPMRadianceEvaluator<Photon>::impl_onCameraSampleStart(
 	const Vector2R&         filmNdc,
 	const SpectralStrength& pathThroughput)
 {
@@ -102,7 +115,8 @@ inline bool VPMRadianceEvaluator::impl_onCameraSampleStart(
 	return true;
 }
 
-inline auto VPMRadianceEvaluator::impl_onPathHitSurface(
+template<typename Photon>
+inline auto TVPMRadianceEvaluator<Photon>::impl_onPathHitSurface(
 	const std::size_t       pathLength,
 	const SurfaceHit&       surfaceHit,
 	const SpectralStrength& pathThroughput) -> ViewPathTracingPolicy
@@ -121,9 +135,6 @@ inline auto VPMRadianceEvaluator::impl_onPathHitSurface(
 		m_sampledRadiance.addLocal(pathThroughput * zeroBounceRadiance);
 	}
 
-	m_photonCache.clear();
-	m_photonMap->findWithinRange(surfaceHit.getPosition(), m_kernelRadius, m_photonCache);
-
 	TSurfaceEventDispatcher<ESaPolicy::STRICT> surfaceEvent(m_scene);
 
 	const Vector3R L = surfaceHit.getIncidentRay().getDirection().mul(-1);
@@ -132,22 +143,26 @@ inline auto VPMRadianceEvaluator::impl_onPathHitSurface(
 
 	BsdfEvaluation   bsdfEval;
 	SpectralStrength radiance(0);
-	for(const auto& photon : m_photonCache)
-	{
-		const Vector3R V = photon.get<EPhotonData::FROM_DIR>();
-
-		bsdfEval.inputs.set(surfaceHit, L, V, ALL_ELEMENTALS, ETransport::IMPORTANCE);
-		if(!surfaceEvent.doBsdfEvaluation(surfaceHit, bsdfEval))
+	++m_numGatherQueries;
+	m_photonMap->forEachWithinRange(surfaceHit.getPosition(), m_kernelRadius, 
+		[&](const Photon& photon)
 		{
-			continue;
-		}
+			++m_numGatheredPhotons;
 
-		SpectralStrength throughput(pathThroughput);
-		throughput.mulLocal(bsdfEval.outputs.bsdf);
-		throughput.mulLocal(lta::importance_BSDF_Ns_corrector(Ns, Ng, L, V));
+			const Vector3R V = photon.template get<EPhotonData::FROM_DIR>();
 
-		radiance.addLocal(throughput * photon.get<EPhotonData::THROUGHPUT_RADIANCE>());
-	}
+			bsdfEval.inputs.set(surfaceHit, L, V, ALL_ELEMENTALS, ETransport::IMPORTANCE);
+			if(!surfaceEvent.doBsdfEvaluation(surfaceHit, bsdfEval))
+			{
+				return;
+			}
+
+			SpectralStrength throughput(pathThroughput);
+			throughput.mulLocal(bsdfEval.outputs.bsdf);
+			throughput.mulLocal(lta::importance_BSDF_Ns_corrector(Ns, Ng, L, V));
+
+			radiance.addLocal(throughput * photon.template get<EPhotonData::THROUGHPUT_RADIANCE>());
+		});
 
 	// FIXME: cache
 	const real kernelArea = m_kernelRadius * m_kernelRadius * constant::pi<real>;
@@ -160,7 +175,8 @@ inline auto VPMRadianceEvaluator::impl_onPathHitSurface(
 	return ViewPathTracingPolicy().kill();
 }
 
-inline void VPMRadianceEvaluator::impl_onCameraSampleEnd()
+template<typename Photon>
+inline void TVPMRadianceEvaluator<Photon>::impl_onCameraSampleEnd()
 {
 	const real filmXPx = m_filmNdc.x * static_cast<real>(m_film->getActualResPx().x);
 	const real filmYPx = m_filmNdc.y * static_cast<real>(m_film->getActualResPx().y);
@@ -168,7 +184,8 @@ inline void VPMRadianceEvaluator::impl_onCameraSampleEnd()
 	m_film->addSample(filmXPx, filmYPx, m_sampledRadiance);
 }
 
-inline void VPMRadianceEvaluator::impl_onSampleBatchFinished()
+template<typename Photon>
+inline void TVPMRadianceEvaluator<Photon>::impl_onSampleBatchFinished()
 {
 	if(m_statistics)
 	{
@@ -182,17 +199,32 @@ inline void VPMRadianceEvaluator::impl_onSampleBatchFinished()
 	}
 }
 
-inline void VPMRadianceEvaluator::setPMStatistics(PMStatistics* const statistics)
+template<typename Photon>
+inline void TVPMRadianceEvaluator<Photon>::setPMStatistics(PMStatistics* const statistics)
 {
 	m_statistics = statistics;
 }
 
-inline void VPMRadianceEvaluator::setPMRenderer(PMRenderer* const renderer)
+template<typename Photon>
+inline std::size_t TVPMRadianceEvaluator<Photon>::numGatherQueries() const
+{
+	return m_numGatherQueries;
+}
+
+template<typename Photon>
+inline std::size_t TVPMRadianceEvaluator<Photon>::numGatheredPhotons() const
+{
+	return m_numGatheredPhotons;
+}
+
+template<typename Photon>
+inline void TVPMRadianceEvaluator<Photon>::setPMRenderer(PMRenderer* const renderer)
 {
 	m_renderer = renderer;
 }
 
-inline void VPMRadianceEvaluator::setKernelRadius(const real radius)
+template<typename Photon>
+inline void TVPMRadianceEvaluator<Photon>::setKernelRadius(const real radius)
 {
 	PH_ASSERT_GT(radius, 0.0_r);
 
@@ -18,6 +18,7 @@ class Scene;
 class Camera;
 class SampleGenerator;
 class Ray;
+class RayDifferential;
 
 template<typename ViewPathHandler>
 class TViewPathTracingWork : public RenderWork
@@ -44,8 +45,10 @@ private:
 	Region m_filmRegion;
 	TVector2<int64> m_filmSize;
 
+	// Differentials of <tracingRay> are only used on the first hit.
 	void traceViewPath(
 		Ray tracingRay, 
+		const RayDifferential& tracingRayDifferential,
 		SpectralStrength pathThroughput,
 		std::size_t pathLength);
 
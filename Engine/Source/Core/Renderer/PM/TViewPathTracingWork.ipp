@@ -6,6 +6,7 @@
 #include "Core/SampleGenerator/SampleGenerator.h"
 #include "Common/assertion.h"
 #include "Core/Ray.h"
+#include "Core/RayDifferential.h"
 #include "Core/HitDetail.h"
 #include "Core/HitProbe.h"
 #include "Core/SurfaceHit.h"
@@ -57,7 +58,13 @@ inline void TViewPathTracingWork<ViewPathHandler>::doWork()
 
 			Ray tracingRay;
 			m_camera->genSensedRay(filmNdc, &tracingRay);
+
+			RayDifferential tracingRayDifferential;
+			m_camera->calcSensedRayDifferentials(filmNdc, tracingRay, &tracingRayDifferential);
+			tracingRayDifferential.scalePartials(1.0_r / rFilmSize.x, 1.0_r / rFilmSize.y);
+
 			tracingRay.reverse();
+			tracingRayDifferential.reverse();
 
 			const std::size_t pathLength = 0;
 			SpectralStrength  pathThroughput(1);// FIXME: camera might affect initial throughput
@@ -69,6 +76,7 @@ inline void TViewPathTracingWork<ViewPathHandler>::doWork()
 			
 			traceViewPath(
 				tracingRay, 
+				tracingRayDifferential,
 				pathThroughput, 
 				pathLength);
 			
@@ -81,11 +89,13 @@ inline void TViewPathTracingWork<ViewPathHandler>::doWork()
 
 template<typename ViewPathHandler>
 inline void TViewPathTracingWork<ViewPathHandler>::traceViewPath(
-	Ray              tracingRay,
-	SpectralStrength pathThroughput,
-	std::size_t      pathLength)
+	Ray                    tracingRay,
+	const RayDifferential& tracingRayDifferential,
+	SpectralStrength       pathThroughput,
+	std::size_t            pathLength)
 {	
 	TSurfaceEventDispatcher<ESaPolicy::STRICT> surfaceEvent(m_scene);
+	bool isFirstHit = true;
 	while(true)
 	{
 		SurfaceHit surfaceHit;
@@ -94,6 +104,12 @@ inline void TViewPathTracingWork<ViewPathHandler>::traceViewPath(
 			break;
 		}
 
+		if(isFirstHit)
+		{
+			surfaceHit.setIncidentRayDifferential(tracingRayDifferential);
+			isFirstHit = false;
+		}
+
 		++pathLength;
 		const ViewPathTracingPolicy& policy = m_handler->onPathHitSurface(pathLength, surfaceHit, pathThroughput);
 		if(policy.isKilled())
@@ -192,6 +208,7 @@ inline void TViewPathTracingWork<ViewPathHandler>::traceElementallyBranchedPath(
 
 		traceViewPath(
 			sampledRay,
+			RayDifferential(),
 			elementalPathThroughput,
 			pathLength);
 	}// end for each phenomenon
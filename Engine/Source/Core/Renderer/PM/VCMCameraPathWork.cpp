@@ -0,0 +1,467 @@
+#include "Core/Renderer/PM/VCMCameraPathWork.h"
+#include "World/Scene.h"
+#include "Core/Camera/Camera.h"
+#include "Core/SampleGenerator/SampleGenerator.h"
+#include "Core/Filmic/HdrRgbFilm.h"
+#include "Core/Ray.h"
+#include "Core/HitProbe.h"
+#include "Core/HitDetail.h"
+#include "Core/SurfaceHit.h"
+#include "Core/Intersectable/Primitive.h"
+#include "Core/Intersectable/PrimitiveMetadata.h"
+#include "Core/SurfaceBehavior/SurfaceBehavior.h"
+#include "Core/SurfaceBehavior/BsdfSample.h"
+#include "Core/SurfaceBehavior/BsdfEvaluation.h"
+#include "Core/SurfaceBehavior/BsdfPdfQuery.h"
+#include "Core/Emitter/Emitter.h"
+#include "Core/Sample/DirectLightSample.h"
+#include "Core/LTABuildingBlock/TSurfaceEventDispatcher.h"
+#include "Core/LTABuildingBlock/RussianRoulette.h"
+#include "Core/LTABuildingBlock/lta.h"
+#include "Math/Mapping/UniformRectangle.h"
+#include "Math/constant.h"
+#include "Common/assertion.h"
+
+#include <cmath>
+
+namespace ph
+{
+
+namespace
+{
+	using SurfaceEventDispatcher = TSurfaceEventDispatcher<ESaPolicy::STRICT>;
+
+	// Pdfs of sampling <L> given <V> at <X>, and the other way around; 0 if
+	// either cannot be sampled.
+	void query_bsdf_pdfs(
+		const SurfaceEventDispatcher& surfaceEvent,
+		const SurfaceHit&             X,
+		const Vector3R&               L,
+		const Vector3R&               V,
+		real* const                   out_dirPdfW,
+		real* const                   out_revPdfW)
+	{
+		BsdfPdfQuery pdfQuery;
+
+		pdfQuery.inputs.set(X, L, V, ALL_ELEMENTALS);
+		*out_dirPdfW = surfaceEvent.doBsdfPdfQuery(X, pdfQuery) ? pdfQuery.outputs.sampleDirPdfW : 0.0_r;
+
+		pdfQuery.inputs.set(X, V, L, ALL_ELEMENTALS);
+		*out_revPdfW = surfaceEvent.doBsdfPdfQuery(X, pdfQuery) ? pdfQuery.outputs.sampleDirPdfW : 0.0_r;
+	}
+}
+
+VCMCameraPathWork::VCMCameraPathWork(
+
+	const Scene* const                 scene,
+	const Camera* const                camera,
+	SampleGenerator* const             sampleGenerator,
+	const VCMParameters&               parameters,
+	const TPhotonMap<VCMPhoton>* const photonMap,
+	const VCMLightVertex* const        lightVertices,
+	const std::size_t* const           pathVertexEnds,
+	const std::size_t                  numLightPaths,
+	const std::size_t                  firstLightPathIndex,
+	HdrRgbFilm* const                  film,
+	const Region&                      filmRegion,
+	const TVector2<int64>&             filmSize) :
+
+	m_scene(scene),
+	m_camera(camera),
+	m_sampleGenerator(sampleGenerator),
+	m_parameters(parameters),
+	m_photonMap(photonMap),
+	m_lightVertices(lightVertices),
+	m_pathVertexEnds(pathVertexEnds),
+	m_numLightPaths(numLightPaths),
+	m_firstLightPathIndex(firstLightPathIndex),
+	m_film(film),
+	m_filmRegion(filmRegion),
+	m_filmSize(filmSize)
+{
+	PH_ASSERT(scene && camera && sampleGenerator && photonMap && pathVertexEnds && film);
+	PH_ASSERT_GT(numLightPaths, 0);
+}
+
+void VCMCameraPathWork::doWork()
+{
+	const Samples2DStage filmStage = m_sampleGenerator->declare2DStage(
+		m_filmRegion.calcArea(),
+		{static_cast<std::size_t>(m_filmRegion.getWidth()), static_cast<std::size_t>(m_filmRegion.getHeight())});
+
+	const TAABB2D<real> rRegion(m_filmRegion);
+	const Vector2R rFilmSize(m_filmSize);
+
+	std::size_t lightPathIndex = m_firstLightPathIndex % m_numLightPaths;
+	while(m_sampleGenerator->prepareSampleBatch())
+	{
+		const Samples2D samples = m_sampleGenerator->getSamples2D(filmStage);
+		for(std::size_t i = 0; i < samples.numSamples(); ++i)
+		{
+			const Vector2R& filmNdc = UniformRectangle::map(samples[i], rRegion).div(rFilmSize);
+
+			Ray tracingRay;
+			m_camera->genSensedRay(filmNdc, &tracingRay);
+			tracingRay.reverse();
+
+			const SpectralStrength radiance = traceCameraPath(tracingRay, lightPathIndex);
+			lightPathIndex = lightPathIndex + 1 < m_numLightPaths ? lightPathIndex + 1 : 0;
+
+			// avoid polluting the film with NaNs and infinities
+			if(!radiance.isFinite())
+			{
+				continue;
+			}
+
+			const real filmXPx = filmNdc.x * static_cast<real>(m_film->getActualResPx().x);
+			const real filmYPx = filmNdc.y * static_cast<real>(m_film->getActualResPx().y);
+			m_film->addSample(filmXPx, filmYPx, radiance);
+		}
+	}
+}
+
+SpectralStrength VCMCameraPathWork::traceCameraPath(Ray tracingRay, const std::size_t lightPathIndex) const
+{
+	SpectralStrength radiance(0);
+
+	// Connecting light sub-paths to the camera is not a technique here, so
+	// the camera sub-path starts with all MIS quantities being 0.
+	VCMPathState path;
+
+	SurfaceEventDispatcher surfaceEvent(m_scene);
+	while(true)
+	{
+		SurfaceHit X;
+		if(!surfaceEvent.traceNextSurface(tracingRay, &X))
+		{
+			break;
+		}
+
+		const Vector3R V     = tracingRay.getDirection().mul(-1);
+		const Vector3R Ns    = X.getShadingNormal();
+		const real     cosIn = Ns.absDot(V);
+		if(cosIn <= 0.0_r)
+		{
+			break;
+		}
+
+		path.onSurfaceHit(X.getPosition().sub(tracingRay.getOrigin()).lengthSquared(), cosIn);
+
+		if(X.getDetail().getPrimitive()->getMetadata()->getSurface().getEmitter())
+		{
+			radiance.addLocal(calcEmitterHitRadiance(X, tracingRay.getOrigin(), path));
+		}
+
+		const bool isSpecular = VCMPathState::isSpecular(X);
+		if(!isSpecular)
+		{
+			radiance.addLocal(sampleDirectLighting(X, V, path));
+			radiance.addLocal(connectToLightPath(X, V, path, lightPathIndex));
+			radiance.addLocal(mergeLightVertices(X, V, path));
+		}
+
+		BsdfSample bsdfSample;
+		Ray        sampledRay;
+		bsdfSample.inputs.set(X, V, ALL_ELEMENTALS, ETransport::RADIANCE);
+		if(!surfaceEvent.doBsdfSample(X, bsdfSample, &sampledRay))
+		{
+			break;
+		}
+
+		const Vector3R L      = bsdfSample.outputs.L;
+		const real     cosOut = Ns.absDot(L);
+
+		real dirPdfW = 0.0_r;
+		real revPdfW = 0.0_r;
+		if(!isSpecular)
+		{
+			query_bsdf_pdfs(surfaceEvent, X, L, V, &dirPdfW, &revPdfW);
+			if(dirPdfW <= 0.0_r)
+			{
+				break;
+			}
+		}
+
+		path.onScatter(cosOut, dirPdfW, revPdfW, isSpecular, m_parameters);
+		path.throughput.mulLocal(bsdfSample.outputs.pdfAppliedBsdf);
+		path.throughput.mulLocal(cosOut);
+
+		if(path.pathLength >= 3)
+		{
+			SpectralStrength weightedThroughput;
+			if(!RussianRoulette::surviveOnLuminance(path.throughput, &weightedThroughput))
+			{
+				break;
+			}
+			path.throughput = weightedThroughput;
+		}
+
+		if(path.throughput.isZero())
+		{
+			break;
+		}
+
+		tracingRay = sampledRay;
+	}// end while tracing the camera sub-path
+
+	return radiance;
+}
+
+SpectralStrength VCMCameraPathWork::calcEmitterHitRadiance(
+	const SurfaceHit&   Xe,
+	const Vector3R&     previousPos,
+	const VCMPathState& path) const
+{
+	const Emitter* const emitter = Xe.getDetail().getPrimitive()->getMetadata()->getSurface().getEmitter();
+	PH_ASSERT(emitter);
+
+	SpectralStrength emittedRadiance;
+	emitter->evalEmittedRadiance(Xe, &emittedRadiance);
+	if(emittedRadiance.isZero())
+	{
+		return SpectralStrength(0);
+	}
+
+	// directly visible emitters can only be found this way
+	if(path.pathLength == 1)
+	{
+		return emittedRadiance.mul(path.throughput);
+	}
+
+	real directPdfA, emissionPdfW;
+	calcEmissionPdfs(Xe, previousPos, &directPdfA, &emissionPdfW);
+
+	const real wCamera =
+		VCMParameters::mis(directPdfA) * path.dVCM +
+		VCMParameters::mis(emissionPdfW) * path.dVC;
+
+	return emittedRadiance.mul(path.throughput).mul(1.0_r / (1.0_r + wCamera));
+}
+
+SpectralStrength VCMCameraPathWork::sampleDirectLighting(
+	const SurfaceHit&   X,
+	const Vector3R&     V,
+	const VCMPathState& path) const
+{
+	DirectLightSample lightSample;
+	lightSample.setDirectSample(X.getPosition());
+	m_scene->genDirectSample(lightSample);
+	if(!lightSample.isDirectSampleGood() || lightSample.radianceLe.isZero())
+	{
+		return SpectralStrength(0);
+	}
+
+	const Vector3R toLightVec  = lightSample.emitPos.sub(X.getPosition());
+	const real     distSquared = toLightVec.lengthSquared();
+	if(distSquared <= lta::RAY_DELTA_DIST * lta::RAY_DELTA_DIST * 3)
+	{
+		return SpectralStrength(0);
+	}
+
+	const Vector3R L = toLightVec.normalize();
+
+	SurfaceEventDispatcher surfaceEvent(m_scene);
+
+	BsdfEvaluation bsdfEval;
+	bsdfEval.inputs.set(X, L, V);
+	if(!surfaceEvent.doBsdfEvaluation(X, bsdfEval) || bsdfEval.outputs.bsdf.isZero())
+	{
+		return SpectralStrength(0);
+	}
+
+	// The sampled point is visible if it is the first hit towards it, which
+	// also provides the emitter normal needed by MIS.
+	const Ray visRay(X.getPosition(), L, lta::RAY_DELTA_DIST, std::sqrt(distSquared) + lta::RAY_DELTA_DIST);
+	HitProbe  probe;
+	if(!m_scene->isIntersecting(visRay, &probe))
+	{
+		return SpectralStrength(0);
+	}
+	const SurfaceHit Xe(visRay, probe);
+	if(Xe.getDetail().getPrimitive() != lightSample.sourcePrim)
+	{
+		return SpectralStrength(0);
+	}
+
+	const real cosToLight = X.getShadingNormal().absDot(L);
+	const real cosAtLight = Xe.getShadingNormal().absDot(L);
+	if(cosAtLight <= 0.0_r)
+	{
+		return SpectralStrength(0);
+	}
+
+	real bsdfDirPdfW, bsdfRevPdfW;
+	query_bsdf_pdfs(surfaceEvent, X, L, V, &bsdfDirPdfW, &bsdfRevPdfW);
+
+	real directPdfA, emissionPdfW;
+	calcEmissionPdfs(Xe, X.getPosition(), &directPdfA, &emissionPdfW);
+
+	const real directPdfW = lightSample.pdfW;
+	const real wLight     = VCMParameters::mis(bsdfDirPdfW / directPdfW);
+	const real wCamera    =
+		VCMParameters::mis(emissionPdfW * cosToLight / (directPdfW * cosAtLight)) *
+		(m_parameters.getMisVmWeightFactor() + path.dVCM + path.dVC * VCMParameters::mis(bsdfRevPdfW));
+	const real misWeight  = 1.0_r / (wLight + 1.0_r + wCamera);
+
+	return lightSample.radianceLe.mul(bsdfEval.outputs.bsdf).mulLocal(path.throughput).mulLocal(
+		misWeight * cosToLight / directPdfW);
+}
+
+SpectralStrength VCMCameraPathWork::connectToLightPath(
+	const SurfaceHit&   X,
+	const Vector3R&     V,
+	const VCMPathState& path,
+	const std::size_t   lightPathIndex) const
+{
+	PH_ASSERT_LT(lightPathIndex, m_numLightPaths);
+
+	const std::size_t vertexBegin = lightPathIndex > 0 ? m_pathVertexEnds[lightPathIndex - 1] : 0;
+	const std::size_t vertexEnd   = m_pathVertexEnds[lightPathIndex];
+
+	SurfaceEventDispatcher surfaceEvent(m_scene);
+
+	SpectralStrength radiance(0);
+	for(std::size_t i = vertexBegin; i < vertexEnd; ++i)
+	{
+		const VCMLightVertex& lightVertex = m_lightVertices[i];
+
+		const Vector3R toLightVertexVec = lightVertex.X.getPosition().sub(X.getPosition());
+		const real     distSquared      = toLightVertexVec.lengthSquared();
+		if(distSquared <= lta::RAY_DELTA_DIST * lta::RAY_DELTA_DIST * 3)
+		{
+			continue;
+		}
+
+		const real     dist = std::sqrt(distSquared);
+		const Vector3R L    = toLightVertexVec.div(dist);
+
+		BsdfEvaluation cameraBsdfEval;
+		cameraBsdfEval.inputs.set(X, L, V);
+		if(!surfaceEvent.doBsdfEvaluation(X, cameraBsdfEval) || cameraBsdfEval.outputs.bsdf.isZero())
+		{
+			continue;
+		}
+
+		// on the light side, importance arrives from the camera vertex
+		const Vector3R lightL = L.mul(-1);
+		const Vector3R lightV = lightVertex.getFromDir();
+
+		BsdfEvaluation lightBsdfEval;
+		lightBsdfEval.inputs.set(lightVertex.X, lightL, lightV, ETransport::IMPORTANCE);
+		if(!surfaceEvent.doBsdfEvaluation(lightVertex.X, lightBsdfEval) || lightBsdfEval.outputs.bsdf.isZero())
+		{
+			continue;
+		}
+
+		const real cosAtCamera = X.getShadingNormal().absDot(L);
+		const real cosAtLight  = lightVertex.X.getShadingNormal().absDot(L);
+		if(cosAtCamera <= 0.0_r || cosAtLight <= 0.0_r)
+		{
+			continue;
+		}
+
+		real cameraBsdfDirPdfW, cameraBsdfRevPdfW;
+		query_bsdf_pdfs(surfaceEvent, X, L, V, &cameraBsdfDirPdfW, &cameraBsdfRevPdfW);
+
+		real lightBsdfDirPdfW, lightBsdfRevPdfW;
+		query_bsdf_pdfs(surfaceEvent, lightVertex.X, lightL, lightV, &lightBsdfDirPdfW, &lightBsdfRevPdfW);
+
+		const real cameraBsdfDirPdfA = cameraBsdfDirPdfW * cosAtLight / distSquared;
+		const real lightBsdfDirPdfA  = lightBsdfDirPdfW * cosAtCamera / distSquared;
+
+		const real wLight = VCMParameters::mis(cameraBsdfDirPdfA) * (
+			m_parameters.getMisVmWeightFactor() +
+			lightVertex.state.dVCM +
+			lightVertex.state.dVC * VCMParameters::mis(lightBsdfRevPdfW));
+		const real wCamera = VCMParameters::mis(lightBsdfDirPdfA) * (
+			m_parameters.getMisVmWeightFactor() +
+			path.dVCM +
+			path.dVC * VCMParameters::mis(cameraBsdfRevPdfW));
+		const real misWeight = 1.0_r / (wLight + 1.0_r + wCamera);
+
+		const real lightNsCorrector = lta::importance_BSDF_Ns_corrector(
+			lightVertex.X.getShadingNormal(), lightVertex.X.getGeometryNormal(), lightL, lightV);
+
+		SpectralStrength contribution = cameraBsdfEval.outputs.bsdf.mul(lightBsdfEval.outputs.bsdf);
+		contribution.mulLocal(path.throughput).mulLocal(lightVertex.state.throughput);
+		contribution.mulLocal(misWeight * lightNsCorrector * cosAtCamera * cosAtLight / distSquared);
+		if(contribution.isZero())
+		{
+			continue;
+		}
+
+		const Ray visRay(X.getPosition(), L, lta::RAY_DELTA_DIST, dist - lta::RAY_DELTA_DIST * 2);
+		if(m_scene->isOccluded(visRay))
+		{
+			continue;
+		}
+
+		radiance.addLocal(contribution);
+	}
+
+	return radiance;
+}
+
+SpectralStrength VCMCameraPathWork::mergeLightVertices(
+	const SurfaceHit&   X,
+	const Vector3R&     V,
+	const VCMPathState& path) const
+{
+	SurfaceEventDispatcher surfaceEvent(m_scene);
+
+	SpectralStrength mergedRadiance(0);
+	m_photonMap->forEachWithinRange(X.getPosition(), m_parameters.getMergeRadius(),
+		[this, &surfaceEvent, &X, &V, &path, &mergedRadiance](const VCMPhoton& photon)
+		{
+			const Vector3R L = photon.get<EPhotonData::FROM_DIR>();
+
+			BsdfEvaluation bsdfEval;
+			bsdfEval.inputs.set(X, L, V);
+			if(!surfaceEvent.doBsdfEvaluation(X, bsdfEval) || bsdfEval.outputs.bsdf.isZero())
+			{
+				return;
+			}
+
+			real bsdfDirPdfW, bsdfRevPdfW;
+			query_bsdf_pdfs(surfaceEvent, X, L, V, &bsdfDirPdfW, &bsdfRevPdfW);
+
+			const real wLight =
+				photon.getDVCM() * m_parameters.getMisVcWeightFactor() +
+				photon.getDVM() * VCMParameters::mis(bsdfDirPdfW);
+			const real wCamera =
+				path.dVCM * m_parameters.getMisVcWeightFactor() +
+				path.dVM * VCMParameters::mis(bsdfRevPdfW);
+			const real misWeight = 1.0_r / (wLight + 1.0_r + wCamera);
+
+			mergedRadiance.addLocal(
+				bsdfEval.outputs.bsdf.mul(photon.get<EPhotonData::THROUGHPUT_RADIANCE>()).mulLocal(misWeight));
+		});
+
+	return mergedRadiance.mulLocal(path.throughput).mulLocal(m_parameters.getVmNormalization());
+}
+
+void VCMCameraPathWork::calcEmissionPdfs(
+	const SurfaceHit& Xe,
+	const Vector3R&   targetPos,
+	real* const       out_directPdfA,
+	real* const       out_emissionPdfW) const
+{
+	PH_ASSERT(out_directPdfA && out_emissionPdfW);
+
+	const Vector3R toTargetVec = targetPos.sub(Xe.getPosition());
+	const real     distSquared = toTargetVec.lengthSquared();
+	if(distSquared <= 0.0_r)
+	{
+		*out_directPdfA   = 0.0_r;
+		*out_emissionPdfW = 0.0_r;
+		return;
+	}
+
+	const real cosAtEmitter = Xe.getShadingNormal().absDot(toTargetVec.normalize());
+	const real directPdfW   = m_scene->calcDirectPdfW(Xe, targetPos);
+
+	*out_directPdfA   = directPdfW * cosAtEmitter / distSquared;
+	*out_emissionPdfW = *out_directPdfA * cosAtEmitter * constant::rcp_pi<real>;
+}
+
+}// end namespace ph
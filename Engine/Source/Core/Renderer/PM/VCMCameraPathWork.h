@@ -0,0 +1,104 @@
+#pragma once
+
+#include "Core/Renderer/RenderWork.h"
+#include "Core/Renderer/PM/VCMParameters.h"
+#include "Core/Renderer/PM/VCMLightVertex.h"
+#include "Core/Renderer/PM/VCMPhoton.h"
+#include "Core/Renderer/PM/TPhotonMap.h"
+#include "Core/Renderer/Region/Region.h"
+#include "Core/Filmic/filmic_fwd.h"
+#include "Math/TVector2.h"
+#include "Core/Quantity/SpectralStrength.h"
+
+#include <cstddef>
+
+namespace ph
+{
+
+class Scene;
+class Camera;
+class SampleGenerator;
+class Ray;
+class SurfaceHit;
+
+/*
+	Traces a camera sub-path for each sample of a film region and estimates
+	radiance with all VCM techniques except connecting light sub-paths to the
+	camera (cameras cannot evaluate their importance yet): hitting emitters,
+	direct lighting, connecting to the vertices of a light sub-path, and
+	merging with light vertices nearby. The i-th sample of the work is paired
+	with light sub-path <firstLightPathIndex> + i (modulo the number of light
+	sub-paths).
+
+	Russian roulette is not accounted for in MIS weights; as it is ignored by
+	all techniques alike, the weights still sum to one.
+*/
+class VCMCameraPathWork : public RenderWork
+{
+public:
+	VCMCameraPathWork(
+		const Scene*                 scene,
+		const Camera*                camera,
+		SampleGenerator*             sampleGenerator,
+		const VCMParameters&         parameters,
+		const TPhotonMap<VCMPhoton>* photonMap,
+		const VCMLightVertex*        lightVertices,
+		const std::size_t*           pathVertexEnds,
+		std::size_t                  numLightPaths,
+		std::size_t                  firstLightPathIndex,
+		HdrRgbFilm*                  film,
+		const Region&                filmRegion,
+		const TVector2<int64>&       filmSize);
+
+private:
+	void doWork() override;
+
+	SpectralStrength traceCameraPath(Ray tracingRay, std::size_t lightPathIndex) const;
+
+	SpectralStrength calcEmitterHitRadiance(
+		const SurfaceHit&   Xe,
+		const Vector3R&     previousPos,
+		const VCMPathState& path) const;
+
+	SpectralStrength sampleDirectLighting(
+		const SurfaceHit&   X,
+		const Vector3R&     V,
+		const VCMPathState& path) const;
+
+	SpectralStrength connectToLightPath(
+		const SurfaceHit&   X,
+		const Vector3R&     V,
+		const VCMPathState& path,
+		std::size_t         lightPathIndex) const;
+
+	SpectralStrength mergeLightVertices(
+		const SurfaceHit&   X,
+		const Vector3R&     V,
+		const VCMPathState& path) const;
+
+	// Calculates the pdfs of a light sub-path starting from <Xe> towards
+	// <targetPos>: <out_directPdfA> for picking <Xe> (as direct lighting
+	// does) and <out_emissionPdfW> for also emitting towards <targetPos>.
+	// Emission is assumed to be cosine-weighted, as diffuse surface emitters
+	// do.
+	void calcEmissionPdfs(
+		const SurfaceHit& Xe,
+		const Vector3R&   targetPos,
+		real*             out_directPdfA,
+		real*             out_emissionPdfW) const;
+
+	const Scene*                 m_scene;
+	const Camera*                m_camera;
+	SampleGenerator*             m_sampleGenerator;
+	VCMParameters                m_parameters;
+	const TPhotonMap<VCMPhoton>* m_photonMap;
+	const VCMLightVertex*        m_lightVertices;
+	const std::size_t*           m_pathVertexEnds;
+	std::size_t                  m_numLightPaths;
+	std::size_t                  m_firstLightPathIndex;
+	HdrRgbFilm*                  m_film;
+	Region                       m_filmRegion;
+	TVector2<int64>              m_filmSize;
+};
+
+}// end namespace ph
@@ -0,0 +1,163 @@
+#include "Core/Renderer/PM/VCMLightPathWork.h"
+#include "World/Scene.h"
+#include "Core/Ray.h"
+#include "Core/SurfaceHit.h"
+#include "Core/SurfaceBehavior/BsdfSample.h"
+#include "Core/SurfaceBehavior/BsdfPdfQuery.h"
+#include "Core/LTABuildingBlock/TSurfaceEventDispatcher.h"
+#include "Core/LTABuildingBlock/RussianRoulette.h"
+#include "Core/LTABuildingBlock/lta.h"
+#include "Core/Renderer/PM/PMStatistics.h"
+#include "Utility/Timer.h"
+#include "Common/assertion.h"
+
+namespace ph
+{
+
+VCMLightPathWork::VCMLightPathWork(
+
+	const Scene* const                 scene,
+	const VCMParameters&               parameters,
+	const std::size_t                  numPaths,
+	std::vector<VCMLightVertex>* const out_lightVertices,
+	std::vector<std::size_t>* const    out_pathVertexEnds) :
+
+	m_scene(scene),
+	m_parameters(parameters),
+	m_numPaths(numPaths),
+	m_lightVertices(out_lightVertices),
+	m_pathVertexEnds(out_pathVertexEnds),
+	m_statistics(nullptr)
+{
+	PH_ASSERT(scene && out_lightVertices && out_pathVertexEnds);
+}
+
+void VCMLightPathWork::doWork()
+{
+	Timer timer;
+	timer.start();
+
+	const std::size_t numInitialVertices = m_lightVertices->size();
+	for(std::size_t i = 0; i < m_numPaths; ++i)
+	{
+		traceLightPath();
+
+		m_pathVertexEnds->push_back(m_lightVertices->size());
+	}
+
+	timer.finish();
+	setElapsedMs(timer.getDeltaMs());
+
+	if(m_statistics)
+	{
+		m_statistics->asyncAddNumTracedPhotons(m_lightVertices->size() - numInitialVertices);
+	}
+}
+
+void VCMLightPathWork::traceLightPath()
+{
+	Ray              tracingRay;
+	SpectralStrength emittedRadiance;
+	Vector3R         emitN;
+	real             pdfA;
+	real             pdfW;
+	m_scene->genSensingRay(&tracingRay, &emittedRadiance, &emitN, &pdfA, &pdfW);
+
+	const real cosAtLight   = emitN.absDot(tracingRay.getDirection());
+	const real emissionPdfW = pdfA * pdfW;
+	if(emissionPdfW <= 0.0_r || cosAtLight <= 0.0_r || emittedRadiance.isZero())
+	{
+		return;
+	}
+
+	// Emitter positions are assumed to be picked the same way for direct
+	// lighting and for emission, so the ratio of their pdfs is 1 / <pdfW>.
+	VCMPathState path;
+	path.throughput = emittedRadiance.mul(cosAtLight / emissionPdfW);
+	path.dVCM       = VCMParameters::mis(1.0_r / pdfW);
+	path.dVC        = VCMParameters::mis(cosAtLight / emissionPdfW);
+	path.dVM        = path.dVC * m_parameters.getMisVcWeightFactor();
+
+	TSurfaceEventDispatcher<ESaPolicy::STRICT> surfaceEvent(m_scene);
+	while(true)
+	{
+		SurfaceHit X;
+		if(!surfaceEvent.traceNextSurface(tracingRay, &X))
+		{
+			break;
+		}
+
+		const Vector3R V  = tracingRay.getDirection().mul(-1);
+		const Vector3R Ns = X.getShadingNormal();
+		const Vector3R Ng = X.getGeometryNormal();
+		const real     cosIn = Ns.absDot(V);
+		if(cosIn <= 0.0_r)
+		{
+			break;
+		}
+
+		path.onSurfaceHit(X.getPosition().sub(tracingRay.getOrigin()).lengthSquared(), cosIn);
+
+		const bool isSpecular = VCMPathState::isSpecular(X);
+		if(!isSpecular)
+		{
+			m_lightVertices->push_back(VCMLightVertex(X, path));
+		}
+
+		BsdfSample bsdfSample;
+		Ray        sampledRay;
+		bsdfSample.inputs.set(X, V, ALL_ELEMENTALS, ETransport::IMPORTANCE);
+		if(!surfaceEvent.doBsdfSample(X, bsdfSample, &sampledRay))
+		{
+			break;
+		}
+
+		const Vector3R L      = bsdfSample.outputs.L;
+		const real     cosOut = Ns.absDot(L);
+
+		real dirPdfW = 0.0_r;
+		real revPdfW = 0.0_r;
+		if(!isSpecular)
+		{
+			BsdfPdfQuery pdfQuery;
+			pdfQuery.inputs.set(X, L, V, ALL_ELEMENTALS);
+			if(!surfaceEvent.doBsdfPdfQuery(X, pdfQuery))
+			{
+				break;
+			}
+			dirPdfW = pdfQuery.outputs.sampleDirPdfW;
+
+			pdfQuery.inputs.set(X, V, L, ALL_ELEMENTALS);
+			revPdfW = surfaceEvent.doBsdfPdfQuery(X, pdfQuery) ? pdfQuery.outputs.sampleDirPdfW : 0.0_r;
+		}
+
+		path.onScatter(cosOut, dirPdfW, revPdfW, isSpecular, m_parameters);
+		path.throughput.mulLocal(bsdfSample.outputs.pdfAppliedBsdf);
+		path.throughput.mulLocal(lta::importance_BSDF_Ns_corrector(Ns, Ng, L, V));
+		path.throughput.mulLocal(cosOut);
+
+		if(path.pathLength >= 3)
+		{
+			SpectralStrength weightedThroughput;
+			if(!RussianRoulette::surviveOnLuminance(path.throughput, &weightedThroughput))
+			{
+				break;
+			}
+			path.throughput = weightedThroughput;
+		}
+
+		if(path.throughput.isZero())
+		{
+			break;
+		}
+
+		tracingRay = sampledRay;
+	}// end while tracing the light sub-path
+}
+
+void VCMLightPathWork::setPMStatistics(PMStatistics* const statistics)
+{
+	m_statistics = statistics;
+}
+
+}// end namespace ph
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Core/Renderer/RenderWork.h"
+#include "Core/Renderer/PM/VCMParameters.h"
+#include "Core/Renderer/PM/VCMLightVertex.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace ph
+{
+
+class Scene;
+class PMStatistics;
+
+/*
+	Traces light sub-paths for VCM. Non-specular vertices of each path are
+	appended to a buffer in path order, and the end of each path in that
+	buffer is recorded, so camera sub-paths can find the vertices of the
+	light sub-path paired with them.
+*/
+class VCMLightPathWork : public RenderWork
+{
+public:
+	VCMLightPathWork(
+		const Scene*                 scene,
+		const VCMParameters&         parameters,
+		std::size_t                  numPaths,
+		std::vector<VCMLightVertex>* out_lightVertices,
+		std::vector<std::size_t>*    out_pathVertexEnds);
+
+	void setPMStatistics(PMStatistics* statistics);
+
+private:
+	void doWork() override;
+
+	void traceLightPath();
+
+	const Scene*                 m_scene;
+	VCMParameters                m_parameters;
+	std::size_t                  m_numPaths;
+	std::vector<VCMLightVertex>* m_lightVertices;
+	std::vector<std::size_t>*    m_pathVertexEnds;
+	PMStatistics*                m_statistics;
+};
+
+}// end namespace ph
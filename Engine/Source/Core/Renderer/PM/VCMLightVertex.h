@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Core/Renderer/PM/VCMPathState.h"
+#include "Core/Renderer/PM/VCMPhoton.h"
+#include "Core/SurfaceHit.h"
+#include "Math/TVector3.h"
+
+namespace ph
+{
+
+/*
+	A non-specular vertex of a light sub-path, kept for connecting camera
+	sub-paths to it. The state is the one on arriving at the vertex.
+*/
+class VCMLightVertex final
+{
+public:
+	SurfaceHit   X;
+	VCMPathState state;
+
+	VCMLightVertex() = default;
+	VCMLightVertex(const SurfaceHit& X, const VCMPathState& state);
+
+	// direction towards the previous vertex of the light sub-path
+	Vector3R getFromDir() const;
+
+	VCMPhoton toPhoton() const;
+};
+
+// In-header Implementations:
+
+inline VCMLightVertex::VCMLightVertex(const SurfaceHit& X, const VCMPathState& state) :
+	X    (X),
+	state(state)
+{}
+
+inline Vector3R VCMLightVertex::getFromDir() const
+{
+	return X.getIncidentRay().getDirection().mul(-1);
+}
+
+inline VCMPhoton VCMLightVertex::toPhoton() const
+{
+	VCMPhoton photon;
+	photon.set<EPhotonData::POSITION>(X.getPosition());
+	photon.set<EPhotonData::THROUGHPUT_RADIANCE>(state.throughput);
+	photon.set<EPhotonData::FROM_DIR>(getFromDir());
+	photon.setMisQuantities(state.dVCM, state.dVM, state.pathLength);
+
+	return photon;
+}
+
+}// end namespace ph
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "Common/primitive_type.h"
+#include "Common/assertion.h"
+#include "Math/constant.h"
+
+#include <cstddef>
+
+namespace ph
+{
+
+/*
+	Constants of a vertex connection and merging (VCM) pass. Merging is
+	treated as a sampling technique whose pdf is that of the connection
+	it replaces times the area of the merging disk and the number of light
+	sub-paths; MIS weights use the power heuristic.
+
+	Reference: Georgiev et al., "Light Transport Simulation with Vertex
+	Connection and Merging", SIGGRAPH Asia 2012, and the accompanying
+	technical report "Implementing Vertex Connection and Merging".
+*/
+class VCMParameters final
+{
+public:
+	static real mis(real pdfRatio);
+
+public:
+	VCMParameters(real mergeRadius, std::size_t numLightPaths);
+
+	real getMergeRadius() const;
+
+	// weight factor of merging relative to connecting
+	real getMisVmWeightFactor() const;
+
+	// weight factor of connecting relative to merging
+	real getMisVcWeightFactor() const;
+
+	// normalizes the sum of merged light vertices into a density estimate
+	real getVmNormalization() const;
+
+private:
+	real m_mergeRadius;
+	real m_misVmWeightFactor;
+	real m_misVcWeightFactor;
+	real m_vmNormalization;
+};
+
+// In-header Implementations:
+
+inline real VCMParameters::mis(const real pdfRatio)
+{
+	return pdfRatio * pdfRatio;
+}
+
+inline VCMParameters::VCMParameters(const real mergeRadius, const std::size_t numLightPaths) :
+	m_mergeRadius(mergeRadius)
+{
+	PH_ASSERT_GT(mergeRadius, 0.0_r);
+	PH_ASSERT_GT(numLightPaths, 0);
+
+	const real etaVCM = constant::pi<real> * mergeRadius * mergeRadius * static_cast<real>(numLightPaths);
+
+	m_misVmWeightFactor = mis(etaVCM);
+	m_misVcWeightFactor = mis(1.0_r / etaVCM);
+	m_vmNormalization   = 1.0_r / etaVCM;
+}
+
+inline real VCMParameters::getMergeRadius() const
+{
+	return m_mergeRadius;
+}
+
+inline real VCMParameters::getMisVmWeightFactor() const
+{
+	return m_misVmWeightFactor;
+}
+
+inline real VCMParameters::getMisVcWeightFactor() const
+{
+	return m_misVcWeightFactor;
+}
+
+inline real VCMParameters::getVmNormalization() const
+{
+	return m_vmNormalization;
+}
+
+}// end namespace ph
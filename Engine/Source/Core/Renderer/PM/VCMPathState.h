@@ -0,0 +1,119 @@
+#pragma once
+
+#include "Core/Renderer/PM/VCMParameters.h"
+#include "Core/Quantity/SpectralStrength.h"
+#include "Core/SurfaceHit.h"
+#include "Core/HitDetail.h"
+#include "Core/Intersectable/Primitive.h"
+#include "Core/Intersectable/PrimitiveMetadata.h"
+#include "Core/SurfaceBehavior/SurfaceOptics.h"
+#include "Common/primitive_type.h"
+#include "Common/assertion.h"
+
+namespace ph
+{
+
+/*
+	State of a light or camera sub-path being traced by VCM. Besides the
+	throughput, the partial MIS quantities dVCM, dVC and dVM are carried along
+	the sub-path, so the MIS weight of a full path can be evaluated from its
+	two ends only (in time independent of path length).
+*/
+class VCMPathState final
+{
+public:
+	// Whether scattering at <X> is treated as specular, where no connection 
+	// or merging is done. Surfaces with any delta component count as 
+	// specular, as in BNEEPTEstimator.
+	static bool isSpecular(const SurfaceHit& X);
+
+public:
+	SpectralStrength throughput;
+	real             dVCM;
+	real             dVC;
+	real             dVM;
+	uint32           pathLength;
+
+	VCMPathState();
+
+	// Updates the MIS quantities for reaching a surface at a squared distance
+	// of <distSquared>, where <cosAtHit> is the cosine between incoming
+	// direction and shading normal.
+	void onSurfaceHit(real distSquared, real cosAtHit);
+
+	// Updates the MIS quantities for scattering into a direction sampled
+	// with <dirPdfW>. <revPdfW> is the pdf of sampling the incoming direction
+	// from the sampled one; both are ignored for specular scattering.
+	void onScatter(
+		real                 cosOut,
+		real                 dirPdfW,
+		real                 revPdfW,
+		bool                 isSpecular,
+		const VCMParameters& parameters);
+};
+
+// In-header Implementations:
+
+inline bool VCMPathState::isSpecular(const SurfaceHit& X)
+{
+	if(!X.hasSurfaceOptics())
+	{
+		return true;
+	}
+
+	const SurfaceOptics* const optics = X.getDetail().getPrimitive()->getMetadata()->getSurface().getOptics();
+	return optics->getAllPhenomena().hasAtLeastOne({
+		ESurfacePhenomenon::DELTA_REFLECTION, 
+		ESurfacePhenomenon::DELTA_TRANSMISSION});
+}
+
+inline VCMPathState::VCMPathState() :
+	throughput(1),
+	dVCM      (0),
+	dVC       (0),
+	dVM       (0),
+	pathLength(0)
+{}
+
+inline void VCMPathState::onSurfaceHit(const real distSquared, const real cosAtHit)
+{
+	PH_ASSERT_GT(cosAtHit, 0.0_r);
+
+	const real misCos = VCMParameters::mis(cosAtHit);
+
+	dVCM *= VCMParameters::mis(distSquared);
+	dVCM /= misCos;
+	dVC  /= misCos;
+	dVM  /= misCos;
+
+	++pathLength;
+}
+
+inline void VCMPathState::onScatter(
+	const real           cosOut,
+	const real           dirPdfW,
+	const real           revPdfW,
+	const bool           isSpecular,
+	const VCMParameters& parameters)
+{
+	// pdfs of both directions are the same delta function for specular
+	// scattering, which cancel out
+	if(isSpecular)
+	{
+		dVCM = 0.0_r;
+		dVC *= VCMParameters::mis(cosOut);
+		dVM *= VCMParameters::mis(cosOut);
+		return;
+	}
+
+	PH_ASSERT_GT(dirPdfW, 0.0_r);
+
+	const real misCosOverPdf = VCMParameters::mis(cosOut / dirPdfW);
+	const real misRevPdfW    = VCMParameters::mis(revPdfW);
+
+	dVC  = misCosOverPdf * (dVC * misRevPdfW + dVCM + parameters.getMisVmWeightFactor());
+	dVM  = misCosOverPdf * (dVM * misRevPdfW + dVCM * parameters.getMisVcWeightFactor() + 1.0_r);
+	dVCM = VCMParameters::mis(1.0_r / dirPdfW);
+}
+
+}// end namespace ph
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "Core/Renderer/PM/TPhoton.h"
+#include "Core/Quantity/SpectralStrength.h"
+#include "Math/TVector3.h"
+#include "Common/primitive_type.h"
+#include "Common/assertion.h"
+
+namespace ph
+{
+
+/*
+	A light sub-path vertex stored for vertex merging. Besides the usual
+	photon data, it keeps the partial MIS quantities of the sub-path (see
+	VCMPathState), which weight merged contributions against other sampling
+	techniques.
+*/
+class VCMPhoton : public TPhoton<VCMPhoton>
+{
+public:
+	VCMPhoton() = default;
+
+	void setMisQuantities(real dVCM, real dVM, uint32 pathLength);
+
+	real   getDVCM() const;
+	real   getDVM() const;
+	uint32 getPathLength() const;
+
+	template<EPhotonData TYPE>
+	static constexpr bool impl_has();
+
+	template<EPhotonData TYPE>
+	decltype(auto) impl_get() const;
+
+	template<EPhotonData TYPE, typename T>
+	void impl_set(const T& value);
+
+private:
+	SpectralStrength m_throughputRadiance;
+	Vector3R         m_position;
+	Vector3R         m_fromDir;
+	real             m_dVCM;
+	real             m_dVM;
+	uint32           m_pathLength;
+};
+
+// In-header Implementations:
+
+inline void VCMPhoton::setMisQuantities(const real dVCM, const real dVM, const uint32 pathLength)
+{
+	m_dVCM       = dVCM;
+	m_dVM        = dVM;
+	m_pathLength = pathLength;
+}
+
+inline real VCMPhoton::getDVCM() const
+{
+	return m_dVCM;
+}
+
+inline real VCMPhoton::getDVM() const
+{
+	return m_dVM;
+}
+
+inline uint32 VCMPhoton::getPathLength() const
+{
+	return m_pathLength;
+}
+
+template<EPhotonData TYPE>
+inline constexpr bool VCMPhoton::impl_has()
+{
+	if constexpr(
+		TYPE == EPhotonData::THROUGHPUT_RADIANCE ||
+		TYPE == EPhotonData::POSITION            ||
+		TYPE == EPhotonData::FROM_DIR)
+	{
+		return true;
+	}
+	else
+	{
+		return false;
+	}
+}
+
+template<EPhotonData TYPE>
+inline decltype(auto) VCMPhoton::impl_get() const
+{
+	if constexpr(TYPE == EPhotonData::THROUGHPUT_RADIANCE)
+	{
+		return m_throughputRadiance;
+	}
+	else if constexpr(TYPE == EPhotonData::POSITION)
+	{
+		return m_position;
+	}
+	else if constexpr(TYPE == EPhotonData::FROM_DIR)
+	{
+		return m_fromDir;
+	}
+	else
+	{
+		PH_ASSERT_UNREACHABLE_SECTION();
+		return false;
+	}
+}
+
+template<EPhotonData TYPE, typename T>
+inline void VCMPhoton::impl_set(const T& value)
+{
+	if constexpr(TYPE == EPhotonData::THROUGHPUT_RADIANCE)
+	{
+		m_throughputRadiance = value;
+	}
+	else if constexpr(TYPE == EPhotonData::POSITION)
+	{
+		m_position = value;
+	}
+	else if constexpr(TYPE == EPhotonData::FROM_DIR)
+	{
+		m_fromDir = value;
+	}
+	else
+	{
+		PH_ASSERT_UNREACHABLE_SECTION();
+	}
+}
+
+}// end namespace ph
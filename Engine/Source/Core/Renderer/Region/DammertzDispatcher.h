@@ -283,7 +283,7 @@ inline void DammertzDispatcher::TAnalyzer<DammertzDispatcher::ERefineMode::MIN_E
 	real regionError = summedEp;
 	regionError /= frameRegion.calcArea();
 	regionError *= fast_sqrt(frameRegion.calcArea() * m_rcpNumRegionPixels);
-	PH_ASSERT_MSG(regionError > 0 && std::isfinite(regionError), std::to_string(regionError));
+	PH_ASSERT_MSG(regionError >= 0 && std::isfinite(regionError), std::to_string(regionError));
 
 	if(regionError >= m_splitThreshold)
 	{
@@ -13,29 +13,36 @@ class RenderState
 public:
 	using IntegerState = int64;
 	using RealState    = float32;
+	using HistogramBin = int64;
 
-	constexpr static std::size_t NUM_INTEGER_STATES = 4;
-	constexpr static std::size_t NUM_REAL_STATES    = 4;
+	constexpr static std::size_t NUM_INTEGER_STATES = 8;
+	constexpr static std::size_t NUM_REAL_STATES    = 8;
+	constexpr static std::size_t NUM_HISTOGRAMS     = 4;
+	constexpr static std::size_t NUM_HISTOGRAM_BINS = 16;
 
 	enum class EType
 	{
 		INTEGER,
-		REAL
+		REAL,
+		HISTOGRAM
 	};
 
 	RenderState() = default;
 
 	IntegerState getIntegerState(std::size_t index) const;
 	RealState    getRealState(std::size_t index) const;
+	HistogramBin getHistogramBin(std::size_t histogramIndex, std::size_t binIndex) const;
 
 	void setIntegerState(std::size_t index, IntegerState state);
 	void setRealState(std::size_t index, RealState state);
+	void setHistogramBin(std::size_t histogramIndex, std::size_t binIndex, HistogramBin count);
 
 	constexpr static std::size_t numStates(EType type);
 
 private:
-	IntegerState m_integerStates[NUM_INTEGER_STATES];
-	RealState    m_realStates[NUM_REAL_STATES];
+	IntegerState m_integerStates[NUM_INTEGER_STATES] = {};
+	RealState    m_realStates[NUM_REAL_STATES]       = {};
+	HistogramBin m_histograms[NUM_HISTOGRAMS][NUM_HISTOGRAM_BINS] = {};
 };
 
 // In-header Implementations:
@@ -54,6 +61,14 @@ inline auto RenderState::getRealState(const std::size_t index) const -> RealStat
 	return m_realStates[index];
 }
 
+inline auto RenderState::getHistogramBin(const std::size_t histogramIndex, const std::size_t binIndex) const -> HistogramBin
+{
+	PH_ASSERT_LT(histogramIndex, NUM_HISTOGRAMS);
+	PH_ASSERT_LT(binIndex, NUM_HISTOGRAM_BINS);
+
+	return m_histograms[histogramIndex][binIndex];
+}
+
 inline void RenderState::setIntegerState(const std::size_t index, const IntegerState state)
 {
 	PH_ASSERT_LT(index, NUM_INTEGER_STATES);
@@ -68,16 +83,31 @@ inline void RenderState::setRealState(const std::size_t index, const RealState s
 	m_realStates[index] = state;
 }
 
+inline void RenderState::setHistogramBin(
+	const std::size_t  histogramIndex,
+	const std::size_t  binIndex,
+	const HistogramBin count)
+{
+	PH_ASSERT_LT(histogramIndex, NUM_HISTOGRAMS);
+	PH_ASSERT_LT(binIndex, NUM_HISTOGRAM_BINS);
+
+	m_histograms[histogramIndex][binIndex] = count;
+}
+
 inline constexpr std::size_t RenderState::numStates(const EType type)
 {
 	if(type == EType::INTEGER)
 	{
 		return NUM_INTEGER_STATES;
 	}
-	else
+	else if(type == EType::REAL)
 	{
 		return NUM_REAL_STATES;
 	}
+	else
+	{
+		return NUM_HISTOGRAMS;
+	}
 }
 
 }// end namespace ph
\ No newline at end of file
@@ -113,6 +113,12 @@ Renderer::Renderer(const InputPacket& packet) :
 	m_widthPx  = filmWidth;
 	m_heightPx = filmHeight;
 	m_windowPx = TAABB2D<int64>({rectX, rectY}, {rectX + rectW, rectY + rectH});
+
+	m_isDeterministic = packet.getString("deterministic", "false") == "true";
+	if(m_isDeterministic)
+	{
+		logger.log("deterministic rendering enabled");
+	}
 }
 
 SdlTypeInfo Renderer::ciTypeInfo()
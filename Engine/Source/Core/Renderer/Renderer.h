@@ -77,6 +77,11 @@ public:
 	uint32         getRenderHeightPx() const;
 	TAABB2D<int64> getRenderWindowPx() const;
 
+	// Whether the rendered result must not depend on the number of workers
+	// or their timing. Renderers trade some performance for this, e.g., by 
+	// splitting work into fixed pieces and keying randomness by them.
+	bool isDeterministic() const;
+
 	bool asyncIsUpdating() const;
 	bool asyncIsRendering() const;
 
@@ -85,6 +90,7 @@ private:
 	uint32         m_widthPx;
 	uint32         m_heightPx;
 	TAABB2D<int64> m_windowPx;
+	bool           m_isDeterministic;
 
 	std::vector<RenderWorker> m_workers;
 
@@ -121,6 +127,11 @@ inline TAABB2D<int64> Renderer::getRenderWindowPx() const
 	return m_windowPx;
 }
 
+inline bool Renderer::isDeterministic() const
+{
+	return m_isDeterministic;
+}
+
 inline bool Renderer::asyncIsUpdating() const
 {
 	return m_isUpdating.load(std::memory_order_relaxed);
@@ -163,6 +174,13 @@ inline bool Renderer::asyncIsRendering() const
 		<input name="rect-h" type="integer">
 			<description>Height of the film cropping window.</description>
 		</input>
+		<input name="deterministic" type="string">
+			<description>
+				Whether the rendered result should be identical regardless of the number of
+				threads used. Can be "true" or "false" (the default); rendering is slightly
+				slower if enabled.
+			</description>
+		</input>
 	</command>
 
 	</SDL_interface>
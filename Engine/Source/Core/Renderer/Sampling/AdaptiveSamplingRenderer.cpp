@@ -19,8 +19,9 @@
 #include "Core/Renderer/Region/GridScheduler.h"
 #include "Core/Renderer/Region/SpiralScheduler.h"
 #include "Core/Renderer/Region/SpiralGridScheduler.h"
-#include "Utility/FixedSizeThreadPool.h"
+#include "Utility/TaskGroup.h"
 #include "Utility/utility.h"
+#include "Math/Random.h"
 
 #include <cmath>
 #include <iostream>
@@ -29,6 +30,7 @@
 #include <chrono>
 #include <functional>
 #include <utility>
+#include <atomic>
 
 namespace ph
 {
@@ -82,7 +84,7 @@ void AdaptiveSamplingRenderer::doUpdate(const SdlResourcePack& data)
 	}
 
 	m_dispatcher = DammertzDispatcher(
-		numWorkers(),
+		isDeterministic() ? DETERMINISTIC_NUM_INITIAL_REGIONS : numWorkers(),
 		getRenderWindowPx(),
 		m_precisionStandard,
 		m_minSamplesPerRegion);
@@ -98,26 +100,27 @@ void AdaptiveSamplingRenderer::doUpdate(const SdlResourcePack& data)
 
 void AdaptiveSamplingRenderer::doRender()
 {
-	FixedSizeThreadPool workers(numWorkers());
+	if(isDeterministic())
+	{
+		renderInWaves();
+		return;
+	}
+
+	TaskGroup workers;
 
 	for(uint32 workerId = 0; workerId < numWorkers(); ++workerId)
 	{
-		workers.queueWork(createWork(workers, workerId));
+		workers.run(createWork(workers, workerId));
 	}
 
-	workers.waitAllWorks();
+	workers.wait();
 }
 
-std::function<void()> AdaptiveSamplingRenderer::createWork(FixedSizeThreadPool& workers, uint32 workerId)
+std::function<void()> AdaptiveSamplingRenderer::createWork(TaskGroup& workers, uint32 workerId)
 {
 	return [this, workerId, &workers]()
 	{
-		auto& renderWork    = m_renderWorks[workerId];
-		auto& filmEstimator = m_filmEstimators[workerId];
-		auto  analyzer      = m_dispatcher.createAnalyzer<REFINE_MODE>();
-
-		// DEBUG
-		auto& metaRecorder = m_metaRecorders[workerId];
+		auto analyzer = m_dispatcher.createAnalyzer<REFINE_MODE>();
 
 		float suppliedFraction = 0.0f;
 		float submittedFraction = 0.0f;
@@ -144,7 +147,7 @@ std::function<void()> AdaptiveSamplingRenderer::createWork(FixedSizeThreadPool&
 					m_freeWorkerIds.pop_back();
 					--numPendingRegions;
 
-					workers.queueWork(createWork(workers, freeWorkerId));
+					workers.run(createWork(workers, freeWorkerId));
 				}
 			}
 
@@ -152,46 +155,7 @@ std::function<void()> AdaptiveSamplingRenderer::createWork(FixedSizeThreadPool&
 				bitwise_cast<float, std::uint32_t>(suppliedFraction),
 				std::memory_order_relaxed);
 
-			filmEstimator.setFilmDimensions(
-				TVector2<int64>(getRenderWidthPx(), getRenderHeightPx()),
-				workUnit.getRegion());
-
-			const auto filmDimensions = filmEstimator.getFilmDimensions();
-			renderWork.setSampleDimensions(
-				filmDimensions.actualResPx,
-				filmDimensions.sampleWindowPx,
-				filmDimensions.effectiveWindowPx.getExtents());
-			renderWork.setSampleGenerator(std::move(sampleGenerator));
-
-			// DEBUG
-			metaRecorder.setDimensions(
-				TVector2<int64>(getRenderWidthPx(), getRenderHeightPx()),
-				workUnit.getRegion());
-			metaRecorder.clearRecords();
-
-			renderWork.onWorkReport([this, workerId]()
-			{
-				// No synchronization needed, since no other worker can have an 
-				// overlapping region with the current one.
-				m_filmEstimators[workerId].mergeFilmTo(0, m_allEffortFilm);
-				m_filmEstimators[workerId].clearFilm(0);
-
-				std::lock_guard<std::mutex> lock(m_rendererMutex);
-
-				addUpdatedRegion(m_filmEstimators[workerId].getFilmEffectiveWindowPx(), true);
-			});
-
-			renderWork.work();
-
-			// No synchronization needed, since no other worker can have an 
-			// overlapping region with the current one.
-			m_filmEstimators[workerId].mergeFilmTo(1, m_halfEffortFilm);
-			m_filmEstimators[workerId].clearFilm(1);
-			m_allEffortFilm.develop(m_allEffortFrame, workUnit.getRegion());
-			m_halfEffortFilm.develop(m_halfEffortFrame, workUnit.getRegion());
-			analyzer.analyzeFinishedRegion(workUnit.getRegion(), m_allEffortFrame, m_halfEffortFrame);
-
-			m_metaRecorders[workerId].getRecord(&m_metaFrame, {0, 0});
+			renderWorkUnit(workerId, workUnit, std::move(sampleGenerator), analyzer);
 
 			{
 				std::lock_guard<std::mutex> lock(m_rendererMutex);
@@ -205,12 +169,129 @@ std::function<void()> AdaptiveSamplingRenderer::createWork(FixedSizeThreadPool&
 			m_submittedFractionBits.store(
 				bitwise_cast<float, std::uint32_t>(submittedFraction),
 				std::memory_order_relaxed);
-
-			m_totalPaths.fetch_add(renderWork.asyncGetStatistics().numSamplesTaken, std::memory_order_relaxed);
 		}
 	};
 }
 
+// Dispatched regions never overlap, so regions of a wave can be rendered in
+// any order by any worker. Each wave waits for the previous one, and its 
+// analyzed data is fed back in dispatch order, so the sequence of regions 
+// is the same no matter how many workers there are.
+void AdaptiveSamplingRenderer::renderInWaves()
+{
+	for(std::size_t waveIndex = 0; ; ++waveIndex)
+	{
+		std::vector<WorkUnit> workUnits;
+		{
+			WorkUnit workUnit;
+			while(m_dispatcher.dispatch(&workUnit))
+			{
+				workUnits.push_back(workUnit);
+			}
+		}
+
+		if(workUnits.empty())
+		{
+			break;
+		}
+
+		std::vector<Analyzer> analyzers(workUnits.size(), m_dispatcher.createAnalyzer<REFINE_MODE>());
+		std::atomic_size_t    nextUnitIndex(0);
+
+		TaskGroup workers;
+		for(uint32 workerId = 0; workerId < numWorkers(); ++workerId)
+		{
+			workers.run([this, workerId, waveIndex, &workUnits, &analyzers, &nextUnitIndex]()
+			{
+				while(true)
+				{
+					const std::size_t unitIndex = nextUnitIndex.fetch_add(1, std::memory_order_relaxed);
+					if(unitIndex >= workUnits.size())
+					{
+						break;
+					}
+
+					std::unique_ptr<SampleGenerator> sampleGenerator;
+					{
+						std::lock_guard<std::mutex> lock(m_rendererMutex);
+
+						Random::keyThisThread(waveIndex, unitIndex);
+						sampleGenerator = m_sampleGenerator->genCopied(workUnits[unitIndex].getDepth());
+					}
+
+					renderWorkUnit(workerId, workUnits[unitIndex], std::move(sampleGenerator), analyzers[unitIndex]);
+				}
+			});
+		}
+		workers.wait();
+
+		std::lock_guard<std::mutex> lock(m_rendererMutex);
+
+		for(std::size_t unitIndex = 0; unitIndex < workUnits.size(); ++unitIndex)
+		{
+			m_dispatcher.addAnalyzedData(analyzers[unitIndex]);
+			addUpdatedRegion(workUnits[unitIndex].getRegion(), false);
+		}
+		m_numNoisyRegions.store(static_cast<uint32>(m_dispatcher.numPendingRegions()), std::memory_order_relaxed);
+	}
+}
+
+void AdaptiveSamplingRenderer::renderWorkUnit(
+	const uint32                     workerId,
+	const WorkUnit&                  workUnit,
+	std::unique_ptr<SampleGenerator> sampleGenerator,
+	Analyzer&                        analyzer)
+{
+	auto& renderWork    = m_renderWorks[workerId];
+	auto& filmEstimator = m_filmEstimators[workerId];
+
+	// DEBUG
+	auto& metaRecorder = m_metaRecorders[workerId];
+
+	filmEstimator.setFilmDimensions(
+		TVector2<int64>(getRenderWidthPx(), getRenderHeightPx()),
+		workUnit.getRegion());
+
+	const auto filmDimensions = filmEstimator.getFilmDimensions();
+	renderWork.setSampleDimensions(
+		filmDimensions.actualResPx,
+		filmDimensions.sampleWindowPx,
+		filmDimensions.effectiveWindowPx.getExtents());
+	renderWork.setSampleGenerator(std::move(sampleGenerator));
+
+	// DEBUG
+	metaRecorder.setDimensions(
+		TVector2<int64>(getRenderWidthPx(), getRenderHeightPx()),
+		workUnit.getRegion());
+	metaRecorder.clearRecords();
+
+	renderWork.onWorkReport([this, workerId]()
+	{
+		// No synchronization needed, since no other worker can have an 
+		// overlapping region with the current one.
+		m_filmEstimators[workerId].mergeFilmTo(0, m_allEffortFilm);
+		m_filmEstimators[workerId].clearFilm(0);
+
+		std::lock_guard<std::mutex> lock(m_rendererMutex);
+
+		addUpdatedRegion(m_filmEstimators[workerId].getFilmEffectiveWindowPx(), true);
+	});
+
+	renderWork.work();
+
+	// No synchronization needed, since no other worker can have an 
+	// overlapping region with the current one.
+	filmEstimator.mergeFilmTo(1, m_halfEffortFilm);
+	filmEstimator.clearFilm(1);
+	m_allEffortFilm.develop(m_allEffortFrame, workUnit.getRegion());
+	m_halfEffortFilm.develop(m_halfEffortFrame, workUnit.getRegion());
+	analyzer.analyzeFinishedRegion(workUnit.getRegion(), m_allEffortFrame, m_halfEffortFrame);
+
+	metaRecorder.getRecord(&m_metaFrame, {0, 0});
+
+	m_totalPaths.fetch_add(renderWork.asyncGetStatistics().numSamplesTaken, std::memory_order_relaxed);
+}
+
 ERegionStatus AdaptiveSamplingRenderer::asyncPollUpdatedRegion(Region* const out_region)
 {
 	PH_ASSERT(out_region != nullptr);
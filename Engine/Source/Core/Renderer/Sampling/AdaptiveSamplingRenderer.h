@@ -20,7 +20,7 @@
 namespace ph
 {
 
-class FixedSizeThreadPool;
+class TaskGroup;
 
 class AdaptiveSamplingRenderer : public SamplingRenderer, public TCommandInterface<AdaptiveSamplingRenderer>
 {
@@ -45,6 +45,12 @@ private:
 	constexpr static auto REFINE_MODE = DammertzDispatcher::ERefineMode::MIN_ERROR_DIFFERENCE;
 	//constexpr static auto REFINE_MODE = DammertzDispatcher::ERefineMode::MIDPOINT;
 
+	using Analyzer = DammertzDispatcher::TAnalyzer<REFINE_MODE>;
+
+	// used in place of the number of workers for the initial division of the
+	// image in deterministic mode
+	constexpr static uint32 DETERMINISTIC_NUM_INITIAL_REGIONS = 16;
+
 	const Scene*               m_scene;
 	const Camera*              m_camera;
 	SampleGenerator*           m_sampleGenerator;
@@ -81,7 +87,13 @@ private:
 
 	void addUpdatedRegion(const Region& region, bool isUpdating);
 
-	std::function<void()> createWork(FixedSizeThreadPool& workers, uint32 workerId);
+	std::function<void()> createWork(TaskGroup& workers, uint32 workerId);
+	void renderInWaves();
+	void renderWorkUnit(
+		uint32                           workerId, 
+		const WorkUnit&                  workUnit, 
+		std::unique_ptr<SampleGenerator> sampleGenerator,
+		Analyzer&                        analyzer);
 
 // command interface
 public:
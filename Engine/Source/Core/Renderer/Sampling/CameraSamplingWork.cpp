@@ -6,6 +6,8 @@
 #include "Core/Estimator/Integrand.h"
 #include "Utility/Timer.h"
 #include "Core/Ray.h"
+#include "Core/RayDifferential.h"
+#include "Core/Quantity/SpectralStrength.h"
 
 namespace ph
 {
@@ -73,6 +75,19 @@ void CameraSamplingWork::doWork()
 		m_sampleResPx.product(),
 		m_sampleResPx);
 
+#if defined(PH_RENDER_MODE_FULL_SPECTRAL)
+	// Wavelengths are drawn from a 1-D stage of their own instead of a third
+	// dimension of the camera stage, which would give up the 2-D 
+	// stratification of camera samples within pixels. The stages are paired
+	// by sample index, and every sample generator shuffles the order of 1-D
+	// values independently of the order of pixel samples (scrambled 
+	// sequences Owen-scramble the index of each dimension, others shuffle
+	// randomly), so the wavelengths of a pixel do not follow sample 
+	// positions.
+	Samples1DStage wavelengthSampleStage = m_sampleGenerator->declare1DStage(
+		m_sampleResPx.product());
+#endif
+
 	const Vector2D ndcScale  = m_filmWindowPx.getExtents().div(m_filmResPx);
 	const Vector2D ndcOffset = m_filmWindowPx.minVertex.div(m_filmResPx);
 
@@ -90,18 +105,37 @@ void CameraSamplingWork::doWork()
 		}
 
 		const Samples2D& camSamples = m_sampleGenerator->getSamples2D(camSampleStage);
+#if defined(PH_RENDER_MODE_FULL_SPECTRAL)
+		const Samples1D& wavelengthSamples = m_sampleGenerator->getSamples1D(wavelengthSampleStage);
+#endif
 		for(std::size_t si = 0; si < camSamples.numSamples(); si++)
 		{
+#if defined(PH_RENDER_MODE_FULL_SPECTRAL)
+			// all spectral values of this camera path, including the one 
+			// added to films, are at these wavelengths
+			SpectralStrength::sampleWavelengths(wavelengthSamples[si]);
+#endif
+
 			const Vector2D filmNdc = Vector2D(camSamples[si]).mul(ndcScale).add(ndcOffset);
 
 			Ray ray;
 			m_camera->genSensedRay(Vector2R(filmNdc), &ray);
 
+			// camera gives differentials with respect to NDC; converting to raster coordinates
+			RayDifferential rayDifferential;
+			m_camera->calcSensedRayDifferentials(Vector2R(filmNdc), ray, &rayDifferential);
+			rayDifferential.scalePartials(
+				static_cast<real>(1.0 / m_filmResPx.x),
+				static_cast<real>(1.0 / m_filmResPx.y));
+
 			for(ISensedRayProcessor* processor : m_processors)
 			{
-				processor->process(filmNdc, ray);
+				processor->process(filmNdc, ray, rayDifferential);
 			}
 		}
+#if defined(PH_RENDER_MODE_FULL_SPECTRAL)
+		SpectralStrength::clearWavelengths();
+#endif
 		m_numSamplesTaken.fetch_add(static_cast<uint32>(camSamples.numSamples()), std::memory_order_relaxed);
 
 		if(m_onWorkReport)
@@ -19,10 +19,12 @@
 #include "Core/Renderer/Region/PlateScheduler.h"
 #include "Core/Renderer/Region/StripeScheduler.h"
 #include "Core/Renderer/Region/GridScheduler.h"
-#include "Utility/FixedSizeThreadPool.h"
+#include "Utility/TaskGroup.h"
 #include "Utility/utility.h"
+#include "Math/math.h"
 #include "Core/Renderer/Region/SpiralGridScheduler.h"
 #include "Core/Renderer/Region/TileScheduler.h"
+#include "Math/Random.h"
 
 #include <cmath>
 #include <iostream>
@@ -31,10 +33,27 @@
 #include <chrono>
 #include <functional>
 #include <utility>
+#include <algorithm>
 
 namespace ph
 {
 
+namespace
+{
+
+inline void copy_frame_region(const HdrRgbFrame& srcFrame, const Region& regionPx, HdrRgbFrame& dstFrame)
+{
+	PH_ASSERT(srcFrame.getSizePx().equals(dstFrame.getSizePx()));
+
+	dstFrame.forEachPixel(TAABB2D<uint32>(regionPx), 
+		[&srcFrame](const uint32 x, const uint32 y, const HdrRgbFrame::Pixel& /* pixel */)
+		{
+			return srcFrame.getPixel({x, y});
+		});
+}
+
+}// end anonymous namespace
+
 void EqualSamplingRenderer::doUpdate(const SdlResourcePack& data)
 {
 	m_updatedRegions.clear();
@@ -57,6 +76,11 @@ void EqualSamplingRenderer::doUpdate(const SdlResourcePack& data)
 		getRenderWindowPx(), 
 		m_filter);
 
+	const auto numFilmStripes = math::ceil_div_positive<int64>(getRenderHeightPx(), FILM_STRIPE_HEIGHT_PX);
+	m_filmStripeMutexes = std::vector<std::mutex>(static_cast<std::size_t>(numFilmStripes));
+	m_workingFrame      = HdrRgbFrame(static_cast<uint32>(getRenderWidthPx()), static_cast<uint32>(getRenderHeightPx()));
+	m_peekFrame         = HdrRgbFrame(static_cast<uint32>(getRenderWidthPx()), static_cast<uint32>(getRenderHeightPx()));
+
 	m_filmEstimators.resize(numWorkers());
 	m_renderWorks.resize(numWorkers());
 	for(uint32 workerId = 0; workerId < numWorkers(); ++workerId)
@@ -70,11 +94,24 @@ void EqualSamplingRenderer::doUpdate(const SdlResourcePack& data)
 		m_renderWorks[workerId].addProcessor(&m_filmEstimators[workerId]);
 	}
 
-	// DEBUG
-	m_scheduler = std::make_unique<SpiralGridScheduler>(
-		numWorkers(),
-		WorkUnit(Region(getRenderWindowPx()), m_sampleGenerator->numSampleBatches()),
-		50);
+	if(isDeterministic())
+	{
+		// Tiles do not depend on the number of workers and their film windows
+		// never overlap, so each pixel receives the same samples in the same 
+		// order however the tiles are distributed.
+		m_scheduler = std::make_unique<TileScheduler>(
+			numWorkers(),
+			WorkUnit(Region(getRenderWindowPx()), m_sampleGenerator->numSampleBatches()),
+			Vector2S(DETERMINISTIC_TILE_SIZE_PX, DETERMINISTIC_TILE_SIZE_PX));
+	}
+	else
+	{
+		// DEBUG
+		m_scheduler = std::make_unique<SpiralGridScheduler>(
+			numWorkers(),
+			WorkUnit(Region(getRenderWindowPx()), m_sampleGenerator->numSampleBatches()),
+			50);
+	}
 
 	/*m_scheduler = std::make_unique<TileScheduler>(
 		numWorkers(),
@@ -92,11 +129,11 @@ void EqualSamplingRenderer::doUpdate(const SdlResourcePack& data)
 
 void EqualSamplingRenderer::doRender()
 {
-	FixedSizeThreadPool workers(numWorkers());
+	TaskGroup workers;
 
 	for(uint32 workerId = 0; workerId < numWorkers(); ++workerId)
 	{
-		workers.queueWork([this, workerId]()
+		workers.run([this, workerId]()
 		{
 			auto& renderWork = m_renderWorks[workerId];
 			auto& filmEstimator = m_filmEstimators[workerId];
@@ -120,6 +157,14 @@ void EqualSamplingRenderer::doRender()
 						break;
 					}
 
+					// all randomness of the work unit is derived from its first pixel
+					if(isDeterministic())
+					{
+						Random::keyThisThread(
+							static_cast<uint64>(workUnit.getRegion().minVertex.x),
+							static_cast<uint64>(workUnit.getRegion().minVertex.y));
+					}
+
 					const std::size_t spp = workUnit.getDepth();
 					sampleGenerator = m_sampleGenerator->genCopied(spp);
 				}
@@ -141,9 +186,7 @@ void EqualSamplingRenderer::doRender()
 
 				renderWork.onWorkReport([this, workerId]()
 				{
-					std::lock_guard<std::mutex> lock(m_rendererMutex);
-
-					m_filmEstimators[workerId].mergeFilmTo(0, m_mainFilm);
+					mergeToMainFilm(workerId);
 					m_filmEstimators[workerId].clearFilm(0);
 
 					addUpdatedRegion(m_filmEstimators[workerId].getFilmEffectiveWindowPx(), true);
@@ -156,10 +199,10 @@ void EqualSamplingRenderer::doRender()
 
 					m_scheduler->submit(workUnit);
 					submittedFraction = m_scheduler->getSubmittedFraction();
-
-					addUpdatedRegion(filmEstimator.getFilmEffectiveWindowPx(), false);
 				}
 
+				addUpdatedRegion(filmEstimator.getFilmEffectiveWindowPx(), false);
+
 				m_submittedFractionBits.store(
 					bitwise_cast<float, std::uint32_t>(submittedFraction),
 					std::memory_order_relaxed);
@@ -169,14 +212,14 @@ void EqualSamplingRenderer::doRender()
 		});
 	}
 
-	workers.waitAllWorks();
+	workers.wait();
 }
 
 ERegionStatus EqualSamplingRenderer::asyncPollUpdatedRegion(Region* const out_region)
 {
 	PH_ASSERT(out_region);
 
-	std::lock_guard<std::mutex> lock(m_rendererMutex);
+	std::lock_guard<std::mutex> lock(m_updatedRegionsMutex);
 
 	if(m_updatedRegions.empty())
 	{
@@ -197,19 +240,26 @@ ERegionStatus EqualSamplingRenderer::asyncPollUpdatedRegion(Region* const out_re
 	}
 }
 
-// FIXME: Peeking does not need to ensure correctness of the frame.
-// If correctness is not guaranteed, develop methods should be reimplemented. 
-// (correctness is guaranteed currently)
+// Peeking never waits for workers: stripes that are being merged at the 
+// moment keep their previously published content until the next peek.
 void EqualSamplingRenderer::asyncPeekFrame(
 	const std::size_t layerIndex,
 	const Region&     region,
 	HdrRgbFrame&      out_frame)
 {
-	std::lock_guard<std::mutex> lock(m_rendererMutex);
-
 	if(layerIndex == 0)
 	{
-		m_mainFilm.develop(out_frame, region);
+		Region frameRegion = getRenderWindowPx();
+		frameRegion.intersectWith(region);
+		if(!frameRegion.isArea())
+		{
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(m_peekFrameMutex);
+
+		publishDevelopedRegion(frameRegion, false);
+		copy_frame_region(m_peekFrame, frameRegion, out_frame);
 	}
 	else
 	{
@@ -219,11 +269,23 @@ void EqualSamplingRenderer::asyncPeekFrame(
 
 void EqualSamplingRenderer::retrieveFrame(const std::size_t layerIndex, HdrRgbFrame& out_frame)
 {
-	asyncPeekFrame(layerIndex, getRenderWindowPx(), out_frame);
+	if(layerIndex == 0)
+	{
+		std::lock_guard<std::mutex> lock(m_peekFrameMutex);
+
+		publishDevelopedRegion(getRenderWindowPx(), true);
+		copy_frame_region(m_peekFrame, getRenderWindowPx(), out_frame);
+	}
+	else
+	{
+		out_frame.fill(0, TAABB2D<uint32>(getRenderWindowPx()));
+	}
 }
 
 void EqualSamplingRenderer::addUpdatedRegion(const Region& region, const bool isUpdating)
 {
+	std::lock_guard<std::mutex> lock(m_updatedRegionsMutex);
+
 	for(UpdatedRegion& pendingRegion : m_updatedRegions)
 	{
 		// later added region takes the precedence
@@ -237,6 +299,51 @@ void EqualSamplingRenderer::addUpdatedRegion(const Region& region, const bool is
 	m_updatedRegions.push_back(UpdatedRegion{region, !isUpdating});
 }
 
+void EqualSamplingRenderer::mergeToMainFilm(const uint32 workerId)
+{
+	const Region filmWindowPx = m_filmEstimators[workerId].getFilmEffectiveWindowPx();
+
+	const int64 beginStripe = filmWindowPx.minVertex.y / FILM_STRIPE_HEIGHT_PX;
+	const int64 endStripe   = math::ceil_div_positive(filmWindowPx.maxVertex.y, FILM_STRIPE_HEIGHT_PX);
+	for(int64 stripe = beginStripe; stripe < endStripe; ++stripe)
+	{
+		Region stripeRegion = filmWindowPx;
+		stripeRegion.minVertex.y = std::max(filmWindowPx.minVertex.y, stripe * FILM_STRIPE_HEIGHT_PX);
+		stripeRegion.maxVertex.y = std::min(filmWindowPx.maxVertex.y, (stripe + 1) * FILM_STRIPE_HEIGHT_PX);
+
+		PH_ASSERT_LT(static_cast<std::size_t>(stripe), m_filmStripeMutexes.size());
+		std::lock_guard<std::mutex> lock(m_filmStripeMutexes[stripe]);
+
+		m_filmEstimators[workerId].mergeFilmTo(0, m_mainFilm, stripeRegion);
+		m_mainFilm.develop(m_workingFrame, stripeRegion);
+	}
+}
+
+void EqualSamplingRenderer::publishDevelopedRegion(const Region& region, const bool shouldWaitForWorkers)
+{
+	const int64 beginStripe = region.minVertex.y / FILM_STRIPE_HEIGHT_PX;
+	const int64 endStripe   = math::ceil_div_positive(region.maxVertex.y, FILM_STRIPE_HEIGHT_PX);
+	for(int64 stripe = beginStripe; stripe < endStripe; ++stripe)
+	{
+		Region stripeRegion = region;
+		stripeRegion.minVertex.y = std::max(region.minVertex.y, stripe * FILM_STRIPE_HEIGHT_PX);
+		stripeRegion.maxVertex.y = std::min(region.maxVertex.y, (stripe + 1) * FILM_STRIPE_HEIGHT_PX);
+
+		PH_ASSERT_LT(static_cast<std::size_t>(stripe), m_filmStripeMutexes.size());
+		std::unique_lock<std::mutex> lock(m_filmStripeMutexes[stripe], std::defer_lock);
+		if(shouldWaitForWorkers)
+		{
+			lock.lock();
+		}
+		else if(!lock.try_lock())
+		{
+			continue;
+		}
+
+		copy_frame_region(m_workingFrame, stripeRegion, m_peekFrame);
+	}
+}
+
 RenderState EqualSamplingRenderer::asyncQueryRenderState()
 {
 	uint64 totalElapsedMs  = 0;
@@ -305,7 +412,12 @@ EqualSamplingRenderer::EqualSamplingRenderer(const InputPacket& packet) :
 	m_filmEstimators(),
 
 	m_updatedRegions       (),
+	m_filmStripeMutexes    (),
+	m_workingFrame         (),
+	m_peekFrame            (),
 	m_rendererMutex        (),
+	m_updatedRegionsMutex  (),
+	m_peekFrameMutex       (),
 	m_totalPaths           (),
 	m_suppliedFractionBits (),
 	m_submittedFractionBits()
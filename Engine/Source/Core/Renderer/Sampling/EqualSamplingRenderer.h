@@ -11,8 +11,10 @@
 #include "Core/Quantity/SpectralStrength.h"
 
 #include <vector>
+#include <deque>
 #include <memory>
 #include <atomic>
+#include <mutex>
 #include <functional>
 
 namespace ph
@@ -60,13 +62,29 @@ private:
 		bool   isFinished;
 	};
 	std::deque<UpdatedRegion> m_updatedRegions;
+
+	// The main film is split into horizontal stripes, each guarded by its own
+	// mutex, so workers merging different parts of the image never wait for
+	// each other. Merged stripes are developed into the working frame by the
+	// merging worker; peeking copies from the working frame into the peek
+	// frame stripe by stripe and skips stripes that are being written.
+	std::vector<std::mutex> m_filmStripeMutexes;
+	HdrRgbFrame             m_workingFrame;
+	HdrRgbFrame             m_peekFrame;
 	
 	std::mutex           m_rendererMutex;
+	std::mutex           m_updatedRegionsMutex;
+	std::mutex           m_peekFrameMutex;
 	std::atomic_uint64_t m_totalPaths;
 	std::atomic_uint32_t m_suppliedFractionBits;
 	std::atomic_uint32_t m_submittedFractionBits;
 
 	void addUpdatedRegion(const Region& region, bool isUpdating);
+	void mergeToMainFilm(uint32 workerId);
+	void publishDevelopedRegion(const Region& region, bool shouldWaitForWorkers);
+
+	static constexpr int64       FILM_STRIPE_HEIGHT_PX      = 16;
+	static constexpr std::size_t DETERMINISTIC_TILE_SIZE_PX = 64;
 
 // command interface
 public:
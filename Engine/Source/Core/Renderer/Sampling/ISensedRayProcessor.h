@@ -7,13 +7,20 @@ namespace ph
 {
 
 class Ray;
+class RayDifferential;
 
 class ISensedRayProcessor
 {
 public:
 	virtual ~ISensedRayProcessor() = default;
 
-	virtual void process(const Vector2D& filmNdc, const Ray& sensedRay) = 0;
+	// Processes <sensedRay> generated from <filmNdc>. Differentials of the 
+	// sensed ray are with respect to raster coordinates.
+	virtual void process(
+		const Vector2D&        filmNdc, 
+		const Ray&             sensedRay, 
+		const RayDifferential& sensedRayDifferential) = 0;
+
 	virtual void onBatchStart(uint64 batchNumber);
 	virtual void onBatchFinish(uint64 batchNumber);
 };
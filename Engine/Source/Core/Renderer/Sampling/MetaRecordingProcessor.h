@@ -23,7 +23,10 @@ public:
 	MetaRecordingProcessor();
 	explicit MetaRecordingProcessor(ISensedRayProcessor* processor);
 
-	void process(const Vector2D& filmNdc, const Ray& ray) override;
+	void process(
+		const Vector2D&        filmNdc, 
+		const Ray&             ray, 
+		const RayDifferential& rayDifferential) override;
 	void onBatchStart(uint64 batchNumber) override;
 	void onBatchFinish(uint64 batchNumber) override;
 
@@ -33,7 +33,10 @@ public:
 
 	TCameraMeasurementEstimator(TCameraMeasurementEstimator&& other);
 
-	void process(const Vector2D& filmNdc, const Ray& sensedRay) override;
+	void process(
+		const Vector2D&        filmNdc, 
+		const Ray&             sensedRay, 
+		const RayDifferential& sensedRayDifferential) override;
 
 	void addEstimator(const Estimator* estimator);
 	void addFilmEstimation(std::size_t filmIndex, std::size_t estimationIndex);
@@ -44,6 +47,7 @@ public:
 	void clearFilms();
 	void clearFilm(std::size_t index);
 	void mergeFilmTo(std::size_t fromIndex, SamplingFilmType& toFilm);
+	void mergeFilmTo(std::size_t fromIndex, SamplingFilmType& toFilm, const TAABB2D<int64>& regionPx);
 
 	std::size_t            numEstimations() const;
 	TAABB2D<int64>         getFilmEffectiveWindowPx() const;
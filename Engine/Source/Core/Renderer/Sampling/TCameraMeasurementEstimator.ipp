@@ -49,12 +49,15 @@ TCameraMeasurementEstimator(TCameraMeasurementEstimator&& other) :
 
 template<typename SamplingFilmType, typename EstimationType>
 inline auto TCameraMeasurementEstimator<SamplingFilmType, EstimationType>::
-process(const Vector2D& filmNdc, const Ray& sensedRay)
+process(
+	const Vector2D&        filmNdc, 
+	const Ray&             sensedRay, 
+	const RayDifferential& sensedRayDifferential)
 	-> void
 {
 	for(const auto* estimator : m_estimators)
 	{
-		estimator->estimate(sensedRay, m_integrand, m_estimations);
+		estimator->estimate(sensedRay, sensedRayDifferential, m_integrand, m_estimations);
 	}
 
 	const Vector2D rasterPos = filmNdc * m_filmActualResFPx;
@@ -121,6 +124,16 @@ mergeFilmTo(const std::size_t fromIndex, SamplingFilmType& toFilm)
 	toFilm.mergeWith(m_films[fromIndex]);
 }
 
+template<typename SamplingFilmType, typename EstimationType>
+inline auto TCameraMeasurementEstimator<SamplingFilmType, EstimationType>::
+mergeFilmTo(const std::size_t fromIndex, SamplingFilmType& toFilm, const TAABB2D<int64>& regionPx)
+	-> void
+{
+	PH_ASSERT_LT(fromIndex, m_films.size());
+
+	toFilm.mergeWith(m_films[fromIndex], regionPx);
+}
+
 template<typename SamplingFilmType, typename EstimationType>
 inline auto TCameraMeasurementEstimator<SamplingFilmType, EstimationType>::
 setFilmDimensions(
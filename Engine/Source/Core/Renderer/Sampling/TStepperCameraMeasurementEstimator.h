@@ -24,7 +24,10 @@ public:
 	TStepperCameraMeasurementEstimator(TStepperCameraMeasurementEstimator&& other) = default;
 
 	void onBatchStart(uint64 batchNumber) override;
-	void process(const Vector2D& filmNdc, const Ray& ray) override;
+	void process(
+		const Vector2D&        filmNdc, 
+		const Ray&             ray, 
+		const RayDifferential& rayDifferential) override;
 
 	void setFilmStepSize(std::size_t filmIndex, std::size_t stepSize);
 
@@ -33,11 +33,14 @@ onBatchStart(const uint64 batchNumber)
 
 template<typename SamplingFilmType, typename EstimationType>
 inline void TStepperCameraMeasurementEstimator<SamplingFilmType, EstimationType>::
-process(const Vector2D& filmNdc, const Ray& ray)
+process(
+	const Vector2D&        filmNdc, 
+	const Ray&             ray, 
+	const RayDifferential& rayDifferential)
 {
 	for(const auto* estimator : Parent::m_estimators)
 	{
-		estimator->estimate(ray, Parent::m_integrand, Parent::m_estimations);
+		estimator->estimate(ray, rayDifferential, Parent::m_integrand, Parent::m_estimations);
 	}
 
 	const Vector2D rasterPos = filmNdc * Parent::m_filmActualResFPx;
@@ -0,0 +1,57 @@
+#include "Core/SampleGenerator/SGHalton.h"
+#include "Math/Random/low_discrepancy.h"
+#include "Math/hash.h"
+#include "FileIO/SDL/InputPacket.h"
+
+namespace ph
+{
+
+SGHalton::SGHalton(const std::size_t numSamples) :
+	SGScrambledSequence(numSamples)
+{}
+
+real SGHalton::genSequence1D(const uint64 index, const uint32 seed) const
+{
+	using namespace low_discrepancy;
+
+	// radical inverse in base 2 is simply the reversed bits
+	return fraction_to_real(owen_scramble_base2(reverse_bits(static_cast<uint32>(index)), seed));
+}
+
+Vector2R SGHalton::genSequence2D(const uint64 index, const uint32 seed) const
+{
+	using namespace low_discrepancy;
+
+	return Vector2R(
+		genSequence1D(index, hash::combine_32(seed, 0)),
+		fraction_to_real(owen_scrambled_radical_inverse(3, index, hash::combine_32(seed, 1))));
+}
+
+std::unique_ptr<SampleGenerator> SGHalton::genNewborn(const std::size_t numSamples) const
+{
+	return std::make_unique<SGHalton>(numSamples);
+}
+
+// command interface
+
+SdlTypeInfo SGHalton::ciTypeInfo()
+{
+	return SdlTypeInfo(ETypeCategory::REF_SAMPLE_GENERATOR, "halton");
+}
+
+void SGHalton::ciRegister(CommandRegister& cmdRegister)
+{
+	SdlLoader loader;
+	loader.setFunc<SGHalton>(ciLoad);
+	cmdRegister.setLoader(loader);
+}
+
+std::unique_ptr<SGHalton> SGHalton::ciLoad(const InputPacket& packet)
+{
+	const integer numSamples = packet.getInteger("sample-amount", 0, DataTreatment::REQUIRED());
+
+	// HACK: casting
+	return std::make_unique<SGHalton>(static_cast<std::size_t>(numSamples));
+}
+
+}// end namespace ph
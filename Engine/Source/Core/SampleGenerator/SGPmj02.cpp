@@ -0,0 +1,238 @@
+#include "Core/SampleGenerator/SGPmj02.h"
+#include "Math/Random/low_discrepancy.h"
+#include "Math/hash.h"
+#include "FileIO/SDL/InputPacket.h"
+#include "Common/assertion.h"
+#include "Common/Logger.h"
+
+#include <vector>
+#include <array>
+#include <random>
+#include <cstddef>
+#include <utility>
+
+namespace ph
+{
+
+namespace
+{
+
+const Logger logger(LogSender("SG PMJ02"));
+
+using Pmj02Point = std::array<uint32, 2>;
+
+constexpr uint32 LOG2_NUM_TABLE_POINTS = 12;
+
+/*
+	Generates a progressive multi-jittered (0,2) sequence as described in 
+	Christensen et al.'s paper "Progressive Multi-Jittered Sample Sequences"
+	(2018). Each new point is placed in the subquadrant diagonally opposite
+	to (or, in odd steps, beside) the one of an existing point, at a random 
+	position that leaves every elementary interval with at most one point.
+	Points are 32-bit fixed-point fractions. Returns false if some point 
+	cannot be placed, which is possible (though unlikely) with unfortunate 
+	random choices.
+*/
+bool gen_pmj02_points(
+	const uint32                   log2NumPoints,
+	std::mt19937&                  rng,
+	std::vector<Pmj02Point>* const out_points)
+{
+	PH_ASSERT(out_points);
+	PH_ASSERT_LE(log2NumPoints, 16);
+
+	const auto genBits = [&rng]()
+	{
+		return static_cast<uint32>(rng());
+	};
+
+	std::vector<Pmj02Point>& points = *out_points;
+	points.clear();
+	points.push_back({genBits(), genBits()});
+
+	std::vector<std::vector<bool>>                   isOccupied;
+	std::vector<Pmj02Point>                          subquadrants;
+	std::vector<std::pair<std::size_t, std::size_t>> candidateCells;
+	for(uint32 log2N = 0; log2N < log2NumPoints; ++log2N)
+	{
+		// Extending from N to M points; all elementary intervals of area 1/M 
+		// are going to be occupied, which is checked on the M-by-M grid of 
+		// fine cells.
+		const std::size_t N      = std::size_t(1) << log2N;
+		const uint32      log2M  = log2N + 1;
+		const std::size_t M      = std::size_t(1) << log2M;
+		const bool        isEven = log2N % 2 == 0;
+
+		// the existing points are stratified on an n-by-n grid
+		const uint32 log2n = isEven ? log2N / 2 : (log2N - 1) / 2;
+		const auto cellOf = [](const uint32 fraction, const uint32 log2Cells)
+		{
+			return log2Cells == 0 ? std::size_t(0) : static_cast<std::size_t>(fraction >> (32 - log2Cells));
+		};
+
+		// occupancy of the M elementary intervals of each shape 2^a by 2^(log2M - a)
+		isOccupied.assign(log2M + 1, std::vector<bool>(M, false));
+		const auto intervalIndex = [log2M](const uint32 a, const std::size_t fineX, const std::size_t fineY)
+		{
+			return (fineY >> a) * (std::size_t(1) << a) + (fineX >> (log2M - a));
+		};
+		const auto markOccupied = [&](const std::size_t fineX, const std::size_t fineY)
+		{
+			for(uint32 a = 0; a <= log2M; ++a)
+			{
+				isOccupied[a][intervalIndex(a, fineX, fineY)] = true;
+			}
+		};
+		for(const Pmj02Point& point : points)
+		{
+			markOccupied(cellOf(point[0], log2M), cellOf(point[1], log2M));
+		}
+
+		// Each existing point determines the subquadrant (on the 2n-by-2n grid)
+		// of a new point: the diagonally opposite one in even steps; in odd
+		// steps, one of the two remaining subquadrants, chosen randomly per 
+		// cell for both points of the cell.
+		std::vector<bool> isXFlipped(std::size_t(1) << (2 * log2n));
+		for(std::size_t i = 0; i < isXFlipped.size(); ++i)
+		{
+			isXFlipped[i] = (genBits() & 1) != 0;
+		}
+		subquadrants.resize(N);
+		for(std::size_t i = 0; i < N; ++i)
+		{
+			const auto subX = static_cast<uint32>(cellOf(points[i][0], log2n + 1));
+			const auto subY = static_cast<uint32>(cellOf(points[i][1], log2n + 1));
+			if(isEven)
+			{
+				subquadrants[i] = {subX ^ 1, subY ^ 1};
+			}
+			else
+			{
+				const std::size_t cellIndex = cellOf(points[i][1], log2n) * (std::size_t(1) << log2n) + cellOf(points[i][0], log2n);
+				subquadrants[i] = isXFlipped[cellIndex] ? Pmj02Point{subX ^ 1, subY} : Pmj02Point{subX, subY ^ 1};
+			}
+		}
+
+		const uint32 log2FinePerSub = log2M - (log2n + 1);
+		for(std::size_t i = 0; i < N; ++i)
+		{
+			candidateCells.clear();
+			for(std::size_t fy = 0; fy < (std::size_t(1) << log2FinePerSub); ++fy)
+			{
+				for(std::size_t fx = 0; fx < (std::size_t(1) << log2FinePerSub); ++fx)
+				{
+					const std::size_t fineX = (static_cast<std::size_t>(subquadrants[i][0]) << log2FinePerSub) + fx;
+					const std::size_t fineY = (static_cast<std::size_t>(subquadrants[i][1]) << log2FinePerSub) + fy;
+
+					bool isValid = true;
+					for(uint32 a = 0; a <= log2M && isValid; ++a)
+					{
+						isValid = !isOccupied[a][intervalIndex(a, fineX, fineY)];
+					}
+					if(isValid)
+					{
+						candidateCells.push_back({fineX, fineY});
+					}
+				}
+			}
+
+			if(candidateCells.empty())
+			{
+				return false;
+			}
+
+			const auto [fineX, fineY] = candidateCells[genBits() % candidateCells.size()];
+			markOccupied(fineX, fineY);
+
+			// jitter within the fine cell
+			const uint32 jitterMask = 0xFFFFFFFF >> log2M;
+			points.push_back({
+				(static_cast<uint32>(fineX) << (32 - log2M)) | (genBits() & jitterMask),
+				(static_cast<uint32>(fineY) << (32 - log2M)) | (genBits() & jitterMask)});
+		}
+	}
+
+	return true;
+}
+
+const std::vector<Pmj02Point>& pmj02_table()
+{
+	static const std::vector<Pmj02Point> table = []()
+	{
+		// fixed seed, so the table is the same for every run
+		std::mt19937 rng(2018);
+
+		std::vector<Pmj02Point> points;
+		while(!gen_pmj02_points(LOG2_NUM_TABLE_POINTS, rng, &points))
+		{
+			logger.log(ELogLevel::NOTE_MED, "retrying PMJ02 point generation");
+		}
+		return points;
+	}();
+
+	return table;
+}
+
+}// end anonymous namespace
+
+SGPmj02::SGPmj02(const std::size_t numSamples) :
+	SGScrambledSequence(numSamples)
+{
+	// build the table before rendering starts
+	pmj02_table();
+}
+
+real SGPmj02::genSequence1D(const uint64 index, const uint32 seed) const
+{
+	using namespace low_discrepancy;
+
+	// Only prefixes of the table are guaranteed to be stratified, while 1-D
+	// points are visited in shuffled blocks; the base-2 radical inverse, which
+	// is stratified in every aligned power-of-two block, is used instead.
+	return fraction_to_real(owen_scramble_base2(reverse_bits(static_cast<uint32>(index)), seed));
+}
+
+Vector2R SGPmj02::genSequence2D(const uint64 index, const uint32 seed) const
+{
+	using namespace low_discrepancy;
+
+	const std::vector<Pmj02Point>& table = pmj02_table();
+
+	// Owen scrambling keeps the stratification of every power-of-two prefix;
+	// points beyond the table are scrambled differently on each repetition.
+	const uint32 repetitionSeed = hash::combine_32(seed, static_cast<uint32>(index >> LOG2_NUM_TABLE_POINTS));
+	const Pmj02Point& point     = table[static_cast<std::size_t>(index & (table.size() - 1))];
+
+	return Vector2R(
+		fraction_to_real(owen_scramble_base2(point[0], hash::combine_32(repetitionSeed, 0))),
+		fraction_to_real(owen_scramble_base2(point[1], hash::combine_32(repetitionSeed, 1))));
+}
+
+std::unique_ptr<SampleGenerator> SGPmj02::genNewborn(const std::size_t numSamples) const
+{
+	return std::make_unique<SGPmj02>(numSamples);
+}
+
+// command interface
+
+SdlTypeInfo SGPmj02::ciTypeInfo()
+{
+	return SdlTypeInfo(ETypeCategory::REF_SAMPLE_GENERATOR, "pmj02");
+}
+
+void SGPmj02::ciRegister(CommandRegister& cmdRegister)
+{
+	SdlLoader loader;
+	loader.setFunc<SGPmj02>(ciLoad);
+	cmdRegister.setLoader(loader);
+}
+
+std::unique_ptr<SGPmj02> SGPmj02::ciLoad(const InputPacket& packet)
+{
+	const integer numSamples = packet.getInteger("sample-amount", 0, DataTreatment::REQUIRED());
+
+	// HACK: casting
+	return std::make_unique<SGPmj02>(static_cast<std::size_t>(numSamples));
+}
+
+}// end namespace ph
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Core/SampleGenerator/SGScrambledSequence.h"
+#include "Common/primitive_type.h"
+
+namespace ph
+{
+
+class SGPmj02 final : public SGScrambledSequence, public TCommandInterface<SGPmj02>
+{
+public:
+	explicit SGPmj02(std::size_t numSamples);
+
+private:
+	std::unique_ptr<SampleGenerator> genNewborn(std::size_t numSamples) const override;
+	real     genSequence1D(uint64 index, uint32 seed) const override;
+	Vector2R genSequence2D(uint64 index, uint32 seed) const override;
+
+// command interface
+public:
+	static SdlTypeInfo ciTypeInfo();
+	static void ciRegister(CommandRegister& cmdRegister);
+	static std::unique_ptr<SGPmj02> ciLoad(const InputPacket& packet);
+};
+
+}// end namespace ph
+
+/*
+	<SDL_interface>
+
+	<category>  sample-generator                  </category>
+	<type_name> pmj02                             </type_name>
+	<extend>    sample-generator.sample-generator </extend>
+
+	<name> Progressive Multi-Jittered (0,2) Sample Generator </name>
+	<description>
+		Generating samples from a progressive multi-jittered (0,2) sequence,
+		Owen scrambled per pixel. Like the Sobol generator, every power-of-two
+		prefix of a pixel's samples is stratified over all elementary intervals,
+		while being more random in appearance.
+	</description>
+
+	<command type="creator">
+		<input name="sample-amount" type="integer">
+			<description>
+				Controls the number of sample batches that will be generated.
+			</description>
+		</input>
+	</command>
+
+	</SDL_interface>
+*/
\ No newline at end of file
@@ -0,0 +1,124 @@
+#include "Core/SampleGenerator/SGScrambledSequence.h"
+#include "Math/Random.h"
+#include "Math/hash.h"
+#include "Math/math.h"
+#include "Math/Random/low_discrepancy.h"
+#include "Common/assertion.h"
+
+namespace ph
+{
+
+SGScrambledSequence::SGScrambledSequence(const std::size_t numSamples) :
+	// points are generated independently of each other, caching more than a
+	// batch would only waste memory
+	SampleGenerator(numSamples, 1),
+
+	// Generators are usually copied for each piece of work and start over
+	// from the first point; a new seed keeps their samples uncorrelated.
+	// Deterministic renderers key Random by work unit, so the seed only
+	// depends on the unit.
+	m_seed(static_cast<uint32>(Random::genSeed()))
+{}
+
+void SGScrambledSequence::genSamples1D(const Samples1DStage& stage, Samples1D* const out_array)
+{
+	PH_ASSERT(out_array);
+	PH_ASSERT_EQ(stage.numSamples(), out_array->numSamples());
+
+	// 1-D stages have a single stratum
+	const uint32 seed       = genStratumSeed(0);
+	const uint64 firstIndex = static_cast<uint64>(currentBatchIndex()) * stage.numSamples();
+	for(std::size_t i = 0; i < stage.numSamples(); ++i)
+	{
+		out_array->set(i, genPointInDim(firstIndex + i, seed, 0));
+	}
+}
+
+void SGScrambledSequence::genSamples2D(const Samples2DStage& stage, Samples2D* const out_array)
+{
+	PH_ASSERT(out_array);
+
+	const Vector2S    strataSizes = stage.getDimSizeHints();
+	const std::size_t numStrata   = strataSizes.product();
+	PH_ASSERT(numStrata > 0);
+
+	// Samples are assigned to strata in a round-robin fashion; each stratum
+	// takes the same number of points from its sequence in a batch.
+	const std::size_t pointsPerStratum = math::ceil_div_positive(out_array->numSamples(), numStrata);
+	const uint64      firstIndex       = static_cast<uint64>(currentBatchIndex()) * pointsPerStratum;
+
+	const real dx = 1.0_r / static_cast<real>(strataSizes.x);
+	const real dy = 1.0_r / static_cast<real>(strataSizes.y);
+
+	for(std::size_t i = 0; i < out_array->numSamples(); ++i)
+	{
+		const std::size_t stratumIndex = i % numStrata;
+		const std::size_t x            = stratumIndex % strataSizes.x;
+		const std::size_t y            = stratumIndex / strataSizes.x;
+
+		const Vector2R point = genSequence2D(firstIndex + i / numStrata, genStratumSeed(stratumIndex));
+		out_array->set(i,
+		               (static_cast<real>(x) + point.x) * dx,
+		               (static_cast<real>(y) + point.y) * dy);
+	}
+}
+
+void SGScrambledSequence::genSamplesND(const SamplesNDStage& stage, SamplesND* const out_array)
+{
+	PH_ASSERT(out_array);
+	PH_ASSERT_EQ(stage.numSamples(), out_array->numSamples());
+
+	const std::size_t numDims   = stage.numDim();
+	std::size_t       numStrata = 1;
+	for(std::size_t d = 0; d < numDims; ++d)
+	{
+		numStrata *= stage.getDimSizeHint(d);
+	}
+	PH_ASSERT(numStrata > 0);
+
+	// same assignment of samples to strata as 2-D stages
+	const std::size_t pointsPerStratum = math::ceil_div_positive(stage.numSamples(), numStrata);
+	const uint64      firstIndex       = static_cast<uint64>(currentBatchIndex()) * pointsPerStratum;
+
+	for(std::size_t i = 0; i < stage.numSamples(); ++i)
+	{
+		const std::size_t stratumIndex = i % numStrata;
+		const uint32      seed         = genStratumSeed(stratumIndex);
+
+		// stratum coordinates, with the first dimension varying fastest
+		std::size_t remainingIndex = stratumIndex;
+		for(std::size_t d = 0; d < numDims; ++d)
+		{
+			const std::size_t dimSize = stage.getDimSizeHint(d);
+			const std::size_t x       = remainingIndex % dimSize;
+			remainingIndex /= dimSize;
+
+			const real point = genPointInDim(firstIndex + i / numStrata, seed, d);
+			out_array->set(i, d, (static_cast<real>(x) + point) / static_cast<real>(dimSize));
+		}
+	}
+}
+
+uint32 SGScrambledSequence::genStratumSeed(const std::size_t stratumIndex) const
+{
+	const uint32 stageSeed = hash::combine_32(m_seed, static_cast<uint32>(currentStageIndex()));
+	return hash::combine_32(stageSeed, static_cast<uint32>(stratumIndex));
+}
+
+real SGScrambledSequence::genPointInDim(
+	const uint64      pointIndex,
+	const uint32      stratumSeed,
+	const std::size_t dimIndex) const
+{
+	const uint32 dimSeed = hash::combine_32(stratumSeed, static_cast<uint32>(dimIndex));
+
+	// Owen scrambling the index shuffles the points while mapping each aligned
+	// power-of-two block of indices to another one, so prefixes of the
+	// shuffled sequence are still well stratified.
+	const uint32 shuffledIndex = low_discrepancy::owen_scramble_base2(
+		static_cast<uint32>(pointIndex), hash::combine_32(dimSeed, 1));
+
+	return genSequence1D(shuffledIndex, dimSeed);
+}
+
+}// end namespace ph
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Core/SampleGenerator/SampleGenerator.h"
+#include "Common/primitive_type.h"
+#include "Math/TVector2.h"
+
+namespace ph
+{
+
+/*
+	Base for generators drawing samples from a low-discrepancy sequence. Each
+	stratum of a stage (as given by its dimensional size hints, usually one per
+	pixel) owns an independently scrambled copy of the sequence, and successive
+	sample batches take successive points from it. This way samples of a pixel
+	stay well distributed no matter how many batches have been taken so far.
+
+	1-D and N-D stages use a 1-D sequence per dimension. Each dimension is
+	scrambled with its own seed and visits the points of its sequence in its
+	own order (by Owen scrambling the point index), so dimensions are not
+	correlated with each other, nor sample slots with sequence positions.
+	Without the latter, 1-D samples at the same slot of successive batches
+	(e.g., of the same pixel) would stay in the same small interval.
+*/
+class SGScrambledSequence : public SampleGenerator
+{
+public:
+	explicit SGScrambledSequence(std::size_t numSamples);
+
+protected:
+	// Generates the <index>-th point of the sequence, scrambled by <seed>.
+	virtual real     genSequence1D(uint64 index, uint32 seed) const = 0;
+	virtual Vector2R genSequence2D(uint64 index, uint32 seed) const = 0;
+
+private:
+	void genSamples1D(const Samples1DStage& stage, Samples1D* out_array) override;
+	void genSamples2D(const Samples2DStage& stage, Samples2D* out_array) override;
+	void genSamplesND(const SamplesNDStage& stage, SamplesND* out_array) override;
+
+	uint32 genStratumSeed(std::size_t stratumIndex) const;
+
+	// Generates the <pointIndex>-th point of a stratum's sequence in
+	// dimension <dimIndex>, in [0, 1).
+	real genPointInDim(uint64 pointIndex, uint32 stratumSeed, std::size_t dimIndex) const;
+
+	uint32 m_seed;
+};
+
+}// end namespace ph
@@ -0,0 +1,61 @@
+#include "Core/SampleGenerator/SGSobol.h"
+#include "Math/Random/low_discrepancy.h"
+#include "Math/hash.h"
+#include "FileIO/SDL/InputPacket.h"
+
+namespace ph
+{
+
+SGSobol::SGSobol(const std::size_t numSamples) :
+	SGScrambledSequence(numSamples)
+{}
+
+real SGSobol::genSequence1D(const uint64 index, const uint32 seed) const
+{
+	using namespace low_discrepancy;
+
+	return fraction_to_real(owen_scramble_base2(sobol_dim0(static_cast<uint32>(index)), seed));
+}
+
+Vector2R SGSobol::genSequence2D(const uint64 index, const uint32 seed) const
+{
+	using namespace low_discrepancy;
+
+	// Following Burley's "Practical Hash-based Owen Scrambling" (2020), the
+	// index is shuffled (by Owen scrambling it) before generating the point,
+	// which keeps every power-of-two prefix the same set of points.
+	const uint32 shuffledIndex = owen_scramble_base2(static_cast<uint32>(index), seed);
+
+	return Vector2R(
+		fraction_to_real(owen_scramble_base2(sobol_dim0(shuffledIndex), hash::combine_32(seed, 0))),
+		fraction_to_real(owen_scramble_base2(sobol_dim1(shuffledIndex), hash::combine_32(seed, 1))));
+}
+
+std::unique_ptr<SampleGenerator> SGSobol::genNewborn(const std::size_t numSamples) const
+{
+	return std::make_unique<SGSobol>(numSamples);
+}
+
+// command interface
+
+SdlTypeInfo SGSobol::ciTypeInfo()
+{
+	return SdlTypeInfo(ETypeCategory::REF_SAMPLE_GENERATOR, "sobol");
+}
+
+void SGSobol::ciRegister(CommandRegister& cmdRegister)
+{
+	SdlLoader loader;
+	loader.setFunc<SGSobol>(ciLoad);
+	cmdRegister.setLoader(loader);
+}
+
+std::unique_ptr<SGSobol> SGSobol::ciLoad(const InputPacket& packet)
+{
+	const integer numSamples = packet.getInteger("sample-amount", 0, DataTreatment::REQUIRED());
+
+	// HACK: casting
+	return std::make_unique<SGSobol>(static_cast<std::size_t>(numSamples));
+}
+
+}// end namespace ph
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Core/SampleGenerator/SGScrambledSequence.h"
+#include "Common/primitive_type.h"
+
+namespace ph
+{
+
+class SGSobol final : public SGScrambledSequence, public TCommandInterface<SGSobol>
+{
+public:
+	explicit SGSobol(std::size_t numSamples);
+
+private:
+	std::unique_ptr<SampleGenerator> genNewborn(std::size_t numSamples) const override;
+	real     genSequence1D(uint64 index, uint32 seed) const override;
+	Vector2R genSequence2D(uint64 index, uint32 seed) const override;
+
+// command interface
+public:
+	static SdlTypeInfo ciTypeInfo();
+	static void ciRegister(CommandRegister& cmdRegister);
+	static std::unique_ptr<SGSobol> ciLoad(const InputPacket& packet);
+};
+
+}// end namespace ph
+
+/*
+	<SDL_interface>
+
+	<category>  sample-generator                  </category>
+	<type_name> sobol                             </type_name>
+	<extend>    sample-generator.sample-generator </extend>
+
+	<name> Sobol Sample Generator </name>
+	<description>
+		Generating samples from the Sobol sequence, Owen scrambled per pixel.
+		The first 2^n samples of a pixel are stratified over all elementary
+		intervals of area 2^-n.
+	</description>
+
+	<command type="creator">
+		<input name="sample-amount" type="integer">
+			<description>
+				Controls the number of sample batches that will be generated.
+			</description>
+		</input>
+	</command>
+
+	</SDL_interface>
+*/
\ No newline at end of file
@@ -12,7 +12,8 @@ namespace ph
 
 SGStratified::SGStratified(const std::size_t numSamples) :
 	//SampleGenerator(numSamples, numSamples)
-	SampleGenerator(numSamples, 4)// HACK
+	SampleGenerator(numSamples, 4),// HACK
+	m_rng(Random::genSeed(), Random::genSeed())
 {}
 
 void SGStratified::genSamples1D(const Samples1DStage& stage, Samples1D* const out_array)
@@ -22,11 +23,11 @@ void SGStratified::genSamples1D(const Samples1DStage& stage, Samples1D* const ou
 	const real dx = 1.0_r / static_cast<real>(out_array->numSamples());
 	for(std::size_t x = 0; x < out_array->numSamples(); ++x)
 	{
-		const real jitter = Random::genUniformReal_i0_e1();
+		const real jitter = m_rng.genUniformReal_i0_e1();
 		out_array->set(x, (static_cast<real>(x) + jitter) * dx);
 	}
 
-	out_array->perSampleShuffle();
+	out_array->perSampleShuffle(m_rng);
 }
 
 void SGStratified::genSamples2D(const Samples2DStage& stage, Samples2D* const out_array)
@@ -54,8 +55,8 @@ void SGStratified::genSamples2D(const Samples2DStage& stage, Samples2D* const ou
 		{
 			for(std::size_t x = 0; x < strataSizes.x; ++x)
 			{
-				const real jitterX = Random::genUniformReal_i0_e1();
-				const real jitterY = Random::genUniformReal_i0_e1();
+				const real jitterX = m_rng.genUniformReal_i0_e1();
+				const real jitterY = m_rng.genUniformReal_i0_e1();
 				out_array->set(currentIndex,
 				               (static_cast<real>(x) + jitterX) * dx,
 				               (static_cast<real>(y) + jitterY) * dy);
@@ -72,16 +73,31 @@ void SGStratified::genSamples2D(const Samples2DStage& stage, Samples2D* const ou
 	for(std::size_t i = currentIndex; i < out_array->numSamples(); ++i)
 	{
 		out_array->set(i, 
-		               Random::genUniformReal_i0_e1(), 
-		               Random::genUniformReal_i0_e1());
+		               m_rng.genUniformReal_i0_e1(), 
+		               m_rng.genUniformReal_i0_e1());
 	}
 
-	out_array->perSampleShuffle();
+	out_array->perSampleShuffle(m_rng);
 }
 
 void SGStratified::genSamplesND(const SamplesNDStage& stage, SamplesND* const out_array)
 {
-	// TODO
+	PH_ASSERT(out_array);
+
+	// Each dimension is stratified on its own, then dimensions are shuffled
+	// independently (Latin hypercube sampling); a full grid of strata would
+	// need exponentially many samples.
+	const real dx = 1.0_r / static_cast<real>(out_array->numSamples());
+	for(std::size_t x = 0; x < out_array->numSamples(); ++x)
+	{
+		for(std::size_t d = 0; d < out_array->numDims(); ++d)
+		{
+			const real jitter = m_rng.genUniformReal_i0_e1();
+			out_array->set(x, d, (static_cast<real>(x) + jitter) * dx);
+		}
+	}
+
+	out_array->perDimensionShuffle(m_rng);
 }
 
 std::unique_ptr<SampleGenerator> SGStratified::genNewborn(const std::size_t numSamples) const
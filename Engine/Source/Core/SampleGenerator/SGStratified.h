@@ -2,6 +2,7 @@
 
 #include "Core/SampleGenerator/SampleGenerator.h"
 #include "Common/primitive_type.h"
+#include "Math/Random/Pcg32.h"
 
 namespace ph
 {
@@ -17,6 +18,8 @@ private:
 	void genSamples2D(const Samples2DStage& stage, Samples2D* out_array) override;
 	void genSamplesND(const SamplesNDStage& stage, SamplesND* out_array) override;
 
+	Pcg32 m_rng;
+
 // command interface
 public:
 	static SdlTypeInfo ciTypeInfo();
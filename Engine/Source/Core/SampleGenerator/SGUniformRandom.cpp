@@ -11,14 +11,15 @@ namespace ph
 
 SGUniformRandom::SGUniformRandom(const std::size_t numSamples) :
 	//SampleGenerator(numSamples, numSamples)
-	SampleGenerator(numSamples, 4)// HACK
+	SampleGenerator(numSamples, 4),// HACK
+	m_rng(Random::genSeed(), Random::genSeed())
 {}
 
 void SGUniformRandom::genSamples1D(const Samples1DStage& stage, Samples1D* const out_array)
 {
 	for(std::size_t i = 0; i < out_array->numSamples(); ++i)
 	{
-		out_array->set(i, Random::genUniformReal_i0_e1());
+		out_array->set(i, m_rng.genUniformReal_i0_e1());
 	}
 }
 
@@ -27,14 +28,20 @@ void SGUniformRandom::genSamples2D(const Samples2DStage& stage, Samples2D* const
 	for(std::size_t i = 0; i < out_array->numSamples(); ++i)
 	{
 		out_array->set(i, 
-		               Random::genUniformReal_i0_e1(), 
-		               Random::genUniformReal_i0_e1());
+		               m_rng.genUniformReal_i0_e1(), 
+		               m_rng.genUniformReal_i0_e1());
 	}
 }
 
 void SGUniformRandom::genSamplesND(const SamplesNDStage& stage, SamplesND* const out_array)
 {
-	// TODO
+	for(std::size_t i = 0; i < out_array->numSamples(); ++i)
+	{
+		for(std::size_t d = 0; d < out_array->numDims(); ++d)
+		{
+			out_array->set(i, d, m_rng.genUniformReal_i0_e1());
+		}
+	}
 }
 
 std::unique_ptr<SampleGenerator> SGUniformRandom::genNewborn(const std::size_t numSamples) const
@@ -14,11 +14,13 @@ namespace ph
 
 SampleGenerator::SampleGenerator(const std::size_t numSampleBatches,
                                  const std::size_t numCachedBatches) :
-	m_numSampleBatches(numSampleBatches),
-	m_numCachedBatches(numCachedBatches),
-	m_numUsedBatches  (0),
-	m_numUsedCaches   (numCachedBatches),
-	m_totalElements   (0)
+	m_numSampleBatches (numSampleBatches),
+	m_numCachedBatches (numCachedBatches),
+	m_numUsedBatches   (0),
+	m_numUsedCaches    (numCachedBatches),
+	m_totalElements    (0),
+	m_currentBatchIndex(0),
+	m_currentStageIndex(0)
 {
 	PH_ASSERT(numCachedBatches > 0);
 }
@@ -106,6 +108,7 @@ SamplesND SampleGenerator::getSamplesND(const SamplesNDStage& stage)
 
 	return SamplesND(
 		&(m_sampleBuffer[stage.getStageIndex() + (m_numUsedCaches - 1) * stage.numElements()]),
+		stage.numDim(),
 		stage.numSamples());
 }
 
@@ -134,11 +137,19 @@ Samples2DStage SampleGenerator::declare2DStage(
 }
 
 SamplesNDStage SampleGenerator::declareNDStage(
-	const std::size_t               numElements,
+	const std::size_t               numSamples,
+	const uint32                    numDims,
 	const std::vector<std::size_t>& dimSizeHints)
 {
-	// TODO
-	return SamplesNDStage(0, 0, 0);
+	PH_ASSERT_GT(numDims, 0);
+
+	const std::size_t stageIndex = m_totalElements;
+	SamplesNDStage stage(stageIndex, numDims, numSamples, dimSizeHints);
+	m_NDStages.push_back(stage);
+
+	m_totalElements += m_numCachedBatches * stage.numElements();
+
+	return stage;
 }
 
 void SampleGenerator::allocSampleBuffer()
@@ -157,12 +168,15 @@ void SampleGenerator::genSamples1DBatch()
 {
 	for(const auto& stage1D : m_1DStages)
 	{
+		m_currentStageIndex = stage1D.getStageIndex();
 		for(std::size_t b = 0; b < m_numCachedBatches; b++)
 		{
 			Samples1D samples(
 				&(m_sampleBuffer[stage1D.getStageIndex() + b * stage1D.numElements()]),
 				stage1D.numSamples());
 
+			m_currentBatchIndex = m_numUsedBatches + b;
+
 			genSamples1D(stage1D, &samples);
 		}
 	}
@@ -172,12 +186,15 @@ void SampleGenerator::genSamples2DBatch()
 {
 	for(const auto& stage2D : m_2DStages)
 	{
+		m_currentStageIndex = stage2D.getStageIndex();
 		for(std::size_t b = 0; b < m_numCachedBatches; b++)
 		{
 			Samples2D samples(
 				&(m_sampleBuffer[stage2D.getStageIndex() + b * stage2D.numElements()]),
 				stage2D.numSamples());
 
+			m_currentBatchIndex = m_numUsedBatches + b;
+
 			genSamples2D(stage2D, &samples);
 		}
 	}
@@ -187,12 +204,16 @@ void SampleGenerator::genSamplesNDBatch()
 {
 	for(const auto& stageND : m_NDStages)
 	{
+		m_currentStageIndex = stageND.getStageIndex();
 		for(std::size_t b = 0; b < m_numCachedBatches; b++)
 		{
 			SamplesND samples(
 				&(m_sampleBuffer[stageND.getStageIndex() + b * stageND.numElements()]),
+				stageND.numDim(),
 				stageND.numSamples());
 
+			m_currentBatchIndex = m_numUsedBatches + b;
+
 			genSamplesND(stageND, &samples);
 		}
 	}
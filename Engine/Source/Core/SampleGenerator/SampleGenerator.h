@@ -35,7 +35,8 @@ public:
 		std::size_t numElements, 
 		const Vector2S& dimSizeHints = {1, 1});
 	SamplesNDStage declareNDStage(
-		std::size_t numElements, 
+		std::size_t numSamples,
+		uint32 numDims,
 		const std::vector<std::size_t>& dimSizeHints = {});
 
 	// TODO: these three methods can use a common helper method (input SamplesStageBase)
@@ -47,6 +48,12 @@ public:
 	std::size_t numCachedBatches() const;
 	bool        hasMoreBatches()   const;
 
+protected:
+	// Index of the sample batch and the stage that are being generated. Only
+	// valid during calls to genSamples<X>D().
+	std::size_t currentBatchIndex() const;
+	std::size_t currentStageIndex() const;
+
 private:
 	virtual std::unique_ptr<SampleGenerator> genNewborn(std::size_t numSamples) const = 0;
 	virtual void genSamples1D(const Samples1DStage& stage, Samples1D* out_array) = 0;
@@ -58,6 +65,8 @@ private:
 	std::size_t m_numUsedBatches;
 	std::size_t m_numUsedCaches;
 	std::size_t m_totalElements;
+	std::size_t m_currentBatchIndex;
+	std::size_t m_currentStageIndex;
 
 	std::vector<real>           m_sampleBuffer;
 	std::vector<Samples1DStage> m_1DStages;
@@ -94,6 +103,16 @@ inline bool SampleGenerator::hasMoreBatches() const
 	return m_numUsedBatches < m_numSampleBatches;
 }
 
+inline std::size_t SampleGenerator::currentBatchIndex() const
+{
+	return m_currentBatchIndex;
+}
+
+inline std::size_t SampleGenerator::currentStageIndex() const
+{
+	return m_currentStageIndex;
+}
+
 }// end namespace ph
 
 /*
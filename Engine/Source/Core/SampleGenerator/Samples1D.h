@@ -10,8 +10,8 @@ class Samples1D : public SamplesBase
 public:
 	using SamplesBase::SamplesBase;
 
-	void perSampleShuffle();
-	void perDimensionShuffle();
+	void perSampleShuffle(Pcg32& rng);
+	void perDimensionShuffle(Pcg32& rng);
 
 	inline void set(const std::size_t index, const real value)
 	{
@@ -26,14 +26,14 @@ public:
 
 // In-header Implementations:
 
-inline void Samples1D::perSampleShuffle()
+inline void Samples1D::perSampleShuffle(Pcg32& rng)
 {
-	perSampleShuffleDurstenfeld(1);
+	perSampleShuffleDurstenfeld(1, rng);
 }
 
-inline void Samples1D::perDimensionShuffle()
+inline void Samples1D::perDimensionShuffle(Pcg32& rng)
 {
-	perDimensionShuffleDurstenfeld(1);
+	perDimensionShuffleDurstenfeld(1, rng);
 }
 
 }// end namespace ph
\ No newline at end of file
@@ -10,8 +10,8 @@ class Samples2D : public SamplesBase
 public:
 	using SamplesBase::SamplesBase;
 
-	void perSampleShuffle();
-	void perDimensionShuffle();
+	void perSampleShuffle(Pcg32& rng);
+	void perDimensionShuffle(Pcg32& rng);
 
 	inline void set(const std::size_t index, const real valueX, const real valueY)
 	{
@@ -32,14 +32,14 @@ public:
 
 // In-header Implementations:
 
-inline void Samples2D::perSampleShuffle()
+inline void Samples2D::perSampleShuffle(Pcg32& rng)
 {
-	perSampleShuffleDurstenfeld(2);
+	perSampleShuffleDurstenfeld(2, rng);
 }
 
-inline void Samples2D::perDimensionShuffle()
+inline void Samples2D::perDimensionShuffle(Pcg32& rng)
 {
-	perDimensionShuffleDurstenfeld(2);
+	perDimensionShuffleDurstenfeld(2, rng);
 }
 
 }// end namespace ph
\ No newline at end of file
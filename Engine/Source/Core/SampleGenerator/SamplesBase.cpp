@@ -1,14 +1,15 @@
 #include "Core/SampleGenerator/SamplesBase.h"
-#include "Math/Random.h"
+
+#include <utility>
 
 namespace ph
 {
 
-void SamplesBase::perSampleShuffleDurstenfeld(const std::size_t dim)
+void SamplesBase::perSampleShuffleDurstenfeld(const std::size_t dim, Pcg32& rng)
 {
 	for(std::size_t s = 0; s < m_numSamples; ++s)
 	{
-		const std::size_t j = Random::genUniformIndex_iL_eU(s, m_numSamples);
+		const std::size_t j = s + rng.genUniformIndex_i0_eU(static_cast<uint32>(m_numSamples - s));
 		for(std::size_t d = 0; d < dim; ++d)
 		{
 			std::swap(m_data[s * dim + d], 
@@ -17,13 +18,13 @@ void SamplesBase::perSampleShuffleDurstenfeld(const std::size_t dim)
 	}
 }
 
-void SamplesBase::perDimensionShuffleDurstenfeld(const std::size_t dim)
+void SamplesBase::perDimensionShuffleDurstenfeld(const std::size_t dim, Pcg32& rng)
 {
 	for(std::size_t d = 0; d < dim; ++d)
 	{
 		for(std::size_t s = 0; s < m_numSamples; ++s)
 		{
-			const std::size_t j = Random::genUniformIndex_iL_eU(s, m_numSamples);
+			const std::size_t j = s + rng.genUniformIndex_i0_eU(static_cast<uint32>(m_numSamples - s));
 			std::swap(m_data[s * dim + d], 
 			          m_data[j * dim + d]);
 			
@@ -3,6 +3,7 @@
 #include "Common/primitive_type.h"
 #include "Math/TVector2.h"
 #include "Common/assertion.h"
+#include "Math/Random/Pcg32.h"
 
 #include <cstddef>
 
@@ -38,8 +39,8 @@ protected:
 
 	inline ~SamplesBase() = default;
 
-	void perSampleShuffleDurstenfeld(std::size_t dim);
-	void perDimensionShuffleDurstenfeld(std::size_t dim);
+	void perSampleShuffleDurstenfeld(std::size_t dim, Pcg32& rng);
+	void perDimensionShuffleDurstenfeld(std::size_t dim, Pcg32& rng);
 };
 
 }// end namespace ph
\ No newline at end of file
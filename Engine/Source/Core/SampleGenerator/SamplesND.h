@@ -8,38 +8,49 @@ namespace ph
 class SamplesND : public SamplesBase
 {
 public:
-	using SamplesBase::SamplesBase;
+	inline SamplesND() :
+		SamplesBase(), m_numDims(0)
+	{}
 
-	/*void perSampleShuffle();
-	void perDimensionShuffle();*/
+	inline SamplesND(real* const data, const std::size_t numDims, const std::size_t numSamples) :
+		SamplesBase(data, numSamples), m_numDims(numDims)
+	{}
 
-	inline void set(const std::size_t index, const real valueX, const real valueY)
+	void perSampleShuffle(Pcg32& rng);
+	void perDimensionShuffle(Pcg32& rng);
+
+	inline std::size_t numDims() const
 	{
-		m_data[index * 2] = valueX;
-		m_data[index * 2 + 1] = valueY;
+		return m_numDims;
 	}
 
-	inline void set(const std::size_t index, const Vector2R& value)
+	inline void set(const std::size_t index, const std::size_t dimIndex, const real value)
 	{
-		set(index, value.x, value.y);
+		PH_ASSERT_LT(dimIndex, m_numDims);
+
+		m_data[index * m_numDims + dimIndex] = value;
 	}
 
-	inline Vector2R operator [] (const std::size_t index) const
+	// Returns the <numDims()> values of a sample.
+	inline const real* operator [] (const std::size_t index) const
 	{
-		return Vector2R(m_data[index * 2], m_data[index * 2 + 1]);
+		return &(m_data[index * m_numDims]);
 	}
+
+private:
+	std::size_t m_numDims;
 };
 
 // In-header Implementations:
 
-//inline void Samples2D::perSampleShuffle()
-//{
-//	perSampleShuffleDurstenfeld(2);
-//}
-//
-//inline void Samples2D::perDimensionShuffle()
-//{
-//	perDimensionShuffleDurstenfeld(2);
-//}
-
-}// end namespace ph
\ No newline at end of file
+inline void SamplesND::perSampleShuffle(Pcg32& rng)
+{
+	perSampleShuffleDurstenfeld(m_numDims, rng);
+}
+
+inline void SamplesND::perDimensionShuffle(Pcg32& rng)
+{
+	perDimensionShuffleDurstenfeld(m_numDims, rng);
+}
+
+}// end namespace ph
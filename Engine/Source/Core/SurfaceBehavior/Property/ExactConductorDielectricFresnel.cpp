@@ -8,6 +8,25 @@
 namespace ph
 {
 
+namespace
+{
+
+template<typename Spectrum>
+inline void calc_ior_terms(
+	const real      iorOuter,
+	const Spectrum& iorInner,
+	const Spectrum& iorInnerK,
+	Spectrum* const out_en2_sub_ek2,
+	Spectrum* const out_4_mul_en2_mul_ek2)
+{
+	const Spectrum en2 = iorInner.div(iorOuter).pow(2);
+	const Spectrum ek2 = iorInnerK.div(iorOuter).pow(2);
+	*out_en2_sub_ek2       = en2.sub(ek2);
+	*out_4_mul_en2_mul_ek2 = en2.mul(ek2).mul(4);
+}
+
+}// end anonymous namespace
+
 ExactConductorDielectricFresnel::ExactConductorDielectricFresnel(
 	const real              iorOuter,
 	const SpectralStrength& iorInner,
@@ -44,6 +63,16 @@ ExactConductorDielectricFresnel::ExactConductorDielectricFresnel(
 	iorInnerN.setSampled(sampledInnerNs);
 	iorInnerK.setSampled(sampledInnerKs);
 	setIors(iorOuter, iorInnerN, iorInnerK);
+
+#if defined(PH_RENDER_MODE_FULL_SPECTRAL)
+	// In hero wavelength mode, the IORs above are constant spectra; the terms
+	// are computed on the tabulated spectra instead so the reflectance varies
+	// with the wavelengths being traced.
+	SampledSpectralStrength en2_sub_ek2, _4_mul_en2_mul_ek2;
+	calc_ior_terms(iorOuter, sampledInnerNs, sampledInnerKs, &en2_sub_ek2, &_4_mul_en2_mul_ek2);
+	m_en2_sub_ek2       = ConstantSpectralStrength(en2_sub_ek2, EQuantity::RAW);
+	m_4_mul_en2_mul_ek2 = ConstantSpectralStrength(_4_mul_en2_mul_ek2, EQuantity::RAW);
+#endif
 }
 
 // Implementation follows the excellent blog post written by Sebastien Lagarde.
@@ -63,8 +92,8 @@ void ExactConductorDielectricFresnel::calcReflectance(
 	const real cosI2 = cosI * cosI;
 	const real sinI2 = 1.0_r - cosI * cosI;
 
-	const SpectralStrength t0       = m_en2_sub_ek2.sub(sinI2);
-	const SpectralStrength a2plusb2 = t0.mul(t0).addLocal(m_4_mul_en2_mul_ek2).sqrtLocal();
+	const SpectralStrength t0       = m_en2_sub_ek2.get().sub(sinI2);
+	const SpectralStrength a2plusb2 = t0.mul(t0).addLocal(m_4_mul_en2_mul_ek2.get()).sqrtLocal();
 	const SpectralStrength a        = a2plusb2.add(t0).mulLocal(0.5_r).sqrtLocal();
 	const SpectralStrength t1       = a2plusb2.add(cosI2);
 	const SpectralStrength t2       = a.mul(2.0_r * cosI);
@@ -85,10 +114,10 @@ void ExactConductorDielectricFresnel::setIors(
 	m_iorInner  = iorInner;
 	m_iorInnerK = iorInnerK;
 
-	const SpectralStrength en2 = iorInner.div(iorOuter).pow(2);
-	const SpectralStrength ek2 = iorInnerK.div(iorOuter).pow(2);
-	m_en2_sub_ek2       = en2.sub(ek2);
-	m_4_mul_en2_mul_ek2 = en2.mul(ek2).mul(4);
+	SpectralStrength en2_sub_ek2, _4_mul_en2_mul_ek2;
+	calc_ior_terms(iorOuter, iorInner, iorInnerK, &en2_sub_ek2, &_4_mul_en2_mul_ek2);
+	m_en2_sub_ek2       = ConstantSpectralStrength(en2_sub_ek2);
+	m_4_mul_en2_mul_ek2 = ConstantSpectralStrength(_4_mul_en2_mul_ek2);
 }
 
 }// end namespace ph
\ No newline at end of file
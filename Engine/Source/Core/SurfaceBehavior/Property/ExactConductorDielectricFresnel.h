@@ -2,6 +2,7 @@
 
 #include "Core/SurfaceBehavior/Property/ConductorDielectricFresnel.h"
 #include "Core/Quantity/SpectralStrength.h"
+#include "Core/Quantity/ConstantSpectralStrength.h"
 
 #include <vector>
 
@@ -23,8 +24,8 @@ public:
 	                     SpectralStrength* out_reflectance) const override;
 
 private:
-	SpectralStrength m_en2_sub_ek2;
-	SpectralStrength m_4_mul_en2_mul_ek2;
+	ConstantSpectralStrength m_en2_sub_ek2;
+	ConstantSpectralStrength m_4_mul_en2_mul_ek2;
 
 	void setIors(real iorOuter,
 	             const SpectralStrength& iorInner,
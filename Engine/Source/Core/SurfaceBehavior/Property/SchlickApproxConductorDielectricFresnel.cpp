@@ -13,18 +13,17 @@ SchlickApproxConductorDielectricFresnel::SchlickApproxConductorDielectricFresnel
 	const SpectralStrength pos2 = iorInner.add(SpectralStrength(iorOuter)).pow(2);
 	const SpectralStrength nume = neg2.add(iorInnerK.pow(2));
 	const SpectralStrength deno = pos2.add(iorInnerK.pow(2));
-	m_f0           = nume.div(deno);
-	m_f0Complement = m_f0.complement();
+	m_f0 = ConstantSpectralStrength(nume.div(deno));
 }
 
 SchlickApproxConductorDielectricFresnel::SchlickApproxConductorDielectricFresnel(
-	const SpectralStrength& f0) : 
+	const ConstantSpectralStrength& f0) : 
 
 	// FIXME: this might cause problems if the class is used polymorphically
 	// actual IOR values are not needed by Schlick's approximation during runtime
 	ConductorDielectricFresnel(1, SpectralStrength(1), SpectralStrength(1)),
 
-	m_f0(f0), m_f0Complement(f0.complement())
+	m_f0(f0)
 {}
 
 void SchlickApproxConductorDielectricFresnel::calcReflectance(
@@ -37,7 +36,10 @@ void SchlickApproxConductorDielectricFresnel::calcReflectance(
 	//
 	const real cosI = std::abs(cosThetaIncident);
 
-	out_reflectance->setValues(m_f0Complement.mul(std::pow(1.0_r - cosI, 5)).addLocal(m_f0));
+	// f0 is resolved on each call as it may depend on the wavelengths being
+	// traced (see ConstantSpectralStrength)
+	const SpectralStrength f0 = m_f0.get();
+	out_reflectance->setValues(f0.complement().mulLocal(std::pow(1.0_r - cosI, 5)).addLocal(f0));
 }
 
 }// end namespace ph
\ No newline at end of file
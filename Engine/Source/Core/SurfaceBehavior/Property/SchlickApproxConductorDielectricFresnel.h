@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Core/SurfaceBehavior/Property/ConductorDielectricFresnel.h"
+#include "Core/Quantity/ConstantSpectralStrength.h"
 
 namespace ph
 {
@@ -11,14 +12,13 @@ public:
 	SchlickApproxConductorDielectricFresnel(real iorOuter,
 	                                        const SpectralStrength& iorInner, 
 	                                        const SpectralStrength& iorInnerK);
-	explicit SchlickApproxConductorDielectricFresnel(const SpectralStrength& f0);
+	explicit SchlickApproxConductorDielectricFresnel(const ConstantSpectralStrength& f0);
 
 	void calcReflectance(real cosThetaIncident, 
 	                     SpectralStrength* out_reflectance) const override;
 
 private:
-	SpectralStrength m_f0;
-	SpectralStrength m_f0Complement;
+	ConstantSpectralStrength m_f0;
 };
 
 }// end namespace ph
\ No newline at end of file
@@ -28,7 +28,19 @@ SurfaceHit SurfaceHit::switchChannel(const uint32 newChannel) const
 
 	HitProbe newProbe = m_recordedProbe;
 	newProbe.setChannel(newChannel);
-	return SurfaceHit(m_incidentRay, newProbe);
+
+	SurfaceHit newHit(m_incidentRay, newProbe);
+	newHit.m_incidentRayDifferential = m_incidentRayDifferential;
+	return newHit;
+}
+
+void SurfaceHit::setIncidentRayDifferential(const RayDifferential& incidentRayDifferential)
+{
+	m_incidentRayDifferential = incidentRayDifferential;
+	if(m_incidentRayDifferential.isNonZero())
+	{
+		m_incidentRayDifferential.transferToSurface(getPosition(), getGeometryNormal());
+	}
 }
 
 bool SurfaceHit::hasSurfaceOptics() const
@@ -3,6 +3,7 @@
 #include "Core/HitDetail.h"
 #include "Core/HitProbe.h"
 #include "Core/Ray.h"
+#include "Core/RayDifferential.h"
 
 namespace ph
 {
@@ -14,17 +15,21 @@ class SurfaceHit final
 {
 public:
 	inline SurfaceHit() :
-		m_incidentRay(), m_recordedProbe(), m_detail()
+		m_incidentRay(), m_recordedProbe(), m_detail(), m_incidentRayDifferential()
 	{}
 
 	inline SurfaceHit(const Ray& incidentRay, const HitProbe& probe) : 
-		m_incidentRay(incidentRay), m_recordedProbe(probe), m_detail()
+		m_incidentRay(incidentRay), m_recordedProbe(probe), m_detail(), m_incidentRayDifferential()
 	{
 		HitProbe(m_recordedProbe).calcIntersectionDetail(m_incidentRay, &m_detail);
 	}
 
 	SurfaceHit switchChannel(uint32 newChannel) const;
 
+	// Sets differentials of the incident ray, which are transferred to the
+	// hit position. They are zero (unknown) unless set.
+	void setIncidentRayDifferential(const RayDifferential& incidentRayDifferential);
+
 	bool hasSurfaceOptics() const;
 	bool hasInteriorOptics() const;
 	bool hasExteriorOptics() const;
@@ -39,6 +44,11 @@ public:
 		return m_incidentRay;
 	}
 
+	inline const RayDifferential& getIncidentRayDifferential() const
+	{
+		return m_incidentRayDifferential;
+	}
+
 	inline const Vector3R& getPosition() const
 	{
 		return m_detail.getPosition();
@@ -58,6 +68,8 @@ private:
 	Ray       m_incidentRay;
 	HitProbe  m_recordedProbe;
 	HitDetail m_detail;
+
+	RayDifferential m_incidentRayDifferential;
 };
 
 }// end namespace ph
\ No newline at end of file
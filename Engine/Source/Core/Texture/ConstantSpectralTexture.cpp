@@ -0,0 +1,19 @@
+#include "Core/Texture/ConstantSpectralTexture.h"
+#include "Common/assertion.h"
+
+namespace ph
+{
+
+ConstantSpectralTexture::ConstantSpectralTexture(const ConstantSpectralStrength& value) :
+	TTexture(),
+	m_value(value)
+{}
+
+void ConstantSpectralTexture::sample(const SampleLocation& sampleLocation, SpectralStrength* const out_value) const
+{
+	PH_ASSERT(out_value != nullptr);
+
+	*out_value = m_value.get();
+}
+
+}// end namespace ph
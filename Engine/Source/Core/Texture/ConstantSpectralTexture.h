@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Core/Texture/TTexture.h"
+#include "Core/Quantity/SpectralStrength.h"
+#include "Core/Quantity/ConstantSpectralStrength.h"
+
+namespace ph
+{
+
+/*
+	A spectral texture of a constant value. Unlike 
+	TConstantTexture<SpectralStrength>, the value is resolved to the 
+	wavelengths being traced on each sample (see ConstantSpectralStrength).
+*/
+class ConstantSpectralTexture final : public TTexture<SpectralStrength>
+{
+public:
+	explicit ConstantSpectralTexture(const ConstantSpectralStrength& value);
+
+	void sample(const SampleLocation& sampleLocation, SpectralStrength* out_value) const override;
+
+private:
+	ConstantSpectralStrength m_value;
+};
+
+}// end namespace ph
@@ -39,25 +39,38 @@ public:
 
 	inline SampleLocation(const HitDetail& hit,
 	                      const EQuantity  quantity) :
-		m_hit(hit), m_quantity(quantity)
+		m_hit(hit), m_quantity(quantity), m_dUVdX(0), m_dUVdY(0)
 	{}
 
 	inline SampleLocation(const SampleLocation& other) :
 		SampleLocation(other.m_hit, other.m_quantity)
-	{}
+	{
+		setUvDerivatives(other.m_dUVdX, other.m_dUVdY);
+	}
 
 	// Gets and sets the uvw coordinates of this sample location.
 	const Vector3R& uvw() const;
 	void setUvw(const Vector3R& uvw);
 	void setUv(const Vector2R& uv);
 
+	// Gets and sets partial derivatives of (u, v) with respect to raster 
+	// coordinates x & y, i.e., the footprint of a pixel in texture space.
+	// Both are zero if the footprint is unknown.
+	const Vector2R& getdUVdX() const;
+	const Vector2R& getdUVdY() const;
+	void setUvDerivatives(const Vector2R& dUVdX, const Vector2R& dUVdY);
+
 	// TODO: should use uvw remapper instead
-	// or update derivatives?
 	inline SampleLocation getUvwScaled(const Vector3R& scale) const
 	{
 		HitDetail newDetail = m_hit;
 		newDetail.setMisc(m_hit.getPrimitive(), m_hit.getUvw().mul(scale), m_hit.getRayT());
-		return SampleLocation(newDetail, m_quantity);
+
+		SampleLocation scaledLocation(newDetail, m_quantity);
+		scaledLocation.setUvDerivatives(
+			m_dUVdX.mul(Vector2R(scale.x, scale.y)), 
+			m_dUVdY.mul(Vector2R(scale.x, scale.y)));
+		return scaledLocation;
 	}
 
 	// Gets the expected type of the quantity being sampled.
@@ -72,6 +85,8 @@ private:
 	// perhaps just store required data here
 	HitDetail m_hit;
 	const EQuantity m_quantity;
+	Vector2R m_dUVdX;
+	Vector2R m_dUVdY;
 };
 
 // In-header Implementations:
@@ -91,4 +106,20 @@ inline void SampleLocation::setUv(const Vector2R& uv)
 	m_hit.setMisc(m_hit.getPrimitive(), Vector3R(uv.x, uv.y, 0.0_r), m_hit.getRayT());
 }
 
+inline const Vector2R& SampleLocation::getdUVdX() const
+{
+	return m_dUVdX;
+}
+
+inline const Vector2R& SampleLocation::getdUVdY() const
+{
+	return m_dUVdY;
+}
+
+inline void SampleLocation::setUvDerivatives(const Vector2R& dUVdX, const Vector2R& dUVdY)
+{
+	m_dUVdX = dUVdX;
+	m_dUVdY = dUVdY;
+}
+
 }// end namespace ph
\ No newline at end of file
@@ -44,7 +44,7 @@ public:
 	inline float64      getTexelSizeV() const { return m_texelSizeV; }
 	inline ETexWrapMode getWrapMode() const   { return m_wrapMode;   }
 
-	inline void setWrapMode(const ETexWrapMode mode)
+	inline virtual void setWrapMode(const ETexWrapMode mode)
 	{
 		m_wrapMode = mode;
 	}
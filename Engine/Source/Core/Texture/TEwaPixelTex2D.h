@@ -0,0 +1,173 @@
+#pragma once
+
+#include "Core/Texture/TMipmap.h"
+#include "Math/TVector2.h"
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <utility>
+
+namespace ph
+{
+
+/*
+	Anisotropic texture filtering by elliptically weighted average (EWA),
+	after Heckbert's and Greene's work. The footprint of a sample location
+	is an ellipse spanned by its uv derivatives, which is filtered with a
+	Gaussian over texels of the level chosen by the minor axis of the
+	ellipse. Overly eccentric ellipses are fattened to bound the number of
+	texels visited. Level 0 is sampled bilinearly if the footprint is
+	unknown.
+*/
+template<typename T, std::size_t N>
+class TEwaPixelTex2D final : public TMipmap<T, N>
+{
+public:
+	using TMipmap<T, N>::TMipmap;
+	virtual ~TEwaPixelTex2D() override = default;
+
+	virtual inline void sample(
+		const SampleLocation&  sampleLocation,
+		TTexPixel<T, N>* const out_value) const override
+	{
+		PH_ASSERT(out_value);
+
+		const Vector2R& dUVdX = sampleLocation.getdUVdX();
+		const Vector2R& dUVdY = sampleLocation.getdUVdY();
+		const float64   w     = this->getWidthPx();
+		const float64   h     = this->getHeightPx();
+
+		// ellipse axes in texels of level 0
+		Vector2D majorAxis(dUVdX.x * w, dUVdX.y * h);
+		Vector2D minorAxis(dUVdY.x * w, dUVdY.y * h);
+		float64  majorLength = std::hypot(majorAxis.x, majorAxis.y);
+		float64  minorLength = std::hypot(minorAxis.x, minorAxis.y);
+		if(majorLength < minorLength)
+		{
+			std::swap(majorAxis, minorAxis);
+			std::swap(majorLength, minorLength);
+		}
+
+		if(!(minorLength > 0.0))
+		{
+			this->getLevel(0)->sample(sampleLocation, out_value);
+			return;
+		}
+
+		if(minorLength * MAX_ANISOTROPY < majorLength)
+		{
+			const float64 scale = majorLength / (minorLength * MAX_ANISOTROPY);
+			minorAxis.mulLocal(scale);
+			minorLength *= scale;
+		}
+
+		const float64     lod   = this->toLevelOfDetail(minorLength);
+		const std::size_t level = static_cast<std::size_t>(lod);
+		const float64     t     = lod - static_cast<float64>(level);
+
+		TTexPixel<float64, N> accuPixel = filterLevel(level, sampleLocation, majorAxis, minorAxis);
+		if(level + 1 < this->numLevels() && t > 0.0)
+		{
+			accuPixel.mulLocal(1.0 - t).addLocal(
+				filterLevel(level + 1, sampleLocation, majorAxis, minorAxis).mulLocal(t));
+		}
+
+		// taking care of pixel value rounding
+		if constexpr(std::is_integral_v<T>)
+		{
+			accuPixel.addLocal(0.5);
+		}
+
+		*out_value = TTexPixel<T, N>(accuPixel);
+	}
+
+private:
+	// Filters texels of a level with the ellipse centered at the sample
+	// location; axes are in texels of level 0.
+	inline TTexPixel<float64, N> filterLevel(
+		const std::size_t     level,
+		const SampleLocation& sampleLocation,
+		const Vector2D&       majorAxis,
+		const Vector2D&       minorAxis) const
+	{
+		const TAbstractPixelTex2D<T, N>* const levelTexture = this->getLevel(level);
+		PH_ASSERT(levelTexture);
+
+		const float64 levelW = levelTexture->getWidthPx();
+		const float64 levelH = levelTexture->getHeightPx();
+
+		const Vector2D scale(levelW / this->getWidthPx(), levelH / this->getHeightPx());
+		const Vector2D axis0 = majorAxis.mul(scale);
+		const Vector2D axis1 = minorAxis.mul(scale);
+
+		// ellipse center in continuous texel coordinates, where texel
+		// centers are on integers
+		const float64 centerX = sampleLocation.uvw().x * levelW - 0.5;
+		const float64 centerY = sampleLocation.uvw().y * levelH - 0.5;
+
+		// implicit ellipse A*x^2 + B*x*y + C*y^2 = 1; adding 1 to A & C makes
+		// the ellipse cover at least a texel
+		float64 A = axis0.y * axis0.y + axis1.y * axis1.y + 1.0;
+		float64 B = -2.0 * (axis0.x * axis0.y + axis1.x * axis1.y);
+		float64 C = axis0.x * axis0.x + axis1.x * axis1.x + 1.0;
+		const float64 reciF = 1.0 / (A * C - B * B * 0.25);
+		A *= reciF;
+		B *= reciF;
+		C *= reciF;
+
+		// bounding box of the ellipse
+		const float64 det     = 4.0 * A * C - B * B;
+		const float64 reciDet = 1.0 / det;
+		const float64 extentX = 2.0 * reciDet * std::sqrt(det * C);
+		const float64 extentY = 2.0 * reciDet * std::sqrt(det * A);
+		const auto    minX    = static_cast<int64>(std::ceil(centerX - extentX));
+		const auto    maxX    = static_cast<int64>(std::floor(centerX + extentX));
+		const auto    minY    = static_cast<int64>(std::ceil(centerY - extentY));
+		const auto    maxY    = static_cast<int64>(std::floor(centerY + extentY));
+
+		// texels are fetched through the level so wrapping is handled there
+		SampleLocation texelLocation(sampleLocation);
+
+		TTexPixel<float64, N> accuPixel(0);
+		TTexPixel<T, N>       pixel;
+		float64               weightSum = 0.0;
+		for(int64 y = minY; y <= maxY; ++y)
+		{
+			const float64 dy = static_cast<float64>(y) - centerY;
+			for(int64 x = minX; x <= maxX; ++x)
+			{
+				const float64 dx = static_cast<float64>(x) - centerX;
+				const float64 r2 = A * dx * dx + B * dx * dy + C * dy * dy;
+				if(r2 >= 1.0)
+				{
+					continue;
+				}
+
+				const float64 weight = std::exp(-GAUSSIAN_ALPHA * r2) - std::exp(-GAUSSIAN_ALPHA);
+				texelLocation.setUv(Vector2R(
+					static_cast<real>((static_cast<float64>(x) + 0.5) / levelW),
+					static_cast<real>((static_cast<float64>(y) + 0.5) / levelH)));
+				levelTexture->sample(texelLocation, &pixel);
+
+				accuPixel.addLocal(TTexPixel<float64, N>(pixel).mulLocal(weight));
+				weightSum += weight;
+			}
+		}
+
+		if(weightSum > 0.0)
+		{
+			return accuPixel.divLocal(weightSum);
+		}
+		else
+		{
+			levelTexture->sample(sampleLocation, &pixel);
+			return TTexPixel<float64, N>(pixel);
+		}
+	}
+
+	static constexpr float64 MAX_ANISOTROPY = 8.0;
+	static constexpr float64 GAUSSIAN_ALPHA = 2.0;
+};
+
+}// end namespace ph
@@ -1,10 +1,17 @@
 #pragma once
 
 #include "Core/Texture/TAbstractPixelTex2D.h"
+#include "Core/Texture/TBilinearPixelTex2D.h"
+#include "Frame/TFrame.h"
+#include "Frame/_mipmap_gen.h"
+#include "Core/Texture/TTiledImage.h"
 #include "Common/assertion.h"
 
 #include <vector>
 #include <memory>
+#include <future>
+#include <cmath>
+#include <algorithm>
 
 namespace ph
 {
@@ -13,23 +20,74 @@ template<typename T, std::size_t N>
 class TMipmap : public TAbstractPixelTex2D<T, N>
 {
 public:
-	inline TMipmap() : 
+	inline TMipmap() :
 		TMipmap(1)
 	{}
 
-	explicit inline TMipmap(const std::size_t numLevels) : 
+	explicit inline TMipmap(const std::size_t numLevels) :
 		TAbstractPixelTex2D<T, N>(),
 		m_levels(numLevels, nullptr)
 	{
 		PH_ASSERT(numLevels >= 1);
 	}
 
+	// Generates all levels from <levelZero>, each of them is bilinearly
+	// sampled. Level 0 will be resized to power-of-2 dimensions if needed.
+	explicit inline TMipmap(const TFrame<T, N>& levelZero) :
+		TAbstractPixelTex2D<T, N>(),
+		m_levels()
+	{
+		std::future<mipmapgen::Mipmaps<T, N>> futureMipmaps;
+		{
+			// waits for generation when going out of scope
+			mipmapgen generator;
+			futureMipmaps = generator.genMipmaps(levelZero);
+		}
+		mipmapgen::Mipmaps<T, N> mipmaps = futureMipmaps.get();
+		PH_ASSERT(!mipmaps.empty());
+
+		this->setWidthPx(mipmaps[0].widthPx());
+		this->setHeightPx(mipmaps[0].heightPx());
+
+		m_levels.resize(mipmaps.size());
+		for(std::size_t level = 0; level < mipmaps.size(); ++level)
+		{
+			setLevel(level, std::make_unique<TBilinearPixelTex2D<T, N>>(std::move(mipmaps[level])));
+		}
+	}
+
+	// Uses all levels of <tiledImage>, each of them is bilinearly sampled.
+	explicit inline TMipmap(const std::shared_ptr<const TTiledImage<T, N>>& tiledImage) :
+		TAbstractPixelTex2D<T, N>(tiledImage->widthPx(0), tiledImage->heightPx(0)),
+		m_levels(tiledImage->numLevels())
+	{
+		PH_ASSERT_GE(tiledImage->numLevels(), 1);
+
+		for(std::size_t level = 0; level < tiledImage->numLevels(); ++level)
+		{
+			setLevel(level, std::make_unique<TBilinearPixelTex2D<T, N>>(tiledImage, level));
+		}
+	}
+
 	virtual ~TMipmap() override = default;
 
 	virtual void sample(
 		const SampleLocation&  sampleLocation,
 		TTexPixel<T, N>* const out_value) const = 0;
 
+	inline void setWrapMode(const ETexWrapMode mode) override
+	{
+		TAbstractPixelTex2D<T, N>::setWrapMode(mode);
+
+		for(auto& level : m_levels)
+		{
+			if(level)
+			{
+				level->setWrapMode(mode);
+			}
+		}
+	}
+
 	inline const TAbstractPixelTex2D<T, N>* getLevel(const std::size_t level) const
 	{
 		PH_ASSERT(level < m_levels.size());
@@ -43,16 +101,32 @@ public:
 	}
 
 protected:
-	inline void setLevel(const std::size_t level, 
+	inline void setLevel(const std::size_t level,
 	                     std::unique_ptr<TAbstractPixelTex2D<T, N>> texture)
 	{
 		PH_ASSERT(level < m_levels.size());
 
+		if(texture)
+		{
+			texture->setWrapMode(this->getWrapMode());
+		}
 		m_levels[level] = std::move(texture);
 	}
 
+	// Maps the size of a footprint, in texels of level 0, to a continuous
+	// level of detail within [0, numLevels() - 1].
+	inline float64 toLevelOfDetail(const float64 footprintTexels) const
+	{
+		if(!(footprintTexels > 1.0))
+		{
+			return 0.0;
+		}
+
+		return std::min(std::log2(footprintTexels), static_cast<float64>(numLevels() - 1));
+	}
+
 private:
 	std::vector<std::unique_ptr<TAbstractPixelTex2D<T, N>>> m_levels;
 };
 
-}// end namespace ph
\ No newline at end of file
+}// end namespace ph
@@ -2,10 +2,12 @@
 
 #include "Core/Texture/TAbstractPixelTex2D.h"
 #include "Frame/TFrame.h"
+#include "Core/Texture/TTiledImage.h"
 #include "Common/assertion.h"
 
 #include <type_traits>
 #include <utility>
+#include <memory>
 
 namespace ph
 {
@@ -20,18 +22,31 @@ public:
 
 	explicit inline TPixelTex2D(const TFrame<T, N>& frame) :
 		TAbstractPixelTex2D<T, N>(frame.widthPx(), frame.heightPx()),
-		m_frame(frame) 
+		m_frame(frame),
+		m_tiledImage(nullptr),
+		m_tiledImageLevel(0)
 	{
 		PH_ASSERT(!m_frame.isEmpty());
 	}
 
 	explicit inline TPixelTex2D(TFrame<T, N>&& frame) :
 		TAbstractPixelTex2D<T, N>(frame.widthPx(), frame.heightPx()),
-		m_frame(std::move(frame))
+		m_frame(std::move(frame)),
+		m_tiledImage(nullptr),
+		m_tiledImageLevel(0)
 	{
 		PH_ASSERT(!m_frame.isEmpty());
 	}
 
+	// Uses pixels of a level of <tiledImage>, which are loaded on demand
+	// instead of being kept in memory.
+	inline TPixelTex2D(std::shared_ptr<const TTiledImage<T, N>> tiledImage, const std::size_t level) :
+		TAbstractPixelTex2D<T, N>(tiledImage->widthPx(level), tiledImage->heightPx(level)),
+		m_frame(),
+		m_tiledImage(std::move(tiledImage)),
+		m_tiledImageLevel(level)
+	{}
+
 	void sample(
 		const SampleLocation& sampleLocation, 
 		TTexPixel<T, N>*      out_value) const override = 0;
@@ -45,20 +60,30 @@ public:
 
 		PH_ASSERT(out_pixel != nullptr);
 
-		m_frame.getPixel(x, y, out_pixel);
+		if(m_tiledImage)
+		{
+			m_tiledImage->getPixel(m_tiledImageLevel, x, y, out_pixel);
+		}
+		else
+		{
+			m_frame.getPixel(x, y, out_pixel);
+		}
 	}
 
 	inline void setPixels(const TFrame<T, N>& frame)
 	{
 		m_frame = frame;
-		setWidthPx(frame->widthPx());
-		setHeightPx(frame->heightPx());
+		m_tiledImage.reset();
+		this->setWidthPx(frame.widthPx());
+		this->setHeightPx(frame.heightPx());
 
 		PH_ASSERT(!m_frame.isEmpty());
 	}
 
 private:
-	TFrame<T, N> m_frame;
+	TFrame<T, N>                             m_frame;
+	std::shared_ptr<const TTiledImage<T, N>> m_tiledImage;
+	std::size_t                              m_tiledImageLevel;
 };
 
 }// end namespace ph
\ No newline at end of file
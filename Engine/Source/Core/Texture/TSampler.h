@@ -33,8 +33,21 @@ public:
 			channeledDetail = X.switchChannel(m_sampledChannel).getDetail();
 		}
 
+		SampleLocation sampleLocation(channeledDetail, m_sampledQuantity);
+
+		const RayDifferential& rayDifferential = X.getIncidentRayDifferential();
+		if(rayDifferential.isNonZero())
+		{
+			Vector2R dUVdX, dUVdY;
+			rayDifferential.calcPartialUVs(
+				channeledDetail.getdPdU(), 
+				channeledDetail.getdPdV(), 
+				&dUVdX, &dUVdY);
+			sampleLocation.setUvDerivatives(dUVdX, dUVdY);
+		}
+
 		OutputType value;
-		texture.sample(SampleLocation(channeledDetail, m_sampledQuantity), &value);
+		texture.sample(sampleLocation, &value);
 		return value;
 	}
 
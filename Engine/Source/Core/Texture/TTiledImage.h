@@ -0,0 +1,113 @@
+#pragma once
+
+#include "Core/Texture/TextureCache.h"
+#include "Frame/TFrame.h"
+#include "FileIO/FileSystem/Path.h"
+#include "Common/primitive_type.h"
+#include "Utility/INoncopyable.h"
+
+#include <vector>
+#include <fstream>
+#include <mutex>
+#include <cstddef>
+
+namespace ph
+{
+
+/*
+	An image with mipmap levels stored as square tiles in a file. Pixels
+	are not kept in memory; tiles are read on first access through a
+	TextureCache, so memory scales with the parts of the image that are
+	actually used. The file is only readable on platforms of the same byte
+	order. Thread-safe for concurrent reads.
+*/
+template<typename T, std::size_t N>
+class TTiledImage final : public INoncopyable
+{
+public:
+	using Pixel = typename TFrame<T, N>::Pixel;
+
+	static constexpr uint32 DEFAULT_TILE_SIZE_PX = 64;
+
+	// Writes <levels> (level 0 first) to <filePath> as tiles of
+	// <tileSizePx> by <tileSizePx> pixels. <sourceKey> is a user-defined
+	// value identifying what the levels were made from (e.g., the size 
+	// and modification time of a picture file). The file is written under 
+	// a temporary name first, so it is never seen partially written.
+	static bool save(
+		const std::vector<TFrame<T, N>>& levels,
+		const Path&                      filePath,
+		uint64                           sourceKey,
+		uint32                           tileSizePx = DEFAULT_TILE_SIZE_PX);
+
+public:
+	// Tiles go to the shared texture cache.
+	TTiledImage();
+
+	explicit TTiledImage(TextureCache* cache);
+
+	// Evicts all tiles of this image from the cache.
+	~TTiledImage();
+
+	// Opens a file written by save(). Fails if the file was saved with
+	// another type of pixel or a source key other than <sourceKey>.
+	bool open(const Path& filePath, uint64 sourceKey);
+
+	// Opens <filePath>; if that fails (including when the file is stale,
+	// i.e., of another source key), mipmaps of the frame returned by 
+	// <frameMaker> are saved to <filePath> and then opened.
+	template<typename FrameMaker>
+	bool openOrCreate(const Path& filePath, uint64 sourceKey, FrameMaker frameMaker);
+
+	// Pixels of tiles that cannot be read are zero.
+	void getPixel(std::size_t level, uint32 x, uint32 y, Pixel* out_pixel) const;
+
+	std::size_t numLevels() const;
+	uint32 widthPx(std::size_t level) const;
+	uint32 heightPx(std::size_t level) const;
+	uint32 tileSizePx() const;
+
+private:
+	// Leads a saved image, followed by a LevelHeader for each level and
+	// the tiles of all levels, starting at an aligned offset.
+	struct FileHeader
+	{
+		char   magicNumber[8];
+		uint64 pixelSignature;
+		uint64 sourceKey;
+		uint64 tileSizePx;
+		uint64 numLevels;
+		uint64 tilesOffset;
+	};
+
+	struct LevelHeader
+	{
+		uint64 widthPx;
+		uint64 heightPx;
+		uint64 numTilesX;
+		uint64 numTilesY;
+		uint64 firstTileIndex;
+	};
+
+	TextureCache*            m_cache;
+	uint64                   m_sourceId;
+	std::vector<LevelHeader> m_levels;
+	uint32                   m_tileSizePx;
+	std::size_t              m_tileBytes;
+	uint64                   m_tilesOffset;
+
+	mutable std::mutex    m_fileMutex;
+	mutable std::ifstream m_file;
+
+	TextureCache::Tile readTile(uint64 tileIndex) const;
+
+	static FileHeader makeFileHeader();
+	static std::size_t calcTileBytes(uint32 tileSizePx);
+
+	static constexpr char        FILE_MAGIC_NUMBER[8]  = {'P', 'H', 'T', 'I', 'L', 'E', '0', '2'};
+	static constexpr std::size_t FILE_TILES_ALIGNMENT = 64;
+};
+
+}// end namespace ph
+
+#include "Core/Texture/TTiledImage.ipp"
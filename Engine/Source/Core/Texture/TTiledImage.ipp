@@ -0,0 +1,305 @@
+#pragma once
+
+#include "Core/Texture/TTiledImage.h"
+#include "Frame/_mipmap_gen.h"
+#include "FileIO/FileReplacement.h"
+#include "Common/assertion.h"
+
+#include <cstring>
+#include <string>
+#include <future>
+#include <type_traits>
+#include <algorithm>
+
+namespace ph
+{
+
+template<typename T, std::size_t N>
+inline bool TTiledImage<T, N>::save(
+	const std::vector<TFrame<T, N>>& levels,
+	const Path&                      filePath,
+	const uint64                     sourceKey,
+	const uint32                     tileSizePx)
+{
+	static_assert(std::is_trivially_copyable_v<T>);
+	PH_ASSERT_GT(tileSizePx, 0);
+
+	FileHeader header = makeFileHeader();
+	header.sourceKey  = sourceKey;
+	header.tileSizePx = tileSizePx;
+	header.numLevels  = levels.size();
+
+	std::vector<LevelHeader> levelHeaders(levels.size());
+	uint64 numTiles = 0;
+	for(std::size_t level = 0; level < levels.size(); ++level)
+	{
+		LevelHeader& levelHeader = levelHeaders[level];
+		levelHeader.widthPx        = levels[level].widthPx();
+		levelHeader.heightPx       = levels[level].heightPx();
+		levelHeader.numTilesX      = (levelHeader.widthPx + tileSizePx - 1) / tileSizePx;
+		levelHeader.numTilesY      = (levelHeader.heightPx + tileSizePx - 1) / tileSizePx;
+		levelHeader.firstTileIndex = numTiles;
+
+		numTiles += levelHeader.numTilesX * levelHeader.numTilesY;
+	}
+
+	const std::size_t headerBytes = sizeof(FileHeader) + sizeof(LevelHeader) * levelHeaders.size();
+	header.tilesOffset = (headerBytes + FILE_TILES_ALIGNMENT - 1) / FILE_TILES_ALIGNMENT * FILE_TILES_ALIGNMENT;
+
+	FileReplacement replacement(filePath);
+	{
+		std::ofstream file(replacement.getTempFilePath(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+		file.write(reinterpret_cast<const char*>(&header), sizeof(FileHeader));
+		if(!levelHeaders.empty())
+		{
+			file.write(reinterpret_cast<const char*>(levelHeaders.data()), sizeof(LevelHeader) * levelHeaders.size());
+		}
+
+		const char padding[FILE_TILES_ALIGNMENT] = {};
+		file.write(padding, header.tilesOffset - headerBytes);
+
+		// pixels outside the level are zero in tiles on the edges
+		TextureCache::Tile tile(calcTileBytes(tileSizePx));
+		Pixel              pixel;
+		for(std::size_t level = 0; level < levels.size() && file.good(); ++level)
+		{
+			const LevelHeader& levelHeader = levelHeaders[level];
+			for(uint64 tileY = 0; tileY < levelHeader.numTilesY; ++tileY)
+			{
+				for(uint64 tileX = 0; tileX < levelHeader.numTilesX; ++tileX)
+				{
+					std::fill(tile.begin(), tile.end(), std::byte(0));
+					for(uint32 y = 0; y < tileSizePx; ++y)
+					{
+						for(uint32 x = 0; x < tileSizePx; ++x)
+						{
+							const uint64 levelX = tileX * tileSizePx + x;
+							const uint64 levelY = tileY * tileSizePx + y;
+							if(levelX >= levelHeader.widthPx || levelY >= levelHeader.heightPx)
+							{
+								continue;
+							}
+
+							levels[level].getPixel(static_cast<uint32>(levelX), static_cast<uint32>(levelY), &pixel);
+
+							std::byte* const pixelData = tile.data() + (y * tileSizePx + x) * sizeof(T) * N;
+							for(std::size_t i = 0; i < N; ++i)
+							{
+								std::memcpy(pixelData + i * sizeof(T), &(pixel[i]), sizeof(T));
+							}
+						}
+					}
+
+					file.write(reinterpret_cast<const char*>(tile.data()), tile.size());
+				}
+			}
+		}
+
+		if(!file.good())
+		{
+			return false;
+		}
+	}
+
+	return replacement.commit();
+}
+
+template<typename T, std::size_t N>
+inline TTiledImage<T, N>::TTiledImage() :
+	TTiledImage(&TextureCache::getShared())
+{}
+
+template<typename T, std::size_t N>
+inline TTiledImage<T, N>::TTiledImage(TextureCache* const cache) :
+	m_cache      (cache),
+	m_sourceId   (0),
+	m_levels     (),
+	m_tileSizePx (0),
+	m_tileBytes  (0),
+	m_tilesOffset(0),
+	m_fileMutex  (),
+	m_file       ()
+{
+	PH_ASSERT(m_cache);
+
+	m_sourceId = m_cache->newSourceId();
+}
+
+template<typename T, std::size_t N>
+inline TTiledImage<T, N>::~TTiledImage()
+{
+	m_cache->removeSource(m_sourceId);
+}
+
+template<typename T, std::size_t N>
+inline bool TTiledImage<T, N>::open(const Path& filePath, const uint64 sourceKey)
+{
+	std::lock_guard<std::mutex> lock(m_fileMutex);
+
+	// tiles of a previously opened file must not be mistaken for new ones
+	m_cache->removeSource(m_sourceId);
+	m_sourceId = m_cache->newSourceId();
+	m_levels.clear();
+
+	m_file = std::ifstream(filePath.toAbsoluteString(), std::ios_base::in | std::ios_base::binary);
+	if(!m_file.good())
+	{
+		return false;
+	}
+
+	FileHeader header;
+	m_file.read(reinterpret_cast<char*>(&header), sizeof(FileHeader));
+
+	const FileHeader expectedHeader = makeFileHeader();
+	if(!m_file.good()                                                                                  ||
+	   std::memcmp(header.magicNumber, expectedHeader.magicNumber, sizeof(header.magicNumber)) != 0 ||
+	   header.pixelSignature != expectedHeader.pixelSignature                                         ||
+	   header.sourceKey != sourceKey                                                                  ||
+	   header.tileSizePx == 0 || header.numLevels == 0)
+	{
+		m_file.close();
+		return false;
+	}
+
+	std::vector<LevelHeader> levelHeaders(static_cast<std::size_t>(header.numLevels));
+	m_file.read(reinterpret_cast<char*>(levelHeaders.data()), sizeof(LevelHeader) * levelHeaders.size());
+	if(!m_file.good())
+	{
+		m_file.close();
+		return false;
+	}
+
+	m_levels      = std::move(levelHeaders);
+	m_tileSizePx  = static_cast<uint32>(header.tileSizePx);
+	m_tileBytes   = calcTileBytes(m_tileSizePx);
+	m_tilesOffset = header.tilesOffset;
+	return true;
+}
+
+template<typename T, std::size_t N>
+template<typename FrameMaker>
+inline bool TTiledImage<T, N>::openOrCreate(const Path& filePath, const uint64 sourceKey, FrameMaker frameMaker)
+{
+	if(open(filePath, sourceKey))
+	{
+		return true;
+	}
+
+	std::future<mipmapgen::Mipmaps<T, N>> futureMipmaps;
+	{
+		// waits for generation when going out of scope
+		mipmapgen generator;
+		futureMipmaps = generator.genMipmaps(frameMaker());
+	}
+
+	return save(futureMipmaps.get(), filePath, sourceKey) && open(filePath, sourceKey);
+}
+
+template<typename T, std::size_t N>
+inline void TTiledImage<T, N>::getPixel(
+	const std::size_t level,
+	const uint32      x,
+	const uint32      y,
+	Pixel* const      out_pixel) const
+{
+	PH_ASSERT_LT(level, m_levels.size());
+	PH_ASSERT(out_pixel);
+
+	const LevelHeader& levelHeader = m_levels[level];
+	PH_ASSERT_LT(x, levelHeader.widthPx);
+	PH_ASSERT_LT(y, levelHeader.heightPx);
+
+	const uint32 tileX     = x / m_tileSizePx;
+	const uint32 tileY     = y / m_tileSizePx;
+	const uint64 tileIndex = levelHeader.firstTileIndex + tileY * levelHeader.numTilesX + tileX;
+
+	// the tile stays valid for this lookup, no reference to it is kept
+	const TextureCache::Tile* const tile = m_cache->getTileForThread(m_sourceId, tileIndex,
+		[this, tileIndex]()
+		{
+			return readTile(tileIndex);
+		});
+
+	const std::size_t pixelIndex = (y % m_tileSizePx) * m_tileSizePx + (x % m_tileSizePx);
+	const std::byte*  pixelData  = tile->data() + pixelIndex * sizeof(T) * N;
+	for(std::size_t i = 0; i < N; ++i)
+	{
+		std::memcpy(&((*out_pixel)[i]), pixelData + i * sizeof(T), sizeof(T));
+	}
+}
+
+template<typename T, std::size_t N>
+inline std::size_t TTiledImage<T, N>::numLevels() const
+{
+	return m_levels.size();
+}
+
+template<typename T, std::size_t N>
+inline uint32 TTiledImage<T, N>::widthPx(const std::size_t level) const
+{
+	PH_ASSERT_LT(level, m_levels.size());
+
+	return static_cast<uint32>(m_levels[level].widthPx);
+}
+
+template<typename T, std::size_t N>
+inline uint32 TTiledImage<T, N>::heightPx(const std::size_t level) const
+{
+	PH_ASSERT_LT(level, m_levels.size());
+
+	return static_cast<uint32>(m_levels[level].heightPx);
+}
+
+template<typename T, std::size_t N>
+inline uint32 TTiledImage<T, N>::tileSizePx() const
+{
+	return m_tileSizePx;
+}
+
+template<typename T, std::size_t N>
+inline TextureCache::Tile TTiledImage<T, N>::readTile(const uint64 tileIndex) const
+{
+	TextureCache::Tile tile(m_tileBytes, std::byte(0));
+
+	std::lock_guard<std::mutex> lock(m_fileMutex);
+
+	m_file.clear();
+	m_file.seekg(static_cast<std::streamoff>(m_tilesOffset + tileIndex * m_tileBytes));
+	m_file.read(reinterpret_cast<char*>(tile.data()), static_cast<std::streamsize>(tile.size()));
+	if(!m_file.good())
+	{
+		std::fill(tile.begin(), tile.end(), std::byte(0));
+	}
+
+	return tile;
+}
+
+template<typename T, std::size_t N>
+inline auto TTiledImage<T, N>::makeFileHeader()
+	-> FileHeader
+{
+	FileHeader header = {};
+	std::memcpy(header.magicNumber, FILE_MAGIC_NUMBER, sizeof(header.magicNumber));
+
+	// Pixel types are told apart by their component type and count; byte
+	// order is detected from a 16-bit value.
+	const uint16 byteOrderProbe = 1;
+	uint8 firstByte;
+	std::memcpy(&firstByte, &byteOrderProbe, 1);
+	header.pixelSignature =
+		static_cast<uint64>(sizeof(T)) |
+		static_cast<uint64>(std::is_floating_point_v<T>) << 8 |
+		static_cast<uint64>(std::is_signed_v<T>) << 9 |
+		static_cast<uint64>(N) << 16 |
+		static_cast<uint64>(firstByte) << 32;
+
+	return header;
+}
+
+template<typename T, std::size_t N>
+inline std::size_t TTiledImage<T, N>::calcTileBytes(const uint32 tileSizePx)
+{
+	return static_cast<std::size_t>(tileSizePx) * tileSizePx * sizeof(T) * N;
+}
+
+}// end namespace ph
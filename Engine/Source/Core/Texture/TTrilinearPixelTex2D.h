@@ -2,8 +2,18 @@
 
 #include "Core/Texture/TMipmap.h"
 
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
 namespace ph
 {
+
+/*
+	Samples the two levels closest to the footprint of a sample location
+	bilinearly, then linearly interpolates between them. Level 0 is used if
+	the footprint is unknown.
+*/
 template<typename T, std::size_t N>
 class TTrilinearPixelTex2D final : public TMipmap<T, N>
 {
@@ -15,14 +25,47 @@ public:
 		const SampleLocation&  sampleLocation,
 		TTexPixel<T, N>* const out_value) const override
 	{
-		// TODO
+		PH_ASSERT(out_value);
+
+		const Vector2R& dUVdX = sampleLocation.getdUVdX();
+		const Vector2R& dUVdY = sampleLocation.getdUVdY();
+		const float64   w     = this->getWidthPx();
+		const float64   h     = this->getHeightPx();
+
+		const float64 footprintTexels = std::max(
+			std::hypot(dUVdX.x * w, dUVdX.y * h),
+			std::hypot(dUVdY.x * w, dUVdY.y * h));
+
+		const float64     lod   = this->toLevelOfDetail(footprintTexels);
+		const std::size_t level = static_cast<std::size_t>(lod);
+		const float64     t     = lod - static_cast<float64>(level);
+		if(level + 1 >= this->numLevels() || t == 0.0)
+		{
+			this->getLevel(level)->sample(sampleLocation, out_value);
+			return;
+		}
+
+		TTexPixel<T, N> finerPixel, coarserPixel;
+		this->getLevel(level)->sample(sampleLocation, &finerPixel);
+		this->getLevel(level + 1)->sample(sampleLocation, &coarserPixel);
+
+		TTexPixel<float64, N> accuPixel(finerPixel);
+		accuPixel.mulLocal(1.0 - t).addLocal(TTexPixel<float64, N>(coarserPixel).mulLocal(t));
+
+		// taking care of pixel value rounding
+		if constexpr(std::is_integral_v<T>)
+		{
+			accuPixel.addLocal(0.5);
+		}
+
+		*out_value = TTexPixel<T, N>(accuPixel);
 	}
 
 	inline void setMipLevel(const std::size_t level,
-	                     std::unique_ptr<TAbstractPixelTex2D<T, N>> texture)
+	                        std::unique_ptr<TAbstractPixelTex2D<T, N>> texture)
 	{
-		setLevel(level, std::move(texture));
+		this->setLevel(level, std::move(texture));
 	}
-};	
+};
 
-}// end namespace ph
\ No newline at end of file
+}// end namespace ph
@@ -0,0 +1,91 @@
+#include "Core/Texture/TextureCache.h"
+
+namespace ph
+{
+
+namespace
+{
+	constexpr std::size_t DEFAULT_MEMORY_BUDGET_MB = 1024;
+}
+
+TextureCache& TextureCache::getShared()
+{
+	static TextureCache cache(DEFAULT_MEMORY_BUDGET_MB * 1024 * 1024);
+
+	return cache;
+}
+
+TextureCache::TextureCache(const std::size_t memoryBudgetBytes) :
+	m_shards(),
+	m_memoryBudgetBytes(memoryBudgetBytes),
+	m_numHits(0),
+	m_numMisses(0)
+{}
+
+uint64 TextureCache::newSourceId()
+{
+	static std::atomic<uint64> nextSourceId(0);
+
+	return nextSourceId.fetch_add(1, std::memory_order_relaxed);
+}
+
+void TextureCache::removeSource(const uint64 sourceId)
+{
+	for(Shard& shard : m_shards)
+	{
+		std::lock_guard<std::mutex> lock(shard.mutex);
+
+		for(auto iter = shard.lruList.begin(); iter != shard.lruList.end();)
+		{
+			if(iter->first.sourceId == sourceId)
+			{
+				shard.numBytes -= iter->second->size();
+				shard.tiles.erase(iter->first);
+				iter = shard.lruList.erase(iter);
+			}
+			else
+			{
+				++iter;
+			}
+		}
+	}
+}
+
+void TextureCache::setMemoryBudget(const std::size_t memoryBudgetBytes)
+{
+	m_memoryBudgetBytes.store(memoryBudgetBytes, std::memory_order_relaxed);
+
+	for(Shard& shard : m_shards)
+	{
+		std::lock_guard<std::mutex> lock(shard.mutex);
+
+		evictLocked(shard);
+	}
+}
+
+std::size_t TextureCache::memoryUsage() const
+{
+	std::size_t numBytes = 0;
+	for(const Shard& shard : m_shards)
+	{
+		std::lock_guard<std::mutex> lock(shard.mutex);
+
+		numBytes += shard.numBytes;
+	}
+	return numBytes;
+}
+
+void TextureCache::evictLocked(Shard& shard)
+{
+	const std::size_t shardBudgetBytes = getMemoryBudget() / NUM_SHARDS;
+	while(shard.numBytes > shardBudgetBytes && shard.lruList.size() > 1)
+	{
+		const auto& leastRecentlyUsed = shard.lruList.back();
+
+		shard.numBytes -= leastRecentlyUsed.second->size();
+		shard.tiles.erase(leastRecentlyUsed.first);
+		shard.lruList.pop_back();
+	}
+}
+
+}// end namespace ph
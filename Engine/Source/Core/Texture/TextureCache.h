@@ -0,0 +1,225 @@
+#pragma once
+
+#include "Common/primitive_type.h"
+#include "Common/assertion.h"
+#include "Utility/INoncopyable.h"
+
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace ph
+{
+
+/*
+	A thread-safe cache of texture tiles under a memory budget. Tiles are
+	loaded on first access and the least recently used ones are evicted
+	once the budget is exceeded; tiles in use stay alive until released.
+	Tiles are identified by the source they are from and an index within
+	the source. To reduce contention between render workers, tiles are
+	spread over shards with separate locks and equal shares of the budget.
+	Each thread additionally keeps its most recently used tiles, so 
+	repeated accesses to the same tiles need no lock (see 
+	getTileForThread()). An engine-wide instance can be obtained via 
+	getShared().
+*/
+class TextureCache final : public INoncopyable
+{
+public:
+	using Tile = std::vector<std::byte>;
+
+	// The cache shared by all tiled textures of the engine.
+	static TextureCache& getShared();
+
+public:
+	explicit TextureCache(std::size_t memoryBudgetBytes);
+
+	// Obtains a tile. On a miss, <tileLoader> is called without any lock
+	// held to produce the tile (as a Tile). Concurrent misses of the same
+	// tile may load it more than once, only one of them is kept.
+	template<typename TileLoader>
+	std::shared_ptr<const Tile> getTile(uint64 sourceId, uint64 tileIndex, TileLoader tileLoader);
+
+	// Similar to getTile(), but looks into a small cache of the calling 
+	// thread first, which takes neither a lock nor a reference count. The 
+	// returned tile is valid until the calling thread calls this method 
+	// again. Hits of the thread's cache are not counted by numHits(); its 
+	// tiles are kept alive even if evicted or removed from this cache, 
+	// until replaced by other tiles.
+	template<typename TileLoader>
+	const Tile* getTileForThread(uint64 sourceId, uint64 tileIndex, TileLoader tileLoader);
+
+	// Obtains an ID for a new source of tiles. IDs are unique among all
+	// caches.
+	uint64 newSourceId();
+
+	// Evicts all tiles of a source, e.g., when it is destroyed.
+	void removeSource(uint64 sourceId);
+
+	void setMemoryBudget(std::size_t memoryBudgetBytes);
+
+	std::size_t getMemoryBudget() const;
+	std::size_t memoryUsage() const;
+	std::size_t numHits() const;
+	std::size_t numMisses() const;
+
+private:
+	struct TileKey
+	{
+		uint64 sourceId;
+		uint64 tileIndex;
+
+		bool operator == (const TileKey& other) const;
+	};
+
+	struct TileKeyHash
+	{
+		std::size_t operator () (const TileKey& key) const;
+	};
+
+	using LruList = std::list<std::pair<TileKey, std::shared_ptr<const Tile>>>;
+
+	struct ThreadTile
+	{
+		TileKey                     key;
+		std::shared_ptr<const Tile> tile;
+	};
+
+	// Most recently used tiles are at the front of <lruList>.
+	struct Shard
+	{
+		mutable std::mutex                                          mutex;
+		LruList                                                     lruList;
+		std::unordered_map<TileKey, LruList::iterator, TileKeyHash> tiles;
+		std::size_t                                                 numBytes = 0;
+	};
+
+	static constexpr std::size_t NUM_SHARDS       = 32;
+	static constexpr std::size_t NUM_THREAD_TILES = 8;
+
+	std::array<Shard, NUM_SHARDS> m_shards;
+	std::atomic<std::size_t>      m_memoryBudgetBytes;
+	std::atomic<std::size_t>      m_numHits;
+	std::atomic<std::size_t>      m_numMisses;
+
+	Shard& getShard(const TileKey& key);
+
+	// Evicts least recently used tiles of <shard> until it is within its
+	// share of the budget; the most recently used tile is always kept.
+	// <shard> must be locked.
+	void evictLocked(Shard& shard);
+};
+
+// In-header Implementations:
+
+template<typename TileLoader>
+inline auto TextureCache::getTile(const uint64 sourceId, const uint64 tileIndex, TileLoader tileLoader)
+	-> std::shared_ptr<const Tile>
+{
+	const TileKey key{sourceId, tileIndex};
+	Shard& shard = getShard(key);
+
+	{
+		std::lock_guard<std::mutex> lock(shard.mutex);
+
+		const auto result = shard.tiles.find(key);
+		if(result != shard.tiles.end())
+		{
+			shard.lruList.splice(shard.lruList.begin(), shard.lruList, result->second);
+			m_numHits.fetch_add(1, std::memory_order_relaxed);
+			return result->second->second;
+		}
+	}
+
+	m_numMisses.fetch_add(1, std::memory_order_relaxed);
+	auto loadedTile = std::make_shared<const Tile>(tileLoader());
+
+	std::lock_guard<std::mutex> lock(shard.mutex);
+
+	// another thread may have loaded the same tile in the meantime
+	const auto result = shard.tiles.find(key);
+	if(result != shard.tiles.end())
+	{
+		shard.lruList.splice(shard.lruList.begin(), shard.lruList, result->second);
+		return result->second->second;
+	}
+
+	shard.lruList.emplace_front(key, loadedTile);
+	shard.tiles[key] = shard.lruList.begin();
+	shard.numBytes += loadedTile->size();
+	evictLocked(shard);
+
+	return loadedTile;
+}
+
+template<typename TileLoader>
+inline auto TextureCache::getTileForThread(const uint64 sourceId, const uint64 tileIndex, TileLoader tileLoader)
+	-> const Tile*
+{
+	// Shared by all caches, which is safe as source IDs are unique among 
+	// them. A handful of tiles is searched linearly and replaced in round 
+	// robin order, so tiles of a footprint never replace each other.
+	thread_local std::array<ThreadTile, NUM_THREAD_TILES> threadTiles;
+	thread_local std::size_t                              nextReplacedIndex = 0;
+
+	const TileKey key{sourceId, tileIndex};
+	for(const ThreadTile& threadTile : threadTiles)
+	{
+		if(threadTile.tile && threadTile.key == key)
+		{
+			return threadTile.tile.get();
+		}
+	}
+
+	ThreadTile& threadTile = threadTiles[nextReplacedIndex];
+	nextReplacedIndex = (nextReplacedIndex + 1) % NUM_THREAD_TILES;
+
+	threadTile.tile = getTile(sourceId, tileIndex, std::move(tileLoader));
+	threadTile.key  = key;
+	return threadTile.tile.get();
+}
+
+inline std::size_t TextureCache::getMemoryBudget() const
+{
+	return m_memoryBudgetBytes.load(std::memory_order_relaxed);
+}
+
+inline std::size_t TextureCache::numHits() const
+{
+	return m_numHits.load(std::memory_order_relaxed);
+}
+
+inline std::size_t TextureCache::numMisses() const
+{
+	return m_numMisses.load(std::memory_order_relaxed);
+}
+
+inline bool TextureCache::TileKey::operator == (const TileKey& other) const
+{
+	return sourceId == other.sourceId && tileIndex == other.tileIndex;
+}
+
+inline std::size_t TextureCache::TileKeyHash::operator () (const TileKey& key) const
+{
+	// 64-bit mix of both fields (from MurmurHash3's finalizer)
+	uint64 hash = key.sourceId * 0x9E3779B97F4A7C15ULL ^ key.tileIndex;
+	hash ^= hash >> 33;
+	hash *= 0xFF51AFD7ED558CCDULL;
+	hash ^= hash >> 33;
+	return static_cast<std::size_t>(hash);
+}
+
+inline auto TextureCache::getShard(const TileKey& key)
+	-> Shard&
+{
+	// high bits are used so tiles within a shard still spread over buckets
+	return m_shards[(TileKeyHash()(key) >> 32) % NUM_SHARDS];
+}
+
+}// end namespace ph
@@ -0,0 +1,431 @@
+#include "FileIO/ExrFileWriter.h"
+#include "FileIO/ZlibCompressor.h"
+#include "FileIO/FileReplacement.h"
+#include "Frame/TFrame.h"
+#include "Common/assertion.h"
+
+#include <fstream>
+#include <algorithm>
+#include <cstring>
+
+namespace ph
+{
+
+namespace
+{
+
+constexpr uint32      EXR_MAGIC_NUMBER       = 20000630;
+constexpr uint32      EXR_VERSION            = 2;
+constexpr uint32      EXR_LONG_NAMES_FLAG    = 0x400;
+constexpr std::size_t EXR_MAX_SHORT_NAME     = 31;
+constexpr std::size_t EXR_MAX_LONG_NAME      = 255;
+constexpr int32       EXR_PIXEL_TYPE_HALF    = 1;
+constexpr int32       EXR_PIXEL_TYPE_FLOAT   = 2;
+constexpr uint8       EXR_INCREASING_Y       = 0;
+constexpr std::size_t NUM_FRAME_COMPONENTS   = 3;
+
+struct Channel
+{
+	std::string        name;
+	const HdrRgbFrame* frame;
+	std::size_t        component;
+};
+
+// Converts to the bits of the nearest IEEE 754 half-precision float, with
+// ties rounded to even. Values too large for a half become infinities.
+uint16 to_half_bits(const float32 value)
+{
+	uint32 bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+
+	const uint32 sign    = (bits >> 16) & 0x8000;
+	const uint32 absBits = bits & 0x7FFFFFFF;
+
+	// infinities and NaNs
+	if(absBits >= 0x7F800000)
+	{
+		return static_cast<uint16>(sign | 0x7C00 | (absBits > 0x7F800000 ? 0x200 : 0));
+	}
+
+	// values rounded to 65520 or more
+	if(absBits >= 0x477FF000)
+	{
+		return static_cast<uint16>(sign | 0x7C00);
+	}
+
+	// subnormal halves are multiples of 2^-24; values below 2^-25 become zero
+	if(absBits < 0x38800000)
+	{
+		if(absBits < 0x33000000)
+		{
+			return static_cast<uint16>(sign);
+		}
+
+		const uint32 mantissa  = (absBits & 0x7FFFFF) | 0x800000;
+		const uint32 shift     = 126 - (absBits >> 23);
+		const uint32 remainder = mantissa & ((1u << shift) - 1);
+		const uint32 halfway   = 1u << (shift - 1);
+
+		uint32 halfBits = mantissa >> shift;
+		if(remainder > halfway || (remainder == halfway && (halfBits & 1)))
+		{
+			++halfBits;
+		}
+		return static_cast<uint16>(sign | halfBits);
+	}
+
+	// rebias the exponent from 127 to 15 and round the mantissa
+	uint32 halfBits = (absBits - 0x38000000) >> 13;
+	const uint32 remainder = absBits & 0x1FFF;
+	if(remainder > 0x1000 || (remainder == 0x1000 && (halfBits & 1)))
+	{
+		++halfBits;
+	}
+	return static_cast<uint16>(sign | halfBits);
+}
+
+// EXR files are little-endian.
+
+void put_uint8(const uint8 value, std::vector<uint8>* const out_bytes)
+{
+	out_bytes->push_back(value);
+}
+
+void put_uint32(const uint32 value, std::vector<uint8>* const out_bytes)
+{
+	for(uint32 i = 0; i < 4; ++i)
+	{
+		out_bytes->push_back(static_cast<uint8>(value >> (i * 8)));
+	}
+}
+
+void put_uint64(const uint64 value, std::vector<uint8>* const out_bytes)
+{
+	for(uint32 i = 0; i < 8; ++i)
+	{
+		out_bytes->push_back(static_cast<uint8>(value >> (i * 8)));
+	}
+}
+
+void put_int32(const int32 value, std::vector<uint8>* const out_bytes)
+{
+	put_uint32(static_cast<uint32>(value), out_bytes);
+}
+
+void put_float32(const float32 value, std::vector<uint8>* const out_bytes)
+{
+	uint32 bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	put_uint32(bits, out_bytes);
+}
+
+void put_string(const std::string& value, std::vector<uint8>* const out_bytes)
+{
+	out_bytes->insert(out_bytes->end(), value.begin(), value.end());
+	out_bytes->push_back(0);
+}
+
+void put_attribute(
+	const std::string&        name,
+	const std::string&        typeName,
+	const std::vector<uint8>& value,
+	std::vector<uint8>* const out_bytes)
+{
+	put_string(name, out_bytes);
+	put_string(typeName, out_bytes);
+	put_int32(static_cast<int32>(value.size()), out_bytes);
+	out_bytes->insert(out_bytes->end(), value.begin(), value.end());
+}
+
+// Separates the even and odd bytes (the two halves of 16-bit values tend to
+// differ) and replaces each byte by its difference from the previous one,
+// which EXR's RLE and zlib compressions do before encoding.
+void predict_bytes(const std::vector<uint8>& bytes, std::vector<uint8>* const out_predicted)
+{
+	out_predicted->resize(bytes.size());
+
+	const std::size_t numEvenBytes = (bytes.size() + 1) / 2;
+	for(std::size_t i = 0; i < bytes.size(); ++i)
+	{
+		(*out_predicted)[i % 2 == 0 ? i / 2 : numEvenBytes + i / 2] = bytes[i];
+	}
+
+	for(std::size_t i = out_predicted->size(); i-- > 1;)
+	{
+		(*out_predicted)[i] = static_cast<uint8>((*out_predicted)[i] - (*out_predicted)[i - 1] + 128);
+	}
+}
+
+// A count c >= 0 is followed by a byte repeated c + 1 times; a count c < 0
+// is followed by -c bytes as is.
+void rle_compress(const std::vector<uint8>& bytes, std::vector<uint8>* const out_compressed)
+{
+	constexpr std::size_t MIN_RUN_LENGTH = 3;
+	constexpr std::size_t MAX_RUN_LENGTH = 128;
+	constexpr std::size_t MAX_LITERALS   = 127;
+
+	const std::size_t numBytes = bytes.size();
+	for(std::size_t i = 0; i < numBytes;)
+	{
+		std::size_t runLength = 1;
+		while(i + runLength < numBytes && bytes[i + runLength] == bytes[i] && runLength < MAX_RUN_LENGTH)
+		{
+			++runLength;
+		}
+
+		if(runLength >= MIN_RUN_LENGTH)
+		{
+			out_compressed->push_back(static_cast<uint8>(runLength - 1));
+			out_compressed->push_back(bytes[i]);
+			i += runLength;
+			continue;
+		}
+
+		// literals end where a run starts
+		std::size_t literalEnd = i;
+		while(literalEnd < numBytes && literalEnd - i < MAX_LITERALS &&
+		      !(literalEnd + 2 < numBytes &&
+		        bytes[literalEnd] == bytes[literalEnd + 1] &&
+		        bytes[literalEnd] == bytes[literalEnd + 2]))
+		{
+			++literalEnd;
+		}
+
+		out_compressed->push_back(static_cast<uint8>(-static_cast<int32>(literalEnd - i)));
+		out_compressed->insert(out_compressed->end(), bytes.begin() + i, bytes.begin() + literalEnd);
+		i = literalEnd;
+	}
+}
+
+}// end anonymous namespace
+
+const Logger ExrFileWriter::logger(LogSender("EXR Writer"));
+
+ExrFileWriter::ExrFileWriter() :
+	ExrFileWriter(EPixelType::HALF, ECompression::ZIP)
+{}
+
+ExrFileWriter::ExrFileWriter(const EPixelType pixelType, const ECompression compression) :
+	m_pixelType  (pixelType),
+	m_compression(compression),
+	m_layers     ()
+{}
+
+void ExrFileWriter::addLayer(const std::string& layerName, const HdrRgbFrame* const frame)
+{
+	PH_ASSERT(frame);
+
+	m_layers.push_back({layerName, frame});
+}
+
+bool ExrFileWriter::write(const Path& filePath) const
+{
+	if(m_layers.empty())
+	{
+		logger.log(ELogLevel::WARNING_MED,
+			"no layer to write to <" + filePath.toString() + ">");
+		return false;
+	}
+
+	const uint32 widthPx  = m_layers.front().frame->widthPx();
+	const uint32 heightPx = m_layers.front().frame->heightPx();
+	if(widthPx == 0 || heightPx == 0)
+	{
+		logger.log(ELogLevel::WARNING_MED,
+			"cannot write an empty image to <" + filePath.toString() + ">");
+		return false;
+	}
+
+	// channels are stored in the order of their names
+	std::vector<Channel> channels;
+	for(const Layer& layer : m_layers)
+	{
+		if(layer.frame->widthPx() != widthPx || layer.frame->heightPx() != heightPx)
+		{
+			logger.log(ELogLevel::WARNING_MED,
+				"layer <" + layer.name + "> is of different dimensions, not writing <" + filePath.toString() + ">");
+			return false;
+		}
+
+		const std::string prefix = layer.name.empty() ? "" : layer.name + ".";
+		channels.push_back({prefix + "R", layer.frame, 0});
+		channels.push_back({prefix + "G", layer.frame, 1});
+		channels.push_back({prefix + "B", layer.frame, 2});
+	}
+	std::sort(channels.begin(), channels.end(),
+		[](const Channel& a, const Channel& b)
+		{
+			return a.name < b.name;
+		});
+
+	std::size_t maxNameLength = 0;
+	for(std::size_t i = 0; i < channels.size(); ++i)
+	{
+		if(i > 0 && channels[i].name == channels[i - 1].name)
+		{
+			logger.log(ELogLevel::WARNING_MED,
+				"duplicated channel <" + channels[i].name + ">, not writing <" + filePath.toString() + ">");
+			return false;
+		}
+
+		maxNameLength = std::max(maxNameLength, channels[i].name.size());
+	}
+	if(maxNameLength > EXR_MAX_LONG_NAME)
+	{
+		logger.log(ELogLevel::WARNING_MED,
+			"layer names are too long, not writing <" + filePath.toString() + ">");
+		return false;
+	}
+
+	std::vector<uint8> header;
+	put_uint32(EXR_MAGIC_NUMBER, &header);
+	put_uint32(EXR_VERSION | (maxNameLength > EXR_MAX_SHORT_NAME ? EXR_LONG_NAMES_FLAG : 0), &header);
+	{
+		std::vector<uint8> value;
+		for(const Channel& channel : channels)
+		{
+			put_string(channel.name, &value);
+			put_int32(m_pixelType == EPixelType::HALF ? EXR_PIXEL_TYPE_HALF : EXR_PIXEL_TYPE_FLOAT, &value);
+
+			// perceptually linear flag and reserved bytes
+			put_uint32(0, &value);
+
+			// sampling rates in x and y
+			put_int32(1, &value);
+			put_int32(1, &value);
+		}
+		put_uint8(0, &value);
+		put_attribute("channels", "chlist", value, &header);
+	}
+	put_attribute("compression", "compression", {static_cast<uint8>(m_compression)}, &header);
+	{
+		std::vector<uint8> value;
+		put_int32(0, &value);
+		put_int32(0, &value);
+		put_int32(static_cast<int32>(widthPx - 1), &value);
+		put_int32(static_cast<int32>(heightPx - 1), &value);
+		put_attribute("dataWindow", "box2i", value, &header);
+		put_attribute("displayWindow", "box2i", value, &header);
+	}
+	put_attribute("lineOrder", "lineOrder", {EXR_INCREASING_Y}, &header);
+	{
+		std::vector<uint8> value;
+		put_float32(1.0f, &value);
+		put_attribute("pixelAspectRatio", "float", value, &header);
+		put_attribute("screenWindowWidth", "float", value, &header);
+	}
+	{
+		std::vector<uint8> value;
+		put_float32(0.0f, &value);
+		put_float32(0.0f, &value);
+		put_attribute("screenWindowCenter", "v2f", value, &header);
+	}
+	put_uint8(0, &header);
+
+	const uint32      linesPerBlock = m_compression == ECompression::ZIP ? 16 : 1;
+	const std::size_t numBlocks     = (heightPx + linesPerBlock - 1) / linesPerBlock;
+	const std::size_t bytesPerValue = m_pixelType == EPixelType::HALF ? 2 : 4;
+
+	FileReplacement replacement(filePath);
+	{
+		std::ofstream file(replacement.getTempFilePath(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+		file.write(reinterpret_cast<const char*>(header.data()), header.size());
+
+		// the offset table is written after all blocks are
+		const std::vector<char> zeroOffsets(numBlocks * sizeof(uint64), 0);
+		file.write(zeroOffsets.data(), zeroOffsets.size());
+
+		std::vector<uint8> offsetTable;
+		uint64             blockOffset = header.size() + zeroOffsets.size();
+		std::vector<uint8> blockBytes, predictedBytes, compressedBytes, blockHeader;
+		for(std::size_t block = 0; block < numBlocks && file.good(); ++block)
+		{
+			const uint32 firstLine = static_cast<uint32>(block * linesPerBlock);
+			const uint32 numLines  = std::min(linesPerBlock, heightPx - firstLine);
+
+			// scanlines of a block are stored one after another, each with
+			// all channels
+			blockBytes.clear();
+			for(uint32 line = firstLine; line < firstLine + numLines; ++line)
+			{
+				// frames store the bottom row first, EXR files the top row
+				const uint32 frameY = heightPx - 1 - line;
+				for(const Channel& channel : channels)
+				{
+					const HdrComponent* const rowData =
+						channel.frame->getPixelData() +
+						static_cast<std::size_t>(frameY) * widthPx * NUM_FRAME_COMPONENTS +
+						channel.component;
+
+					for(uint32 x = 0; x < widthPx; ++x)
+					{
+						const float32 value = static_cast<float32>(rowData[x * NUM_FRAME_COMPONENTS]);
+						if(m_pixelType == EPixelType::HALF)
+						{
+							const uint16 halfBits = to_half_bits(value);
+							blockBytes.push_back(static_cast<uint8>(halfBits));
+							blockBytes.push_back(static_cast<uint8>(halfBits >> 8));
+						}
+						else
+						{
+							put_float32(value, &blockBytes);
+						}
+					}
+				}
+			}
+			PH_ASSERT_EQ(blockBytes.size(), numLines * channels.size() * widthPx * bytesPerValue);
+
+			// blocks that do not get smaller are stored uncompressed, which
+			// readers tell by their size
+			const std::vector<uint8>* blockData = &blockBytes;
+			if(m_compression != ECompression::NONE)
+			{
+				predict_bytes(blockBytes, &predictedBytes);
+
+				compressedBytes.clear();
+				if(m_compression == ECompression::RLE)
+				{
+					rle_compress(predictedBytes, &compressedBytes);
+				}
+				else
+				{
+					ZlibCompressor::compress(predictedBytes.data(), predictedBytes.size(), &compressedBytes);
+				}
+
+				if(compressedBytes.size() < blockBytes.size())
+				{
+					blockData = &compressedBytes;
+				}
+			}
+
+			blockHeader.clear();
+			put_int32(static_cast<int32>(firstLine), &blockHeader);
+			put_int32(static_cast<int32>(blockData->size()), &blockHeader);
+			file.write(reinterpret_cast<const char*>(blockHeader.data()), blockHeader.size());
+			file.write(reinterpret_cast<const char*>(blockData->data()), blockData->size());
+
+			put_uint64(blockOffset, &offsetTable);
+			blockOffset += blockHeader.size() + blockData->size();
+		}
+
+		file.seekp(static_cast<std::streamoff>(header.size()));
+		file.write(reinterpret_cast<const char*>(offsetTable.data()), offsetTable.size());
+
+		if(!file.good())
+		{
+			logger.log(ELogLevel::WARNING_MED,
+				"failed writing <" + filePath.toString() + ">");
+			return false;
+		}
+	}
+
+	if(!replacement.commit())
+	{
+		logger.log(ELogLevel::WARNING_MED,
+			"failed writing <" + filePath.toString() + ">");
+		return false;
+	}
+	return true;
+}
+
+}// end namespace ph
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "Frame/frame_fwd.h"
+#include "FileIO/FileSystem/Path.h"
+#include "Common/primitive_type.h"
+#include "Common/Logger.h"
+
+#include <string>
+#include <vector>
+
+namespace ph
+{
+
+/*
+	Writes HDR frames as layers of a single scanline OpenEXR file. Each layer
+	is stored as R, G and B channels named "<layer>.R" and so on, except for
+	a layer with an empty name, whose channels are plain "R", "G" and "B"
+	(the layer most viewers display by default).
+
+	Pixel data are gathered from the frames one block of scanlines at a
+	time, so the writer itself keeps no copy of the whole image; the frames
+	of all layers must be in memory though. Compressions other than 
+	PIZ-style wavelet coding are supported.
+*/
+class ExrFileWriter final
+{
+public:
+	enum class EPixelType
+	{
+		HALF,
+		FLOAT
+	};
+
+	// Values are as stored in EXR files.
+	enum class ECompression
+	{
+		NONE = 0,
+		RLE  = 1,
+		ZIPS = 2,// zlib, a scanline per block
+		ZIP  = 3 // zlib, 16 scanlines per block
+	};
+
+public:
+	ExrFileWriter();
+	ExrFileWriter(EPixelType pixelType, ECompression compression);
+
+	// <frame> is read by write(), it must be valid until then. All frames
+	// must be of the same dimensions.
+	void addLayer(const std::string& layerName, const HdrRgbFrame* frame);
+
+	bool write(const Path& filePath) const;
+
+private:
+	struct Layer
+	{
+		std::string        name;
+		const HdrRgbFrame* frame;
+	};
+
+	EPixelType         m_pixelType;
+	ECompression       m_compression;
+	std::vector<Layer> m_layers;
+
+	static const Logger logger;
+};
+
+}// end namespace ph
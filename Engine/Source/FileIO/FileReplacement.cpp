@@ -0,0 +1,52 @@
+#include "FileIO/FileReplacement.h"
+
+#include <cstdio>
+
+namespace ph
+{
+
+FileReplacement::FileReplacement(const Path& filePath) :
+	m_finalFilePath(filePath.toAbsoluteString()),
+	m_tempFilePath (m_finalFilePath + ".tmp"),
+	m_isPending    (true)
+{}
+
+FileReplacement::~FileReplacement()
+{
+	discard();
+}
+
+bool FileReplacement::commit()
+{
+	if(!m_isPending)
+	{
+		return false;
+	}
+
+	// Renaming replaces the final file atomically on POSIX systems. Where it
+	// cannot rename over an existing file (e.g., on Windows), the final file
+	// is removed first, leaving a moment without it.
+	if(std::rename(m_tempFilePath.c_str(), m_finalFilePath.c_str()) != 0)
+	{
+		std::remove(m_finalFilePath.c_str());
+		if(std::rename(m_tempFilePath.c_str(), m_finalFilePath.c_str()) != 0)
+		{
+			discard();
+			return false;
+		}
+	}
+
+	m_isPending = false;
+	return true;
+}
+
+void FileReplacement::discard()
+{
+	if(m_isPending)
+	{
+		std::remove(m_tempFilePath.c_str());
+		m_isPending = false;
+	}
+}
+
+}// end namespace ph
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "FileIO/FileSystem/Path.h"
+#include "Utility/INoncopyable.h"
+
+#include <string>
+
+namespace ph
+{
+
+/*
+	Replaces a file by writing a temporary file next to it and renaming it
+	over the file once complete, so an interrupted write never leaves a
+	partial file behind. The temporary file is removed unless commit()
+	succeeds.
+*/
+class FileReplacement : public INoncopyable
+{
+public:
+	explicit FileReplacement(const Path& filePath);
+	~FileReplacement();
+
+	// Renames the temporary file over the final one. Returns false and
+	// removes the temporary file on failure.
+	bool commit();
+
+	// Removes the temporary file, keeping the final one as is.
+	void discard();
+
+	const std::string& getTempFilePath() const;
+
+private:
+	std::string m_finalFilePath;
+	std::string m_tempFilePath;
+	bool        m_isPending;
+};
+
+// In-header Implementations:
+
+inline const std::string& FileReplacement::getTempFilePath() const
+{
+	return m_tempFilePath;
+}
+
+}// end namespace ph
@@ -0,0 +1,149 @@
+#include "FileIO/MemoryMappedFile.h"
+#include "Common/os.h"
+
+#if defined(PH_OPERATING_SYSTEM_IS_WINDOWS)
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <windows.h>
+#else
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+namespace ph
+{
+
+const Logger MemoryMappedFile::logger(LogSender("Memory Mapped File"));
+
+MemoryMappedFile::MemoryMappedFile(const Path& filePath) :
+	m_filePath      (filePath),
+	m_data          (nullptr),
+	m_size          (0),
+	m_fileDescriptor(-1),
+	m_fileHandle    (nullptr),
+	m_mappingHandle (nullptr)
+{}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+	close();
+}
+
+bool MemoryMappedFile::open()
+{
+	close();
+
+	const std::string& filePath = m_filePath.toAbsoluteString();
+
+#if defined(PH_OPERATING_SYSTEM_IS_WINDOWS)
+
+	const HANDLE fileHandle = CreateFileA(
+		filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, 
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if(fileHandle == INVALID_HANDLE_VALUE)
+	{
+		logger.log(ELogLevel::WARNING_MED, "<" + filePath + "> open failed");
+		return false;
+	}
+	m_fileHandle = fileHandle;
+
+	LARGE_INTEGER fileSize;
+	if(!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0)
+	{
+		logger.log(ELogLevel::WARNING_MED, "<" + filePath + "> is empty or its size is unknown");
+		close();
+		return false;
+	}
+	m_size = static_cast<std::size_t>(fileSize.QuadPart);
+
+	const HANDLE mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if(!mappingHandle)
+	{
+		logger.log(ELogLevel::WARNING_MED, "<" + filePath + "> mapping failed");
+		close();
+		return false;
+	}
+	m_mappingHandle = mappingHandle;
+
+	const void* data = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+	if(!data)
+	{
+		logger.log(ELogLevel::WARNING_MED, "<" + filePath + "> mapping failed");
+		close();
+		return false;
+	}
+	m_data = static_cast<const std::byte*>(data);
+
+#else
+
+	m_fileDescriptor = ::open(filePath.c_str(), O_RDONLY);
+	if(m_fileDescriptor == -1)
+	{
+		logger.log(ELogLevel::WARNING_MED, "<" + filePath + "> open failed");
+		return false;
+	}
+
+	struct stat fileStatus;
+	if(fstat(m_fileDescriptor, &fileStatus) == -1 || fileStatus.st_size == 0)
+	{
+		logger.log(ELogLevel::WARNING_MED, "<" + filePath + "> is empty or its size is unknown");
+		close();
+		return false;
+	}
+	m_size = static_cast<std::size_t>(fileStatus.st_size);
+
+	void* const data = mmap(nullptr, m_size, PROT_READ, MAP_SHARED, m_fileDescriptor, 0);
+	if(data == MAP_FAILED)
+	{
+		logger.log(ELogLevel::WARNING_MED, "<" + filePath + "> mapping failed");
+		m_size = 0;
+		close();
+		return false;
+	}
+	m_data = static_cast<const std::byte*>(data);
+
+#endif
+
+	return true;
+}
+
+void MemoryMappedFile::close()
+{
+#if defined(PH_OPERATING_SYSTEM_IS_WINDOWS)
+
+	if(m_data)
+	{
+		UnmapViewOfFile(m_data);
+	}
+	if(m_mappingHandle)
+	{
+		CloseHandle(m_mappingHandle);
+	}
+	if(m_fileHandle)
+	{
+		CloseHandle(m_fileHandle);
+	}
+
+#else
+
+	if(m_data)
+	{
+		munmap(const_cast<std::byte*>(m_data), m_size);
+	}
+	if(m_fileDescriptor != -1)
+	{
+		::close(m_fileDescriptor);
+	}
+
+#endif
+
+	m_data           = nullptr;
+	m_size           = 0;
+	m_fileDescriptor = -1;
+	m_fileHandle     = nullptr;
+	m_mappingHandle  = nullptr;
+}
+
+}// end namespace ph
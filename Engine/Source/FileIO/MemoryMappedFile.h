@@ -0,0 +1,54 @@
+#pragma once
+
+#include "FileIO/FileSystem/Path.h"
+#include "Common/Logger.h"
+#include "Utility/INoncopyable.h"
+
+#include <cstddef>
+
+namespace ph
+{
+
+/*
+	A file mapped read-only into memory. Pages are loaded on first access 
+	and shared with other processes mapping the same file.
+*/
+class MemoryMappedFile : public INoncopyable
+{
+public:
+	explicit MemoryMappedFile(const Path& filePath);
+	~MemoryMappedFile();
+
+	bool open();
+	void close();
+
+	// Contents of the file; valid until close() is called.
+	const std::byte* getData() const;
+	std::size_t getSize() const;
+
+private:
+	Path             m_filePath;
+	const std::byte* m_data;
+	std::size_t      m_size;
+
+	// file descriptor on POSIX systems, or file and mapping handles on Windows
+	int   m_fileDescriptor;
+	void* m_fileHandle;
+	void* m_mappingHandle;
+
+	static const Logger logger;
+};
+
+// In-header Implementations:
+
+inline const std::byte* MemoryMappedFile::getData() const
+{
+	return m_data;
+}
+
+inline std::size_t MemoryMappedFile::getSize() const
+{
+	return m_size;
+}
+
+}// end namespace ph
@@ -1,4 +1,5 @@
 #include "FileIO/PictureSaver.h"
+#include "FileIO/ExrFileWriter.h"
 #include "Frame/TFrame.h"
 #include "Common/assertion.h"
 
@@ -39,6 +40,14 @@ bool PictureSaver::save(const HdrRgbFrame& frame, const Path& filePath)
 
 		return save(ldrFrame, filePath);
 	}
+	else if(ext == ".exr")
+	{
+		logger.log(ELogLevel::NOTE_MED, "saving image <" + filePath.toString() + ">");
+
+		ExrFileWriter writer;
+		writer.addLayer("", &frame);
+		return writer.write(filePath);
+	}
 	else
 	{
 		// TODO
@@ -15,7 +15,8 @@ public:
 	static bool save(const LdrRgbFrame& frame, const Path& filePath);
 
 	// Saves a HDR frame in the specified file. Notice that if the file is 
-	// a LDR format, values outside [0, 1] will be clamped.
+	// a LDR format, values outside [0, 1] will be clamped. OpenEXR files 
+	// (.exr) keep the values as half floats.
 	//
 	static bool save(const HdrRgbFrame& frame, const Path& filePath);
 
@@ -0,0 +1,512 @@
+#include "FileIO/ZlibCompressor.h"
+#include "Common/assertion.h"
+
+#include <algorithm>
+#include <queue>
+#include <utility>
+#include <functional>
+
+namespace ph
+{
+
+namespace
+{
+
+constexpr std::size_t WINDOW_SIZE       = 32768;
+constexpr std::size_t WINDOW_MASK       = WINDOW_SIZE - 1;
+constexpr std::size_t HASH_SIZE         = 32768;
+constexpr std::size_t HASH_MASK         = HASH_SIZE - 1;
+constexpr std::size_t MIN_MATCH_LENGTH  = 3;
+constexpr std::size_t MAX_MATCH_LENGTH  = 258;
+constexpr std::size_t MAX_CHAIN_LENGTH  = 32;
+
+// Number of input bytes coded by each block (with its own Huffman codes).
+constexpr std::size_t BLOCK_BYTES = 65536;
+
+constexpr std::size_t NUM_LITERAL_LENGTH_CODES = 286;
+constexpr std::size_t NUM_DISTANCE_CODES       = 30;
+constexpr std::size_t NUM_CODE_LENGTH_CODES    = 19;
+constexpr uint32      END_OF_BLOCK             = 256;
+constexpr uint32      MAX_CODE_BITS            = 15;
+constexpr uint32      MAX_CODE_LENGTH_BITS     = 7;
+
+constexpr uint16 LENGTH_BASES[] = {
+	3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+	35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+constexpr uint8 LENGTH_EXTRA_BITS[] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+	3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+constexpr uint16 DISTANCE_BASES[] = {
+	1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+	257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+constexpr uint8 DISTANCE_EXTRA_BITS[] = {
+	0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+	7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+constexpr uint8 CODE_LENGTH_ORDER[] = {
+	16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+// A literal if <length> is 0, otherwise a match.
+struct Token
+{
+	uint16 length;
+	uint16 literalOrDistance;
+};
+
+class BitWriter final
+{
+public:
+	explicit BitWriter(std::vector<uint8>* const out_bytes) :
+		m_bytes(out_bytes), m_buffer(0), m_numBits(0)
+	{
+		PH_ASSERT(out_bytes);
+	}
+
+	// Bits are packed starting from the least significant one.
+	void write(const uint32 bits, const uint32 numBits)
+	{
+		PH_ASSERT_LE(numBits, 32);
+
+		m_buffer  |= static_cast<uint64>(bits) << m_numBits;
+		m_numBits += numBits;
+		while(m_numBits >= 8)
+		{
+			m_bytes->push_back(static_cast<uint8>(m_buffer));
+			m_buffer  >>= 8;
+			m_numBits -= 8;
+		}
+	}
+
+	// Huffman codes are packed starting from the most significant bit.
+	void writeCode(const uint32 code, const uint32 numBits)
+	{
+		uint32 reversed = 0;
+		for(uint32 i = 0; i < numBits; ++i)
+		{
+			reversed |= ((code >> i) & 1) << (numBits - 1 - i);
+		}
+		write(reversed, numBits);
+	}
+
+	void flush()
+	{
+		if(m_numBits > 0)
+		{
+			m_bytes->push_back(static_cast<uint8>(m_buffer));
+		}
+		m_buffer  = 0;
+		m_numBits = 0;
+	}
+
+private:
+	std::vector<uint8>* m_bytes;
+	uint64              m_buffer;
+	uint32              m_numBits;
+};
+
+// Makes sure at least two symbols have codes; some decoders reject a code
+// with less than that.
+void ensure_two_codes(std::vector<uint32>* const freqs)
+{
+	std::size_t numUsed = std::count_if(freqs->begin(), freqs->end(),
+		[](const uint32 freq)
+		{
+			return freq > 0;
+		});
+
+	for(std::size_t i = 0; i < freqs->size() && numUsed < 2; ++i)
+	{
+		if((*freqs)[i] == 0)
+		{
+			(*freqs)[i] = 1;
+			++numUsed;
+		}
+	}
+}
+
+// Huffman code lengths for symbols of <freqs>, none longer than <maxBits>.
+// Frequencies are flattened until the limit is met.
+std::vector<uint8> build_code_lengths(const std::vector<uint32>& freqs, const uint32 maxBits)
+{
+	using Entry = std::pair<uint64, std::size_t>;
+
+	std::vector<uint64> weights(freqs.begin(), freqs.end());
+	while(true)
+	{
+		std::vector<int64>  parents;
+		std::vector<int64>  leafNodes(freqs.size(), -1);
+		std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+		for(std::size_t symbol = 0; symbol < freqs.size(); ++symbol)
+		{
+			if(weights[symbol] > 0)
+			{
+				leafNodes[symbol] = static_cast<int64>(parents.size());
+				queue.push({weights[symbol], parents.size()});
+				parents.push_back(-1);
+			}
+		}
+
+		while(queue.size() > 1)
+		{
+			const Entry a = queue.top();
+			queue.pop();
+			const Entry b = queue.top();
+			queue.pop();
+
+			parents[a.second] = static_cast<int64>(parents.size());
+			parents[b.second] = static_cast<int64>(parents.size());
+			queue.push({a.first + b.first, parents.size()});
+			parents.push_back(-1);
+		}
+
+		// parents are always created after their children
+		std::vector<uint32> depths(parents.size(), 0);
+		for(std::size_t i = parents.size(); i-- > 0;)
+		{
+			if(parents[i] >= 0)
+			{
+				depths[i] = depths[static_cast<std::size_t>(parents[i])] + 1;
+			}
+		}
+
+		std::vector<uint8> lengths(freqs.size(), 0);
+		uint32             maxDepth = 0;
+		for(std::size_t symbol = 0; symbol < freqs.size(); ++symbol)
+		{
+			if(leafNodes[symbol] >= 0)
+			{
+				const uint32 depth = std::max(depths[static_cast<std::size_t>(leafNodes[symbol])], uint32(1));
+				lengths[symbol] = static_cast<uint8>(std::min(depth, uint32(255)));
+				maxDepth = std::max(maxDepth, depth);
+			}
+		}
+
+		if(maxDepth <= maxBits)
+		{
+			return lengths;
+		}
+
+		for(uint64& weight : weights)
+		{
+			weight = weight > 0 ? (weight + 1) / 2 : 0;
+		}
+	}
+}
+
+// Canonical Huffman codes of <lengths> (RFC 1951, section 3.2.2).
+std::vector<uint16> gen_codes(const std::vector<uint8>& lengths)
+{
+	uint32 numCodesOfLength[MAX_CODE_BITS + 1] = {};
+	for(const uint8 length : lengths)
+	{
+		++numCodesOfLength[length];
+	}
+	numCodesOfLength[0] = 0;
+
+	uint32 nextCodes[MAX_CODE_BITS + 1] = {};
+	uint32 code = 0;
+	for(uint32 bits = 1; bits <= MAX_CODE_BITS; ++bits)
+	{
+		code = (code + numCodesOfLength[bits - 1]) << 1;
+		nextCodes[bits] = code;
+	}
+
+	std::vector<uint16> codes(lengths.size(), 0);
+	for(std::size_t symbol = 0; symbol < lengths.size(); ++symbol)
+	{
+		if(lengths[symbol] != 0)
+		{
+			codes[symbol] = static_cast<uint16>(nextCodes[lengths[symbol]]++);
+		}
+	}
+	return codes;
+}
+
+std::size_t length_code_index(const uint32 length)
+{
+	return std::upper_bound(std::begin(LENGTH_BASES), std::end(LENGTH_BASES), length) - std::begin(LENGTH_BASES) - 1;
+}
+
+std::size_t distance_code_index(const uint32 distance)
+{
+	return std::upper_bound(std::begin(DISTANCE_BASES), std::end(DISTANCE_BASES), distance) - std::begin(DISTANCE_BASES) - 1;
+}
+
+// Writes <tokens> as a block compressed with dynamic Huffman codes.
+void write_block(const std::vector<Token>& tokens, const bool isFinal, BitWriter& writer)
+{
+	std::vector<uint32> literalLengthFreqs(NUM_LITERAL_LENGTH_CODES, 0);
+	std::vector<uint32> distanceFreqs(NUM_DISTANCE_CODES, 0);
+	for(const Token& token : tokens)
+	{
+		if(token.length == 0)
+		{
+			++literalLengthFreqs[token.literalOrDistance];
+		}
+		else
+		{
+			++literalLengthFreqs[257 + length_code_index(token.length)];
+			++distanceFreqs[distance_code_index(token.literalOrDistance)];
+		}
+	}
+	literalLengthFreqs[END_OF_BLOCK] = 1;
+	ensure_two_codes(&literalLengthFreqs);
+	ensure_two_codes(&distanceFreqs);
+
+	const std::vector<uint8> literalLengthLengths = build_code_lengths(literalLengthFreqs, MAX_CODE_BITS);
+	const std::vector<uint8> distanceLengths      = build_code_lengths(distanceFreqs, MAX_CODE_BITS);
+	const std::vector<uint16> literalLengthCodes  = gen_codes(literalLengthLengths);
+	const std::vector<uint16> distanceCodes       = gen_codes(distanceLengths);
+
+	std::size_t numLiteralLengthCodes = NUM_LITERAL_LENGTH_CODES;
+	while(literalLengthLengths[numLiteralLengthCodes - 1] == 0)
+	{
+		--numLiteralLengthCodes;
+	}
+	std::size_t numDistanceCodes = NUM_DISTANCE_CODES;
+	while(distanceLengths[numDistanceCodes - 1] == 0)
+	{
+		--numDistanceCodes;
+	}
+
+	// code lengths of both alphabets are run-length coded as a whole;
+	// symbols 16, 17 and 18 repeat the previous length, short zero runs and
+	// long zero runs, respectively
+	std::vector<uint8> allLengths(literalLengthLengths.begin(), literalLengthLengths.begin() + numLiteralLengthCodes);
+	allLengths.insert(allLengths.end(), distanceLengths.begin(), distanceLengths.begin() + numDistanceCodes);
+
+	struct LengthSymbol
+	{
+		uint8 symbol;
+		uint8 extraValue;
+	};
+	std::vector<LengthSymbol> lengthSymbols;
+	for(std::size_t i = 0; i < allLengths.size();)
+	{
+		const uint8 length = allLengths[i];
+		std::size_t runLength = 1;
+		while(i + runLength < allLengths.size() && allLengths[i + runLength] == length)
+		{
+			++runLength;
+		}
+		i += runLength;
+
+		if(length == 0)
+		{
+			while(runLength >= 11)
+			{
+				const std::size_t repeats = std::min(runLength, std::size_t(138));
+				lengthSymbols.push_back({18, static_cast<uint8>(repeats - 11)});
+				runLength -= repeats;
+			}
+			if(runLength >= 3)
+			{
+				lengthSymbols.push_back({17, static_cast<uint8>(runLength - 3)});
+				runLength = 0;
+			}
+		}
+		else
+		{
+			lengthSymbols.push_back({length, 0});
+			--runLength;
+			while(runLength >= 3)
+			{
+				const std::size_t repeats = std::min(runLength, std::size_t(6));
+				lengthSymbols.push_back({16, static_cast<uint8>(repeats - 3)});
+				runLength -= repeats;
+			}
+		}
+
+		for(; runLength > 0; --runLength)
+		{
+			lengthSymbols.push_back({length, 0});
+		}
+	}
+
+	std::vector<uint32> codeLengthFreqs(NUM_CODE_LENGTH_CODES, 0);
+	for(const LengthSymbol& lengthSymbol : lengthSymbols)
+	{
+		++codeLengthFreqs[lengthSymbol.symbol];
+	}
+	ensure_two_codes(&codeLengthFreqs);
+
+	const std::vector<uint8>  codeLengthLengths = build_code_lengths(codeLengthFreqs, MAX_CODE_LENGTH_BITS);
+	const std::vector<uint16> codeLengthCodes   = gen_codes(codeLengthLengths);
+
+	std::size_t numCodeLengthCodes = NUM_CODE_LENGTH_CODES;
+	while(numCodeLengthCodes > 4 && codeLengthLengths[CODE_LENGTH_ORDER[numCodeLengthCodes - 1]] == 0)
+	{
+		--numCodeLengthCodes;
+	}
+
+	writer.write(isFinal ? 1 : 0, 1);
+	writer.write(2, 2);
+	writer.write(static_cast<uint32>(numLiteralLengthCodes - 257), 5);
+	writer.write(static_cast<uint32>(numDistanceCodes - 1), 5);
+	writer.write(static_cast<uint32>(numCodeLengthCodes - 4), 4);
+	for(std::size_t i = 0; i < numCodeLengthCodes; ++i)
+	{
+		writer.write(codeLengthLengths[CODE_LENGTH_ORDER[i]], 3);
+	}
+
+	constexpr uint32 LENGTH_SYMBOL_EXTRA_BITS[] = {2, 3, 7};
+	for(const LengthSymbol& lengthSymbol : lengthSymbols)
+	{
+		writer.writeCode(codeLengthCodes[lengthSymbol.symbol], codeLengthLengths[lengthSymbol.symbol]);
+		if(lengthSymbol.symbol >= 16)
+		{
+			writer.write(lengthSymbol.extraValue, LENGTH_SYMBOL_EXTRA_BITS[lengthSymbol.symbol - 16]);
+		}
+	}
+
+	for(const Token& token : tokens)
+	{
+		if(token.length == 0)
+		{
+			writer.writeCode(literalLengthCodes[token.literalOrDistance], literalLengthLengths[token.literalOrDistance]);
+		}
+		else
+		{
+			const std::size_t lengthIndex   = length_code_index(token.length);
+			const std::size_t distanceIndex = distance_code_index(token.literalOrDistance);
+
+			writer.writeCode(literalLengthCodes[257 + lengthIndex], literalLengthLengths[257 + lengthIndex]);
+			writer.write(token.length - LENGTH_BASES[lengthIndex], LENGTH_EXTRA_BITS[lengthIndex]);
+			writer.writeCode(distanceCodes[distanceIndex], distanceLengths[distanceIndex]);
+			writer.write(token.literalOrDistance - DISTANCE_BASES[distanceIndex], DISTANCE_EXTRA_BITS[distanceIndex]);
+		}
+	}
+	writer.writeCode(literalLengthCodes[END_OF_BLOCK], literalLengthLengths[END_OF_BLOCK]);
+}
+
+uint32 calc_adler32(const uint8* const data, const std::size_t numBytes)
+{
+	// the largest number of bytes that can be summed before <b> overflows
+	constexpr std::size_t MAX_RUN_BYTES = 5552;
+
+	uint32 a = 1, b = 0;
+	for(std::size_t i = 0; i < numBytes;)
+	{
+		const std::size_t runEnd = std::min(numBytes, i + MAX_RUN_BYTES);
+		for(; i < runEnd; ++i)
+		{
+			a += data[i];
+			b += a;
+		}
+		a %= 65521;
+		b %= 65521;
+	}
+	return (b << 16) | a;
+}
+
+}// end anonymous namespace
+
+void ZlibCompressor::compress(
+	const uint8* const        data,
+	const std::size_t         numBytes,
+	std::vector<uint8>* const out_compressed)
+{
+	PH_ASSERT(data || numBytes == 0);
+	PH_ASSERT(out_compressed);
+
+	// deflate with a 32 KiB window and no preset dictionary
+	out_compressed->push_back(0x78);
+	out_compressed->push_back(0x01);
+
+	BitWriter writer(out_compressed);
+
+	// most recent position of each hash and the previous position of the
+	// same hash for positions within the window
+	std::vector<int64> hashHeads(HASH_SIZE, -1);
+	std::vector<int64> previousPositions(WINDOW_SIZE, -1);
+
+	const auto hashAt = [data](const std::size_t position)
+	{
+		return ((static_cast<std::size_t>(data[position]) << 10) ^
+		        (static_cast<std::size_t>(data[position + 1]) << 5) ^
+		        data[position + 2]) & HASH_MASK;
+	};
+
+	const auto insertPosition = [&](const std::size_t position)
+	{
+		if(position + MIN_MATCH_LENGTH <= numBytes)
+		{
+			const std::size_t hash = hashAt(position);
+			previousPositions[position & WINDOW_MASK] = hashHeads[hash];
+			hashHeads[hash] = static_cast<int64>(position);
+		}
+	};
+
+	std::vector<Token> tokens;
+	std::size_t blockBegin = 0;
+	std::size_t position   = 0;
+	while(position < numBytes)
+	{
+		std::size_t matchLength   = 0;
+		std::size_t matchDistance = 0;
+		if(position + MIN_MATCH_LENGTH <= numBytes)
+		{
+			const std::size_t hash      = hashAt(position);
+			const std::size_t maxLength = std::min(MAX_MATCH_LENGTH, numBytes - position);
+
+			int64 candidate = hashHeads[hash];
+			for(std::size_t chain = 0;
+			    chain < MAX_CHAIN_LENGTH && candidate >= 0 && position - static_cast<std::size_t>(candidate) <= WINDOW_SIZE;
+			    ++chain)
+			{
+				const uint8* const a = data + candidate;
+				const uint8* const b = data + position;
+
+				std::size_t length = 0;
+				while(length < maxLength && a[length] == b[length])
+				{
+					++length;
+				}
+
+				if(length > matchLength)
+				{
+					matchLength   = length;
+					matchDistance = position - static_cast<std::size_t>(candidate);
+					if(length == maxLength)
+					{
+						break;
+					}
+				}
+
+				candidate = previousPositions[static_cast<std::size_t>(candidate) & WINDOW_MASK];
+			}
+		}
+
+		if(matchLength >= MIN_MATCH_LENGTH)
+		{
+			tokens.push_back({static_cast<uint16>(matchLength), static_cast<uint16>(matchDistance)});
+			for(std::size_t i = 0; i < matchLength; ++i)
+			{
+				insertPosition(position + i);
+			}
+			position += matchLength;
+		}
+		else
+		{
+			tokens.push_back({0, data[position]});
+			insertPosition(position);
+			++position;
+		}
+
+		if(position - blockBegin >= BLOCK_BYTES && position < numBytes)
+		{
+			write_block(tokens, false, writer);
+			tokens.clear();
+			blockBegin = position;
+		}
+	}
+	write_block(tokens, true, writer);
+	writer.flush();
+
+	const uint32 adler32 = calc_adler32(data, numBytes);
+	out_compressed->push_back(static_cast<uint8>(adler32 >> 24));
+	out_compressed->push_back(static_cast<uint8>(adler32 >> 16));
+	out_compressed->push_back(static_cast<uint8>(adler32 >> 8));
+	out_compressed->push_back(static_cast<uint8>(adler32));
+}
+
+}// end namespace ph
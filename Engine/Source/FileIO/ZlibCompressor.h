@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Common/primitive_type.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace ph
+{
+
+/*
+	Compresses data to the zlib format (RFC 1950 and 1951), readable by any
+	zlib implementation. Matches are searched greedily within a limited
+	chain of candidates and each block gets its own Huffman codes, which
+	favors speed over compression ratio.
+*/
+class ZlibCompressor final
+{
+public:
+	// Appends the compressed form of <numBytes> bytes starting at <data> to
+	// <out_compressed>.
+	static void compress(
+		const uint8*        data,
+		std::size_t         numBytes,
+		std::vector<uint8>* out_compressed);
+};
+
+}// end namespace ph
@@ -3,8 +3,8 @@
 namespace ph
 {
 
-mipmapgen::mipmapgen(const std::size_t numThreads) :
-	m_workers(numThreads)
+mipmapgen::mipmapgen() :
+	m_works()
 {
 
 }
@@ -2,7 +2,7 @@
 
 #include "Utility/INoncopyable.h"
 #include "Frame/TFrame.h"
-#include "Utility/FixedSizeThreadPool.h"
+#include "Utility/TaskGroup.h"
 #include "Math/Function/TConstant2D.h"
 #include "Math/math.h"
 
@@ -18,10 +18,11 @@ namespace ph
 class mipmapgen final : public INoncopyable
 {
 public:
-	mipmapgen(const std::size_t numThreads);
+	// Mipmaps are generated on the shared scheduler.
+	mipmapgen();
 	~mipmapgen()
 	{
-		m_workers.waitAllWorks();
+		m_works.wait();
 	}
 
 	// Generates a series of MIP levels from specified source frame.
@@ -37,14 +38,14 @@ public:
 		-> std::future<Mipmaps<T, N>>
 	{
 		// Using shared_ptr here because if we move a std::promise to some lambda 
-		// and use it to construct a Work, which is a std::function, then we can
+		// and use it to construct a Task, which is a std::function, then we can
 		// not satisfy the CopyConstructible requirement that a std::function 
 		// needs.
 		auto promisedMipmaps = std::make_shared<std::promise<Mipmaps<T, N>>>();
 
 		std::future<Mipmaps<T, N>> futureMipmaps = promisedMipmaps->get_future();
 
-		m_workers.queueWork([workingResult = promisedMipmaps, src = source]()
+		m_works.run([workingResult = promisedMipmaps, src = source]()
 		{
 			TFrame<T, N> level0;
 			if(math::is_power_of_2(src.widthPx()) && math::is_power_of_2(src.heightPx()))
@@ -80,7 +81,7 @@ public:
 	}
 
 private:
-	FixedSizeThreadPool m_workers;
+	TaskGroup m_works;
 };
 
 }// end namespace ph
\ No newline at end of file
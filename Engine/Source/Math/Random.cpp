@@ -2,36 +2,58 @@
 #include "Math/math.h"
 #include "Common/assertion.h"
 
-#include <random>
+#include <limits>
+#include <algorithm>
 
 namespace ph
 {
 
-std::atomic<int32> Random::seed(37);
-const int32 Random::incrementation = 17;
+std::atomic<uint64> Random::nextStreamId(0);
 
-// NOTE: consider using __rdtsc() as seed (if film merging is desired)
-real Random::genUniformReal_i0_e1()
+std::size_t Random::genUniformIndex_iL_eU(const std::size_t lowerBound,
+                                          const std::size_t upperBound)
 {
-	// TODO: check whether std::mt19937 can be used for 64-bit random number generating
-	static thread_local std::mt19937 generator(seed += incrementation);
+	PH_ASSERT(upperBound > lowerBound);
 
-	// NOTE: we can just create a new distribution for each call
-	// (profile the code to find out which is better)
-	static thread_local std::uniform_real_distribution<real> distribution(0.0_r, 1.0_r);
+	const uint64 numIntervals = upperBound - lowerBound;
+	if(PrimarySampleSequence* const sequence = threadState().sequence)
+	{
+		// indices follow the overriding numbers, so they mutate along with them
+		const auto index = static_cast<uint64>(sequence->next() * static_cast<real>(numIntervals));
+		return lowerBound + static_cast<std::size_t>(std::min(index, numIntervals - 1));
+	}
+	else if(numIntervals <= std::numeric_limits<uint32>::max())
+	{
+		return lowerBound + threadGenerator().genUniformIndex_i0_eU(static_cast<uint32>(numIntervals));
+	}
+	else
+	{
+		// the bias of modulo is negligible for such large ranges
+		return lowerBound + static_cast<std::size_t>(genSeed() % numIntervals);
+	}
+}
 
-	return distribution(generator);
+uint64 Random::genSeed()
+{
+	Pcg32& generator = threadGenerator();
+
+	const uint64 high = generator.genUint32();
+	return (high << 32) | generator.genUint32();
 }
 
-std::size_t Random::genUniformIndex_iL_eU(const std::size_t lowerBound,
-                                          const std::size_t upperBound)
+void Random::seedThisThread(const uint64 seed, const uint64 streamId)
 {
-	PH_ASSERT(upperBound > lowerBound);
+	threadGenerator() = Pcg32(seed, streamId);
+}
 
-	const std::size_t numIntervals = upperBound - lowerBound;
-	std::size_t index = static_cast<std::size_t>(lowerBound + genUniformReal_i0_e1() * numIntervals);
+void Random::keyThisThread(const uint64 key0, const uint64 key1, const uint64 key2)
+{
+	threadGenerator() = Pcg32::makeKeyed(key0, key1, key2);
+}
 
-	return index < lowerBound ? lowerBound : (index >= upperBound ? upperBound - 1 : index);
+void Random::overrideThisThread(PrimarySampleSequence* const sequence)
+{
+	threadState().sequence = sequence;
 }
 
 // FIXME: type-punning with unions is undefined behavior
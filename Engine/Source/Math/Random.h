@@ -1,12 +1,22 @@
 #pragma once
 
 #include "Common/primitive_type.h"
+#include "Math/Random/Pcg32.h"
+#include "Math/Random/PrimarySampleSequence.h"
 
 #include <atomic>
+#include <cstddef>
 
 namespace ph
 {
 
+/*
+	Each thread has its own generator. Unless reseeded, generators of 
+	different threads use different streams, assigned in the order threads
+	first generate a number. For results that do not depend on threads,
+	reseed with seedThisThread() before each piece of work, or use a Pcg32 
+	directly.
+*/
 class Random final
 {
 	// Method Notations
@@ -25,10 +35,75 @@ public:
 	static real        genUniformReal_i0_e1();
 	static std::size_t genUniformIndex_iL_eU(std::size_t lowerBound, 
 	                                         std::size_t upperBound);
+	static void        genUniformReals_i0_e1(real* out_reals, std::size_t numReals);
+
+	// Generates a seed for creating other generators.
+	static uint64 genSeed();
+
+	// Restarts the generator of the calling thread from a known state.
+	static void seedThisThread(uint64 seed, uint64 streamId = 0);
+
+	// Restarts the generator of the calling thread from a state keyed by up 
+	// to three values, see Pcg32::makeKeyed().
+	static void keyThisThread(uint64 key0, uint64 key1 = 0, uint64 key2 = 0);
+
+	// Makes the calling thread take uniform numbers from <sequence> instead 
+	// of its generator, until called again with nullptr. Markov chain methods 
+	// use this to mutate the numbers a sample is made of. Seeds are still 
+	// generated by the generator.
+	static void overrideThisThread(PrimarySampleSequence* sequence);
 
 private:
-	static std::atomic<int32> seed;
-	static const int32 incrementation;
+	struct ThreadState
+	{
+		Pcg32                  generator;
+		PrimarySampleSequence* sequence;
+	};
+
+	static ThreadState& threadState();
+	static Pcg32& threadGenerator();
+
+	static std::atomic<uint64> nextStreamId;
 };
 
+// In-header Implementations:
+
+inline real Random::genUniformReal_i0_e1()
+{
+	ThreadState& state = threadState();
+
+	return state.sequence ? state.sequence->next() : state.generator.genUniformReal_i0_e1();
+}
+
+inline void Random::genUniformReals_i0_e1(real* const out_reals, const std::size_t numReals)
+{
+	ThreadState& state = threadState();
+	if(state.sequence)
+	{
+		for(std::size_t i = 0; i < numReals; ++i)
+		{
+			out_reals[i] = state.sequence->next();
+		}
+	}
+	else
+	{
+		state.generator.genUniformReals_i0_e1(out_reals, numReals);
+	}
+}
+
+inline auto Random::threadState()
+	-> ThreadState&
+{
+	static thread_local ThreadState state{
+		Pcg32(37, nextStreamId.fetch_add(1, std::memory_order_relaxed)), 
+		nullptr};
+
+	return state;
+}
+
+inline Pcg32& Random::threadGenerator()
+{
+	return threadState().generator;
+}
+
 }// end namespace ph
\ No newline at end of file
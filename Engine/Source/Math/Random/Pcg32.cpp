@@ -0,0 +1,85 @@
+#include "Math/Random/Pcg32.h"
+
+namespace ph
+{
+
+void Pcg32::genUniformReals_i0_e1(real* const out_reals, const std::size_t numReals)
+{
+	PH_ASSERT(out_reals || numReals == 0);
+
+	// A single LCG has a serial dependency on its state. Here NUM_LANES
+	// consecutive states are stepped NUM_LANES at a time instead, which are
+	// independent of each other and can be computed in parallel (by the CPU
+	// pipeline or by SIMD instructions).
+	constexpr std::size_t NUM_LANES = 4;
+
+	std::size_t i = 0;
+	if(numReals >= NUM_LANES)
+	{
+		uint64 laneMultiplier, laneIncrement;
+		calcStepsLcg(NUM_LANES, &laneMultiplier, &laneIncrement);
+
+		uint64 laneStates[NUM_LANES];
+		for(std::size_t lane = 0; lane < NUM_LANES; ++lane)
+		{
+			laneStates[lane] = m_state;
+			m_state = m_state * MULTIPLIER + m_inc;
+		}
+
+		for(; i + NUM_LANES <= numReals; i += NUM_LANES)
+		{
+			for(std::size_t lane = 0; lane < NUM_LANES; ++lane)
+			{
+				out_reals[i + lane] = toUniformReal(output(laneStates[lane]));
+				laneStates[lane] = laneStates[lane] * laneMultiplier + laneIncrement;
+			}
+		}
+
+		// the first lane is at the state right after the last generated number
+		m_state = laneStates[0];
+	}
+
+	for(; i < numReals; ++i)
+	{
+		out_reals[i] = genUniformReal_i0_e1();
+	}
+}
+
+void Pcg32::advance(const int64 delta)
+{
+	// going back is the same as going forward by 2^64 - |delta| steps, as
+	// the period is 2^64
+	uint64 multiplier, increment;
+	calcStepsLcg(static_cast<uint64>(delta), &multiplier, &increment);
+
+	m_state = m_state * multiplier + increment;
+}
+
+void Pcg32::calcStepsLcg(uint64 delta, uint64* const out_multiplier, uint64* const out_increment) const
+{
+	PH_ASSERT(out_multiplier && out_increment);
+
+	// Brown's algorithm, "Random Number Generation with Arbitrary Strides"
+	// (1994), composes the LCG with itself by repeated squaring.
+
+	uint64 accMultiplier = 1;
+	uint64 accIncrement  = 0;
+	uint64 curMultiplier = MULTIPLIER;
+	uint64 curIncrement  = m_inc;
+	while(delta > 0)
+	{
+		if(delta & 1)
+		{
+			accMultiplier *= curMultiplier;
+			accIncrement   = accIncrement * curMultiplier + curIncrement;
+		}
+		curIncrement   = (curMultiplier + 1) * curIncrement;
+		curMultiplier *= curMultiplier;
+		delta /= 2;
+	}
+
+	*out_multiplier = accMultiplier;
+	*out_increment  = accIncrement;
+}
+
+}// end namespace ph
@@ -0,0 +1,157 @@
+#pragma once
+
+#include "Common/primitive_type.h"
+#include "Common/assertion.h"
+#include "Math/hash.h"
+
+#include <cstddef>
+#include <type_traits>
+
+namespace ph
+{
+
+/*
+	The PCG32 random number generator (XSH-RR variant) by Melissa O'Neill.
+	Its state is only 16 bytes, so it is cheap to create one for each pixel,
+	sample or path; different stream IDs give independent sequences for the
+	same initial state.
+
+	Reference: https://www.pcg-random.org/
+*/
+class Pcg32 final
+{
+public:
+	// Creates a generator whose stream is keyed by up to three values (e.g.,
+	// pixel, sample and dimension indices). Generators of different keys are
+	// uncorrelated, and the same keys always give the same sequence.
+	static Pcg32 makeKeyed(uint64 key0, uint64 key1 = 0, uint64 key2 = 0);
+
+public:
+	Pcg32();
+	Pcg32(uint64 initState, uint64 streamId);
+
+	uint32 genUint32();
+
+	// Generates a uniformly distributed real in [0, 1).
+	real genUniformReal_i0_e1();
+
+	// Generates a uniformly distributed index in [0, <upperBound>).
+	uint32 genUniformIndex_i0_eU(uint32 upperBound);
+
+	// Generates <numReals> uniformly distributed reals in [0, 1). The results
+	// are identical to calling genUniformReal_i0_e1() the same number of
+	// times, only faster.
+	void genUniformReals_i0_e1(real* out_reals, std::size_t numReals);
+
+	// Skips <delta> numbers (or goes back if <delta> is negative) in
+	// O(log(delta)) time.
+	void advance(int64 delta);
+
+	bool operator == (const Pcg32& rhs) const;
+	bool operator != (const Pcg32& rhs) const;
+
+private:
+	static constexpr uint64 MULTIPLIER    = 6364136223846793005ULL;
+	static constexpr uint64 DEFAULT_STATE = 0x853c49e6748fea9bULL;
+	static constexpr uint64 DEFAULT_INC   = 0xda3e39cb94b95bdbULL;
+
+	uint64 m_state;
+	uint64 m_inc;
+
+	static uint32 output(uint64 state);
+	static real   toUniformReal(uint32 bits);
+
+	// Calculates the multiplier and increment equivalent to <delta> steps.
+	void calcStepsLcg(uint64 delta, uint64* out_multiplier, uint64* out_increment) const;
+};
+
+// In-header Implementations:
+
+inline Pcg32 Pcg32::makeKeyed(const uint64 key0, const uint64 key1, const uint64 key2)
+{
+	const uint64 stateKey  = hash::mix_bits_64(key0 ^ hash::mix_bits_64(key1 ^ hash::mix_bits_64(key2)));
+	const uint64 streamKey = hash::mix_bits_64(stateKey ^ DEFAULT_INC);
+
+	return Pcg32(stateKey, streamKey);
+}
+
+inline Pcg32::Pcg32() :
+	m_state(DEFAULT_STATE),
+	m_inc  (DEFAULT_INC)
+{}
+
+inline Pcg32::Pcg32(const uint64 initState, const uint64 streamId) :
+	m_state(0),
+	m_inc  ((streamId << 1) | 1)
+{
+	// the seeding procedure of the reference implementation
+	genUint32();
+	m_state += initState;
+	genUint32();
+}
+
+inline uint32 Pcg32::genUint32()
+{
+	const uint64 oldState = m_state;
+	m_state = oldState * MULTIPLIER + m_inc;
+
+	return output(oldState);
+}
+
+inline real Pcg32::genUniformReal_i0_e1()
+{
+	return toUniformReal(genUint32());
+}
+
+inline uint32 Pcg32::genUniformIndex_i0_eU(const uint32 upperBound)
+{
+	PH_ASSERT_GT(upperBound, 0);
+
+	// Lemire's nearly divisionless method, "Fast Random Integer Generation in
+	// an Interval" (2019)
+
+	uint64 product = static_cast<uint64>(genUint32()) * upperBound;
+	if(static_cast<uint32>(product) < upperBound)
+	{
+		const uint32 threshold = (0U - upperBound) % upperBound;
+		while(static_cast<uint32>(product) < threshold)
+		{
+			product = static_cast<uint64>(genUint32()) * upperBound;
+		}
+	}
+	return static_cast<uint32>(product >> 32);
+}
+
+inline bool Pcg32::operator == (const Pcg32& rhs) const
+{
+	return m_state == rhs.m_state && m_inc == rhs.m_inc;
+}
+
+inline bool Pcg32::operator != (const Pcg32& rhs) const
+{
+	return !(*this == rhs);
+}
+
+inline uint32 Pcg32::output(const uint64 state)
+{
+	const uint32 xorShifted = static_cast<uint32>(((state >> 18) ^ state) >> 27);
+	const uint32 rotation   = static_cast<uint32>(state >> 59);
+
+	return (xorShifted >> rotation) | (xorShifted << ((0U - rotation) & 31));
+}
+
+inline real Pcg32::toUniformReal(const uint32 bits)
+{
+	// Only use as many bits as the mantissa can hold, so the result is
+	// exactly representable and never rounds up to 1.
+	if constexpr(std::is_same_v<real, float32>)
+	{
+		return static_cast<real>(bits >> 8) * 0x1p-24f;
+	}
+	else
+	{
+		return static_cast<real>(bits) * 0x1p-32;
+	}
+}
+
+}// end namespace ph
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "Common/primitive_type.h"
+#include "Math/Random/Pcg32.h"
+
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include <cmath>
+
+namespace ph
+{
+
+/*
+	The uniform numbers a sample (e.g., a photon path) is made of, seen as a
+	point in primary sample space, as in Kelemen et al.'s Metropolis light
+	transport. A proposal draws the numbers in order with next(), either all
+	anew (a large step) or by perturbing each number of the current sample
+	by up to a given size (a small step, which is symmetric). Numbers beyond
+	those of the current sample are always drawn anew. A proposal becomes the
+	current sample only if accepted.
+*/
+class PrimarySampleSequence final
+{
+public:
+	explicit PrimarySampleSequence(const Pcg32& generator);
+
+	void proposeLargeStep();
+	void proposeSmallStep(real mutationSize);
+	void accept();
+
+	// Generates the next number of the proposal, in [0, 1).
+	real next();
+
+	std::size_t numCurrentValues() const;
+
+private:
+	Pcg32             m_generator;
+	std::vector<real> m_currentValues;
+	std::vector<real> m_proposedValues;
+	real              m_mutationSize;
+};
+
+// In-header Implementations:
+
+inline PrimarySampleSequence::PrimarySampleSequence(const Pcg32& generator) :
+	m_generator     (generator),
+	m_currentValues (),
+	m_proposedValues(),
+	m_mutationSize  (0.0_r)
+{}
+
+inline void PrimarySampleSequence::proposeLargeStep()
+{
+	m_proposedValues.clear();
+	m_mutationSize = 0.0_r;
+}
+
+inline void PrimarySampleSequence::proposeSmallStep(const real mutationSize)
+{
+	m_proposedValues.clear();
+	m_mutationSize = mutationSize;
+}
+
+inline void PrimarySampleSequence::accept()
+{
+	std::swap(m_currentValues, m_proposedValues);
+}
+
+inline real PrimarySampleSequence::next()
+{
+	const std::size_t index = m_proposedValues.size();
+
+	real value = m_generator.genUniformReal_i0_e1();
+	if(m_mutationSize > 0.0_r && index < m_currentValues.size())
+	{
+		// wrapping around keeps the perturbation symmetric
+		value = m_currentValues[index] + (value * 2.0_r - 1.0_r) * m_mutationSize;
+		value = value - std::floor(value);
+		value = value < 1.0_r ? value : 0.0_r;
+	}
+
+	m_proposedValues.push_back(value);
+	return value;
+}
+
+inline std::size_t PrimarySampleSequence::numCurrentValues() const
+{
+	return m_currentValues.size();
+}
+
+}// end namespace ph
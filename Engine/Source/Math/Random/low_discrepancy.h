@@ -0,0 +1,132 @@
+#pragma once
+
+#include "Common/primitive_type.h"
+#include "Common/assertion.h"
+#include "Math/hash.h"
+
+#include <cstddef>
+#include <algorithm>
+#include <limits>
+
+namespace ph
+{
+
+/*
+	Building blocks of low-discrepancy sequences. Sequence values are either
+	32-bit fixed-point fractions in [0, 1) (base-2 sequences) or floating-point
+	values in [0, 1) (other bases).
+*/
+namespace low_discrepancy
+{
+
+inline uint32 reverse_bits(uint32 value)
+{
+	value = (value << 16) | (value >> 16);
+	value = ((value & 0x00ff00ff) << 8) | ((value & 0xff00ff00) >> 8);
+	value = ((value & 0x0f0f0f0f) << 4) | ((value & 0xf0f0f0f0) >> 4);
+	value = ((value & 0x33333333) << 2) | ((value & 0xcccccccc) >> 2);
+	value = ((value & 0x55555555) << 1) | ((value & 0xaaaaaaaa) >> 1);
+
+	return value;
+}
+
+/*
+	A hash-based permutation where each bit is only affected by less
+	significant bits. The constants are from Brent Burley's paper "Practical
+	Hash-based Owen Scrambling" (2020), which improves the original one by
+	Laine and Karras.
+*/
+inline uint32 laine_karras_permutation(uint32 value, const uint32 seed)
+{
+	value ^= value * 0x3d20adea;
+	value += seed;
+	value *= (seed >> 16) | 1;
+	value ^= value * 0x05526c56;
+	value ^= value * 0x53a22864;
+
+	return value;
+}
+
+/*
+	Owen scrambles (nested uniform scrambling) a base-2 fixed-point fraction:
+	each digit is flipped depending on all the more significant digits. The
+	scrambled value preserves all elementary interval stratifications of the
+	original one.
+*/
+inline uint32 owen_scramble_base2(const uint32 fraction, const uint32 seed)
+{
+	return reverse_bits(laine_karras_permutation(reverse_bits(fraction), seed));
+}
+
+// The first two dimensions of the Sobol sequence, in fixed-point. Dimension 0
+// is the base-2 radical inverse.
+
+inline uint32 sobol_dim0(const uint32 index)
+{
+	return reverse_bits(index);
+}
+
+inline uint32 sobol_dim1(uint32 index)
+{
+	uint32 result = 0;
+	for(uint32 v = 1U << 31; index != 0; index >>= 1, v ^= v >> 1)
+	{
+		if(index & 1)
+		{
+			result ^= v;
+		}
+	}
+	return result;
+}
+
+/*
+	Radical inverse of <index> in <base>, with each digit permuted by a
+	random shift depending on <seed> and all the more significant digits
+	(a nested scrambling in the sense of Owen). Digits are generated until
+	the precision of float64 is exhausted.
+*/
+inline float64 owen_scrambled_radical_inverse(
+	const uint32 base,
+	uint64       index,
+	const uint32 seed)
+{
+	PH_ASSERT_GE(base, 2);
+
+	const float64 reciBase   = 1.0 / static_cast<float64>(base);
+	float64       reciBaseN  = 1.0;
+	uint64        digits     = 0;
+	uint32        digitsHash = seed;
+	while(1.0 - static_cast<float64>(base - 1) * reciBaseN < 1.0)
+	{
+		const uint64 nextIndex = index / base;
+		const uint32 digit     = static_cast<uint32>(index - nextIndex * base);
+		const uint32 shift     = digitsHash % base;
+		const uint32 permuted  = (digit + shift) % base;
+
+		digits      = digits * base + permuted;
+		digitsHash  = hash::combine_32(digitsHash, permuted);
+		reciBaseN  *= reciBase;
+		index       = nextIndex;
+	}
+
+	return std::min(static_cast<float64>(digits) * reciBaseN, 1.0 - std::numeric_limits<float64>::epsilon());
+}
+
+// Converts a fraction (either float64 or 32-bit fixed-point) to a real in 
+// [0, 1); a plain cast may round it up to 1.
+
+inline real fraction_to_real(const float64 fraction)
+{
+	constexpr real ONE_MINUS_EPSILON = static_cast<real>(1) - std::numeric_limits<real>::epsilon();
+
+	return std::min(static_cast<real>(fraction), ONE_MINUS_EPSILON);
+}
+
+inline real fraction_to_real(const uint32 fraction)
+{
+	return fraction_to_real(fraction * 0x1p-32);
+}
+
+}// end namespace low_discrepancy
+
+}// end namespace ph
@@ -2,6 +2,7 @@
 
 #include "Common/primitive_type.h"
 #include "Math/math_fwd.h"
+#include "Math/TSimdPack.h"
 
 #include <cstddef>
 #include <array>
@@ -11,6 +12,12 @@
 namespace ph
 {
 
+/*
+	An array of N values with element-wise arithmetic. Operations are carried
+	out with SIMD instructions (see TSimdPack) when the element type supports
+	it and N is at least a pack wide, e.g., for sampled spectral strengths;
+	the storage is then aligned to the size of a pack.
+*/
 template<typename T, std::size_t N>
 class TArithmeticArray final
 {
@@ -85,8 +92,13 @@ public:
 
 	std::string toString() const;
 
+private:
+	using Pack = TSimdPack<T>;
+
+	static constexpr bool IS_SIMD = Pack::IS_SUPPORTED && N >= Pack::WIDTH;
+
 protected:
-	std::array<T, N> m;
+	alignas(IS_SIMD ? sizeof(T) * Pack::WIDTH : alignof(std::array<T, N>)) std::array<T, N> m;
 };
 
 }// end namespace ph
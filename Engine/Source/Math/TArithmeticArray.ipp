@@ -44,18 +44,22 @@ inline TArithmeticArray<T, N> TArithmeticArray<T, N>::add(const TArithmeticArray
 template<typename T, std::size_t N>
 inline TArithmeticArray<T, N> TArithmeticArray<T, N>::add(const T rhs) const
 {
-	TArithmeticArray result(*this);
-	for(std::size_t i = 0; i < N; ++i)
-	{
-		result.m[i] += rhs;
-	}
-	return result;
+	return TArithmeticArray(*this).addLocal(rhs);
 }
 
 template<typename T, std::size_t N>
 inline TArithmeticArray<T, N>& TArithmeticArray<T, N>::addLocal(const TArithmeticArray& rhs)
 {
-	for(std::size_t i = 0; i < N; ++i)
+	std::size_t i = 0;
+	if constexpr(IS_SIMD)
+	{
+		for(; i + Pack::WIDTH <= N; i += Pack::WIDTH)
+		{
+			Pack::store(&m[i], Pack::add(Pack::load(&m[i]), Pack::load(&rhs.m[i])));
+		}
+	}
+
+	for(; i < N; ++i)
 	{
 		m[i] += rhs.m[i];
 	}
@@ -66,7 +70,17 @@ inline TArithmeticArray<T, N>& TArithmeticArray<T, N>::addLocal(const TArithmeti
 template<typename T, std::size_t N>
 inline TArithmeticArray<T, N>& TArithmeticArray<T, N>::addLocal(const T rhs)
 {
-	for(std::size_t i = 0; i < N; ++i)
+	std::size_t i = 0;
+	if constexpr(IS_SIMD)
+	{
+		const auto rhsPack = Pack::set(rhs);
+		for(; i + Pack::WIDTH <= N; i += Pack::WIDTH)
+		{
+			Pack::store(&m[i], Pack::add(Pack::load(&m[i]), rhsPack));
+		}
+	}
+
+	for(; i < N; ++i)
 	{
 		m[i] += rhs;
 	}
@@ -89,7 +103,16 @@ inline TArithmeticArray<T, N> TArithmeticArray<T, N>::sub(const T rhs) const
 template<typename T, std::size_t N>
 inline TArithmeticArray<T, N>& TArithmeticArray<T, N>::subLocal(const TArithmeticArray& rhs)
 {
-	for(std::size_t i = 0; i < N; ++i)
+	std::size_t i = 0;
+	if constexpr(IS_SIMD)
+	{
+		for(; i + Pack::WIDTH <= N; i += Pack::WIDTH)
+		{
+			Pack::store(&m[i], Pack::sub(Pack::load(&m[i]), Pack::load(&rhs.m[i])));
+		}
+	}
+
+	for(; i < N; ++i)
 	{
 		m[i] -= rhs.m[i];
 	}
@@ -100,7 +123,17 @@ inline TArithmeticArray<T, N>& TArithmeticArray<T, N>::subLocal(const TArithmeti
 template<typename T, std::size_t N>
 inline TArithmeticArray<T, N>& TArithmeticArray<T, N>::subLocal(const T rhs)
 {
-	for(std::size_t i = 0; i < N; ++i)
+	std::size_t i = 0;
+	if constexpr(IS_SIMD)
+	{
+		const auto rhsPack = Pack::set(rhs);
+		for(; i + Pack::WIDTH <= N; i += Pack::WIDTH)
+		{
+			Pack::store(&m[i], Pack::sub(Pack::load(&m[i]), rhsPack));
+		}
+	}
+
+	for(; i < N; ++i)
 	{
 		m[i] -= rhs;
 	}
@@ -123,7 +156,16 @@ inline TArithmeticArray<T, N> TArithmeticArray<T, N>::mul(const T rhs) const
 template<typename T, std::size_t N>
 inline TArithmeticArray<T, N>& TArithmeticArray<T, N>::mulLocal(const TArithmeticArray& rhs)
 {
-	for(std::size_t i = 0; i < N; ++i)
+	std::size_t i = 0;
+	if constexpr(IS_SIMD)
+	{
+		for(; i + Pack::WIDTH <= N; i += Pack::WIDTH)
+		{
+			Pack::store(&m[i], Pack::mul(Pack::load(&m[i]), Pack::load(&rhs.m[i])));
+		}
+	}
+
+	for(; i < N; ++i)
 	{
 		m[i] *= rhs.m[i];
 	}
@@ -134,7 +176,17 @@ inline TArithmeticArray<T, N>& TArithmeticArray<T, N>::mulLocal(const TArithmeti
 template<typename T, std::size_t N>
 inline TArithmeticArray<T, N>& TArithmeticArray<T, N>::mulLocal(const T rhs)
 {
-	for(std::size_t i = 0; i < N; ++i)
+	std::size_t i = 0;
+	if constexpr(IS_SIMD)
+	{
+		const auto rhsPack = Pack::set(rhs);
+		for(; i + Pack::WIDTH <= N; i += Pack::WIDTH)
+		{
+			Pack::store(&m[i], Pack::mul(Pack::load(&m[i]), rhsPack));
+		}
+	}
+
+	for(; i < N; ++i)
 	{
 		m[i] *= rhs;
 	}
@@ -157,7 +209,16 @@ inline TArithmeticArray<T, N> TArithmeticArray<T, N>::div(const T rhs) const
 template<typename T, std::size_t N>
 inline TArithmeticArray<T, N>& TArithmeticArray<T, N>::divLocal(const TArithmeticArray& rhs)
 {
-	for(std::size_t i = 0; i < N; ++i)
+	std::size_t i = 0;
+	if constexpr(IS_SIMD)
+	{
+		for(; i + Pack::WIDTH <= N; i += Pack::WIDTH)
+		{
+			Pack::store(&m[i], Pack::div(Pack::load(&m[i]), Pack::load(&rhs.m[i])));
+		}
+	}
+
+	for(; i < N; ++i)
 	{
 		m[i] /= rhs.m[i];
 	}
@@ -168,7 +229,17 @@ inline TArithmeticArray<T, N>& TArithmeticArray<T, N>::divLocal(const TArithmeti
 template<typename T, std::size_t N>
 inline TArithmeticArray<T, N>& TArithmeticArray<T, N>::divLocal(const T rhs)
 {
-	for(std::size_t i = 0; i < N; ++i)
+	std::size_t i = 0;
+	if constexpr(IS_SIMD)
+	{
+		const auto rhsPack = Pack::set(rhs);
+		for(; i + Pack::WIDTH <= N; i += Pack::WIDTH)
+		{
+			Pack::store(&m[i], Pack::div(Pack::load(&m[i]), rhsPack));
+		}
+	}
+
+	for(; i < N; ++i)
 	{
 		m[i] /= rhs;
 	}
@@ -191,7 +262,16 @@ inline TArithmeticArray<T, N> TArithmeticArray<T, N>::pow(const integer exponent
 template<typename T, std::size_t N>
 inline TArithmeticArray<T, N>& TArithmeticArray<T, N>::sqrtLocal()
 {
-	for(std::size_t i = 0; i < N; ++i)
+	std::size_t i = 0;
+	if constexpr(IS_SIMD)
+	{
+		for(; i + Pack::WIDTH <= N; i += Pack::WIDTH)
+		{
+			Pack::store(&m[i], Pack::sqrt(Pack::load(&m[i])));
+		}
+	}
+
+	for(; i < N; ++i)
 	{
 		m[i] = std::sqrt(m[i]);
 	}
@@ -203,7 +283,19 @@ template<typename T, std::size_t N>
 inline TArithmeticArray<T, N>& TArithmeticArray<T, N>::clampLocal(const T lowerBound, 
                                                                   const T upperBound)
 {
-	for(std::size_t i = 0; i < N; ++i)
+	std::size_t i = 0;
+	if constexpr(IS_SIMD)
+	{
+		// max() picks the lower bound for NaNs, same as std::fmax()
+		const auto lowerPack = Pack::set(lowerBound);
+		const auto upperPack = Pack::set(upperBound);
+		for(; i + Pack::WIDTH <= N; i += Pack::WIDTH)
+		{
+			Pack::store(&m[i], Pack::min(Pack::max(Pack::load(&m[i]), lowerPack), upperPack));
+		}
+	}
+
+	for(; i < N; ++i)
 	{
 		m[i] = std::fmin(upperBound, std::fmax(m[i], lowerBound));
 	}
@@ -215,7 +307,18 @@ template<typename T, std::size_t N>
 inline T TArithmeticArray<T, N>::dot(const TArithmeticArray& rhs) const
 {
 	T result(0);
-	for(std::size_t i = 0; i < N; ++i)
+	std::size_t i = 0;
+	if constexpr(IS_SIMD)
+	{
+		auto resultPack = Pack::set(0);
+		for(; i + Pack::WIDTH <= N; i += Pack::WIDTH)
+		{
+			resultPack = Pack::add(resultPack, Pack::mul(Pack::load(&m[i]), Pack::load(&rhs.m[i])));
+		}
+		result = Pack::sum(resultPack);
+	}
+
+	for(; i < N; ++i)
 	{
 		result += m[i] * rhs.m[i];
 	}
@@ -227,7 +330,18 @@ template<typename T, std::size_t N>
 inline T TArithmeticArray<T, N>::sum() const
 {
 	T result(0);
-	for(std::size_t i = 0; i < N; ++i)
+	std::size_t i = 0;
+	if constexpr(IS_SIMD)
+	{
+		auto resultPack = Pack::set(0);
+		for(; i + Pack::WIDTH <= N; i += Pack::WIDTH)
+		{
+			resultPack = Pack::add(resultPack, Pack::load(&m[i]));
+		}
+		result = Pack::sum(resultPack);
+	}
+
+	for(; i < N; ++i)
 	{
 		result += m[i];
 	}
@@ -245,7 +359,18 @@ template<typename T, std::size_t N>
 inline T TArithmeticArray<T, N>::max() const
 {
 	T maxValue = m[0];
-	for(std::size_t i = 1; i < N; ++i)
+	std::size_t i = 1;
+	if constexpr(IS_SIMD)
+	{
+		auto maxPack = Pack::load(&m[0]);
+		for(i = Pack::WIDTH; i + Pack::WIDTH <= N; i += Pack::WIDTH)
+		{
+			maxPack = Pack::max(Pack::load(&m[i]), maxPack);
+		}
+		maxValue = Pack::max(maxPack);
+	}
+
+	for(; i < N; ++i)
 	{
 		if(m[i] > maxValue)
 		{
@@ -275,7 +400,17 @@ inline TArithmeticArray<T, N> TArithmeticArray<T, N>::complement() const
 template<typename T, std::size_t N>
 inline TArithmeticArray<T, N>& TArithmeticArray<T, N>::complementLocal()
 {
-	for(std::size_t i = 0; i < N; ++i)
+	std::size_t i = 0;
+	if constexpr(IS_SIMD)
+	{
+		const auto onePack = Pack::set(1);
+		for(; i + Pack::WIDTH <= N; i += Pack::WIDTH)
+		{
+			Pack::store(&m[i], Pack::sub(onePack, Pack::load(&m[i])));
+		}
+	}
+
+	for(; i < N; ++i)
 	{
 		m[i] = 1 - m[i];
 	}
@@ -302,7 +437,20 @@ inline bool TArithmeticArray<T, N>::isZero() const
 	// TODO: using lengthSquared() == 0 can achieve branchless isZero()
 	// (will it be faster?)
 
-	for(std::size_t i = 0; i < N; ++i)
+	std::size_t i = 0;
+	if constexpr(IS_SIMD)
+	{
+		const auto zeroPack = Pack::set(0);
+		for(; i + Pack::WIDTH <= N; i += Pack::WIDTH)
+		{
+			if(Pack::isAnyNotEqual(Pack::load(&m[i]), zeroPack))
+			{
+				return false;
+			}
+		}
+	}
+
+	for(; i < N; ++i)
 	{
 		if(m[i] != 0)
 		{
@@ -316,7 +464,20 @@ inline bool TArithmeticArray<T, N>::isZero() const
 template<typename T, std::size_t N>
 inline bool TArithmeticArray<T, N>::isNonNegative() const
 {
-	for(std::size_t i = 0; i < N; ++i)
+	std::size_t i = 0;
+	if constexpr(IS_SIMD)
+	{
+		const auto zeroPack = Pack::set(0);
+		for(; i + Pack::WIDTH <= N; i += Pack::WIDTH)
+		{
+			if(Pack::isAnyLess(Pack::load(&m[i]), zeroPack))
+			{
+				return false;
+			}
+		}
+	}
+
+	for(; i < N; ++i)
 	{
 		if(m[i] < 0)
 		{
@@ -0,0 +1,223 @@
+#pragma once
+
+#include "Common/config.h"
+#include "Common/compiler.h"
+#include "Common/primitive_type.h"
+
+#include <cstddef>
+
+#if defined(PH_USE_SIMD) && defined(PH_ISA_HAS_SSE2)
+	#include <emmintrin.h>
+#endif
+
+#if defined(PH_USE_SIMD) && defined(PH_ISA_HAS_AVX)
+	#include <immintrin.h>
+#endif
+
+namespace ph
+{
+
+/*
+	Arithmetic on a pack of <WIDTH> values of type T, performed by a single
+	SIMD instruction each. Specialized for the element types and instruction
+	sets that are available to the current compilation; IS_SUPPORTED is false
+	for the general template, which has no operations.
+
+	Loads and stores do not require any alignment. Comparisons treat NaNs as
+	the corresponding scalar comparison does.
+*/
+template<typename T>
+class TSimdPack final
+{
+public:
+	static constexpr bool        IS_SUPPORTED = false;
+	static constexpr std::size_t WIDTH        = 1;
+};
+
+#if defined(PH_USE_SIMD) && defined(PH_ISA_HAS_AVX)
+
+template<>
+class TSimdPack<float32> final
+{
+public:
+	using Register = __m256;
+
+	static constexpr bool        IS_SUPPORTED = true;
+	static constexpr std::size_t WIDTH        = 8;
+
+	static inline Register load(const float32* const src)            { return _mm256_loadu_ps(src); }
+	static inline void store(float32* const dst, const Register a)   { _mm256_storeu_ps(dst, a); }
+	static inline Register set(const float32 value)                  { return _mm256_set1_ps(value); }
+	static inline Register add(const Register a, const Register b)   { return _mm256_add_ps(a, b); }
+	static inline Register sub(const Register a, const Register b)   { return _mm256_sub_ps(a, b); }
+	static inline Register mul(const Register a, const Register b)   { return _mm256_mul_ps(a, b); }
+	static inline Register div(const Register a, const Register b)   { return _mm256_div_ps(a, b); }
+	static inline Register sqrt(const Register a)                    { return _mm256_sqrt_ps(a); }
+
+	// Return <b> for elements where any operand is NaN.
+	static inline Register min(const Register a, const Register b)   { return _mm256_min_ps(a, b); }
+	static inline Register max(const Register a, const Register b)   { return _mm256_max_ps(a, b); }
+
+	static inline bool isAnyNotEqual(const Register a, const Register b)
+	{
+		return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_NEQ_UQ)) != 0;
+	}
+
+	static inline bool isAnyLess(const Register a, const Register b)
+	{
+		return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_LT_OQ)) != 0;
+	}
+
+	static inline float32 sum(const Register a)
+	{
+		const __m128 sum4 = _mm_add_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+		const __m128 sum2 = _mm_add_ps(sum4, _mm_movehl_ps(sum4, sum4));
+		return _mm_cvtss_f32(_mm_add_ss(sum2, _mm_shuffle_ps(sum2, sum2, 1)));
+	}
+
+	static inline float32 max(const Register a)
+	{
+		const __m128 max4 = _mm_max_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+		const __m128 max2 = _mm_max_ps(max4, _mm_movehl_ps(max4, max4));
+		return _mm_cvtss_f32(_mm_max_ss(max2, _mm_shuffle_ps(max2, max2, 1)));
+	}
+};
+
+template<>
+class TSimdPack<float64> final
+{
+public:
+	using Register = __m256d;
+
+	static constexpr bool        IS_SUPPORTED = true;
+	static constexpr std::size_t WIDTH        = 4;
+
+	static inline Register load(const float64* const src)            { return _mm256_loadu_pd(src); }
+	static inline void store(float64* const dst, const Register a)   { _mm256_storeu_pd(dst, a); }
+	static inline Register set(const float64 value)                  { return _mm256_set1_pd(value); }
+	static inline Register add(const Register a, const Register b)   { return _mm256_add_pd(a, b); }
+	static inline Register sub(const Register a, const Register b)   { return _mm256_sub_pd(a, b); }
+	static inline Register mul(const Register a, const Register b)   { return _mm256_mul_pd(a, b); }
+	static inline Register div(const Register a, const Register b)   { return _mm256_div_pd(a, b); }
+	static inline Register sqrt(const Register a)                    { return _mm256_sqrt_pd(a); }
+
+	// Return <b> for elements where any operand is NaN.
+	static inline Register min(const Register a, const Register b)   { return _mm256_min_pd(a, b); }
+	static inline Register max(const Register a, const Register b)   { return _mm256_max_pd(a, b); }
+
+	static inline bool isAnyNotEqual(const Register a, const Register b)
+	{
+		return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_NEQ_UQ)) != 0;
+	}
+
+	static inline bool isAnyLess(const Register a, const Register b)
+	{
+		return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_LT_OQ)) != 0;
+	}
+
+	static inline float64 sum(const Register a)
+	{
+		const __m128d sum2 = _mm_add_pd(_mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1));
+		return _mm_cvtsd_f64(_mm_add_sd(sum2, _mm_unpackhi_pd(sum2, sum2)));
+	}
+
+	static inline float64 max(const Register a)
+	{
+		const __m128d max2 = _mm_max_pd(_mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1));
+		return _mm_cvtsd_f64(_mm_max_sd(max2, _mm_unpackhi_pd(max2, max2)));
+	}
+};
+
+#elif defined(PH_USE_SIMD) && defined(PH_ISA_HAS_SSE2)
+
+template<>
+class TSimdPack<float32> final
+{
+public:
+	using Register = __m128;
+
+	static constexpr bool        IS_SUPPORTED = true;
+	static constexpr std::size_t WIDTH        = 4;
+
+	static inline Register load(const float32* const src)            { return _mm_loadu_ps(src); }
+	static inline void store(float32* const dst, const Register a)   { _mm_storeu_ps(dst, a); }
+	static inline Register set(const float32 value)                  { return _mm_set1_ps(value); }
+	static inline Register add(const Register a, const Register b)   { return _mm_add_ps(a, b); }
+	static inline Register sub(const Register a, const Register b)   { return _mm_sub_ps(a, b); }
+	static inline Register mul(const Register a, const Register b)   { return _mm_mul_ps(a, b); }
+	static inline Register div(const Register a, const Register b)   { return _mm_div_ps(a, b); }
+	static inline Register sqrt(const Register a)                    { return _mm_sqrt_ps(a); }
+
+	// Return <b> for elements where any operand is NaN.
+	static inline Register min(const Register a, const Register b)   { return _mm_min_ps(a, b); }
+	static inline Register max(const Register a, const Register b)   { return _mm_max_ps(a, b); }
+
+	static inline bool isAnyNotEqual(const Register a, const Register b)
+	{
+		return _mm_movemask_ps(_mm_cmpneq_ps(a, b)) != 0;
+	}
+
+	static inline bool isAnyLess(const Register a, const Register b)
+	{
+		return _mm_movemask_ps(_mm_cmplt_ps(a, b)) != 0;
+	}
+
+	static inline float32 sum(const Register a)
+	{
+		const __m128 sum2 = _mm_add_ps(a, _mm_movehl_ps(a, a));
+		return _mm_cvtss_f32(_mm_add_ss(sum2, _mm_shuffle_ps(sum2, sum2, 1)));
+	}
+
+	static inline float32 max(const Register a)
+	{
+		const __m128 max2 = _mm_max_ps(a, _mm_movehl_ps(a, a));
+		return _mm_cvtss_f32(_mm_max_ss(max2, _mm_shuffle_ps(max2, max2, 1)));
+	}
+};
+
+template<>
+class TSimdPack<float64> final
+{
+public:
+	using Register = __m128d;
+
+	static constexpr bool        IS_SUPPORTED = true;
+	static constexpr std::size_t WIDTH        = 2;
+
+	static inline Register load(const float64* const src)            { return _mm_loadu_pd(src); }
+	static inline void store(float64* const dst, const Register a)   { _mm_storeu_pd(dst, a); }
+	static inline Register set(const float64 value)                  { return _mm_set1_pd(value); }
+	static inline Register add(const Register a, const Register b)   { return _mm_add_pd(a, b); }
+	static inline Register sub(const Register a, const Register b)   { return _mm_sub_pd(a, b); }
+	static inline Register mul(const Register a, const Register b)   { return _mm_mul_pd(a, b); }
+	static inline Register div(const Register a, const Register b)   { return _mm_div_pd(a, b); }
+	static inline Register sqrt(const Register a)                    { return _mm_sqrt_pd(a); }
+
+	// Return <b> for elements where any operand is NaN.
+	static inline Register min(const Register a, const Register b)   { return _mm_min_pd(a, b); }
+	static inline Register max(const Register a, const Register b)   { return _mm_max_pd(a, b); }
+
+	static inline bool isAnyNotEqual(const Register a, const Register b)
+	{
+		return _mm_movemask_pd(_mm_cmpneq_pd(a, b)) != 0;
+	}
+
+	static inline bool isAnyLess(const Register a, const Register b)
+	{
+		return _mm_movemask_pd(_mm_cmplt_pd(a, b)) != 0;
+	}
+
+	static inline float64 sum(const Register a)
+	{
+		return _mm_cvtsd_f64(_mm_add_sd(a, _mm_unpackhi_pd(a, a)));
+	}
+
+	static inline float64 max(const Register a)
+	{
+		return _mm_cvtsd_f64(_mm_max_sd(a, _mm_unpackhi_pd(a, a)));
+	}
+};
+
+#endif
+
+}// end namespace ph
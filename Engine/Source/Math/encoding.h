@@ -0,0 +1,140 @@
+#pragma once
+
+#include "Common/primitive_type.h"
+#include "Common/assertion.h"
+#include "Math/TVector3.h"
+
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+#include <type_traits>
+#include <limits>
+
+namespace ph
+{
+
+/*
+	Compact, lossy encodings of common quantities, for storing large amounts
+	of them (e.g., photons).
+*/
+namespace encoding
+{
+
+/*
+	Maps a unit vector onto an octahedron, which is then unfolded onto a
+	square and quantized. <Code> can be uint16 (8 bits per axis) or uint32
+	(16 bits per axis); the maximum angular error is about 0.6 and 0.003
+	degrees, respectively.
+
+	Reference: Cigolle et al., "A Survey of Efficient Representations for
+	Independent Unit Vectors", JCGT 2014.
+*/
+template<typename Code>
+inline Code encode_unit_vector_octahedral(const Vector3R& unitVector)
+{
+	static_assert(std::is_same_v<Code, uint16> || std::is_same_v<Code, uint32>);
+
+	constexpr std::size_t NUM_AXIS_BITS = sizeof(Code) * 4;
+	constexpr real        MAX_AXIS_CODE = static_cast<real>((1ULL << NUM_AXIS_BITS) - 1);
+
+	const real l1Norm = std::abs(unitVector.x) + std::abs(unitVector.y) + std::abs(unitVector.z);
+	PH_ASSERT_GT(l1Norm, 0.0_r);
+
+	real u = unitVector.x / l1Norm;
+	real v = unitVector.y / l1Norm;
+	if(unitVector.z < 0.0_r)
+	{
+		// fold the lower hemisphere over the diagonals
+		const real foldedU = (1.0_r - std::abs(v)) * (u >= 0.0_r ? 1.0_r : -1.0_r);
+		const real foldedV = (1.0_r - std::abs(u)) * (v >= 0.0_r ? 1.0_r : -1.0_r);
+		u = foldedU;
+		v = foldedV;
+	}
+
+	const auto quantize = [](const real value)
+	{
+		const real normalized = std::clamp(value * 0.5_r + 0.5_r, 0.0_r, 1.0_r);
+		return static_cast<Code>(std::lround(normalized * MAX_AXIS_CODE));
+	};
+
+	return static_cast<Code>(quantize(u) | (quantize(v) << NUM_AXIS_BITS));
+}
+
+template<typename Code>
+inline Vector3R decode_unit_vector_octahedral(const Code code)
+{
+	static_assert(std::is_same_v<Code, uint16> || std::is_same_v<Code, uint32>);
+
+	constexpr std::size_t NUM_AXIS_BITS = sizeof(Code) * 4;
+	constexpr Code        AXIS_MASK     = static_cast<Code>((1ULL << NUM_AXIS_BITS) - 1);
+	constexpr real        MAX_AXIS_CODE = static_cast<real>(AXIS_MASK);
+
+	const real u = static_cast<real>(code & AXIS_MASK) / MAX_AXIS_CODE * 2.0_r - 1.0_r;
+	const real v = static_cast<real>((code >> NUM_AXIS_BITS) & AXIS_MASK) / MAX_AXIS_CODE * 2.0_r - 1.0_r;
+
+	Vector3R result(u, v, 1.0_r - std::abs(u) - std::abs(v));
+	if(result.z < 0.0_r)
+	{
+		result.x = (1.0_r - std::abs(v)) * (u >= 0.0_r ? 1.0_r : -1.0_r);
+		result.y = (1.0_r - std::abs(u)) * (v >= 0.0_r ? 1.0_r : -1.0_r);
+	}
+
+	return result.normalize();
+}
+
+/*
+	Encodes <N> non-negative values into N + 1 bytes: an 8-bit mantissa for
+	each value and an exponent shared by all, which is the RGBE format of
+	Greg Ward when N = 3. Values are relative to the largest one, which keeps
+	about 2 significant digits; negative values are stored as 0.
+
+	Reference: Ward, "Real Pixels", Graphics Gems II, 1991.
+*/
+template<std::size_t N>
+inline void encode_shared_exponent(const real* const values, uint8* const out_bytes)
+{
+	PH_ASSERT(values && out_bytes);
+
+	const real maxValue = *std::max_element(values, values + N);
+	if(!(maxValue > 1e-32_r))
+	{
+		std::fill(out_bytes, out_bytes + N + 1, uint8(0));
+		return;
+	}
+
+	// maxValue = mantissa * 2^exponent, where mantissa is in [0.5, 1)
+	int exponent;
+	std::frexp(maxValue, &exponent);
+	exponent = std::min(exponent, 127);
+
+	const real scale = std::ldexp(256.0_r, -exponent);
+	for(std::size_t i = 0; i < N; ++i)
+	{
+		const real mantissa = std::clamp(values[i] * scale, 0.0_r, 255.0_r);
+		out_bytes[i] = static_cast<uint8>(mantissa);
+	}
+	out_bytes[N] = static_cast<uint8>(exponent + 128);
+}
+
+template<std::size_t N>
+inline void decode_shared_exponent(const uint8* const bytes, real* const out_values)
+{
+	PH_ASSERT(bytes && out_values);
+
+	if(bytes[N] == 0)
+	{
+		std::fill(out_values, out_values + N, 0.0_r);
+		return;
+	}
+
+	// take the center of each quantization interval
+	const real scale = std::ldexp(1.0_r, static_cast<int>(bytes[N]) - (128 + 8));
+	for(std::size_t i = 0; i < N; ++i)
+	{
+		out_values[i] = bytes[i] != 0 ? (static_cast<real>(bytes[i]) + 0.5_r) * scale : 0.0_r;
+	}
+}
+
+}// end namespace encoding
+
+}// end namespace ph
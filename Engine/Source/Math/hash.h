@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Common/primitive_type.h"
 #include "Math/TVector3.h"
 #include "Common/assertion.h"
 
@@ -83,6 +84,55 @@ inline std::size_t discrete_spatial_hash(
 		hashTableSize);
 }
 
+/*
+	Scrambles the bits of a 32-bit integer such that each input bit affects
+	all output bits. This is the finalizer of MurmurHash3.
+
+	Reference:
+	https://github.com/aappleby/smhasher/blob/master/src/MurmurHash3.cpp
+*/
+inline uint32 mix_bits_32(uint32 value)
+{
+	value ^= value >> 16;
+	value *= 0x85ebca6b;
+	value ^= value >> 13;
+	value *= 0xc2b2ae35;
+	value ^= value >> 16;
+
+	return value;
+}
+
+/*
+	The 64-bit counterpart of mix_bits_32(), this is the finalizer of 
+	SplitMix64.
+*/
+inline uint64 mix_bits_64(uint64 value)
+{
+	value ^= value >> 30;
+	value *= 0xbf58476d1ce4e5b9ULL;
+	value ^= value >> 27;
+	value *= 0x94d049bb133111ebULL;
+	value ^= value >> 31;
+
+	return value;
+}
+
+/*
+	Combines a value into an existing hash, similar to boost::hash_combine().
+*/
+inline uint32 combine_32(const uint32 hash, const uint32 value)
+{
+	return mix_bits_32(hash ^ (value + 0x9e3779b9 + (hash << 6) + (hash >> 2)));
+}
+
+/*
+	The 64-bit counterpart of combine_32().
+*/
+inline uint64 combine_64(const uint64 hash, const uint64 value)
+{
+	return mix_bits_64(hash ^ (value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2)));
+}
+
 }// end namespace hash
 
 }// end namespace ph
\ No newline at end of file
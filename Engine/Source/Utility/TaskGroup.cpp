@@ -0,0 +1,105 @@
+#include "Utility/TaskGroup.h"
+
+#include <utility>
+
+namespace ph
+{
+
+TaskGroup::TaskGroup() :
+	TaskGroup(WorkStealingScheduler::getShared())
+{}
+
+TaskGroup::TaskGroup(WorkStealingScheduler& scheduler) :
+	m_scheduler(&scheduler),
+	m_state(std::make_shared<State>())
+{}
+
+TaskGroup::~TaskGroup()
+{
+	wait();
+}
+
+void TaskGroup::run(Task task)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_state->mutex);
+
+		m_state->pendingTasks.push_back(std::move(task));
+		++(m_state->numUnfinishedTasks);
+	}
+
+	// a waiter may be sleeping while the task it waits on adds more tasks
+	m_state->stateChangedCv.notify_all();
+
+	// Waiters run the task themselves if the scheduler has no workers.
+	// Otherwise, whoever comes first starts it: the handle simply finds no
+	// pending task if a waiter took it already.
+	if(m_scheduler->numWorkers() > 0)
+	{
+		m_scheduler->submit([state = m_state]()
+		{
+			tryRunPendingTask(*state, false);
+		});
+	}
+}
+
+void TaskGroup::wait()
+{
+	while(true)
+	{
+		// the newest task is likely to use data still in cache
+		if(tryRunPendingTask(*m_state, true))
+		{
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(m_state->mutex);
+
+		m_state->stateChangedCv.wait(lock, [this]()
+		{
+			return m_state->numUnfinishedTasks == 0 || !m_state->pendingTasks.empty();
+		});
+
+		if(m_state->numUnfinishedTasks == 0)
+		{
+			break;
+		}
+	}
+}
+
+bool TaskGroup::tryRunPendingTask(State& state, const bool isNewestFirst)
+{
+	Task task;
+	{
+		std::lock_guard<std::mutex> lock(state.mutex);
+
+		if(state.pendingTasks.empty())
+		{
+			return false;
+		}
+
+		if(isNewestFirst)
+		{
+			task = std::move(state.pendingTasks.back());
+			state.pendingTasks.pop_back();
+		}
+		else
+		{
+			task = std::move(state.pendingTasks.front());
+			state.pendingTasks.pop_front();
+		}
+	}
+
+	task();
+
+	std::lock_guard<std::mutex> lock(state.mutex);
+
+	if(--state.numUnfinishedTasks == 0)
+	{
+		state.stateChangedCv.notify_all();
+	}
+
+	return true;
+}
+
+}// end namespace ph
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Utility/INoncopyable.h"
+#include "Utility/WorkStealingScheduler.h"
+
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <cstddef>
+
+namespace ph
+{
+
+/*
+	A set of tasks running on a WorkStealingScheduler that can be waited on
+	as a whole. Tasks may add more tasks to the group they belong to. A group
+	can be reused after waiting is finished.
+
+	Tasks are kept by the group until started; the scheduler only runs
+	handles that start the next task of the group.
+*/
+class TaskGroup final : public INoncopyable
+{
+public:
+	using Task = WorkStealingScheduler::Task;
+
+public:
+	// Runs tasks on the shared scheduler.
+	TaskGroup();
+
+	explicit TaskGroup(WorkStealingScheduler& scheduler);
+
+	// Waits for all tasks in the group to finish.
+	~TaskGroup();
+
+	void run(Task task);
+
+	// Blocks until all tasks in the group are finished, including the ones
+	// added while waiting. The calling thread runs not yet started tasks of
+	// this group while waiting, never tasks of other groups, so thread-local
+	// states of the caller (such as those of Random) are only affected by
+	// work it has spawned itself.
+	void wait();
+
+	WorkStealingScheduler& getScheduler() const;
+
+private:
+	// Outlives the group if the scheduler still holds handles to it.
+	struct State
+	{
+		std::mutex              mutex;
+		std::condition_variable stateChangedCv;
+		std::deque<Task>        pendingTasks;
+		std::size_t             numUnfinishedTasks = 0;
+	};
+
+	WorkStealingScheduler* m_scheduler;
+	std::shared_ptr<State> m_state;
+
+	// Runs a not yet started task, the newest one if <isNewestFirst> is
+	// true. Returns whether a task has been run.
+	static bool tryRunPendingTask(State& state, bool isNewestFirst);
+};
+
+// In-header Implementations:
+
+inline WorkStealingScheduler& TaskGroup::getScheduler() const
+{
+	return *m_scheduler;
+}
+
+}// end namespace ph
@@ -0,0 +1,203 @@
+#include "Utility/WorkStealingScheduler.h"
+#include "Common/assertion.h"
+
+#include <algorithm>
+
+namespace ph
+{
+
+namespace
+{
+
+// Identifies the scheduler (and the worker index within it) that owns the
+// calling thread. Threads not owned by any scheduler have a null scheduler.
+struct WorkerIdentity
+{
+	const WorkStealingScheduler* scheduler;
+	std::size_t                  index;
+};
+
+thread_local WorkerIdentity tl_workerIdentity = {nullptr, 0};
+
+std::mutex                             sharedSchedulerMutex;
+std::unique_ptr<WorkStealingScheduler> sharedScheduler;
+
+}// end anonymous namespace
+
+WorkStealingScheduler& WorkStealingScheduler::getShared()
+{
+	std::lock_guard<std::mutex> lock(sharedSchedulerMutex);
+
+	// the thread waiting on tasks is the last busy thread
+	if(!sharedScheduler)
+	{
+		sharedScheduler = std::make_unique<WorkStealingScheduler>(
+			std::max(std::thread::hardware_concurrency(), 1u) - 1);
+	}
+
+	return *sharedScheduler;
+}
+
+void WorkStealingScheduler::setSharedNumWorkers(const std::size_t numWorkers)
+{
+	std::lock_guard<std::mutex> lock(sharedSchedulerMutex);
+
+	if(sharedScheduler && sharedScheduler->numWorkers() == numWorkers)
+	{
+		return;
+	}
+
+	sharedScheduler.reset();
+	sharedScheduler = std::make_unique<WorkStealingScheduler>(numWorkers);
+}
+
+WorkStealingScheduler::WorkStealingScheduler(const std::size_t numWorkers) :
+	m_workers(numWorkers), m_queues(std::max(numWorkers, std::size_t(1))),
+	m_sleepMutex(), m_sleepCv(),
+	m_numQueuedTasks(0), m_nextQueueIndex(0),
+	m_isTerminationRequested(false)
+{
+	for(auto& queue : m_queues)
+	{
+		queue = std::make_unique<TaskQueue>();
+	}
+
+	// all queues must exist before any worker starts stealing
+	for(std::size_t workerIndex = 0; workerIndex < m_workers.size(); ++workerIndex)
+	{
+		m_workers[workerIndex] = std::thread([this, workerIndex]()
+		{
+			asyncProcessTasks(workerIndex);
+		});
+	}
+}
+
+WorkStealingScheduler::~WorkStealingScheduler()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+
+		m_isTerminationRequested = true;
+	}
+	m_sleepCv.notify_all();
+
+	for(auto& worker : m_workers)
+	{
+		if(worker.joinable())
+		{
+			worker.join();
+		}
+	}
+}
+
+void WorkStealingScheduler::submit(Task task)
+{
+	// workers push to their own queue; other threads spread tasks over all
+	// queues in round-robin order
+	std::size_t queueIndex = getCallingWorkerIndex();
+	if(queueIndex == numWorkers())
+	{
+		queueIndex = m_nextQueueIndex.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+	}
+
+	{
+		TaskQueue& queue = *m_queues[queueIndex];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+
+		queue.tasks.push_back(std::move(task));
+		m_numQueuedTasks.fetch_add(1, std::memory_order_release);
+	}
+
+	// Locking the sleep mutex ensures a worker that has just found nothing to
+	// do is either not yet checking for tasks or already waiting; otherwise
+	// the notification could be lost.
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+	}
+	m_sleepCv.notify_one();
+}
+
+void WorkStealingScheduler::asyncProcessTasks(const std::size_t workerIndex)
+{
+	tl_workerIdentity.scheduler = this;
+	tl_workerIdentity.index     = workerIndex;
+
+	while(true)
+	{
+		Task task;
+		if(tryPopLocalTask(workerIndex, &task) || tryStealTask(workerIndex + 1, &task))
+		{
+			task();
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(m_sleepMutex);
+
+		m_sleepCv.wait(lock, [this]()
+		{
+			return m_numQueuedTasks.load(std::memory_order_acquire) > 0 || m_isTerminationRequested;
+		});
+
+		if(m_isTerminationRequested)
+		{
+			break;
+		}
+	}
+}
+
+bool WorkStealingScheduler::tryPopLocalTask(const std::size_t workerIndex, Task* const out_task)
+{
+	PH_ASSERT_LT(workerIndex, m_queues.size());
+	PH_ASSERT(out_task);
+
+	TaskQueue& queue = *m_queues[workerIndex];
+	std::lock_guard<std::mutex> lock(queue.mutex);
+
+	if(queue.tasks.empty())
+	{
+		return false;
+	}
+
+	*out_task = std::move(queue.tasks.back());
+	queue.tasks.pop_back();
+	m_numQueuedTasks.fetch_sub(1, std::memory_order_relaxed);
+
+	return true;
+}
+
+bool WorkStealingScheduler::tryStealTask(const std::size_t firstVictimIndex, Task* const out_task)
+{
+	PH_ASSERT(out_task);
+
+	if(m_numQueuedTasks.load(std::memory_order_acquire) == 0)
+	{
+		return false;
+	}
+
+	for(std::size_t i = 0; i < m_queues.size(); ++i)
+	{
+		TaskQueue& queue = *m_queues[(firstVictimIndex + i) % m_queues.size()];
+
+		// skip queues that are busy rather than waiting on them
+		std::unique_lock<std::mutex> lock(queue.mutex, std::try_to_lock);
+		if(!lock.owns_lock() || queue.tasks.empty())
+		{
+			continue;
+		}
+
+		*out_task = std::move(queue.tasks.front());
+		queue.tasks.pop_front();
+		m_numQueuedTasks.fetch_sub(1, std::memory_order_relaxed);
+
+		return true;
+	}
+
+	return false;
+}
+
+std::size_t WorkStealingScheduler::getCallingWorkerIndex() const
+{
+	return tl_workerIdentity.scheduler == this ? tl_workerIdentity.index : numWorkers();
+}
+
+}// end namespace ph
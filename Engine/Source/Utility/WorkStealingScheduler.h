@@ -0,0 +1,86 @@
+#pragma once
+
+#include "Utility/INoncopyable.h"
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <cstddef>
+
+namespace ph
+{
+
+/*
+	A thread pool where every worker owns a task queue. A worker processes its
+	own queue in LIFO order and steals from the front of other queues once it
+	runs out of tasks, so recently spawned (cache-warm) tasks stay local while
+	older and usually larger ones are shared. Threads are created once and
+	reused for the lifetime of the scheduler; an engine-wide instance can be
+	obtained via getShared(). The scheduler is thread-safe.
+
+	Tasks are normally submitted through a TaskGroup so they can be waited on.
+	Waiting threads run tasks of the awaited group, so a scheduler with N
+	workers keeps N + 1 threads busy; a scheduler without workers runs
+	everything on waiting threads.
+*/
+class WorkStealingScheduler final : public INoncopyable
+{
+public:
+	using Task = std::function<void()>;
+
+	// The scheduler shared by the engine. Unless set otherwise, it keeps one
+	// thread busy per hardware thread.
+	static WorkStealingScheduler& getShared();
+
+	// Replaces the shared scheduler with one having <numWorkers> workers, if
+	// the number differs. Must not be called while the shared scheduler is in
+	// use.
+	static void setSharedNumWorkers(std::size_t numWorkers);
+
+public:
+	explicit WorkStealingScheduler(std::size_t numWorkers);
+
+	// Stops all workers. Queued tasks that are not yet started are discarded.
+	~WorkStealingScheduler();
+
+	// Queues a task for execution. When called from a worker of this
+	// scheduler, the task goes to the worker's own queue. Without workers,
+	// the task is never run.
+	void submit(Task task);
+
+	std::size_t numWorkers() const;
+
+private:
+	struct TaskQueue
+	{
+		std::mutex       mutex;
+		std::deque<Task> tasks;
+	};
+
+	std::vector<std::thread>                m_workers;
+	std::vector<std::unique_ptr<TaskQueue>> m_queues;
+	std::mutex                              m_sleepMutex;
+	std::condition_variable                 m_sleepCv;
+	std::atomic<std::size_t>                m_numQueuedTasks;
+	std::atomic<std::size_t>                m_nextQueueIndex;
+	bool                                    m_isTerminationRequested;
+
+	void asyncProcessTasks(std::size_t workerIndex);
+	bool tryPopLocalTask(std::size_t workerIndex, Task* out_task);
+	bool tryStealTask(std::size_t firstVictimIndex, Task* out_task);
+	std::size_t getCallingWorkerIndex() const;
+};
+
+// In-header Implementations:
+
+inline std::size_t WorkStealingScheduler::numWorkers() const
+{
+	return m_workers.size();
+}
+
+}// end namespace ph
@@ -1,18 +1,22 @@
 #pragma once
 
+#include "Utility/TaskGroup.h"
+#include "Utility/WorkStealingScheduler.h"
 #include "Common/assertion.h"
 #include "Math/math.h"
 
 #include <functional>
 #include <cstddef>
-#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <utility>
 
 namespace ph
 {
 
 /*
-	Runs specified works in parallel. The function will block calling thread 
-	until all works are complete.
+	Runs specified works in parallel on the shared scheduler. The function 
+	will block calling thread until all works are complete.
 
 	<totalWorkSize>: total amount of work
 	<numWorkers>:    number of workers running the works
@@ -30,20 +34,91 @@ inline void parallel_work(
 {
 	PH_ASSERT(numWorkers > 0);
 
-	std::vector<std::thread> workers(numWorkers);
-	for(std::size_t workerIdx = 0; workerIdx < numWorkers; ++workerIdx)
+	TaskGroup works;
+	for(std::size_t workerIdx = 1; workerIdx < numWorkers; ++workerIdx)
 	{
 		const auto workRange = math::ith_evenly_divided_range(workerIdx, totalWorkSize, numWorkers);
 
 		// TODO: should we execute 0-sized works? (currently they are executed)
-		workers[workerIdx] = std::thread(work, workerIdx, workRange.first, workRange.second);
+		works.run([&work, workerIdx, workRange]()
+		{
+			work(workerIdx, workRange.first, workRange.second);
+		});
 	}
 
-	for(std::size_t workerIdx = 0; workerIdx < numWorkers; ++workerIdx)
+	// the calling thread does the first work itself
+	const auto firstWorkRange = math::ith_evenly_divided_range(0, totalWorkSize, numWorkers);
+	work(0, firstWorkRange.first, firstWorkRange.second);
+
+	works.wait();
+}
+
+/*
+	Calls <func> over index range [begin, end) in parallel on the shared 
+	scheduler, blocking until all indices are processed. The range is handed 
+	out in chunks of at least <minGrainSize> indices; chunks get smaller as 
+	the remaining range shrinks, so threads that finish early pick up more 
+	work and uneven per-index costs are balanced.
+
+	<func>: called as func(chunkBegin, chunkEnd), possibly concurrently.
+*/
+template<typename Func>
+inline void parallel_for(
+	const std::size_t begin,
+	const std::size_t end,
+	const std::size_t minGrainSize,
+	Func&&            func)
+{
+	PH_ASSERT_LE(begin, end);
+
+	if(begin == end)
 	{
-		PH_ASSERT(workers[workerIdx].joinable());
-		workers[workerIdx].join();
+		return;
 	}
+
+	const std::size_t grainSize = std::max(minGrainSize, std::size_t(1));
+	const std::size_t numChunks = math::ceil_div_positive(end - begin, grainSize);
+
+	// the calling thread participates as well
+	const std::size_t numThreads = std::min(WorkStealingScheduler::getShared().numWorkers() + 1, numChunks);
+
+	std::atomic<std::size_t> nextIndex(begin);
+	const auto processChunks = [&]()
+	{
+		while(true)
+		{
+			const std::size_t numRemaining = end - std::min(nextIndex.load(std::memory_order_relaxed), end);
+			const std::size_t chunkSize    = std::max(grainSize, numRemaining / (2 * numThreads));
+
+			const std::size_t chunkBegin = nextIndex.fetch_add(chunkSize, std::memory_order_relaxed);
+			if(chunkBegin >= end)
+			{
+				break;
+			}
+
+			func(chunkBegin, std::min(chunkBegin + chunkSize, end));
+		}
+	};
+
+	TaskGroup chunkProcessors;
+	for(std::size_t i = 1; i < numThreads; ++i)
+	{
+		chunkProcessors.run(processChunks);
+	}
+	processChunks();
+
+	chunkProcessors.wait();
+}
+
+// Same as the one with grain size specified, with the minimum chunk size 
+// being a single index.
+template<typename Func>
+inline void parallel_for(
+	const std::size_t begin,
+	const std::size_t end,
+	Func&&            func)
+{
+	parallel_for(begin, end, 1, std::forward<Func>(func));
 }
 
-}// end namespace ph
\ No newline at end of file
+}// end namespace ph
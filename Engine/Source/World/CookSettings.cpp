@@ -13,6 +13,8 @@ CookSettings::CookSettings() :
 CookSettings::CookSettings(const EAccelerator topLevelAccelerator)
 {
 	setTopLevelAccelerator(topLevelAccelerator);
+	setBvhType(EBvhType::SAH_BUCKET);
+	setTextureCacheMB(1024);
 }
 
 // command interface
@@ -34,6 +36,14 @@ namespace
 			{
 				settings.setTopLevelAccelerator(EAccelerator::BVH);
 			}
+			else if(topLevelAccelerator == "bvh4")
+			{
+				settings.setTopLevelAccelerator(EAccelerator::BVH4);
+			}
+			else if(topLevelAccelerator == "bvh8")
+			{
+				settings.setTopLevelAccelerator(EAccelerator::BVH8);
+			}
 			else if(topLevelAccelerator == "kd-tree")
 			{
 				settings.setTopLevelAccelerator(EAccelerator::KDTREE);
@@ -48,6 +58,38 @@ namespace
 			}
 		}
 
+		const auto& bvhType = packet.getString("bvh-type", "");
+		if(!bvhType.empty())
+		{
+			if(bvhType == "lbvh")
+			{
+				settings.setBvhType(EBvhType::LBVH);
+			}
+			else if(bvhType == "sah-bucket")
+			{
+				settings.setBvhType(EBvhType::SAH_BUCKET);
+			}
+			else if(bvhType == "sah-sweep")
+			{
+				settings.setBvhType(EBvhType::SAH_SWEEP);
+			}
+			else
+			{
+				std::cerr << "warning: unknown BVH type <" + bvhType + "> specified" << std::endl;
+			}
+		}
+
+		const integer textureCacheMB = packet.getInteger(
+			"texture-cache-mb", static_cast<integer>(settings.getTextureCacheMB()));
+		if(textureCacheMB > 0)
+		{
+			settings.setTextureCacheMB(static_cast<std::size_t>(textureCacheMB));
+		}
+		else
+		{
+			std::cerr << "warning: texture cache size must be positive, <" + std::to_string(textureCacheMB) + "> specified" << std::endl;
+		}
+
 		return settings;
 	}
 }
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "FileIO/SDL/TCommandInterface.h"
+#include "Core/Intersectable/Bvh/EBvhType.h"
+
+#include <cstddef>
 
 namespace ph
 {
@@ -9,6 +12,8 @@ enum class EAccelerator
 {
 	BRUTE_FORCE,
 	BVH,
+	BVH4,
+	BVH8,
 	KDTREE,
 	INDEXED_KDTREE
 };
@@ -20,10 +25,16 @@ public:
 	CookSettings(EAccelerator topLevelAccelerator);
 
 	void setTopLevelAccelerator(EAccelerator accelerator);
+	void setBvhType(EBvhType type);
+	void setTextureCacheMB(std::size_t textureCacheMB);
 	EAccelerator getTopLevelAccelerator() const;
+	EBvhType getBvhType() const;
+	std::size_t getTextureCacheMB() const;
 
 private:
 	EAccelerator m_topLevelAccelerator;
+	EBvhType     m_bvhType;
+	std::size_t  m_textureCacheMB;
 
 // command interface
 public:
@@ -38,9 +49,64 @@ inline void CookSettings::setTopLevelAccelerator(const EAccelerator accelerator)
 	m_topLevelAccelerator = accelerator;
 }
 
+inline void CookSettings::setBvhType(const EBvhType type)
+{
+	m_bvhType = type;
+}
+
+inline void CookSettings::setTextureCacheMB(const std::size_t textureCacheMB)
+{
+	m_textureCacheMB = textureCacheMB;
+}
+
 inline EAccelerator CookSettings::getTopLevelAccelerator() const
 {
 	return m_topLevelAccelerator;
 }
 
-}// end namespace ph
\ No newline at end of file
+inline EBvhType CookSettings::getBvhType() const
+{
+	return m_bvhType;
+}
+
+inline std::size_t CookSettings::getTextureCacheMB() const
+{
+	return m_textureCacheMB;
+}
+
+}// end namespace ph
+
+/*
+	<SDL_interface>
+
+	<category>  option        </category>
+	<type_name> cook-settings </type_name>
+
+	<name> Cook Settings </name>
+	<description>
+		Settings related to the actor-cooking process.
+	</description>
+
+	<command type="creator">
+		<input name="top-level-accelerator" type="string">
+			<description>
+				Acceleration structure used on the top level, can be "brute-force", 
+				"bvh", "bvh4", "bvh8", "kd-tree" or "indexed-kd-tree".
+			</description>
+		</input>
+		<input name="bvh-type" type="string">
+			<description>
+				Method for building BVHs: "lbvh" (fastest build), "sah-bucket" (the 
+				default) or "sah-sweep" (best quality).
+			</description>
+		</input>
+		<input name="texture-cache-mb" type="integer">
+			<description>
+				Memory in megabytes for tiles of tiled picture images (1024 by default). Least 
+				recently used tiles are evicted when more is needed.
+			</description>
+		</input>
+	</command>
+
+	</SDL_interface>
+*/
\ No newline at end of file
@@ -43,17 +43,17 @@ bool Scene::isIntersecting(const Ray& ray, HitProbe* const out_probe) const
 	return false;
 }
 
-bool Scene::isIntersecting(const Ray& ray) const
+bool Scene::isOccluded(const Ray& ray) const
 {
 	PH_ASSERT(ray.getOrigin().isFinite() && ray.getDirection().isFinite());
 
-	if(m_intersector->isIntersecting(ray))
+	if(m_intersector->isOccluded(ray))
 	{
 		return true;
 	}
 	else if(m_backgroundEmitterPrimitive)
 	{
-		return m_backgroundEmitterPrimitive->isIntersecting(ray);
+		return m_backgroundEmitterPrimitive->isOccluded(ray);
 	}
 
 	return false;
@@ -24,9 +24,11 @@ public:
 	Scene();
 	Scene(const Intersector* intersector, const EmitterSampler* emitterSampler);
 
-	bool isIntersecting(const Ray& ray) const;
 	bool isIntersecting(const Ray& ray, HitProbe* out_probe) const;
 
+	// Whether anything blocks the ray; cheaper than finding the closest hit.
+	bool isOccluded(const Ray& ray) const;
+
 	const Emitter* pickEmitter(real* const out_PDF) const;
 	void genDirectSample(DirectLightSample& sample) const;
 	real calcDirectPdfW(const SurfaceHit& emitPos, const Vector3R& targetPos) const;
@@ -8,14 +8,18 @@
 #include "Core/Intersectable/Kdtree/KdtreeIntersector.h"
 #include "Core/Emitter/Sampler/ESUniformRandom.h"
 #include "Core/Intersectable/Bvh/ClassicBvhIntersector.h"
+#include "Core/Intersectable/Bvh/TWideBvhIntersector.h"
 #include "World/VisualWorldInfo.h"
 #include "Core/Intersectable/IndexedKdtree/TIndexedKdtreeIntersector.h"
 #include "Core/Emitter/Sampler/ESPowerFavoring.h"
 #include "Actor/APhantomModel.h"
+#include "Core/Texture/TextureCache.h"
+#include "Math/hash.h"
 
 #include <limits>
 #include <iostream>
 #include <algorithm>
+#include <cstring>
 
 namespace ph
 {
@@ -31,7 +35,9 @@ VisualWorld::VisualWorld() :
 	m_cameraPos(0),
 	m_cookSettings(),
 
-	m_backgroundEmitterPrimitive(nullptr)
+	m_backgroundEmitterPrimitive(nullptr),
+
+	m_sceneSignature(0)
 {
 	setCookSettings(std::make_shared<CookSettings>());
 }
@@ -45,7 +51,9 @@ VisualWorld::VisualWorld(VisualWorld&& other) :
 	m_cameraPos         (std::move(other.m_cameraPos)),
 	m_cookSettings      (std::move(other.m_cookSettings)),
 
-	m_backgroundEmitterPrimitive(std::move(other.m_backgroundEmitterPrimitive))
+	m_backgroundEmitterPrimitive(std::move(other.m_backgroundEmitterPrimitive)),
+
+	m_sceneSignature(other.m_sceneSignature)
 {}
 
 void VisualWorld::addActor(std::shared_ptr<Actor> actor)
@@ -66,6 +74,10 @@ void VisualWorld::cook()
 {
 	logger.log(ELogLevel::NOTE_MED, "cooking visual world...");
 
+	// tiled textures are created during cooking
+	PH_ASSERT(m_cookSettings);
+	TextureCache::getShared().setMemoryBudget(m_cookSettings->getTextureCacheMB() * 1024 * 1024);
+
 	// TODO: clear cooked data
 
 	CookingContext cookingContext;
@@ -130,6 +142,8 @@ void VisualWorld::cook()
 	logger.log(ELogLevel::NOTE_MED, "updating light sampler...");
 	m_emitterSampler->update(m_cookedActorStorage);
 
+	m_sceneSignature = calcSceneSignature(m_cookedActorStorage);
+
 	m_scene = Scene(m_intersector.get(), m_emitterSampler.get());
 
 	// HACK
@@ -177,10 +191,20 @@ void VisualWorld::createTopLevelAccelerator()
 		break;
 
 	case EAccelerator::BVH:
-		m_intersector = std::make_unique<ClassicBvhIntersector>();
+		m_intersector = std::make_unique<ClassicBvhIntersector>(m_cookSettings->getBvhType());
 		name = "BVH";
 		break;
 
+	case EAccelerator::BVH4:
+		m_intersector = std::make_unique<TWideBvhIntersector<4>>(m_cookSettings->getBvhType());
+		name = "4-wide BVH";
+		break;
+
+	case EAccelerator::BVH8:
+		m_intersector = std::make_unique<TWideBvhIntersector<8>>(m_cookSettings->getBvhType());
+		name = "8-wide BVH";
+		break;
+
 	case EAccelerator::KDTREE:
 		m_intersector = std::make_unique<KdtreeIntersector>();
 		name = "kD-Tree";
@@ -205,6 +229,11 @@ const Scene& VisualWorld::getScene() const
 	return m_scene;
 }
 
+uint64 VisualWorld::getSceneSignature() const
+{
+	return m_sceneSignature;
+}
+
 AABB3D VisualWorld::calcIntersectableBound(const CookedDataStorage& storage)
 {
 	if(storage.numIntersectables() == 0)
@@ -223,4 +252,31 @@ AABB3D VisualWorld::calcIntersectableBound(const CookedDataStorage& storage)
 	return fullBound;
 }
 
+uint64 VisualWorld::calcSceneSignature(const CookedDataStorage& storage)
+{
+	const auto realBits = [](const real value)
+	{
+		uint64 bits = 0;
+		std::memcpy(&bits, &value, sizeof(real));
+		return bits;
+	};
+
+	uint64 signature = hash::combine_64(storage.numIntersectables(), storage.numEmitters());
+	for(const auto& intersectable : storage.intersectables())
+	{
+		AABB3D bound;
+		intersectable->calcAABB(&bound);
+		for(int i = 0; i < 3; ++i)
+		{
+			signature = hash::combine_64(signature, realBits(bound.getMinVertex()[i]));
+			signature = hash::combine_64(signature, realBits(bound.getMaxVertex()[i]));
+		}
+	}
+	for(const auto& emitter : storage.emitters())
+	{
+		signature = hash::combine_64(signature, realBits(emitter->calcRadiantFluxApprox()));
+	}
+	return signature;
+}
+
 }// end namespace ph
\ No newline at end of file
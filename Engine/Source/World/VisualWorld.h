@@ -37,6 +37,11 @@ public:
 
 	const Scene& getScene() const;
 
+	// A hash of the bounds of all cooked intersectables and the power of all
+	// emitters, which tells apart scenes of different geometry or lights (but
+	// not of different materials). Valid after cook().
+	uint64 getSceneSignature() const;
+
 	// forbid copying
 	VisualWorld(const VisualWorld& other) = delete;
 	VisualWorld& operator = (const VisualWorld& rhs) = delete;
@@ -56,10 +61,13 @@ private:
 	// HACK
 	const Primitive* m_backgroundEmitterPrimitive;
 
+	uint64 m_sceneSignature;
+
 	void cookActors(CookingContext& cookingContext);
 	void createTopLevelAccelerator();
 
 	static AABB3D calcIntersectableBound(const CookedDataStorage& storage);
+	static uint64 calcSceneSignature(const CookedDataStorage& storage);
 
 	static const Logger logger;
 };
@@ -2,6 +2,8 @@
 
 #include <Core/Filmic/HdrRgbFilm.h>
 #include <Core/Filmic/SampleFilters.h>
+#include <Frame/TFrame.h>
+#include <Math/TVector3.h>
 
 #include <gtest/gtest.h>
 
@@ -51,4 +53,36 @@ TEST(HdrRgbFilmTest, CorrectRasterCoordinates)
 	EXPECT_NEAR(film.getSampleWindowPx().maxVertex.y,
 	            static_cast<float64>(filmHpx) - 0.5 + filter.getSizePx().y / 2.0,
 	            TEST_FLOAT64_EPSILON);
-}
\ No newline at end of file
+}
+
+TEST(HdrRgbFilmTest, MergeWithinRegion)
+{
+	const auto& filter = SampleFilters::createBoxFilter();
+
+	HdrRgbFilm dstFilm(4, 4, filter);
+	HdrRgbFilm srcFilm(4, 4, filter);
+	for(int64 y = 0; y < 4; ++y)
+	{
+		for(int64 x = 0; x < 4; ++x)
+		{
+			srcFilm.addSample(x + 0.5, y + 0.5, Vector3R(1, 2, 3));
+		}
+	}
+
+	// merging two disjoint stripes is the same as merging all at once
+	dstFilm.mergeWith(srcFilm, TAABB2D<int64>({0, 0}, {4, 1}));
+	dstFilm.mergeWith(srcFilm, TAABB2D<int64>({1, 1}, {3, 4}));
+
+	HdrRgbFrame frame(4, 4);
+	dstFilm.develop(frame);
+	for(uint32 y = 0; y < 4; ++y)
+	{
+		for(uint32 x = 0; x < 4; ++x)
+		{
+			const bool isMerged = y == 0 || (x >= 1 && x < 3);
+			const auto pixel    = frame.getPixel({x, y});
+			EXPECT_EQ(pixel[0], isMerged ? 1.0f : 0.0f);
+			EXPECT_EQ(pixel[2], isMerged ? 3.0f : 0.0f);
+		}
+	}
+}
@@ -0,0 +1,40 @@
+#include <Core/Filmic/SampleFilter.h>
+#include <Core/Filmic/SampleFilters.h>
+#include <Math/Function/TGaussian2D.h>
+#include <Math/Function/TMNCubic2D.h>
+#include <Math/Function/TBlackmanHarris2D.h>
+
+#include <gtest/gtest.h>
+
+using namespace ph;
+
+namespace
+{
+	void expect_matches_function(
+		const SampleFilter&              filter,
+		const TMathFunction2D<float64>& func)
+	{
+		ASSERT_TRUE(filter.isSeparable());
+
+		for(float64 y = -filter.getHalfSizePx().y; y <= filter.getHalfSizePx().y; y += 0.037)
+		{
+			for(float64 x = -filter.getHalfSizePx().x; x <= filter.getHalfSizePx().x; x += 0.041)
+			{
+				EXPECT_NEAR(filter.evaluate(x, y), func.evaluate(x, y), 1e-4);
+			}
+		}
+	}
+}
+
+TEST(SampleFilterTest, SeparableTablesMatchFunctions)
+{
+	TGaussian2D<float64> gaussian(0.5, 0.5, 1.0);
+	gaussian.setSubmergeAmount(gaussian.evaluate(2.0, 2.0));
+	expect_matches_function(SampleFilters::createGaussianFilter(), gaussian);
+
+	expect_matches_function(SampleFilters::createMitchellNetravaliFilter(), TMNCubic2D<float64>(1.0 / 3.0, 1.0 / 3.0));
+	expect_matches_function(SampleFilters::createBlackmanHarrisFilter(), TBlackmanHarris2D<float64>(2.0));
+
+	const SampleFilter boxFilter = SampleFilters::createBoxFilter();
+	EXPECT_DOUBLE_EQ(boxFilter.evaluate(0.3, -0.4), 1.0);
+}
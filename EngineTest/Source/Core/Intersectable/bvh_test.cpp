@@ -0,0 +1,145 @@
+#include <Core/Intersectable/Bvh/ClassicBvhIntersector.h>
+#include <Core/Intersectable/Bvh/TWideBvhIntersector.h>
+#include <Core/Intersectable/PTriangle.h>
+#include <Core/Intersectable/PrimitiveMetadata.h>
+#include <Core/HitProbe.h>
+#include <Core/Ray.h>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <memory>
+#include <random>
+#include <limits>
+
+namespace
+{
+	std::vector<std::unique_ptr<ph::PTriangle>> make_random_triangles(
+		const ph::PrimitiveMetadata* const metadata,
+		const std::size_t                  numTriangles)
+	{
+		using namespace ph;
+
+		std::mt19937 engine(0);
+		std::uniform_real_distribution<real> center(-10.0_r, 10.0_r);
+		std::uniform_real_distribution<real> offset(-1.0_r, 1.0_r);
+
+		std::vector<std::unique_ptr<PTriangle>> triangles;
+		for(std::size_t i = 0; i < numTriangles; ++i)
+		{
+			const Vector3R c(center(engine), center(engine), center(engine));
+			const Vector3R vA = c.add(Vector3R(offset(engine), offset(engine), offset(engine)));
+			const Vector3R vB = c.add(Vector3R(offset(engine), offset(engine), offset(engine)));
+			const Vector3R vC = c.add(Vector3R(offset(engine), offset(engine), offset(engine)));
+			triangles.push_back(std::make_unique<PTriangle>(metadata, vA, vB, vC));
+		}
+		return triangles;
+	}
+
+	template<std::size_t N>
+	void expect_same_hits_as_binary_bvh()
+	{
+		using namespace ph;
+
+		PrimitiveMetadata metadata;
+		const auto triangles = make_random_triangles(&metadata, 2000);
+
+		std::vector<const Intersectable*> intersectables;
+		for(const auto& triangle : triangles)
+		{
+			intersectables.push_back(triangle.get());
+		}
+
+		ClassicBvhIntersector binaryBvh;
+		binaryBvh.rebuildWithIntersectables(intersectables);
+
+		TWideBvhIntersector<N> wideBvh;
+		wideBvh.rebuildWithIntersectables(intersectables);
+
+		std::mt19937 engine(1);
+		std::uniform_real_distribution<real> coord(-12.0_r, 12.0_r);
+		for(int i = 0; i < 1000; ++i)
+		{
+			const Vector3R origin(coord(engine), coord(engine), coord(engine));
+			const Vector3R target(coord(engine), coord(engine), coord(engine));
+			const Ray ray(origin, target.sub(origin).normalize(), 0, std::numeric_limits<real>::max());
+
+			HitProbe binaryProbe;
+			HitProbe wideProbe;
+			const bool isBinaryHit = binaryBvh.isIntersecting(ray, binaryProbe);
+			const bool isWideHit   = wideBvh.isIntersecting(ray, wideProbe);
+
+			ASSERT_EQ(isBinaryHit, isWideHit);
+			EXPECT_EQ(isBinaryHit, binaryBvh.isOccluded(ray));
+			EXPECT_EQ(isWideHit, wideBvh.isOccluded(ray));
+			if(isBinaryHit)
+			{
+				EXPECT_EQ(binaryProbe.getHitRayT(), wideProbe.getHitRayT());
+				EXPECT_EQ(binaryProbe.getCurrentHit(), wideProbe.getCurrentHit());
+			}
+		}
+	}
+}
+
+TEST(BvhTest, WideBvhMatchesBinaryBvh)
+{
+	expect_same_hits_as_binary_bvh<4>();
+	expect_same_hits_as_binary_bvh<8>();
+}
+
+TEST(BvhTest, BuildTypesFindSameClosestHits)
+{
+	using namespace ph;
+
+	PrimitiveMetadata metadata;
+	const auto triangles = make_random_triangles(&metadata, 5000);
+
+	std::vector<const Intersectable*> intersectables;
+	for(const auto& triangle : triangles)
+	{
+		intersectables.push_back(triangle.get());
+	}
+
+	ClassicBvhIntersector bucketBvh(EBvhType::SAH_BUCKET);
+	ClassicBvhIntersector sweepBvh(EBvhType::SAH_SWEEP);
+	ClassicBvhIntersector lbvh(EBvhType::LBVH);
+	bucketBvh.rebuildWithIntersectables(intersectables);
+	sweepBvh.rebuildWithIntersectables(intersectables);
+	lbvh.rebuildWithIntersectables(intersectables);
+
+	std::mt19937 engine(2);
+	std::uniform_real_distribution<real> coord(-12.0_r, 12.0_r);
+	for(int i = 0; i < 1000; ++i)
+	{
+		const Vector3R origin(coord(engine), coord(engine), coord(engine));
+		const Vector3R target(coord(engine), coord(engine), coord(engine));
+		const Ray ray(origin, target.sub(origin).normalize(), 0, std::numeric_limits<real>::max());
+
+		HitProbe bucketProbe, sweepProbe, lbvhProbe;
+		const bool isBucketHit = bucketBvh.isIntersecting(ray, bucketProbe);
+		ASSERT_EQ(isBucketHit, sweepBvh.isIntersecting(ray, sweepProbe));
+		ASSERT_EQ(isBucketHit, lbvh.isIntersecting(ray, lbvhProbe));
+		if(isBucketHit)
+		{
+			EXPECT_EQ(bucketProbe.getHitRayT(), sweepProbe.getHitRayT());
+			EXPECT_EQ(bucketProbe.getHitRayT(), lbvhProbe.getHitRayT());
+		}
+	}
+}
+
+TEST(BvhTest, WideBvhWithSingleIntersectable)
+{
+	using namespace ph;
+
+	PrimitiveMetadata metadata;
+	PTriangle triangle(&metadata, Vector3R(-1, -1, 0), Vector3R(1, -1, 0), Vector3R(0, 1, 0));
+
+	TWideBvhIntersector<4> bvh;
+	bvh.rebuildWithIntersectables({&triangle});
+
+	HitProbe probe;
+	EXPECT_TRUE(bvh.isIntersecting(Ray(Vector3R(0, 0, 1), Vector3R(0, 0, -1), 0, 10), probe));
+	EXPECT_FALSE(bvh.isIntersecting(Ray(Vector3R(0, 0, 1), Vector3R(0, 0, 1), 0, 10), probe));
+	EXPECT_TRUE(bvh.isOccluded(Ray(Vector3R(0, 0, 1), Vector3R(0, 0, -1), 0, 10)));
+	EXPECT_FALSE(bvh.isOccluded(Ray(Vector3R(0, 0, 1), Vector3R(0, 0, -1), 0, 0.5_r)));
+}
@@ -0,0 +1,166 @@
+#include <Core/Intersectable/HashGrid/TCenterHashGrid.h>
+#include <Math/TVector3.h>
+#include <Math/Random/Pcg32.h>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+
+TEST(CenterHashGridTest, RangeSearchCubeVertices)
+{
+	using namespace ph;
+
+	auto trivialCenterCalculator = [](const Vector3R& point)
+	{
+		return point;
+	};
+
+	std::vector<Vector3R> points = {
+		{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {1, 1, 0},
+		{0, 0, 1}, {1, 0, 1}, {0, 1, 1}, {1, 1, 1}
+	};
+
+	auto grid = TCenterHashGrid<Vector3R, decltype(trivialCenterCalculator)>(trivialCenterCalculator);
+	grid.build(std::move(points), 1.0_r);
+	EXPECT_EQ(grid.numItems(), 8);
+
+	std::vector<Vector3R> results;
+
+	results.clear();
+	grid.findWithinRange({0, 0, 0}, 0.5_r, results);
+	ASSERT_EQ(results.size(), 1);
+	EXPECT_TRUE(results[0].equals({0, 0, 0}));
+
+	results.clear();
+	grid.findWithinRange({1, 0, 0}, 1.0_r, results);
+	EXPECT_EQ(results.size(), 4);
+	EXPECT_TRUE(std::find(results.begin(), results.end(), Vector3R(1, 0, 0)) != results.end());
+	EXPECT_TRUE(std::find(results.begin(), results.end(), Vector3R(0, 0, 0)) != results.end());
+	EXPECT_TRUE(std::find(results.begin(), results.end(), Vector3R(1, 1, 0)) != results.end());
+	EXPECT_TRUE(std::find(results.begin(), results.end(), Vector3R(1, 0, 1)) != results.end());
+
+	results.clear();
+	grid.findWithinRange({0.5_r, 0.5_r, 0.5_r}, 0.5_r, results);
+	EXPECT_EQ(results.size(), 0);
+
+	// searching with a radius much larger than the cell size
+	results.clear();
+	grid.findWithinRange({0.5_r, 0.5_r, 0.5_r}, 10.0_r, results);
+	EXPECT_EQ(results.size(), 8);
+}
+
+TEST(CenterHashGridTest, RangeSearchManyRandomPoints)
+{
+	using namespace ph;
+
+	const std::size_t numPoints = 50000;
+
+	// some points have negative coordinates
+	Pcg32 rng;
+	std::vector<Vector3R> points(numPoints);
+	for(auto& point : points)
+	{
+		point.x = rng.genUniformReal_i0_e1() * 2.0_r - 1.0_r;
+		point.y = rng.genUniformReal_i0_e1() * 2.0_r - 1.0_r;
+		point.z = rng.genUniformReal_i0_e1() * 2.0_r - 1.0_r;
+	}
+
+	auto indexToCenter = [&points](const std::size_t index)
+	{
+		return points[index];
+	};
+
+	std::vector<std::size_t> indices(numPoints);
+	for(std::size_t i = 0; i < numPoints; ++i)
+	{
+		indices[i] = i;
+	}
+
+	const real radius = 0.1_r;
+
+	auto grid = TCenterHashGrid<std::size_t, decltype(indexToCenter)>(indexToCenter);
+	grid.build(std::move(indices), radius);
+
+	for(int i = 0; i < 100; ++i)
+	{
+		const Vector3R location(
+			rng.genUniformReal_i0_e1() * 2.0_r - 1.0_r,
+			rng.genUniformReal_i0_e1() * 2.0_r - 1.0_r,
+			rng.genUniformReal_i0_e1() * 2.0_r - 1.0_r);
+
+		std::vector<std::size_t> results;
+		grid.findWithinRange(location, radius, results);
+		std::sort(results.begin(), results.end());
+
+		std::vector<std::size_t> expected;
+		for(std::size_t p = 0; p < numPoints; ++p)
+		{
+			if((points[p] - location).lengthSquared() <= radius * radius)
+			{
+				expected.push_back(p);
+			}
+		}
+
+		EXPECT_EQ(results, expected);
+
+		std::vector<std::size_t> visitedResults;
+		grid.forEachWithinRange(location, radius, 
+			[&visitedResults](const std::size_t index)
+			{
+				visitedResults.push_back(index);
+			});
+		std::sort(visitedResults.begin(), visitedResults.end());
+
+		EXPECT_EQ(visitedResults, expected);
+	}
+}
+
+TEST(CenterHashGridTest, RejectsCorruptedStorage)
+{
+	using namespace ph;
+
+	auto trivialCenterCalculator = [](const Vector3R& point)
+	{
+		return point;
+	};
+
+	using Grid = TCenterHashGrid<Vector3R, decltype(trivialCenterCalculator)>;
+
+	std::vector<Vector3R> points = {
+		{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {1, 1, 0},
+		{0, 0, 1}, {1, 0, 1}, {0, 1, 1}, {1, 1, 1}
+	};
+
+	auto grid = Grid(trivialCenterCalculator);
+	grid.build(std::move(points), 1.0_r);
+
+	const Grid::Storage storage = grid.getStorage();
+	ASSERT_TRUE(Grid::isStorageValid(storage));
+	ASSERT_GE(storage.numBuckets, 2);
+
+	std::vector<std::size_t> bucketBegins(storage.bucketBegins, storage.bucketBegins + storage.numBuckets + 1);
+	Grid::Storage corruptedStorage = storage;
+	corruptedStorage.bucketBegins = bucketBegins.data();
+
+	// a decreasing bucket begin
+	bucketBegins[1] = storage.numItems;
+	bucketBegins[2] = 0;
+	EXPECT_FALSE(Grid::isStorageValid(corruptedStorage));
+
+	// buckets past the last item
+	std::fill(bucketBegins.begin(), bucketBegins.end(), 0);
+	bucketBegins.back() = storage.numItems + 1;
+	EXPECT_FALSE(Grid::isStorageValid(corruptedStorage));
+	bucketBegins.back() = storage.numItems;
+	EXPECT_TRUE(Grid::isStorageValid(corruptedStorage));
+
+	// items without buckets, and a non-finite cell size
+	corruptedStorage.numBuckets = 0;
+	EXPECT_FALSE(Grid::isStorageValid(corruptedStorage));
+	corruptedStorage = storage;
+	corruptedStorage.reciCellSize = std::numeric_limits<real>::infinity();
+	EXPECT_FALSE(Grid::isStorageValid(corruptedStorage));
+}
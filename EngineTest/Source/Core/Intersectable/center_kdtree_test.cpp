@@ -1,10 +1,12 @@
 #include <Core/Intersectable/IndexedKdtree/TCenterKdtree.h>
 #include <Math/TVector3.h>
+#include <Math/Random/Pcg32.h>
 
 #include <gtest/gtest.h>
 
 #include <vector>
 #include <algorithm>
+#include <cstddef>
 
 TEST(CenterKdtreeTest, RangeSearchPointsOnAxis)
 {
@@ -118,4 +120,160 @@ TEST(CenterKdtreeTest, RangeSearchCubeVertices)
 	EXPECT_TRUE(std::find(results.begin(), results.end(), Vector3R(1, 0, 1)) != results.end());
 	EXPECT_TRUE(std::find(results.begin(), results.end(), Vector3R(0, 1, 1)) != results.end());
 	EXPECT_TRUE(std::find(results.begin(), results.end(), Vector3R(1, 1, 1)) != results.end());
-}
\ No newline at end of file
+}
+
+TEST(CenterKdtreeTest, RangeSearchManyRandomPoints)
+{
+	using namespace ph;
+
+	// enough points for subtrees to be built in parallel
+	const std::size_t numPoints = 100000;
+
+	Pcg32 rng;
+	std::vector<Vector3R> points(numPoints);
+	for(auto& point : points)
+	{
+		point.x = rng.genUniformReal_i0_e1();
+		point.y = rng.genUniformReal_i0_e1();
+		point.z = rng.genUniformReal_i0_e1();
+	}
+
+	auto indexToCenter = [&points](const std::size_t index)
+	{
+		return points[index];
+	};
+
+	std::vector<std::size_t> indices(numPoints);
+	for(std::size_t i = 0; i < numPoints; ++i)
+	{
+		indices[i] = i;
+	}
+
+	auto tree = TCenterKdtree<std::size_t, int, decltype(indexToCenter)>(4, indexToCenter);
+	tree.build(std::move(indices));
+	EXPECT_EQ(tree.numItems(), numPoints);
+
+	const real radius = 0.05_r;
+	for(int i = 0; i < 100; ++i)
+	{
+		const Vector3R location(
+			rng.genUniformReal_i0_e1(), 
+			rng.genUniformReal_i0_e1(), 
+			rng.genUniformReal_i0_e1());
+
+		std::vector<std::size_t> results;
+		tree.findWithinRange(location, radius, results);
+		std::sort(results.begin(), results.end());
+
+		std::vector<std::size_t> expected;
+		for(std::size_t p = 0; p < numPoints; ++p)
+		{
+			if((points[p] - location).lengthSquared() <= radius * radius)
+			{
+				expected.push_back(p);
+			}
+		}
+
+		EXPECT_EQ(results, expected);
+
+		std::vector<std::size_t> visitedResults;
+		tree.forEachWithinRange(location, radius, 
+			[&visitedResults](const std::size_t index)
+			{
+				visitedResults.push_back(index);
+			});
+		std::sort(visitedResults.begin(), visitedResults.end());
+
+		EXPECT_EQ(visitedResults, expected);
+	}
+}
+
+TEST(CenterKdtreeTest, VisitsAllLeaves)
+{
+	using namespace ph;
+
+	auto trivialCenterCalculator = [](const Vector3R& point)
+	{
+		return point;
+	};
+
+	Pcg32 rng;
+	std::vector<Vector3R> points(1000);
+	for(auto& point : points)
+	{
+		point.x = rng.genUniformReal_i0_e1();
+		point.y = rng.genUniformReal_i0_e1();
+		point.z = rng.genUniformReal_i0_e1();
+	}
+
+	auto tree = TCenterKdtree<Vector3R, int, decltype(trivialCenterCalculator)>(4, trivialCenterCalculator);
+
+	std::size_t numLeaves = 0;
+	tree.forEachLeaf(
+		[&numLeaves](const std::size_t /* depth */, const std::size_t /* numItems */)
+		{
+			++numLeaves;
+		});
+	EXPECT_EQ(numLeaves, 0);
+
+	tree.build(std::move(points));
+
+	std::size_t numLeafItems = 0;
+	std::size_t maxDepth     = 0;
+	tree.forEachLeaf(
+		[&](const std::size_t depth, const std::size_t numItems)
+		{
+			++numLeaves;
+			numLeafItems += numItems;
+			maxDepth = std::max(depth, maxDepth);
+		});
+
+	EXPECT_EQ(numLeafItems, 1000);
+	EXPECT_GT(numLeaves, 1);
+	EXPECT_GT(maxDepth, 0);
+	EXPECT_GE(tree.memoryUsage(), 1000 * sizeof(Vector3R));
+}
+
+TEST(CenterKdtreeTest, RejectsCorruptedStorage)
+{
+	using namespace ph;
+
+	auto trivialCenterCalculator = [](const Vector3R& point)
+	{
+		return point;
+	};
+
+	using Tree = TCenterKdtree<Vector3R, int, decltype(trivialCenterCalculator)>;
+
+	Pcg32 rng;
+	std::vector<Vector3R> points(100);
+	for(auto& point : points)
+	{
+		point.x = rng.genUniformReal_i0_e1();
+		point.y = rng.genUniformReal_i0_e1();
+		point.z = rng.genUniformReal_i0_e1();
+	}
+
+	auto tree = Tree(4, trivialCenterCalculator);
+	tree.build(std::move(points));
+
+	const Tree::Storage storage = tree.getStorage();
+	ASSERT_TRUE(Tree::isStorageValid(storage));
+	ASSERT_FALSE(storage.nodes[0].isLeaf());
+
+	std::vector<Tree::Node> nodes(storage.nodes, storage.nodes + storage.numNodes);
+	Tree::Storage corruptedStorage = storage;
+	corruptedStorage.nodes = nodes.data();
+
+	// positive child out of range, or pointing back to the root
+	nodes[0] = Tree::Node::makeInner(0.5_r, constant::X_AXIS, storage.numNodes);
+	EXPECT_FALSE(Tree::isStorageValid(corruptedStorage));
+	nodes[0] = Tree::Node::makeInner(0.5_r, constant::X_AXIS, 0);
+	EXPECT_FALSE(Tree::isStorageValid(corruptedStorage));
+
+	// leaf items past the last item
+	nodes[0] = Tree::Node::makeLeaf(static_cast<int>(storage.numItems - 1), 2);
+	EXPECT_FALSE(Tree::isStorageValid(corruptedStorage));
+	nodes[0] = Tree::Node::makeLeaf(0, storage.numItems);
+	EXPECT_TRUE(Tree::isStorageValid(corruptedStorage));
+}
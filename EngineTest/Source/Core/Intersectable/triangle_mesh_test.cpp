@@ -0,0 +1,135 @@
+#include <Core/Intersectable/PTriangleMesh.h>
+#include <Core/Intersectable/PTriangle.h>
+#include <Core/Intersectable/IndexedTriangleBuffer.h>
+#include <Core/Intersectable/Bvh/ClassicBvhIntersector.h>
+#include <Core/Intersectable/PrimitiveMetadata.h>
+#include <Core/HitProbe.h>
+#include <Core/Ray.h>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <memory>
+#include <random>
+#include <limits>
+
+using namespace ph;
+
+namespace
+{
+	// A grid of quads in the XY plane, bent along Z so triangles are not coplanar.
+	void make_grid_soup(
+		const int              numCells,
+		std::vector<Vector3R>* out_positions,
+		std::vector<Vector3R>* out_normals,
+		std::vector<Vector3R>* out_uvws)
+	{
+		const auto vertexAt = [numCells](const int x, const int y)
+		{
+			const real fx = static_cast<real>(x) / numCells;
+			const real fy = static_cast<real>(y) / numCells;
+			return Vector3R(fx * 10.0_r - 5.0_r, fy * 10.0_r - 5.0_r, fx * fx + fy);
+		};
+
+		for(int y = 0; y < numCells; ++y)
+		{
+			for(int x = 0; x < numCells; ++x)
+			{
+				const Vector3R corners[6] = {
+					vertexAt(x, y), vertexAt(x + 1, y), vertexAt(x + 1, y + 1),
+					vertexAt(x, y), vertexAt(x + 1, y + 1), vertexAt(x, y + 1)};
+
+				for(const Vector3R& corner : corners)
+				{
+					out_positions->push_back(corner);
+					out_normals->push_back(Vector3R(corner.x, corner.y, 3.0_r).normalize());
+					out_uvws->push_back(Vector3R(corner.x * 0.1_r + 0.5_r, corner.y * 0.1_r + 0.5_r, 0.0_r));
+				}
+			}
+		}
+	}
+}
+
+TEST(TriangleMeshTest, SharesVerticesAndQuantizesAttributes)
+{
+	std::vector<Vector3R> positions, normals, uvws;
+	make_grid_soup(8, &positions, &normals, &uvws);
+
+	const IndexedTriangleBuffer fullBuffer(positions, normals, uvws, false);
+	const IndexedTriangleBuffer quantizedBuffer(positions, normals, uvws, true);
+
+	ASSERT_EQ(fullBuffer.numTriangles(), 8 * 8 * 2);
+	EXPECT_EQ(fullBuffer.numVertices(), 9 * 9);
+	EXPECT_EQ(quantizedBuffer.numVertices(), 9 * 9);
+	EXPECT_LT(quantizedBuffer.memoryUsage(), fullBuffer.memoryUsage());
+
+	for(std::size_t i = 0; i < fullBuffer.numTriangles(); ++i)
+	{
+		Vector3R vA, vB, vC;
+		fullBuffer.getPositions(i, &vA, &vB, &vC);
+		EXPECT_EQ(vA, positions[i * 3 + 0]);
+		EXPECT_EQ(vB, positions[i * 3 + 1]);
+		EXPECT_EQ(vC, positions[i * 3 + 2]);
+
+		Vector3R nA, nB, nC;
+		quantizedBuffer.getNormals(i, &nA, &nB, &nC);
+		EXPECT_GT(nA.dot(normals[i * 3 + 0]), 0.9999_r);
+		EXPECT_GT(nB.dot(normals[i * 3 + 1]), 0.9999_r);
+		EXPECT_GT(nC.dot(normals[i * 3 + 2]), 0.9999_r);
+
+		Vector3R uvwA, uvwB, uvwC;
+		quantizedBuffer.getUVWs(i, &uvwA, &uvwB, &uvwC);
+		EXPECT_NEAR(uvwA.x, uvws[i * 3 + 0].x, 1e-4_r);
+		EXPECT_NEAR(uvwB.y, uvws[i * 3 + 1].y, 1e-4_r);
+		EXPECT_NEAR(uvwC.z, uvws[i * 3 + 2].z, 1e-4_r);
+	}
+}
+
+TEST(TriangleMeshTest, MatchesIndividualTriangles)
+{
+	std::vector<Vector3R> positions, normals, uvws;
+	make_grid_soup(16, &positions, &normals, &uvws);
+
+	PrimitiveMetadata metadata;
+
+	std::vector<std::unique_ptr<PTriangle>> triangles;
+	std::vector<const Intersectable*>       intersectables;
+	for(std::size_t i = 0; i < positions.size(); i += 3)
+	{
+		triangles.push_back(std::make_unique<PTriangle>(&metadata, positions[i], positions[i + 1], positions[i + 2]));
+		intersectables.push_back(triangles.back().get());
+	}
+	ClassicBvhIntersector bvh;
+	bvh.rebuildWithIntersectables(intersectables);
+
+	// both BVH widths and the default one
+	const PTriangleMesh meshes[] = {
+		{&metadata, IndexedTriangleBuffer(positions, normals, uvws, false)},
+		{&metadata, IndexedTriangleBuffer(positions, normals, uvws, false), 8, EBvhType::SAH_SWEEP}};
+	for(const PTriangleMesh& mesh : meshes)
+	{
+		ASSERT_EQ(mesh.numTriangles(), triangles.size());
+
+		std::mt19937 engine(0);
+		std::uniform_real_distribution<real> coord(-6.0_r, 6.0_r);
+		for(int i = 0; i < 1000; ++i)
+		{
+			const Vector3R origin(coord(engine), coord(engine), 10.0_r);
+			const Vector3R target(coord(engine), coord(engine), -1.0_r);
+			const Ray ray(origin, target.sub(origin).normalize(), 0, std::numeric_limits<real>::max());
+
+			HitProbe bvhProbe;
+			HitProbe meshProbe;
+			const bool isBvhHit = bvh.isIntersecting(ray, bvhProbe);
+			const bool isMeshHit = mesh.isIntersecting(ray, meshProbe);
+
+			ASSERT_EQ(isBvhHit, isMeshHit);
+			EXPECT_EQ(isMeshHit, mesh.isOccluded(ray));
+			if(isMeshHit)
+			{
+				EXPECT_EQ(bvhProbe.getHitRayT(), meshProbe.getHitRayT());
+				EXPECT_EQ(meshProbe.getCurrentHit(), &mesh);
+			}
+		}
+	}
+}
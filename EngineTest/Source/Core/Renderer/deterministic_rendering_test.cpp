@@ -0,0 +1,125 @@
+#include <Core/Engine.h>
+#include <Frame/TFrame.h>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+#include <cstring>
+
+using namespace ph;
+
+namespace
+{
+	const std::vector<std::string> SCENE_COMMANDS = 
+	{
+		R"(## camera(pinhole) [real fov-degree 30] [vector3 position "0 6 40"] [vector3 direction "0 0 -1"] [vector3 up-axis "0 1 0"])",
+		R"(-> geometry(rectangle) @plane [real width 15] [real height 15])",
+		R"(-> geometry(sphere) @ball [real radius 2.5])",
+		R"(-> material(matte-opaque) @white [vector3 albedo "0.9 0.9 0.9"])",
+		R"(-> actor(model) @ground [geometry geometry @plane] [material material @white])",
+		R"(-> actor(model) rotate(@ground) [vector3 axis "1 0 0"] [real degree -90])",
+		R"(-> actor(model) scale(@ground) [vector3 factor "10 10 10"])",
+		R"(-> actor(model) @object [geometry geometry @ball] [material material @white])",
+		R"(-> actor(model) translate(@object) [vector3 factor "0 2.5 0"])",
+		R"(-> light-source(rectangle) @areaSource [vector3 linear-srgb "1 1 0.8"] [real watts 400] [real width 2] [real height 2])",
+		R"(-> actor(light) @topLight [light-source light-source @areaSource])",
+		R"(-> actor(light) translate(@topLight) [vector3 factor "0 10 0"])",
+		R"(-> actor(light) rotate(@topLight) [vector3 axis "1 0 0"] [real degree 90])"
+	};
+
+	HdrRgbFrame render_scene(
+		const std::string& sampleGeneratorCommand,
+		const std::string& rendererCommand,
+		const uint32       numThreads)
+	{
+		Engine engine;
+		engine.setNumRenderThreads(numThreads);
+		engine.enterCommand(sampleGeneratorCommand);
+		engine.enterCommand(rendererCommand);
+		for(const std::string& command : SCENE_COMMANDS)
+		{
+			engine.enterCommand(command);
+		}
+		engine.enterCommand("->");
+
+		engine.update();
+		engine.render();
+
+		const auto resPx = engine.getFilmDimensionPx();
+		HdrRgbFrame frame(static_cast<uint32>(resPx.x), static_cast<uint32>(resPx.y));
+		engine.retrieveFrame(0, frame, false);
+		return frame;
+	}
+
+	void expect_bitwise_equal(const HdrRgbFrame& frameA, const HdrRgbFrame& frameB)
+	{
+		ASSERT_EQ(frameA.widthPx(), frameB.widthPx());
+		ASSERT_EQ(frameA.heightPx(), frameB.heightPx());
+
+		std::size_t numDifferentPixels = 0;
+		for(uint32 y = 0; y < frameA.heightPx(); ++y)
+		{
+			for(uint32 x = 0; x < frameA.widthPx(); ++x)
+			{
+				HdrRgbFrame::Pixel pixelA, pixelB;
+				frameA.getPixel(x, y, &pixelA);
+				frameB.getPixel(x, y, &pixelB);
+				if(std::memcmp(&pixelA, &pixelB, sizeof(pixelA)) != 0)
+				{
+					++numDifferentPixels;
+				}
+			}
+		}
+		EXPECT_EQ(numDifferentPixels, 0);
+	}
+}
+
+TEST(DeterministicRenderingTest, EqualSamplingRendersAreIdentical)
+{
+	const std::string sgCommand       = "## sample-generator(sobol) [integer sample-amount 4]";
+	const std::string rendererCommand = 
+		"## renderer(equal-sampling) [integer width 48][integer height 32][string filter-name gaussian]"
+		"[string estimator bneept][string deterministic true]";
+
+	const HdrRgbFrame frame = render_scene(sgCommand, rendererCommand, 4);
+	expect_bitwise_equal(frame, render_scene(sgCommand, rendererCommand, 4));
+
+	// work is split independently of the number of threads
+	expect_bitwise_equal(frame, render_scene(sgCommand, rendererCommand, 2));
+
+	// the image must not be trivially empty
+	HdrRgbFrame::Pixel pixel;
+	frame.getPixel(24, 8, &pixel);
+	EXPECT_GT(pixel[0] + pixel[1] + pixel[2], 0.0f);
+}
+
+TEST(DeterministicRenderingTest, PhotonMappingRendersAreIdentical)
+{
+	const std::string sgCommand       = "## sample-generator(stratified) [integer sample-amount 1]";
+	const std::string rendererCommand = 
+		"## renderer(pm) [integer width 48][integer height 32][string filter-name box][string mode sppm]"
+		"[integer num-photons 20000][integer num-passes 2][real radius 0.5][string deterministic true]";
+
+	const HdrRgbFrame frame = render_scene(sgCommand, rendererCommand, 1);
+	expect_bitwise_equal(frame, render_scene(sgCommand, rendererCommand, 4));
+	expect_bitwise_equal(frame, render_scene(sgCommand, rendererCommand, 3));
+}
+
+TEST(DeterministicRenderingTest, AdaptiveSamplingRendersAreIdentical)
+{
+	const std::string sgCommand       = "## sample-generator(stratified) [integer sample-amount 4]";
+	const std::string rendererCommand = 
+		"## renderer(adaptive-sampling) [integer width 48][integer height 32][string filter-name box]"
+		"[string estimator bneept][real precision-standard 500][integer min-samples-per-region 16]"
+		"[string deterministic true]";
+
+	// waves of regions do not depend on the number of threads
+	const HdrRgbFrame frame = render_scene(sgCommand, rendererCommand, 1);
+	expect_bitwise_equal(frame, render_scene(sgCommand, rendererCommand, 4));
+	expect_bitwise_equal(frame, render_scene(sgCommand, rendererCommand, 3));
+
+	HdrRgbFrame::Pixel pixel;
+	frame.getPixel(24, 8, &pixel);
+	EXPECT_GT(pixel[0] + pixel[1] + pixel[2], 0.0f);
+}
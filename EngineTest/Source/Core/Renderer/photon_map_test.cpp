@@ -0,0 +1,115 @@
+#include <Core/Renderer/PM/TPhotonMap.h>
+#include <Core/Renderer/PM/FullPhoton.h>
+#include <FileIO/FileSystem/Path.h>
+#include <Math/Random/Pcg32.h>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+namespace
+{
+
+std::vector<ph::FullPhoton> make_random_photons(const std::size_t numPhotons)
+{
+	using namespace ph;
+
+	Pcg32 rng;
+	std::vector<FullPhoton> photons(numPhotons);
+	for(std::size_t i = 0; i < numPhotons; ++i)
+	{
+		photons[i].set<EPhotonData::POSITION>(Vector3R(
+			rng.genUniformReal_i0_e1(),
+			rng.genUniformReal_i0_e1(),
+			rng.genUniformReal_i0_e1()));
+		photons[i].set<EPhotonData::THROUGHPUT_RADIANCE>(SpectralStrength(static_cast<real>(i)));
+		photons[i].set<EPhotonData::FROM_DIR>(Vector3R(0, 1, 0));
+	}
+	return photons;
+}
+
+// sums of throughput radiance identify a set of photons made above
+std::vector<ph::real> gather_sums(const ph::TPhotonMap<ph::FullPhoton>& photonMap)
+{
+	using namespace ph;
+
+	std::vector<real> sums;
+	for(int i = 0; i < 10; ++i)
+	{
+		const real coordinate = static_cast<real>(i) / 10.0_r;
+
+		real sum = 0.0_r;
+		photonMap.forEachWithinRange(Vector3R(coordinate), 0.1_r,
+			[&sum](const FullPhoton& photon)
+			{
+				sum += photon.get<EPhotonData::THROUGHPUT_RADIANCE>()[0];
+			});
+		sums.push_back(sum);
+	}
+	return sums;
+}
+
+void test_save_and_load(const ph::EPhotonMapType type)
+{
+	using namespace ph;
+
+	const Path filePath("./photon_map_test.tmp");
+
+	TPhotonMap<FullPhoton> builtMap(type);
+	builtMap.build(make_random_photons(10000), 0.1_r);
+	ASSERT_TRUE(builtMap.save(filePath, 12345, 777));
+
+	TPhotonMap<FullPhoton> loadedMap(type);
+	std::size_t numPhotonPaths = 0;
+	EXPECT_FALSE(loadedMap.load(Path("./photon_map_test_missing.tmp"), 777, &numPhotonPaths));
+	ASSERT_TRUE(loadedMap.load(filePath, 777, &numPhotonPaths));
+
+	EXPECT_EQ(numPhotonPaths, 12345);
+	EXPECT_EQ(loadedMap.numItems(), builtMap.numItems());
+	EXPECT_EQ(loadedMap.memoryUsage(), builtMap.memoryUsage());
+	EXPECT_EQ(gather_sums(loadedMap), gather_sums(builtMap));
+
+	// photon maps of another type cannot use the file
+	TPhotonMap<FullPhoton> otherTypeMap(
+		type == EPhotonMapType::KD_TREE ? EPhotonMapType::HASH_GRID : EPhotonMapType::KD_TREE);
+	EXPECT_FALSE(otherTypeMap.load(filePath, 777, &numPhotonPaths));
+
+	// neither can photon maps of another content key
+	TPhotonMap<FullPhoton> otherKeyMap(type);
+	EXPECT_FALSE(otherKeyMap.load(filePath, 778, &numPhotonPaths));
+
+	// nor a truncated file
+	const Path truncatedFilePath("./photon_map_test_truncated.tmp");
+	{
+		std::ifstream file(filePath.toAbsoluteString(), std::ios_base::in | std::ios_base::binary);
+		const std::vector<char> bytes{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+		std::ofstream truncatedFile(truncatedFilePath.toAbsoluteString(), std::ios_base::out | std::ios_base::binary);
+		truncatedFile.write(bytes.data(), bytes.size() - 1);
+	}
+	TPhotonMap<FullPhoton> truncatedMap(type);
+	EXPECT_FALSE(truncatedMap.load(truncatedFilePath, 777, &numPhotonPaths));
+	std::remove(truncatedFilePath.toAbsoluteString().c_str());
+
+	// building again replaces the loaded photons
+	loadedMap.build(make_random_photons(10), 0.1_r);
+	EXPECT_EQ(loadedMap.numItems(), 10);
+
+	std::remove(filePath.toAbsoluteString().c_str());
+}
+
+}// end anonymous namespace
+
+TEST(PhotonMapTest, SaveAndLoadKdtree)
+{
+	test_save_and_load(ph::EPhotonMapType::KD_TREE);
+}
+
+TEST(PhotonMapTest, SaveAndLoadHashGrid)
+{
+	test_save_and_load(ph::EPhotonMapType::HASH_GRID);
+}
@@ -0,0 +1,65 @@
+#include <Core/Renderer/PM/VCMPathState.h>
+#include <Core/Renderer/PM/VCMParameters.h>
+
+#include <gtest/gtest.h>
+
+TEST(VCMPathStateTest, WeightFactorsAreReciprocal)
+{
+	using namespace ph;
+
+	const VCMParameters parameters(0.01_r, 640 * 480);
+
+	EXPECT_NEAR(parameters.getMisVmWeightFactor() * parameters.getMisVcWeightFactor(), 1.0_r, 1e-4_r);
+	EXPECT_NEAR(
+		parameters.getVmNormalization(),
+		1.0_r / (constant::pi<real> * 0.01_r * 0.01_r * 640 * 480),
+		1e-9_r);
+}
+
+TEST(VCMPathStateTest, SurfaceHitUpdate)
+{
+	using namespace ph;
+
+	VCMPathState state;
+	state.dVCM = 2.0_r;
+	state.dVC  = 3.0_r;
+	state.dVM  = 4.0_r;
+
+	state.onSurfaceHit(4.0_r, 0.5_r);
+
+	// power heuristic: each quantity is scaled by squared ratios
+	EXPECT_FLOAT_EQ(state.dVCM, 2.0_r * 16.0_r / 0.25_r);
+	EXPECT_FLOAT_EQ(state.dVC,  3.0_r / 0.25_r);
+	EXPECT_FLOAT_EQ(state.dVM,  4.0_r / 0.25_r);
+	EXPECT_EQ(state.pathLength, 1);
+}
+
+TEST(VCMPathStateTest, ScatterUpdate)
+{
+	using namespace ph;
+
+	const VCMParameters parameters(0.1_r, 100);
+
+	VCMPathState specular;
+	specular.dVCM = 2.0_r;
+	specular.dVC  = 3.0_r;
+	specular.dVM  = 4.0_r;
+	specular.onScatter(0.5_r, 0.0_r, 0.0_r, true, parameters);
+
+	EXPECT_EQ(specular.dVCM, 0.0_r);
+	EXPECT_FLOAT_EQ(specular.dVC, 3.0_r * 0.25_r);
+	EXPECT_FLOAT_EQ(specular.dVM, 4.0_r * 0.25_r);
+
+	VCMPathState diffuse;
+	diffuse.dVCM = 2.0_r;
+	diffuse.dVC  = 3.0_r;
+	diffuse.dVM  = 4.0_r;
+	diffuse.onScatter(0.5_r, 0.25_r, 0.5_r, false, parameters);
+
+	const real misCosOverPdf = 4.0_r;
+	EXPECT_FLOAT_EQ(diffuse.dVC, 
+		misCosOverPdf * (3.0_r * 0.25_r + 2.0_r + parameters.getMisVmWeightFactor()));
+	EXPECT_FLOAT_EQ(diffuse.dVM, 
+		misCosOverPdf * (4.0_r * 0.25_r + 2.0_r * parameters.getMisVcWeightFactor() + 1.0_r));
+	EXPECT_FLOAT_EQ(diffuse.dVCM, 16.0_r);
+}
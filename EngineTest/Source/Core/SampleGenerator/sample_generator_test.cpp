@@ -0,0 +1,287 @@
+#include <Core/SampleGenerator/SGSobol.h>
+#include <Core/SampleGenerator/SGHalton.h>
+#include <Core/SampleGenerator/SGPmj02.h>
+#include <Core/SampleGenerator/SGStratified.h>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <memory>
+#include <algorithm>
+
+using namespace ph;
+
+namespace
+{
+	// Checks whether the points form a (0, m, 2)-net in base 2, i.e., each
+	// elementary interval of area 1/<numPoints> contains exactly one point.
+	void expect_0m2_net(const std::vector<Vector2R>& points)
+	{
+		const std::size_t numPoints = points.size();
+		for(std::size_t numX = 1; numX <= numPoints; numX *= 2)
+		{
+			const std::size_t numY = numPoints / numX;
+
+			std::vector<int> counts(numPoints, 0);
+			for(const Vector2R& point : points)
+			{
+				const auto x = static_cast<std::size_t>(point.x * static_cast<real>(numX));
+				const auto y = static_cast<std::size_t>(point.y * static_cast<real>(numY));
+				ASSERT_LT(x, numX);
+				ASSERT_LT(y, numY);
+
+				++counts[y * numX + x];
+			}
+			for(int count : counts)
+			{
+				EXPECT_EQ(count, 1);
+			}
+		}
+	}
+
+	std::vector<Vector2R> gen_single_stratum_points(SampleGenerator& sg, const std::size_t numPoints)
+	{
+		const Samples2DStage stage = sg.declare2DStage(numPoints);
+
+		std::vector<Vector2R> points;
+		EXPECT_TRUE(sg.prepareSampleBatch());
+		const Samples2D samples = sg.getSamples2D(stage);
+		for(std::size_t i = 0; i < samples.numSamples(); ++i)
+		{
+			points.push_back(samples[i]);
+		}
+		return points;
+	}
+
+	// Takes one sample per pixel in each batch, and returns the samples of 
+	// each pixel in local coordinates.
+	std::vector<std::vector<Vector2R>> gen_per_pixel_points(
+		SampleGenerator& sg, 
+		const Vector2S&  resPx, 
+		const std::size_t numBatches)
+	{
+		const Samples2DStage stage = sg.declare2DStage(resPx.product(), resPx);
+
+		std::vector<std::vector<Vector2R>> pixelPoints(resPx.product());
+		for(std::size_t b = 0; b < numBatches; ++b)
+		{
+			EXPECT_TRUE(sg.prepareSampleBatch());
+			const Samples2D samples = sg.getSamples2D(stage);
+			for(std::size_t i = 0; i < samples.numSamples(); ++i)
+			{
+				const Vector2R point = samples[i].mul(Vector2R(resPx));
+				const std::size_t x = static_cast<std::size_t>(point.x);
+				const std::size_t y = static_cast<std::size_t>(point.y);
+				EXPECT_EQ(y * resPx.x + x, i);
+
+				pixelPoints[i].push_back(point.sub(Vector2R(Vector2S(x, y))));
+			}
+		}
+		return pixelPoints;
+	}
+}
+
+TEST(SampleGeneratorTest, SobolPointsAreElementaryIntervalStratified)
+{
+	SGSobol sg(1);
+	expect_0m2_net(gen_single_stratum_points(sg, 256));
+}
+
+TEST(SampleGeneratorTest, Pmj02PointsAreElementaryIntervalStratified)
+{
+	SGPmj02 sg(1);
+	expect_0m2_net(gen_single_stratum_points(sg, 1024));
+}
+
+TEST(SampleGeneratorTest, PixelSamplesAreProgressivelyStratified)
+{
+	const Vector2S resPx(3, 5);
+
+	SGSobol sobol(16);
+	for(const auto& points : gen_per_pixel_points(sobol, resPx, 16))
+	{
+		expect_0m2_net(std::vector<Vector2R>(points.begin(), points.begin() + 8));
+		expect_0m2_net(points);
+	}
+
+	SGPmj02 pmj02(16);
+	for(const auto& points : gen_per_pixel_points(pmj02, resPx, 16))
+	{
+		expect_0m2_net(std::vector<Vector2R>(points.begin(), points.begin() + 4));
+		expect_0m2_net(points);
+	}
+
+	// Halton points are stratified on 2^i-by-3^j grids
+	SGHalton halton(6);
+	for(const auto& points : gen_per_pixel_points(halton, resPx, 6))
+	{
+		std::vector<int> counts(6, 0);
+		for(const Vector2R& point : points)
+		{
+			++counts[static_cast<std::size_t>(point.y * 3) * 2 + static_cast<std::size_t>(point.x * 2)];
+		}
+		for(int count : counts)
+		{
+			EXPECT_EQ(count, 1);
+		}
+	}
+}
+
+TEST(SampleGeneratorTest, PixelsAreScrambledDifferently)
+{
+	SGSobol sg(1);
+	const auto pixelPoints = gen_per_pixel_points(sg, {2, 1}, 1);
+	EXPECT_NE(pixelPoints[0][0].x, pixelPoints[1][0].x);
+}
+
+TEST(SampleGeneratorTest, OneDimensionalSamplesAreStratified)
+{
+	const std::size_t numSamples = 64;
+	const std::size_t numBatches = 4;
+
+	SGSobol  sobol(numBatches);
+	SGHalton halton(numBatches);
+	SGPmj02  pmj02(numBatches);
+	for(SampleGenerator* sg : {static_cast<SampleGenerator*>(&sobol), static_cast<SampleGenerator*>(&halton), static_cast<SampleGenerator*>(&pmj02)})
+	{
+		SCOPED_TRACE(sg == &sobol ? "sobol" : sg == &halton ? "halton" : "pmj02");
+
+		const Samples1DStage stage = sg->declare1DStage(numSamples);
+
+		// the interval each slot (e.g., a pixel) falls in, for every batch
+		std::vector<std::vector<std::size_t>> slotIntervals(numSamples);
+		for(std::size_t b = 0; b < numBatches; ++b)
+		{
+			ASSERT_TRUE(sg->prepareSampleBatch());
+			const Samples1D samples = sg->getSamples1D(stage);
+
+			std::vector<int> counts(numSamples, 0);
+			for(std::size_t i = 0; i < samples.numSamples(); ++i)
+			{
+				const auto interval = static_cast<std::size_t>(samples[i] * static_cast<real>(numSamples));
+				ASSERT_LT(interval, numSamples);
+
+				++counts[interval];
+				slotIntervals[i].push_back(interval);
+			}
+			for(int count : counts)
+			{
+				EXPECT_EQ(count, 1);
+			}
+		}
+
+		// slots must not stick to the same interval across batches
+		std::size_t numStuckSlots = 0;
+		for(const auto& intervals : slotIntervals)
+		{
+			if(std::all_of(intervals.begin(), intervals.end(), [&](std::size_t i) { return i == intervals[0]; }))
+			{
+				++numStuckSlots;
+			}
+		}
+		EXPECT_LT(numStuckSlots, numSamples / 4);
+	}
+}
+
+TEST(SampleGeneratorTest, NDimensionalSamplesAreStratifiedPerDimension)
+{
+	SGSobol sg(1);
+	const SamplesNDStage stage = sg.declareNDStage(16, 3, {2, 1, 2});
+
+	ASSERT_TRUE(sg.prepareSampleBatch());
+	const SamplesND samples = sg.getSamplesND(stage);
+	ASSERT_EQ(samples.numDims(), 3);
+
+	// 4 strata with 4 points each, which are stratified in every dimension
+	// within the stratum
+	const std::size_t dimSizes[] = {2, 1, 2};
+	for(std::size_t stratumIndex = 0; stratumIndex < 4; ++stratumIndex)
+	{
+		const std::size_t stratumCoords[] = {stratumIndex % 2, 0, stratumIndex / 2};
+		for(std::size_t d = 0; d < 3; ++d)
+		{
+			std::vector<int> counts(4, 0);
+			for(std::size_t i = stratumIndex; i < samples.numSamples(); i += 4)
+			{
+				const real localValue = samples[i][d] * static_cast<real>(dimSizes[d]) - static_cast<real>(stratumCoords[d]);
+				ASSERT_GE(localValue, 0.0_r);
+				ASSERT_LT(localValue, 1.0_r);
+
+				++counts[static_cast<std::size_t>(localValue * 4)];
+			}
+			for(int count : counts)
+			{
+				EXPECT_EQ(count, 1);
+			}
+		}
+	}
+
+	// dimensions are scrambled and shuffled independently
+	EXPECT_NE(samples[0][0] * 2, samples[0][2] * 2);
+}
+
+TEST(SampleGeneratorTest, OneDimensionalSamplesAreIndependentOfPixelSamples)
+{
+	// as drawn by camera sampling works: a 2-D stage over pixels, then a 
+	// 1-D stage of the same size (e.g., for wavelengths)
+	const Vector2S    resPx(4, 4);
+	const std::size_t numBatches = 64;
+	const std::size_t numCells   = 4;
+
+	SGSobol      sobol(numBatches);
+	SGHalton     halton(numBatches);
+	SGPmj02      pmj02(numBatches);
+	SGStratified stratified(numBatches);
+	for(SampleGenerator* sg : {
+		static_cast<SampleGenerator*>(&sobol), static_cast<SampleGenerator*>(&halton), 
+		static_cast<SampleGenerator*>(&pmj02), static_cast<SampleGenerator*>(&stratified)})
+	{
+		SCOPED_TRACE(sg == &sobol ? "sobol" : sg == &halton ? "halton" : sg == &pmj02 ? "pmj02" : "stratified");
+
+		const Samples2DStage pixelStage = sg->declare2DStage(resPx.product(), resPx);
+		const Samples1DStage valueStage = sg->declare1DStage(resPx.product());
+
+		// For each pixel, counts of (in-pixel x, 1-D value) and (in-pixel y, 
+		// 1-D value) pairs in a grid of cells. A 1-D value that follows the
+		// pixel sample piles up in a few cells.
+		std::vector<std::vector<int>> xCounts(resPx.product(), std::vector<int>(numCells * numCells, 0));
+		std::vector<std::vector<int>> yCounts(resPx.product(), std::vector<int>(numCells * numCells, 0));
+		for(std::size_t b = 0; b < numBatches; ++b)
+		{
+			ASSERT_TRUE(sg->prepareSampleBatch());
+			const Samples2D pixelSamples = sg->getSamples2D(pixelStage);
+			const Samples1D values       = sg->getSamples1D(valueStage);
+			for(std::size_t i = 0; i < pixelSamples.numSamples(); ++i)
+			{
+				const Vector2R point = pixelSamples[i].mul(Vector2R(resPx));
+				const Vector2S pixel(static_cast<std::size_t>(point.x), static_cast<std::size_t>(point.y));
+				const Vector2R local = point.sub(Vector2R(pixel));
+
+				const auto cellX = std::min(static_cast<std::size_t>(local.x * numCells), numCells - 1);
+				const auto cellY = std::min(static_cast<std::size_t>(local.y * numCells), numCells - 1);
+				const auto cellV = std::min(static_cast<std::size_t>(values[i] * numCells), numCells - 1);
+				++xCounts[pixel.y * resPx.x + pixel.x][cellV * numCells + cellX];
+				++yCounts[pixel.y * resPx.x + pixel.x][cellV * numCells + cellY];
+			}
+		}
+
+		// chi-square statistics summed over pixels, each having 
+		// numCells^2 - 1 degrees of freedom as expected counts are fixed; 
+		// the expected sum is 240 with a standard deviation of about 22, 
+		// while a 1-D value following the pixel sample gives about 3000
+		const real expectedCount = static_cast<real>(numBatches) / static_cast<real>(numCells * numCells);
+		for(const auto* counts : {&xCounts, &yCounts})
+		{
+			real chiSquare = 0.0_r;
+			for(const auto& pixelCounts : *counts)
+			{
+				for(const int count : pixelCounts)
+				{
+					const real diff = static_cast<real>(count) - expectedCount;
+					chiSquare += diff * diff / expectedCount;
+				}
+			}
+			EXPECT_LT(chiSquare, 400.0_r);
+		}
+	}
+}
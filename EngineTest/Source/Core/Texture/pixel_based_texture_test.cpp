@@ -1,5 +1,7 @@
 #include <Core/Texture/TNearestPixelTex2D.h>
 #include <Core/Texture/TBilinearPixelTex2D.h>
+#include <Core/Texture/TTrilinearPixelTex2D.h>
+#include <Core/Texture/TEwaPixelTex2D.h>
 
 #include <gtest/gtest.h>
 
@@ -119,3 +121,53 @@ TEST(PixelBasedTextureTest, BilinearFilteredTexture)
 	texture1.sample(uv(0.5_r, 0.5_r), &pixel);
 	EXPECT_FLOAT_EQ(pixel[0], (1.0f + 2.0f + 3.0f + 4.0f) / 4.0f);
 }
+
+TEST(PixelBasedTextureTest, MipmapFilteredTexture)
+{
+	using namespace ph;
+
+	auto uv = [](const real u, const real v, const Vector2R& dUVdX, const Vector2R& dUVdY)
+	{
+		SampleLocation location(Vector3R(u, v, 0), EQuantity::RAW);
+		location.setUvDerivatives(dUVdX, dUVdY);
+		return location;
+	};
+
+	typedef TFrame<float, 1> Frame;
+
+	// a 4x4 checkerboard of 0s and 1s
+	Frame frame1(4, 4);
+	for(uint32 y = 0; y < 4; ++y)
+	{
+		for(uint32 x = 0; x < 4; ++x)
+		{
+			frame1.setPixel(x, y, Frame::Pixel((x + y) % 2 == 0 ? 0.0f : 1.0f));
+		}
+	}
+
+	TTrilinearPixelTex2D<float, 1> trilinear(frame1);
+	trilinear.setWrapMode(ETexWrapMode::REPEAT);
+	TEwaPixelTex2D<float, 1> ewa(frame1);
+	ewa.setWrapMode(ETexWrapMode::REPEAT);
+
+	EXPECT_EQ(trilinear.numLevels(), 3);
+	EXPECT_EQ(ewa.numLevels(), 3);
+
+	TTexPixel<float, 1> pixel;
+
+	// without footprints, texels of level 0 are obtained
+	trilinear.sample(uv(0.125_r, 0.125_r, Vector2R(0), Vector2R(0)), &pixel);
+	EXPECT_FLOAT_EQ(pixel[0], 0.0f);
+	ewa.sample(uv(0.375_r, 0.125_r, Vector2R(0), Vector2R(0)), &pixel);
+	EXPECT_FLOAT_EQ(pixel[0], 1.0f);
+
+	// footprints covering the whole texture average out the checkerboard
+	trilinear.sample(uv(0.125_r, 0.125_r, Vector2R(1, 0), Vector2R(0, 1)), &pixel);
+	EXPECT_NEAR(pixel[0], 0.5f, 0.05f);
+	ewa.sample(uv(0.125_r, 0.125_r, Vector2R(1, 0), Vector2R(0, 1)), &pixel);
+	EXPECT_NEAR(pixel[0], 0.5f, 0.05f);
+
+	// an elongated footprint along a row averages the checkerboard too
+	ewa.sample(uv(0.125_r, 0.125_r, Vector2R(0.5_r, 0), Vector2R(0, 0.0625_r)), &pixel);
+	EXPECT_NEAR(pixel[0], 0.5f, 0.15f);
+}
@@ -0,0 +1,167 @@
+#include <Core/Texture/TextureCache.h>
+#include <Core/Texture/TTiledImage.h>
+#include <Core/Texture/TNearestPixelTex2D.h>
+#include <FileIO/FileSystem/Path.h>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+#include <cstdio>
+
+TEST(TextureCacheTest, EvictsLeastRecentlyUsedTiles)
+{
+	using namespace ph;
+
+	// each tile is larger than a shard's share of the budget, so only the
+	// most recently used tile of a shard stays cached
+	TextureCache cache(1024);
+	const uint64 sourceId = cache.newSourceId();
+
+	std::size_t numLoads = 0;
+	auto loader = [&numLoads]()
+	{
+		++numLoads;
+		return TextureCache::Tile(1024, std::byte(7));
+	};
+
+	const auto tile = cache.getTile(sourceId, 0, loader);
+	ASSERT_TRUE(tile);
+	EXPECT_EQ(tile->size(), 1024);
+	EXPECT_EQ((*tile)[0], std::byte(7));
+	EXPECT_EQ(numLoads, 1);
+	EXPECT_EQ(cache.numMisses(), 1);
+
+	cache.getTile(sourceId, 0, loader);
+	EXPECT_EQ(numLoads, 1);
+	EXPECT_EQ(cache.numHits(), 1);
+
+	for(uint64 tileIndex = 1; tileIndex < 200; ++tileIndex)
+	{
+		cache.getTile(sourceId, tileIndex, loader);
+	}
+	EXPECT_EQ(numLoads, 200);
+	EXPECT_LE(cache.memoryUsage(), 32 * 1024);
+
+	// tiles stay valid while in use even if evicted
+	EXPECT_EQ((*tile)[1023], std::byte(7));
+
+	cache.removeSource(sourceId);
+	EXPECT_EQ(cache.memoryUsage(), 0);
+
+	cache.getTile(sourceId, 0, loader);
+	EXPECT_EQ(numLoads, 201);
+}
+
+TEST(TextureCacheTest, ThreadTilesBypassSharedTiles)
+{
+	using namespace ph;
+
+	TextureCache cache(1024 * 1024);
+	const uint64 sourceId = cache.newSourceId();
+
+	auto loader = [](const uint64 tileIndex)
+	{
+		return [tileIndex]()
+		{
+			return TextureCache::Tile(16, std::byte(tileIndex));
+		};
+	};
+
+	const TextureCache::Tile* tile = cache.getTileForThread(sourceId, 0, loader(0));
+	ASSERT_TRUE(tile);
+	EXPECT_EQ((*tile)[0], std::byte(0));
+	EXPECT_EQ(cache.numMisses(), 1);
+
+	// repeated accesses are served by the thread without the shared tiles
+	tile = cache.getTileForThread(sourceId, 0, loader(0));
+	EXPECT_EQ((*tile)[0], std::byte(0));
+	EXPECT_EQ(cache.numHits(), 0);
+	EXPECT_EQ(cache.numMisses(), 1);
+
+	// tiles of another source are never mistaken for the thread's tiles,
+	// even those of another cache
+	TextureCache otherCache(1024 * 1024);
+	tile = otherCache.getTileForThread(otherCache.newSourceId(), 0, loader(9));
+	EXPECT_EQ((*tile)[0], std::byte(9));
+
+	// once replaced by enough other tiles, the tile comes from the shared 
+	// tiles again
+	for(uint64 tileIndex = 1; tileIndex <= 8; ++tileIndex)
+	{
+		tile = cache.getTileForThread(sourceId, tileIndex, loader(tileIndex));
+		EXPECT_EQ((*tile)[0], std::byte(tileIndex));
+	}
+	tile = cache.getTileForThread(sourceId, 0, loader(0));
+	EXPECT_EQ((*tile)[0], std::byte(0));
+	EXPECT_EQ(cache.numHits(), 1);
+	EXPECT_EQ(cache.numMisses(), 9);
+}
+
+TEST(TextureCacheTest, TiledImageSaveAndOpen)
+{
+	using namespace ph;
+
+	typedef TFrame<int, 1> Frame;
+
+	const Path filePath("./texture_cache_test.tmp");
+
+	std::vector<Frame> levels;
+	levels.push_back(Frame(10, 6));
+	levels.push_back(Frame(5, 3));
+	for(std::size_t level = 0; level < levels.size(); ++level)
+	{
+		for(uint32 y = 0; y < levels[level].heightPx(); ++y)
+		{
+			for(uint32 x = 0; x < levels[level].widthPx(); ++x)
+			{
+				levels[level].setPixel(x, y, Frame::Pixel(static_cast<int>(level * 1000 + y * 100 + x)));
+			}
+		}
+	}
+	ASSERT_TRUE((TTiledImage<int, 1>::save(levels, filePath, 42, 4)));
+
+	TextureCache cache(1024 * 1024);
+	auto tiledImage = std::make_shared<TTiledImage<int, 1>>(&cache);
+	ASSERT_TRUE(tiledImage->open(filePath, 42));
+	EXPECT_EQ(tiledImage->numLevels(), 2);
+	EXPECT_EQ(tiledImage->tileSizePx(), 4);
+	EXPECT_EQ(tiledImage->widthPx(0), 10);
+	EXPECT_EQ(tiledImage->heightPx(0), 6);
+	EXPECT_EQ(tiledImage->widthPx(1), 5);
+	EXPECT_EQ(tiledImage->heightPx(1), 3);
+
+	Frame::Pixel pixel;
+	for(std::size_t level = 0; level < levels.size(); ++level)
+	{
+		for(uint32 y = 0; y < levels[level].heightPx(); ++y)
+		{
+			for(uint32 x = 0; x < levels[level].widthPx(); ++x)
+			{
+				tiledImage->getPixel(level, x, y, &pixel);
+				EXPECT_EQ(pixel[0], static_cast<int>(level * 1000 + y * 100 + x));
+			}
+		}
+	}
+
+	// level 0 has 3x2 tiles, level 1 has 2x1 tiles
+	EXPECT_EQ(cache.numMisses(), 8);
+
+	TNearestPixelTex2D<int, 1> texture(tiledImage, 0);
+	EXPECT_EQ(texture.getWidthPx(), 10);
+	EXPECT_EQ(texture.getHeightPx(), 6);
+
+	TTexPixel<int, 1> texel;
+	texture.sample(SampleLocation(Vector3R(0.95_r, 0.95_r, 0), EQuantity::RAW), &texel);
+	EXPECT_EQ(texel[0], 509);
+
+	// images of another pixel type cannot use the file
+	TTiledImage<float32, 3> otherTypeImage(&cache);
+	EXPECT_FALSE(otherTypeImage.open(filePath, 42));
+
+	// nor can images of another source key (stale files)
+	TTiledImage<int, 1> staleImage(&cache);
+	EXPECT_FALSE(staleImage.open(filePath, 43));
+
+	std::remove(filePath.toAbsoluteString().c_str());
+}
@@ -0,0 +1,148 @@
+#include <Core/Quantity/SpectralStrength.h>
+#include <Core/Quantity/ColorSpace.h>
+#include <Math/TVector3.h>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <algorithm>
+
+namespace
+{
+	using HeroSpectrum = ph::THeroSpectralStrength<4>;
+}
+
+TEST(HeroSpectralStrengthTest, SampleWavelengths)
+{
+	using namespace ph;
+
+	HeroSpectrum::clearWavelengths();
+	EXPECT_FALSE(HeroSpectrum::hasWavelengths());
+
+	HeroSpectrum::sampleWavelengths(0.1_r);
+	ASSERT_TRUE(HeroSpectrum::hasWavelengths());
+
+	// evenly spaced after the hero wavelength, wrapping around
+	const auto& indices = HeroSpectrum::sampleIndices();
+	EXPECT_EQ(indices[0], 10);
+	EXPECT_EQ(indices[1], 35);
+	EXPECT_EQ(indices[2], 60);
+	EXPECT_EQ(indices[3], 85);
+
+	HeroSpectrum::sampleWavelengths(0.905_r);
+	EXPECT_EQ(HeroSpectrum::sampleIndices()[0], 90);
+	EXPECT_EQ(HeroSpectrum::sampleIndices()[1], 15);
+
+	for(std::size_t i = 0; i < 4; ++i)
+	{
+		const real nm = HeroSpectrum::wavelengthNmOf(i);
+		EXPECT_GE(nm, static_cast<real>(PH_SPECTRUM_SAMPLED_MIN_WAVELENGTH_NM));
+		EXPECT_LT(nm, static_cast<real>(PH_SPECTRUM_SAMPLED_MAX_WAVELENGTH_NM));
+	}
+
+	HeroSpectrum::clearWavelengths();
+}
+
+TEST(HeroSpectralStrengthTest, ReflectanceEstimatesAreUnclamped)
+{
+	using namespace ph;
+
+	const real ACCEPTABLE_ERROR = 0.0005_r;
+
+	SampledSpectralStrength white;
+	white.setLinearSrgb(Vector3R(1.0_r), EQuantity::ECF);
+	const Vector3R expected = white.genLinearSrgb(EQuantity::ECF);
+
+	// single estimates of a valid reflectance can exceed 1; clamping them 
+	// would make the average darker than the full conversion
+	const std::size_t NUM_STRATA = 200;
+	Vector3R sum(0);
+	real     maxComponent = 0.0_r;
+	for(std::size_t k = 0; k < NUM_STRATA; ++k)
+	{
+		HeroSpectrum::sampleWavelengths((static_cast<real>(k) + 0.5_r) / static_cast<real>(NUM_STRATA));
+
+		HeroSpectrum albedo;
+		albedo.setSampled(white, EQuantity::ECF);
+		const Vector3R estimate = albedo.genLinearSrgb(EQuantity::ECF);
+		sum.addLocal(estimate);
+		maxComponent = std::max(maxComponent, estimate.max());
+	}
+	HeroSpectrum::clearWavelengths();
+
+	EXPECT_GT(maxComponent, 1.0_r);
+
+	const Vector3R estimate = sum.div(static_cast<real>(NUM_STRATA));
+	EXPECT_NEAR(estimate.x, expected.x, ACCEPTABLE_ERROR);
+	EXPECT_NEAR(estimate.y, expected.y, ACCEPTABLE_ERROR);
+	EXPECT_NEAR(estimate.z, expected.z, ACCEPTABLE_ERROR);
+}
+
+TEST(HeroSpectralStrengthTest, SetSampled)
+{
+	using namespace ph;
+
+	SampledSpectralStrength sampled;
+	for(std::size_t i = 0; i < SampledSpectralStrength::NUM_VALUES; ++i)
+	{
+		sampled[i] = static_cast<real>(i);
+	}
+
+	// without wavelengths, values represent a constant spectrum
+	HeroSpectrum::clearWavelengths();
+	HeroSpectrum constant;
+	constant.setSampled(sampled);
+	for(std::size_t i = 0; i < 4; ++i)
+	{
+		EXPECT_FLOAT_EQ(constant[i], sampled.avg());
+	}
+
+	HeroSpectrum::sampleWavelengths(0.0_r);
+	HeroSpectrum gathered;
+	gathered.setSampled(sampled);
+	EXPECT_FLOAT_EQ(gathered[0], 0.0_r);
+	EXPECT_FLOAT_EQ(gathered[1], 25.0_r);
+	EXPECT_FLOAT_EQ(gathered[2], 50.0_r);
+	EXPECT_FLOAT_EQ(gathered[3], 75.0_r);
+
+	HeroSpectrum::clearWavelengths();
+}
+
+TEST(HeroSpectralStrengthTest, LinearSrgbEstimateConverges)
+{
+	using namespace ph;
+
+	const real ACCEPTABLE_ERROR = 0.0005_r;
+
+	const SampledSpectralStrength& d65 = ColorSpace::get_D65_SPD();
+	const Vector3R expected = SampledSpectralStrength(d65).genLinearSrgb(EQuantity::EMR);
+
+	// stratified hero samples cover all intervals evenly, so the average of
+	// the estimates equals the conversion of the full spectrum
+	const std::size_t NUM_STRATA = 200;
+	Vector3R sum(0);
+	for(std::size_t k = 0; k < NUM_STRATA; ++k)
+	{
+		HeroSpectrum::sampleWavelengths((static_cast<real>(k) + 0.5_r) / static_cast<real>(NUM_STRATA));
+
+		HeroSpectrum radiance;
+		radiance.setSampled(d65, EQuantity::EMR);
+		sum.addLocal(radiance.genLinearSrgb(EQuantity::EMR));
+	}
+	HeroSpectrum::clearWavelengths();
+
+	const Vector3R estimate = sum.div(static_cast<real>(NUM_STRATA));
+	EXPECT_NEAR(estimate.x, expected.x, ACCEPTABLE_ERROR);
+	EXPECT_NEAR(estimate.y, expected.y, ACCEPTABLE_ERROR);
+	EXPECT_NEAR(estimate.z, expected.z, ACCEPTABLE_ERROR);
+
+	// a round trip at the same wavelengths reproduces a reflectance
+	HeroSpectrum::sampleWavelengths(0.3_r);
+	HeroSpectrum albedo;
+	albedo.setLinearSrgb(Vector3R(0.5_r), EQuantity::ECF);
+	for(std::size_t i = 0; i < 4; ++i)
+	{
+		EXPECT_NEAR(albedo[i], 0.5_r, ACCEPTABLE_ERROR);
+	}
+	HeroSpectrum::clearWavelengths();
+}
@@ -0,0 +1,601 @@
+#include <FileIO/ExrFileWriter.h>
+#include <FileIO/ZlibCompressor.h>
+#include <FileIO/FileSystem/Path.h>
+#include <Frame/TFrame.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace ph;
+
+namespace
+{
+
+struct ExrBlock
+{
+	int32              firstLine;
+	std::vector<uint8> data;
+};
+
+struct ExrFile
+{
+	uint32                   version;
+	std::vector<std::string> channelNames;
+	std::vector<int32>       channelPixelTypes;
+	uint8                    compression;
+	std::vector<ExrBlock>    blocks;
+};
+
+uint32 read_uint32(const std::vector<uint8>& bytes, const std::size_t offset)
+{
+	return bytes[offset] | bytes[offset + 1] << 8 | bytes[offset + 2] << 16 | static_cast<uint32>(bytes[offset + 3]) << 24;
+}
+
+std::string read_string(const std::vector<uint8>& bytes, std::size_t* const offset)
+{
+	std::string value;
+	while(bytes[*offset] != 0)
+	{
+		value.push_back(static_cast<char>(bytes[(*offset)++]));
+	}
+	++(*offset);
+	return value;
+}
+
+// Reads the parts of a scanline file needed by the tests.
+ExrFile read_exr(const Path& filePath, const std::size_t numBlocks)
+{
+	std::ifstream stream(filePath.toAbsoluteString(), std::ios_base::in | std::ios_base::binary);
+	const std::vector<uint8> bytes{std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+
+	ExrFile file;
+	EXPECT_EQ(read_uint32(bytes, 0), 20000630);
+	file.version = read_uint32(bytes, 4);
+
+	std::size_t offset = 8;
+	while(bytes[offset] != 0)
+	{
+		const std::string name = read_string(bytes, &offset);
+		const std::string type = read_string(bytes, &offset);
+		const uint32      size = read_uint32(bytes, offset);
+		offset += 4;
+
+		if(name == "channels")
+		{
+			std::size_t channelOffset = offset;
+			while(bytes[channelOffset] != 0)
+			{
+				file.channelNames.push_back(read_string(bytes, &channelOffset));
+				file.channelPixelTypes.push_back(static_cast<int32>(read_uint32(bytes, channelOffset)));
+				channelOffset += 16;
+			}
+		}
+		else if(name == "compression")
+		{
+			file.compression = bytes[offset];
+		}
+		offset += size;
+	}
+	++offset;
+
+	for(std::size_t i = 0; i < numBlocks; ++i)
+	{
+		const std::size_t blockOffset = read_uint32(bytes, offset + i * 8);
+		const uint32      blockSize   = read_uint32(bytes, blockOffset + 4);
+
+		ExrBlock block;
+		block.firstLine = static_cast<int32>(read_uint32(bytes, blockOffset));
+		block.data.assign(bytes.begin() + blockOffset + 8, bytes.begin() + blockOffset + 8 + blockSize);
+		file.blocks.push_back(block);
+	}
+	return file;
+}
+
+// Reverses the byte prediction and reordering done before RLE and zlib 
+// compression.
+std::vector<uint8> unpredict_bytes(std::vector<uint8> predicted)
+{
+	for(std::size_t i = 1; i < predicted.size(); ++i)
+	{
+		predicted[i] = static_cast<uint8>(predicted[i - 1] + predicted[i] - 128);
+	}
+
+	std::vector<uint8> bytes(predicted.size());
+	const std::size_t numEvenBytes = (bytes.size() + 1) / 2;
+	for(std::size_t i = 0; i < bytes.size(); ++i)
+	{
+		bytes[i] = predicted[i % 2 == 0 ? i / 2 : numEvenBytes + i / 2];
+	}
+	return bytes;
+}
+
+std::vector<uint8> rle_decompress(const std::vector<uint8>& compressed)
+{
+	std::vector<uint8> predicted;
+	for(std::size_t i = 0; i < compressed.size();)
+	{
+		const int count = static_cast<int8>(compressed[i++]);
+		if(count < 0)
+		{
+			predicted.insert(predicted.end(), compressed.begin() + i, compressed.begin() + i - count);
+			i -= count;
+		}
+		else
+		{
+			predicted.insert(predicted.end(), count + 1, compressed[i++]);
+		}
+	}
+	return unpredict_bytes(std::move(predicted));
+}
+
+// Bits of a deflate stream, read from the least significant bit of each
+// byte. Reading past the end yields zeros and marks the reader as failed.
+struct InflateBitReader
+{
+	const std::vector<uint8>& bytes;
+	std::size_t               byteIndex;
+	uint32                    bitBuffer;
+	int                       numBufferedBits;
+	bool                      hasFailed;
+
+	uint32 readBits(const int numBits)
+	{
+		while(numBufferedBits < numBits)
+		{
+			if(byteIndex >= bytes.size())
+			{
+				hasFailed = true;
+				return 0;
+			}
+			bitBuffer |= static_cast<uint32>(bytes[byteIndex++]) << numBufferedBits;
+			numBufferedBits += 8;
+		}
+
+		const uint32 value = bitBuffer & ((uint32(1) << numBits) - 1);
+		bitBuffer >>= numBits;
+		numBufferedBits -= numBits;
+		return value;
+	}
+
+	void alignToByte()
+	{
+		bitBuffer       = 0;
+		numBufferedBits = 0;
+	}
+};
+
+// A canonical Huffman code as the number of codes of each length and the
+// symbols sorted by code.
+struct InflateHuffman
+{
+	std::vector<int> counts;
+	std::vector<int> symbols;
+
+	explicit InflateHuffman(const std::vector<int>& codeLengths) :
+		counts(16, 0), symbols(codeLengths.size())
+	{
+		for(const int length : codeLengths)
+		{
+			++counts[length];
+		}
+		counts[0] = 0;
+
+		std::vector<int> offsets(16, 0);
+		for(int length = 1; length < 15; ++length)
+		{
+			offsets[length + 1] = offsets[length] + counts[length];
+		}
+		for(std::size_t symbol = 0; symbol < codeLengths.size(); ++symbol)
+		{
+			if(codeLengths[symbol] != 0)
+			{
+				symbols[offsets[codeLengths[symbol]]++] = static_cast<int>(symbol);
+			}
+		}
+	}
+
+	// Returns -1 on an invalid code.
+	int decode(InflateBitReader& reader) const
+	{
+		int code = 0, first = 0, index = 0;
+		for(int length = 1; length < 16; ++length)
+		{
+			code |= static_cast<int>(reader.readBits(1));
+			if(code - counts[length] < first)
+			{
+				return symbols[index + (code - first)];
+			}
+			index += counts[length];
+			first  = (first + counts[length]) << 1;
+			code <<= 1;
+		}
+		return -1;
+	}
+};
+
+// Decompresses a zlib stream (RFC 1950 and 1951) with all types of deflate
+// blocks, and checks its header and Adler-32 checksum.
+bool zlib_decompress(const std::vector<uint8>& compressed, std::vector<uint8>* const out_bytes)
+{
+	static const int LENGTH_BASES[]         = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+	static const int LENGTH_EXTRA_BITS[]    = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+	static const int DISTANCE_BASES[]       = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+	static const int DISTANCE_EXTRA_BITS[]  = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+	static const int CODE_LENGTH_ORDER[]    = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+	if(compressed.size() < 6 || (compressed[0] & 0x0F) != 8 || (compressed[0] << 8 | compressed[1]) % 31 != 0)
+	{
+		return false;
+	}
+
+	std::vector<uint8>& bytes = *out_bytes;
+	InflateBitReader reader{compressed, 2, 0, 0, false};
+
+	bool isFinalBlock = false;
+	while(!isFinalBlock && !reader.hasFailed)
+	{
+		isFinalBlock = reader.readBits(1) == 1;
+		const uint32 blockType = reader.readBits(2);
+		if(blockType == 0)
+		{
+			reader.alignToByte();
+			const uint32 length  = reader.readBits(16);
+			const uint32 nLength = reader.readBits(16);
+			if((length ^ 0xFFFF) != nLength)
+			{
+				return false;
+			}
+			for(uint32 i = 0; i < length; ++i)
+			{
+				bytes.push_back(static_cast<uint8>(reader.readBits(8)));
+			}
+			continue;
+		}
+		else if(blockType == 3)
+		{
+			return false;
+		}
+
+		std::vector<int> literalLengths(288, 0), distanceLengths(30, 5);
+		if(blockType == 1)
+		{
+			std::fill(literalLengths.begin(), literalLengths.begin() + 144, 8);
+			std::fill(literalLengths.begin() + 144, literalLengths.begin() + 256, 9);
+			std::fill(literalLengths.begin() + 256, literalLengths.begin() + 280, 7);
+			std::fill(literalLengths.begin() + 280, literalLengths.end(), 8);
+		}
+		else
+		{
+			const uint32 numLiteralCodes  = reader.readBits(5) + 257;
+			const uint32 numDistanceCodes = reader.readBits(5) + 1;
+			const uint32 numLengthCodes   = reader.readBits(4) + 4;
+
+			std::vector<int> lengthCodeLengths(19, 0);
+			for(uint32 i = 0; i < numLengthCodes; ++i)
+			{
+				lengthCodeLengths[CODE_LENGTH_ORDER[i]] = static_cast<int>(reader.readBits(3));
+			}
+			const InflateHuffman lengthCode(lengthCodeLengths);
+
+			std::vector<int> lengths;
+			while(lengths.size() < numLiteralCodes + numDistanceCodes && !reader.hasFailed)
+			{
+				const int symbol = lengthCode.decode(reader);
+				if(symbol < 0)
+				{
+					return false;
+				}
+				else if(symbol < 16)
+				{
+					lengths.push_back(symbol);
+				}
+				else if(symbol == 16)
+				{
+					if(lengths.empty())
+					{
+						return false;
+					}
+					lengths.insert(lengths.end(), 3 + reader.readBits(2), lengths.back());
+				}
+				else
+				{
+					lengths.insert(lengths.end(), symbol == 17 ? 3 + reader.readBits(3) : 11 + reader.readBits(7), 0);
+				}
+			}
+			if(lengths.size() != numLiteralCodes + numDistanceCodes || lengths[256] == 0)
+			{
+				return false;
+			}
+			literalLengths.assign(lengths.begin(), lengths.begin() + numLiteralCodes);
+			distanceLengths.assign(lengths.begin() + numLiteralCodes, lengths.end());
+		}
+
+		const InflateHuffman literalCode(literalLengths);
+		const InflateHuffman distanceCode(distanceLengths);
+		while(!reader.hasFailed)
+		{
+			const int symbol = literalCode.decode(reader);
+			if(symbol < 0 || symbol > 285)
+			{
+				return false;
+			}
+			else if(symbol < 256)
+			{
+				bytes.push_back(static_cast<uint8>(symbol));
+				continue;
+			}
+			else if(symbol == 256)
+			{
+				break;
+			}
+
+			const int length         = LENGTH_BASES[symbol - 257] + static_cast<int>(reader.readBits(LENGTH_EXTRA_BITS[symbol - 257]));
+			const int distanceSymbol = distanceCode.decode(reader);
+			if(distanceSymbol < 0 || distanceSymbol > 29)
+			{
+				return false;
+			}
+			const std::size_t distance = DISTANCE_BASES[distanceSymbol] + reader.readBits(DISTANCE_EXTRA_BITS[distanceSymbol]);
+			if(distance > bytes.size())
+			{
+				return false;
+			}
+			for(int i = 0; i < length; ++i)
+			{
+				bytes.push_back(bytes[bytes.size() - distance]);
+			}
+		}
+	}
+	if(reader.hasFailed)
+	{
+		return false;
+	}
+
+	// the checksum follows the last block, starting at a byte boundary
+	const std::size_t checksumIndex = reader.byteIndex - reader.numBufferedBits / 8;
+	if(checksumIndex + 4 != compressed.size())
+	{
+		return false;
+	}
+
+	uint32 a = 1, b = 0;
+	for(const uint8 value : bytes)
+	{
+		a = (a + value) % 65521;
+		b = (b + a) % 65521;
+	}
+	const uint32 adler32 =
+		static_cast<uint32>(compressed[checksumIndex]) << 24 | compressed[checksumIndex + 1] << 16 | 
+		compressed[checksumIndex + 2] << 8 | compressed[checksumIndex + 3];
+	return adler32 == (b << 16 | a);
+}
+
+}// end anonymous namespace
+
+TEST(ExrFileWriterTest, WritesUncompressedFloatLayers)
+{
+	const Path filePath("./exr_file_writer_test_float.exr");
+
+	HdrRgbFrame color(3, 2), normal(3, 2);
+	for(uint32 y = 0; y < 2; ++y)
+	{
+		for(uint32 x = 0; x < 3; ++x)
+		{
+			color.setPixel(x, y, HdrRgbFrame::Pixel({x + 10.0f * y, -1.0f, 1e6f}));
+			normal.setPixel(x, y, HdrRgbFrame::Pixel({0.0f, 0.5f, 1.0f}));
+		}
+	}
+
+	ExrFileWriter writer(ExrFileWriter::EPixelType::FLOAT, ExrFileWriter::ECompression::NONE);
+	writer.addLayer("", &color);
+	writer.addLayer("normal", &normal);
+	ASSERT_TRUE(writer.write(filePath));
+
+	const ExrFile file = read_exr(filePath, 2);
+	EXPECT_EQ(file.version, 2);
+	EXPECT_EQ(file.compression, 0);
+	ASSERT_EQ(file.channelNames.size(), 6);
+	EXPECT_EQ(file.channelNames[0], "B");
+	EXPECT_EQ(file.channelNames[1], "G");
+	EXPECT_EQ(file.channelNames[2], "R");
+	EXPECT_EQ(file.channelNames[3], "normal.B");
+	EXPECT_EQ(file.channelNames[4], "normal.G");
+	EXPECT_EQ(file.channelNames[5], "normal.R");
+	EXPECT_EQ(file.channelPixelTypes[0], 2);
+
+	// the first scanline of the file is the top row of the frames
+	ASSERT_EQ(file.blocks.size(), 2);
+	EXPECT_EQ(file.blocks[0].firstLine, 0);
+	EXPECT_EQ(file.blocks[1].firstLine, 1);
+	ASSERT_EQ(file.blocks[0].data.size(), 6 * 3 * 4);
+
+	std::vector<float32> values(6 * 3);
+	std::memcpy(values.data(), file.blocks[0].data.data(), file.blocks[0].data.size());
+	EXPECT_EQ(values[0], 1e6f);
+	EXPECT_EQ(values[3], -1.0f);
+	EXPECT_EQ(values[6], 10.0f);
+	EXPECT_EQ(values[8], 12.0f);
+	EXPECT_EQ(values[9], 1.0f);
+	EXPECT_EQ(values[12], 0.5f);
+	EXPECT_EQ(values[15], 0.0f);
+
+	std::remove(filePath.toAbsoluteString().c_str());
+}
+
+TEST(ExrFileWriterTest, WritesRleCompressedHalfLayers)
+{
+	const Path filePath("./exr_file_writer_test_half.exr");
+
+	const float32 inputs[] = {1.0f, 0.5f, -2.0f, 65504.0f, 1e6f, 5.9604645e-8f, 0.1f, 0.0f};
+	const uint16  expectedBits[] = {0x3C00, 0x3800, 0xC000, 0x7BFF, 0x7C00, 0x0001, 0x2E66, 0x0000};
+
+	// a long flat row makes the block compressible
+	const uint32 widthPx = 64;
+	HdrRgbFrame frame(widthPx, 1);
+	frame.fill(0.25f);
+	for(uint32 x = 0; x < 8; ++x)
+	{
+		frame.setPixel(x, 0, HdrRgbFrame::Pixel(inputs[x]));
+	}
+
+	ExrFileWriter writer(ExrFileWriter::EPixelType::HALF, ExrFileWriter::ECompression::RLE);
+	writer.addLayer("a_layer_name_longer_than_thirty_one_characters", &frame);
+	ASSERT_TRUE(writer.write(filePath));
+
+	const ExrFile file = read_exr(filePath, 1);
+	EXPECT_EQ(file.version, 2 | 0x400);
+	EXPECT_EQ(file.compression, 1);
+	EXPECT_EQ(file.channelPixelTypes[0], 1);
+	ASSERT_EQ(file.blocks.size(), 1);
+	EXPECT_LT(file.blocks[0].data.size(), 3 * widthPx * 2);
+
+	const std::vector<uint8> bytes = rle_decompress(file.blocks[0].data);
+	ASSERT_EQ(bytes.size(), 3 * widthPx * 2);
+	for(std::size_t channel = 0; channel < 3; ++channel)
+	{
+		for(uint32 x = 0; x < widthPx; ++x)
+		{
+			const std::size_t offset = (channel * widthPx + x) * 2;
+			const uint16 bits = static_cast<uint16>(bytes[offset] | bytes[offset + 1] << 8);
+			EXPECT_EQ(bits, x < 8 ? expectedBits[x] : 0x3400);
+		}
+	}
+
+	std::remove(filePath.toAbsoluteString().c_str());
+}
+
+TEST(ExrFileWriterTest, WritesZipCompressedFloatLayers)
+{
+	const Path filePath("./exr_file_writer_test_zip.exr");
+
+	// 20 scanlines make a full block of 16 and a partial one
+	const uint32 widthPx  = 40;
+	const uint32 heightPx = 20;
+	HdrRgbFrame frame(widthPx, heightPx);
+	for(uint32 y = 0; y < heightPx; ++y)
+	{
+		for(uint32 x = 0; x < widthPx; ++x)
+		{
+			frame.setPixel(x, y, HdrRgbFrame::Pixel({x * 0.5f, static_cast<float32>(y), 1.0f}));
+		}
+	}
+
+	ExrFileWriter writer(ExrFileWriter::EPixelType::FLOAT, ExrFileWriter::ECompression::ZIP);
+	writer.addLayer("", &frame);
+	ASSERT_TRUE(writer.write(filePath));
+
+	const ExrFile file = read_exr(filePath, 2);
+	EXPECT_EQ(file.compression, 3);
+	ASSERT_EQ(file.blocks.size(), 2);
+	EXPECT_EQ(file.blocks[0].firstLine, 0);
+	EXPECT_EQ(file.blocks[1].firstLine, 16);
+
+	for(const ExrBlock& block : file.blocks)
+	{
+		const uint32 numLines = std::min<uint32>(16, heightPx - block.firstLine);
+		const std::size_t numBytes = numLines * 3 * widthPx * 4;
+
+		// the smooth gradient compresses well, so blocks are not stored raw
+		ASSERT_LT(block.data.size(), numBytes);
+		std::vector<uint8> predicted;
+		ASSERT_TRUE(zlib_decompress(block.data, &predicted));
+		const std::vector<uint8> bytes = unpredict_bytes(std::move(predicted));
+		ASSERT_EQ(bytes.size(), numBytes);
+
+		// channels of each scanline are B, G and R, and scanlines are from
+		// the top row of the frame
+		std::vector<float32> values(bytes.size() / 4);
+		std::memcpy(values.data(), bytes.data(), bytes.size());
+		for(uint32 line = 0; line < numLines; ++line)
+		{
+			for(uint32 x = 0; x < widthPx; ++x)
+			{
+				const std::size_t lineOffset = line * 3 * widthPx;
+				EXPECT_EQ(values[lineOffset + x], 1.0f);
+				EXPECT_EQ(values[lineOffset + widthPx + x], static_cast<float32>(heightPx - 1 - (block.firstLine + line)));
+				EXPECT_EQ(values[lineOffset + 2 * widthPx + x], x * 0.5f);
+			}
+		}
+	}
+
+	std::remove(filePath.toAbsoluteString().c_str());
+}
+
+TEST(ExrFileWriterTest, RejectsMismatchedLayers)
+{
+	HdrRgbFrame frameA(4, 4), frameB(4, 3);
+
+	ExrFileWriter writer;
+	writer.addLayer("", &frameA);
+	writer.addLayer("other", &frameB);
+	EXPECT_FALSE(writer.write(Path("./exr_file_writer_test_mismatched.exr")));
+
+	ExrFileWriter duplicatedWriter;
+	duplicatedWriter.addLayer("same", &frameA);
+	duplicatedWriter.addLayer("same", &frameA);
+	EXPECT_FALSE(duplicatedWriter.write(Path("./exr_file_writer_test_duplicated.exr")));
+}
+
+TEST(ZlibCompressorTest, CompressesRepetitiveData)
+{
+	std::vector<uint8> data(20000);
+	for(std::size_t i = 0; i < data.size(); ++i)
+	{
+		data[i] = static_cast<uint8>(i % 7 == 0 ? i : 3);
+	}
+
+	std::vector<uint8> compressed;
+	ZlibCompressor::compress(data.data(), data.size(), &compressed);
+	ASSERT_GE(compressed.size(), 6);
+	EXPECT_LT(compressed.size(), data.size() / 4);
+
+	// header of a 32 KiB window
+	EXPECT_EQ(compressed[0], 0x78);
+
+	std::vector<uint8> decompressed;
+	ASSERT_TRUE(zlib_decompress(compressed, &decompressed));
+	EXPECT_EQ(decompressed, data);
+}
+
+TEST(ZlibCompressorTest, RoundTripsData)
+{
+	// empty and tiny inputs, incompressible noise, and long runs with 
+	// matches far back in the window, over several blocks
+	std::vector<std::vector<uint8>> inputs = {{}, {42}, {1, 2, 3, 1, 2, 3, 1, 2, 3}};
+
+	uint32 state = 12345;
+	std::vector<uint8> noise(70000);
+	for(uint8& value : noise)
+	{
+		state = state * 1664525 + 1013904223;
+		value = static_cast<uint8>(state >> 24);
+	}
+	inputs.push_back(noise);
+
+	std::vector<uint8> mixed(noise.begin(), noise.begin() + 30000);
+	mixed.insert(mixed.end(), 50000, 9);
+	mixed.insert(mixed.end(), noise.begin(), noise.begin() + 30000);
+	mixed.insert(mixed.end(), noise.begin() + 100, noise.begin() + 400);
+	inputs.push_back(mixed);
+
+	for(const std::vector<uint8>& input : inputs)
+	{
+		SCOPED_TRACE(input.size());
+
+		std::vector<uint8> compressed;
+		ZlibCompressor::compress(input.data(), input.size(), &compressed);
+
+		std::vector<uint8> decompressed;
+		ASSERT_TRUE(zlib_decompress(compressed, &decompressed));
+		EXPECT_EQ(decompressed, input);
+	}
+}
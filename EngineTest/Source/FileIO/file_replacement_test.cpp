@@ -0,0 +1,70 @@
+#include <FileIO/FileReplacement.h>
+#include <FileIO/FileSystem/Path.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+using namespace ph;
+
+namespace
+{
+
+void write_file(const std::string& filePath, const std::string& content)
+{
+	std::ofstream file(filePath, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+	file << content;
+}
+
+std::string read_file(const std::string& filePath)
+{
+	std::ifstream file(filePath, std::ios_base::in | std::ios_base::binary);
+	return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+bool file_exists(const std::string& filePath)
+{
+	return std::ifstream(filePath).good();
+}
+
+}
+
+TEST(FileReplacementTest, CommitReplacesExistingFile)
+{
+	const Path        filePath("./file_replacement_test_commit.txt");
+	const std::string finalFilePath = filePath.toAbsoluteString();
+	write_file(finalFilePath, "old");
+
+	{
+		FileReplacement replacement(filePath);
+		write_file(replacement.getTempFilePath(), "new");
+		EXPECT_EQ(read_file(finalFilePath), "old");
+
+		ASSERT_TRUE(replacement.commit());
+		EXPECT_FALSE(file_exists(replacement.getTempFilePath()));
+	}
+	EXPECT_EQ(read_file(finalFilePath), "new");
+
+	std::remove(finalFilePath.c_str());
+}
+
+TEST(FileReplacementTest, UncommittedTempFileIsRemoved)
+{
+	const Path        filePath("./file_replacement_test_discard.txt");
+	const std::string finalFilePath = filePath.toAbsoluteString();
+	write_file(finalFilePath, "old");
+
+	std::string tempFilePath;
+	{
+		FileReplacement replacement(filePath);
+		tempFilePath = replacement.getTempFilePath();
+		write_file(tempFilePath, "partial");
+	}
+	EXPECT_FALSE(file_exists(tempFilePath));
+	EXPECT_EQ(read_file(finalFilePath), "old");
+
+	std::remove(finalFilePath.c_str());
+}
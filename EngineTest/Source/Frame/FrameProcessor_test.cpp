@@ -27,7 +27,7 @@ TEST(FrameProcessorTest, GenerateMipmaps)
 		return true;
 	};
 
-	ph::mipmapgen processor(3);
+	ph::mipmapgen processor;
 	ph::HdrRgbFrame src(127, 127);
 	src.fill(7);
 
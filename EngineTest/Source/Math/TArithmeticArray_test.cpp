@@ -2,6 +2,9 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <limits>
+
 TEST(TArithmeticArrayTest, AddsRhsValue)
 {
 	const std::size_t size = 10;
@@ -53,4 +56,81 @@ TEST(TArithmeticArrayTest, PerElementAbsolute)
 	EXPECT_EQ(absArray1[1], 0.0f);
 	EXPECT_EQ(absArray1[2], 2.0f);
 	EXPECT_EQ(absArray1[3], 8.0f);
-}
\ No newline at end of file
+}
+
+namespace
+{
+
+template<typename T>
+void test_wide_array_arithmetic()
+{
+	// not a multiple of any SIMD width, so remaining elements are covered too
+	constexpr std::size_t SIZE = 101;
+
+	ph::TArithmeticArray<T, SIZE> array1;
+	ph::TArithmeticArray<T, SIZE> array2;
+	for(std::size_t i = 0; i < SIZE; ++i)
+	{
+		array1[i] = static_cast<T>(i) * static_cast<T>(0.5);
+		array2[i] = static_cast<T>(SIZE - i);
+	}
+
+	const auto sum     = array1.add(array2);
+	const auto diff    = array1.sub(array2);
+	const auto product = array1.mul(array2);
+	const auto ratio   = array1.div(array2);
+	const auto scaled  = array1.mul(static_cast<T>(2));
+	const auto shifted = array1.sub(static_cast<T>(1));
+	const auto roots   = ph::TArithmeticArray<T, SIZE>(array2).sqrtLocal();
+	const auto compl1  = array1.complement();
+	T dotResult = 0;
+	T sumResult = 0;
+	for(std::size_t i = 0; i < SIZE; ++i)
+	{
+		EXPECT_EQ(sum[i],     array1[i] + array2[i]);
+		EXPECT_EQ(diff[i],    array1[i] - array2[i]);
+		EXPECT_EQ(product[i], array1[i] * array2[i]);
+		EXPECT_EQ(ratio[i],   array1[i] / array2[i]);
+		EXPECT_EQ(scaled[i],  array1[i] * static_cast<T>(2));
+		EXPECT_EQ(shifted[i], array1[i] - static_cast<T>(1));
+		EXPECT_EQ(roots[i],   std::sqrt(array2[i]));
+		EXPECT_EQ(compl1[i],  static_cast<T>(1) - array1[i]);
+
+		dotResult += array1[i] * array2[i];
+		sumResult += array1[i];
+	}
+
+	// elements are summed in a different order, but all values are exact
+	EXPECT_EQ(array1.dot(array2), dotResult);
+	EXPECT_EQ(array1.sum(), sumResult);
+	EXPECT_EQ(array1.max(), static_cast<T>(SIZE - 1) * static_cast<T>(0.5));
+	EXPECT_EQ(array2.max(), static_cast<T>(SIZE));
+
+	ph::TArithmeticArray<T, SIZE> zeros(0);
+	EXPECT_TRUE(zeros.isZero());
+	EXPECT_TRUE(zeros.isNonNegative());
+	zeros[SIZE - 1] = static_cast<T>(-1);
+	EXPECT_FALSE(zeros.isZero());
+	EXPECT_FALSE(zeros.isNonNegative());
+	zeros[SIZE - 1] = 0;
+	zeros[3] = static_cast<T>(-1);
+	EXPECT_FALSE(zeros.isZero());
+	EXPECT_FALSE(zeros.isNonNegative());
+
+	ph::TArithmeticArray<T, SIZE> clamped(array2);
+	clamped[0] = std::numeric_limits<T>::quiet_NaN();
+	clamped.clampLocal(static_cast<T>(2), static_cast<T>(50));
+	EXPECT_EQ(clamped[0], static_cast<T>(2));
+	for(std::size_t i = 1; i < SIZE; ++i)
+	{
+		EXPECT_EQ(clamped[i], std::fmin(static_cast<T>(50), std::fmax(array2[i], static_cast<T>(2))));
+	}
+}
+
+}// end anonymous namespace
+
+TEST(TArithmeticArrayTest, WideArrayArithmetic)
+{
+	test_wide_array_arithmetic<float>();
+	test_wide_array_arithmetic<double>();
+}
@@ -0,0 +1,97 @@
+#include <Math/encoding.h>
+#include <Math/TVector3.h>
+#include <Math/Random/Pcg32.h>
+#include <Math/constant.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+using namespace ph;
+
+namespace
+{
+
+Vector3R gen_unit_vector(Pcg32& rng)
+{
+	const real z   = rng.genUniformReal_i0_e1() * 2.0_r - 1.0_r;
+	const real phi = rng.genUniformReal_i0_e1() * constant::two_pi<real>;
+	const real r   = std::sqrt(std::max(1.0_r - z * z, 0.0_r));
+
+	return Vector3R(r * std::cos(phi), r * std::sin(phi), z);
+}
+
+}
+
+TEST(EncodingTest, OctahedralUnitVectorRoundTrip)
+{
+	// errors are measured in chord lengths, which are close to angles in 
+	// radians for small angles
+	Pcg32 rng;
+	for(int i = 0; i < 10000; ++i)
+	{
+		const Vector3R unitVector = gen_unit_vector(rng);
+
+		const Vector3R decoded32 = encoding::decode_unit_vector_octahedral(
+			encoding::encode_unit_vector_octahedral<uint32>(unitVector));
+		EXPECT_NEAR(decoded32.length(), 1.0_r, 1e-5_r);
+		EXPECT_LT((decoded32 - unitVector).length(), 1e-4_r);
+
+		const Vector3R decoded16 = encoding::decode_unit_vector_octahedral(
+			encoding::encode_unit_vector_octahedral<uint16>(unitVector));
+		EXPECT_NEAR(decoded16.length(), 1.0_r, 1e-5_r);
+		EXPECT_LT((decoded16 - unitVector).length(), 2e-2_r);
+	}
+
+	// axes are exactly representable
+	const Vector3R axes[] = {
+		{1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}};
+	for(const Vector3R& axis : axes)
+	{
+		const Vector3R decoded = encoding::decode_unit_vector_octahedral(
+			encoding::encode_unit_vector_octahedral<uint32>(axis));
+		EXPECT_NEAR(decoded.x, axis.x, 1e-4_r);
+		EXPECT_NEAR(decoded.y, axis.y, 1e-4_r);
+		EXPECT_NEAR(decoded.z, axis.z, 1e-4_r);
+	}
+}
+
+TEST(EncodingTest, SharedExponentRoundTrip)
+{
+	uint8 bytes[4];
+	real  values[3];
+
+	const real zeros[3] = {0, 0, 0};
+	encoding::encode_shared_exponent<3>(zeros, bytes);
+	encoding::decode_shared_exponent<3>(bytes, values);
+	EXPECT_EQ(values[0], 0.0_r);
+	EXPECT_EQ(values[1], 0.0_r);
+	EXPECT_EQ(values[2], 0.0_r);
+
+	// negative values are stored as 0
+	const real mixed[3] = {-1, 0, 2};
+	encoding::encode_shared_exponent<3>(mixed, bytes);
+	encoding::decode_shared_exponent<3>(bytes, values);
+	EXPECT_EQ(values[0], 0.0_r);
+	EXPECT_EQ(values[1], 0.0_r);
+	EXPECT_NEAR(values[2], 2.0_r, 2.0_r / 128.0_r);
+
+	// values are accurate relative to the largest one, over a wide range
+	Pcg32 rng;
+	for(int i = 0; i < 10000; ++i)
+	{
+		const real scale     = std::pow(2.0_r, rng.genUniformReal_i0_e1() * 80.0_r - 40.0_r);
+		const real inputs[3] = {
+			rng.genUniformReal_i0_e1() * scale,
+			rng.genUniformReal_i0_e1() * scale,
+			rng.genUniformReal_i0_e1() * scale};
+		const real maxInput  = std::max({inputs[0], inputs[1], inputs[2]});
+
+		encoding::encode_shared_exponent<3>(inputs, bytes);
+		encoding::decode_shared_exponent<3>(bytes, values);
+		for(int c = 0; c < 3; ++c)
+		{
+			EXPECT_NEAR(values[c], inputs[c], maxInput / 128.0_r);
+		}
+	}
+}
@@ -0,0 +1,70 @@
+#include <Math/Random/low_discrepancy.h>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <cmath>
+
+using namespace ph;
+
+TEST(LowDiscrepancyTest, ReverseBits)
+{
+	EXPECT_EQ(low_discrepancy::reverse_bits(0x00000000), 0x00000000);
+	EXPECT_EQ(low_discrepancy::reverse_bits(0x00000001), 0x80000000);
+	EXPECT_EQ(low_discrepancy::reverse_bits(0x0000000F), 0xF0000000);
+	EXPECT_EQ(low_discrepancy::reverse_bits(0x12345678), 0x1E6A2C48);
+}
+
+TEST(LowDiscrepancyTest, SobolSecondDimension)
+{
+	EXPECT_EQ(low_discrepancy::sobol_dim1(0), 0x00000000);
+	EXPECT_EQ(low_discrepancy::sobol_dim1(1), 0x80000000);
+	EXPECT_EQ(low_discrepancy::sobol_dim1(2), 0xC0000000);
+	EXPECT_EQ(low_discrepancy::sobol_dim1(3), 0x40000000);
+}
+
+TEST(LowDiscrepancyTest, OwenScramblingKeepsStratification)
+{
+	for(uint32 seed : {0U, 7U, 123456789U})
+	{
+		// every power-of-two prefix still occupies each 1-D stratum once
+		const uint32 numPoints = 256;
+		std::vector<int> strata(numPoints, 0);
+		for(uint32 i = 0; i < numPoints; ++i)
+		{
+			const uint32 value = low_discrepancy::owen_scramble_base2(low_discrepancy::sobol_dim1(i), seed);
+			++strata[value >> 24];
+		}
+		for(int count : strata)
+		{
+			EXPECT_EQ(count, 1);
+		}
+	}
+}
+
+TEST(LowDiscrepancyTest, ScrambledRadicalInverseBase3)
+{
+	for(uint32 seed : {0U, 42U})
+	{
+		const uint32 numPoints = 243;
+		std::vector<int> strata(numPoints, 0);
+		for(uint64 i = 0; i < numPoints; ++i)
+		{
+			const float64 value = low_discrepancy::owen_scrambled_radical_inverse(3, i, seed);
+			ASSERT_TRUE(0.0 <= value && value < 1.0);
+
+			++strata[static_cast<std::size_t>(value * numPoints)];
+		}
+		for(int count : strata)
+		{
+			EXPECT_EQ(count, 1);
+		}
+	}
+}
+
+TEST(LowDiscrepancyTest, FractionToRealIsBelowOne)
+{
+	EXPECT_EQ(low_discrepancy::fraction_to_real(uint32(0)), 0.0_r);
+	EXPECT_LT(low_discrepancy::fraction_to_real(uint32(0xFFFFFFFF)), 1.0_r);
+	EXPECT_LT(low_discrepancy::fraction_to_real(std::nextafter(1.0, 0.0)), 1.0_r);
+}
@@ -1,7 +1,13 @@
 #include <Math/Random.h>
+#include <Math/Random/Pcg32.h>
+#include <Math/Random/PrimarySampleSequence.h>
 
 #include <gtest/gtest.h>
 
+#include <vector>
+#include <thread>
+#include <cmath>
+
 using namespace ph;
 
 // TODO: seed with time or other data
@@ -24,4 +30,155 @@ TEST(RandomNumberTest, GeneratesIndexInExpectedRange)
 		const std::size_t index = Random::genUniformIndex_iL_eU(lowerBound, upperBound);
 		EXPECT_TRUE(lowerBound <= index && index < upperBound);
 	}
-}
\ No newline at end of file
+}
+
+TEST(RandomNumberTest, ReseededThreadGeneratorRepeats)
+{
+	Random::seedThisThread(123, 4);
+	const real value1 = Random::genUniformReal_i0_e1();
+	const real value2 = Random::genUniformReal_i0_e1();
+
+	Random::seedThisThread(123, 4);
+	EXPECT_EQ(Random::genUniformReal_i0_e1(), value1);
+	EXPECT_EQ(Random::genUniformReal_i0_e1(), value2);
+}
+
+TEST(RandomNumberTest, KeyedThreadGeneratorsAgreeAcrossThreads)
+{
+	Random::keyThisThread(3, 5, 7);
+	const uint64 seed = Random::genSeed();
+
+	uint64 otherThreadSeed = 0;
+	std::thread otherThread([&otherThreadSeed]()
+	{
+		// advance this thread's generator first; keying restarts it anyway
+		Random::genSeed();
+
+		Random::keyThisThread(3, 5, 7);
+		otherThreadSeed = Random::genSeed();
+	});
+	otherThread.join();
+
+	EXPECT_EQ(otherThreadSeed, seed);
+
+	Random::keyThisThread(3, 5, 8);
+	EXPECT_NE(Random::genSeed(), seed);
+}
+
+TEST(Pcg32Test, MatchesReferenceImplementation)
+{
+	// outputs of pcg32-demo from the reference C implementation
+	Pcg32 rng(42, 54);
+	EXPECT_EQ(rng.genUint32(), 0xa15c02b7);
+	EXPECT_EQ(rng.genUint32(), 0x7b47f409);
+	EXPECT_EQ(rng.genUint32(), 0xba1d3330);
+	EXPECT_EQ(rng.genUint32(), 0x83d2f293);
+	EXPECT_EQ(rng.genUint32(), 0xbfa4784b);
+	EXPECT_EQ(rng.genUint32(), 0xcbed606e);
+}
+
+TEST(Pcg32Test, GeneratesNumbersInExpectedRange)
+{
+	Pcg32 rng(7, 11);
+	for(std::size_t i = 0; i < 512; i++)
+	{
+		const real value = rng.genUniformReal_i0_e1();
+		EXPECT_TRUE(0.0_r <= value && value < 1.0_r);
+
+		EXPECT_LT(rng.genUniformIndex_i0_eU(13), 13);
+	}
+}
+
+TEST(Pcg32Test, BatchedGenerationMatchesSequential)
+{
+	for(std::size_t numReals : {0, 1, 3, 4, 5, 8, 63})
+	{
+		Pcg32 sequentialRng = Pcg32::makeKeyed(1, 2, 3);
+		Pcg32 batchedRng    = sequentialRng;
+
+		std::vector<real> reals(numReals);
+		batchedRng.genUniformReals_i0_e1(reals.data(), numReals);
+		for(std::size_t i = 0; i < numReals; ++i)
+		{
+			EXPECT_EQ(reals[i], sequentialRng.genUniformReal_i0_e1());
+		}
+		EXPECT_TRUE(batchedRng == sequentialRng);
+	}
+}
+
+TEST(Pcg32Test, AdvanceSkipsNumbers)
+{
+	Pcg32 rng1(3, 5);
+	Pcg32 rng2 = rng1;
+
+	for(int i = 0; i < 1000; ++i)
+	{
+		rng1.genUint32();
+	}
+	rng2.advance(1000);
+	EXPECT_TRUE(rng1 == rng2);
+
+	rng2.advance(-1000);
+	EXPECT_TRUE(rng2 == Pcg32(3, 5));
+}
+
+TEST(Pcg32Test, KeyedGeneratorsAreDistinct)
+{
+	EXPECT_TRUE(Pcg32::makeKeyed(1, 2, 3) == Pcg32::makeKeyed(1, 2, 3));
+	EXPECT_TRUE(Pcg32::makeKeyed(1, 2, 3) != Pcg32::makeKeyed(1, 2, 4));
+	EXPECT_TRUE(Pcg32::makeKeyed(1, 2, 3) != Pcg32::makeKeyed(2, 1, 3));
+}
+
+TEST(PrimarySampleSequenceTest, OverridesThreadGenerator)
+{
+	PrimarySampleSequence sequence(Pcg32(1, 2));
+	PrimarySampleSequence referenceSequence(Pcg32(1, 2));
+
+	sequence.proposeLargeStep();
+	referenceSequence.proposeLargeStep();
+
+	Random::overrideThisThread(&sequence);
+	const real        value = Random::genUniformReal_i0_e1();
+	const std::size_t index = Random::genUniformIndex_iL_eU(10, 20);
+	Random::overrideThisThread(nullptr);
+
+	EXPECT_EQ(value, referenceSequence.next());
+	EXPECT_EQ(index, 10 + static_cast<std::size_t>(referenceSequence.next() * 10));
+}
+
+TEST(PrimarySampleSequenceTest, SmallStepsStayNearAcceptedSample)
+{
+	PrimarySampleSequence sequence(Pcg32(3, 4));
+
+	std::vector<real> currentValues;
+	sequence.proposeLargeStep();
+	for(int i = 0; i < 8; ++i)
+	{
+		currentValues.push_back(sequence.next());
+	}
+	sequence.accept();
+	EXPECT_EQ(sequence.numCurrentValues(), 8);
+
+	// a rejected proposal leaves the current sample as is
+	sequence.proposeLargeStep();
+	sequence.next();
+
+	const real mutationSize = 0.01_r;
+	sequence.proposeSmallStep(mutationSize);
+	for(int i = 0; i < 8; ++i)
+	{
+		const real value = sequence.next();
+		EXPECT_TRUE(0.0_r <= value && value < 1.0_r);
+
+		// distance on the unit circle, as perturbations wrap around
+		const real distance = std::abs(value - currentValues[i]);
+		EXPECT_LE(std::min(distance, 1.0_r - distance), mutationSize + 1e-6_r);
+	}
+
+	// numbers beyond the current sample are new ones
+	const real value = sequence.next();
+	EXPECT_TRUE(0.0_r <= value && value < 1.0_r);
+
+	sequence.accept();
+	EXPECT_EQ(sequence.numCurrentValues(), 9);
+}
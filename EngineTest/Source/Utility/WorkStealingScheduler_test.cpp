@@ -0,0 +1,138 @@
+#include <Utility/WorkStealingScheduler.h>
+#include <Utility/TaskGroup.h>
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <atomic>
+#include <functional>
+#include <thread>
+
+TEST(WorkStealingSchedulerTest, CalculateNumberSum)
+{
+	std::random_device rd;
+	std::mt19937 rng(rd());
+	std::uniform_int_distribution<> dis(-10, 10);
+
+	const int NUM_WORKERS        = 4;
+	const int NUMBERS_PER_WORKER = 10000;
+	const int NUMBERS            = NUM_WORKERS * NUMBERS_PER_WORKER;
+
+	int numbers[NUMBERS];
+	for(int i = 0; i < NUMBERS; i++)
+	{
+		numbers[i] = dis(rng);
+	}
+
+	int actualSum = 0;
+	for(int i = 0; i < NUMBERS; i++)
+	{
+		actualSum += numbers[i];
+	}
+
+	ph::WorkStealingScheduler scheduler(NUM_WORKERS);
+	ph::TaskGroup tasks(scheduler);
+	std::atomic_int testSum = 0;
+	for(int i = 0; i < NUM_WORKERS; i++)
+	{
+		tasks.run([i, NUMBERS_PER_WORKER, &numbers, &testSum]()
+		{
+			for(int j = i * NUMBERS_PER_WORKER; 
+			    j < (i + 1) * NUMBERS_PER_WORKER;
+			    j++)
+			{
+				testSum += numbers[j];
+			}
+		});
+	}
+	tasks.wait();
+
+	EXPECT_EQ(testSum, actualSum);
+}
+
+TEST(WorkStealingSchedulerTest, TasksSpawningTasks)
+{
+	ph::WorkStealingScheduler scheduler(3);
+	ph::TaskGroup tasks(scheduler);
+
+	// a binary tree of tasks with 2^10 leaves
+	std::atomic_int numLeaves = 0;
+	std::function<void(int)> spawn = [&](const int depth)
+	{
+		if(depth == 10)
+		{
+			++numLeaves;
+			return;
+		}
+
+		tasks.run([&spawn, depth]() { spawn(depth + 1); });
+		spawn(depth + 1);
+	};
+	tasks.run([&spawn]() { spawn(0); });
+	tasks.wait();
+
+	EXPECT_EQ(numLeaves, 1 << 10);
+
+	// the group can be reused after waiting
+	tasks.run([&numLeaves]() { numLeaves = 0; });
+	tasks.wait();
+
+	EXPECT_EQ(numLeaves, 0);
+}
+
+TEST(WorkStealingSchedulerTest, GetAttributes)
+{
+	ph::WorkStealingScheduler scheduler(2);
+	EXPECT_EQ(scheduler.numWorkers(), 2);
+
+	ph::WorkStealingScheduler::setSharedNumWorkers(3);
+	EXPECT_EQ(ph::WorkStealingScheduler::getShared().numWorkers(), 3);
+}
+
+TEST(WorkStealingSchedulerTest, WaitingWithoutWorkers)
+{
+	ph::WorkStealingScheduler scheduler(0);
+	ph::TaskGroup tasks(scheduler);
+
+	int numFinished = 0;
+	for(int i = 0; i < 100; ++i)
+	{
+		tasks.run([&numFinished, &tasks, i]()
+		{
+			if(i % 10 == 0)
+			{
+				tasks.run([&numFinished]() { ++numFinished; });
+			}
+			++numFinished;
+		});
+	}
+	tasks.wait();
+
+	EXPECT_EQ(numFinished, 110);
+}
+
+TEST(WorkStealingSchedulerTest, WaitingRunsOnlyOwnTasks)
+{
+	ph::WorkStealingScheduler scheduler(2);
+	ph::TaskGroup otherTasks(scheduler);
+	ph::TaskGroup tasks(scheduler);
+
+	const std::thread::id waitingThread = std::this_thread::get_id();
+	std::atomic_bool isOtherTaskRunByWaiter = false;
+	for(int i = 0; i < 1000; ++i)
+	{
+		otherTasks.run([waitingThread, &isOtherTaskRunByWaiter]()
+		{
+			if(std::this_thread::get_id() == waitingThread)
+			{
+				isOtherTaskRunByWaiter = true;
+			}
+		});
+		tasks.run([](){});
+	}
+	tasks.wait();
+
+	EXPECT_FALSE(isOtherTaskRunByWaiter);
+
+	otherTasks.wait();
+}
@@ -32,4 +32,38 @@ TEST(ConcurrentTest, ParallelWork)
 			}
 		});
 	EXPECT_EQ(sum, 55);
-}
\ No newline at end of file
+}
+
+TEST(ConcurrentTest, ParallelFor)
+{
+	using namespace ph;
+
+	const std::size_t grainSizes[] = {1, 7, 1000, 50000};
+	for(const std::size_t grainSize : grainSizes)
+	{
+		std::vector<std::atomic_int> numVisits(10000);
+		parallel_for(100, numVisits.size(), grainSize,
+			[grainSize, &numVisits](const std::size_t chunkBegin, const std::size_t chunkEnd)
+			{
+				EXPECT_LT(chunkBegin, chunkEnd);
+				EXPECT_TRUE(chunkEnd - chunkBegin >= grainSize || chunkEnd == numVisits.size());
+
+				for(std::size_t i = chunkBegin; i < chunkEnd; ++i)
+				{
+					++numVisits[i];
+				}
+			});
+
+		for(std::size_t i = 0; i < numVisits.size(); ++i)
+		{
+			EXPECT_EQ(numVisits[i], i < 100 ? 0 : 1);
+		}
+	}
+
+	bool isCalled = false;
+	parallel_for(5, 5, [&isCalled](const std::size_t, const std::size_t)
+	{
+		isCalled = true;
+	});
+	EXPECT_FALSE(isCalled);
+}
@@ -1,11 +1,12 @@
 #pragma once
 
-#define JAVA_INT_SIGNATURE          "I"
-#define JAVA_LONG_SIGNATURE         "J"
-#define JAVA_FLOAT_SIGNATURE        "F"
-#define JAVA_DOUBLE_SIGNATURE       "D"
-#define JAVA_INT_ARRAY_SIGNATURE    "[I"
-#define JAVA_LONG_ARRAY_SIGNATURE   "[J"
-#define JAVA_FLOAT_ARRAY_SIGNATURE  "[F"
-#define JAVA_STRING_SIGNATURE       "Ljava/lang/String;"
-#define JAVA_STRING_ARRAY_SIGNATURE "[Ljava/lang/String;"
\ No newline at end of file
+#define JAVA_INT_SIGNATURE           "I"
+#define JAVA_LONG_SIGNATURE          "J"
+#define JAVA_FLOAT_SIGNATURE         "F"
+#define JAVA_DOUBLE_SIGNATURE        "D"
+#define JAVA_INT_ARRAY_SIGNATURE     "[I"
+#define JAVA_LONG_ARRAY_SIGNATURE    "[J"
+#define JAVA_LONG_2D_ARRAY_SIGNATURE "[[J"
+#define JAVA_FLOAT_ARRAY_SIGNATURE   "[F"
+#define JAVA_STRING_SIGNATURE        "Ljava/lang/String;"
+#define JAVA_STRING_ARRAY_SIGNATURE  "[Ljava/lang/String;"
\ No newline at end of file
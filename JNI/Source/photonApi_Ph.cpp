@@ -390,15 +390,29 @@ JNIEXPORT void JNICALL Java_photonApi_Ph_phGetObservableRenderData
 			env->NewStringUTF(data.reals[i]));
 	}
 
+	jobjectArray jHistogramNamesStringArray = env->NewObjectArray(
+		PH_NUM_RENDER_HISTOGRAMS,
+		env->FindClass(JAVA_STRING_SIGNATURE),
+		env->NewStringUTF(""));
+	for(jsize i = 0; i < PH_NUM_RENDER_HISTOGRAMS; ++i)
+	{
+		env->SetObjectArrayElement(
+			jHistogramNamesStringArray,
+			i,
+			env->NewStringUTF(data.histograms[i]));
+	}
+
 	jclass class_ObservableRenderData = env->GetObjectClass(out_ObservableRenderData_data);
 
-	jfieldID field_layerNames   = env->GetFieldID(class_ObservableRenderData, "layerNames",   JAVA_STRING_ARRAY_SIGNATURE);
-	jfieldID field_integerNames = env->GetFieldID(class_ObservableRenderData, "integerNames", JAVA_STRING_ARRAY_SIGNATURE);
-	jfieldID field_realNames    = env->GetFieldID(class_ObservableRenderData, "realNames",    JAVA_STRING_ARRAY_SIGNATURE);
+	jfieldID field_layerNames     = env->GetFieldID(class_ObservableRenderData, "layerNames",     JAVA_STRING_ARRAY_SIGNATURE);
+	jfieldID field_integerNames   = env->GetFieldID(class_ObservableRenderData, "integerNames",   JAVA_STRING_ARRAY_SIGNATURE);
+	jfieldID field_realNames      = env->GetFieldID(class_ObservableRenderData, "realNames",      JAVA_STRING_ARRAY_SIGNATURE);
+	jfieldID field_histogramNames = env->GetFieldID(class_ObservableRenderData, "histogramNames", JAVA_STRING_ARRAY_SIGNATURE);
 
-	env->SetObjectField(out_ObservableRenderData_data, field_layerNames,   jLayerNamesStringArray);
-	env->SetObjectField(out_ObservableRenderData_data, field_integerNames, jIntegerNamesStringArray);
-	env->SetObjectField(out_ObservableRenderData_data, field_realNames,    jRealNamesStringArray);
+	env->SetObjectField(out_ObservableRenderData_data, field_layerNames,     jLayerNamesStringArray);
+	env->SetObjectField(out_ObservableRenderData_data, field_integerNames,   jIntegerNamesStringArray);
+	env->SetObjectField(out_ObservableRenderData_data, field_realNames,      jRealNamesStringArray);
+	env->SetObjectField(out_ObservableRenderData_data, field_histogramNames, jHistogramNamesStringArray);
 }
 
 /*
@@ -426,9 +440,28 @@ JNIEXPORT void JNICALL Java_photonApi_Ph_phAsyncGetRendererState
 		env->SetFloatArrayRegion(jFloatArray, static_cast<jsize>(i), 1, &value);
 	}
 
+	jobjectArray jHistogramArray = env->NewObjectArray(
+		PH_NUM_RENDER_HISTOGRAMS,
+		env->FindClass(JAVA_LONG_ARRAY_SIGNATURE),
+		nullptr);
+	for(std::size_t i = 0; i < PH_NUM_RENDER_HISTOGRAMS; ++i)
+	{
+		jlong bins[PH_NUM_RENDER_HISTOGRAM_BINS];
+		for(std::size_t j = 0; j < PH_NUM_RENDER_HISTOGRAM_BINS; ++j)
+		{
+			bins[j] = static_cast<jlong>(state.histograms[i][j]);
+		}
+
+		jlongArray jBinArray = env->NewLongArray(PH_NUM_RENDER_HISTOGRAM_BINS);
+		env->SetLongArrayRegion(jBinArray, 0, PH_NUM_RENDER_HISTOGRAM_BINS, bins);
+		env->SetObjectArrayElement(jHistogramArray, static_cast<jsize>(i), jBinArray);
+	}
+
 	jclass   class_RenderState   = env->GetObjectClass(out_RenderState_state);
 	jfieldID field_integerStates = env->GetFieldID(class_RenderState, "integerStates", JAVA_LONG_ARRAY_SIGNATURE);
 	jfieldID field_realStates    = env->GetFieldID(class_RenderState, "realStates",    JAVA_FLOAT_ARRAY_SIGNATURE);
+	jfieldID field_histograms    = env->GetFieldID(class_RenderState, "histograms",    JAVA_LONG_2D_ARRAY_SIGNATURE);
 	env->SetObjectField(out_RenderState_state, field_integerStates, jLongArray);
 	env->SetObjectField(out_RenderState_state, field_realStates,    jFloatArray);
+	env->SetObjectField(out_RenderState_state, field_histograms,    jHistogramArray);
 }
\ No newline at end of file
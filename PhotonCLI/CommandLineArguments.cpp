@@ -177,7 +177,9 @@ void CommandLineArguments::printHelpMessage()
 	               (default path: "./scene.p2")
 
 	-o <path>      Specify image output path. This should be a filename for
-	               single image and a path for image series.
+	               single image and a path for image series. An OpenEXR
+	               file (.exr) keeps all render layers as half floats, 
+	               without post-processing.
 	               (default path: "./rendered_scene.png")
 
 	-t <number>    Set number of threads used for rendering.
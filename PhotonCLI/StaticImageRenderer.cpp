@@ -7,6 +7,8 @@
 #include <thread>
 #include <chrono>
 #include <atomic>
+#include <algorithm>
+#include <cctype>
 
 // FIXME: add osx fs headers once it is supported
 #if defined(_WIN32)
@@ -97,21 +99,38 @@ void StaticImageRenderer::render() const
 	isRenderingCompleted = true;
 	std::cout << "render completed" << std::endl;
 
-	PHuint64 frameId;
-	phCreateFrame(&frameId, filmWpx, filmHpx);
-	if(m_isPostProcessRequested)
+	// OpenEXR files keep all layers of the render, without post-processing
+	const std::string exrExtension = ".exr";
+	std::string imageFileExtension = m_imageFilePath.size() >= exrExtension.size() ? 
+		m_imageFilePath.substr(m_imageFilePath.size() - exrExtension.size()) : "";
+	std::transform(imageFileExtension.begin(), imageFileExtension.end(), imageFileExtension.begin(), 
+		[](const unsigned char ch)
+		{
+			return static_cast<char>(std::tolower(ch));
+		});
+	if(imageFileExtension == exrExtension)
 	{
-		phAquireFrame(m_engineId, 0, frameId);
+		std::cout << "saving render layers to <" << m_imageFilePath << ">" << std::endl;
+		phSaveRenderLayers(m_engineId, m_imageFilePath.c_str());
 	}
 	else
 	{
-		phAquireFrameRaw(m_engineId, 0, frameId);
-	}
+		PHuint64 frameId;
+		phCreateFrame(&frameId, filmWpx, filmHpx);
+		if(m_isPostProcessRequested)
+		{
+			phAquireFrame(m_engineId, 0, frameId);
+		}
+		else
+		{
+			phAquireFrameRaw(m_engineId, 0, frameId);
+		}
 
-	std::cout << "saving image to <" << m_imageFilePath << ">" << std::endl;
-	phSaveFrame(frameId, m_imageFilePath.c_str());
+		std::cout << "saving image to <" << m_imageFilePath << ">" << std::endl;
+		phSaveFrame(frameId, m_imageFilePath.c_str());
 
-	phDeleteFrame(frameId);
+		phDeleteFrame(frameId);
+	}
 
 	queryThread.join();
 }
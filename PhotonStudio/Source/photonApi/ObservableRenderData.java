@@ -5,4 +5,5 @@ public class ObservableRenderData
 	public String[] layerNames;
 	public String[] integerNames;
 	public String[] realNames;
+	public String[] histogramNames;
 }
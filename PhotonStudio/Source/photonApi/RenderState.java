@@ -2,12 +2,14 @@ package photonApi;
 
 public class RenderState
 {
-	public long[]  integerStates;
-	public float[] realStates;
+	public long[]   integerStates;
+	public float[]  realStates;
+	public long[][] histograms;
 	
 	public RenderState()
 	{
 		integerStates = null;
 		realStates    = null;
+		histograms    = null;
 	}
 }